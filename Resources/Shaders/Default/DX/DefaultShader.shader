@@ -1,5 +1,6 @@
 #define VERTEX_ENTRY mainVS
 #define PIXEL_ENTRY mainPS
+#define TDE2_INSTANCING_SUPPORTED
 
 
 #include <TDEngine2Globals.inc>
@@ -8,7 +9,6 @@
 struct VertexOut
 {
 	float4 mPos              : SV_POSITION;
-	float4 mLightPos         : POSITION1;
 	float4 mWorldPos         : POSITION2;
 	float4 mColor            : COLOR;
 	float2 mUV               : TEXCOORD;
@@ -27,6 +27,17 @@ struct VertexIn
 	float2 mUV      : TEXCOORD;
 	float4 mNormal  : NORMAL;
 	float4 mTangent : TANGENT;
+
+#ifdef TDE2_INSTANCING_ENABLED
+	float4 mModelMat0    : TEXCOORD1;
+	float4 mModelMat1    : TEXCOORD2;
+	float4 mModelMat2    : TEXCOORD3;
+	float4 mModelMat3    : TEXCOORD4;
+	float4 mInvModelMat0 : TEXCOORD5;
+	float4 mInvModelMat1 : TEXCOORD6;
+	float4 mInvModelMat2 : TEXCOORD7;
+	float4 mInvModelMat3 : TEXCOORD8;
+#endif
 };
 
 
@@ -34,14 +45,21 @@ VertexOut mainVS(in VertexIn input)
 {
 	VertexOut output;
 
-	output.mPos      = mul(mul(ProjMat, mul(ViewMat, ModelMat)), input.mPos);
-	output.mLightPos = mul(mul(SunLightMat, ModelMat), input.mPos);
-	output.mWorldPos = mul(ModelMat, input.mPos);
-	output.mNormal   = normalize(mul(transpose(InvModelMat), input.mNormal));
+#ifdef TDE2_INSTANCING_ENABLED
+	float4x4 modelMat    = TDE2_INSTANCE_MATRIX(input.mModelMat0, input.mModelMat1, input.mModelMat2, input.mModelMat3);
+	float4x4 invModelMat = TDE2_INSTANCE_MATRIX(input.mInvModelMat0, input.mInvModelMat1, input.mInvModelMat2, input.mInvModelMat3);
+#else
+	float4x4 modelMat    = ModelMat;
+	float4x4 invModelMat = InvModelMat;
+#endif
+
+	output.mPos      = mul(mul(ProjMat, mul(ViewMat, modelMat)), input.mPos);
+	output.mWorldPos = mul(modelMat, input.mPos);
+	output.mNormal   = normalize(mul(transpose(invModelMat), input.mNormal));
 	output.mUV       = input.mUV;
 	output.mColor    = input.mColor;
 
-	float3 tangent  = normalize(mul(transpose(InvModelMat), input.mTangent));
+	float3 tangent  = normalize(mul(transpose(invModelMat), input.mTangent));
 	float3 binormal = normalize(cross(output.mNormal, tangent));
 
 	output.mTangentToWorld = transpose(float3x3(tangent, binormal, output.mNormal.xyz));
@@ -59,15 +77,15 @@ VertexOut mainVS(in VertexIn input)
 #include <TDEngine2ShadowMappingUtils.inc>
 
 
-DECLARE_TEX2D_EX(AlbedoMap, 1);
-DECLARE_TEX2D_EX(NormalMap, 2);
-DECLARE_TEX2D_EX(PropertiesMap, 3);
+DECLARE_TEX2D_EX(AlbedoMap, 4);
+DECLARE_TEX2D_EX(NormalMap, 5);
+DECLARE_TEX2D_EX(PropertiesMap, 6);
 
 
 TDE2_ENABLE_PARALLAX_MAPPING
 
 
-CBUFFER_SECTION_EX(ShaderParameters, 4)
+CBUFFER_SECTION_EX(ShaderParameters, 5)
 	float parallaxMappingEnabled;
 CBUFFER_ENDSECTION
 
@@ -88,12 +106,14 @@ float4 mainPS(VertexOut input): SV_TARGET0
 
 	float4 pointLightsContribution = float4(0.0, 0.0, 0.0, 0.0);
 
-	for (int i = 0; i < ActivePointLightsCount; ++i)
+	uint lightCluster = GetLightClusterIndex(input.mWorldPos);
+
+	for (uint i = 0u; i < GetLightClusterLightsCount(lightCluster); ++i)
 	{
-		pointLightsContribution += CalcPointLightContribution(PointLights[i], lightingData);
+		pointLightsContribution += CalcPointLightContribution(PointLights[GetLightClusterLightIndex(lightCluster, i)], lightingData);
 	}
 
-	return (sunLight + pointLightsContribution)	* (1.0 - ComputeShadowFactorPCF(8, input.mLightPos, 0.0001, 1000.0)) * input.mColor;
+	return (sunLight + pointLightsContribution)	* (1.0 - ComputeCascadedShadowFactorPCF(8, input.mWorldPos, 0.0001, 1000.0)) * input.mColor;
 }
 
 #endprogram
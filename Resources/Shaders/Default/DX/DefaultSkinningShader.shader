@@ -7,7 +7,6 @@
 struct VertexOut
 {
 	float4 mPos          : SV_POSITION;
-	float4 mLightPos     : POSITION1;
 	float4 mWorldPos     : POSITION2;
 	float4 mColor        : COLOR;
 	float2 mUV           : TEXCOORD;
@@ -62,7 +61,6 @@ VertexOut mainVS(in VertexIn input)
 	}
 
 	output.mPos      = mul(mul(ProjMat, mul(ViewMat, ModelMat)), float4(localPos, 1.0));
-	output.mLightPos = mul(mul(SunLightMat, ModelMat), input.mPos);
 	output.mWorldPos = mul(ModelMat, float4(localPos, 1.0));
 	output.mNormal   = mul(transpose(InvModelMat), float4(localNormal, 0.0));
 	output.mUV       = input.mUV;
@@ -83,9 +81,9 @@ VertexOut mainVS(in VertexIn input)
 #include <TDEngine2ShadowMappingUtils.inc>
 
 
-DECLARE_TEX2D_EX(AlbedoMap, 1);
-DECLARE_TEX2D_EX(NormalMap, 2);
-DECLARE_TEX2D_EX(PropertiesMap, 3);
+DECLARE_TEX2D_EX(AlbedoMap, 4);
+DECLARE_TEX2D_EX(NormalMap, 5);
+DECLARE_TEX2D_EX(PropertiesMap, 6);
 
 
 float4 mainPS(VertexOut input): SV_TARGET0
@@ -101,12 +99,14 @@ float4 mainPS(VertexOut input): SV_TARGET0
 
 	float4 pointLightsContribution = float4(0.0, 0.0, 0.0, 0.0);
 
-	for (int i = 0; i < ActivePointLightsCount; ++i)
+	uint lightCluster = GetLightClusterIndex(input.mWorldPos);
+
+	for (uint i = 0u; i < GetLightClusterLightsCount(lightCluster); ++i)
 	{
-		pointLightsContribution += CalcPointLightContribution(PointLights[i], lightingData);
+		pointLightsContribution += CalcPointLightContribution(PointLights[GetLightClusterLightIndex(lightCluster, i)], lightingData);
 	}
 
-	return (sunLight + pointLightsContribution)	* (1.0 - ComputeShadowFactorPCF(8, input.mLightPos, 0.0001, 1000.0)) * input.mColor;
+	return (sunLight + pointLightsContribution)	* (1.0 - ComputeCascadedShadowFactorPCF(8, input.mWorldPos, 0.0001, 1000.0)) * input.mColor;
 }
 
 #endprogram
@@ -4,6 +4,7 @@
 
 #define VERTEX_ENTRY main
 #define PIXEL_ENTRY main
+#define TDE2_INSTANCING_SUPPORTED
 
 #program vertex
 
@@ -13,8 +14,18 @@ layout (location = 2) in vec2 inUV;
 layout (location = 3) in vec4 inNormal;
 layout (location = 4) in vec4 inTangent;
 
+#ifdef TDE2_INSTANCING_ENABLED
+layout (location = 5) in vec4 inModelMat0;
+layout (location = 6) in vec4 inModelMat1;
+layout (location = 7) in vec4 inModelMat2;
+layout (location = 8) in vec4 inModelMat3;
+layout (location = 9) in vec4 inInvModelMat0;
+layout (location = 10) in vec4 inInvModelMat1;
+layout (location = 11) in vec4 inInvModelMat2;
+layout (location = 12) in vec4 inInvModelMat3;
+#endif
+
 out vec4 VertOutColor;
-out vec4 LightSpaceVertPos;
 out vec4 VertOutWorldPos;
 out vec2 VertOutUV;
 out vec4 VertOutNormal;
@@ -24,16 +35,23 @@ out vec3 OutTangentViewDir;
 
 void main(void)
 {
-	gl_Position = ProjMat * ViewMat * ModelMat * inlPos;
-	LightSpaceVertPos = SunLightMat * ModelMat * inlPos;
+#ifdef TDE2_INSTANCING_ENABLED
+	mat4 modelMat    = TDE2_INSTANCE_MATRIX(inModelMat0, inModelMat1, inModelMat2, inModelMat3);
+	mat4 invModelMat = TDE2_INSTANCE_MATRIX(inInvModelMat0, inInvModelMat1, inInvModelMat2, inInvModelMat3);
+#else
+	mat4 modelMat    = ModelMat;
+	mat4 invModelMat = InvModelMat;
+#endif
+
+	gl_Position = ProjMat * ViewMat * modelMat * inlPos;
 
 	VertOutColor = inColor;
 
-	VertOutWorldPos = ModelMat * inlPos;
-	VertOutNormal = transpose(InvModelMat) * inNormal;
+	VertOutWorldPos = modelMat * inlPos;
+	VertOutNormal = transpose(invModelMat) * inNormal;
 	VertOutUV = inUV;
 
-	float3 tangent  = (transpose(InvModelMat) * inTangent).xyz;
+	float3 tangent  = (transpose(invModelMat) * inTangent).xyz;
 	float3 binormal = normalize(cross(VertOutNormal.xyz, tangent));
 
 	VertOutTBN = mat3(tangent, binormal, VertOutNormal.xyz);
@@ -55,7 +73,6 @@ DECLARE_TEX2D(PropertiesMap);
 
 
 in vec4 VertOutColor;
-in vec4 LightSpaceVertPos;
 in vec4 VertOutWorldPos;
 in vec2 VertOutUV;
 in vec4 VertOutNormal;
@@ -68,7 +85,7 @@ out vec4 FragColor;
 TDE2_ENABLE_PARALLAX_MAPPING
 
 
-CBUFFER_SECTION_EX(ShaderParameters, 4)
+CBUFFER_SECTION_EX(ShaderParameters, 5)
 	float parallaxMappingEnabled;
 CBUFFER_ENDSECTION
 
@@ -89,12 +106,14 @@ void main(void)
 
 	vec4 pointLightsContribution = vec4(0.0);
 
-	for (int i = 0; i < ActivePointLightsCount; ++i)
+	uint lightCluster = GetLightClusterIndex(VertOutWorldPos);
+
+	for (uint i = 0u; i < GetLightClusterLightsCount(lightCluster); ++i)
 	{
-		pointLightsContribution += CalcPointLightContribution(PointLights[i], lightingData);
+		pointLightsContribution += CalcPointLightContribution(PointLights[GetLightClusterLightIndex(lightCluster, i)], lightingData);
 	}
 
-	FragColor = (sunLight + pointLightsContribution) * (1.0 - ComputeShadowFactorPCF(8, LightSpaceVertPos, 0.0001, 1000.0)) * VertOutColor;
+	FragColor = (sunLight + pointLightsContribution) * (1.0 - ComputeCascadedShadowFactorPCF(8, VertOutWorldPos, 0.0001, 1000.0)) * VertOutColor;
 }
 
 #endprogram
@@ -18,7 +18,6 @@ layout (location = 5) in vec4  inJointWeights;
 layout (location = 6) in vec4 inJointIndices;
 
 out vec4 VertOutColor;
-out vec4 LightSpaceVertPos;
 out vec4 VertOutWorldPos;
 out vec2 VertOutUV;
 out vec4 VertOutNormal;
@@ -47,7 +46,6 @@ void main(void)
 	vec4 pos = vec4(localPos, 1.0);
 
 	gl_Position = ProjMat * ViewMat * ModelMat * pos;
-	LightSpaceVertPos = SunLightMat * ModelMat * pos;
 
 	VertOutColor = inColor;
 
@@ -74,7 +72,6 @@ DECLARE_TEX2D(PropertiesMap);
 
 
 in vec4 VertOutColor;
-in vec4 LightSpaceVertPos;
 in vec4 VertOutWorldPos;
 in vec2 VertOutUV;
 in vec4 VertOutNormal;
@@ -96,12 +93,14 @@ void main(void)
 
 	vec4 pointLightsContribution = vec4(0.0);
 
-	for (int i = 0; i < ActivePointLightsCount; ++i)
+	uint lightCluster = GetLightClusterIndex(VertOutWorldPos);
+
+	for (uint i = 0u; i < GetLightClusterLightsCount(lightCluster); ++i)
 	{
-		pointLightsContribution += CalcPointLightContribution(PointLights[i], lightingData);
+		pointLightsContribution += CalcPointLightContribution(PointLights[GetLightClusterLightIndex(lightCluster, i)], lightingData);
 	}
 
-	FragColor = (sunLight + pointLightsContribution) * (1.0 - ComputeShadowFactorPCF(8, LightSpaceVertPos, 0.0001, 1000.0)) * VertOutColor;
+	FragColor = (sunLight + pointLightsContribution) * (1.0 - ComputeCascadedShadowFactorPCF(8, VertOutWorldPos, 0.0001, 1000.0)) * VertOutColor;
 }
 
 #endprogram
@@ -29,7 +29,7 @@ VertexOut mainVS(uint id : SV_VertexID)
 
 DECLARE_TEX2D(FrameTexture);
 
-CBUFFER_SECTION_EX(BloomParameters, 4)
+CBUFFER_SECTION_EX(BloomParameters, 5)
 	float threshold;
 CBUFFER_ENDSECTION
 
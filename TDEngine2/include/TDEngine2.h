@@ -30,6 +30,8 @@
 #include "core/CResourceManager.h"
 #include "core/IJobManager.h"
 #include "core/CBaseJobManager.h"
+#include "core/CWorkStealingQueue.h"
+#include "core/CMPSCQueue.h"
 #include "core/IPluginManager.h"
 #include "core/CBasePluginManager.h"
 #include "core/IResourceFactory.h"
@@ -68,6 +70,7 @@
 #include "ecs/CEntity.h"
 #include "ecs/CEntityManager.h"
 #include "ecs/CComponentManager.h"
+#include "ecs/CArchetypeStorage.h"
 #include "ecs/IComponent.h"
 #include "ecs/CBaseComponent.h"
 #include "ecs/ISystem.h"
@@ -119,6 +122,9 @@
 #include "graphics/CBaseCubemapTexture.h"
 #include "graphics/ICamera.h"
 #include "graphics/CBaseCamera.h"
+#include "graphics/FrustumCulling.h"
+#include "graphics/ClusteredLighting.h"
+#include "graphics/ShadowCascades.h"
 #include "graphics/CPerspectiveCamera.h"
 #include "graphics/COrthoCamera.h"
 #include "graphics/CBaseShaderCompiler.h"
@@ -108,7 +108,7 @@ namespace TDEngine2
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API E_RESULT_CODE _configureJobManager(U32 maxNumOfThreads) override;
+			TDE2_API E_RESULT_CODE _configureJobManager(const TJobManagerInitParams& params) override;
 
 			/*!
 				\brief The method tries to configure a plugin manager
@@ -9,13 +9,18 @@
 
 #include "IJobManager.h"
 #include "CBaseObject.h"
+#include "CWorkStealingQueue.h"
+#include "CMPSCQueue.h"
 #include <vector>
-#include <queue>
+#include <deque>
+#include <array>
 #include <thread>
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
 #include <memory>
+#include <type_traits>
+#include <cstddef>
 
 
 namespace TDEngine2
@@ -26,34 +31,70 @@ namespace TDEngine2
 		\return A pointer to CResourceManager's implementation
 	*/
 
-	TDE2_API IJobManager* CreateBaseJobManager(U32 maxNumOfThreads, E_RESULT_CODE& result);
+	TDE2_API IJobManager* CreateBaseJobManager(const TJobManagerInitParams& params, E_RESULT_CODE& result);
+
+
+	constexpr U32 InvalidWorkerThreadIndex = (std::numeric_limits<U32>::max)();
 
 
 	/*!
 		class CBaseJobManager
 
 		\brief The class is a common implementation of a thread pool for
-		Win32 and UNIX platforms
+		Win32 and UNIX platforms.
+
+		Each worker and the thread which initializes the manager own a lock-free queue and a pool of jobs' slots, so submission
+		doesn't allocate and doesn't take locks. Idle workers steal jobs from queues of other threads. Jobs that are submitted
+		from other threads go into a shared queue which is guarded with a mutex
 	*/
 
 	class CBaseJobManager : public IJobManager, public CBaseObject
 	{
 		public:
-			friend TDE2_API IJobManager* CreateBaseJobManager(U32 maxNumOfThreads, E_RESULT_CODE& result);
+			friend TDE2_API IJobManager* CreateBaseJobManager(const TJobManagerInitParams& params, E_RESULT_CODE& result);
 		protected:
 			typedef std::vector<std::thread>          TThreadsArray;
-			typedef std::queue<std::unique_ptr<IJob>> TJobQueue;
-			typedef std::queue<std::function<void()>> TCallbacksQueue;
+			typedef std::deque<U32>                   TJobQueue;
+			typedef CMPSCQueue<std::function<void()>> TCallbacksQueue;
+
+			typedef void (*TInlineCallbackInvoker)(void*);
+
+			TDE2_STATIC_CONSTEXPR USIZE JobInlineCallbackSize = 48;
+
+			typedef struct TJobSlot
+			{
+				alignas(std::max_align_t) U8                mInlineCallback[JobInlineCallbackSize];
+				TInlineCallbackInvoker                      mpInlineCallbackInvoker = nullptr; ///< If it's nullptr mCallback is executed
+				TJobCallback                                mCallback;
+				TJobCounter*                                mpCounter = nullptr;
+
+				std::atomic<U32>                            mGeneration { 0 };
+				std::atomic<bool>                           mIsBusy { false };
+
+				std::atomic_flag                            mContinuationsLock = ATOMIC_FLAG_INIT;
+				std::array<U32, MaxJobContinuationsCount>   mContinuations;
+				U32                                         mContinuationsCount = 0;
+			} TJobSlot, *TJobSlotPtr;
+
+			typedef struct TThreadContext
+			{
+				TDE2_API TThreadContext(U32 queueCapacity) : mQueue(queueCapacity) {}
+
+				CWorkStealingQueue mQueue;
+				U32                mNextSlotIndex = 0; ///< Only the owner's thread allocates slots, so it's not atomic
+			} TThreadContext, *TThreadContextPtr;
+
+			typedef std::vector<std::unique_ptr<TThreadContext>> TThreadContextsArray;
 		public:
 			/*!
 				\brief The method initializes an inner state of a manager
 
-				\param[in] maxNumOfThreads A maximum number of threads that will be created and processed by the manager
+				\param[in] params Parameters of the manager which include a maximum number of worker threads
 
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API E_RESULT_CODE Init(U32 maxNumOfThreads) override;
+			TDE2_API E_RESULT_CODE Init(const TJobManagerInitParams& params) override;
 
 			/*!
 				\brief The method allows to execute some code from main thread nomatter from which thread it's called
@@ -66,11 +107,77 @@ namespace TDEngine2
 			TDE2_API E_RESULT_CODE ExecuteInMainThread(const std::function<void()>& action = nullptr) override;
 
 			/*!
-				\brief The method unrolls main thread's queue of actions that should be executed only in the main thread
+				\brief The method unrolls main thread's queue of actions that should be executed only in the main thread.
+				The method is called every frame and stops when the time budget is exceeded, the rest of callbacks are
+				executed on next frames
 			*/
 
 			TDE2_API void ProcessMainThreadQueue() override;
 
+			/*!
+				\brief The method returns statistics of the last ProcessMainThreadQueue's invocation
+
+				\return The method returns statistics of the last ProcessMainThreadQueue's invocation
+			*/
+
+			TDE2_API const TMainThreadQueueStats& GetMainThreadQueueStats() const override;
+
+			/*!
+				\brief The method returns a number of worker threads which execute submitted jobs
+
+				\return The method returns a number of worker threads
+			*/
+
+			TDE2_API U32 GetWorkerThreadsCount() const override;
+
+			/*!
+				\brief The method splits [0; elementsCount) range into subranges and processes them on worker threads.
+				Sizes of subranges are multiples of a number of elements that fit into a single cache line, so
+				neighbouring subranges don't write into the same cache line. The calling thread processes a subrange too and
+				then helps to execute pending jobs until all of subranges are done (join barrier)
+
+				\param[in] elementsCount A total number of elements
+				\param[in] elementSize A size of a single element of processed arrays in bytes
+				\param[in] action A callback that processes [first; last) range
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE ParallelFor(USIZE elementsCount, USIZE elementSize, const TParallelForAction& action) override;
+
+			/*!
+				\brief The method submits a job which starts only when the given one is completed. If the parent job is
+				already completed the continuation is submitted immediately
+
+				\param[in] parentJobHandle A handle of a job which should be completed before the continuation
+				\param[in, out] pCounter A counter which is increased now and decreased when the continuation is completed. Can be nullptr
+				\param[in] job A callback of the continuation
+
+				\return The method returns a handle of the continuation, or an invalid handle if it wasn't submitted
+			*/
+
+			TDE2_API TJobHandle ContinueWith(const TJobHandle& parentJobHandle, TJobCounter* pCounter, TJobCallback job) override;
+
+			/*!
+				\brief The method blocks until the counter reaches the given value. The calling thread executes pending jobs
+				while it waits, so it's safe to call the method from jobs
+
+				\param[in] counter A counter that's passed into SubmitJob
+				\param[in] value A value which the counter should reach
+			*/
+
+			TDE2_API void WaitForJobCounter(const TJobCounter& counter, U32 value = 0) override;
+
+			/*!
+				\brief The method blocks until the job is completed. The calling thread executes pending jobs while it waits
+
+				\param[in] jobHandle A handle of the job
+			*/
+
+			TDE2_API void WaitForJob(const TJobHandle& jobHandle) override;
+
+			TDE2_API bool IsJobCompleted(const TJobHandle& jobHandle) const override;
+
 			/*!
 				\brief The method returns a type of the subsystem
 
@@ -80,34 +187,106 @@ namespace TDEngine2
 			TDE2_API E_ENGINE_SUBSYSTEM_TYPE GetType() const override;
 
 			TDE2_API static bool IsMainThread();
+
+			/*!
+				\brief The function returns an index of the calling worker thread, which lies within [0; GetWorkerThreadsCount()).
+				The main thread and threads that aren't managed by a job manager get InvalidWorkerThreadIndex
+
+				\return The function returns an index of the calling worker thread
+			*/
+
+			TDE2_API static U32 GetCurrWorkerThreadIndex();
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CBaseJobManager)
 
-			TDE2_API void _executeTasksLoop();
+			TDE2_API void _executeTasksLoop(U32 threadContextIndex);
+
+			/*!
+				\brief The method retrieves a single job from queues and executes it in the calling thread
+
+				\return The method returns false if there were no pending jobs
+			*/
+
+			TDE2_API bool _tryExecuteJob();
+
+			TDE2_API TJobHandle _submitJob(TJobCounter* pCounter, TJobCallback&& job) override;
+
+			/*!
+				\brief The method submits a job which callable is copied into the slot's inline storage, so no allocations happen.
+				It's used for internal jobs which captures are known to be small
+			*/
+
+			template <typename TCallable>
+			TJobHandle _submitInlineJob(TJobCounter* pCounter, const TCallable& callable)
+			{
+				static_assert(sizeof(TCallable) <= JobInlineCallbackSize, "The callable doesn't fit into the inline storage of a job's slot");
+				static_assert(std::is_trivially_copyable<TCallable>::value && std::is_trivially_destructible<TCallable>::value, "The callable should be trivially copyable");
+
+				if (!mIsInitialized)
+				{
+					return {};
+				}
 
-			TDE2_API E_RESULT_CODE _submitJob(std::unique_ptr<IJob> pJob) override;
+				const U32 slotIndex = _allocateJobSlot(pCounter);
+
+				TJobSlot& slot = mpJobSlots[slotIndex];
+
+				new (slot.mInlineCallback) TCallable(callable);
+				slot.mpInlineCallbackInvoker = [](void* pCallable) { (*static_cast<TCallable*>(pCallable))(); };
+
+				const TJobHandle jobHandle { slotIndex, slot.mGeneration.load(std::memory_order_relaxed) };
+				_pushJob(slotIndex);
+
+				return jobHandle;
+			}
+
+			/*!
+				\brief The method finds a free slot and marks it as busy. The caller should set a callback of the slot before it's pushed
+			*/
+
+			TDE2_API U32 _allocateJobSlot(TJobCounter* pCounter);
+
+			TDE2_API void _pushJob(U32 slotIndex);
+
+			TDE2_API bool _tryGetJob(U32& slotIndex);
+
+			TDE2_API void _executeJob(U32 slotIndex);
+
+			TDE2_API TThreadContext* _getCurrThreadContext() const;
 
 			TDE2_API E_RESULT_CODE _onFreeInternal() override;
 		protected:
-			static constexpr U8     mUpdateTickRate = 60; // \note Single update every 60 frames
-
 			bool                    mIsInitialized;
 
 			U32                     mNumOfThreads;
 
 			std::atomic<bool>       mIsRunning;
 
-			std::atomic_uint8_t     mUpdateCounter;
+			F32                     mMainThreadQueueTimeBudget;
+
+			TMainThreadQueueStats   mMainThreadQueueStats;
 
 			TThreadsArray           mWorkerThreads;
 
 			TCallbacksQueue         mMainThreadCallbacksQueue;
 
-			mutable std::mutex      mQueueMutex;
+			std::unique_ptr<TJobSlot[]> mpJobSlots; ///< Each thread context owns JobsPoolSizePerThread slots, the last range is shared by other threads
+
+			TThreadContextsArray    mThreadContexts; ///< Workers' contexts and the last one belongs to the thread which has initialized the manager
+
+			TJobQueue               mSharedJobs;
+
+			std::atomic<U32>        mSharedJobsCount;
+
+			mutable std::mutex      mSharedJobsMutex;
+
+			U32                     mNextSharedSlotIndex;
+
+			std::atomic<I32>        mPendingJobsCount;
 
-			mutable std::mutex      mMainThreadCallbacksQueueMutex;
+			std::atomic<U32>        mSleepingWorkersCount;
 
-			TJobQueue               mJobs;
+			mutable std::mutex      mSleepMutex;
 
 			std::condition_variable mHasNewJobAdded;
 	};
@@ -59,6 +59,15 @@ namespace TDEngine2
 
 			TDE2_API virtual E_RESULT_CODE Reset() = 0;
 
+			/*!
+				\brief The method releases loaded data of the resource but keeps the object itself. The base
+				implementation doesn't support eviction
+
+				\return RC_OK if everything went ok, RC_NOT_IMPLEMENTED_YET if the resource doesn't support eviction
+			*/
+
+			TDE2_API E_RESULT_CODE Evict() override;
+
 			/*!
 				\brief The method is called after the resource has been created
 			*/
@@ -96,6 +105,15 @@ namespace TDEngine2
 			*/
 
 			TDE2_API E_RESOURCE_LOADING_POLICY GetLoadingPolicy() const override;
+
+			/*!
+				\return The method returns an approximate size of memory in bytes which is occupied by loaded data of the resource
+			*/
+
+			TDE2_API USIZE GetMemorySize() const override;
+
+			TDE2_API void SetLastUsedTick(U32 tick) override;
+			TDE2_API U32 GetLastUsedTick() const override;
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CBaseResource)
 
@@ -115,6 +133,8 @@ namespace TDEngine2
 
 			E_RESOURCE_LOADING_POLICY          mLoadingPolicy;
 
+			std::atomic<U32>                   mLastUsedTick;
+
 			mutable std::mutex                 mMutex;
 	};
 }
\ No newline at end of file
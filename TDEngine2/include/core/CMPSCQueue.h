@@ -0,0 +1,127 @@
+/*!
+	\file CMPSCQueue.h
+	\date 16.10.2026
+	\authors Kasimov Ildar
+*/
+
+#pragma once
+
+
+#include "../utils/Types.h"
+#include "../utils/Utils.h"
+#include <atomic>
+
+
+namespace TDEngine2
+{
+	/*!
+		class CMPSCQueue
+
+		\brief The class is an unbounded lock-free queue with multiple producers and a single consumer (D. Vyukov's algorithm).
+		Push is wait-free and can be called from any thread, while TryPop should be called only by a thread which owns the queue
+	*/
+
+	template <typename T>
+	class CMPSCQueue
+	{
+		private:
+			typedef struct TNode
+			{
+				std::atomic<TNode*> mpNext { nullptr };
+				T                   mValue;
+			} TNode, *TNodePtr;
+		public:
+			CMPSCQueue();
+			~CMPSCQueue();
+
+			/*!
+				\brief The method appends a new value into the queue. It's safe to call the method from any thread
+
+				\param[in] value A value that will be pushed
+			*/
+
+			void Push(T&& value);
+
+			/*!
+				\brief The method retrieves the oldest value of the queue. Should be called only by the consumer's thread
+
+				\param[out] value A retrieved value
+
+				\return The method returns false if the queue is empty. Note that a value which is being pushed right now can be
+				invisible for the consumer until the producer completes Push
+			*/
+
+			bool TryPop(T& value);
+
+			/*!
+				\brief The method returns an approximate number of values within the queue
+
+				\return The method returns an approximate number of values within the queue
+			*/
+
+			U32 GetSize() const;
+		private:
+			CMPSCQueue(const CMPSCQueue<T>&) = delete;
+			CMPSCQueue<T>& operator= (const CMPSCQueue<T>&) = delete;
+		private:
+			alignas(CacheLineSize) std::atomic<TNode*> mpHead; ///< Producers append nodes here
+			alignas(CacheLineSize) TNode*              mpTail; ///< The consumer's side, it always points to a stub node
+
+			std::atomic<U32>                           mSize;
+	};
+
+
+	template <typename T>
+	CMPSCQueue<T>::CMPSCQueue():
+		mpHead(new TNode()), mSize(0)
+	{
+		mpTail = mpHead.load(std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	CMPSCQueue<T>::~CMPSCQueue()
+	{
+		T value;
+		while (TryPop(value)) {}
+
+		delete mpTail;
+	}
+
+	template <typename T>
+	void CMPSCQueue<T>::Push(T&& value)
+	{
+		TNode* pNode = new TNode();
+		pNode->mValue = std::move(value);
+
+		mSize.fetch_add(1, std::memory_order_relaxed);
+
+		TNode* pPrevNode = mpHead.exchange(pNode, std::memory_order_acq_rel);
+		pPrevNode->mpNext.store(pNode, std::memory_order_release);
+	}
+
+	template <typename T>
+	bool CMPSCQueue<T>::TryPop(T& value)
+	{
+		TNode* pNextNode = mpTail->mpNext.load(std::memory_order_acquire);
+		if (!pNextNode)
+		{
+			return false;
+		}
+
+		value = std::move(pNextNode->mValue);
+
+		/// \note The popped node becomes a new stub
+		delete mpTail;
+		mpTail = pNextNode;
+
+		mSize.fetch_sub(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	template <typename T>
+	U32 CMPSCQueue<T>::GetSize() const
+	{
+		return mSize.load(std::memory_order_relaxed);
+	}
+}
@@ -53,6 +53,8 @@ namespace TDEngine2
 				{
 					U32  mShadowMapSizes = 512;
 					bool mIsShadowMappingEnabled = true;
+					U32  mShadowCascadesCount = 4;
+					F32  mShadowsDistance = 100.0f; ///< Shadows of the directional light are drawn only within the distance from the camera
 				} mRendererSettings;
 
 				std::string mDefaultSkyboxMaterial = "DefaultMaterials/DefaultSkybox.material";
@@ -67,6 +69,10 @@ namespace TDEngine2
 			{
 				U32 mMaxNumOfWorkerThreads = std::thread::hardware_concurrency() - 1;
 
+				F32 mMainThreadQueueTimeBudget = 2.0f; ///< Milliseconds per frame which are spent on callbacks that are executed in the main thread
+
+				U32 mResourcesMemoryBudget = 0; ///< Mebibytes which could be occupied by loaded resources before eviction begins, 0 means no limit
+
 				std::string mApplicationName;
 
 				U32 mFlags = static_cast<U32>(P_RESIZEABLE | P_ZBUFFER_ENABLED);
@@ -22,6 +22,22 @@ namespace TDEngine2
 	TDE2_API IGraphicsContext* CreateProxyGraphicsContext(TPtr<IWindowSystem> pWindowSystem, E_RESULT_CODE& result);
 
 
+	/*!
+		struct TProxyGraphicsContextStats
+
+		\brief The structure contains numbers of calls that were received by CProxyGraphicsContext. It's used
+		to check how many states binds and draw calls are issued by the renderer
+	*/
+
+	typedef struct TProxyGraphicsContextStats
+	{
+		U32 mBlendStateBindsCount = 0;
+		U32 mDepthStencilStateBindsCount = 0;
+		U32 mRasterizerStateBindsCount = 0;
+		U32 mDrawCallsCount = 0;
+	} TProxyGraphicsContextStats, *TProxyGraphicsContextStatsPtr;
+
+
 	/*!
 		class CProxyGraphicsContext
 
@@ -345,9 +361,23 @@ namespace TDEngine2
 			*/
 
 			TDE2_API TPtr<IWindowSystem> GetWindowSystem() const override;
+
+			/*!
+				\brief The method resets all counters of received calls
+			*/
+
+			TDE2_API void ResetStats();
+
+			/*!
+				\return The method returns numbers of calls that were received since the last ResetStats call
+			*/
+
+			TDE2_API const TProxyGraphicsContextStats& GetStats() const;
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CProxyGraphicsContext)
 		protected:
-			TPtr<IWindowSystem> mpWindowSystem;
+			TPtr<IWindowSystem>        mpWindowSystem;
+
+			TProxyGraphicsContextStats mStats;
 	};
 }
\ No newline at end of file
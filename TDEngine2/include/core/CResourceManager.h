@@ -9,12 +9,21 @@
 
 #include "IResourceManager.h"
 #include "CBaseObject.h"
+#include "IJobManager.h"
 #include "../utils/CResourceContainer.h"
+#include "../editor/IProfiler.h"
 #include <unordered_map>
+#include <unordered_set>
+#include <shared_mutex>
 #include <atomic>
 #include <vector>
 #include <mutex>
+#include <thread>
+#include <array>
 #include <list>
+#include <queue>
+#include <memory>
+#include <functional>
 
 
 namespace TDEngine2
@@ -55,13 +64,88 @@ namespace TDEngine2
 			
 			typedef CResourceContainer<TPtr<IResourceFactory>>            TResourceFactoriesContainer;
 
-			typedef std::unordered_map<std::string, TResourceId>          TResourcesMap;
+			typedef struct TResourceEntry
+			{
+				std::string     mName;
+				TResourceId     mId = TResourceId::Invalid;
+				std::thread::id mLoadingThreadId; ///< A thread which loads the resource at the moment, the default value means there is no such thread
+				bool            mIsEvictable = false; ///< Only resources that were loaded via Load could be restored after eviction
+			} TResourceEntry;
+
+			typedef std::unordered_multimap<U32, TResourceEntry>          TResourcesMap; ///< Names' hashes are computed only once by callers
+
+			/*!
+				\brief The names' table is split into shards with their own locks, so lookups of different resources don't
+				contend with each other. Shards are read-mostly, a lock is taken exclusively only when a new entry is added or
+				a resource is claimed for loading. Resources are never loaded under these locks
+			*/
+
+			typedef struct TResourcesMapShard
+			{
+				TResourcesMap                   mResourcesMap;
+				mutable std::shared_timed_mutex mMutex;
+			} TResourcesMapShard;
 
 			typedef CResourceContainer<TPtr<IResource>>                   TResourcesContainer;
 
 			typedef std::vector<std::tuple<TypeId, TypeId>>               TResourceTypesAliasesMap;
 
 			typedef std::unordered_map<TypeId, E_RESOURCE_LOADING_POLICY> TResourceTypesPoliciesMap;
+
+			typedef std::unordered_set<U32>                               TEvictedResourcesSet;
+
+			typedef std::vector<TResourceId>                              TResourcesIdsArray;
+
+			typedef struct TEvictionCandidate
+			{
+				TResourceId mId;
+				U32         mLastUsedTick;
+				USIZE       mSize;
+			} TEvictionCandidate;
+
+			typedef std::vector<TEvictionCandidate>                       TEvictionCandidatesArray;
+
+			typedef struct TAsyncLoadingRequest
+			{
+				std::string                         mName;
+				U32                                 mNameHash = 0;
+				TResourceId                         mResourceId = TResourceId::Invalid;
+				TypeId                              mResourceTypeId = TypeId::Invalid;
+				E_RESOURCE_LOADING_PRIORITY         mPriority = E_RESOURCE_LOADING_PRIORITY::NORMAL;
+				std::vector<TResourceLoadingHandle> mDependencies;
+				E_RESOURCE_LOADING_STATUS           mStatus = E_RESOURCE_LOADING_STATUS::INVALID;
+				U32                                 mGeneration = 0;
+				U32                                 mFinishedTick = 0;
+				TJobHandle                          mJobHandle;
+				std::shared_ptr<std::atomic<bool>>  mpUploadFence; ///< Is set by a main thread's callback which goes after callbacks of the resource's loader
+			} TAsyncLoadingRequest;
+
+			typedef struct TQueuedAsyncLoadingRequest
+			{
+				E_RESOURCE_LOADING_PRIORITY mPriority;
+				U32                         mSequenceIndex; ///< Requests with the same priority are started in FIFO order
+				U32                         mSlotIndex;
+				U32                         mGeneration;
+
+				TDE2_API bool operator< (const TQueuedAsyncLoadingRequest& other) const
+				{
+					return (mPriority < other.mPriority) || ((mPriority == other.mPriority) && (mSequenceIndex > other.mSequenceIndex));
+				}
+			} TQueuedAsyncLoadingRequest;
+
+			typedef std::vector<TAsyncLoadingRequest>                     TAsyncLoadingRequestsArray;
+
+			typedef struct TDeferredLoadingAction
+			{
+				std::vector<TResourceLoadingHandle> mDependencies;
+				std::function<void()>               mAction;
+			} TDeferredLoadingAction;
+
+			typedef std::vector<TDeferredLoadingAction>                   TDeferredLoadingActionsArray;
+
+			typedef std::vector<std::tuple<U32, U32>>                     TAsyncLoadingSlotsArray; ///< Slots and generations of requests
+
+			typedef std::priority_queue<TQueuedAsyncLoadingRequest>       TAsyncLoadingRequestsQueue;
 		public:
 			/*!
 				\brief The method initializes an inner state of a resource manager
@@ -159,6 +243,57 @@ namespace TDEngine2
 
 			TDE2_API TResourceId Load(const std::string& name, TypeId typeId, E_RESOURCE_LOADING_POLICY loadingPolicy) override;
 
+			/*!
+				\brief The method enqueues loading of a resource and returns immediately. Data of the resource is read and
+				decoded on worker threads, GPU data is uploaded from the main thread by the resource's loader. Requests with
+				greater priorities are started first
+
+				\param[in] name A name of a resource that should be loaded
+				\param[in] typeId A identifier of type which we try to load
+				\param[in] params Priority of the request and requests it depends on
+
+				\return A handle of the request, an invalid one if there is no factory for the type
+			*/
+
+			TDE2_API TResourceLoadingHandle LoadAsync(const std::string& name, TypeId typeId, const TAsyncLoadingParams& params) override;
+
+			/*!
+				\return The method returns a current stage of the request
+			*/
+
+			TDE2_API E_RESOURCE_LOADING_STATUS GetLoadingStatus(const TResourceLoadingHandle& handle) const override;
+
+			/*!
+				\brief The method blocks until the request is finished. If it's called from the main thread, the thread
+				executes its queue of callbacks while it waits, otherwise the last stage is completed within Update
+
+				\return The method returns a final status of the request
+			*/
+
+			TDE2_API E_RESOURCE_LOADING_STATUS WaitForLoading(const TResourceLoadingHandle& handle) override;
+
+			/*!
+				\brief The method cancels the request if it's not started yet. Requests which depend on the cancelled one fail.
+				The resource stays registered in RST_PENDING state, so it could be loaded later
+
+				\return RC_OK if the request was cancelled, RC_FAIL if it's already started or finished
+			*/
+
+			TDE2_API E_RESULT_CODE CancelLoading(const TResourceLoadingHandle& handle) override;
+
+			/*!
+				\brief The method executes the action on the main thread when all the requests are finished. A loader uses it to bind
+				a resource to its dependencies that are loaded asynchronously. If it's called from the main thread the method
+				waits for the requests and executes the action at once, otherwise the action is executed within Update
+
+				\param[in] params Requests that should be finished before the action, the priority isn't used
+				\param[in] action A callback which is executed on the main thread regardless of final statuses of the requests
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE ExecuteAfterLoading(const TAsyncLoadingParams& params, const std::function<void()>& action) override;
+
 			/*!
 				\brief The method decrements internal reference counter of the resource which corresponds to given identifier
 				If the coutner goes down to zero the resource is unloaded and destroyed
@@ -199,11 +334,133 @@ namespace TDEngine2
 			*/
 
 			TDE2_API TResourceId GetResourceId(const std::string& name) const override;
+
+			/*!
+				\brief The method is called once per frame from the main thread. It reloads evicted resources which were
+				requested since the last call and evicts least recently used ones if the memory budget is exceeded
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE Update() override;
+
+			/*!
+				\brief The method sets up a limit of memory which could be occupied by loaded resources. Only resources
+				which were loaded via Load and aren't referenced outside of the manager are evicted
+
+				\param[in] budget A size in bytes, 0 means that the budget is unlimited
+			*/
+
+			TDE2_API void SetMemoryBudget(USIZE budget) override;
+
+			TDE2_API USIZE GetMemoryBudget() const override;
+
+			/*!
+				\return The method returns a size of memory that was occupied by loaded resources when Update was called last time
+			*/
+
+			TDE2_API USIZE GetMemoryUsage() const override;
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CResourceManager)
 
-			TDE2_API TResourceId _loadResource(TypeId resourceTypeId, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy) override;
-			TDE2_API TResourceId _loadResourceWithResourceProviderInfo(TypeId resourceTypeId, TypeId factoryTypeId, TypeId loaderTypeId, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy) override;
+			TDE2_API TResourceId _loadResource(TypeId resourceTypeId, const std::string& name, U32 nameHash, E_RESOURCE_LOADING_POLICY loadingPolicy) override;
+			TDE2_API TResourceId _loadResourceWithResourceProviderInfo(TypeId resourceTypeId, TypeId factoryTypeId, TypeId loaderTypeId, const std::string& name, U32 nameHash,
+																	   E_RESOURCE_LOADING_POLICY loadingPolicy) override;
+
+			/*!
+				\brief The method loads a pending resource. If the resource is being loaded by another thread the method
+				waits until the loading is finished instead of running it twice
+			*/
+
+			TDE2_API E_RESULT_CODE _loadResourceOnce(const TResourceId& resourceId, const std::string& name, U32 nameHash);
+			TDE2_API E_RESULT_CODE _loadClaimedResource(TPtr<IResource> pResource, const TResourceId& resourceId, const std::string& name, U32 nameHash);
+
+			/*!
+				\brief The method is used by synchronous loading on the main thread. A loader which was executed by a worker
+				could leave the resource in RST_LOADING state until its callbacks upload data on the main thread, so the
+				method executes the main thread's queue until the resource is ready. Streamed resources aren't awaited
+			*/
+
+			TDE2_API void _waitForDeferredUploading(const TPtr<IResource>& pResource);
+
+			TDE2_API TResourceId _findResourceId(const std::string& name, U32 nameHash, bool* pIsBeingLoaded = nullptr) const;
+
+			/*!
+				\brief The method adds a new resource into the registry. If a resource with the same name was added by
+				another thread in the meantime, the existing one is returned and pResource is discarded
+
+				\param[in] claimLoading If true the current thread becomes responsible for loading of the added resource
+				\param[in] isEvictable If true the resource could be evicted when the memory budget is exceeded
+
+				\return The method returns an identifier of the resource and a flag which is true if pResource was added
+			*/
+
+			TDE2_API std::tuple<TResourceId, bool> _registerResource(const std::string& name, U32 nameHash, TPtr<IResource> pResource, bool claimLoading, bool isEvictable);
+
+			/*!
+				\brief The method creates a new resource with a factory of the given type. The resource isn't registered
+			*/
+
+			TDE2_API TPtr<IResource> _createResourceForLoading(TypeId resourceTypeId, TypeId factoryTypeId, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy);
+
+			/*!
+				\brief The method unloads data of the resource and returns it back to RST_PENDING state. The resource is
+				claimed for the time of eviction, so it can't be loaded concurrently
+
+				\return RC_OK if the resource was evicted, or some other code if it's referenced, being loaded or doesn't support eviction
+			*/
+
+			TDE2_API E_RESULT_CODE _evictResource(const TResourceId& resourceId);
+
+			/*!
+				\brief The method collects loaded resources that weren't used within the current frame and aren't referenced
+				outside of the manager. Candidates are ordered from the least recently used ones
+			*/
+
+			TDE2_API void _collectEvictionCandidates(TEvictionCandidatesArray& candidates) const;
+
+			/*!
+				\brief The method enqueues a reload of an evicted resource, the request is processed within Update
+			*/
+
+			TDE2_API void _requestEvictedResourceReload(const TResourceId& resourceId) const;
+
+			TDE2_API void _reloadEvictedResources();
+
+			/*!
+				\brief The method is executed by a worker thread, or by the main thread if the resource's loader requires it
+			*/
+
+			TDE2_API void _processAsyncLoadingRequest(U32 slotIndex, U32 generation);
+
+			/*!
+				\brief The method completes requests which GPU data was uploaded and recycles requests that were finished
+				at least a frame ago. The method is called from the main thread
+			*/
+
+			TDE2_API void _updateAsyncLoadingRequests();
+
+			/*!
+				\brief The method starts requests which dependencies are completed while there are free workers.
+				The method should be called when mAsyncLoadingMutex is locked
+
+				\return Slots and generations of started requests which jobs should be submitted via _submitAsyncLoadingJobs
+			*/
+
+			TDE2_API TAsyncLoadingSlotsArray _dispatchAsyncLoadingRequestsInternal();
+
+			/*!
+				\brief The method submits jobs of started requests. The method should be called when mAsyncLoadingMutex
+				is unlocked, because workers lock it too
+
+				\param[in] requests Slots and generations which are returned by _dispatchAsyncLoadingRequestsInternal
+			*/
+
+			TDE2_API void _submitAsyncLoadingJobs(const TAsyncLoadingSlotsArray& requests);
+
+			TDE2_API E_RESOURCE_LOADING_STATUS _getLoadingStatusInternal(const TResourceLoadingHandle& handle) const;
+
+			TDE2_API void _finishAsyncLoadingRequestInternal(TAsyncLoadingRequest& request, E_RESOURCE_LOADING_STATUS status);
 
 			TDE2_API TResourceId _createResource(TypeId resourceTypeId, const std::string& name, const TBaseResourceParameters& params) override;
 			
@@ -215,7 +472,13 @@ namespace TDEngine2
 			TDE2_API std::vector<std::string> _getResourcesListByType(TypeId resourceTypeId) const override;
 
 			TDE2_API E_RESULT_CODE _onFreeInternal() override;
+
+			TDE2_API static U32 _getResourcesMapShardIndex(U32 nameHash);
 		protected:
+			static constexpr U32 mResourcesMapShardsCount = 16;
+
+			static_assert(!(mResourcesMapShardsCount & (mResourcesMapShardsCount - 1)), "The number of shards should be a power of two");
+
 			TResourceLoadersMap         mResourceLoadersMap;
 
 			TResourceLoadersContainer   mRegisteredResourceLoaders;
@@ -224,7 +487,7 @@ namespace TDEngine2
 
 			TResourceFactoriesContainer mRegisteredResourceFactories;
 
-			TResourcesMap               mResourcesMap;
+			std::array<TResourcesMapShard, mResourcesMapShardsCount> mResourcesMapShards;
 
 			TResourcesContainer         mResources;
 
@@ -234,6 +497,36 @@ namespace TDEngine2
 
 			TPtr<IJobManager>           mpJobManager;
 
-			mutable std::mutex          mMutex;
+			mutable std::mutex          mMutex; ///< The mutex guards registries of loaders, factories and policies
+
+			std::atomic<U32>            mCurrTick;
+
+			std::atomic<USIZE>          mMemoryBudget;
+			std::atomic<USIZE>          mMemoryUsage;
+
+			TResourcesMemoryInfo        mMemoryInfo; ///< Is accessed only within Update
+
+			mutable TEvictedResourcesSet mEvictedResources;
+			mutable TResourcesIdsArray  mReloadRequests;
+
+			mutable std::mutex          mEvictionMutex; ///< The mutex guards the set of evicted resources and reload requests
+
+			TAsyncLoadingRequestsArray  mAsyncLoadingRequests;
+			std::vector<U32>            mFreeAsyncLoadingRequestsSlots;
+			std::vector<U32>            mWaitingAsyncLoadingRequests; ///< Slots of requests which wait for their dependencies
+
+			TAsyncLoadingSlotsArray     mMainThreadAsyncLoadingRequests; ///< Slots and generations of started requests which loaders require the main thread
+
+			TDeferredLoadingActionsArray mDeferredLoadingActions; ///< Actions of loaders which wait for asynchronous requests, see ExecuteAfterLoading
+
+			TAsyncLoadingRequestsQueue  mQueuedAsyncLoadingRequests;
+
+			U32                         mAsyncLoadingSequenceIndex;
+			U32                         mActiveAsyncLoadingRequestsCount;
+			U32                         mMaxActiveAsyncLoadingRequestsCount;
+
+			std::thread::id             mMainThreadId;
+
+			mutable std::mutex          mAsyncLoadingMutex; ///< The mutex guards all the state of asynchronous loading requests
 	};
 }
@@ -0,0 +1,87 @@
+/*!
+	\file CWorkStealingQueue.h
+	\date 16.10.2026
+	\authors Kasimov Ildar
+*/
+
+#pragma once
+
+
+#include "../utils/Types.h"
+#include "../utils/Utils.h"
+#include <atomic>
+#include <memory>
+
+
+namespace TDEngine2
+{
+	/*!
+		class CWorkStealingQueue
+
+		\brief The class is a bounded lock-free double-ended queue (Chase-Lev). Only the thread which owns the queue
+		can push and pop values from its bottom, while any other thread can steal values from its top.
+
+		The queue stores indices of jobs, so it never allocates memory after the creation
+	*/
+
+	class CWorkStealingQueue
+	{
+		public:
+			typedef U32 TValueType;
+		public:
+			/*!
+				\brief The main constructor of the type
+
+				\param[in] capacity A maximal number of values within the queue, should be a power of two
+			*/
+
+			TDE2_API explicit CWorkStealingQueue(U32 capacity);
+
+			TDE2_API ~CWorkStealingQueue() = default;
+
+			/*!
+				\brief The method pushes a value into the bottom of the queue. Should be called only by an owner of the queue
+
+				\param[in] value A value that will be pushed
+
+				\return The method returns false if the queue is full
+			*/
+
+			TDE2_API bool Push(TValueType value);
+
+			/*!
+				\brief The method pops a value from the bottom of the queue. Should be called only by an owner of the queue
+
+				\param[out] value A retrieved value
+
+				\return The method returns false if the queue is empty or the last value was stolen by another thread
+			*/
+
+			TDE2_API bool Pop(TValueType& value);
+
+			/*!
+				\brief The method retrieves a value from the top of the queue. The method is safe to be called from any thread
+
+				\param[out] value A retrieved value
+
+				\return The method returns false if the queue is empty or another thread has won a race for the value
+			*/
+
+			TDE2_API bool Steal(TValueType& value);
+
+			TDE2_API bool IsEmpty() const;
+
+			TDE2_API U32 GetCapacity() const;
+		private:
+			TDE2_API CWorkStealingQueue(const CWorkStealingQueue&) = delete;
+			TDE2_API CWorkStealingQueue& operator= (const CWorkStealingQueue&) = delete;
+		private:
+			std::unique_ptr<std::atomic<TValueType>[]> mpBuffer;
+
+			U32                                        mCapacity;
+			U32                                        mMask;
+
+			alignas(CacheLineSize) std::atomic<I64>    mTop;
+			alignas(CacheLineSize) std::atomic<I64>    mBottom;
+	};
+}
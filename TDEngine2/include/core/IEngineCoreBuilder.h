@@ -9,6 +9,7 @@
 #include "../utils/Types.h"
 #include "../utils/Utils.h"
 #include "../core/IBaseObject.h"
+#include "../core/IJobManager.h"
 #include <string>
 #include <thread>
 
@@ -89,12 +90,12 @@ namespace TDEngine2
 			/*!
 				\brief The method tries to configure a job manager
 
-				\param[in] maxNumOfThreads A number of worker threads
+				\param[in] params Parameters of the job manager which include a number of worker threads
 
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API virtual E_RESULT_CODE _configureJobManager(U32 maxNumOfThreads = std::thread::hardware_concurrency() - 1) = 0;
+			TDE2_API virtual E_RESULT_CODE _configureJobManager(const TJobManagerInitParams& params) = 0;
 
 			/*!
 				\brief The method tries to configure a plugin manager. SHOULD be called
@@ -553,6 +553,23 @@ namespace TDEngine2
 	};
 
 
+	/*!
+		enum class E_PACKAGE_ENTRY_CODEC
+
+		\brief The enumeration contains all codecs which files within packages could be compressed with.
+		Only zlib is vendored within deps/, so there are no other codecs for now
+
+		\todo Add LZ4 when its sources are vendored within deps/ like zlib's ones. The value should be appended,
+		because codecs are stored within packages' tables
+	*/
+
+	enum class E_PACKAGE_ENTRY_CODEC : U8
+	{
+		NONE,
+		ZLIB,
+	};
+
+
 	typedef struct TPackageFileEntryInfo
 	{
 		std::string mFilename;
@@ -561,9 +578,25 @@ namespace TDEngine2
 		U64  mDataBlockSize = 0;
 		U64  mCompressedBlockSize = 0;
 		bool mIsCompressed = false;
+
+		E_PACKAGE_ENTRY_CODEC mCodec = E_PACKAGE_ENTRY_CODEC::NONE;
+		U32                   mChunkSize = 0; ///< Chunks are compressed independently, 0 means the whole block is compressed at once
 	} TPackageFileEntryInfo, *TPackageFileEntryInfoPtr;
 
 
+	/*!
+		struct TPackageFileDataView
+
+		\brief The type is a non-owning view of a file's data which is stored within a package
+	*/
+
+	typedef struct TPackageFileDataView
+	{
+		const U8* mpData = nullptr;
+		USIZE     mSize = 0;
+	} TPackageFileDataView, *TPackageFileDataViewPtr;
+
+
 	/*!
 		\brief The interface represents a functionality of a packages file reader
 	*/
@@ -582,6 +615,28 @@ namespace TDEngine2
 
 			TDE2_API virtual std::vector<U8> ReadFileBytes(const std::string& path) = 0;
 
+			/*!
+				\brief The method returns a view of an uncompressed file's data without copying it. The view stays
+				valid until the package is closed
+
+				\return The view of the data, mpData is nullptr if the file isn't found, it's compressed or 
+				the package couldn't be mapped into memory
+			*/
+
+			TDE2_API virtual TPackageFileDataView GetFileDataView(const std::string& path) const = 0;
+
+			/*!
+				\brief The method reads a part of a file. Only chunks which intersect the range are decompressed
+
+				\param[in] path A path of a file within the package
+				\param[in] offset An offset in bytes from the beginning of the uncompressed file
+				\param[in] size A number of bytes that should be read, the range is clamped by the file's size
+
+				\return The array of decompressed bytes, it's empty if the file isn't found or the range is out of the file
+			*/
+
+			TDE2_API virtual std::vector<U8> ReadFileRange(const std::string& path, U64 offset, U64 size) = 0;
+
 			TDE2_API virtual const struct TPackageFileHeader& GetPackageHeader() const = 0;
 			TDE2_API virtual const std::vector<TPackageFileEntryInfo>& GetFilesTable() const = 0;
 		protected:
@@ -607,12 +662,24 @@ namespace TDEngine2
 #endif
 			WriteFile(const std::string& path, const T& file, bool useCompression = false)
 			{
-				return _writeFileInternal(T::GetTypeId(), path, dynamic_cast<const IFileReader&>(file), useCompression);
+				return _writeFileInternal(T::GetTypeId(), path, dynamic_cast<const IFileReader&>(file), useCompression ? E_PACKAGE_ENTRY_CODEC::ZLIB : E_PACKAGE_ENTRY_CODEC::NONE);
+			}
+
+			template <typename T>
+			TDE2_API
+#if _HAS_CXX17
+			std::enable_if_t<std::is_base_of_v<IFileReader, T>, E_RESULT_CODE>
+#else
+			typename std::enable_if<std::is_base_of<IFileReader, T>::value, E_RESULT_CODE>::type
+#endif
+			WriteFile(const std::string& path, const T& file, E_PACKAGE_ENTRY_CODEC codec)
+			{
+				return _writeFileInternal(T::GetTypeId(), path, dynamic_cast<const IFileReader&>(file), codec);
 			}
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(IPackageFileWriter)
 
-			TDE2_API virtual E_RESULT_CODE _writeFileInternal(TypeId fileTypeId, const std::string& path, const IFileReader& file, bool useCompression) = 0;
+			TDE2_API virtual E_RESULT_CODE _writeFileInternal(TypeId fileTypeId, const std::string& path, const IFileReader& file, E_PACKAGE_ENTRY_CODEC codec) = 0;
 	};
 
 
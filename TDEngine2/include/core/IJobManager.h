@@ -11,66 +11,72 @@
 #include "../utils/Utils.h"
 #include "IEngineSubsystem.h"
 #include <functional>
-#include <memory>
+#include <atomic>
+#include <limits>
 
 
 namespace TDEngine2
 {
+	typedef std::function<void()> TJobCallback;
+
+
 	/*!
-		interface IJob
+		struct TJobCounter
 
-		\brief The interface represents a single job's functionality
+		\brief The type is used to track a group of jobs. The counter is increased when a job is submitted
+		and decreased when the job is completed, so a thread can wait until the whole group is done
 	*/
 
-	struct IJob
+	typedef struct TJobCounter
 	{
-		/*!
-			\brief The operator executes current job
-		*/
+		std::atomic<U32> mValue { 0 };
+	} TJobCounter, *TJobCounterPtr;
 
-		TDE2_API virtual void operator()() = 0;
-	};
 
+	/*!
+		struct TJobHandle
 
-	template <typename... TArgs>
-	struct TJob: public IJob
+		\brief The type is a weak reference to a submitted job. The handle becomes completed when
+		the job's been executed, it stays valid even if the storage of the job is reused
+	*/
+
+	typedef struct TJobHandle
 	{
-		protected:
-			typedef std::function<void(TArgs...)> TJobCallback;
-			typedef std::tuple<TArgs...>          TArguments;
-		public:
-			/*!
-				\brief The main constructor of the type
+		TDE2_STATIC_CONSTEXPR U32 mInvalidSlotIndex = (std::numeric_limits<U32>::max)();
 
-				\param[in] callback A job's callback
-				\param[in] args An arguments that should be passed into a job
-			*/
+		U32 mSlotIndex  = mInvalidSlotIndex;
+		U32 mGeneration = 0;
 
-			TDE2_API TJob(const TJobCallback& callback, TArgs... args);
+		TDE2_API bool IsValid() const { return mInvalidSlotIndex != mSlotIndex; }
+	} TJobHandle, *TJobHandlePtr;
 
-			/*!
-				\brief The operator executes current job
-			*/
 
-			TDE2_API void operator()() override;
-		protected:
-			TJobCallback mJobCallback;
-			TArguments   mArguments;
-	};
+	/*!
+		struct TJobManagerInitParams
+
+		\brief The type contains parameters of a job manager's initialization
+	*/
 
-	
-	template <typename... TArgs>
-	TJob<TArgs...>::TJob(const TJobCallback& callback, TArgs... args) :
-		mJobCallback(callback), mArguments(args...)
+	typedef struct TJobManagerInitParams
 	{
-	}
+		U32 mMaxNumOfThreads = 1;
+		F32 mMainThreadQueueTimeBudget = 2.0f; ///< Milliseconds per frame which are spent on the main thread's callbacks, a non-positive value means no limit
+	} TJobManagerInitParams, *TJobManagerInitParamsPtr;
 
-	template <typename... TArgs>
-	void TJob<TArgs...>::operator() ()
+
+	/*!
+		struct TMainThreadQueueStats
+
+		\brief The type contains statistics of the last processing of main thread's callbacks
+	*/
+
+	typedef struct TMainThreadQueueStats
 	{
-		mJobCallback(std::get<TArgs>(mArguments)...);
-	}
-	
+		U32 mProcessedCallbacksCount = 0;
+		U32 mPendingCallbacksCount = 0; ///< A number of callbacks which are left for next frames
+		F32 mDrainTime = 0.0f;          ///< In milliseconds
+	} TMainThreadQueueStats, *TMainThreadQueueStatsPtr;
+
 
 	/*!
 		interface IJobManager
@@ -80,21 +86,24 @@ namespace TDEngine2
 
 	class IJobManager : public IEngineSubsystem
 	{
+		public:
+			typedef std::function<void(USIZE, USIZE)> TParallelForAction; ///< Accepts [first; last) range of indices
 		public:
 			/*!
-				\brief The method initializes an inner state of a resource manager
+				\brief The method initializes an inner state of a job manager
 
-				\param[in] maxNumOfThreads A maximum number of threads that will be created and processed by the manager
+				\param[in] params Parameters of the manager which include a maximum number of worker threads
 
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API virtual E_RESULT_CODE Init(U32 maxNumOfThreads) = 0;
+			TDE2_API virtual E_RESULT_CODE Init(const TJobManagerInitParams& params) = 0;
 
 			/*!
 				\brief The method pushes specified job into a queue for an execution
 
-				\param[in] pJob A pointer to IJob's implementation
+				\param[in] jobCallback A callback of the job
+				\param[in] args Arguments that are passed into the callback
 
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
@@ -102,9 +111,56 @@ namespace TDEngine2
 			template <typename... TArgs>
 			TDE2_API E_RESULT_CODE SubmitJob(std::function<void (TArgs...)> jobCallback, TArgs... args)
 			{
-				return _submitJob(std::make_unique<TJob<TArgs...>>(jobCallback, std::forward<TArgs>(args)...));
+				return _submitJob(nullptr, [jobCallback, args...] { jobCallback(args...); }).IsValid() ? RC_OK : RC_FAIL;
+			}
+
+			/*!
+				\brief The method pushes specified job into a queue of the calling thread. The job can be stolen by any worker
+
+				\param[in, out] pCounter A counter which is increased now and decreased when the job is completed. Can be nullptr
+				\param[in] job A callback of the job
+
+				\return The method returns a handle of the job, or an invalid handle if the job wasn't submitted
+			*/
+
+			TDE2_API TJobHandle SubmitJob(TJobCounter* pCounter, TJobCallback job)
+			{
+				return _submitJob(pCounter, std::move(job));
 			}
 
+			/*!
+				\brief The method submits a job which starts only when the given one is completed. If the parent job is
+				already completed the continuation is submitted immediately
+
+				\param[in] parentJobHandle A handle of a job which should be completed before the continuation
+				\param[in, out] pCounter A counter which is increased now and decreased when the continuation is completed. Can be nullptr
+				\param[in] job A callback of the continuation
+
+				\return The method returns a handle of the continuation, or an invalid handle if it wasn't submitted
+			*/
+
+			TDE2_API virtual TJobHandle ContinueWith(const TJobHandle& parentJobHandle, TJobCounter* pCounter, TJobCallback job) = 0;
+
+			/*!
+				\brief The method blocks until the counter reaches the given value. The calling thread executes pending jobs
+				while it waits, so it's safe to call the method from jobs
+
+				\param[in] counter A counter that's passed into SubmitJob
+				\param[in] value A value which the counter should reach
+			*/
+
+			TDE2_API virtual void WaitForJobCounter(const TJobCounter& counter, U32 value = 0) = 0;
+
+			/*!
+				\brief The method blocks until the job is completed. The calling thread executes pending jobs while it waits
+
+				\param[in] jobHandle A handle of the job
+			*/
+
+			TDE2_API virtual void WaitForJob(const TJobHandle& jobHandle) = 0;
+
+			TDE2_API virtual bool IsJobCompleted(const TJobHandle& jobHandle) const = 0;
+
 			/*!
 				\brief The method allows to execute some code from main thread nomatter from which thread it's called
 
@@ -116,16 +172,49 @@ namespace TDEngine2
 			TDE2_API virtual E_RESULT_CODE ExecuteInMainThread(const std::function<void()>& action = nullptr) = 0;
 
 			/*!
-				\brief The method unrolls main thread's queue of actions that should be executed only in the main thread
+				\brief The method unrolls main thread's queue of actions that should be executed only in the main thread.
+				The method is called every frame and stops when the time budget is exceeded, the rest of callbacks are
+				executed on next frames
 			*/
 
 			TDE2_API virtual void ProcessMainThreadQueue() = 0;
 
+			/*!
+				\brief The method returns statistics of the last ProcessMainThreadQueue's invocation
+
+				\return The method returns statistics of the last ProcessMainThreadQueue's invocation
+			*/
+
+			TDE2_API virtual const TMainThreadQueueStats& GetMainThreadQueueStats() const = 0;
+
+			/*!
+				\brief The method returns a number of worker threads which execute submitted jobs
+
+				\return The method returns a number of worker threads
+			*/
+
+			TDE2_API virtual U32 GetWorkerThreadsCount() const = 0;
+
+			/*!
+				\brief The method splits [0; elementsCount) range into subranges and processes them on worker threads.
+				Sizes of subranges are multiples of a number of elements that fit into a single cache line, so
+				neighbouring subranges don't write into the same cache line. The calling thread processes a subrange too and
+				then helps to execute pending jobs until all of subranges are done (join barrier)
+
+				\param[in] elementsCount A total number of elements
+				\param[in] elementSize A size of a single element of processed arrays in bytes
+				\param[in] action A callback that processes [first; last) range
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE ParallelFor(USIZE elementsCount, USIZE elementSize, const TParallelForAction& action) = 0;
+
 			TDE2_API static E_ENGINE_SUBSYSTEM_TYPE GetTypeID() { return EST_JOB_MANAGER; }
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(IJobManager)
 
-			TDE2_API virtual E_RESULT_CODE _submitJob(std::unique_ptr<IJob> pJob) = 0;
+			TDE2_API virtual TJobHandle _submitJob(TJobCounter* pCounter, TJobCallback&& job) = 0;
 	};
 
 
@@ -25,6 +25,11 @@ namespace TDEngine2
 		TDE2_API virtual TypeId GetResourceTypeId() const		\
 		{														\
 			return Type::GetTypeId();							\
+		}														\
+																\
+		TDE2_API virtual const C8* GetResourceTypeName() const	\
+		{														\
+			return #Type;										\
 		}
 
 
@@ -63,6 +68,15 @@ namespace TDEngine2
 
 			TDE2_API virtual E_RESULT_CODE Reset() = 0;
 
+			/*!
+				\brief The method releases loaded data of the resource but keeps the object itself, so it
+				could be loaded again later. The method is used by the resource manager when the memory budget is exceeded
+
+				\return RC_OK if everything went ok, RC_NOT_IMPLEMENTED_YET if the resource doesn't support eviction
+			*/
+
+			TDE2_API virtual E_RESULT_CODE Evict() = 0;
+
 			/*!
 				\brief The method is called after the resource has been created
 			*/
@@ -113,6 +127,26 @@ namespace TDEngine2
 			*/
 
 			TDE2_API virtual TypeId GetResourceTypeId() const = 0;
+
+			/*!
+				\return The method returns a name of the underlying type, the name is used to group statistics of resources
+			*/
+
+			TDE2_API virtual const C8* GetResourceTypeName() const = 0;
+
+			/*!
+				\return The method returns an approximate size of memory in bytes which is occupied by loaded data of the resource
+			*/
+
+			TDE2_API virtual USIZE GetMemorySize() const = 0;
+
+			/*!
+				\brief The method stores a number of the resource manager's frame when the resource was accessed last time
+			*/
+
+			TDE2_API virtual void SetLastUsedTick(U32 tick) = 0;
+
+			TDE2_API virtual U32 GetLastUsedTick() const = 0;
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(IResource)
 
@@ -42,6 +42,15 @@ namespace TDEngine2
 			*/
 
 			TDE2_API virtual TypeId GetResourceTypeId() const = 0;
+
+			/*!
+				\brief Asynchronous loading requests execute loaders on worker threads. A loader that calls graphics API
+				directly within LoadResource should return true, then its requests are executed from the main thread
+
+				\return The method returns true if LoadResource could be called only from the main thread
+			*/
+
+			TDE2_API virtual bool IsMainThreadRequired() const { return false; }
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(IResourceLoader)
 	};
@@ -12,6 +12,9 @@
 #include "../utils/Utils.h"
 #include <type_traits>
 #include <string>
+#include <vector>
+#include <limits>
+#include <functional>
 
 
 namespace TDEngine2
@@ -32,6 +35,57 @@ namespace TDEngine2
 	};
 
 
+	/*!
+		struct TResourceNameHash
+
+		\brief The type stores a name of a resource with its precomputed hash. Systems which look up the same
+		resource often could keep an instance of the type to avoid rehashing of the name on each call of Load
+	*/
+
+	typedef struct TResourceNameHash
+	{
+		explicit TResourceNameHash(const std::string& name) :
+			mName(name), mHash(ComputeHash(name.c_str()))
+		{
+		}
+
+		std::string mName;
+		U32         mHash;
+	} TResourceNameHash, *TResourceNameHashPtr;
+
+
+	/*!
+		struct TResourceLoadingHandle
+
+		\brief The type is a weak reference to an asynchronous loading request. A request's storage is reused
+		when the request is finished and a frame has passed, the status of such handle is restored from the resource's state
+	*/
+
+	typedef struct TResourceLoadingHandle
+	{
+		TDE2_STATIC_CONSTEXPR U32 mInvalidSlotIndex = (std::numeric_limits<U32>::max)();
+
+		U32         mSlotIndex  = mInvalidSlotIndex;
+		U32         mGeneration = 0;
+		TResourceId mResourceId = TResourceId::Invalid; ///< The resource is registered at once, but its data isn't available till the request is completed
+
+		TDE2_API bool IsValid() const { return mInvalidSlotIndex != mSlotIndex; }
+	} TResourceLoadingHandle, *TResourceLoadingHandlePtr;
+
+
+	/*!
+		struct TAsyncLoadingParams
+
+		\brief The type contains parameters of an asynchronous loading request
+	*/
+
+	typedef struct TAsyncLoadingParams
+	{
+		E_RESOURCE_LOADING_PRIORITY         mPriority = E_RESOURCE_LOADING_PRIORITY::NORMAL;
+		std::vector<TResourceLoadingHandle> mDependencies; ///< The request isn't started until all of these are completed, e.g. a material waits for its shader
+	} TAsyncLoadingParams, *TAsyncLoadingParamsPtr;
+
+
 	TDE2_DECLARE_SCOPED_PTR(IJobManager)
 	TDE2_DECLARE_SCOPED_PTR(IResourceFactory)
 	TDE2_DECLARE_SCOPED_PTR(IResourceLoader)
@@ -101,7 +155,22 @@ namespace TDEngine2
 			TResourceId
 			Load(const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy = E_RESOURCE_LOADING_POLICY::DEFAULT)
 			{
-				return _loadResource(T::GetTypeId(), name, loadingPolicy);
+				return _loadResource(T::GetTypeId(), name, ComputeHash(name.c_str()), loadingPolicy);
+			}
+
+			/*!
+				\brief The method is the same as Load<T>(name) but doesn't compute a hash of the name
+
+				\param[in] name A name of a resource with its precomputed hash
+				\param[in] loadingPolicy Determines a way the resource will be loaded. Does it block execution or runs in asynchrous manner
+
+				\return A handle of loaded resource, TResourceId::Invalid if some error has happened
+			*/
+
+			template <typename T>
+			TResourceId Load(const TResourceNameHash& name, E_RESOURCE_LOADING_POLICY loadingPolicy = E_RESOURCE_LOADING_POLICY::DEFAULT)
+			{
+				return _loadResource(T::GetTypeId(), name.mName, name.mHash, loadingPolicy);
 			}
 
 			/*!
@@ -122,7 +191,21 @@ namespace TDEngine2
 #endif
 			Load(const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy = E_RESOURCE_LOADING_POLICY::DEFAULT)
 			{
-				return _loadResourceWithResourceProviderInfo(T::GetTypeId(), TResourceProviderInfo::GetFactoryResourceId(), TResourceProviderInfo::GetLoaderResourceId(), name, loadingPolicy);
+				return _loadResourceWithResourceProviderInfo(T::GetTypeId(), TResourceProviderInfo::GetFactoryResourceId(), TResourceProviderInfo::GetLoaderResourceId(), 
+															 name, ComputeHash(name.c_str()), loadingPolicy);
+			}
+
+			template <typename T, typename TResourceProviderInfo>
+			TDE2_API
+#if _HAS_CXX17
+			std::enable_if_t<std::is_base_of_v<IResource, T>, TResourceId>
+#else
+			typename std::enable_if<std::is_base_of<IResource, T>::value, TResourceId>::type
+#endif
+			Load(const TResourceNameHash& name, E_RESOURCE_LOADING_POLICY loadingPolicy = E_RESOURCE_LOADING_POLICY::DEFAULT)
+			{
+				return _loadResourceWithResourceProviderInfo(T::GetTypeId(), TResourceProviderInfo::GetFactoryResourceId(), TResourceProviderInfo::GetLoaderResourceId(), 
+															 name.mName, name.mHash, loadingPolicy);
 			}
 
 			/*!
@@ -138,6 +221,72 @@ namespace TDEngine2
 
 			TDE2_API virtual TResourceId Load(const std::string& name, TypeId typeId, E_RESOURCE_LOADING_POLICY loadingPolicy = E_RESOURCE_LOADING_POLICY::DEFAULT) = 0;
 
+			/*!
+				\brief The method enqueues loading of a resource and returns immediately. Data of the resource is read and
+				decoded on worker threads, GPU data is uploaded from the main thread by the resource's loader. Requests with
+				greater priorities are started first
+
+				\param[in] name A name of a resource that should be loaded
+				\param[in] params Priority of the request and requests it depends on
+
+				\return A handle of the request which could be polled with GetLoadingStatus or awaited with WaitForLoading
+			*/
+
+			template <typename T>
+			TResourceLoadingHandle LoadAsync(const std::string& name, const TAsyncLoadingParams& params = {})
+			{
+				return LoadAsync(name, T::GetTypeId(), params);
+			}
+
+			/*!
+				\brief The method is the same as LoadAsync<T>(name, params)
+
+				\param[in] name A name of a resource that should be loaded
+				\param[in] typeId A identifier of type which we try to load
+				\param[in] params Priority of the request and requests it depends on
+
+				\return A handle of the request, an invalid one if there is no factory for the type
+			*/
+
+			TDE2_API virtual TResourceLoadingHandle LoadAsync(const std::string& name, TypeId typeId, const TAsyncLoadingParams& params) = 0;
+
+			/*!
+				\return The method returns a current stage of the request
+			*/
+
+			TDE2_API virtual E_RESOURCE_LOADING_STATUS GetLoadingStatus(const TResourceLoadingHandle& handle) const = 0;
+
+			/*!
+				\brief The method blocks until the request is finished. If it's called from the main thread, the thread
+				executes its queue of callbacks while it waits, otherwise the last stage is completed within Update
+
+				\return The method returns a final status of the request
+			*/
+
+			TDE2_API virtual E_RESOURCE_LOADING_STATUS WaitForLoading(const TResourceLoadingHandle& handle) = 0;
+
+			/*!
+				\brief The method cancels the request if it's not started yet. Requests which depend on the cancelled one fail.
+				The resource stays registered in RST_PENDING state, so it could be loaded later
+
+				\return RC_OK if the request was cancelled, RC_FAIL if it's already started or finished
+			*/
+
+			TDE2_API virtual E_RESULT_CODE CancelLoading(const TResourceLoadingHandle& handle) = 0;
+
+			/*!
+				\brief The method executes the action on the main thread when all the requests are finished. A loader uses it to bind
+				a resource to its dependencies that are loaded asynchronously. If it's called from the main thread the method
+				waits for the requests and executes the action at once, otherwise the action is executed within Update
+
+				\param[in] params Requests that should be finished before the action, the priority isn't used
+				\param[in] action A callback which is executed on the main thread regardless of final statuses of the requests
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE ExecuteAfterLoading(const TAsyncLoadingParams& params, const std::function<void()>& action) = 0;
+
 			/*!
 				\brief The method registers specified resource factory within a manager
 
@@ -290,12 +439,39 @@ namespace TDEngine2
 
 			TDE2_API virtual TResourceId GetResourceId(const std::string& name) const = 0;
 
+			/*!
+				\brief The method is called once per frame from the main thread. It reloads evicted resources which were
+				requested since the last call and evicts least recently used ones if the memory budget is exceeded
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE Update() = 0;
+
+			/*!
+				\brief The method sets up a limit of memory which could be occupied by loaded resources. Only resources
+				which were loaded via Load and aren't referenced outside of the manager are evicted
+
+				\param[in] budget A size in bytes, 0 means that the budget is unlimited
+			*/
+
+			TDE2_API virtual void SetMemoryBudget(USIZE budget) = 0;
+
+			TDE2_API virtual USIZE GetMemoryBudget() const = 0;
+
+			/*!
+				\return The method returns a size of memory that was occupied by loaded resources when Update was called last time
+			*/
+
+			TDE2_API virtual USIZE GetMemoryUsage() const = 0;
+
 			TDE2_API static E_ENGINE_SUBSYSTEM_TYPE GetTypeID() { return EST_RESOURCE_MANAGER; }
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(IResourceManager)
 
-			TDE2_API virtual TResourceId _loadResource(TypeId resourceTypeId, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy) = 0;
-			TDE2_API virtual TResourceId _loadResourceWithResourceProviderInfo(TypeId resourceTypeId, TypeId factoryTypeId, TypeId loaderTypeId, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy) = 0;
+			TDE2_API virtual TResourceId _loadResource(TypeId resourceTypeId, const std::string& name, U32 nameHash, E_RESOURCE_LOADING_POLICY loadingPolicy) = 0;
+			TDE2_API virtual TResourceId _loadResourceWithResourceProviderInfo(TypeId resourceTypeId, TypeId factoryTypeId, TypeId loaderTypeId, const std::string& name, U32 nameHash,
+																			   E_RESOURCE_LOADING_POLICY loadingPolicy) = 0;
 
 			TDE2_API virtual TResourceId _createResource(TypeId resourceTypeId, const std::string& name, const TBaseResourceParameters& params) = 0;
 
@@ -9,6 +9,7 @@
 
 #include "CBaseAllocator.h"
 #include "../../utils/Utils.h"
+#include "../../editor/IProfiler.h"
 
 
 namespace TDEngine2
@@ -42,6 +43,7 @@ namespace TDEngine2
 	{
 		public:
 			friend TDE2_API IAllocator* CreatePoolAllocator(USIZE, USIZE, USIZE, E_RESULT_CODE&);
+			friend class CPoolAllocatorsRegistry;
 		public:
 			TDE2_REGISTER_TYPE(CPoolAllocator)
 
@@ -91,6 +93,15 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE Clear() override;
 
+#if TDE2_EDITORS_ENABLED
+			/*!
+				\brief The method assigns a name to the pool. Named pools are tracked by the memory profiler, their statistics
+				are sent once per frame with CPoolAllocatorsRegistry::UpdatePoolsInfo
+			*/
+
+			TDE2_API void SetBlockDebugName(const std::string& blockId) override;
+#endif
+
 			/*!
 				\brief The method returns a size of used memory
 
@@ -98,15 +109,38 @@ namespace TDEngine2
 			*/
 
 			TDE2_API TSizeType GetUsedMemorySize() const override;
+
+			/*!
+				\brief The method returns statistics of the pool, which include its occupancy and fragmentation
+
+				\return The method returns statistics of the pool
+			*/
+
+			TDE2_API TPoolAllocatorInfo GetPoolInfo() const;
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CPoolAllocator)
 
-			TDE2_API void _clearMemoryRegion(TMemoryBlockEntity*& pRegion);
+			/*!
+				\brief The method links all objects' slots of the region into a list
+
+				\return The method returns a number of slots within the region
+			*/
+
+			TDE2_API TSizeType _clearMemoryRegion(TMemoryBlockEntity*& pRegion);
+
+			TDE2_API E_RESULT_CODE _onFreeInternal() override;
+
+			TDE2_API void _updatePoolInfo();
 		protected:
 			TSizeType mObjectSize;
 			TSizeType mObjectAlignment;
 			TSizeType mUsedMemorySize;
 
+			TSizeType mObjectsCapacity;
+			U32       mPeakAllocationsCount;
+
+			bool      mIsPoolInfoDirty;
+
 			void** mppNextFreeBlock;
 	};
 
@@ -137,6 +171,13 @@ namespace TDEngine2
 		public:
 			TDE2_API static IAllocator* GetAllocator(USIZE objectSize, USIZE objectAlignment, USIZE pageSize);
 			TDE2_API static void ClearAllAllocators();
+
+			/*!
+				\brief The function sends statistics of named pools that were changed since the previous call to the memory profiler.
+				Should be called once per frame
+			*/
+
+			TDE2_API static void UpdatePoolsInfo();
 	};
 
 
@@ -148,6 +189,35 @@ namespace TDEngine2
 	class CPoolMemoryAllocPolicy
 	{
 		public:
+			TDE2_STATIC_CONSTEXPR USIZE mAllocatorPageSize = allocatorPageSize;
+		public:
+			/*!
+				\brief The method binds an allocator which serves all instances of T, e.g. a pool which is owned by a factory of T.
+				The allocator can't be replaced while there are living instances which were allocated by the previous one
+
+				\param[in] pAllocator A pointer to an allocator, nullptr resets the binding
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API static E_RESULT_CODE SetAllocator(IAllocator* pAllocator)
+			{
+				if (mpTypeAllocator && mpTypeAllocator->GetAllocationsCount())
+				{
+					return RC_FAIL;
+				}
+
+				mpTypeAllocator = pAllocator;
+
+				return RC_OK;
+			}
+
+			/*!
+				\return The method returns an allocator which serves instances of T
+			*/
+
+			TDE2_API static IAllocator* GetAllocator() { return _getAllocator(); }
+
 			TDE2_API static void* operator new(std::size_t size, const std::nothrow_t&) { return _allocateImpl(size); }
 			TDE2_API static void* operator new[](std::size_t size, const std::nothrow_t&) { return _allocateImpl(size); }
 
@@ -188,4 +258,15 @@ namespace TDEngine2
 	};
 
 	template <typename T, USIZE allocatorPageSize> IAllocator* CPoolMemoryAllocPolicy<T, allocatorPageSize>::mpTypeAllocator = nullptr;
+
+
+	/*!
+		\brief The trait is used to check whether T is derived from CPoolMemoryAllocPolicy or not
+	*/
+
+	template <typename T, typename = void>
+	struct THasPoolMemoryAllocPolicy : std::false_type {};
+
+	template <typename T>
+	struct THasPoolMemoryAllocPolicy<T, decltype(T::mAllocatorPageSize, void())> : std::true_type {};
 }
@@ -0,0 +1,340 @@
+/*!
+	\file CArchetypeStorage.h
+	\date 16.10.2026
+	\authors Kasimov Ildar
+*/
+
+#pragma once
+
+
+#include "../utils/Types.h"
+#include "../utils/Utils.h"
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <memory>
+
+
+namespace TDEngine2
+{
+	class IComponent;
+
+
+	TDE2_DECLARE_HANDLE_TYPE(TArchetypeId);
+
+
+	/*!
+		struct TComponentsMask
+
+		\brief The type is a growable bitset where each bit corresponds to a registered component's type.
+		It's used to match archetypes' signatures against queries without touching sorted arrays of types
+	*/
+
+	typedef struct TComponentsMask
+	{
+		TDE2_API void Set(U32 bitIndex);
+
+		TDE2_API bool Test(U32 bitIndex) const;
+
+		/*!
+			\return The method returns true if all bits of the given mask are set within this one
+		*/
+
+		TDE2_API bool ContainsAll(const TComponentsMask& mask) const;
+
+		/*!
+			\return The method returns true if at least one bit of the given mask is set within this one
+		*/
+
+		TDE2_API bool Intersects(const TComponentsMask& mask) const;
+
+		TDE2_API bool IsEmpty() const;
+
+		/*!
+			\brief The method clears all bits but keeps the memory, so the mask could be reused without allocations
+		*/
+
+		TDE2_API void Reset();
+
+		std::vector<U64> mBits;
+	} TComponentsMask, *TComponentsMaskPtr;
+
+
+	/*!
+		class CArchetype
+
+		\brief The class represents a group of entities which have the same set of components' types (signature).
+		Components of each type are stored within their own contiguous column, so all columns and the entities array
+		are indexed by the same row's index
+	*/
+
+	class CArchetype
+	{
+		public:
+			typedef std::vector<TypeId>                        TComponentsSignature;
+			typedef std::vector<IComponent*>                   TComponentsColumn;
+			typedef std::vector<TComponentsColumn>             TComponentsColumns;
+			typedef std::vector<TEntityId>                     TEntitiesArray;
+			typedef std::unordered_map<TypeId, TArchetypeId>   TArchetypesEdges;
+
+			TDE2_STATIC_CONSTEXPR U32 mInvalidColumnIndex = (std::numeric_limits<U32>::max)();
+		public:
+			/*!
+				\brief The main constructor of the type
+
+				\param[in] id An identifier of the archetype
+				\param[in] signature A sorted array of components' types which belong to the archetype
+				\param[in] mask A bitset which is built from the signature
+				\param[in] typesBitsIndices Indices of bits of the signature's types, the array has the same order as the signature
+			*/
+
+			TDE2_API CArchetype(TArchetypeId id, const TComponentsSignature& signature, const TComponentsMask& mask, const std::vector<U32>& typesBitsIndices);
+
+			/*!
+				\brief The method appends a new row into the archetype. All components of the row are set to nullptr
+
+				\param[in] entityId An identifier of an entity
+
+				\return The method returns an index of a new row
+			*/
+
+			TDE2_API U32 AddEntity(TEntityId entityId);
+
+			/*!
+				\brief The method removes a row with the given index. The last row is moved into its place
+
+				\param[in] rowIndex An index of a row that should be removed
+
+				\return The method returns an identifier of an entity which was moved into rowIndex place or
+				TEntityId::Invalid if the removed row was the last one
+			*/
+
+			TDE2_API TEntityId RemoveEntity(U32 rowIndex);
+
+			/*!
+				\brief The method returns an index of a column which stores components of given type
+
+				\return The method returns an index of a column or mInvalidColumnIndex if there is no the type in the archetype
+			*/
+
+			TDE2_API U32 GetColumnIndex(TypeId componentTypeId) const;
+
+			/*!
+				\brief The method is a faster version of GetColumnIndex which uses a dense table indexed by bits of types
+
+				\return The method returns an index of a column or mInvalidColumnIndex if there is no the type in the archetype
+			*/
+
+			TDE2_API U32 GetColumnIndexByTypeBit(U32 typeBitIndex) const;
+
+			TDE2_API bool HasComponentType(TypeId componentTypeId) const;
+
+			/*!
+				\brief The method returns true if the archetype's signature contains all the given types
+			*/
+
+			TDE2_API bool HasAllComponentTypes(const std::vector<TypeId>& types) const;
+
+			/*!
+				\brief The method returns true if the archetype's signature contains at least one of the given types
+			*/
+
+			TDE2_API bool HasAnyComponentTypes(const std::vector<TypeId>& types) const;
+
+			/*!
+				\brief The method returns true if the archetype's mask contains all bits of the given one and
+				at least one bit of anyOfMask if the latter isn't empty
+			*/
+
+			TDE2_API bool MatchesMask(const TComponentsMask& allOfMask, const TComponentsMask& anyOfMask) const;
+
+			TDE2_API void SetAddEdge(TypeId componentTypeId, TArchetypeId archetypeId);
+			TDE2_API void SetRemoveEdge(TypeId componentTypeId, TArchetypeId archetypeId);
+
+			/*!
+				\return The method returns an archetype which signature equals to this one plus the given type or TArchetypeId::Invalid
+				if the transition wasn't cached yet
+			*/
+
+			TDE2_API TArchetypeId GetAddEdge(TypeId componentTypeId) const;
+
+			/*!
+				\return The method returns an archetype which signature equals to this one without the given type or TArchetypeId::Invalid
+				if the transition wasn't cached yet
+			*/
+
+			TDE2_API TArchetypeId GetRemoveEdge(TypeId componentTypeId) const;
+
+			TDE2_API TComponentsColumn& GetColumn(U32 columnIndex);
+			TDE2_API const TComponentsColumn& GetColumn(U32 columnIndex) const;
+
+			TDE2_API const TEntitiesArray& GetEntities() const;
+
+			TDE2_API const TComponentsSignature& GetSignature() const;
+
+			TDE2_API const TComponentsMask& GetComponentsMask() const;
+
+			TDE2_API TArchetypeId GetId() const;
+
+			TDE2_API USIZE GetEntitiesCount() const;
+		private:
+			TArchetypeId         mId;
+
+			TComponentsSignature mSignature;
+
+			TComponentsMask      mComponentsMask;
+
+			TEntitiesArray       mEntities;
+
+			TComponentsColumns   mColumns;
+
+			std::vector<U32>     mColumnsIndicesTable; ///< The table is indexed with bits of components' types
+
+			TArchetypesEdges     mAddEdges;
+			TArchetypesEdges     mRemoveEdges;
+	};
+
+
+	/*!
+		class CArchetypeStorage
+
+		\brief The class is a storage of components which groups entities by their components' signatures
+		into archetypes. An entity belongs to a single archetype at any moment. When a component is added or removed the entity
+		moves into another archetype. Transitions between archetypes are cached as the graph's edges.
+
+		The storage doesn't own components, it only tracks their placement
+	*/
+
+	class CArchetypeStorage
+	{
+		public:
+			typedef std::vector<std::unique_ptr<CArchetype>>                  TArchetypesArray;
+			typedef std::map<CArchetype::TComponentsSignature, TArchetypeId>  TArchetypesTable;
+			typedef std::function<void(TypeId, IComponent*)>                  TComponentAction;
+
+			typedef struct TEntityRecord
+			{
+				TArchetypeId mArchetypeId = TArchetypeId::Invalid;
+				U32          mRowIndex = 0;
+				TEntityId    mEntityId = TEntityId::Invalid; ///< The full identifier including a generation, it's used to reject stale identifiers
+			} TEntityRecord, *TEntityRecordPtr;
+
+			TDE2_STATIC_CONSTEXPR U32 mInvalidBitIndex = (std::numeric_limits<U32>::max)();
+
+			typedef struct TComponentTypeBitEntry
+			{
+				TypeId mTypeId = TypeId::Invalid;
+				U32    mBitIndex = mInvalidBitIndex;
+			} TComponentTypeBitEntry, *TComponentTypeBitEntryPtr;
+
+			typedef std::vector<TEntityRecord>                                TEntitiesRecords;
+			typedef std::vector<TComponentTypeBitEntry>                       TComponentTypesBitsTable;
+			typedef std::vector<std::vector<TArchetypeId>>                    TArchetypesPerTypeArray;
+		public:
+			TDE2_API CArchetypeStorage() = default;
+			TDE2_API ~CArchetypeStorage() = default;
+
+			/*!
+				\brief The method attaches a component to the entity. The entity is moved into a corresponding archetype
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE AddComponent(TEntityId entityId, TypeId componentTypeId, IComponent* pComponent);
+
+			/*!
+				\brief The method detaches a component from the entity and returns it. The memory of the component isn't released
+
+				\return The method returns a pointer to detached component or nullptr if there is no component of given type
+			*/
+
+			TDE2_API IComponent* RemoveComponent(TEntityId entityId, TypeId componentTypeId);
+
+			/*!
+				\brief The method detaches all components of the entity and invokes the action for each of them
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE RemoveEntity(TEntityId entityId, const TComponentAction& action = nullptr);
+
+			TDE2_API IComponent* GetComponent(TEntityId entityId, TypeId componentTypeId) const;
+
+			TDE2_API bool HasComponent(TEntityId entityId, TypeId componentTypeId) const;
+
+			TDE2_API std::vector<IComponent*> GetComponents(TEntityId entityId) const;
+
+			/*!
+				\brief The method appends entities which have all the given components into outEntities. The search starts
+				from the smallest set of archetypes which contain one of the types, so the complexity depends on the result's size
+				rather than on the total number of entities. No allocations happen if outEntities has enough capacity
+
+				\param[in] types An array of components' types. An empty array matches all entities
+				\param[out] outEntities An array which the entities are appended to
+			*/
+
+			TDE2_API void FindEntitiesWithAll(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities) const;
+
+			/*!
+				\brief The method appends entities which have at least one of the given components into outEntities.
+				Each entity is written once. No allocations happen if outEntities has enough capacity
+
+				\param[in] types An array of components' types
+				\param[out] outEntities An array which the entities are appended to
+			*/
+
+			TDE2_API void FindEntitiesWithAny(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities) const;
+
+			/*!
+				\brief The method builds a bitset for the given components' types. Unknown types are registered, so the mask
+				stays valid for archetypes which will be created later
+
+				\param[in] types An array of components' types
+
+				\return The method returns a bitset for the given types
+			*/
+
+			TDE2_API TComponentsMask CreateComponentsMask(const std::vector<TypeId>& types);
+
+			/*!
+				\brief The method invokes the action for each existing component. Use it to release the memory
+			*/
+
+			TDE2_API void ForEachComponent(const TComponentAction& action) const;
+
+			/*!
+				\brief The method removes all archetypes and records of entities
+			*/
+
+			TDE2_API void Clear();
+
+			TDE2_API const TArchetypesArray& GetArchetypes() const;
+
+			TDE2_API const CArchetype* GetArchetype(TArchetypeId archetypeId) const;
+
+			TDE2_API const TEntityRecord* GetEntityRecord(TEntityId entityId) const;
+		private:
+			TDE2_API TArchetypeId _findOrCreateArchetype(const CArchetype::TComponentsSignature& signature);
+
+			TDE2_API TArchetypeId _getArchetypeWithComponent(TArchetypeId archetypeId, TypeId componentTypeId);
+			TDE2_API TArchetypeId _getArchetypeWithoutComponent(TArchetypeId archetypeId, TypeId componentTypeId);
+
+			TDE2_API void _moveEntity(TEntityId entityId, TArchetypeId destArchetypeId);
+
+			TDE2_API U32 _getOrCreateComponentTypeBitIndex(TypeId componentTypeId);
+			TDE2_API U32 _getComponentTypeBitIndex(TypeId componentTypeId) const;
+
+			TDE2_API void _insertComponentTypeBitIndex(TypeId componentTypeId, U32 bitIndex);
+		private:
+			TArchetypesArray mArchetypes;
+
+			TArchetypesTable mArchetypesTable;
+
+			TEntitiesRecords mEntitiesRecords; ///< The array is indexed with entities' slots indices, see GetEntityIndex
+
+			TComponentTypesBitsTable mComponentTypesBitsTable; ///< Open addressing table, identifiers of types are hashes already, so they're used as is
+
+			TArchetypesPerTypeArray  mArchetypesPerType; ///< The array is indexed with components' bits indices
+	};
+}
@@ -205,9 +205,11 @@ namespace TDEngine2
 
 		REGISTER_EVENT_TYPE(TOnComponentCreatedEvent)
 			
-		TEntityId mEntityId;
+		TEntityId           mEntityId;
 
-		TypeId    mCreatedComponentTypeId;
+		TypeId              mCreatedComponentTypeId;
+
+		std::vector<TypeId> mEntityComponentsTypes; ///< A sorted array of types of all entity's components including the created one
 	} TOnComponentCreatedEvent, *TOnComponentCreatedEventPtr;
 
 
@@ -226,9 +228,11 @@ namespace TDEngine2
 
 		REGISTER_EVENT_TYPE(TOnComponentRemovedEvent)
 		
-		TEntityId mEntityId;
+		TEntityId           mEntityId;
+
+		TypeId              mRemovedComponentTypeId;
 
-		TypeId    mRemovedComponentTypeId;
+		std::vector<TypeId> mEntityComponentsTypes; ///< A sorted array of types of entity's components that are left after the removal
 	} TOnComponentRemovedEvent, *TOnComponentRemovedEventPtr;
 
 
@@ -259,6 +263,12 @@ namespace TDEngine2
 					return RC_FAIL;
 				}
 
+				E_RESULT_CODE result = _createComponentsPool(THasPoolMemoryAllocPolicy<TComponentType>{});
+				if (RC_OK != result)
+				{
+					return result;
+				}
+
 				mIsInitialized = true;
 
 				return RC_OK;
@@ -298,12 +308,67 @@ namespace TDEngine2
 			}
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CBaseComponentFactory)
+
+			TDE2_API E_RESULT_CODE _onFreeInternal() override
+			{
+				return _releaseComponentsPool(THasPoolMemoryAllocPolicy<TComponentType>{});
+			}
+
+			/*!
+				\brief The method creates a pool which serves all instances of TComponentType. If there are living components that were allocated
+				before the factory appeared (e.g. by another factory of the same type) the factory shares their allocator instead
+			*/
+
+			TDE2_API E_RESULT_CODE _createComponentsPool(std::true_type)
+			{
+				E_RESULT_CODE result = RC_OK;
+
+				mpComponentsPool = CreatePoolAllocator(sizeof(TComponentType), alignof(TComponentType), TComponentType::mAllocatorPageSize, result);
+				if (RC_OK != result)
+				{
+					return result;
+				}
+
+#if TDE2_EDITORS_ENABLED
+				mpComponentsPool->SetBlockDebugName("Components::" + std::to_string(static_cast<U32>(TComponentType::GetTypeId())));
+#endif
+
+				if (RC_OK != TComponentType::SetAllocator(mpComponentsPool))
+				{
+					result = mpComponentsPool->Free();
+					mpComponentsPool = nullptr;
+				}
+
+				return result;
+			}
+
+			TDE2_API E_RESULT_CODE _createComponentsPool(std::false_type) { return RC_OK; }
+
+			TDE2_API E_RESULT_CODE _releaseComponentsPool(std::true_type)
+			{
+				if (!mpComponentsPool || (TComponentType::GetAllocator() != mpComponentsPool))
+				{
+					return RC_OK;
+				}
+
+				/// \note Components that are still alive keep the pool, it's leaked intentionally to keep their memory valid
+				if (RC_OK != TComponentType::SetAllocator(nullptr))
+				{
+					return RC_OK;
+				}
+
+				return mpComponentsPool->Free();
+			}
+
+			TDE2_API E_RESULT_CODE _releaseComponentsPool(std::false_type) { return RC_OK; }
+		protected:
+			IAllocator* mpComponentsPool;
 	};
 
 
 	template <typename TComponentType, typename TComponentParamsType>
 	CBaseComponentFactory<TComponentType, TComponentParamsType>::CBaseComponentFactory():
-		CBaseObject()
+		CBaseObject(), mpComponentsPool(nullptr)
 	{
 	}
 
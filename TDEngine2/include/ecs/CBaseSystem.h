@@ -10,6 +10,7 @@
 #include "../core/CBaseObject.h"
 #include "ISystem.h"
 #include <vector>
+#include <algorithm>
 
 
 namespace TDEngine2
@@ -46,9 +47,73 @@ namespace TDEngine2
 			*/
 
 			TDE2_API bool IsActive() const override;
+
+			/*!
+				\brief The method returns filters which the system's bindings depend on
+
+				\return The method returns an array of components filters
+			*/
+
+			TDE2_API const std::vector<TComponentsFilter>& GetComponentsFilters() const override;
+
+			/*!
+				\brief The method returns information about components which the system reads and writes during its update
+
+				\return The method returns components access information
+			*/
+
+			TDE2_API const TComponentsAccessInfo& GetComponentsAccessInfo() const override;
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(CBaseSystem)
+
+			/*!
+				\brief The method declares a set of components' types that the system reads within InjectBindings.
+				Should be invoked for each query that the system uses, usually within a constructor
+			*/
+
+			template <typename... TArgs>
+			TDE2_API void _addComponentsFilter()
+			{
+				TComponentsFilter filter { TArgs::GetTypeId()... };
+				std::sort(filter.begin(), filter.end());
+
+				mComponentsFilters.emplace_back(std::move(filter));
+			}
+
+			/*!
+				\brief The method declares components' types that the system only reads within Update. A system which declares
+				its access could be executed concurrently with others, so it shouldn't touch any shared state besides declared components
+			*/
+
+			template <typename... TArgs>
+			TDE2_API void _addReadAccess()
+			{
+				_addComponentsAccess(mComponentsAccessInfo.mReadComponentsTypes, { TArgs::GetTypeId()... });
+			}
+
+			/*!
+				\brief The method declares components' types that the system modifies within Update
+			*/
+
+			template <typename... TArgs>
+			TDE2_API void _addWriteAccess()
+			{
+				_addComponentsAccess(mComponentsAccessInfo.mWrittenComponentsTypes, { TArgs::GetTypeId()... });
+			}
+
+			/*!
+				\brief The method marks the system as one that should be updated in the main thread. The system still could run
+				concurrently with systems that are executed on worker threads
+			*/
+
+			TDE2_API void _requireMainThread();
+
+			TDE2_API void _addComponentsAccess(std::vector<TypeId>& accessTypes, const std::vector<TypeId>& types);
 		private:
-			bool mIsActive;
+			bool                           mIsActive;
+
+			std::vector<TComponentsFilter> mComponentsFilters;
+
+			TComponentsAccessInfo          mComponentsAccessInfo;
 	};
 }
\ No newline at end of file
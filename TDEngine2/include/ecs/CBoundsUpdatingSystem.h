@@ -25,6 +25,9 @@ namespace TDEngine2
 	class CStaticMeshContainer;
 	class CSkinnedMeshContainer;
 	class CBoundsComponent;
+	class IResource;
+	class IStaticMesh;
+	class ISkinnedMesh;
 
 
 	/*!
@@ -53,17 +56,18 @@ namespace TDEngine2
 			friend TDE2_API ISystem* CreateBoundsUpdatingSystem(IResourceManager*, IDebugUtility*, ISceneManager*, E_RESULT_CODE&);
 
 		public:
-			template <typename T>
+			template <typename T, typename TResourceType = IResource>
 			struct TSystemContext
 			{
 				std::vector<CBoundsComponent*> mpBounds;
 				std::vector<CTransform*>       mpTransforms;
 				std::vector<T*>                mpElements;
+				std::vector<TResourceType*>    mpResources; ///< Resolved on the main thread before elements are processed in parallel
 			};
 
-			typedef TSystemContext<CQuadSprite>           TSpritesBoundsContext;
-			typedef TSystemContext<CStaticMeshContainer>  TStaticMeshesBoundsContext;
-			typedef TSystemContext<CSkinnedMeshContainer> TSkinnedMeshesBoundsContext;
+			typedef TSystemContext<CQuadSprite>                         TSpritesBoundsContext;
+			typedef TSystemContext<CStaticMeshContainer, IStaticMesh>   TStaticMeshesBoundsContext;
+			typedef TSystemContext<CSkinnedMeshContainer, ISkinnedMesh> TSkinnedMeshesBoundsContext;
 		public:
 			TDE2_SYSTEM(CBoundsUpdatingSystem);
 
@@ -10,6 +10,7 @@
 #include "../core/CBaseObject.h"
 #include "../ecs/IComponentManager.h"
 #include "../utils/Utils.h"
+#include "CArchetypeStorage.h"
 #include <vector>
 #include <list>
 #include <unordered_set>
@@ -32,7 +33,8 @@ namespace TDEngine2
 		class CComponentManager
 
 		\brief The class represents a component manager, which
-		creates, destroys and stores all components in the engine
+		creates, destroys and stores all components in the engine.
+		Entities are grouped into archetypes by their components' signatures, see CArchetypeStorage
 	*/
 
 	class CComponentManager : public CBaseObject, public IComponentManager
@@ -40,19 +42,13 @@ namespace TDEngine2
 		public:
 			friend TDE2_API IComponentManager* CreateComponentManager(E_RESULT_CODE& result);
 		protected:
-			typedef std::unordered_map<TypeId, std::unordered_map<TEntityId, U32>> TComponentEntityMap;
-
-			typedef std::unordered_map<TEntityId, std::unordered_map<TypeId, U32>> TEntityComponentMap;
-
-			typedef std::unordered_map<TypeId, U32>                                TComponentHashTable;
-
 			typedef std::unordered_map<TypeId, U32>                                TComponentFactoriesMap;
 
 			typedef std::vector<TPtr<IComponentFactory>>                           TComponentFactoriesArray;
 
 			typedef std::list<U32>                                                 TFreeEntitiesRegistry;
 
-			typedef std::vector<std::vector<IComponent*>>                          TComponentsMatrix;
+			typedef std::unordered_map<TypeId, std::vector<IComponent*>>           TComponentsOfTypeCache;
 
 			typedef std::unordered_map<TypeId, TEntityId>                          TUniqueComponentsTable;
 		public:
@@ -95,6 +91,16 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE RemoveComponentsImmediately(TEntityId id) override;
 
+			/*!
+				\brief The method frees all components which were removed with RemoveComponent/RemoveComponents.
+				Their memory is returned into pools of corresponding factories. Should be called once per frame
+				when there are no systems that still work with the removed components
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE ReleaseDestroyedComponents() override;
+
 			/*!
 				\return The method returns an array of components that belong to given entity
 			*/
@@ -102,7 +108,8 @@ namespace TDEngine2
 			TDE2_API std::vector<IComponent*> GetComponents(TEntityId id) const override;
 
 			/*!
-				\brief The method returns a one way iterator to an array of components of specified type
+				\brief The method returns a one way iterator to an array of components of specified type.
+				Note that the iterator is valid until next call of the method with the same type
 
 				\param[in] typeId A type of a component
 
@@ -133,6 +140,16 @@ namespace TDEngine2
 
 			TDE2_API std::vector<TEntityId> FindEntitiesWithAll(const std::vector<TypeId>& types) override;
 
+			/*!
+				\brief The method appends identifiers of entities, which have all of specified components, into
+				the given array. The method doesn't allocate memory if the array has enough capacity
+
+				\param[in] types An array that contains types identifiers that an entity should have
+				\param[out] outEntities An array which entities identifiers are appended to
+			*/
+
+			TDE2_API void FindEntitiesWithAll(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities) override;
+
 			/*!
 				\brief The method returns an array of entities identifiers, which have any of
 				specified components
@@ -145,6 +162,16 @@ namespace TDEngine2
 
 			TDE2_API std::vector<TEntityId> FindEntitiesWithAny(const std::vector<TypeId>& types) override;
 
+			/*!
+				\brief The method appends identifiers of entities, which have any of specified components, into
+				the given array. The method doesn't allocate memory if the array has enough capacity
+
+				\param[in] types An array that contains types identifiers that an entity should have
+				\param[out] outEntities An array which entities identifiers are appended to
+			*/
+
+			TDE2_API void FindEntitiesWithAny(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities) override;
+
 			/*!
 				\param[in] types An array that contains types identifiers that an entity should have. Note that the method
 				isn't responsible for creating a new instances of unqiue components.
@@ -172,6 +199,8 @@ namespace TDEngine2
 															  const std::function<E_RESULT_CODE(IComponent*&)>& action);
 
 			TDE2_API E_RESULT_CODE _removeComponentsWithAction(TEntityId entityId, const std::function<E_RESULT_CODE(IComponent*&)>& action);
+
+			TDE2_API void _onComponentDetached(TypeId componentTypeId);
 			
 			TDE2_API E_RESULT_CODE _registerBuiltinComponentFactories();
 
@@ -184,15 +213,11 @@ namespace TDEngine2
 		protected:
 			static std::unordered_set<TypeId> mUniqueComponentTypesRegistry;
 
-			TComponentEntityMap      mComponentEntityMap;
-
-			TEntityComponentMap      mEntityComponentMap;
-
-			TComponentHashTable      mComponentsHashTable;
+			CArchetypeStorage        mArchetypesStorage;
 
-			TComponentsMatrix        mActiveComponents;
+			TComponentsOfTypeCache   mComponentsOfTypeCache;
 
-			std::list<IComponent*>   mDestroyedComponents;
+			std::vector<IComponent*> mDestroyedComponents;
 
 			TComponentFactoriesMap   mComponentFactoriesMap;
 
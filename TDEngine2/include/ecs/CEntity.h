@@ -256,6 +256,8 @@ namespace TDEngine2
 
 		REGISTER_EVENT_TYPE(TOnEntityRemovedEvent)
 
-		TEntityId mRemovedEntityId;
+		TEntityId           mRemovedEntityId;
+
+		std::vector<TypeId> mRemovedComponentsTypes; ///< A sorted array of types of components which the entity had before its removal
 	} TOnEntityRemovedEvent, *TOnEntityRemovedEventPtr;
 }
@@ -13,7 +13,6 @@
 #include <vector>
 #include <list>
 #include <string>
-#include <unordered_map>
 #include <mutex>
 
 
@@ -53,7 +52,20 @@ namespace TDEngine2
 		public:
 			friend TDE2_API CEntityManager* CreateEntityManager(IEventManager* pEventManager, IComponentManager* pComponentManager, E_RESULT_CODE& result);
 		protected:
-			typedef std::unordered_map<TEntityId, U32> TEntitiesHashTable;
+			/*!
+				struct TEntitySlot
+
+				\brief The structure is an element of a dense array of entities. A slot is addressed with an index
+				which is stored within TEntityId, while the generation distinguishes different entities that occupied the slot
+			*/
+
+			typedef struct TEntitySlot
+			{
+				CEntity* mpEntity = nullptr;
+				U32      mGeneration = 0;
+			} TEntitySlot, *TEntitySlotPtr;
+
+			typedef std::vector<TEntitySlot> TEntitiesSlotsArray;
 		public:
 			/*!
 				\brief The method initializes an entity manager's instance
@@ -179,7 +191,8 @@ namespace TDEngine2
 			TDE2_API std::vector<IComponent*> GetComponents(TEntityId id) const;
 
 			/*!
-				\brief The method seeks out an entity and either return it or return nullptr
+				\brief The method seeks out an entity and either return it or return nullptr. The lookup takes
+				constant time, nullptr is returned for identifiers of destroyed entities even if their slots were recycled
 
 				\param[in] entityId Unique entity's identifier
 
@@ -194,23 +207,34 @@ namespace TDEngine2
 
 			TDE2_API CEntity* _createEntity(const std::string& name);
 
+			TDE2_API U32 _getNextSlotIndex() const;
+
+			TDE2_API const TEntitySlot* _getEntitySlot(TEntityId entityId) const;
+
+			/*!
+				\brief The method increments a generation of entity's slot and returns the slot into the free list. Slots
+				which generations are exhausted are never used again
+			*/
+
+			TDE2_API void _releaseEntitySlot(TEntityId entityId);
+
 			TDE2_API E_RESULT_CODE _destroyImmediatelyInternal(CEntity* pEntity);
 
 			TDE2_API void _notifyOnAddComponent(TEntityId entityId, TypeId componentTypeId);
 
 			TDE2_API void _notifyOnRemovedComponent(TEntityId entityId, TypeId componentTypeId);
 
+			TDE2_API void _getComponentsTypes(TEntityId entityId, std::vector<TypeId>& outComponentsTypes) const;
+
 			TDE2_API E_RESULT_CODE _onFreeInternal() override;
 		protected:
 			mutable std::mutex    mMutex;
 
-			std::vector<CEntity*> mActiveEntities;
+			TEntitiesSlotsArray   mEntitiesSlots;
 
-			std::list<CEntity*>   mDestroyedEntities;
-
-			TEntitiesHashTable    mEntitiesHashTable;
+			std::vector<U32>      mFreeSlotsIndices; ///< The free list of slots, the last released slot is reused first
 
-			U32                   mNextIdValue;
+			std::list<CEntity*>   mDestroyedEntities;
 
 			IComponentManager*    mpComponentManager;
 
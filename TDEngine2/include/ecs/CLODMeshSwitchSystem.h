@@ -78,6 +78,5 @@ namespace TDEngine2
 			TComponentsQueryLocalSlice<CLODStrategyComponent, CSkinnedMeshContainer, CTransform> mSkinnedMeshesLODs;
 
 			CCamerasContextComponent*                                                            mpCamerasContext = nullptr;
-			CTransform*                                                                          mpCurrActiveCameraTransform = nullptr;
 	};
 }
\ No newline at end of file
@@ -10,19 +10,24 @@
 #include "CBaseSystem.h"
 #include "../math/TMatrix4.h"
 #include "../ecs/IWorld.h"
+#include "../graphics/InternalShaderData.h"
+#include "../graphics/ShadowCascades.h"
 #include <vector>
+#include <unordered_map>
+#include <utility>
 
 
 namespace TDEngine2
 {
 	class IRenderer;
 	class IVertexDeclaration;
+	class IVertexBuffer;
+	class IIndexBuffer;
 	class IGraphicsObjectManager;
 	class IResourceManager;
 	class CRenderQueue;
 	class IGraphicsContext;
 	class CEntity;
-	struct TLightingShaderData;
 	class CDirectionalLight;
 	class CPointLight;
 	class CTransform;
@@ -30,6 +35,7 @@ namespace TDEngine2
 	class CShadowReceiverComponent;
 	class CStaticMeshContainer;
 	class CSkinnedMeshContainer;
+	class CBoundsComponent;
 
 	TDE2_DECLARE_SCOPED_PTR(IResourceManager)
 
@@ -64,6 +70,39 @@ namespace TDEngine2
 			typedef TComponentsQueryLocalSlice<CShadowReceiverComponent, CStaticMeshContainer>            TStaticShadowReceiverContext;
 			typedef TComponentsQueryLocalSlice<CShadowReceiverComponent, CSkinnedMeshContainer>           TSkinnedShadowReceiverContext;
 			typedef TComponentsQueryLocalSlice<CShadowCasterComponent, CSkinnedMeshContainer, CTransform> TSkinnedShadowCastersContext;
+
+			/*!
+				\brief The type contains information about a cascade of the directional shadow map which was used to render it last time
+			*/
+
+			typedef struct TShadowCascadeState
+			{
+				TShadowCascadeBounds mBounds;
+				TMatrix4             mMatrix = IdentityMatrix4;
+				TVector3             mLightDirection;
+				U32                  mShadowMapSizes = 0;
+				bool                 mIsValid = false;
+			} TShadowCascadeState, *TShadowCascadeStatePtr;
+
+			/*!
+				struct TShadowCastersBatch
+
+				\brief The type describes static casters of a cascade that share the same submesh and are drawn
+				with a single instanced draw call
+			*/
+
+			typedef struct TShadowCastersBatch
+			{
+				IVertexBuffer*        mpVertexBuffer = nullptr;
+				IIndexBuffer*         mpIndexBuffer = nullptr;
+
+				U32                   mStartIndex = 0;
+				U32                   mIndicesCount = 0;
+
+				std::vector<TMatrix4> mModelMatrices; ///< Matrices are stored transposed as TPerObjectShaderData's ones
+			} TShadowCastersBatch, *TShadowCastersBatchPtr;
+
+			typedef std::unordered_map<U64, TShadowCastersBatch> TShadowCastersBatchesMap;
 		public:
 			TDE2_SYSTEM(CLightingSystem);
 
@@ -100,6 +139,10 @@ namespace TDEngine2
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CLightingSystem)
 
 			TDE2_API E_RESULT_CODE _prepareResources();
+
+			TDE2_API U32 _processInstancedStaticShadowCasters(U32 cascadeIndex, U32 drawIndex);
+
+			TDE2_API IVertexBuffer* _getShadowInstancesBuffer();
 		protected:
 			IRenderer*                   mpRenderer;
 
@@ -118,12 +161,35 @@ namespace TDEngine2
 			TStaticShadowReceiverContext mStaticShadowReceiversContext;
 			TSkinnedShadowReceiverContext mSkinnedShadowReceiversContext;
 
+			std::vector<CBoundsComponent*> mStaticShadowCastersBounds; ///< The arrays have the same order as casters' contexts
+			std::vector<CBoundsComponent*> mSkinnedShadowCastersBounds;
+
+			std::vector<U8>              mStaticShadowCastersCascades; ///< Each element is a mask of cascades which the caster is visible within
+			std::vector<U8>              mSkinnedShadowCastersCascades;
+
+			TShadowCascadeState          mShadowCascades[MaxShadowCascadesCount];
+
+			TShadowCascadesCastersState  mShadowCascadesCastersState;
+
 			IVertexDeclaration*          mpShadowVertDecl;
+			IVertexDeclaration*          mpInstancedShadowVertDecl;
 			IVertexDeclaration*          mpSkinnedShadowVertDecl;
 
 			TResourceId                  mShadowPassMaterialHandle;
 			TResourceId                  mShadowPassSkinnedMaterialHandle;
 
 			CRenderQueue*                mpShadowPassRenderQueue;
+
+			TShadowCastersBatchesMap     mShadowCastersBatches; ///< Batches are kept between frames to reuse their memory
+
+			std::vector<TShadowCastersBatch*> mActiveShadowCastersBatches;
+
+			std::vector<IVertexBuffer*>  mShadowInstancesBuffers; ///< Dynamic buffers are reused between frames
+
+			U32                          mUsedShadowInstancesBuffersCount = 0;
+
+			std::vector<std::pair<F32, U32>> mPointLightsCandidates; ///< Squared distances to the camera and indices of visible point lights
+
+			TLightClustersShaderData     mLightClustersData;
 	};
 }
\ No newline at end of file
@@ -18,6 +18,7 @@ namespace TDEngine2
 	class CSkinnedMeshContainer;
 	class CMeshAnimatorComponent;
 	class CBoundsComponent;
+	class ISkeleton;
 
 
 	/*!
@@ -78,6 +79,8 @@ namespace TDEngine2
 
 		protected:
 			TComponentsQueryLocalSlice<CSkinnedMeshContainer, CMeshAnimatorComponent, CAnimationContainerComponent, CBoundsComponent> mEntitiesContext;
+
+			std::vector<ISkeleton*> mpSkeletons; ///< Resolved on the main thread before entities are processed in parallel
 			
 			IResourceManager* mpResourceManager;
 	};
@@ -128,8 +128,6 @@ namespace TDEngine2
 
 			TDE2_API void _populateCommandsBuffer(TSystemContext& context, CRenderQueue*& pRenderGroup, const IMaterial* pCurrMaterial, const ICamera* pCamera);
 
-			TDE2_API U32 _computeRenderCommandHash(TResourceId materialId, F32 distanceToCamera);
-
 		protected:
 			IRenderer*              mpRenderer;
 
@@ -145,8 +143,6 @@ namespace TDEngine2
 
 			IVertexDeclaration*     mpParticleVertexDeclaration;
 
-			CEntity*                mpCameraEntity;
-
 			TParticlesArray         mParticlesInstancesData;
 
 			TParticlesInfoArray     mParticles;
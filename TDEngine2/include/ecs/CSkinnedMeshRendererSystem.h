@@ -29,6 +29,10 @@ namespace TDEngine2
 	class CPerspectiveCamera;
 	class CEntity;
 	class ICamera;
+	class CBoundsComponent;
+
+
+	enum class TMaterialInstanceId : U32;
 
 
 	TDE2_DECLARE_SCOPED_PTR(IResourceManager)
@@ -66,8 +70,41 @@ namespace TDEngine2
 				IVertexDeclaration* mpVertexDecl;
 			} TMeshBuffersEntry, *TMeshBuffersEntryPtr;
 
+			/*!
+				struct TMaterialBucket
+
+				\brief The type contains visible entities that use the same material within the current frame
+			*/
+
+			typedef struct TMaterialBucket
+			{
+				TPtr<IMaterial>  mpMaterial;
+				std::vector<U32> mEntitiesIndices; ///< Indices of entities within mProcessingEntities
+			} TMaterialBucket, *TMaterialBucketPtr;
+
+			/*!
+				struct TDrawRecord
+
+				\brief The type contains resolved resources of a visible entity. Records are gathered on the main thread
+				and turned into commands within jobs
+			*/
+
+			typedef struct TDrawRecord
+			{
+				CRenderQueue*       mpRenderGroup;
+				TMeshBuffersEntry   mMeshBuffers;
+				TResourceId         mMaterialId;
+				TMaterialInstanceId mMaterialInstanceId;
+				U32                 mEntityIndex; ///< An index within mProcessingEntities
+				U32                 mStartIndex;
+				U32                 mIndicesCount;
+				U8                  mLayer;
+				bool                mIsTransparent;
+			} TDrawRecord, *TDrawRecordPtr;
+
 			typedef std::vector<std::tuple<CTransform*, CSkinnedMeshContainer*>> TEntitiesArray;
-			typedef std::vector<TPtr<IMaterial>>                                 TMaterialsArray;
+			typedef std::vector<TMaterialBucket*>                                TMaterialBucketsArray;
+			typedef std::unordered_map<TResourceId, TMaterialBucket>             TMaterialBucketsTable;
 			typedef std::vector<TMeshBuffersEntry>                               TMeshBuffersMap;
 		public:
 			TDE2_SYSTEM(CSkinnedMeshRendererSystem);
@@ -105,15 +142,19 @@ namespace TDEngine2
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CSkinnedMeshRendererSystem)
 
-			TDE2_API void _collectUsedMaterials(const TEntitiesArray& entities, IResourceManager* pResourceManager, TMaterialsArray& usedMaterials);
+			TDE2_API void _collectUsedMaterials(const TEntitiesArray& entities, const std::vector<U8>& visibilityFlags, IResourceManager* pResourceManager,
+												TMaterialBucketsArray& usedMaterials);
 
-			TDE2_API void _populateCommandsBuffer(const TEntitiesArray& entities, CRenderQueue*& pRenderGroup, TPtr<IMaterial> pCurrMaterial,
-												  const ICamera* pCamera);
+			TDE2_API void _populateCommandsBuffer(const TEntitiesArray& entities, TMaterialBucket& materialBucket, CRenderQueue*& pRenderGroup, const ICamera* pCamera);
 
-			TDE2_API U32 _computeMeshCommandHash(TResourceId materialId, F32 distanceToCamera);
+			TDE2_API void _recordDrawCommands(IWorld* pWorld, const TEntitiesArray& entities, const ICamera* pCamera);
 		protected:
 			TEntitiesArray          mProcessingEntities;
 
+			std::vector<CBoundsComponent*> mProcessingEntitiesBounds;
+
+			std::vector<U8>         mVisibilityFlags; ///< Results of frustum culling, an element per processing entity
+
 			IGraphicsObjectManager* mpGraphicsObjectManager;
 
 			TPtr<IResourceManager>  mpResourceManager;
@@ -123,8 +164,12 @@ namespace TDEngine2
 			CRenderQueue*           mpOpaqueRenderGroup;
 			CRenderQueue*           mpTransparentRenderGroup;
 
-			TMaterialsArray         mCurrMaterialsArray;
+			TMaterialBucketsTable   mMaterialBuckets; ///< Buckets are kept between frames to reuse their memory
+
+			TMaterialBucketsArray   mCurrMaterialsArray; ///< Buckets of the current frame, opaque materials go first
 
 			TMeshBuffersMap         mMeshBuffersMap;
+
+			std::vector<TDrawRecord> mDrawRecords; ///< Draw calls of the current frame
 	};
 }
\ No newline at end of file
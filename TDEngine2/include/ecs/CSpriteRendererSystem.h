@@ -21,6 +21,7 @@ namespace TDEngine2
 {
 	class CTransform;
 	class CQuadSprite;
+	class CBoundsComponent;
 	class CRenderQueue;
 	class IGraphicsObjectManager;
 	class IVertexBuffer;
@@ -80,13 +81,16 @@ namespace TDEngine2
 
 			typedef struct TBatchEntry
 			{
-				//std::vector<TSpriteInstanceData> mInstancesData;
-				CDynamicArray<TSpriteInstanceData>* mpInstancesData;
-				
-				TResourceId mMaterialHandle;
+				std::vector<TSpriteInstanceData> mInstancesData; ///< The array is cleared every frame but keeps its capacity
+
+				TResourceId mMaterialHandle = TResourceId::Invalid;
+
+				U64         mGroupKey = 0x0;
 			} TBatchEntry, *TBatchEntryPtr;
 
-			typedef std::unordered_map<U32, TBatchEntry> TBatchesBuffer;
+			typedef std::vector<TBatchEntry> TBatchesBuffer;
+
+			typedef std::unordered_map<U64, U32> TBatchesTable; ///< A group key is mapped onto an index within TBatchesBuffer
 		public:
 			TDE2_SYSTEM(CSpriteRendererSystem);
 
@@ -125,10 +129,16 @@ namespace TDEngine2
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CSpriteRendererSystem)
 
-			TDE2_API U32 _computeSpriteCommandKey(TResourceId materialId, U16 graphicsLayerId);
+			TDE2_API U64 _computeSpriteCommandKey(TResourceId materialId, U16 graphicsLayerId);
 
 			TDE2_API void _initializeBatchVertexBuffers(IGraphicsObjectManager* pGraphicsObjectManager, U32 numOfBuffers);
 
+			TDE2_API TBatchEntry& _getBatchEntry(U64 groupKey, TResourceId materialHandle);
+
+			TDE2_API IVertexBuffer* _getInstancesBuffer();
+
+			TDE2_API void _submitBatch(const TBatchEntry& batchEntry);
+
 			TDE2_API E_RESULT_CODE _onFreeInternal() override;
 		protected:
 			TPtr<IAllocator>            mpTempAllocator;
@@ -137,6 +147,10 @@ namespace TDEngine2
 
 			std::vector<CQuadSprite*>   mSprites;
 
+			std::vector<CBoundsComponent*> mSpritesBounds;
+
+			std::vector<U8>             mVisibilityFlags; ///< Results of frustum culling, an element per sprite
+
 			IRenderer*                  mpRenderer;
 
 			TPtr<IResourceManager>      mpResourceManager;
@@ -145,7 +159,7 @@ namespace TDEngine2
 
 			IGraphicsObjectManager*     mpGraphicsObjectManager;
 
-			std::vector<IVertexBuffer*> mSpritesPerInstanceData;
+			std::vector<IVertexBuffer*> mSpritesPerInstanceData; ///< Buffers live between frames, the pool grows when a frame needs more of them
 
 			IVertexBuffer*              mpSpriteVertexBuffer;
 
@@ -158,5 +172,9 @@ namespace TDEngine2
 			IGraphicsLayersInfo*        mpGraphicsLayers;
 
 			TBatchesBuffer              mBatches;
+
+			TBatchesTable               mBatchesTable;
+
+			U32                         mUsedInstancesBuffersCount = 0;
 	};
 }
\ No newline at end of file
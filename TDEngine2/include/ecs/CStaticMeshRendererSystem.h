@@ -10,6 +10,8 @@
 #include "CBaseSystem.h"
 #include <vector>
 #include <tuple>
+#include <unordered_map>
+#include "../math/TMatrix4.h"
 
 
 namespace TDEngine2
@@ -29,6 +31,8 @@ namespace TDEngine2
 	class CPerspectiveCamera;
 	class CEntity;
 	class ICamera;
+	class CBoundsComponent;
+	class IStaticMesh;
 
 
 	TDE2_DECLARE_SCOPED_PTR(IResourceManager)
@@ -68,9 +72,75 @@ namespace TDEngine2
 				IVertexDeclaration* mpVertexDecl;
 			} TMeshBuffersEntry, *TMeshBuffersEntryPtr;
 
+			/*!
+				struct TMaterialBucket
+
+				\brief The type contains visible entities that use the same material within the current frame
+			*/
+
+			typedef struct TMaterialBucket
+			{
+				TPtr<IMaterial>  mpMaterial;
+				std::vector<U32> mEntitiesIndices; ///< Indices of entities within mProcessingEntities
+			} TMaterialBucket, *TMaterialBucketPtr;
+
+			/// \note The layout matches TPerObjectShaderData's matrices, both of them are stored transposed
+			typedef struct TStaticMeshInstanceData
+			{
+				TMatrix4 mModelMat;
+				TMatrix4 mInvModelMat;
+			} TStaticMeshInstanceData, *TStaticMeshInstanceDataPtr;
+
+			/*!
+				struct TInstancesBatch
+
+				\brief The type describes visible entities that share the same submesh and material and
+				are drawn with a single instanced draw call
+			*/
+
+			typedef struct TInstancesBatch
+			{
+				IVertexBuffer*                       mpVertexBuffer = nullptr;
+				IIndexBuffer*                        mpIndexBuffer = nullptr;
+				IVertexDeclaration*                  mpVertexDecl = nullptr;
+
+				U32                                  mStartIndex = 0;
+				U32                                  mIndicesCount = 0;
+
+				F32                                  mMinDistanceToCamera = 0.0f;
+
+				U32                                  mLastUsedFrameIndex = 0;
+
+				std::vector<TStaticMeshInstanceData> mInstances;
+			} TInstancesBatch, *TInstancesBatchPtr;
+
+			/*!
+				struct TDrawRecord
+
+				\brief The type contains resolved resources of a visible entity that's drawn without instancing.
+				Records are gathered on the main thread and turned into commands within jobs
+			*/
+
+			typedef struct TDrawRecord
+			{
+				CRenderQueue*     mpRenderGroup;
+				TMeshBuffersEntry mMeshBuffers;
+				TResourceId       mMaterialId;
+				U32               mEntityIndex; ///< An index within mProcessingEntities
+				U32               mStartIndex;
+				U32               mIndicesCount;
+				U8                mLayer;
+				bool              mIsTransparent;
+			} TDrawRecord, *TDrawRecordPtr;
+
 			typedef std::vector<std::tuple<CTransform*, CStaticMeshContainer*>> TEntitiesArray;
-			typedef std::vector<TPtr<IMaterial>>                                TMaterialsArray;
+			typedef std::vector<TMaterialBucket*>                               TMaterialBucketsArray;
+			typedef std::unordered_map<TResourceId, TMaterialBucket>            TMaterialBucketsTable;
 			typedef std::vector<TMeshBuffersEntry>                              TMeshBuffersMap;
+			typedef std::unordered_map<U64, TInstancesBatch>                    TInstancesBatchesMap;
+			typedef std::unordered_map<TResourceId, IVertexDeclaration*>        TInstancedVertexDeclsMap;
+		public:
+			TDE2_STATIC_CONSTEXPR U32 mMaxInstancesBatchUnusedFramesCount = 120; ///< A batch which isn't drawn during this number of frames is released
 		public:
 			TDE2_SYSTEM(CStaticMeshRendererSystem);
 
@@ -107,15 +177,29 @@ namespace TDEngine2
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CStaticMeshRendererSystem)
 
-			TDE2_API void _collectUsedMaterials(const TEntitiesArray& entities, IResourceManager* pResourceManager, TMaterialsArray& usedMaterials);
+			TDE2_API void _collectUsedMaterials(const TEntitiesArray& entities, const std::vector<U8>& visibilityFlags, IResourceManager* pResourceManager,
+												TMaterialBucketsArray& usedMaterials);
+
+			TDE2_API void _populateCommandsBuffer(const TEntitiesArray& entities, TMaterialBucket& materialBucket, CRenderQueue*& pRenderGroup, const ICamera* pCamera);
+
+			TDE2_API void _submitInstancesBatches(CRenderQueue*& pRenderGroup, TPtr<IMaterial> pCurrMaterial);
+
+			TDE2_API void _recordDrawCommands(IWorld* pWorld, const TEntitiesArray& entities, const ICamera* pCamera);
+
+			TDE2_API void _pruneInstancesBatches();
+
+			TDE2_API IVertexDeclaration* _createMeshVertexDeclaration(IStaticMesh* pSharedMesh);
 
-			TDE2_API void _populateCommandsBuffer(const TEntitiesArray& entities, CRenderQueue*& pRenderGroup, TPtr<IMaterial> pCurrMaterial,
-												  const ICamera* pCamera);
+			TDE2_API IVertexDeclaration* _getInstancedVertexDeclaration(TResourceId meshId, IStaticMesh* pSharedMesh);
 
-			TDE2_API U32 _computeMeshCommandHash(TResourceId materialId, F32 distanceToCamera);
+			TDE2_API IVertexBuffer* _getInstancesBuffer();
 		protected:
 			TEntitiesArray          mProcessingEntities;
 
+			std::vector<CBoundsComponent*> mProcessingEntitiesBounds;
+
+			std::vector<U8>         mVisibilityFlags; ///< Results of frustum culling, an element per processing entity
+
 			IGraphicsObjectManager* mpGraphicsObjectManager;
 
 			TPtr<IResourceManager>  mpResourceManager;
@@ -123,8 +207,24 @@ namespace TDEngine2
 			CRenderQueue*           mpOpaqueRenderGroup;
 			CRenderQueue*           mpTransparentRenderGroup;
 
-			TMaterialsArray         mCurrMaterialsArray;
+			TMaterialBucketsTable   mMaterialBuckets; ///< Buckets are kept between frames to reuse their memory
+
+			TMaterialBucketsArray   mCurrMaterialsArray; ///< Buckets of the current frame, opaque materials go first
 
 			TMeshBuffersMap         mMeshBuffersMap;
+
+			std::vector<TDrawRecord> mDrawRecords; ///< Non-instanced draw calls of the current frame
+
+			TInstancesBatchesMap     mInstancesBatches; ///< Batches are kept between frames to reuse their memory, unused ones are pruned
+
+			std::vector<TInstancesBatch*> mActiveInstancesBatches; ///< Batches of the material that's processed at the moment in order of their creation
+
+			U32                      mCurrFrameIndex = 0;
+
+			TInstancedVertexDeclsMap mInstancedVertexDecls;
+
+			std::vector<IVertexBuffer*> mInstancesBuffers; ///< Dynamic buffers are reused between frames
+
+			U32                      mUsedInstancesBuffersCount = 0;
 	};
 }
\ No newline at end of file
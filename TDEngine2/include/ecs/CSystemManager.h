@@ -22,6 +22,7 @@ namespace TDEngine2
 {
 	class IWorld;
 	class ISystem;
+	class IJobManager;
 
 	
 	/*!
@@ -30,13 +31,15 @@ namespace TDEngine2
 		\param[in, out] pWorld A pointer to IWorld implementation
 
 		\param[in, out] pEventManager A pointer to IEventManager implementation
+
+		\param[in, out] pJobManager A pointer to IJobManager implementation, could be nullptr
 		
 		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
 
 		\return A pointer to CSystemManager's implementation
 	*/
 
-	TDE2_API ISystemManager* CreateSystemManager(IWorld* pWorld, IEventManager* pEventManager, E_RESULT_CODE& result);
+	TDE2_API ISystemManager* CreateSystemManager(IWorld* pWorld, IEventManager* pEventManager, IJobManager* pJobManager, E_RESULT_CODE& result);
 
 
 	/*!
@@ -44,18 +47,23 @@ namespace TDEngine2
 
 		\brief The implementation of ISystemManager. The manager
 		registers, activates and update existing systems.
+
+		Every frame systems are split into execution levels. A system is placed after all preceding systems which
+		components access conflicts with its own one. Systems of the same level are updated concurrently on the job manager's threads.
 	*/
 
 	class CSystemManager : public CBaseObject, public ISystemManager, public IEventHandler
 	{
 		public:
-			friend TDE2_API ISystemManager* CreateSystemManager(IWorld* pWorld, IEventManager* pEventManager, E_RESULT_CODE& result);
+			friend TDE2_API ISystemManager* CreateSystemManager(IWorld* pWorld, IEventManager* pEventManager, IJobManager* pJobManager, E_RESULT_CODE& result);
 		protected:
 			typedef struct TSystemDesc
 			{
 				TSystemId mSystemId; /// low bytes contains system's unique id, high bytes contains its priority
 
 				ISystem*  mpSystem;
+
+				bool      mIsDirty = false; ///< The flag is true if the system's bindings should be injected again
 			} TSystemDesc, *TSystemDescPtr;
 
 			typedef std::vector<TSystemDesc>                   TSystemsArray;
@@ -63,6 +71,8 @@ namespace TDEngine2
 			typedef std::list<TSystemDesc>                     TSystemsList;
 
 			typedef std::unordered_map<E_SYSTEM_PRIORITY, U32> TSystemsAccountTable;
+
+			typedef std::vector<std::vector<U32>>              TSystemsExecutionLevels; ///< Each level contains indices of active systems
 		public:
 			TDE2_REGISTER_TYPE(CSystemManager)
 
@@ -73,10 +83,12 @@ namespace TDEngine2
 
 				\param[in, out] pEventManager A pointer to IEventManager implementation
 
+				\param[in, out] pJobManager A pointer to IJobManager implementation, could be nullptr
+
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API E_RESULT_CODE Init(IWorld* pWorld, IEventManager* pEventManager) override;
+			TDE2_API E_RESULT_CODE Init(IWorld* pWorld, IEventManager* pEventManager, IJobManager* pJobManager) override;
 
 			/*!
 				\brief The method registers specified system
@@ -213,6 +225,30 @@ namespace TDEngine2
 			TDE2_API E_RESULT_CODE _internalUnregisterSystemImmediately(TSystemId systemId);
 			
 			TDE2_API E_RESULT_CODE _onFreeInternal() override;
+
+			/*!
+				\brief The method marks systems which bindings depend on the changed entity. Only these systems will
+				inject their bindings again on the next update
+
+				\param[in] entityComponentsTypes A sorted array of types of entity's components
+				\param[in] changedComponentTypeId A type of created or removed component. TypeId::Invalid means that
+				the entity itself was removed
+			*/
+
+			TDE2_API void _markAffectedSystems(const std::vector<TypeId>& entityComponentsTypes, TypeId changedComponentTypeId);
+
+			TDE2_API static bool _isSystemAffected(const ISystem* pSystem, const std::vector<TypeId>& entityComponentsTypes, TypeId changedComponentTypeId);
+
+			/*!
+				\brief The method builds a dependency graph of active systems and splits it into levels. Systems of a single level
+				don't conflict with each other
+			*/
+
+			TDE2_API void _buildExecutionLevels();
+
+			TDE2_API void _updateSystemsLevel(IWorld* pWorld, F32 dt, const std::vector<U32>& systemsIndices);
+
+			TDE2_API void _injectBindingsIfDirty(TSystemDesc& systemDesc);
 		protected:
 			TSystemsArray        mpActiveSystems;
 
@@ -222,10 +258,36 @@ namespace TDEngine2
 
 			IWorld*              mpWorld;
 
+			IJobManager*         mpJobManager;
+
+			TSystemsExecutionLevels mExecutionLevels;
+
+			std::vector<const ISystem*> mpLevelsSystems; ///< Pointers to active systems which are passed into BuildSystemsExecutionLevels
+
 			TSystemsAccountTable mSystemsIdentifiersTable;
 
 			mutable std::mutex   mMutex;
 
-			bool                 mIsDirty;
+			std::mutex           mDirtyFlagsMutex; ///< Events could be sent from systems which are executed on worker threads
 	};
+
+
+	/*!
+		\return The function returns true if systems can't be executed concurrently. A system without declared components access
+		conflicts with any other one
+	*/
+
+	TDE2_API bool HasSystemsAccessConflict(const ISystem* pLeftSystem, const ISystem* pRightSystem);
+
+
+	/*!
+		\brief The function splits systems into execution levels. A system is placed into the level next to the latest preceding
+		system which components access conflicts with its own one, so the order of conflicting systems is preserved
+
+		\param[in] systems An array of systems in order of their execution
+
+		\param[out] levels Each level contains indices of given systems which could be updated concurrently
+	*/
+
+	TDE2_API void BuildSystemsExecutionLevels(const std::vector<const ISystem*>& systems, std::vector<std::vector<U32>>& levels);
 }
\ No newline at end of file
@@ -28,12 +28,14 @@ namespace TDEngine2
 
 		\param[in, out] pEventManager A pointer to IEventManager implementation
 
+		\param[in, out] pJobManager A pointer to IJobManager implementation, could be nullptr
+
 		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
 
 		\return A pointer to CWorld's implementation
 	*/
 
-	TDE2_API IWorld* CreateWorld(TPtr<IEventManager> pEventManager, E_RESULT_CODE& result);
+	TDE2_API IWorld* CreateWorld(TPtr<IEventManager> pEventManager, TPtr<IJobManager> pJobManager, E_RESULT_CODE& result);
 
 
 	/*!
@@ -46,17 +48,19 @@ namespace TDEngine2
 	class CWorld : public CBaseObject, public IWorld
 	{
 		public:
-			friend TDE2_API IWorld* CreateWorld(TPtr<IEventManager>, E_RESULT_CODE&);
+			friend TDE2_API IWorld* CreateWorld(TPtr<IEventManager>, TPtr<IJobManager>, E_RESULT_CODE&);
 		public:
 			/*!
 				\brief The method initializes a world's instance
 
 				\param[in, out] A pointer to IEventManager implementation
+				\param[in, out] pJobManager A pointer to IJobManager implementation which is used to update systems concurrently.
+				Could be nullptr, then all systems are updated in the main thread
 
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API E_RESULT_CODE Init(TPtr<IEventManager> pEventManager) override;
+			TDE2_API E_RESULT_CODE Init(TPtr<IEventManager> pEventManager, TPtr<IJobManager> pJobManager) override;
 			
 			/*!
 				\brief The method creates a new instance of CEntity
@@ -227,6 +231,8 @@ namespace TDEngine2
 
 			TDE2_API TEntityId _findEntityWithUniqueComponent(TypeId typeId) override;
 
+			TDE2_API void _parallelFor(USIZE elementsCount, USIZE elementSize, const std::function<void(USIZE, USIZE)>& action) override;
+
 			TDE2_API E_RESULT_CODE _onFreeInternal() override;
 		protected:
 			CEntityManager*       mpEntityManager;
@@ -237,6 +243,8 @@ namespace TDEngine2
 
 			TPtr<IEventManager>   mpEventManager;
 
+			TPtr<IJobManager>     mpJobManager;
+
 			TPtr<IRaycastContext> mpRaycastContext;
 
 			F32                   mTimeScaleFactor;
@@ -160,6 +160,16 @@ namespace TDEngine2
 			*/
 
 			TDE2_API virtual E_RESULT_CODE RemoveComponentsImmediately(TEntityId id) = 0;
+
+			/*!
+				\brief The method frees all components which were removed with RemoveComponent/RemoveComponents.
+				Their memory is returned into pools of corresponding factories. Should be called once per frame
+				when there are no systems that still work with the removed components
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE ReleaseDestroyedComponents() = 0;
 			
 			/*!
 				\brief The method returns a one way iterator to an array of components of specified type
@@ -211,6 +221,16 @@ namespace TDEngine2
 
 			TDE2_API virtual std::vector<TEntityId> FindEntitiesWithAll(const std::vector<TypeId>& types) = 0;
 
+			/*!
+				\brief The method appends identifiers of entities, which have all of specified components, into
+				the given array. The method doesn't allocate memory if the array has enough capacity
+
+				\param[in] types An array that contains types identifiers that an entity should have
+				\param[out] outEntities An array which entities identifiers are appended to
+			*/
+
+			TDE2_API virtual void FindEntitiesWithAll(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities) = 0;
+
 			/*!
 				\brief The method returns an array of entities identifiers, which have any of
 				specified components
@@ -223,6 +243,16 @@ namespace TDEngine2
 
 			TDE2_API virtual std::vector<TEntityId> FindEntitiesWithAny(const std::vector<TypeId>& types) = 0;
 
+			/*!
+				\brief The method appends identifiers of entities, which have any of specified components, into
+				the given array. The method doesn't allocate memory if the array has enough capacity
+
+				\param[in] types An array that contains types identifiers that an entity should have
+				\param[out] outEntities An array which entities identifiers are appended to
+			*/
+
+			TDE2_API virtual void FindEntitiesWithAny(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities) = 0;
+
 			/*!
 				\param[in] types An array that contains types identifiers that an entity should have. Note that the method
 				isn't responsible for creating a new instances of unqiue components.
@@ -248,7 +278,13 @@ namespace TDEngine2
 	#endif
 				GetComponent(TEntityId id)
 			{
-				return dynamic_cast<T*>(_getComponent(T::GetTypeId(), id));
+				/// \note The type of the component is already checked with its identifier, so dynamic_cast is used only to validate it in debug builds
+				IComponent* pComponent = _getComponent(T::GetTypeId(), id);
+#if TDE2_DEBUG_MODE
+				TDE2_ASSERT(!pComponent || dynamic_cast<T*>(pComponent));
+#endif
+
+				return static_cast<T*>(pComponent);
 			}
 
 			/*!
@@ -10,6 +10,7 @@
 #include "../core/IBaseObject.h"
 #include "../utils/Utils.h"
 #include <string>
+#include <vector>
 
 
 namespace TDEngine2
@@ -42,6 +43,27 @@ namespace TDEngine2
 
 	class IWorld;
 
+
+	typedef std::vector<TypeId> TComponentsFilter;
+
+
+	/*!
+		struct TComponentsAccessInfo
+
+		\brief The type describes which components' types a system reads and writes within its Update method.
+		Systems which access info don't conflict are executed concurrently
+	*/
+
+	typedef struct TComponentsAccessInfo
+	{
+		std::vector<TypeId> mReadComponentsTypes;    ///< A sorted array of types
+		std::vector<TypeId> mWrittenComponentsTypes; ///< A sorted array of types
+
+		bool                mIsDeclared = false;     ///< A system without declared access is executed exclusively
+		bool                mIsMainThreadRequired = false; ///< The flag is true if the system calls graphics API or something else that isn't thread safe
+	} TComponentsAccessInfo, *TComponentsAccessInfoPtr;
+
+
 	/*!
 		interface ISystem
 
@@ -100,6 +122,24 @@ namespace TDEngine2
 			*/
 
 			TDE2_API virtual TypeId GetSystemType() const = 0;
+
+			/*!
+				\brief The method returns filters which the system's bindings depend on. Each filter is a set of components' types.
+				Bindings of the system are injected again only when an entity, which has all the types of some filter, gets or loses
+				one of them. An empty array means that the system depends on any change of the world
+
+				\return The method returns an array of components filters
+			*/
+
+			TDE2_API virtual const std::vector<TComponentsFilter>& GetComponentsFilters() const = 0;
+
+			/*!
+				\brief The method returns information about components which the system reads and writes during its update
+
+				\return The method returns components access information
+			*/
+
+			TDE2_API virtual const TComponentsAccessInfo& GetComponentsAccessInfo() const = 0;
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(ISystem)
 	};
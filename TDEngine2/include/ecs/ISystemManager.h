@@ -16,6 +16,7 @@ namespace TDEngine2
 	class ISystem;
 	class IWorld;
 	class IEventManager;
+	class IJobManager;
 
 
 	/*!
@@ -35,10 +36,13 @@ namespace TDEngine2
 
 				\param[in, out] pEventManager A pointer to IEventManager implementation
 
+				\param[in, out] pJobManager A pointer to IJobManager implementation. Systems which declared their components access
+				are updated concurrently on its worker threads. Could be nullptr
+
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API virtual E_RESULT_CODE Init(IWorld* pWorld, IEventManager* pEventManager) = 0;
+			TDE2_API virtual E_RESULT_CODE Init(IWorld* pWorld, IEventManager* pEventManager, IJobManager* pJobManager) = 0;
 
 			/*!
 				\brief The method registers specified system
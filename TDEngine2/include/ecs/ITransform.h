@@ -133,7 +133,8 @@ namespace TDEngine2
 			TDE2_API virtual const TMatrix4& GetLocalToWorldTransform() const = 0;
 
 			/*!
-				\brief The method returns world to local matrix
+				\brief The method returns world to local matrix. The matrix is cached and recomputed
+				only when the transform is changed, so prefer it to inversion of GetLocalToWorldTransform's result
 
 				\return The method returns world to local matrix
 			*/
@@ -28,9 +28,11 @@ namespace TDEngine2
 	class IEventManager;
 	class IRaycastContext;
 	class CTransform;
+	class IJobManager;
 
 
 	TDE2_DECLARE_SCOPED_PTR(IEventManager)
+	TDE2_DECLARE_SCOPED_PTR(IJobManager)
 	TDE2_DECLARE_SCOPED_PTR(IRaycastContext)
 
 
@@ -67,11 +69,13 @@ namespace TDEngine2
 				\brief The method initializes a world's instance
 
 				\param[in, out] A pointer to IEventManager implementation
+				\param[in, out] pJobManager A pointer to IJobManager implementation which is used to update systems concurrently.
+				Could be nullptr, then all systems are updated in the main thread
 
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API virtual E_RESULT_CODE Init(TPtr<IEventManager> pEventManager) = 0;
+			TDE2_API virtual E_RESULT_CODE Init(TPtr<IEventManager> pEventManager, TPtr<IJobManager> pJobManager) = 0;
 
 			/*!
 				\brief The method creates a new instance of CEntity
@@ -337,6 +341,42 @@ namespace TDEngine2
 
 				return std::move(result);
 			}
+
+			/*!
+				\brief The method invokes the action for each element of the slice. Elements are split into cache-line aligned
+				ranges which are processed on worker threads. The method returns when all elements are processed.
+				The action should touch only components of the given element
+
+				\param[in] slice A slice which elements are processed
+				\param[in] action A callback which accepts an index of an element
+			*/
+
+			template <typename TAction, typename... TArgs>
+			TDE2_API void ParallelForEach(const TComponentsQueryLocalSlice<TArgs...>& slice, const TAction& action)
+			{
+				ParallelForEach(slice.mComponentsCount, action);
+			}
+
+			/*!
+				\brief The method invokes the action for each index within [0; elementsCount) range on worker threads.
+				The method returns when all elements are processed
+
+				\param[in] elementsCount A number of elements
+				\param[in] action A callback which accepts an index of an element
+			*/
+
+			template <typename TAction>
+			TDE2_API void ParallelForEach(USIZE elementsCount, const TAction& action)
+			{
+				/// \note Slices store arrays of pointers so ranges are aligned with a number of pointers per cache line
+				_parallelFor(elementsCount, sizeof(void*), [&action](USIZE first, USIZE last)
+				{
+					for (USIZE i = first; i < last; ++i)
+					{
+						action(i);
+					}
+				});
+			}
 			
 			/*!
 				\brief The method registers given raycasting context within the world's instance
@@ -390,6 +430,8 @@ namespace TDEngine2
 
 			TDE2_API virtual TSystemId _findSystem(TypeId typeId) = 0;
 
+			TDE2_API virtual void _parallelFor(USIZE elementsCount, USIZE elementSize, const std::function<void(USIZE, USIZE)>& action) = 0;
+
 			template <typename TComponentType>
 			TDE2_API std::vector<TComponentType*> _getComponentsOfTypeFromEntities(const std::vector<TEntityId>& entities)
 			{
@@ -48,6 +48,8 @@ namespace TDEngine2
 
 			typedef std::unordered_map<U32Ptr, TBaseObjectAllocInfo> TBaseObjectsRegistry;
 
+			typedef std::unordered_map<std::string, TPoolAllocatorInfo> TPoolAllocatorsStatistics;
+
 		public:
 			/*!
 				\brief The method stars to record current frame's statistics. The method should be called only once per frame
@@ -86,6 +88,27 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE UpdateMemoryBlockInfo(const std::string& name, USIZE usedSize) override;
 
+			/*!
+				\brief The method updates statistics of a pool allocator. A new record is created if there is no the pool with given name
+
+				\param[in] name A name of the pool
+				\param[in] info Current statistics of the pool
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE UpdatePoolAllocatorInfo(const std::string& name, const TPoolAllocatorInfo& info) override;
+
+			/*!
+				\brief The method updates statistics of loaded resources, which are sent by the resource manager once per frame
+
+				\param[in] info Current statistics of resources
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE UpdateResourcesMemoryInfo(const TResourcesMemoryInfo& info) override;
+
 			TDE2_API E_RESULT_CODE RegisterBaseObject(const std::string& typeId, U32Ptr address) override;
 			TDE2_API E_RESULT_CODE UnregisterBaseObject(U32Ptr address) override;
 
@@ -102,6 +125,18 @@ namespace TDEngine2
 
 			const TProfilerStatisticsData& GetStatistics() const;
 
+			/*!
+				\brief The method returns a copy of pools' statistics, because pools can be updated from other threads
+			*/
+
+			TDE2_API TPoolAllocatorsStatistics GetPoolAllocatorsStatistics() const;
+
+			/*!
+				\brief The method returns a copy of resources' statistics
+			*/
+
+			TDE2_API TResourcesMemoryInfo GetResourcesMemoryInfo() const;
+
 			TDE2_API USIZE GetTotalMemoryAvailable() const override;
 
 			TDE2_API U32 GetLiveObjectsCount() const override;
@@ -119,12 +154,18 @@ namespace TDEngine2
 
 			TBaseObjectsRegistry mLivingBaseObjectsTable;
 
+			TPoolAllocatorsStatistics mPoolAllocatorsInfoRegistry;
+
+			TResourcesMemoryInfo mResourcesMemoryInfo;
+
 			mutable std::mutex mMutex;
 	};
 
 
 #define TDE2_REGISTER_MEMORY_BLOCK_PROFILE(Name, Offset, Size) CMemoryProfiler::Get()->RegisterGlobalMemoryBlock(Name, Offset, Size)
 #define TDE2_UPDATE_MEMORY_BLOCK_INFO(Name, UsedSize) CMemoryProfiler::Get()->UpdateMemoryBlockInfo(Name, UsedSize)
+#define TDE2_UPDATE_POOL_ALLOCATOR_INFO(Name, Info) CMemoryProfiler::Get()->UpdatePoolAllocatorInfo(Name, Info)
+#define TDE2_UPDATE_RESOURCES_MEMORY_INFO(Info) CMemoryProfiler::Get()->UpdateResourcesMemoryInfo(Info)
 
 }
 
@@ -132,5 +173,7 @@ namespace TDEngine2
 
 #define TDE2_DECLARE_MEMORY_BLOCK_PROFILE(Name, Offset, Size) 
 #define TDE2_UPDATE_MEMORY_BLOCK_INFO(Name, UsedSize)
+#define TDE2_UPDATE_POOL_ALLOCATOR_INFO(Name, Info)
+#define TDE2_UPDATE_RESOURCES_MEMORY_INFO(Info)
 
 #endif
@@ -13,6 +13,7 @@
 #include <string>
 #include <stack>
 #include <thread>
+#include <mutex>
 #include <unordered_map>
 
 #ifdef TDE2_USE_WINPLATFORM
@@ -60,6 +61,16 @@ namespace TDEngine2
 
 			TDE2_API void WriteSample(const std::string& name, F32 startTime, F32 duration, USIZE threadID) override;
 
+			/*!
+				\brief The method writes a value of a named counter for the current frame. Counters are used to track
+				values that aren't time intervals, e.g. sizes of queues
+
+				\param[in] name A name of the counter
+				\param[in] value A value of the counter
+			*/
+
+			TDE2_API void WriteCounter(const std::string& name, F32 value) override;
+
 			/*!
 				\brief The method returns instrumental timer that's used for measurements
 
@@ -96,6 +107,16 @@ namespace TDEngine2
 
 			TDE2_API const TSamplesTable& GetSamplesLogByFrameIndex(U32 frameIndex) const override;
 
+			/*!
+				\brief The method returns counters based on a given frame's index
+
+				\param[in] frameIndex Frame's index
+
+				\return The method returns counters based on a given frame's index
+			*/
+
+			TDE2_API const TCountersTable& GetCountersByFrameIndex(U32 frameIndex) const override;
+
 			/*!
 				\brief The function is replacement of factory method for instances of this type.
 				The only instance will be created per program's lifetime.
@@ -119,10 +140,14 @@ namespace TDEngine2
 
 			TFramesTimesLog     mFramesTimesStatistics;
 
+			TCountersLog        mFramesCounters;
+
 			U32                 mCurrFrameIndex;
 
 			U32                 mWorstTimeFrameIndex;
 
+			mutable std::mutex  mMutex; ///< Samples are written from worker threads too
+
 	};
 
 
@@ -169,8 +194,10 @@ namespace TDEngine2
 
 #if TDE2_BUILTIN_PERF_PROFILER_ENABLED
 	#define TDE2_BUILTIN_PROFILER_EVENT(Name) CProfilerScope scope##__LINE__(Name)	
+	#define TDE2_PROFILER_COUNTER(Name, Value) CPerfProfiler::Get()->WriteCounter(Name, Value)
 #else
 	#define TDE2_BUILTIN_PROFILER_EVENT(Name) 
+	#define TDE2_PROFILER_COUNTER(Name, Value)
 #endif
 
 
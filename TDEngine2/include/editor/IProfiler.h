@@ -10,6 +10,8 @@
 #include "../utils/Config.h"
 #include "../utils/Types.h"
 #include "../core/IBaseObject.h"
+#include <string>
+#include <unordered_map>
 
 
 namespace TDEngine2
@@ -43,6 +45,8 @@ namespace TDEngine2
 			typedef std::unordered_map<USIZE, TSamplesArray> TSamplesTable;
 			typedef std::vector<TSamplesTable>               TSamplesLog;
 			typedef std::vector<F32>                         TFramesTimesLog;
+			typedef std::unordered_map<std::string, F32>     TCountersTable;
+			typedef std::vector<TCountersTable>              TCountersLog;
 		public:
 			/*!
 				\brief The method stars to record current frame's statistics. The method should be called only once per frame
@@ -71,6 +75,16 @@ namespace TDEngine2
 
 			TDE2_API virtual void WriteSample(const std::string& name, F32 startTime, F32 duration, USIZE threadID) = 0;
 
+			/*!
+				\brief The method writes a value of a named counter for the current frame. Counters are used to track
+				values that aren't time intervals, e.g. sizes of queues
+
+				\param[in] name A name of the counter
+				\param[in] value A value of the counter
+			*/
+
+			TDE2_API virtual void WriteCounter(const std::string& name, F32 value) = 0;
+
 			/*!
 				\brief The method returns instrumental timer that's used for measurements
 
@@ -106,6 +120,16 @@ namespace TDEngine2
 
 			TDE2_API virtual const TSamplesTable& GetSamplesLogByFrameIndex(U32 frameIndex) const = 0;
 
+			/*!
+				\brief The method returns counters based on a given frame's index
+
+				\param[in] frameIndex Frame's index
+
+				\return The method returns counters based on a given frame's index
+			*/
+
+			TDE2_API virtual const TCountersTable& GetCountersByFrameIndex(U32 frameIndex) const = 0;
+
 			/*!
 				\brief The function is replacement of factory method for instances of this type.
 				The only instance will be created per program's lifetime. To destroy it call Free
@@ -120,6 +144,65 @@ namespace TDEngine2
 	};
 
 
+	/*!
+		struct TPoolAllocatorInfo
+
+		\brief The structure contains statistics of a pool allocator
+	*/
+
+	typedef struct TPoolAllocatorInfo
+	{
+		USIZE mObjectSize = 0;
+		USIZE mCapacity = 0;         ///< A total number of objects that fit into all allocated pages
+		USIZE mLiveObjectsCount = 0;
+		USIZE mPeakObjectsCount = 0; ///< All slots below the peak were used once, free ones among them are holes
+
+		/*!
+			\return The method returns a ratio of living objects to the capacity of the pool
+		*/
+
+		TDE2_API F32 GetOccupancy() const { return mCapacity ? static_cast<F32>(mLiveObjectsCount) / static_cast<F32>(mCapacity) : 0.0f; }
+
+		/*!
+			\return The method returns a ratio of free slots between living objects to the peak number of objects
+		*/
+
+		TDE2_API F32 GetFragmentation() const { return mPeakObjectsCount ? static_cast<F32>(mPeakObjectsCount - mLiveObjectsCount) / static_cast<F32>(mPeakObjectsCount) : 0.0f; }
+	} TPoolAllocatorInfo, *TPoolAllocatorInfoPtr;
+
+
+	/*!
+		struct TResourceTypeMemoryInfo
+
+		\brief The structure contains statistics of all loaded resources of a single type
+	*/
+
+	typedef struct TResourceTypeMemoryInfo
+	{
+		U32   mLoadedCount = 0;
+		USIZE mMemorySize = 0;
+		U32   mEvictionsCount = 0; ///< A total number of evictions of resources of the type since the start
+	} TResourceTypeMemoryInfo, *TResourceTypeMemoryInfoPtr;
+
+
+	/*!
+		struct TResourcesMemoryInfo
+
+		\brief The structure contains statistics of the resource manager's memory budget
+	*/
+
+	typedef struct TResourcesMemoryInfo
+	{
+		typedef std::unordered_map<std::string, TResourceTypeMemoryInfo> TResourceTypesStatistics;
+
+		USIZE                    mBudget = 0;          ///< 0 means that the budget is unlimited
+		USIZE                    mUsedSize = 0;
+		U32                      mEvictionsCount = 0;
+		USIZE                    mEvictedSize = 0;
+		TResourceTypesStatistics mTypesInfo;
+	} TResourcesMemoryInfo, *TResourcesMemoryInfoPtr;
+
+
 	/*!
 		\brief The interface describes a functionality of a memory profiler
 	*/
@@ -164,6 +247,27 @@ namespace TDEngine2
 
 			TDE2_API virtual E_RESULT_CODE UpdateMemoryBlockInfo(const std::string& name, USIZE usedSize) = 0;
 
+			/*!
+				\brief The method updates statistics of a pool allocator. A new record is created if there is no the pool with given name
+
+				\param[in] name A name of the pool
+				\param[in] info Current statistics of the pool
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE UpdatePoolAllocatorInfo(const std::string& name, const TPoolAllocatorInfo& info) = 0;
+
+			/*!
+				\brief The method updates statistics of loaded resources, which are sent by the resource manager once per frame
+
+				\param[in] info Current statistics of resources
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE UpdateResourcesMemoryInfo(const TResourcesMemoryInfo& info) = 0;
+
 			TDE2_API virtual E_RESULT_CODE RegisterBaseObject(const std::string& typeId, U32Ptr address) = 0;
 			TDE2_API virtual E_RESULT_CODE UnregisterBaseObject(U32Ptr address) = 0;
 
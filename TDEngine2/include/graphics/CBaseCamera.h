@@ -223,10 +223,18 @@ namespace TDEngine2
 			*/
 
 			TDE2_API bool TestAABB(const TAABB& box) const override;
+
+			/*!
+				\brief The method returns planes of the frustum, their normals point inside the volume
+
+				\return The method returns planes of the frustum
+			*/
+
+			TDE2_API const TPlanesArray& GetPlanes() const override;
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CFrustum)
 		protected:
-			std::array<TPlaneF32, 6> mPlanes;
+			TPlanesArray mPlanes;
 	};
 
 
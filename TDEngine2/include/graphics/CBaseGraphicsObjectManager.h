@@ -63,6 +63,17 @@ namespace TDEngine2
 
 			TDE2_API IGraphicsContext* GetGraphicsContext() const override;
 
+			/*!
+				\brief The method releases a buffer that was created with one of Create*Buffer methods. The slot
+				of the buffer is reused by next created buffers
+
+				\param[in] pBuffer A pointer to a buffer which is owned by the manager
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE DestroyBuffer(IBuffer* pBuffer) override;
+
 			/*!
 				\brief The method convert input shader's name into E_DEFAULT_SHADER_TYPE's value
 
@@ -29,6 +29,28 @@ namespace TDEngine2
 	TDE2_DECLARE_SCOPED_PTR(IMaterialInstance)
 
 
+	/*!
+		struct TMaterialResourcesBindings
+
+		\brief The type contains names of resources which are referenced by a material's file. It's filled in when
+		the file is read, so the resources could be loaded asynchronously before the material is bound to them
+	*/
+
+	typedef struct TMaterialResourcesBindings
+	{
+		typedef struct TTextureBinding
+		{
+			TMaterialInstanceId mInstanceId = DefaultMaterialInstanceId;
+			std::string         mSlotId;
+			std::string         mTextureId;
+			TypeId              mTextureTypeId = TypeId::Invalid;
+		} TTextureBinding;
+
+		std::string                  mShaderName;
+		std::vector<TTextureBinding> mTextures;
+	} TMaterialResourcesBindings, *TMaterialResourcesBindingsPtr;
+
+
 	/*!
 		\brief A factory function for creation objects of CBaseMaterial's type
 
@@ -83,7 +105,7 @@ namespace TDEngine2
 			friend TDE2_API IMaterial* CreateBaseMaterial(IResourceManager* pResourceManager, IGraphicsContext* pGraphicsContext, const std::string& name,
 														  const TMaterialParameters& params, E_RESULT_CODE& result);
 		protected:
-			typedef std::unordered_map<std::string, ITexture*>                         TTexturesHashTable;
+			typedef std::unordered_map<std::string, TPtr<ITexture>>                    TTexturesHashTable; ///< Assigned textures aren't evicted until the material is
 
 			typedef std::vector<U8>                                                    TUserUniformBufferData;
 
@@ -122,6 +144,22 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE Reset() override;
 
+			/*!
+				\brief The method releases references onto assigned textures, so the resource manager could evict them as well.
+				The loader assigns them again from the material's file. Materials with runtime instances aren't evicted, because
+				their data couldn't be restored
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE Evict() override;
+
+			/*!
+				\return The method returns a size of the material's object and its user uniforms of all instances
+			*/
+
+			TDE2_API USIZE GetMemorySize() const override;
+
 			/*!
 				\brief The method deserializes object's state from given reader
 
@@ -132,6 +170,29 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE Load(IArchiveReader* pReader) override;
 
+			/*!
+				\brief The method reads the material's parameters and render states, but doesn't load resources which are referenced
+				by the file. The method doesn't access GPU, so it could be called from a worker thread
+
+				\param[in, out] pReader An input stream of data that contains information about the object
+				\param[out] bindings Names of the shader and textures which should be passed into BindResources
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE LoadParameters(IArchiveReader* pReader, TMaterialResourcesBindings& bindings);
+
+			/*!
+				\brief The method assigns the shader and textures to the material. Resources which aren't loaded yet are
+				loaded synchronously. The method should be called from the main thread
+
+				\param[in] bindings Names of resources which are returned by LoadParameters
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE BindResources(const TMaterialResourcesBindings& bindings);
+
 			/*!
 				\brief The method serializes object's state into given stream
 
@@ -191,9 +252,20 @@ namespace TDEngine2
 				\brief The method binds a material to a rendering pipeline
 
 				\param[in] materialInstanceId An identifier of an instance of this material. 0 means a default instance, which is used by default
+				\param[in] useInstancedShader If true the instanced variant of the shader is bound, see GetInstancedShaderHandle
+			*/
+
+			TDE2_API void Bind(TMaterialInstanceId instanceId = DefaultMaterialInstanceId, bool useInstancedShader = false) override;
+
+			/*!
+				\brief The method binds only per-instance data (user uniforms and textures) of the material. Pipeline's states
+				are expected to be already set up by a previous Bind call of the same material
+
+				\param[in] materialInstanceId An identifier of an instance of this material
+				\param[in] useInstancedShader The value should be the same as the one which was passed into the previous Bind call
 			*/
 
-			TDE2_API void Bind(TMaterialInstanceId instanceId = DefaultMaterialInstanceId) override;
+			TDE2_API void BindInstanceData(TMaterialInstanceId instanceId, bool useInstancedShader = false) override;
 
 			/*!
 				\brief The method assigns a given texture to a given resource's name
@@ -310,6 +382,16 @@ namespace TDEngine2
 
 			TDE2_API void SetGeometrySubGroupTag(const E_GEOMETRY_SUBGROUP_TAGS& tag) override;
 
+			/*!
+				\brief The method forces renderers to batch objects that share a mesh and the material into
+				a single instanced draw call. Materials whose shaders have the instanced variant are batched without
+				the flag, otherwise the material's shader itself should read per-instance transforms
+
+				\param[in] value A new state of the instancing
+			*/
+
+			TDE2_API void SetInstancingEnabled(bool value) override;
+
 			/*!
 				\brief The method returns hash value which corresponds to a given variable's name
 
@@ -326,6 +408,15 @@ namespace TDEngine2
 
 			TDE2_API TResourceId GetShaderHandle() const override;
 
+			/*!
+				\brief The method returns an identifier of the instanced variant of the attached shader, see GetInstancedShaderVariantName.
+				The attached shader's identifier is returned if the shader doesn't have the variant
+
+				\return The method returns an identifier of the shader that should be used with instanced draw calls
+			*/
+
+			TDE2_API TResourceId GetInstancedShaderHandle() const override;
+
 			/*!
 				\brief The method returns true if the material's instance uses alpha blending
 				based transparency
@@ -336,6 +427,14 @@ namespace TDEngine2
 
 			TDE2_API bool IsTransparent() const override;
 
+			/*!
+				\brief The method returns true if objects with the material could be drawn with GPU instancing
+
+				\return The method returns true if objects with the material could be drawn with GPU instancing
+			*/
+
+			TDE2_API bool IsInstancingEnabled() const override;
+
 			/*!
 				\brief The method returns assigned tag
 
@@ -385,6 +484,8 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE _initDefaultInstance(const TShaderCompilerOutput& metadata);
 
+			TDE2_API void _bindInstanceData(IShader* pShaderInstance, TMaterialInstanceId instanceId);
+
 			TDE2_API const TPtr<IResourceLoader> _getResourceLoader() override;
 		protected:
 			static constexpr U16     mVersionTag = 0x1;
@@ -395,6 +496,8 @@ namespace TDEngine2
 
 			TResourceId              mShaderHandle;
 
+			TResourceId              mInstancedShaderHandle = TResourceId::Invalid; ///< Invalid if the shader doesn't define TDE2_INSTANCING_SUPPORTED
+
 			TMaterialInstancesArray  mpInstancesArray;
 
 			TInstanceUniformsArray   mpInstancesUserUniformBuffers;
@@ -416,6 +519,8 @@ namespace TDEngine2
 			TRasterizerStateId       mRasterizerStateHandle = TRasterizerStateId::Invalid;
 
 			E_GEOMETRY_SUBGROUP_TAGS mTag = E_GEOMETRY_SUBGROUP_TAGS::BASE;
+
+			bool                     mIsInstancingEnabled = false; ///< The value forces instancing for materials without the instanced shader
 	};
 
 
@@ -464,8 +569,8 @@ namespace TDEngine2
 			TDE2_API E_RESULT_CODE Init(IResourceManager* pResourceManager, IGraphicsContext* pGraphicsContext, IFileSystem* pFileSystem) override;
 			
 			/*!
-				\brief The method loads data into the specified resource based on its
-				internal information
+				\brief The method reads the material's file on the calling thread and enqueues loading of its shader and textures.
+				The material stays in RST_LOADING state until it's bound to them on the main thread
 
 				\param[in, out] pResource A pointer to an allocated resource
 
@@ -38,6 +38,21 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE Reset() override;
 
+			/*!
+				\brief The method releases geometry's data and GPU buffers of the mesh. The mesh
+				could be loaded again by its loader after that
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE Evict() override;
+
+			/*!
+				\return The method returns a size of geometry's data and GPU buffers of the mesh
+			*/
+
+			TDE2_API USIZE GetMemorySize() const override;
+
 			/*!
 				\brief The method adds a new point into the array of mesh's positions
 
@@ -10,6 +10,7 @@
 #include "./../core/CBaseResource.h"
 #include "IShader.h"
 #include <vector>
+#include <tuple>
 
 
 namespace TDEngine2
@@ -132,4 +133,26 @@ namespace TDEngine2
 
 			TShaderCompilerOutput*        mpShaderMeta;
 	};
+
+
+	/*!
+		\brief The function returns a name of the instanced variant of a shader. The variant is compiled from the same source
+		with TDE2_INSTANCING_ENABLED defined, so only shaders that define TDE2_INSTANCING_SUPPORTED have it
+
+		\param[in] shaderName A name of a shader's resource
+
+		\return The function returns a name of the instanced variant's resource
+	*/
+
+	TDE2_API std::string GetInstancedShaderVariantName(const std::string& shaderName);
+
+	/*!
+		\brief The function splits a name of a shader's resource into a name of its source and a flag of the instanced variant
+
+		\param[in] name A name of a shader's resource, which could be returned by GetInstancedShaderVariantName
+
+		\return The function returns a name of the shader's source and true if the name belongs to the instanced variant
+	*/
+
+	TDE2_API std::tuple<std::string, bool> ParseShaderVariantName(const std::string& name);
 }
@@ -188,6 +188,8 @@ namespace TDEngine2
 				TShaderResourcesMap     mShaderResources;
 
 				TStagesRegionsMap       mShaderStagesRegionsInfo;
+
+				bool                    mIsInstancingSupported = false;
 			} TShaderMetadata;
 		public:
 			/*!
@@ -231,6 +233,8 @@ namespace TDEngine2
 
 			static const C8* mTargetVersionDefineName;
 
+			static const C8* mInstancingSupportDefineName;
+
 			IFileSystem*     mpFileSystem;
 	};
 }
\ No newline at end of file
@@ -124,6 +124,21 @@ namespace TDEngine2
 
 			TDE2_API TRectF32 GetNormalizedTextureRect() const override;
 
+			/*!
+				\brief The method releases GPU memory of the texture. The object stays initialized, so
+				the texture's loader could recreate its content later
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE Evict() override;
+
+			/*!
+				\return The method returns an approximate size of the texture's data including its mip chain
+			*/
+
+			TDE2_API USIZE GetMemorySize() const override;
+
 			static TDE2_API TTextureSamplerId GetTextureSampleHandle(IGraphicsContext* pGraphicsContext, const TTextureSamplerDesc& params);
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CBaseTexture2D)
@@ -131,6 +146,12 @@ namespace TDEngine2
 			TDE2_API virtual E_RESULT_CODE _createInternalTextureHandler(IGraphicsContext* pGraphicsContext, U32 width, U32 height, E_FORMAT_TYPE format,
 																		 U32 mipLevelsCount, U32 samplesCount, U32 samplingQuality) = 0;
 
+			/*!
+				\brief The method releases GAPI objects of the texture, unlike Reset it doesn't change the state of the object
+			*/
+
+			TDE2_API virtual E_RESULT_CODE _releaseInternalTextureHandler() = 0;
+
 			TDE2_API const TPtr<IResourceLoader> _getResourceLoader() override;
 		protected:
 			IGraphicsContext*   mpGraphicsContext;
@@ -12,6 +12,7 @@
 #include "../core/CBaseObject.h"
 #include "IRenderer.h"
 #include "InternalShaderData.h"
+#include "CRenderQueue.h"
 
 
 namespace TDEngine2
@@ -93,6 +94,26 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE SetLightingData(const TLightingShaderData& lightingData) override;
 
+			/*!
+				\brief The method stores point lights and their assignment to clusters of the view frustum. The data is uploaded
+				into IUBR_LIGHTS buffer before the frame is drawn
+
+				\param[in] lightClustersData A parameter that contains point lights and clusters
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE SetLightClustersData(const TLightClustersShaderData& lightClustersData) override;
+
+			/*!
+				\brief The method specifies cascades of the directional shadow map which should be redrawn within the next frame.
+				The rest cascades keep their content from previous frames
+
+				\param[in] cascadesMask A mask where i-th bit corresponds to i-th cascade
+			*/
+
+			TDE2_API void SetShadowCascadesUpdateMask(U32 cascadesMask) override;
+
 			/*!
 				\brief The method sets up a pointer to selection manager
 
@@ -140,6 +161,13 @@ namespace TDEngine2
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CForwardRenderer)
 
 			TDE2_API void _prepareFrame(F32 currTime, F32 deltaTime);
+
+			/*!
+				\brief The method gathers data of all submitted commands and uploads it at once. Commands
+				refer to their data by indices
+			*/
+
+			TDE2_API void _uploadObjectsData();
 		protected:
 			TPtr<IGraphicsContext>        mpGraphicsContext;
 							         
@@ -160,5 +188,16 @@ namespace TDEngine2
 			ISelectionManager*            mpSelectionManager;
 
 			TLightingShaderData           mLightingData;
+
+			TLightClustersShaderData      mLightClustersData;
+
+			TPerFrameShaderData           mPerFrameShaderData;
+
+			U32                           mShadowCascadesUpdateMask;
+			U32                           mShadowMapSizes; ///< Sizes of cascades which were used for rendering last time, they're redrawn when the value changes
+
+			TRenderStateCache             mRenderStateCache;
+
+			std::vector<TPerObjectShaderData> mObjectsData;
 	};
 }
\ No newline at end of file
@@ -84,6 +84,15 @@ namespace TDEngine2
 
 			TDE2_API void SetColor(const TColor32F& color) override;
 
+			/*!
+				\brief The method caches an identifier of the material's resource which is resolved by a renderer.
+				The cached value is reset when the material's name changes
+
+				\param[in] materialId An identifier of the material
+			*/
+
+			TDE2_API void SetMaterialId(TResourceId materialId) override;
+
 			/*!
 					\brief The method returns an identifier of used material
 
@@ -92,6 +101,14 @@ namespace TDEngine2
 
 			TDE2_API const std::string& GetMaterialName() const override;
 
+			/*!
+				\brief The method returns a cached identifier of used material or TResourceId::Invalid if it's not resolved yet
+
+				\return The method returns a cached identifier of used material or TResourceId::Invalid if it's not resolved yet
+			*/
+
+			TDE2_API TResourceId GetMaterialId() const override;
+
 			/*!
 				\brief The method returns a color of a sprite
 
@@ -105,6 +122,8 @@ namespace TDEngine2
 			std::string mMaterialName;
 
 			TColor32F   mColor;
+
+			TResourceId mMaterialId = TResourceId::Invalid; ///< A cached identifier of the material, it's resolved by a renderer
 			/*!
 				\todo a sprite should contains
 				- ref to atlas 
@@ -13,6 +13,7 @@
 #include "../core/IGraphicsContext.h"
 #include "../core/memory/IAllocator.h"
 #include "../graphics/IMaterial.h"
+#include "../graphics/IShader.h"
 #include "InternalShaderData.h"
 #include <vector>
 #include <tuple>
@@ -27,11 +28,95 @@ namespace TDEngine2
 	class CRenderQueue;
 	class IRenderer;
 	class IVertexDeclaration;
+	class IIndexBuffer;
 	class IResourceManager;
 	class IGlobalShaderProperties;
 	class IResourceHandler;
 
 
+	/*!
+		struct TRenderStateCache
+
+		\brief The structure keeps track of a pipeline's state that was set up by the last submitted draw command.
+		Binds of the same material's instance, vertex declaration or buffers are skipped
+	*/
+
+	typedef struct TRenderStateCache
+	{
+		/*!
+			\brief The method forgets all cached bindings. Should be called each time when the pipeline's state
+			could be changed outside of draw commands
+		*/
+
+		TDE2_API void Invalidate();
+
+		/*!
+			\brief The method resets binds and skips counters
+		*/
+
+		TDE2_API void ResetStats();
+
+		/*!
+			\brief The method binds a material's instance if it differs from the last bound one. If only an instance
+			is changed its user data is rebound without pipeline's states
+
+			\param[in, out] pResourceManager A pointer to IResourceManager implementation
+			\param[in] materialHandle A handle of a material
+			\param[in] instanceId An identifier of material's instance
+			\param[in] useInstancedShader If true the instanced variant of the material's shader is bound
+
+			\return A pointer to the material or nullptr if there is no material with the given handle
+		*/
+
+		TDE2_API IMaterial* BindMaterial(IResourceManager* pResourceManager, TResourceId materialHandle, TMaterialInstanceId instanceId, bool useInstancedShader = false);
+
+		/*!
+			\brief The method binds a vertex declaration if it or its buffers or the current shader were changed.
+			Cached vertex and index buffers are invalidated in this case, because they could be a part of declaration's state
+
+			\param[in, out] pGraphicsContext A pointer to IGraphicsContext implementation
+			\param[in, out] pVertexDeclaration A pointer to IVertexDeclaration implementation
+			\param[in, out] pVertexBuffer A pointer to a vertex buffer with per vertex data
+			\param[in, out] pInstancingBuffer A pointer to a vertex buffer with per instance data, could be nullptr
+		*/
+
+		TDE2_API void BindVertexDeclaration(IGraphicsContext* pGraphicsContext, IVertexDeclaration* pVertexDeclaration, IVertexBuffer* pVertexBuffer,
+											IVertexBuffer* pInstancingBuffer = nullptr);
+
+		TDE2_API void BindVertexBuffer(U32 slot, IVertexBuffer* pVertexBuffer, U32 stride);
+
+		TDE2_API void BindIndexBuffer(IIndexBuffer* pIndexBuffer);
+
+		static constexpr U32 mMaxVertexBuffersCount = 2;
+
+		TResourceId         mMaterialHandle = TResourceId::Invalid;
+
+		TMaterialInstanceId mMaterialInstanceId = TMaterialInstanceId::Invalid;
+
+		bool                mIsInstancedShaderBound = false;
+
+		TPtr<IMaterial>     mpMaterial;
+
+		TPtr<IShader>       mpShader;
+
+		IVertexDeclaration* mpVertexDeclaration = nullptr;
+
+		IShader*            mpDeclarationShader = nullptr;
+
+		IVertexBuffer*      mpDeclarationBuffers[mMaxVertexBuffersCount] { nullptr, nullptr };
+
+		IVertexBuffer*      mpVertexBuffers[mMaxVertexBuffersCount] { nullptr, nullptr };
+
+		U32                 mVertexBuffersStrides[mMaxVertexBuffersCount] { 0, 0 };
+
+		IIndexBuffer*       mpIndexBuffer = nullptr;
+
+		U32                 mBindsCount = 0;
+
+		U32                 mSkippedBindsCount = 0;
+	} TRenderStateCache, *TRenderStateCachePtr;
+
+
 	typedef struct TRenderCommand
 	{
 		TDE2_API virtual ~TRenderCommand() = default;
@@ -45,10 +130,12 @@ namespace TDEngine2
 
 			\param[in, out] pGlobalShaderProperties A pointer to IGlobalShaderProperties implementation
 
+			\param[in, out] pStateCache A pointer to a state of the pipeline that's shared between commands. If nullptr is passed all states are rebound
+
 			\return RC_OK if everything went ok, or some other code, which describes an error
 		*/
 
-		TDE2_API virtual E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties) = 0;
+		TDE2_API virtual E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache) = 0;
 
 		E_PRIMITIVE_TOPOLOGY_TYPE mPrimitiveType;
 
@@ -62,6 +149,8 @@ namespace TDEngine2
 
 		TPerObjectShaderData      mObjectData;
 
+		U32                       mObjectDataIndex = InvalidPerObjectDataIndex; ///< An index within per frame objects' data which is assigned by a renderer, mObjectData is written per draw call if it's invalid
+
 		TRectU32                  mScissorRect; ///< \note The assignment is executed only if the corresponding test is enabled for used material
 	} TRenderCommand, *TRenderCommandPtr;
 
@@ -77,10 +166,12 @@ namespace TDEngine2
 
 			\param[in, out] pGlobalShaderProperties A pointer to IGlobalShaderProperties implementation
 
+			\param[in, out] pStateCache A pointer to a state of the pipeline that's shared between commands. If nullptr is passed all states are rebound
+
 			\return RC_OK if everything went ok, or some other code, which describes an error
 		*/
 
-		TDE2_API E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties) override;
+		TDE2_API E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache) override;
 
 		U32 mNumOfVertices;
 
@@ -99,10 +190,12 @@ namespace TDEngine2
 
 			\param[in, out] pGlobalShaderProperties A pointer to IGlobalShaderProperties implementation
 
+			\param[in, out] pStateCache A pointer to a state of the pipeline that's shared between commands. If nullptr is passed all states are rebound
+
 			\return RC_OK if everything went ok, or some other code, which describes an error
 		*/
 
-		TDE2_API E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties) override;
+		TDE2_API E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache) override;
 
 		U32           mNumOfIndices;
 
@@ -125,10 +218,12 @@ namespace TDEngine2
 
 			\param[in, out] pGlobalShaderProperties A pointer to IGlobalShaderProperties implementation
 
+			\param[in, out] pStateCache A pointer to a state of the pipeline that's shared between commands. If nullptr is passed all states are rebound
+
 			\return RC_OK if everything went ok, or some other code, which describes an error
 		*/
 
-		TDE2_API E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties) override;
+		TDE2_API E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache) override;
 
 		U32            mStartVertex;
 
@@ -153,10 +248,12 @@ namespace TDEngine2
 
 			\param[in, out] pGlobalShaderProperties A pointer to IGlobalShaderProperties implementation
 
+			\param[in, out] pStateCache A pointer to a state of the pipeline that's shared between commands. If nullptr is passed all states are rebound
+
 			\return RC_OK if everything went ok, or some other code, which describes an error
 		*/
 
-		TDE2_API E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties) override;
+		TDE2_API E_RESULT_CODE Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache) override;
 
 		U32            mBaseVertexIndex;
 
@@ -174,6 +271,65 @@ namespace TDEngine2
 	} TDrawIndexedInstancedCommand, *TDrawIndexedInstancedCommandPtr;
 
 
+	/*!
+		\brief The function builds a 64-bit key which is used to sort draw commands within CRenderQueue. Commands with greater keys
+		are submitted first. The key's fields from the highest bits to the lowest ones are
+
+		| layer (8) | opaque flag (1) | material (32) or depth (16) | depth (16) or material (32) | sequence (7) |
+
+		Opaque commands precede transparent ones. The former are grouped by materials and sorted front-to-back, the latter are
+		sorted back-to-front before materials
+
+		\param[in] layer A layer of a command, see GetGeometrySubGroupLayer
+		\param[in] isTransparent The flag is true for geometry with translucent materials
+		\param[in] materialId A handle of command's material
+		\param[in] distanceToCamera A view space depth of an object
+		\param[in] sequence A tie breaker for commands of the same object, only 7 lowest bits are used
+
+		\return A packed 64-bit sorting key
+	*/
+
+	TDE2_API U64 MakeRenderCommandSortKey(U8 layer, bool isTransparent, TResourceId materialId, F32 distanceToCamera, U8 sequence = 0);
+
+	/*!
+		\brief The function maps a geometry's sub-group tag into a layer of a sorting key keeping the order of tags' values
+
+		\param[in] tag A value of E_GEOMETRY_SUBGROUP_TAGS type
+
+		\return A layer that could be passed into MakeRenderCommandSortKey
+	*/
+
+	TDE2_API U8 GetGeometrySubGroupLayer(E_GEOMETRY_SUBGROUP_TAGS tag);
+
+
+	/*!
+		enum class E_RENDER_COMMANDS_RECORDER_TYPE
+
+		\brief The enumeration lists recorders of commands that share render queues. Each of them owns a range of
+		submission indices, see MakeRenderCommandSubmissionIndex
+	*/
+
+	enum class E_RENDER_COMMANDS_RECORDER_TYPE: U8
+	{
+		RCRT_MAIN_THREAD,
+		RCRT_STATIC_MESHES,
+		RCRT_SKINNED_MESHES,
+	};
+
+
+	/*!
+		\brief The function builds a submission index that's unique among all recorders of a queue, so commands
+		with equal keys are ordered in the same way each frame regardless of which systems record them
+
+		\param[in] recorderType A recorder of a command
+		\param[in] index An index of a command among the recorder's ones, only 24 lowest bits are used
+
+		\return A submission index that could be passed into CRenderQueue::SubmitDrawCommand
+	*/
+
+	TDE2_API U32 MakeRenderCommandSubmissionIndex(E_RENDER_COMMANDS_RECORDER_TYPE recorderType, U32 index);
+
+
 	/*!
 		\brief A factory function for creation objects of CRenderQueue's type
 
@@ -187,20 +343,54 @@ namespace TDEngine2
 	TDE2_API CRenderQueue* CreateRenderQueue(IAllocator* pTempAllocator, E_RESULT_CODE& result);
 
 
+	/*!
+		\brief A factory function for creation objects of CRenderQueue's type which allows to record commands from worker threads
+		of a job manager in parallel
+
+		\param[in, out] pTempAllocator  A pointer to IAllocator object which will be used for temporary allocations of the main thread
+
+		\param[in] workersAllocators An array of allocators, one per worker thread. The queue owns all of them
+
+		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
+
+		\return A pointer to CRenderQueue's implementation
+	*/
+
+	TDE2_API CRenderQueue* CreateRenderQueue(IAllocator* pTempAllocator, const std::vector<IAllocator*>& workersAllocators, E_RESULT_CODE& result);
+
+
 	/*!
 		interface CRenderQueue
 
 		\brief The interface describes a functionality of
 		a rendering queue, which accumulates commands and
-		later sends it to a renderer
+		later sends it to a renderer.
+
+		Each worker thread records commands into its own buffer with its own allocator, so systems could fill the same
+		queue from parallel jobs. The buffers are merged when commands are sorted or iterated, that should happen after
+		all recording jobs are completed
 	*/
 
 	class CRenderQueue: public CBaseObject
 	{
 		public:
 			friend TDE2_API CRenderQueue* CreateRenderQueue(IAllocator* pTempAllocator, E_RESULT_CODE& result);
+			friend TDE2_API CRenderQueue* CreateRenderQueue(IAllocator* pTempAllocator, const std::vector<IAllocator*>& workersAllocators, E_RESULT_CODE& result);
 		protected:
-			typedef std::vector<std::tuple<U32, TRenderCommand*>> TCommandsArray;
+			typedef struct TCommandEntry
+			{
+				U64             mSortKey;
+				U32             mSubmissionIndex;
+				TRenderCommand* mpCommand;
+			} TCommandEntry, *TCommandEntryPtr;
+
+			typedef std::vector<TCommandEntry> TCommandsArray;
+
+			typedef struct TRecordingContext
+			{
+				IAllocator*    mpAllocator = nullptr;
+				TCommandsArray mCommandsBuffer;
+			} TRecordingContext, *TRecordingContextPtr;
 		public:
 			/*!
 				class CRenderQueueIterator
@@ -225,6 +415,7 @@ namespace TDEngine2
 
 					TDE2_API TRenderCommand* Get() const;
 					TDE2_API U32 GetIndex() const;
+					TDE2_API U64 GetSortKey() const;
 
 					TDE2_API CRenderQueueIterator& operator++();
 
@@ -245,35 +436,46 @@ namespace TDEngine2
 				\param[in, out] pTempAllocator A pointer to IAllocator object which will be used
 				for temporary allocations
 
+				\param[in] workersAllocators An array of allocators of worker threads, commands that are submitted from
+				the i-th worker are placed with the i-th allocator
+
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 			
-			TDE2_API E_RESULT_CODE Init(IAllocator* pTempAllocator);
+			TDE2_API E_RESULT_CODE Init(IAllocator* pTempAllocator, const std::vector<IAllocator*>& workersAllocators = {});
 
 			/*!
-				\brief The method creates and pushes a new command to the queue
+				\brief The method creates and pushes a new command to the queue. The method could be called from
+				worker threads of the job manager simultaneously, if the queue was created with their allocators
 
-				\param groupKey A key of a created command
+				\param groupKey A key of a created command, commands with greater keys are submitted first. Use MakeRenderCommandSortKey
+				to build a key for scene's geometry
+
+				\param submissionIndex Commands with equal keys are ordered by this index. Commands that are recorded from jobs should
+				pass unique indices that are built with MakeRenderCommandSubmissionIndex, because the distribution of jobs among workers varies between frames
 
 				\return A pointer to TRenderCommand object
 			*/
 
 			template <typename T>
-			TDE2_API T* SubmitDrawCommand(U32 groupKey)
+			TDE2_API T* SubmitDrawCommand(U64 groupKey, U32 submissionIndex = 0)
 			{
 				static_assert(std::is_base_of<TRenderCommand, T>::value, "Invalid template argument's type. \"T\" should derive TRenderCommand type");
 
-				if (!mpTempAllocator)
+				TRecordingContext* pWorkerContext = _getCurrWorkerRecordingContext();
+
+				IAllocator* pAllocator = pWorkerContext ? pWorkerContext->mpAllocator : mpTempAllocator;
+				if (!pAllocator)
 				{
 					return nullptr;
 				}
 
-				void* pMemoryBlock = mpTempAllocator->Allocate(sizeof(T), __alignof(T));
+				void* pMemoryBlock = pAllocator->Allocate(sizeof(T), __alignof(T));
 				TDE2_ASSERT(pMemoryBlock);
 
 				T* pRenderCommand = new (pMemoryBlock) T(); /// \todo Replace the allocation with a helper function's invokation
 
-				mCommandsBuffer.emplace_back(groupKey, pRenderCommand);
+				(pWorkerContext ? pWorkerContext->mCommandsBuffer : mCommandsBuffer).push_back({ groupKey, submissionIndex, pRenderCommand });
 
 				return pRenderCommand;
 			}
@@ -287,7 +489,9 @@ namespace TDEngine2
 			TDE2_API E_RESULT_CODE Clear();
 
 			/*!
-				\brief The method sorts existing commands in buffer based on their group keys
+				\brief The method sorts existing commands in buffer based on their group keys in descending order. Commands with equal keys
+				are ordered by their submission indices, the order of submission is preserved for equal indices. LSD radix sort is used,
+				submission indices are its least significant digits
 			*/
 
 			TDE2_API void Sort();
@@ -301,7 +505,8 @@ namespace TDEngine2
 			TDE2_API bool IsEmpty() const;
 
 			/*!
-				\brief The method creates a new iterator that points to the beginning of the commands buffer and returns it
+				\brief The method creates a new iterator that points to the beginning of the commands buffer and returns it.
+				The order of commands that are recorded from jobs is defined only after Sort is called
 
 				\return The method creates a new iterator that points to the beginning of the commands buffer and returns it
 			*/
@@ -311,10 +516,18 @@ namespace TDEngine2
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CRenderQueue)
 
 			TDE2_API E_RESULT_CODE _onFreeInternal() override;
+
+			TDE2_API TRecordingContext* _getCurrWorkerRecordingContext();
+
+			TDE2_API void _mergeRecordedCommands();
 		protected:
-			TCommandsArray mCommandsBuffer;
+			TCommandsArray                 mCommandsBuffer; ///< Commands of the main thread, and all commands after they're merged
+
+			TCommandsArray                 mTempCommandsBuffer; ///< An auxiliary buffer of the radix sort
+
+			IAllocator*                    mpTempAllocator;
 
-			IAllocator*    mpTempAllocator;
+			std::vector<TRecordingContext> mWorkersContexts;
 	};
 
 
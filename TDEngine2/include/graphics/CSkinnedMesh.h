@@ -55,6 +55,9 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE Accept(IBinaryMeshFileReader* pReader) override;
 
+			TDE2_API E_RESULT_CODE Evict() override;
+			TDE2_API USIZE GetMemorySize() const override;
+
 			TDE2_API void AddVertexJointWeights(const TJointsWeightsArray& weights) override;
 			TDE2_API void AddVertexJointIndices(const TJointsIndicesArray& indices) override;
 
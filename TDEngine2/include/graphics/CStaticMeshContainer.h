@@ -97,6 +97,32 @@ namespace TDEngine2
 
 			TDE2_API void SetDirty(bool value) override;
 
+			/*!
+				\brief The method caches an identifier of the material's resource which is resolved by a renderer.
+				The cached value is reset when the material's name changes
+
+				\param[in] materialId An identifier of the material
+			*/
+
+			TDE2_API void SetMaterialId(TResourceId materialId) override;
+
+			/*!
+				\brief The method caches an identifier of the mesh's resource which is resolved by a renderer.
+				The cached value is reset when the mesh's name changes
+
+				\param[in] meshId An identifier of the mesh
+			*/
+
+			TDE2_API void SetMeshId(TResourceId meshId) override;
+
+			/*!
+				\brief The method marks the mesh as a static one. Static casters don't invalidate cached cascades of the shadow map
+
+				\param[in] value If true the mesh is considered as a static one
+			*/
+
+			TDE2_API void SetStatic(bool value) override;
+
 #if TDE2_EDITORS_ENABLED
 			TDE2_API void AddSubmeshIdentifier(const std::string& submeshId) override;
 #endif
@@ -130,6 +156,30 @@ namespace TDEngine2
 
 			TDE2_API bool IsDirty() const override;
 
+			/*!
+				\brief The method returns a cached identifier of used material or TResourceId::Invalid if it's not resolved yet
+
+				\return The method returns a cached identifier of used material or TResourceId::Invalid if it's not resolved yet
+			*/
+
+			TDE2_API TResourceId GetMaterialId() const override;
+
+			/*!
+				\brief The method returns a cached identifier of used mesh or TResourceId::Invalid if it's not resolved yet
+
+				\return The method returns a cached identifier of used mesh or TResourceId::Invalid if it's not resolved yet
+			*/
+
+			TDE2_API TResourceId GetMeshId() const override;
+
+			/*!
+				\brief The method returns true if the mesh isn't moved during the gameplay
+
+				\return The method returns true if the mesh isn't moved during the gameplay
+			*/
+
+			TDE2_API bool IsStatic() const override;
+
 #if TDE2_EDITORS_ENABLED
 			TDE2_API const std::vector<std::string>& GetSubmeshesIdentifiers() const override;
 #endif
@@ -140,11 +190,15 @@ namespace TDEngine2
 			std::string              mMeshName; /// \todo replace with GUID or something like that
 			std::string              mSubMeshId = Wrench::StringUtils::GetEmptyStr(); ///< If the field's value is empty the whole mesh will be rendered with same material
 
+			TResourceId              mMaterialId = TResourceId::Invalid; ///< Cached identifiers of resources, they're resolved by renderers
+			TResourceId              mMeshId = TResourceId::Invalid;
+
 			U32                      mSystemBuffersHandle = static_cast<U32>(-1);
 
 			TSubMeshRenderInfo       mSubMeshInfo;
 
 			bool                     mIsDirty = true;
+			bool                     mIsStatic = false;
 
 #if TDE2_EDITORS_ENABLED
 			std::vector<std::string> mSubmeshesIdentifiers;
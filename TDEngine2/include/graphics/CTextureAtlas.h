@@ -226,6 +226,21 @@ namespace TDEngine2
 			*/
 
 			TDE2_API E_RESULT_CODE Reset() override;
+
+			/*!
+				\brief The method releases the atlas's registry of subtextures. The texture itself is a separate resource
+				which is evicted on its own
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API E_RESULT_CODE Evict() override;
+
+			/*!
+				\return The method returns an approximate size of the atlas's registry of subtextures
+			*/
+
+			TDE2_API USIZE GetMemorySize() const override;
 			
 			/*!
 				\brief The method returns a pointer to texture that is used with texture atlas
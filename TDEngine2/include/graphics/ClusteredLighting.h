@@ -0,0 +1,45 @@
+/*!
+	\file ClusteredLighting.h
+	\date 16.10.2026
+	\authors Kasimov Ildar
+*/
+
+#pragma once
+
+
+#include "../utils/Types.h"
+#include "../math/TMatrix4.h"
+
+
+namespace TDEngine2
+{
+	class IWorld;
+	struct TLightClustersShaderData;
+
+
+	/*!
+		\brief The function assigns point lights to clusters of the view frustum. Bounds of each light are projected onto
+		the grid of clusters, then slices of the grid are filled on worker threads. If a total number of references exceeds
+		MaxLightClustersIndicesCount all clusters are limited by the same number of lights, so the truncation is spread over
+		the whole frustum. Overflowed clusters keep lights with lower indices, so lights should be sorted by their importance.
+		A number of dropped references is written as the profiler's counter
+
+		\param[in, out] pWorld A pointer to IWorld's implementation which splits the work between worker threads, if it's nullptr
+		all the clusters are processed on the calling thread
+
+		\param[in] viewMatrix A view matrix of the camera
+
+		\param[in] projMatrix A projection matrix of the camera
+
+		\param[in] zNear A distance to the near plane of the camera
+
+		\param[in] zFar A distance to the far plane of the camera
+
+		\param[in, out] lightClustersData The structure should contain mPointLightsCount point lights, the rest fields are written by the function
+
+		\return The function returns a total number of references from clusters onto point lights
+	*/
+
+	TDE2_API U32 AssignPointLightsToClusters(IWorld* pWorld, const TMatrix4& viewMatrix, const TMatrix4& projMatrix, F32 zNear, F32 zFar,
+											 TLightClustersShaderData& lightClustersData);
+}
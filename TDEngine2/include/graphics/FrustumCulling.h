@@ -0,0 +1,40 @@
+/*!
+	\file FrustumCulling.h
+	\date 16.10.2026
+	\authors Kasimov Ildar
+*/
+
+#pragma once
+
+
+#include "../utils/Types.h"
+#include "../utils/Config.h"
+#include <vector>
+
+
+namespace TDEngine2
+{
+	class IWorld;
+	class IFrustum;
+	class CBoundsComponent;
+
+
+	/*!
+		\brief The function is a visibility stage which is shared between renderers. It tests bounds of renderables against planes
+		of the frustum. Boxes are packed by four into SIMD registers and packets are processed on worker threads.
+		Elements without bounds or with bounds which aren't recomputed yet are considered as visible ones
+
+		\param[in, out] pWorld A pointer to IWorld's implementation which splits the work between worker threads, if it's nullptr
+		all the bounds are processed on the calling thread
+
+		\param[in] pFrustum A pointer to a frustum of the active camera, if it's nullptr all elements are visible
+
+		\param[in] bounds An array of bounds of renderables, the array can contain nullptr values
+
+		\param[out] visibilityFlags An array with the same size as bounds has, non-zero values correspond to visible elements
+
+		\return The function returns a number of visible elements
+	*/
+
+	TDE2_API U32 CullBoundsByFrustum(IWorld* pWorld, const IFrustum* pFrustum, const std::vector<CBoundsComponent*>& bounds, std::vector<U8>& visibilityFlags);
+}
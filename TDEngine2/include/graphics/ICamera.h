@@ -13,7 +13,9 @@
 #include "../math/TVector3.h"
 #include "../math/TMatrix4.h"
 #include "../math/MathUtils.h"
+#include "../math/TPlane.h"
 #include "../core/IBaseObject.h"
+#include <array>
 
 
 namespace TDEngine2
@@ -308,6 +310,8 @@ namespace TDEngine2
 
 	class IFrustum : public virtual IBaseObject
 	{
+		public:
+			typedef std::array<TPlaneF32, 6> TPlanesArray;
 		public:
 			/*!
 				\brief The method initializes an internal state of a frustum
@@ -358,6 +362,14 @@ namespace TDEngine2
 			*/
 
 			TDE2_API virtual bool TestAABB(const TAABB& box) const = 0;
+
+			/*!
+				\brief The method returns planes of the frustum, their normals point inside the volume
+
+				\return The method returns planes of the frustum
+			*/
+
+			TDE2_API virtual const TPlanesArray& GetPlanes() const = 0;
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(IFrustum);
 	};
@@ -46,6 +46,18 @@ namespace TDEngine2
 
 			TDE2_API virtual void Bind(U32 slot) = 0;
 
+			/*!
+				\brief The method binds a part of a constant buffer to a given slot, so shaders see it as a whole buffer
+
+				\param[in] slot An index of a slot, in which the constant buffer will be binded to
+				\param[in] offset An offset in bytes from the beginning of the buffer, should be a multiple of 256
+				\param[in] size A size of the range in bytes, should be a multiple of 256
+
+				\return RC_OK if everything went ok, RC_NOT_IMPLEMENTED_YET if GAPI doesn't support binding of ranges
+			*/
+
+			TDE2_API virtual E_RESULT_CODE BindRange(U32 slot, USIZE offset, USIZE size) = 0;
+
 			/*!
 				\brief The method unbinds a constant buffer from rendering pipeline
 			*/
@@ -10,11 +10,13 @@
 #include "../core/IBaseObject.h"
 #include "../utils/Types.h"
 #include "../utils/Utils.h"
+#include <vector>
 
 
 namespace TDEngine2
 {
 	class IGraphicsObjectManager;
+	struct TPerObjectShaderData;
 
 
 	/*!
@@ -50,6 +52,28 @@ namespace TDEngine2
 			*/
 
 			TDE2_API virtual E_RESULT_CODE SetInternalUniformsBuffer(E_INTERNAL_UNIFORM_BUFFER_REGISTERS slot, const U8* pData, U32 dataSize) = 0;
+
+			/*!
+				\brief The method uploads data of all objects that are drawn within the current frame. Objects are packed
+				into pages of PerObjectShaderDataPageSize bytes, so a single page is written at once instead of a write per draw call
+
+				\param[in] objectsData An array of objects' data, indices of elements are passed into BindObjectData later
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE SetObjectsData(const std::vector<TPerObjectShaderData>& objectsData) = 0;
+
+			/*!
+				\brief The method binds data of an object which was uploaded with SetObjectsData into IUBR_PER_OBJECT register
+
+				\param[in] objectIndex An index of the object within an array that was passed into SetObjectsData
+
+				\return RC_OK if everything went ok, RC_NOT_IMPLEMENTED_YET if GAPI can't bind ranges of uniforms buffers.
+				In the latter case the object's data should be written with SetInternalUniformsBuffer
+			*/
+
+			TDE2_API virtual E_RESULT_CODE BindObjectData(U32 objectIndex) = 0;
 		protected:
 			DECLARE_INTERFACE_PROTECTED_MEMBERS(IGlobalShaderProperties)
 	};
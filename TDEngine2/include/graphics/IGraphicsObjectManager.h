@@ -18,6 +18,7 @@
 
 namespace TDEngine2
 {
+	class IBuffer;
 	class IVertexBuffer;
 	class IConstantBuffer;
 	class IGraphicsContext;
@@ -117,6 +118,17 @@ namespace TDEngine2
 
 			TDE2_API virtual TResult<IConstantBuffer*> CreateConstantBuffer(E_BUFFER_USAGE_TYPE usageType, USIZE totalBufferSize, const void* pDataPtr) = 0;
 
+			/*!
+				\brief The method releases a buffer that was created with one of Create*Buffer methods. The slot
+				of the buffer is reused by next created buffers
+
+				\param[in] pBuffer A pointer to a buffer which is owned by the manager
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE DestroyBuffer(IBuffer* pBuffer) = 0;
+
 			/*!
 				\brief The method is a factory for creation objects of IVertexDeclaration's type
 
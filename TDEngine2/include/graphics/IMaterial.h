@@ -112,9 +112,20 @@ namespace TDEngine2
 				\brief The method binds a material to a rendering pipeline
 
 				\param[in] materialInstanceId An identifier of an instance of this material. 0 means a default instance, which is used by default
+				\param[in] useInstancedShader If true the instanced variant of the shader is bound, see GetInstancedShaderHandle
 			*/
 
-			TDE2_API virtual void Bind(TMaterialInstanceId instanceId = DefaultMaterialInstanceId) = 0;
+			TDE2_API virtual void Bind(TMaterialInstanceId instanceId = DefaultMaterialInstanceId, bool useInstancedShader = false) = 0;
+
+			/*!
+				\brief The method binds only per-instance data (user uniforms and textures) of the material. Pipeline's states
+				are expected to be already set up by a previous Bind call of the same material
+
+				\param[in] materialInstanceId An identifier of an instance of this material
+				\param[in] useInstancedShader The value should be the same as the one which was passed into the previous Bind call
+			*/
+
+			TDE2_API virtual void BindInstanceData(TMaterialInstanceId instanceId, bool useInstancedShader = false) = 0;
 			
 			/*!
 				\brief The method assigns a given texture to a given resource's name
@@ -296,6 +307,16 @@ namespace TDEngine2
 
 			TDE2_API virtual void SetGeometrySubGroupTag(const E_GEOMETRY_SUBGROUP_TAGS& tag) = 0;
 
+			/*!
+				\brief The method forces renderers to batch objects that share a mesh and the material into
+				a single instanced draw call. Materials whose shaders have the instanced variant are batched without
+				the flag, otherwise the material's shader itself should read per-instance transforms
+
+				\param[in] value A new state of the instancing
+			*/
+
+			TDE2_API virtual void SetInstancingEnabled(bool value) = 0;
+
 			/*!
 				\brief The method returns hash value which corresponds to a given variable's name
 
@@ -312,6 +333,15 @@ namespace TDEngine2
 
 			TDE2_API virtual TResourceId GetShaderHandle() const = 0;
 
+			/*!
+				\brief The method returns an identifier of the instanced variant of the attached shader, see GetInstancedShaderVariantName.
+				The attached shader's identifier is returned if the shader doesn't have the variant
+
+				\return The method returns an identifier of the shader that should be used with instanced draw calls
+			*/
+
+			TDE2_API virtual TResourceId GetInstancedShaderHandle() const = 0;
+
 			/*!
 				\brief The method returns true if the material's instance uses alpha blending
 				based transparency
@@ -322,6 +352,14 @@ namespace TDEngine2
 
 			TDE2_API virtual bool IsTransparent() const = 0;
 
+			/*!
+				\brief The method returns true if objects with the material could be drawn with GPU instancing
+
+				\return The method returns true if objects with the material could be drawn with GPU instancing
+			*/
+
+			TDE2_API virtual bool IsInstancingEnabled() const = 0;
+
 			/*!
 				\brief The method returns assigned tag 
 
@@ -22,6 +22,7 @@ namespace TDEngine2
 	class IFramePostProcessor;
 	class ISelectionManager;
 	struct TLightingShaderData;
+	struct TLightClustersShaderData;
 	class IGlobalShaderProperties;
 
 
@@ -70,6 +71,7 @@ namespace TDEngine2
 		TPtr<IResourceManager>   mpResourceManager;
 		TAllocatorFactoryFunctor mAllocatorFactoryFunctor;
 		IFramePostProcessor*     mpFramePostProcessor;
+		U32                      mWorkerThreadsCount = 0; ///< Render queues get a commands buffer per worker to record commands from jobs
 	};
 
 
@@ -139,6 +141,26 @@ namespace TDEngine2
 
 			TDE2_API virtual E_RESULT_CODE SetLightingData(const TLightingShaderData& lightingData) = 0;
 
+			/*!
+				\brief The method stores point lights and their assignment to clusters of the view frustum. The data is uploaded
+				into IUBR_LIGHTS buffer before the frame is drawn
+
+				\param[in] lightClustersData A parameter that contains point lights and clusters
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual E_RESULT_CODE SetLightClustersData(const TLightClustersShaderData& lightClustersData) = 0;
+
+			/*!
+				\brief The method specifies cascades of the directional shadow map which should be redrawn within the next frame.
+				The rest cascades keep their content from previous frames
+
+				\param[in] cascadesMask A mask where i-th bit corresponds to i-th cascade
+			*/
+
+			TDE2_API virtual void SetShadowCascadesUpdateMask(U32 cascadesMask) = 0;
+
 			/*!
 				\brief The method returns a pointer to CRenderQueue which contains objects of specific group
 
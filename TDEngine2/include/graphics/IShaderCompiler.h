@@ -114,6 +114,8 @@ namespace TDEngine2
 		std::unordered_map<std::string, TUniformBufferDesc>  mUniformBuffersInfo; /// first key is a buffer's name, the value is the buffer's slot index and its size
 
 		std::unordered_map<std::string, TShaderResourceDesc> mShaderResourcesInfo;	/// the key is a resource's name, the value is an information about resource  
+
+		bool                                                 mIsInstancingSupported = false; ///< True if the source defines TDE2_INSTANCING_SUPPORTED, so its instanced variant could be compiled
 	} TShaderCompilerOutput, *TShaderCompilerOutputPtr;
 
 
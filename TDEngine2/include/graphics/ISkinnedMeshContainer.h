@@ -72,6 +72,26 @@ namespace TDEngine2
 
 			TDE2_API virtual void SetDirty(bool value) = 0;
 
+			/*!
+				\brief The method caches an identifier of the material's resource which is resolved by a renderer.
+				The cached value is reset when the material's name changes
+
+				\param[in] materialId An identifier of the material
+			*/
+
+			TDE2_API virtual void SetMaterialId(TResourceId materialId) = 0;
+
+			/*!
+				\brief The method caches an identifier of the mesh's resource which is resolved by a renderer.
+				The cached value is reset when the mesh's name changes
+
+				\param[in] meshId An identifier of the mesh
+			*/
+
+			TDE2_API virtual void SetMeshId(TResourceId meshId) = 0;
+
+			TDE2_API virtual void SetSkeletonId(TResourceId skeletonId) = 0;
+
 #if TDE2_EDITORS_ENABLED
 			TDE2_API virtual void AddSubmeshIdentifier(const std::string& submeshId) = 0;
 #endif
@@ -109,6 +129,24 @@ namespace TDEngine2
 
 			TDE2_API virtual bool IsDirty() const = 0;
 
+			/*!
+				\brief The method returns a cached identifier of used material or TResourceId::Invalid if it's not resolved yet
+
+				\return The method returns a cached identifier of used material or TResourceId::Invalid if it's not resolved yet
+			*/
+
+			TDE2_API virtual TResourceId GetMaterialId() const = 0;
+
+			/*!
+				\brief The method returns a cached identifier of used mesh or TResourceId::Invalid if it's not resolved yet
+
+				\return The method returns a cached identifier of used mesh or TResourceId::Invalid if it's not resolved yet
+			*/
+
+			TDE2_API virtual TResourceId GetMeshId() const = 0;
+
+			TDE2_API virtual TResourceId GetSkeletonId() const = 0;
+
 #if TDE2_EDITORS_ENABLED
 			TDE2_API virtual const std::vector<std::string>& GetSubmeshesIdentifiers() const = 0;
 #endif
@@ -53,6 +53,15 @@ namespace TDEngine2
 
 			TDE2_API virtual void SetColor(const TColor32F& color) = 0;
 
+			/*!
+				\brief The method caches an identifier of the material's resource which is resolved by a renderer.
+				The cached value is reset when the material's name changes
+
+				\param[in] materialId An identifier of the material
+			*/
+
+			TDE2_API virtual void SetMaterialId(TResourceId materialId) = 0;
+
 			/*!
 				\brief The method returns an identifier of used material
 
@@ -61,6 +70,14 @@ namespace TDEngine2
 
 			TDE2_API virtual const std::string& GetMaterialName() const = 0;
 
+			/*!
+				\brief The method returns a cached identifier of used material or TResourceId::Invalid if it's not resolved yet
+
+				\return The method returns a cached identifier of used material or TResourceId::Invalid if it's not resolved yet
+			*/
+
+			TDE2_API virtual TResourceId GetMaterialId() const = 0;
+
 			/*!
 				\brief The method returns a color of a sprite
 
@@ -11,6 +11,7 @@
 #include "./../math/TMatrix4.h"
 #include "./../math/TVector4.h"
 #include "./../utils/Color.h"
+#include <limits>
 
 
 namespace TDEngine2
@@ -18,7 +19,22 @@ namespace TDEngine2
 #pragma pack(push, 16)
 
 
-	constexpr U32 MaxPointLightsCount = 8;
+	constexpr U32 MaxLightClustersDataSize = 16384; ///< GL guarantees only 16 KiB for a single uniforms block
+
+	constexpr U32 MaxPointLightsCount = 128;
+
+	constexpr U32 LightClustersCountX = 16;
+	constexpr U32 LightClustersCountY = 8;
+	constexpr U32 LightClustersCountZ = 12;
+	constexpr U32 LightClustersCount  = LightClustersCountX * LightClustersCountY * LightClustersCountZ;
+
+	constexpr U32 MaxLightClustersIndicesCount = 2032; ///< A total number of references from clusters onto point lights, takes the rest of MaxLightClustersDataSize
+
+	constexpr U32 MaxShadowCascadesCount = 4;
+
+	constexpr U32 PerObjectShaderDataStride   = 256; ///< Ranges of uniforms buffers should be aligned to 256 bytes in both GAPIs
+	constexpr U32 PerObjectShaderDataPageSize = 65536; ///< A size of a single uniforms buffer with objects' data, D3D11 can't bind more than 64 KiB at once
+	constexpr U32 InvalidPerObjectDataIndex   = (std::numeric_limits<U32>::max)();
 
 
 	typedef struct TPointLightData
@@ -40,16 +56,42 @@ namespace TDEngine2
 		TVector4        mSunLightDirection;
 		TVector4        mSunLightPosition;
 		TColor32F       mSunLightColor;
-		TMatrix4        mSunLightMatrix = IdentityMatrix4;
+		TMatrix4        mSunLightMatrix = IdentityMatrix4; ///< A matrix of the cascade which is currently rendered within the shadow pass
 
-		TPointLightData mPointLights[MaxPointLightsCount];
+		TMatrix4        mShadowCascadesMatrices[MaxShadowCascadesCount];
+		TVector4        mShadowCascadesSplits; ///< Far distances of cascades along the camera's view direction
 
-		U32             mPointLightsCount;
 		U32             mIsShadowMappingEnabled;
+		U32             mShadowCascadesCount = 1;
 
 		U32             mPadding[2];
 	};
 
+
+	/*!
+		\brief The structure contains point lights and their assignment to clusters of the view frustum. The frustum is split
+		into LightClustersCountX x LightClustersCountY tiles in NDC space and LightClustersCountZ slices which are distributed
+		exponentially between near and far planes. Arrays of integers are declared as arrays of uint4 in shaders.
+		The whole structure is a single uniforms buffer, so it should fit into MaxLightClustersDataSize
+	*/
+
+	struct TLightClustersShaderData
+	{
+		TVector4        mClustersParams; ///< x - near plane, y - far plane, z - a number of slices divided by log(far / near), w - a sign of view space z along the view direction
+
+		U32             mClustersCount[3]; ///< Dimensions of the grid of clusters
+		U32             mPointLightsCount;
+
+		TPointLightData mPointLights[MaxPointLightsCount];
+
+		U32             mClusters[LightClustersCount]; ///< An element contains an offset within mLightIndices (low 16 bits) and a number of lights (high 16 bits)
+		U16             mLightIndices[MaxLightClustersIndicesCount]; ///< Indices of point lights, shaders read them as pairs packed into U32
+	};
+
+
+	static_assert(sizeof(TLightClustersShaderData) <= MaxLightClustersDataSize, "TLightClustersShaderData doesn't fit into a uniforms buffer");
+	static_assert(MaxLightClustersIndicesCount % 8 == 0, "Shaders read indices of lights as uint4 vectors");
+
 	/*!
 		struct TPerFrameShaderData
 
@@ -90,6 +132,9 @@ namespace TDEngine2
 	} TPerObjectShaderData, *TPerObjectShaderDataPtr;
 
 
+	static_assert(sizeof(TPerObjectShaderData) <= PerObjectShaderDataStride, "TPerObjectShaderData doesn't fit into a slot of the per frame objects buffer");
+
+
 	/*!
 		struct TRareUpdateShaderData
 
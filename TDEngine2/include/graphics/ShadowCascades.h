@@ -0,0 +1,164 @@
+/*!
+	\file ShadowCascades.h
+	\date 16.10.2026
+	\authors Kasimov Ildar
+*/
+
+#pragma once
+
+
+#include "../utils/Types.h"
+#include "../math/TMatrix4.h"
+#include "../math/TVector3.h"
+#include "InternalShaderData.h"
+#include <string>
+
+
+namespace TDEngine2
+{
+	struct TAABB;
+
+
+	/*!
+		struct TShadowCascadeBounds
+
+		\brief The type describes a bounding sphere of a cascade of the directional shadow map in world space
+	*/
+
+	typedef struct TShadowCascadeBounds
+	{
+		TVector3 mCenter;
+		F32      mRadius = 0.0f;
+	} TShadowCascadeBounds, *TShadowCascadeBoundsPtr;
+
+
+	/*!
+		struct TShadowCascadesCastersState
+
+		\brief The type describes casters which were drawn into cascades last time
+	*/
+
+	typedef struct TShadowCascadesCastersState
+	{
+		U32 mDynamicCastersMask = 0; ///< Cascades that contained non-static casters
+		U32 mStaticCastersHashes[MaxShadowCascadesCount] {};
+	} TShadowCascadesCastersState, *TShadowCascadesCastersStatePtr;
+
+
+	/*!
+		\brief The function splits a range of view distances between cascades. Splits are a mix of uniform and
+		logarithmic distributions which is controlled by splitLambda
+
+		\param[in] zNear A distance to the near plane of the camera
+		\param[in] shadowDistance A maximal distance from the camera where shadows are drawn
+		\param[in] cascadesCount A number of cascades, should be in range [1; MaxShadowCascadesCount]
+		\param[in] splitLambda 0 means uniform distribution of splits, 1 means logarithmic one
+		\param[out] splits Far distances of cascades, unused elements are equal to the far distance of the last cascade
+	*/
+
+	TDE2_API void ComputeShadowCascadesSplits(F32 zNear, F32 shadowDistance, U32 cascadesCount, F32 splitLambda, F32 splits[]);
+
+	/*!
+		\brief The function computes a bounding sphere of a part of the camera's frustum which lies between given distances.
+		The radius doesn't depend on the camera's orientation, so the size of a cascade stays the same between frames
+
+		\param[in] projMatrix Projection matrix of the camera
+		\param[in] viewMatrix View matrix of the camera
+		\param[in] ndcZMin A minimal value for z component in NDC space (either -1 or 0)
+		\param[in] zNear A distance to the near plane of the camera
+		\param[in] zFar A distance to the far plane of the camera
+		\param[in] sliceNear A distance where the cascade begins
+		\param[in] sliceFar A distance where the cascade ends
+
+		\return The function returns a bounding sphere of the frustum's slice
+	*/
+
+	TDE2_API TShadowCascadeBounds ComputeShadowCascadeBounds(const TMatrix4& projMatrix, const TMatrix4& viewMatrix, F32 ndcZMin, F32 zNear, F32 zFar,
+															   F32 sliceNear, F32 sliceFar);
+
+	/*!
+		\brief The function moves cached bounds of a cascade only if the camera's slice leaves them. Cached bounds are enlarged
+		by the margin to allow the camera to move without invalidation of the cascade's content
+
+		\param[in] sliceBounds A bounding sphere of the camera's slice for the current frame
+		\param[in] margin A relative size of the enlargement
+		\param[in, out] cachedBounds Bounds of the cascade which were used to render it last time
+
+		\return The function returns true if cached bounds were changed
+	*/
+
+	TDE2_API bool UpdateCachedShadowCascadeBounds(const TShadowCascadeBounds& sliceBounds, F32 margin, TShadowCascadeBounds& cachedBounds);
+
+	/*!
+		\brief The function builds an orthographic view-projection matrix of a cascade. The center of the cascade is
+		snapped to texels of the shadow map to prevent shimmering of shadows' edges when the camera moves
+
+		\param[in] lightDirection A direction of the sun light
+		\param[in] bounds A bounding sphere of the cascade
+		\param[in] castersExtrusion A distance which the volume is extended by towards the light to catch casters outside of the sphere
+		\param[in] shadowMapSizes Sizes of the cascade's shadow map in texels
+		\param[in] ndcZMin A minimal value for z component in NDC space (either -1 or 0)
+
+		\return The function returns a matrix which transforms world space positions into NDC space of the cascade
+	*/
+
+	TDE2_API TMatrix4 ComputeShadowCascadeMatrix(const TVector3& lightDirection, const TShadowCascadeBounds& bounds, F32 castersExtrusion,
+												 U32 shadowMapSizes, F32 ndcZMin);
+
+	/*!
+		\brief The function tests whether an axis-aligned box is within the volume of a cascade
+
+		\param[in] cascadeMatrix A matrix which is computed with ComputeShadowCascadeMatrix
+		\param[in] bounds World space bounds of a caster
+		\param[in] ndcZMin A minimal value for z component in NDC space (either -1 or 0)
+
+		\return The function returns true if the box intersects the cascade's volume at least partially
+	*/
+
+	TDE2_API bool TestShadowCascadeAABB(const TMatrix4& cascadeMatrix, const TAABB& bounds, F32 ndcZMin);
+
+	/*!
+		\brief The function compares casters of the current frame with the ones which were drawn last time and stores the current ones.
+		A cascade should be redrawn if it contains dynamic casters now, or contained them before (their old shadows should be erased),
+		or a set of its static casters has changed
+
+		\param[in] cascadesCount A number of cascades
+		\param[in] dynamicCastersMask Cascades that contain non-static casters within the current frame
+		\param[in] staticCastersHashes Hashes of static casters of each cascade within the current frame
+		\param[in, out] castersState Casters of the previous frame, the current ones are written instead
+
+		\return The function returns a mask of cascades which content has changed
+	*/
+
+	TDE2_API U32 UpdateShadowCascadesCastersState(U32 cascadesCount, U32 dynamicCastersMask, const U32 staticCastersHashes[], TShadowCascadesCastersState& castersState);
+
+	/*!
+		\brief The function builds a key for a shadow caster's command. Commands are grouped by cascades within
+		RQG_SHADOW_PASS queue, the first cascade gets the greatest keys
+
+		\param[in] cascadeIndex An index of a cascade which the command is drawn into
+		\param[in] drawIndex An index of the command within the cascade
+
+		\return A key that could be passed into CRenderQueue::SubmitDrawCommand
+	*/
+
+	TDE2_API U64 MakeShadowCasterSortKey(U32 cascadeIndex, U32 drawIndex);
+
+	/*!
+		\return The function returns an index of a cascade which is encoded into a key by MakeShadowCasterSortKey
+	*/
+
+	TDE2_API U32 GetShadowCascadeIndexFromSortKey(U64 key);
+
+	/*!
+		\return The function returns an identifier of a depth buffer which stores the given cascade
+	*/
+
+	TDE2_API const std::string& GetShadowMapCascadeResourceName(U32 cascadeIndex);
+
+	/*!
+		\return The function returns a name of a sampler within shaders that the given cascade is bound to
+	*/
+
+	TDE2_API const std::string& GetShadowMapCascadeSamplerName(U32 cascadeIndex);
+}
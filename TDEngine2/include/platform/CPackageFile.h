@@ -10,10 +10,15 @@
 #include "../platform/CBinaryFileReader.h"
 #include "../platform/CBinaryFileWriter.h"
 #include <string>
+#include <vector>
+#include <limits>
 
 
 namespace TDEngine2
 {
+	class IJobManager;
+
+
 	/*!
 		\brief The structure of a simple package file looks like the following below
 
@@ -23,9 +28,15 @@ namespace TDEngine2
 		----------------------------
 		        Files Data
 		....
+		Compressed files are split into chunks (since 0x300), a block of such file begins with
+		a table of (ChunksCount + 1) offsets of chunks relative to the block's beginning
+		....
 		----------------------------
 		    FilesTableDescription
 		Entry1, Entry2, .... EntryN
+		----------------------------
+		     TableOfContents (since 0x200)
+		Bucket1, Bucket2, .... BucketM
 
 		Full specification could be found here
 		https://github.com/bnoazx005/TDEngine2/wiki/%5BDraft%5D-Package-file-format-specification
@@ -39,18 +50,111 @@ namespace TDEngine2
 	{
 		TDE2_STATIC_CONSTEXPR C8 mTag[4] { "PAK" };
 
-		TDE2_STATIC_CONSTEXPR U16 mVersion = 0x100;
+		TDE2_STATIC_CONSTEXPR U16 mVersion = 0x300;
+		TDE2_STATIC_CONSTEXPR U16 mMinSupportedVersion = 0x100; ///< Packages of 0x100 version have no table of contents, it's built on loading
+		TDE2_STATIC_CONSTEXPR U16 mTableOfContentsVersion = 0x200;
+		TDE2_STATIC_CONSTEXPR U16 mChunkedEntriesVersion = 0x300; ///< Entries of older packages are compressed as a whole
 		TDE2_STATIC_CONSTEXPR U16 mPadding = 0x0;
 
 		U32 mEntitiesCount = 0;
 
 		U64 mFilesTableOffset = 0;
 		U64 mFilesTableSize = 0;
+
+		U64 mTableOfContentsOffset = 0;
+		U32 mTableOfContentsBucketsCount = 0;
 	} TPackageFileHeader, *TPackageFileHeaderPtr;
 
+
+	/*!
+		struct TPackageTableOfContentsBucket
+
+		\brief The type is a bucket of an open addressing hash table which maps hashes of files' names onto
+		indices within the files table. Empty buckets have mEntryIndex equal to mInvalidEntryIndex
+	*/
+
+	typedef struct TPackageTableOfContentsBucket
+	{
+		TDE2_STATIC_CONSTEXPR U32 mInvalidEntryIndex = (std::numeric_limits<U32>::max)();
+
+		U32 mNameHash = 0;
+		U32 mEntryIndex = mInvalidEntryIndex;
+	} TPackageTableOfContentsBucket, *TPackageTableOfContentsBucketPtr;
+
 #pragma pack(pop)
 
 
+	/// \note Static members of the header aren't a part of its layout, but they're written into a file too
+	TDE2_STATIC_CONSTEXPR USIZE PackageFileHeaderSize = sizeof(TPackageFileHeader::mTag) + sizeof(TPackageFileHeader::mVersion) + 
+														 sizeof(TPackageFileHeader::mPadding) + sizeof(TPackageFileHeader);
+
+
+	/*!
+		\brief A size of uncompressed chunks of files which are written by CPackageFileWriter. A chunk is stored
+		without compression if the codec doesn't make it smaller
+	*/
+
+	TDE2_STATIC_CONSTEXPR U32 PackageFileChunkSize = 64 * 1024;
+
+
+	/*!
+		\brief The function splits data into chunks and compresses each of them independently. The output begins
+		with a table of (ChunksCount + 1) offsets of chunks relative to the output's beginning, they're stored
+		in the package's byte order
+
+		\param[in] codec A codec which chunks are compressed with, shouldn't be E_PACKAGE_ENTRY_CODEC::NONE
+		\param[in] data Uncompressed data of a file
+		\param[in] chunkSize A size of uncompressed chunks
+		\param[out] output A block that's written into a package
+
+		\return RC_OK if everything went ok, or some other code, which describes an error
+	*/
+
+	TDE2_API E_RESULT_CODE CompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC codec, const std::vector<U8>& data, U32 chunkSize, std::vector<U8>& output);
+
+	/*!
+		\brief The function decompresses a continuous range of chunks, each chunk is processed by a job if pJobManager isn't nullptr
+
+		\param[in] codec A codec which chunks were compressed with
+		\param[in] pChunksOffsets (chunksCount + 1) offsets of chunks in the host's byte order
+		\param[in] chunksCount A number of chunks that should be decompressed
+		\param[in] pChunksData A pointer to the data of the first chunk
+		\param[in] chunkSize A size of uncompressed chunks
+		\param[out] pDestData A buffer which receives the data
+		\param[in] destSize A size of the buffer, only the last chunk could be smaller than chunkSize
+		\param[in] pJobManager A pointer to IJobManager implementation, could be nullptr
+
+		\return RC_OK if everything went ok, or some other code, which describes an error
+	*/
+
+	TDE2_API E_RESULT_CODE DecompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC codec, const U64* pChunksOffsets, USIZE chunksCount, const U8* pChunksData, U32 chunkSize, 
+													   U8* pDestData, USIZE destSize, IJobManager* pJobManager);
+
+	/*!
+		\brief The function builds a table of contents for a given files table. The number of buckets is a power of two
+		which is at least twice greater than the number of files
+
+		\param[in] filesTable An array of package's entries
+
+		\return An array of buckets, the array is empty if there are no files
+	*/
+
+	TDE2_API std::vector<TPackageTableOfContentsBucket> BuildPackageTableOfContents(const std::vector<TPackageFileEntryInfo>& filesTable);
+
+	/*!
+		\brief The function looks up an entry of the files table by the file's path
+
+		\param[in] tableOfContents Buckets that are built with BuildPackageTableOfContents
+		\param[in] filesTable An array of package's entries
+		\param[in] path A path of a file within the package
+
+		\return An index of the entry or TPackageTableOfContentsBucket::mInvalidEntryIndex if there is no such file
+	*/
+
+	TDE2_API U32 FindPackageFileEntryIndex(const std::vector<TPackageTableOfContentsBucket>& tableOfContents, const std::vector<TPackageFileEntryInfo>& filesTable,
+										   const std::string& path);
+
+
 	/*!
 		\brief A factory function for creation objects of CPackageFileReader's type
 
@@ -75,6 +179,24 @@ namespace TDEngine2
 
 			TDE2_API std::vector<U8> ReadFileBytes(const std::string& path) override;
 
+			/*!
+				\brief The method returns a view of an uncompressed file's data within the memory mapped package.
+				The view stays valid until the package is closed
+
+				\return The view of the data, mpData is nullptr if the file isn't found, it's compressed or the package isn't mapped
+			*/
+
+			TDE2_API TPackageFileDataView GetFileDataView(const std::string& path) const override;
+
+			/*!
+				\brief The method reads a part of a file. Only chunks which intersect the range are decompressed,
+				they're processed in parallel if the file system has a job manager
+
+				\return The array of decompressed bytes, it's empty if the file isn't found or the range is out of the file
+			*/
+
+			TDE2_API std::vector<U8> ReadFileRange(const std::string& path, U64 offset, U64 size) override;
+
 			TDE2_API const TPackageFileHeader& GetPackageHeader() const override;
 			TDE2_API const std::vector<TPackageFileEntryInfo>& GetFilesTable() const override;
 
@@ -82,13 +204,47 @@ namespace TDEngine2
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CPackageFileReader)
 
 			TDE2_API E_RESULT_CODE _onInit() override;
-			//TDE2_API E_RESULT_CODE _onFree() override;
+			TDE2_API E_RESULT_CODE _onFree() override;
 
 			TDE2_API E_RESULT_CODE _readPackageHeader();
 			TDE2_API E_RESULT_CODE _readFilesTableDescription();
+			TDE2_API E_RESULT_CODE _readTableOfContents();
+
+			TDE2_API const TPackageFileEntryInfo* _findFileEntry(const std::string& path) const;
+
+			/*!
+				\brief The method returns a pointer to a part of the entry's block. The data is taken from the mapped
+				package or it's read into the buffer
+
+				\return A pointer to the data or nullptr if the range is out of the package
+			*/
+
+			TDE2_API const U8* _getEntryBlockData(const TPackageFileEntryInfo& entry, U64 offset, U64 size, std::vector<U8>& buffer);
+
+			/*!
+				\brief The method decompresses [firstChunkIndex; lastChunkIndex) chunks of the entry
+
+				\return The array of decompressed bytes, it's empty if some of chunks is corrupted
+			*/
+
+			TDE2_API std::vector<U8> _decompressChunks(const TPackageFileEntryInfo& entry, U64 firstChunkIndex, U64 lastChunkIndex);
+
+			/*!
+				\brief The method maps the whole package into the address space. If it fails the reader
+				falls back to reading through the stream
+			*/
+
+			TDE2_API E_RESULT_CODE _mapPackageFile();
+			TDE2_API void _unmapPackageFile();
 		private:
 			TPackageFileHeader mCurrHeader;
 			std::vector<TPackageFileEntryInfo> mFilesTable;
+			std::vector<TPackageTableOfContentsBucket> mTableOfContents;
+
+			const U8* mpMappedData;
+			USIZE mMappedDataSize;
+
+			U16 mPackageVersion;
 	};
 
 
@@ -120,10 +276,11 @@ namespace TDEngine2
 			TDE2_API E_RESULT_CODE _onInit() override;
 			TDE2_API E_RESULT_CODE _onFree() override;
 			
-			TDE2_API E_RESULT_CODE _writeFileInternal(TypeId fileTypeId, const std::string& path, const IFileReader& file, bool useCompression) override;
+			TDE2_API E_RESULT_CODE _writeFileInternal(TypeId fileTypeId, const std::string& path, const IFileReader& file, E_PACKAGE_ENTRY_CODEC codec) override;
 
 			TDE2_API E_RESULT_CODE _writePackageHeader();
 			TDE2_API E_RESULT_CODE _writeFilesTableDescription();
+			TDE2_API E_RESULT_CODE _writeTableOfContents();
 		private:
 			TPackageFileHeader mCurrHeader;
 			std::vector<TPackageFileEntryInfo> mFilesTable;
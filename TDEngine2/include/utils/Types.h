@@ -306,10 +306,33 @@ namespace TDEngine2
 	/// Entity-Component-System's types declarations
 
 
-	TDE2_DECLARE_HANDLE_TYPE(TEntityId); ///< A type of entity's identifier	
+	TDE2_DECLARE_HANDLE_TYPE(TEntityId); ///< A type of entity's identifier
 	TDE2_DECLARE_HANDLE_TYPE(TSystemId);
 
 
+	/// \note TEntityId packs an index of entity's slot into lower bits and a generation of the slot into higher ones.
+	/// The generation is incremented when the slot is released, so stale identifiers never match recycled slots
+
+	constexpr U32 EntityIndexBitsCount = 22;
+	constexpr U32 EntityIndexMask = (1u << EntityIndexBitsCount) - 1;
+	constexpr U32 EntityGenerationMask = (std::numeric_limits<U32>::max)() >> EntityIndexBitsCount;
+
+	inline constexpr TEntityId MakeEntityId(U32 index, U32 generation)
+	{
+		return static_cast<TEntityId>(((generation & EntityGenerationMask) << EntityIndexBitsCount) | (index & EntityIndexMask));
+	}
+
+	inline constexpr U32 GetEntityIndex(TEntityId entityId)
+	{
+		return static_cast<U32>(entityId) & EntityIndexMask;
+	}
+
+	inline constexpr U32 GetEntityGeneration(TEntityId entityId)
+	{
+		return static_cast<U32>(entityId) >> EntityIndexBitsCount;
+	}
+
+
 	/*!
 		enum class E_SYSTEM_PRIORITY
 
@@ -478,6 +501,40 @@ namespace TDEngine2
 	};
 
 
+	/*!
+		enum class E_RESOURCE_LOADING_PRIORITY
+
+		\brief Asynchronous loading requests with greater priorities are started first
+	*/
+
+	enum class E_RESOURCE_LOADING_PRIORITY : U8
+	{
+		LOW,
+		NORMAL,
+		HIGH,
+		CRITICAL
+	};
+
+
+	/*!
+		enum class E_RESOURCE_LOADING_STATUS
+
+		\brief The enumeration describes stages of an asynchronous loading request
+	*/
+
+	enum class E_RESOURCE_LOADING_STATUS : U8
+	{
+		INVALID,
+		WAITING_DEPENDENCIES, ///< The request waits until requests it depends on are completed
+		QUEUED,               ///< The request waits for a free worker, could be cancelled till this stage
+		LOADING,              ///< Data of the resource is read and decoded on a worker thread
+		UPLOADING,            ///< The resource waits for its GPU data to be uploaded from the main thread
+		COMPLETED,
+		FAILED,
+		CANCELLED
+	};
+
+
 	TDE2_DECLARE_HANDLE_TYPE_EX(TResourceLoaderId, 0); ///< A resource loader's identifier
 	TDE2_DECLARE_HANDLE_TYPE_EX(TResourceFactoryId, 0); ///< A resource factory's identifier
 
@@ -527,7 +584,8 @@ namespace TDEngine2
 		IUBR_PER_OBJECT,		///< This uniforms buffer is unique for each model
 		IUBR_RARE_UDATED,		///< This uniforms buffer contains rare updating values 
 		IUBR_CONSTANTS,			///< This uniforms buffer contains in-engine constants (like Pi, Epsilon, etc)
-		IUBR_LAST_USED_SLOT = IUBR_CONSTANTS
+		IUBR_LIGHTS,			///< This uniforms buffer contains point lights and their clusters, it's updated each frame
+		IUBR_LAST_USED_SLOT = IUBR_LIGHTS
 	};
 
 
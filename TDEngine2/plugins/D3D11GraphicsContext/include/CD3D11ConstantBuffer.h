@@ -13,6 +13,9 @@
 
 #if defined (TDE2_USE_WINPLATFORM)
 
+#include <d3d11_1.h>
+
+
 namespace TDEngine2
 {
 	class IBuffer;
@@ -88,6 +91,18 @@ namespace TDEngine2
 
 			TDE2_API void Bind(U32 slot) override;
 
+			/*!
+				\brief The method binds a part of a constant buffer to a given slot, so shaders see it as a whole buffer
+
+				\param[in] slot An index of a slot, in which the constant buffer will be binded to
+				\param[in] offset An offset in bytes from the beginning of the buffer, should be a multiple of 256
+				\param[in] size A size of the range in bytes, should be a multiple of 256
+
+				\return RC_OK if everything went ok, RC_NOT_IMPLEMENTED_YET if GAPI doesn't support binding of ranges
+			*/
+
+			TDE2_API E_RESULT_CODE BindRange(U32 slot, USIZE offset, USIZE size) override;
+
 			/*!
 				\brief The method unbinds a constant buffer from rendering pipeline
 			*/
@@ -122,11 +137,13 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE _onFreeInternal() override;
 		protected:
-			ID3D11DeviceContext* mp3dDeviceContext;
+			ID3D11DeviceContext*  mp3dDeviceContext;
+
+			ID3D11DeviceContext1* mp3dDeviceContext1 = nullptr; ///< The pointer is null if D3D11.1 runtime doesn't support offsets of constant buffers
 
-			IBuffer*             mpBufferImpl;
+			IBuffer*              mpBufferImpl;
 
-			U32                  mCurrUsedSlot;
+			U32                   mCurrUsedSlot;
 	};
 
 
@@ -132,6 +132,8 @@ namespace TDEngine2
 			TDE2_API E_RESULT_CODE _createInternalTextureHandler(IGraphicsContext* pGraphicsContext, U32 width, U32 height, E_FORMAT_TYPE format,
 																 U32 mipLevelsCount, U32 samplesCount, U32 samplingQuality) override;
 
+			TDE2_API E_RESULT_CODE _releaseInternalTextureHandler() override;
+
 			TDE2_API E_RESULT_CODE _createShaderTextureView(ID3D11Device* p3dDevice, E_FORMAT_TYPE format, U32 mipLevelsCount);
 
 			TDE2_API TResult<ID3D11Texture2D*> _createD3D11TextureResource(IGraphicsContext* pGraphicsContext, U32 width, U32 height, E_FORMAT_TYPE format,
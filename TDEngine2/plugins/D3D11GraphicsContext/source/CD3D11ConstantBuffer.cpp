@@ -31,6 +31,21 @@ namespace TDEngine2
 
 		mp3dDeviceContext = dynamic_cast<CD3D11Buffer*>(mpBufferImpl)->GetDeviceContext();
 
+		ID3D11Device* p3dDevice = nullptr;
+		mp3dDeviceContext->GetDevice(&p3dDevice);
+
+		D3D11_FEATURE_DATA_D3D11_OPTIONS options {};
+
+		if (p3dDevice && SUCCEEDED(p3dDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) && options.ConstantBufferOffsetting)
+		{
+			mp3dDeviceContext->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&mp3dDeviceContext1));
+		}
+
+		if (p3dDevice)
+		{
+			p3dDevice->Release(); /// \note GetDevice increments a counter of references
+		}
+
 		mIsInitialized = true;
 
 		return RC_OK;
@@ -38,6 +53,12 @@ namespace TDEngine2
 
 	E_RESULT_CODE CD3D11ConstantBuffer::_onFreeInternal()
 	{
+		if (mp3dDeviceContext1)
+		{
+			mp3dDeviceContext1->Release();
+			mp3dDeviceContext1 = nullptr;
+		}
+
 		return mpBufferImpl->Free();
 	}
 
@@ -77,6 +98,38 @@ namespace TDEngine2
 		mCurrUsedSlot = slot;
 	}
 
+	E_RESULT_CODE CD3D11ConstantBuffer::BindRange(U32 slot, USIZE offset, USIZE size)
+	{
+		if (!mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (!mp3dDeviceContext1)
+		{
+			return RC_NOT_IMPLEMENTED_YET;
+		}
+
+		if (offset + size > mpBufferImpl->GetSize())
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		/// \note Offsets are measured in shader constants, each of them takes 16 bytes
+		const UINT firstConstant = static_cast<UINT>(offset / 16);
+		const UINT constantsCount = static_cast<UINT>(size / 16);
+
+		ID3D11Buffer* pInternalBuffer = mpBufferImpl->GetInternalData().mpD3D11Buffer;
+
+		mp3dDeviceContext1->VSSetConstantBuffers1(slot, 1, &pInternalBuffer, &firstConstant, &constantsCount);
+		mp3dDeviceContext1->PSSetConstantBuffers1(slot, 1, &pInternalBuffer, &firstConstant, &constantsCount);
+		mp3dDeviceContext1->GSSetConstantBuffers1(slot, 1, &pInternalBuffer, &firstConstant, &constantsCount);
+
+		mCurrUsedSlot = slot;
+
+		return RC_OK;
+	}
+
 	void CD3D11ConstantBuffer::Unbind()
 	{
 		if (!mIsInitialized || !mCurrUsedSlot)
@@ -434,7 +434,7 @@ namespace TDEngine2
 					DECLARE_TEX2D(FrameTexture);
 					DECLARE_TEX2D(ColorGradingLUT);
 
-					CBUFFER_SECTION_EX(ToneMappingParameters, 4)
+					CBUFFER_SECTION_EX(ToneMappingParameters, 5)
 						float4 toneMappingParams; // x  weight (0 is disabled, 1 is enabled), y - exposure
 						float4 colorGradingParams; // x - weight (enabled or not)
 					CBUFFER_ENDSECTION
@@ -654,14 +654,32 @@ namespace TDEngine2
 				return  R"(
 					#define VERTEX_ENTRY mainVS
 					#define PIXEL_ENTRY mainPS
+					#define TDE2_INSTANCING_SUPPORTED
 
 					#include <TDEngine2Globals.inc>
 
 					#program vertex
 
-					float4 mainVS(float4 lPos : POSITION0): SV_POSITION
+					struct VertexIn
 					{
-						return mul(SunLightMat, mul(ModelMat, lPos));
+						float4 mPos       : POSITION0;
+					#ifdef TDE2_INSTANCING_ENABLED
+						float4 mModelMat0 : TEXCOORD0;
+						float4 mModelMat1 : TEXCOORD1;
+						float4 mModelMat2 : TEXCOORD2;
+						float4 mModelMat3 : TEXCOORD3;
+					#endif
+					};
+
+					float4 mainVS(in VertexIn input): SV_POSITION
+					{
+					#ifdef TDE2_INSTANCING_ENABLED
+						float4x4 modelMat = TDE2_INSTANCE_MATRIX(input.mModelMat0, input.mModelMat1, input.mModelMat2, input.mModelMat3);
+					#else
+						float4x4 modelMat = ModelMat;
+					#endif
+
+						return mul(SunLightMat, mul(modelMat, input.mPos));
 					}
 
 					#endprogram
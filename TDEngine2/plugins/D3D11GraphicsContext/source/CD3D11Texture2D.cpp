@@ -29,15 +29,7 @@ namespace TDEngine2
 	{
 		mIsInitialized = false;
 
-		E_RESULT_CODE result = RC_OK;
-
-		if ((result = SafeReleaseCOMPtr<ID3D11Texture2D>(&mpTexture)) != RC_OK ||
-			(result = SafeReleaseCOMPtr<ID3D11ShaderResourceView>(&mpShaderTextureView)) != RC_OK)
-		{
-			return result;
-		}
-
-		return RC_OK;
+		return _releaseInternalTextureHandler();
 	}
 
 	E_RESULT_CODE CD3D11Texture2D::WriteData(const TRectI32& regionRect, const U8* pData)
@@ -121,6 +113,19 @@ namespace TDEngine2
 		return _createShaderTextureView(mp3dDevice, mFormat, mNumOfMipLevels);
 	}
 
+	E_RESULT_CODE CD3D11Texture2D::_releaseInternalTextureHandler()
+	{
+		E_RESULT_CODE result = RC_OK;
+
+		if ((result = SafeReleaseCOMPtr<ID3D11Texture2D>(&mpTexture)) != RC_OK ||
+			(result = SafeReleaseCOMPtr<ID3D11ShaderResourceView>(&mpShaderTextureView)) != RC_OK)
+		{
+			return result;
+		}
+
+		return RC_OK;
+	}
+
 	TResult<ID3D11Texture2D*> CD3D11Texture2D::_createD3D11TextureResource(IGraphicsContext* pGraphicsContext, U32 width, U32 height, E_FORMAT_TYPE format,
 																		   U32 mipLevelsCount, U32 samplesCount, U32 samplingQuality,
 																		   U32 accessType)
@@ -125,6 +125,8 @@ namespace TDEngine2
 
 			TDE2_API E_RESULT_CODE _createInternalTextureHandler(IGraphicsContext* pGraphicsContext, U32 width, U32 height, E_FORMAT_TYPE format,
 																 U32 mipLevelsCount, U32 samplesCount, U32 samplingQuality) override;
+
+			TDE2_API E_RESULT_CODE _releaseInternalTextureHandler() override;
 		protected:
 			GLuint mTextureHandler;
 	};
@@ -70,6 +70,25 @@ namespace TDEngine2
 		GL_SAFE_VOID_CALL(glBindBufferBase(GL_UNIFORM_BUFFER, slot, mpBufferImpl->GetInternalData().mGLBuffer));
 	}
 
+	E_RESULT_CODE COGLConstantBuffer::BindRange(U32 slot, USIZE offset, USIZE size)
+	{
+		if (!mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (offset + size > mpBufferImpl->GetSize())
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mCurrUsedSlot = slot;
+
+		GL_SAFE_CALL(glBindBufferRange(GL_UNIFORM_BUFFER, slot, mpBufferImpl->GetInternalData().mGLBuffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size)));
+
+		return RC_OK;
+	}
+
 	void COGLConstantBuffer::Unbind()
 	{
 		if (!mIsInitialized && !mCurrUsedSlot)
@@ -454,14 +454,28 @@ namespace TDEngine2
 
 					#define VERTEX_ENTRY main
 					#define PIXEL_ENTRY main
+					#define TDE2_INSTANCING_SUPPORTED
 
 					#program vertex
 
 					layout (location = 0) in vec4 inlPos;
 
+					#ifdef TDE2_INSTANCING_ENABLED
+					layout (location = 1) in vec4 inModelMat0;
+					layout (location = 2) in vec4 inModelMat1;
+					layout (location = 3) in vec4 inModelMat2;
+					layout (location = 4) in vec4 inModelMat3;
+					#endif
+
 					void main(void)
 					{
-						gl_Position = SunLightMat * ModelMat * inlPos;
+					#ifdef TDE2_INSTANCING_ENABLED
+						mat4 modelMat = TDE2_INSTANCE_MATRIX(inModelMat0, inModelMat1, inModelMat2, inModelMat3);
+					#else
+						mat4 modelMat = ModelMat;
+					#endif
+
+						gl_Position = SunLightMat * modelMat * inlPos;
 					}
 
 					#endprogram
@@ -532,7 +546,7 @@ namespace TDEngine2
 					DECLARE_TEX2D(FrameTexture);
 					DECLARE_TEX2D(ColorGradingLUT);
 
-					CBUFFER_SECTION_EX(ToneMappingParameters, 4)
+					CBUFFER_SECTION_EX(ToneMappingParameters, 5)
 						vec4 toneMappingParams; // x  weight (0 is disabled, 1 is enabled), y - exposure
 						vec4 colorGradingParams; // x - weight (enabled or not)
 					CBUFFER_ENDSECTION
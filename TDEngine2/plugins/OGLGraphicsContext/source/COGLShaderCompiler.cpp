@@ -83,6 +83,8 @@ namespace TDEngine2
 
 		pResult->mUniformBuffersInfo  = std::move(shaderMetadata.mUniformBuffers);
 		pResult->mShaderResourcesInfo = std::move(shaderMetadata.mShaderResources);
+
+		pResult->mIsInstancingSupported = shaderMetadata.mIsInstancingSupported;
 		
 		return Wrench::TOkValue<TShaderCompilerOutput*>(pResult);
 	}
@@ -46,11 +46,7 @@ namespace TDEngine2
 	{
 		mIsInitialized = false;
 
-		GL_SAFE_CALL(glDeleteTextures(1, &mTextureHandler));
-		
-		mTextureHandler = 0;
-
-		return RC_OK;
+		return _releaseInternalTextureHandler();
 	}
 
 	E_RESULT_CODE COGLTexture2D::WriteData(const TRectI32& regionRect, const U8* pData)
@@ -130,6 +126,15 @@ namespace TDEngine2
 
 		return RC_OK;
 	}
+
+	E_RESULT_CODE COGLTexture2D::_releaseInternalTextureHandler()
+	{
+		GL_SAFE_CALL(glDeleteTextures(1, &mTextureHandler));
+		
+		mTextureHandler = 0;
+
+		return RC_OK;
+	}
 	
 
 	TDE2_API ITexture2D* CreateOGLTexture2D(IResourceManager* pResourceManager, IGraphicsContext* pGraphicsContext, const std::string& name, E_RESULT_CODE& result)
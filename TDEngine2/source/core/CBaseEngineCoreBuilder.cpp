@@ -271,10 +271,12 @@ namespace TDEngine2
 		mpResourceManagerInstance->RegisterResourceTypeAlias(ITexture2D::GetTypeId(), IAtlasSubTexture::GetTypeId());
 		mpResourceManagerInstance->RegisterResourceTypeAlias(IFont::GetTypeId(), IRuntimeFont::GetTypeId());
 
+		mpResourceManagerInstance->SetMemoryBudget(static_cast<USIZE>(CProjectSettings::Get()->mCommonSettings.mResourcesMemoryBudget) << 20);
+
 		return mpEngineCoreInstance->RegisterSubsystem(DynamicPtrCast<IEngineSubsystem>(mpResourceManagerInstance));
 	}
 
-	E_RESULT_CODE CBaseEngineCoreBuilder::_configureJobManager(U32 maxNumOfThreads)
+	E_RESULT_CODE CBaseEngineCoreBuilder::_configureJobManager(const TJobManagerInitParams& params)
 	{
 		if (!mIsInitialized)
 		{
@@ -284,7 +286,7 @@ namespace TDEngine2
 		E_RESULT_CODE result = RC_OK;
 
 #if defined (TDE2_USE_WINPLATFORM) || defined (TDE2_USE_UNIXPLATFORM)
-		mpJobManagerInstance = TPtr<IJobManager>(CreateBaseJobManager(maxNumOfThreads, result));
+		mpJobManagerInstance = TPtr<IJobManager>(CreateBaseJobManager(params, result));
 #else
 #endif
 
@@ -346,7 +348,9 @@ namespace TDEngine2
 
 		E_RESULT_CODE result = RC_OK;
 
-		IRenderer* pRenderer = CreateForwardRenderer({ mpGraphicsContextInstance, mpResourceManagerInstance, CreateLinearAllocator, nullptr }, result);
+		const U32 workerThreadsCount = mpJobManagerInstance ? mpJobManagerInstance->GetWorkerThreadsCount() : 0;
+
+		IRenderer* pRenderer = CreateForwardRenderer({ mpGraphicsContextInstance, mpResourceManagerInstance, CreateLinearAllocator, nullptr, workerThreadsCount }, result);
 		if (result != RC_OK)
 		{
 			return result;
@@ -505,7 +509,7 @@ namespace TDEngine2
 		E_RESULT_CODE result = RC_OK;
 
 		// \todo load settings from  settings
-		auto pSceneManager = TPtr<ISceneManager>(CreateSceneManager(mpFileSystemInstance, TPtr<IWorld>(CreateWorld(mpWindowSystemInstance->GetEventManager(), result)), {}, result));
+		auto pSceneManager = TPtr<ISceneManager>(CreateSceneManager(mpFileSystemInstance, TPtr<IWorld>(CreateWorld(mpWindowSystemInstance->GetEventManager(), mpJobManagerInstance, result)), {}, result));
 		if (result != RC_OK)
 		{
 			return result;
@@ -551,7 +555,15 @@ namespace TDEngine2
 
 		PANIC_ON_FAILURE(_mountDirectories(CProjectSettings::Get()->mGraphicsSettings.mGraphicsContextType));
 
-		PANIC_ON_FAILURE(_configureJobManager(CProjectSettings::Get()->mCommonSettings.mMaxNumOfWorkerThreads));
+		{
+			auto&& commonSettings = CProjectSettings::Get()->mCommonSettings;
+
+			TJobManagerInitParams jobManagerParams;
+			jobManagerParams.mMaxNumOfThreads            = commonSettings.mMaxNumOfWorkerThreads;
+			jobManagerParams.mMainThreadQueueTimeBudget = commonSettings.mMainThreadQueueTimeBudget;
+
+			PANIC_ON_FAILURE(_configureJobManager(jobManagerParams));
+		}
 		PANIC_ON_FAILURE(_configureEventManager());
 		PANIC_ON_FAILURE(_configureResourceManager());
 
@@ -1,31 +1,55 @@
 #include "./../../include/core/CBaseJobManager.h"
 #include "./../../include/utils/CFileLogger.h"
+#include "./../../include/editor/CPerfProfiler.h"
+#include <algorithm>
+#include <chrono>
 
 
 namespace TDEngine2
 {
+	static thread_local const CBaseJobManager* pCurrThreadJobManager = nullptr;
+	static thread_local U32 CurrThreadContextIndex = 0;
+
+
 	CBaseJobManager::CBaseJobManager():
 		mIsInitialized(false)
 	{
 	}
 
-	E_RESULT_CODE CBaseJobManager::Init(U32 maxNumOfThreads)
+	E_RESULT_CODE CBaseJobManager::Init(const TJobManagerInitParams& params)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 		
-		mNumOfThreads = maxNumOfThreads;
+		mNumOfThreads = params.mMaxNumOfThreads;
+		mMainThreadQueueTimeBudget = params.mMainThreadQueueTimeBudget;
 
 		mIsRunning = true;
 
-		for (U32 i = 0; i < mNumOfThreads; ++i)
+		mSharedJobsCount      = 0;
+		mNextSharedSlotIndex  = 0;
+		mPendingJobsCount     = 0;
+		mSleepingWorkersCount = 0;
+
+		/// \note Workers' contexts go first, the last one is used by the calling thread
+		const U32 threadContextsCount = mNumOfThreads + 1;
+
+		for (U32 i = 0; i < threadContextsCount; ++i)
 		{
-			mWorkerThreads.emplace_back(&CBaseJobManager::_executeTasksLoop, this);
+			mThreadContexts.emplace_back(std::make_unique<TThreadContext>(JobsPoolSizePerThread));
 		}
 
-		mUpdateCounter = 0;
+		mpJobSlots = std::unique_ptr<TJobSlot[]>(new TJobSlot[(threadContextsCount + 1) * JobsPoolSizePerThread]);
+
+		pCurrThreadJobManager  = this;
+		CurrThreadContextIndex = mNumOfThreads;
+
+		for (U32 i = 0; i < mNumOfThreads; ++i)
+		{
+			mWorkerThreads.emplace_back(&CBaseJobManager::_executeTasksLoop, this, i);
+		}
 
 		mIsInitialized = true;
 
@@ -37,7 +61,10 @@ namespace TDEngine2
 	
 	E_RESULT_CODE CBaseJobManager::_onFreeInternal()
 	{
-		mIsRunning = false;
+		{
+			std::lock_guard<std::mutex> lock(mSleepMutex);
+			mIsRunning = false;
+		}
 
 		mHasNewJobAdded.notify_all();
 
@@ -50,6 +77,14 @@ namespace TDEngine2
 			}
 		}
 
+		/// \note Execute jobs that were left in the queue of the calling thread
+		while (_tryExecuteJob()) {}
+
+		if (this == pCurrThreadJobManager)
+		{
+			pCurrThreadJobManager = nullptr;
+		}
+
 		LOG_MESSAGE("[Job Manager] The job manager was successfully destroyed");
 
 		return RC_OK;
@@ -64,6 +99,12 @@ namespace TDEngine2
 		return MainThreadId == std::this_thread::get_id();
 	}
 
+	U32 CBaseJobManager::GetCurrWorkerThreadIndex()
+	{
+		/// \note The thread which has initialized the manager owns the last context, so its index is equal to the number of workers
+		return (pCurrThreadJobManager && (CurrThreadContextIndex < pCurrThreadJobManager->mNumOfThreads)) ? CurrThreadContextIndex : InvalidWorkerThreadIndex;
+	}
+
 	E_RESULT_CODE CBaseJobManager::ExecuteInMainThread(const std::function<void()>& action)
 	{
 		if (!action)
@@ -77,81 +118,424 @@ namespace TDEngine2
 			return RC_OK;
 		}
 
-		std::lock_guard<std::mutex> lock(mMainThreadCallbacksQueueMutex);
-
-		mMainThreadCallbacksQueue.emplace(action);
+		mMainThreadCallbacksQueue.Push(std::function<void()>(action));
 
 		return RC_OK;
 	}
 
 	void CBaseJobManager::ProcessMainThreadQueue()
 	{
-		if (mUpdateCounter < mUpdateTickRate)
+		TDE2_PROFILER_SCOPE("CBaseJobManager::ProcessMainThreadQueue");
+
+		typedef std::chrono::steady_clock TClock;
+
+		const TClock::time_point startTime = TClock::now();
+		const bool isBudgetLimited = mMainThreadQueueTimeBudget > 0.0f;
+
+		F32 elapsedTime = 0.0f;
+		U32 processedCallbacksCount = 0;
+
+		std::function<void()> callback;
+
+		/// \note At least one callback is executed per frame, so the queue progresses even with a tiny budget
+		while (mMainThreadCallbacksQueue.TryPop(callback))
+		{
+			callback();
+			++processedCallbacksCount;
+
+			elapsedTime = std::chrono::duration<F32, std::milli>(TClock::now() - startTime).count();
+
+			if (isBudgetLimited && elapsedTime >= mMainThreadQueueTimeBudget)
+			{
+				break;
+			}
+		}
+
+		mMainThreadQueueStats.mProcessedCallbacksCount = processedCallbacksCount;
+		mMainThreadQueueStats.mPendingCallbacksCount   = mMainThreadCallbacksQueue.GetSize();
+		mMainThreadQueueStats.mDrainTime               = elapsedTime;
+
+		TDE2_PROFILER_COUNTER("MainThreadQueue::ProcessedCallbacks", static_cast<F32>(mMainThreadQueueStats.mProcessedCallbacksCount));
+		TDE2_PROFILER_COUNTER("MainThreadQueue::PendingCallbacks", static_cast<F32>(mMainThreadQueueStats.mPendingCallbacksCount));
+		TDE2_PROFILER_COUNTER("MainThreadQueue::DrainTime (ms)", mMainThreadQueueStats.mDrainTime);
+	}
+
+	const TMainThreadQueueStats& CBaseJobManager::GetMainThreadQueueStats() const
+	{
+		return mMainThreadQueueStats;
+	}
+	
+	U32 CBaseJobManager::GetWorkerThreadsCount() const
+	{
+		return mNumOfThreads;
+	}
+
+	E_RESULT_CODE CBaseJobManager::ParallelFor(USIZE elementsCount, USIZE elementSize, const TParallelForAction& action)
+	{
+		TDE2_PROFILER_SCOPE("CBaseJobManager::ParallelFor");
+
+		if (!action || !elementSize)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		if (!elementsCount)
+		{
+			return RC_OK;
+		}
+
+		/// \note The calling thread processes one of ranges too
+		const USIZE executorsCount = static_cast<USIZE>(mNumOfThreads) + 1;
+		const USIZE elementsPerCacheLine = std::max<USIZE>(1, CacheLineSize / elementSize);
+
+		USIZE rangeSize = (elementsCount + executorsCount - 1) / executorsCount;
+		rangeSize = ((rangeSize + elementsPerCacheLine - 1) / elementsPerCacheLine) * elementsPerCacheLine;
+
+		const USIZE rangesCount = (elementsCount + rangeSize - 1) / rangeSize;
+
+		if (!mNumOfThreads || rangesCount < 2)
+		{
+			action(0, elementsCount);
+			return RC_OK;
+		}
+
+		TJobCounter unfinishedRangesCounter;
+
+		for (USIZE i = 1; i < rangesCount; ++i)
+		{
+			const USIZE first = i * rangeSize;
+			const USIZE last  = std::min(first + rangeSize, elementsCount);
+
+			const TJobHandle jobHandle = _submitInlineJob(&unfinishedRangesCounter, [&action, first, last] { action(first, last); });
+			TDE2_ASSERT(jobHandle.IsValid());
+		}
+
+		action(0, rangeSize);
+
+		WaitForJobCounter(unfinishedRangesCounter);
+
+		return RC_OK;
+	}
+
+	TJobHandle CBaseJobManager::ContinueWith(const TJobHandle& parentJobHandle, TJobCounter* pCounter, TJobCallback job)
+	{
+		if (!job)
+		{
+			return {};
+		}
+
+		const U32 slotIndex = _allocateJobSlot(pCounter);
+		mpJobSlots[slotIndex].mCallback = std::move(job);
+
+		const TJobHandle jobHandle { slotIndex, mpJobSlots[slotIndex].mGeneration.load(std::memory_order_relaxed) };
+
+		if (!parentJobHandle.IsValid())
+		{
+			_pushJob(slotIndex);
+			return jobHandle;
+		}
+
+		TJobSlot& parentSlot = mpJobSlots[parentJobHandle.mSlotIndex];
+
+		while (parentSlot.mContinuationsLock.test_and_set(std::memory_order_acquire)) {}
+
+		/// \note The generation is changed under the lock when the parent is completed, so the continuation can't be lost
+		if (parentSlot.mGeneration.load(std::memory_order_relaxed) != parentJobHandle.mGeneration)
 		{
-			++mUpdateCounter;
-			return;
+			parentSlot.mContinuationsLock.clear(std::memory_order_release);
+			_pushJob(slotIndex);
+
+			return jobHandle;
 		}
 
-		mUpdateCounter = 0;
+		if (parentSlot.mContinuationsCount < MaxJobContinuationsCount)
+		{
+			parentSlot.mContinuations[parentSlot.mContinuationsCount++] = slotIndex;
+			parentSlot.mContinuationsLock.clear(std::memory_order_release);
 
-		std::lock_guard<std::mutex> lock(mMainThreadCallbacksQueueMutex);
+			return jobHandle;
+		}
+
+		parentSlot.mContinuationsLock.clear(std::memory_order_release);
+
+		/// \note There is no space for the continuation, so wait for the parent
+		WaitForJob(parentJobHandle);
+		_pushJob(slotIndex);
+
+		return jobHandle;
+	}
+
+	void CBaseJobManager::WaitForJobCounter(const TJobCounter& counter, U32 value)
+	{
+		TDE2_PROFILER_SCOPE("CBaseJobManager::WaitForJobCounter");
 
-		while (!mMainThreadCallbacksQueue.empty())
+		while (counter.mValue.load(std::memory_order_acquire) > value)
 		{
-			mMainThreadCallbacksQueue.front()();
-			mMainThreadCallbacksQueue.pop();
+			if (!_tryExecuteJob())
+			{
+				std::this_thread::yield();
+			}
 		}
 	}
-	
+
+	void CBaseJobManager::WaitForJob(const TJobHandle& jobHandle)
+	{
+		TDE2_PROFILER_SCOPE("CBaseJobManager::WaitForJob");
+
+		while (!IsJobCompleted(jobHandle))
+		{
+			if (!_tryExecuteJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	bool CBaseJobManager::IsJobCompleted(const TJobHandle& jobHandle) const
+	{
+		if (!jobHandle.IsValid())
+		{
+			return true;
+		}
+
+		return mpJobSlots[jobHandle.mSlotIndex].mGeneration.load(std::memory_order_acquire) != jobHandle.mGeneration;
+	}
+
 	E_ENGINE_SUBSYSTEM_TYPE CBaseJobManager::GetType() const
 	{
 		return EST_JOB_MANAGER;
 	}
 
-	void CBaseJobManager::_executeTasksLoop()
+	void CBaseJobManager::_executeTasksLoop(U32 threadContextIndex)
 	{
-		std::unique_ptr<IJob> pJob;
+		pCurrThreadJobManager  = this;
+		CurrThreadContextIndex = threadContextIndex;
 
 		while (true)
 		{
+			if (_tryExecuteJob())
 			{
-				std::unique_lock<std::mutex> lock(mQueueMutex);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(mSleepMutex);
+
+			if (!mIsRunning && mPendingJobsCount.load() <= 0)
+			{
+				return;
+			}
+
+			++mSleepingWorkersCount;
+			mHasNewJobAdded.wait(lock, [this] { return !mIsRunning || mPendingJobsCount.load() > 0; });
+			--mSleepingWorkersCount;
+		}
+	}
+
+	bool CBaseJobManager::_tryExecuteJob()
+	{
+		U32 slotIndex = 0;
+
+		if (!_tryGetJob(slotIndex))
+		{
+			return false;
+		}
+
+		_executeJob(slotIndex);
+
+		return true;
+	}
+
+	TJobHandle CBaseJobManager::_submitJob(TJobCounter* pCounter, TJobCallback&& job)
+	{
+		if (!job || !mIsInitialized)
+		{
+			return {};
+		}
+
+		const U32 slotIndex = _allocateJobSlot(pCounter);
+		mpJobSlots[slotIndex].mCallback = std::move(job); /// \note The slot isn't visible to other threads until it's pushed
 
-				mHasNewJobAdded.wait(lock, [this] { return !mIsRunning || !mJobs.empty(); });
+		const TJobHandle jobHandle { slotIndex, mpJobSlots[slotIndex].mGeneration.load(std::memory_order_relaxed) };
 
-				if (!mIsRunning && mJobs.empty())
+		_pushJob(slotIndex);
+
+		return jobHandle;
+	}
+
+	U32 CBaseJobManager::_allocateJobSlot(TJobCounter* pCounter)
+	{
+		/// \note The counter is increased before the job becomes visible to other threads
+		if (pCounter)
+		{
+			pCounter->mValue.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		const U32 threadContextIndex = (this == pCurrThreadJobManager) ? CurrThreadContextIndex : static_cast<U32>(mThreadContexts.size());
+		const U32 firstSlotIndex = threadContextIndex * JobsPoolSizePerThread;
+
+		TThreadContext* pThreadContext = _getCurrThreadContext();
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mSharedJobsMutex, std::defer_lock);
+
+				if (!pThreadContext) /// \note Slots of the shared range are allocated by any thread
 				{
-					return;
+					lock.lock();
 				}
 
-				pJob = std::move(mJobs.front());
+				U32& nextSlotIndex = pThreadContext ? pThreadContext->mNextSlotIndex : mNextSharedSlotIndex;
+
+				for (U32 i = 0; i < JobsPoolSizePerThread; ++i)
+				{
+					const U32 slotIndex = firstSlotIndex + nextSlotIndex;
+					nextSlotIndex = (nextSlotIndex + 1) & (JobsPoolSizePerThread - 1);
+
+					TJobSlot& slot = mpJobSlots[slotIndex];
+
+					if (slot.mIsBusy.load(std::memory_order_acquire))
+					{
+						continue;
+					}
 
-				mJobs.pop();
+					slot.mIsBusy.store(true, std::memory_order_relaxed);
+					slot.mpCounter           = pCounter;
+					slot.mContinuationsCount = 0;
+
+					return slotIndex;
+				}
 			}
 
-			(*pJob)();
+			/// \note All slots are occupied, help to complete some of them
+			if (!_tryExecuteJob())
+			{
+				std::this_thread::yield();
+			}
 		}
 	}
 
-	E_RESULT_CODE CBaseJobManager::_submitJob(std::unique_ptr<IJob> pJob)
+	void CBaseJobManager::_pushJob(U32 slotIndex)
 	{
-		if (!pJob)
+		TThreadContext* pThreadContext = _getCurrThreadContext();
+
+		if (!pThreadContext || !pThreadContext->mQueue.Push(slotIndex))
 		{
-			return RC_INVALID_ARGS;
+			std::lock_guard<std::mutex> lock(mSharedJobsMutex);
+
+			mSharedJobs.push_back(slotIndex);
+			++mSharedJobsCount;
 		}
 
-		std::lock_guard<std::mutex> lock(mQueueMutex);
+		++mPendingJobsCount;
 
-		mJobs.emplace(std::move(pJob));
+		if (mSleepingWorkersCount.load())
+		{
+			std::lock_guard<std::mutex> lock(mSleepMutex);
+			mHasNewJobAdded.notify_one();
+		}
+	}
 
-		mHasNewJobAdded.notify_one();
+	bool CBaseJobManager::_tryGetJob(U32& slotIndex)
+	{
+		TThreadContext* pThreadContext = _getCurrThreadContext();
 
-		return RC_OK;
+		if (pThreadContext && pThreadContext->mQueue.Pop(slotIndex))
+		{
+			--mPendingJobsCount;
+			return true;
+		}
+
+		if (mSharedJobsCount.load(std::memory_order_relaxed))
+		{
+			std::lock_guard<std::mutex> lock(mSharedJobsMutex);
+
+			if (!mSharedJobs.empty())
+			{
+				slotIndex = mSharedJobs.front();
+				mSharedJobs.pop_front();
+
+				--mSharedJobsCount;
+				--mPendingJobsCount;
+
+				return true;
+			}
+		}
+
+		/// \note Steal from other threads starting from the next one to spread thieves over queues
+		const U32 threadContextsCount = static_cast<U32>(mThreadContexts.size());
+		const U32 firstVictimIndex = pThreadContext ? (CurrThreadContextIndex + 1) : 0;
+
+		for (U32 i = 0; i < threadContextsCount; ++i)
+		{
+			TThreadContext* pVictimContext = mThreadContexts[(firstVictimIndex + i) % threadContextsCount].get();
+			if (pVictimContext == pThreadContext)
+			{
+				continue;
+			}
+
+			if (pVictimContext->mQueue.Steal(slotIndex))
+			{
+				--mPendingJobsCount;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CBaseJobManager::_executeJob(U32 slotIndex)
+	{
+		TJobSlot& slot = mpJobSlots[slotIndex];
+
+		if (slot.mpInlineCallbackInvoker)
+		{
+			slot.mpInlineCallbackInvoker(slot.mInlineCallback);
+			slot.mpInlineCallbackInvoker = nullptr;
+		}
+		else
+		{
+			slot.mCallback();
+			slot.mCallback = nullptr; /// \note Release captured resources right away
+		}
+
+		TJobCounter* pCounter = slot.mpCounter;
+		slot.mpCounter = nullptr;
+
+		std::array<U32, MaxJobContinuationsCount> continuations;
+		U32 continuationsCount = 0;
+
+		while (slot.mContinuationsLock.test_and_set(std::memory_order_acquire)) {}
+
+		slot.mGeneration.fetch_add(1, std::memory_order_release);
+
+		continuationsCount = slot.mContinuationsCount;
+		std::copy(slot.mContinuations.begin(), slot.mContinuations.begin() + continuationsCount, continuations.begin());
+		slot.mContinuationsCount = 0;
+
+		slot.mContinuationsLock.clear(std::memory_order_release);
+
+		for (U32 i = 0; i < continuationsCount; ++i)
+		{
+			_pushJob(continuations[i]);
+		}
+
+		slot.mIsBusy.store(false, std::memory_order_release);
+
+		if (pCounter)
+		{
+			pCounter->mValue.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	CBaseJobManager::TThreadContext* CBaseJobManager::_getCurrThreadContext() const
+	{
+		return (this == pCurrThreadJobManager) ? mThreadContexts[CurrThreadContextIndex].get() : nullptr;
 	}
 
 
-	IJobManager* CreateBaseJobManager(U32 maxNumOfThreads, E_RESULT_CODE& result)
+	IJobManager* CreateBaseJobManager(const TJobManagerInitParams& params, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(IJobManager, CBaseJobManager, result, maxNumOfThreads);
+		return CREATE_IMPL(IJobManager, CBaseJobManager, result, params);
 	}
 }
\ No newline at end of file
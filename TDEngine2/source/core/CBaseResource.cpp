@@ -4,7 +4,8 @@
 namespace TDEngine2
 {
 	CBaseResource::CBaseResource() :
-		CBaseObject(), mId(TResourceId::Invalid), mState(E_RESOURCE_STATE_TYPE::RST_PENDING), mLoadingPolicy(E_RESOURCE_LOADING_POLICY::SYNCED)
+		CBaseObject(), mId(TResourceId::Invalid), mState(E_RESOURCE_STATE_TYPE::RST_PENDING), mLoadingPolicy(E_RESOURCE_LOADING_POLICY::SYNCED), 
+		mLastUsedTick(0)
 	{
 	}
 
@@ -35,13 +36,16 @@ namespace TDEngine2
 			return result;
 		}
 
+		/// \note A loader could set the state itself, e.g. it stays RST_LOADING until the loader's callbacks are executed on the main thread
+		E_RESOURCE_STATE_TYPE expectedState = E_RESOURCE_STATE_TYPE::RST_PENDING;
+
 		switch (mLoadingPolicy)
 		{
 			case E_RESOURCE_LOADING_POLICY::SYNCED:
-				mState = E_RESOURCE_STATE_TYPE::RST_LOADED;
+				mState.compare_exchange_strong(expectedState, E_RESOURCE_STATE_TYPE::RST_LOADED);
 				break;
 			case E_RESOURCE_LOADING_POLICY::STREAMING:
-				mState = E_RESOURCE_STATE_TYPE::RST_LOADING;
+				mState.compare_exchange_strong(expectedState, E_RESOURCE_STATE_TYPE::RST_LOADING);
 				break;
 		}
 
@@ -54,6 +58,11 @@ namespace TDEngine2
 		return mpResourceManager->ReleaseResource(mId);
 	}
 
+	E_RESULT_CODE CBaseResource::Evict()
+	{
+		return RC_NOT_IMPLEMENTED_YET;
+	}
+
 	E_RESULT_CODE CBaseResource::_onFreeInternal()
 	{
 		return Reset();
@@ -96,6 +105,21 @@ namespace TDEngine2
 		return mLoadingPolicy;
 	}
 
+	USIZE CBaseResource::GetMemorySize() const
+	{
+		return 0;
+	}
+
+	void CBaseResource::SetLastUsedTick(U32 tick)
+	{
+		mLastUsedTick = tick;
+	}
+
+	U32 CBaseResource::GetLastUsedTick() const
+	{
+		return mLastUsedTick;
+	}
+
 	TDE2_API E_RESULT_CODE CBaseResource::_init(IResourceManager* pResourceManager, const std::string& name)
 	{
 		if (mIsInitialized)
@@ -358,7 +358,14 @@ namespace TDEngine2
 			pJobManager->ProcessMainThreadQueue();
 		}
 
+		if (IResourceManager* pResourceManager = _getSubsystemAs<IResourceManager>(EST_RESOURCE_MANAGER))
+		{
+			pResourceManager->Update(); /// \note Evicted resources are reloaded here, so their GPU data is created on the main thread
+		}
+
 #if defined(TDE2_DEBUG_MODE) || TDE2_PRODUCTION_MODE
+		CPoolAllocatorsRegistry::UpdatePoolsInfo(); /// \note Pools' statistics are sampled once per frame instead of on each allocation
+
 		CPerfProfiler::Get()->EndFrame();
 		CMemoryProfiler::Get()->EndFrame();
 #endif
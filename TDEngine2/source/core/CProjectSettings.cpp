@@ -17,6 +17,8 @@ namespace TDEngine2
 		{
 			static const std::string mApplicationIdKey;
 			static const std::string mMaxThreadsCountKey;
+			static const std::string mMainThreadQueueTimeBudgetKey;
+			static const std::string mResourcesMemoryBudgetKey;
 			static const std::string mFlagsKey;
 		};
 
@@ -30,6 +32,8 @@ namespace TDEngine2
 			{
 				static const std::string mShadowMapSizesKey;
 				static const std::string mIsShadowMapEnabledKey;
+				static const std::string mShadowCascadesCountKey;
+				static const std::string mShadowsDistanceKey;
 			};
 		};
 
@@ -61,6 +65,8 @@ namespace TDEngine2
 
 	const std::string TProjectSettingsArchiveKeys::TCommonSettingsKeys::mApplicationIdKey = "application_id";
 	const std::string TProjectSettingsArchiveKeys::TCommonSettingsKeys::mMaxThreadsCountKey = "max_worker_threads_count";
+	const std::string TProjectSettingsArchiveKeys::TCommonSettingsKeys::mMainThreadQueueTimeBudgetKey = "main_thread_queue_time_budget";
+	const std::string TProjectSettingsArchiveKeys::TCommonSettingsKeys::mResourcesMemoryBudgetKey = "resources_memory_budget";
 	const std::string TProjectSettingsArchiveKeys::TCommonSettingsKeys::mFlagsKey = "flags";
 
 	const std::string TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::mGraphicsTypeKey = "gapi_type";
@@ -68,6 +74,8 @@ namespace TDEngine2
 	const std::string TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::mDefaultSkyboxMaterialKey = "default_skybox_mat_id";
 	const std::string TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::TRendererSettingsKeys::mShadowMapSizesKey = "shadow_maps_size";
 	const std::string TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::TRendererSettingsKeys::mIsShadowMapEnabledKey = "shadow_maps_enabled";
+	const std::string TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::TRendererSettingsKeys::mShadowCascadesCountKey = "shadow_cascades_count";
+	const std::string TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::TRendererSettingsKeys::mShadowsDistanceKey = "shadows_distance";
 
 	const std::string TProjectSettingsArchiveKeys::TAudioSettingsKeys::mAudioTypeKey = "api_type";
 
@@ -99,6 +107,8 @@ namespace TDEngine2
 		{
 			mCommonSettings.mApplicationName = pFileReader->GetString(TProjectSettingsArchiveKeys::TCommonSettingsKeys::mApplicationIdKey);
 			mCommonSettings.mMaxNumOfWorkerThreads = pFileReader->GetUInt32(TProjectSettingsArchiveKeys::TCommonSettingsKeys::mMaxThreadsCountKey);
+			mCommonSettings.mMainThreadQueueTimeBudget = pFileReader->GetFloat(TProjectSettingsArchiveKeys::TCommonSettingsKeys::mMainThreadQueueTimeBudgetKey, mCommonSettings.mMainThreadQueueTimeBudget);
+			mCommonSettings.mResourcesMemoryBudget = pFileReader->GetUInt32(TProjectSettingsArchiveKeys::TCommonSettingsKeys::mResourcesMemoryBudgetKey, mCommonSettings.mResourcesMemoryBudget);
 			mCommonSettings.mFlags = pFileReader->GetUInt32(TProjectSettingsArchiveKeys::TCommonSettingsKeys::mFlagsKey);
 		}
 		result = result | pFileReader->EndGroup();
@@ -119,6 +129,11 @@ namespace TDEngine2
 			{
 				mGraphicsSettings.mRendererSettings.mShadowMapSizes = pFileReader->GetUInt32(TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::TRendererSettingsKeys::mShadowMapSizesKey);
 				mGraphicsSettings.mRendererSettings.mIsShadowMappingEnabled = pFileReader->GetBool(TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::TRendererSettingsKeys::mIsShadowMapEnabledKey);
+
+				auto& rendererSettings = mGraphicsSettings.mRendererSettings;
+
+				rendererSettings.mShadowCascadesCount = pFileReader->GetUInt32(TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::TRendererSettingsKeys::mShadowCascadesCountKey, rendererSettings.mShadowCascadesCount);
+				rendererSettings.mShadowsDistance = pFileReader->GetFloat(TProjectSettingsArchiveKeys::TGraphicsSettingsKeys::TRendererSettingsKeys::mShadowsDistanceKey, rendererSettings.mShadowsDistance);
 			}
 			result = result | pFileReader->EndGroup();
 		}
@@ -91,22 +91,30 @@ namespace TDEngine2
 
 	void CProxyGraphicsContext::Draw(E_PRIMITIVE_TOPOLOGY_TYPE topology, U32 startVertex, U32 numOfVertices)
 	{
+		++mStats.mDrawCallsCount;
+
 		LOG_MESSAGE("[ProxyGraphicsContext] Draw(E_PRIMITIVE_TOPOLOGY_TYPE, U32, U32)");
 	}
 
 	void CProxyGraphicsContext::DrawIndexed(E_PRIMITIVE_TOPOLOGY_TYPE topology, E_INDEX_FORMAT_TYPE indexFormatType, U32 baseVertex, U32 startIndex, U32 numOfIndices)
 	{
+		++mStats.mDrawCallsCount;
+
 		LOG_MESSAGE("[ProxyGraphicsContext] DrawIndexed(E_PRIMITIVE_TOPOLOGY_TYPE, E_INDEX_FORMAT_TYPE, U32, U32, U32)");
 	}
 
 	void CProxyGraphicsContext::DrawInstanced(E_PRIMITIVE_TOPOLOGY_TYPE topology, U32 startVertex, U32 verticesPerInstance, U32 startInstance, U32 numOfInstances)
 	{
+		++mStats.mDrawCallsCount;
+
 		LOG_MESSAGE("[ProxyGraphicsContext] DrawIndexed(E_PRIMITIVE_TOPOLOGY_TYPE, U32, U32, U32, U32)");
 	}
 
 	void CProxyGraphicsContext::DrawIndexedInstanced(E_PRIMITIVE_TOPOLOGY_TYPE topology, E_INDEX_FORMAT_TYPE indexFormatType, U32 baseVertex, U32 startIndex,
 		U32 startInstance, U32 indicesPerInstance, U32 numOfInstances)
 	{
+		++mStats.mDrawCallsCount;
+
 		LOG_MESSAGE("[ProxyGraphicsContext] DrawIndexedInstanced(E_PRIMITIVE_TOPOLOGY_TYPE, E_INDEX_FORMAT_TYPE, U32, U32, U32, U32, U32)");
 	}
 
@@ -117,16 +125,22 @@ namespace TDEngine2
 
 	void CProxyGraphicsContext::BindBlendState(TBlendStateId blendStateId)
 	{
+		++mStats.mBlendStateBindsCount;
+
 		LOG_MESSAGE("[ProxyGraphicsContext] BindBlendState(TBlendStateId)");
 	}
 
 	void CProxyGraphicsContext::BindDepthStencilState(TDepthStencilStateId depthStencilStateId)
 	{
+		++mStats.mDepthStencilStateBindsCount;
+
 		LOG_MESSAGE("[ProxyGraphicsContext] BindDepthStencilState(TDepthStencilStateId)");
 	}
 
 	void CProxyGraphicsContext::BindRasterizerState(TRasterizerStateId rasterizerStateId)
 	{
+		++mStats.mRasterizerStateBindsCount;
+
 		LOG_MESSAGE("[ProxyGraphicsContext] BindRasterizerState(TRasterizerStateId)");
 	}
 
@@ -191,6 +205,16 @@ namespace TDEngine2
 		return mpWindowSystem;
 	}
 
+	void CProxyGraphicsContext::ResetStats()
+	{
+		mStats = TProxyGraphicsContextStats();
+	}
+
+	const TProxyGraphicsContextStats& CProxyGraphicsContext::GetStats() const
+	{
+		return mStats;
+	}
+
 
 	TDE2_API IGraphicsContext* CreateProxyGraphicsContext(TPtr<IWindowSystem> pWindowSystem, E_RESULT_CODE& result)
 	{
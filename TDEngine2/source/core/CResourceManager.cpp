@@ -3,14 +3,53 @@
 #include "../../include/core/IJobManager.h"
 #include "../../include/core/IResourceFactory.h"
 #include "../../include/core/IResource.h"
+#include "../../include/editor/CMemoryProfiler.h"
 #include <memory>
 #include <algorithm>
+#include <iterator>
 
 
 namespace TDEngine2
 {
+	template <typename TMap>
+	static auto FindResourceEntry(TMap& resourcesMap, const std::string& name, U32 nameHash) -> decltype(resourcesMap.begin())
+	{
+		auto&& range = resourcesMap.equal_range(nameHash);
+
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second.mName == name)
+			{
+				return it;
+			}
+		}
+
+		return resourcesMap.end();
+	}
+
+
+	/// \note A resource which isn't referenced outside of the manager is held by the container and a local handle only
+	static constexpr U32 UnreferencedResourceRefCount = 2;
+
+
+	static bool IsLoadingRequestFinished(E_RESOURCE_LOADING_STATUS status)
+	{
+		switch (status)
+		{
+			case E_RESOURCE_LOADING_STATUS::INVALID:
+			case E_RESOURCE_LOADING_STATUS::COMPLETED:
+			case E_RESOURCE_LOADING_STATUS::FAILED:
+			case E_RESOURCE_LOADING_STATUS::CANCELLED:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+
 	CResourceManager::CResourceManager():
-		CBaseObject()
+		CBaseObject(), mCurrTick(1), mMemoryBudget(0), mMemoryUsage(0), mAsyncLoadingSequenceIndex(0), mActiveAsyncLoadingRequestsCount(0), 
+		mMaxActiveAsyncLoadingRequestsCount(1)
 	{
 	}
 
@@ -30,6 +69,9 @@ namespace TDEngine2
 
 		mpJobManager = pJobManager;
 
+		mMaxActiveAsyncLoadingRequestsCount = std::max<U32>(1, mpJobManager->GetWorkerThreadsCount());
+		mMainThreadId = std::this_thread::get_id();
+
 		mIsInitialized = true;
 
 		return RC_OK;
@@ -37,6 +79,67 @@ namespace TDEngine2
 
 	E_RESULT_CODE CResourceManager::_onFreeInternal()
 	{
+		if (!mIsInitialized)
+		{
+			return RC_OK;
+		}
+
+		std::vector<TJobHandle> activeJobs;
+		bool hasUnsubmittedJobs = true;
+
+		/// \note Jobs are submitted after mAsyncLoadingMutex is unlocked, so requests without handles are polled until they get them
+		while (hasUnsubmittedJobs)
+		{
+			activeJobs.clear();
+			hasUnsubmittedJobs = false;
+
+			{
+				std::lock_guard<std::mutex> lock(mAsyncLoadingMutex);
+
+				for (U32 i = 0; i < static_cast<U32>(mAsyncLoadingRequests.size()); ++i)
+				{
+					TAsyncLoadingRequest& currRequest = mAsyncLoadingRequests[i];
+
+					switch (currRequest.mStatus)
+					{
+						case E_RESOURCE_LOADING_STATUS::WAITING_DEPENDENCIES:
+						case E_RESOURCE_LOADING_STATUS::QUEUED:
+							_finishAsyncLoadingRequestInternal(currRequest, E_RESOURCE_LOADING_STATUS::CANCELLED);
+							break;
+						case E_RESOURCE_LOADING_STATUS::LOADING:
+							if (currRequest.mJobHandle.IsValid())
+							{
+								activeJobs.push_back(currRequest.mJobHandle);
+							}
+							else if (std::find(mMainThreadAsyncLoadingRequests.cbegin(), mMainThreadAsyncLoadingRequests.cend(), std::make_tuple(i, currRequest.mGeneration)) == mMainThreadAsyncLoadingRequests.cend())
+							{
+								hasUnsubmittedJobs = true;
+							}
+							break;
+						default:
+							break;
+					}
+				}
+			}
+
+			/// \note Jobs reference the manager, so they should be finished before it's destroyed
+			for (const TJobHandle& currJobHandle : activeJobs)
+			{
+				mpJobManager->WaitForJob(currJobHandle);
+			}
+
+			if (hasUnsubmittedJobs)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		{
+			/// \note Actions could hold references to resources, so they're released before the resources
+			std::lock_guard<std::mutex> lock(mAsyncLoadingMutex);
+			mDeferredLoadingActions.clear();
+		}
+
 		return RC_OK;
 	}
 
@@ -178,6 +281,8 @@ namespace TDEngine2
 
 	E_RESULT_CODE CResourceManager::RegisterTypeGlobalLoadingPolicy(TypeId resourceType, E_RESOURCE_LOADING_POLICY policy)
 	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
 		if (TypeId::Invalid == resourceType)
 		{
 			return RC_INVALID_ARGS;
@@ -196,6 +301,8 @@ namespace TDEngine2
 
 	E_RESULT_CODE CResourceManager::UnregisterTypeGlobalLoadingPolicy(TypeId resourceType)
 	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
 		if (TypeId::Invalid == resourceType)
 		{
 			return RC_INVALID_ARGS;
@@ -219,235 +326,1162 @@ namespace TDEngine2
 
 	TPtr<IResource> CResourceManager::GetResource(const TResourceId& handle) const
 	{
-		std::lock_guard<std::mutex> lock(mMutex);
+		TPtr<IResource> pResource = _getResourceInternal(handle); /// \note The container of resources is synchronized by itself
+		if (!pResource)
+		{
+			return pResource;
+		}
 
-		return _getResourceInternal(handle);
-	}
+		pResource->SetLastUsedTick(mCurrTick);
 
-	TResourceId CResourceManager::GetResourceId(const std::string& name) const
-	{
-		if (name.empty())
+		if (E_RESOURCE_STATE_TYPE::RST_PENDING == pResource->GetState())
 		{
-			return TResourceId::Invalid;
+			_requestEvictedResourceReload(handle);
 		}
 
-		TResourcesMap::const_iterator resourceIter = mResourcesMap.find(name);
+		return pResource;
+	}
 
-		if (resourceIter == mResourcesMap.cend())
+	TResourceId CResourceManager::GetResourceId(const std::string& name) const
+	{
+		if (name.empty())
 		{
 			return TResourceId::Invalid;
 		}
 
-		return (*resourceIter).second;
+		return _findResourceId(name, ComputeHash(name.c_str()));
 	}
 
 	TResourceId CResourceManager::Load(const std::string& name, TypeId typeId, E_RESOURCE_LOADING_POLICY loadingPolicy)
 	{
-		std::lock_guard<std::mutex> lock(mMutex);
-		return _loadResource(typeId, name, loadingPolicy);
+		return _loadResource(typeId, name, ComputeHash(name.c_str()), loadingPolicy);
 	}
 
-	TResourceId CResourceManager::_loadResource(TypeId resourceTypeId, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy)
+	TResourceId CResourceManager::_loadResource(TypeId resourceTypeId, const std::string& name, U32 nameHash, E_RESOURCE_LOADING_POLICY loadingPolicy)
 	{
-		return _loadResourceWithResourceProviderInfo(resourceTypeId, resourceTypeId, resourceTypeId, name, loadingPolicy);
+		return _loadResourceWithResourceProviderInfo(resourceTypeId, resourceTypeId, resourceTypeId, name, nameHash, loadingPolicy);
 	}
 
-	TResourceId CResourceManager::_loadResourceWithResourceProviderInfo(TypeId resourceTypeId, TypeId factoryTypeId, TypeId loaderTypeId, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy)
+	TResourceId CResourceManager::_loadResourceWithResourceProviderInfo(TypeId resourceTypeId, TypeId factoryTypeId, TypeId loaderTypeId, const std::string& name, U32 nameHash,
+																		E_RESOURCE_LOADING_POLICY loadingPolicy)
 	{
-		//std::lock_guard<std::mutex> lock(mMutex);
+		bool isBeingLoaded = false;
 
-		auto&& iter = mResourcesMap.find(name);
-		if ((iter != mResourcesMap.cend()) && (iter->second != TResourceId::Invalid)) /// needed resource already exists
+		TResourceId resourceId = _findResourceId(name, nameHash, &isBeingLoaded);
+		if (TResourceId::Invalid != resourceId) /// needed resource already exists
 		{
-			auto getResourceResult = mResources[static_cast<U32>(iter->second)];
-			if (getResourceResult.HasError())
+			auto&& pResource = _getResourceInternal(resourceId);
+			if (pResource)
 			{
-				return TResourceId::Invalid;
+				pResource->SetLastUsedTick(mCurrTick);
 			}
 
-			auto&& pResource = getResourceResult.Get();
-			TDE2_ASSERT(pResource);
-
-			if (pResource)
+			if (!isBeingLoaded && pResource && (E_RESOURCE_STATE_TYPE::RST_PENDING != pResource->GetState()))
 			{
-				if (E_RESOURCE_STATE_TYPE::RST_PENDING == pResource->GetState())
-				{
-					E_RESULT_CODE result = pResource->Load(); /// \note Load is executed in sequential manner, but internally it can create background tasks
-					if (RC_OK != result)
-					{
-						return TResourceId::Invalid;
-					}
-				}
+				_waitForDeferredUploading(pResource);
+				return resourceId;
+			}
 
-				return iter->second;
+			if (RC_OK != _loadResourceOnce(resourceId, name, nameHash))
+			{
+				return TResourceId::Invalid;
 			}
 
-			TDE2_UNREACHABLE();
-			return TResourceId::Invalid;
+			_waitForDeferredUploading(pResource);
+
+			return resourceId;
 		}
 
 		/// \note Create a new resource and load it	
-		auto&& pResourceFactory = _getResourceFactory(factoryTypeId);
-		if (!pResourceFactory)
+		TPtr<IResource> pResource = _createResourceForLoading(resourceTypeId, factoryTypeId, name, loadingPolicy);
+		if (!pResource)
 		{
 			return TResourceId::Invalid;
 		}
 
-		auto it = mResourceTypesPoliciesRegistry.find(resourceTypeId);
+		pResource->SetLastUsedTick(mCurrTick);
 
-		TBaseResourceParameters loadingParameters;
-		loadingParameters.mLoadingPolicy = (E_RESOURCE_LOADING_POLICY::DEFAULT != loadingPolicy) || (it == mResourceTypesPoliciesRegistry.cend()) ? loadingPolicy : it->second;
+		auto&& registrationResult = _registerResource(name, nameHash, pResource, true, true);
+		
+		resourceId = std::get<TResourceId>(registrationResult);
 
-		IResource* pResource = pResourceFactory->CreateDefault(name, loadingParameters);
+		if (!std::get<bool>(registrationResult)) /// \note Another thread has created the resource, so treat it as an existing one
+		{
+			if (RC_OK != _loadResourceOnce(resourceId, name, nameHash))
+			{
+				return TResourceId::Invalid;
+			}
 
-		const TResourceId resourceId = TResourceId(mResources.Add(TPtr<IResource>(pResource)));
+			_waitForDeferredUploading(_getResourceInternal(resourceId));
 
-		mResourcesMap[name] = resourceId;
+			return resourceId;
+		}
 
-		pResource->Load(); /// \note Load is executed in sequential manner, but internally it can create background tasks
+		_loadClaimedResource(pResource, resourceId, name, nameHash);
 
 		return resourceId;
 	}
 
-	TResourceId CResourceManager::_createResource(TypeId resourceTypeId, const std::string& name, const TBaseResourceParameters& params)
+	TResourceLoadingHandle CResourceManager::LoadAsync(const std::string& name, TypeId typeId, const TAsyncLoadingParams& params)
 	{
-		TResourceId resourceId = GetResourceId(name);
-
-		if (TResourceId::Invalid != resourceId)
+		if (!mIsInitialized || name.empty())
 		{
-			return resourceId;
+			return {};
 		}
 
-		auto factoryIdIter = mResourceFactoriesMap.find(resourceTypeId);
-		if (factoryIdIter == mResourceFactoriesMap.cend())
+		const U32 nameHash = ComputeHash(name.c_str());
+
+		bool isBeingLoaded = false;
+		bool isLoaded = false;
+
+		TResourceId resourceId = _findResourceId(name, nameHash, &isBeingLoaded);
+		if (TResourceId::Invalid == resourceId)
 		{
-			return TResourceId::Invalid;
-		}
+			/// \note A loader is executed by a worker as a whole, so data is loaded synchronously there unless the type is streamed
+			E_RESOURCE_LOADING_POLICY loadingPolicy = E_RESOURCE_LOADING_POLICY::SYNCED;
 
-		auto&& pResourceFactory = mRegisteredResourceFactories[static_cast<U32>((*factoryIdIter).second) - 1].Get();
-		
-		IResource* pResource = nullptr;
-				
-		/// \todo move it to a background thread
-		pResource = pResourceFactory->Create(name, params);
-		
-		resourceId = TResourceId(mResources.Add(TPtr<IResource>(pResource)));
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
 
-		mResourcesMap[name] = resourceId;
+				auto it = mResourceTypesPoliciesRegistry.find(typeId);
+				if ((it != mResourceTypesPoliciesRegistry.cend()) && (E_RESOURCE_LOADING_POLICY::DEFAULT != it->second))
+				{
+					loadingPolicy = it->second;
+				}
+			}
 
-		pResource->OnCreated(this);
+			TPtr<IResource> pResource = _createResourceForLoading(typeId, typeId, name, loadingPolicy);
+			if (!pResource)
+			{
+				return {};
+			}
 
-		return resourceId;
-	}
+			/// \note The resource is registered at once, so its identifier could be used before the request is completed
+			pResource->SetState(E_RESOURCE_STATE_TYPE::RST_PENDING);
+			pResource->SetLastUsedTick(mCurrTick);
 
-	TPtr<IResource> CResourceManager::_getResourceInternal(const TResourceId& handle) const
-	{
-		if (handle == TResourceId::Invalid)
+			resourceId = std::get<TResourceId>(_registerResource(name, nameHash, pResource, false, true));
+		}
+		else if (auto pResource = _getResourceInternal(resourceId))
 		{
-			return TPtr<IResource>(nullptr);
+			pResource->SetLastUsedTick(mCurrTick);
+			isLoaded = !isBeingLoaded && (E_RESOURCE_STATE_TYPE::RST_LOADED == pResource->GetState());
 		}
 
-		const U32 resourceId = static_cast<U32>(handle);
+		std::unique_lock<std::mutex> lock(mAsyncLoadingMutex);
 
-		if (resourceId >= mResources.GetSize())
+		U32 slotIndex = static_cast<U32>(mAsyncLoadingRequests.size());
+
+		if (mFreeAsyncLoadingRequestsSlots.empty())
 		{
-			return TPtr<IResource>(nullptr);
+			mAsyncLoadingRequests.emplace_back();
+		}
+		else
+		{
+			slotIndex = mFreeAsyncLoadingRequestsSlots.back();
+			mFreeAsyncLoadingRequestsSlots.pop_back();
 		}
 
-		return mResources[resourceId].GetOrDefault(TPtr<IResource>(nullptr));
+		TAsyncLoadingRequest& request = mAsyncLoadingRequests[slotIndex];
+		request.mName           = name;
+		request.mNameHash       = nameHash;
+		request.mResourceId     = resourceId;
+		request.mResourceTypeId = typeId;
+		request.mPriority       = params.mPriority;
+		request.mDependencies   = params.mDependencies;
+		request.mJobHandle      = {};
+		request.mpUploadFence   = nullptr;
+
+		const TResourceLoadingHandle handle { slotIndex, request.mGeneration, resourceId };
+
+		if (isLoaded)
+		{
+			_finishAsyncLoadingRequestInternal(request, E_RESOURCE_LOADING_STATUS::COMPLETED);
+			return handle;
+		}
+
+		request.mStatus = E_RESOURCE_LOADING_STATUS::WAITING_DEPENDENCIES;
+		mWaitingAsyncLoadingRequests.push_back(slotIndex);
+
+		const TAsyncLoadingSlotsArray startedRequests = _dispatchAsyncLoadingRequestsInternal();
+
+		lock.unlock();
+		_submitAsyncLoadingJobs(startedRequests);
+
+		return handle;
 	}
 
-	E_RESULT_CODE CResourceManager::ReleaseResource(const TResourceId& id)
+	E_RESOURCE_LOADING_STATUS CResourceManager::GetLoadingStatus(const TResourceLoadingHandle& handle) const
 	{
-		std::lock_guard<std::mutex> lock(mMutex);
-	
-		if (TResourceId::Invalid == id)
+		std::lock_guard<std::mutex> lock(mAsyncLoadingMutex);
+		return _getLoadingStatusInternal(handle);
+	}
+
+	E_RESOURCE_LOADING_STATUS CResourceManager::WaitForLoading(const TResourceLoadingHandle& handle)
+	{
+		const bool isMainThread = (std::this_thread::get_id() == mMainThreadId);
+
+		while (true)
 		{
-			return RC_INVALID_ARGS;
+			TJobHandle jobHandle;
+
+			{
+				std::lock_guard<std::mutex> lock(mAsyncLoadingMutex);
+
+				const E_RESOURCE_LOADING_STATUS status = _getLoadingStatusInternal(handle);
+				if (IsLoadingRequestFinished(status))
+				{
+					return status;
+				}
+
+				if (E_RESOURCE_LOADING_STATUS::LOADING == status)
+				{
+					jobHandle = mAsyncLoadingRequests[handle.mSlotIndex].mJobHandle;
+				}
+				else if (E_RESOURCE_LOADING_STATUS::UPLOADING != status)
+				{
+					/// \note The request waits for free workers or its dependencies, so help to finish any of started requests
+					auto it = std::find_if(mAsyncLoadingRequests.cbegin(), mAsyncLoadingRequests.cend(), [](const TAsyncLoadingRequest& currRequest)
+					{
+						return (E_RESOURCE_LOADING_STATUS::LOADING == currRequest.mStatus) && currRequest.mJobHandle.IsValid();
+					});
+
+					if (it != mAsyncLoadingRequests.cend())
+					{
+						jobHandle = it->mJobHandle;
+					}
+				}
+			}
+
+			if (jobHandle.IsValid())
+			{
+				mpJobManager->WaitForJob(jobHandle);
+				continue;
+			}
+
+			if (isMainThread)
+			{
+				mpJobManager->ProcessMainThreadQueue();
+				_updateAsyncLoadingRequests();
+				continue;
+			}
+
+			std::this_thread::yield();
 		}
+	}
 
-		E_RESULT_CODE result = RC_OK;
+	E_RESULT_CODE CResourceManager::CancelLoading(const TResourceLoadingHandle& handle)
+	{
+		std::unique_lock<std::mutex> lock(mAsyncLoadingMutex);
 
-		auto pResource = _getResourceInternal(id);
+		if (!handle.IsValid() || handle.mSlotIndex >= mAsyncLoadingRequests.size())
+		{
+			return RC_INVALID_ARGS;
+		}
 
-		if (!pResource /*|| (E_RESOURCE_STATE_TYPE::RST_DESTROYING != pResource->GetState())*/) /// \note A resource should be marked as DESTROYING to allow its deletion from the registry
+		TAsyncLoadingRequest& request = mAsyncLoadingRequests[handle.mSlotIndex];
+		if (request.mGeneration != handle.mGeneration)
 		{
 			return RC_FAIL;
 		}
 
-		result = result | mResources.ReplaceAt(static_cast<U32>(id), TPtr<IResource>(nullptr));
-		mResourcesMap.erase(mResourcesMap.find(pResource->GetName()));
+		switch (request.mStatus)
+		{
+			case E_RESOURCE_LOADING_STATUS::WAITING_DEPENDENCIES:
+			case E_RESOURCE_LOADING_STATUS::QUEUED:
+				/// \note Stale entries of the queue and the waiting list are skipped by the dispatch
+			{
+				_finishAsyncLoadingRequestInternal(request, E_RESOURCE_LOADING_STATUS::CANCELLED);
 
-		return result;
-	}
-	
-	const TPtr<IResourceLoader> CResourceManager::_getResourceLoader(TypeId resourceTypeId) const
-	{
-		auto resourceLoaderIdIter = mResourceLoadersMap.find(resourceTypeId);
+				const TAsyncLoadingSlotsArray startedRequests = _dispatchAsyncLoadingRequestsInternal();
 
-		if (resourceLoaderIdIter == mResourceLoadersMap.cend())
-		{
-			return TPtr<IResourceLoader>(nullptr);
+				lock.unlock();
+				_submitAsyncLoadingJobs(startedRequests);
+
+				return RC_OK;
+			}
+			default:
+				break;
 		}
 
-		return mRegisteredResourceLoaders[static_cast<U32>(resourceLoaderIdIter->second) - 1].GetOrDefault(TPtr<IResourceLoader>(nullptr));
+		return RC_FAIL;
 	}
 
-	const TPtr<IResourceFactory> CResourceManager::_getResourceFactory(TypeId resourceTypeId) const
+	E_RESULT_CODE CResourceManager::ExecuteAfterLoading(const TAsyncLoadingParams& params, const std::function<void()>& action)
 	{
-		auto factoryIdIter = mResourceFactoriesMap.find(resourceTypeId);
+		if (!mIsInitialized)
+		{
+			return RC_FAIL;
+		}
 
-		auto getFactoryInternal = [&factoryIdIter, this]() -> TPtr<IResourceFactory>
+		if (!action)
 		{
-			if (auto getFactoryResult = mRegisteredResourceFactories[static_cast<U32>((*factoryIdIter).second) - 1])
+			return RC_INVALID_ARGS;
+		}
+
+		if (std::this_thread::get_id() == mMainThreadId)
+		{
+			for (const TResourceLoadingHandle& currDependency : params.mDependencies)
 			{
-				return getFactoryResult.Get();
+				WaitForLoading(currDependency);
 			}
 
-			return TPtr<IResourceFactory>(nullptr);
-		};
+			action();
 
-		if (factoryIdIter == mResourceFactoriesMap.cend())
+			return RC_OK;
+		}
+
+		std::lock_guard<std::mutex> lock(mAsyncLoadingMutex);
+		mDeferredLoadingActions.push_back({ params.mDependencies, action });
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CResourceManager::_loadResourceOnce(const TResourceId& resourceId, const std::string& name, U32 nameHash)
+	{
+		auto&& pResource = _getResourceInternal(resourceId);
+		if (!pResource)
+		{
+			return RC_FAIL;
+		}
+
+		TResourcesMapShard& shard = mResourcesMapShards[_getResourcesMapShardIndex(nameHash)];
+
+		const std::thread::id currThreadId = std::this_thread::get_id();
+
+		/// \note Claim the resource, so concurrent callers wait for the load instead of running it twice
+		while (true)
 		{
-			/// \note We haven't found factory, try to find an alias type and its corresponding factory
-			for (auto&& currResourceAliasInfo : mResourceTypesAliases)
 			{
-				if (std::get<0>(currResourceAliasInfo) != resourceTypeId)
+				std::lock_guard<std::shared_timed_mutex> lock(shard.mMutex);
+
+				auto it = FindResourceEntry(shard.mResourcesMap, name, nameHash);
+				if ((it == shard.mResourcesMap.end()) || (it->second.mId != resourceId))
 				{
-					continue;
+					return RC_FAIL; /// \note The resource was released in the meantime
 				}
 
-				factoryIdIter = mResourceFactoriesMap.find(std::get<1>(currResourceAliasInfo));
-				if (factoryIdIter != mResourceFactoriesMap.cend())
+				std::thread::id& loadingThreadId = it->second.mLoadingThreadId;
+
+				if (currThreadId == loadingThreadId) /// \note A nested request from the resource's own Load, the outer call will finish the loading
 				{
-					return getFactoryInternal();
+					return RC_OK;
+				}
+
+				if (std::thread::id() == loadingThreadId)
+				{
+					if (E_RESOURCE_STATE_TYPE::RST_PENDING != pResource->GetState())
+					{
+						return RC_OK;
+					}
+
+					loadingThreadId = currThreadId;
+					break;
 				}
 			}
 
-			return TPtr<IResourceFactory>(nullptr);
+			std::this_thread::yield();
 		}
 
-		return getFactoryInternal();
+		return _loadClaimedResource(pResource, resourceId, name, nameHash);
 	}
 
-	std::vector<std::string> CResourceManager::_getResourcesListByType(TypeId resourceTypeId) const
+	E_RESULT_CODE CResourceManager::_loadClaimedResource(TPtr<IResource> pResource, const TResourceId& resourceId, const std::string& name, U32 nameHash)
 	{
-		std::vector<std::string> resourcesList;
+		TResourcesMapShard& shard = mResourcesMapShards[_getResourcesMapShardIndex(nameHash)];
+
+		const E_RESULT_CODE result = pResource->Load(); /// \note Load is executed in sequential manner, but internally it can create background tasks
 
-		for (U32 i = 0; i < mResources.GetSize(); ++i)
 		{
-			if (auto getResourceResult = mResources[i])
-			{
-				auto&& pResource = getResourceResult.Get();
+			std::lock_guard<std::shared_timed_mutex> lock(shard.mMutex);
 
-				if (pResource && (resourceTypeId == pResource->GetResourceTypeId()))
-				{
-					resourcesList.push_back(pResource->GetName());
-				}
+			auto it = FindResourceEntry(shard.mResourcesMap, name, nameHash);
+			if ((it != shard.mResourcesMap.end()) && (it->second.mId == resourceId))
+			{
+				it->second.mLoadingThreadId = std::thread::id();
 			}
 		}
 
-		return resourcesList;
+		return result;
+	}
+
+	void CResourceManager::_waitForDeferredUploading(const TPtr<IResource>& pResource)
+	{
+		if (!pResource || (std::this_thread::get_id() != mMainThreadId) || (E_RESOURCE_LOADING_POLICY::STREAMING == pResource->GetLoadingPolicy()))
+		{
+			return;
+		}
+
+		while (E_RESOURCE_STATE_TYPE::RST_LOADING == pResource->GetState())
+		{
+			mpJobManager->ProcessMainThreadQueue();
+			_updateAsyncLoadingRequests();
+
+			std::this_thread::yield();
+		}
+	}
+
+	TResourceId CResourceManager::_findResourceId(const std::string& name, U32 nameHash, bool* pIsBeingLoaded) const
+	{
+		const TResourcesMapShard& shard = mResourcesMapShards[_getResourcesMapShardIndex(nameHash)];
+
+		std::shared_lock<std::shared_timed_mutex> lock(shard.mMutex);
+
+		auto it = FindResourceEntry(shard.mResourcesMap, name, nameHash);
+		if (it == shard.mResourcesMap.cend())
+		{
+			return TResourceId::Invalid;
+		}
+
+		if (pIsBeingLoaded)
+		{
+			*pIsBeingLoaded = (std::thread::id() != it->second.mLoadingThreadId);
+		}
+
+		return it->second.mId;
+	}
+
+	std::tuple<TResourceId, bool> CResourceManager::_registerResource(const std::string& name, U32 nameHash, TPtr<IResource> pResource, bool claimLoading, bool isEvictable)
+	{
+		TResourcesMapShard& shard = mResourcesMapShards[_getResourcesMapShardIndex(nameHash)];
+
+		std::lock_guard<std::shared_timed_mutex> lock(shard.mMutex);
+
+		auto it = FindResourceEntry(shard.mResourcesMap, name, nameHash);
+		if (it != shard.mResourcesMap.end())
+		{
+			return { it->second.mId, false };
+		}
+
+		const TResourceId resourceId = TResourceId(mResources.Add(pResource));
+
+		TResourceEntry entry;
+		entry.mName = name;
+		entry.mId = resourceId;
+		entry.mLoadingThreadId = claimLoading ? std::this_thread::get_id() : std::thread::id();
+		entry.mIsEvictable = isEvictable;
+
+		shard.mResourcesMap.emplace(nameHash, std::move(entry));
+
+		return { resourceId, true };
+	}
+
+	TPtr<IResource> CResourceManager::_createResourceForLoading(TypeId resourceTypeId, TypeId factoryTypeId, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy)
+	{
+		TPtr<IResourceFactory> pResourceFactory = nullptr;
+		TBaseResourceParameters loadingParameters;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			pResourceFactory = _getResourceFactory(factoryTypeId);
+			if (!pResourceFactory)
+			{
+				return TPtr<IResource>(nullptr);
+			}
+
+			auto it = mResourceTypesPoliciesRegistry.find(resourceTypeId);
+			loadingParameters.mLoadingPolicy = (E_RESOURCE_LOADING_POLICY::DEFAULT != loadingPolicy) || (it == mResourceTypesPoliciesRegistry.cend()) ? loadingPolicy : it->second;
+		}
+
+		/// \note The resource is created without any lock held, because a factory could access the manager
+		return TPtr<IResource>(pResourceFactory->CreateDefault(name, loadingParameters));
+	}
+
+	TResourceId CResourceManager::_createResource(TypeId resourceTypeId, const std::string& name, const TBaseResourceParameters& params)
+	{
+		const U32 nameHash = ComputeHash(name.c_str());
+
+		TResourceId resourceId = _findResourceId(name, nameHash);
+
+		if (TResourceId::Invalid != resourceId)
+		{
+			return resourceId;
+		}
+
+		TPtr<IResourceFactory> pResourceFactory = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			auto factoryIdIter = mResourceFactoriesMap.find(resourceTypeId);
+			if (factoryIdIter == mResourceFactoriesMap.cend())
+			{
+				return TResourceId::Invalid;
+			}
+
+			pResourceFactory = mRegisteredResourceFactories[static_cast<U32>((*factoryIdIter).second) - 1].Get();
+		}
+		
+		/// \todo move it to a background thread
+		TPtr<IResource> pResource = TPtr<IResource>(pResourceFactory->Create(name, params));
+		
+		auto&& registrationResult = _registerResource(name, nameHash, pResource, false, false);
+
+		resourceId = std::get<TResourceId>(registrationResult);
+
+		if (std::get<bool>(registrationResult))
+		{
+			pResource->OnCreated(this);
+		}
+
+		return resourceId;
+	}
+
+	TPtr<IResource> CResourceManager::_getResourceInternal(const TResourceId& handle) const
+	{
+		if (handle == TResourceId::Invalid)
+		{
+			return TPtr<IResource>(nullptr);
+		}
+
+		const U32 resourceId = static_cast<U32>(handle);
+
+		if (resourceId >= mResources.GetSize())
+		{
+			return TPtr<IResource>(nullptr);
+		}
+
+		return mResources[resourceId].GetOrDefault(TPtr<IResource>(nullptr));
+	}
+
+	E_RESULT_CODE CResourceManager::ReleaseResource(const TResourceId& id)
+	{
+		if (TResourceId::Invalid == id)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		E_RESULT_CODE result = RC_OK;
+
+		auto pResource = _getResourceInternal(id);
+
+		if (!pResource /*|| (E_RESOURCE_STATE_TYPE::RST_DESTROYING != pResource->GetState())*/) /// \note A resource should be marked as DESTROYING to allow its deletion from the registry
+		{
+			return RC_FAIL;
+		}
+
+		const std::string& name = pResource->GetName();
+		const U32 nameHash = ComputeHash(name.c_str());
+
+		{
+			TResourcesMapShard& shard = mResourcesMapShards[_getResourcesMapShardIndex(nameHash)];
+
+			std::lock_guard<std::shared_timed_mutex> lock(shard.mMutex);
+
+			auto it = FindResourceEntry(shard.mResourcesMap, name, nameHash);
+			if ((it != shard.mResourcesMap.end()) && (it->second.mId == id))
+			{
+				shard.mResourcesMap.erase(it);
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mEvictionMutex);
+			mEvictedResources.erase(static_cast<U32>(id));
+		}
+
+		result = result | mResources.ReplaceAt(static_cast<U32>(id), TPtr<IResource>(nullptr));
+
+		return result;
+	}
+
+	E_RESULT_CODE CResourceManager::Update()
+	{
+		if (!mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		_reloadEvictedResources();
+		_updateAsyncLoadingRequests();
+
+		for (auto&& currTypeInfo : mMemoryInfo.mTypesInfo)
+		{
+			currTypeInfo.second.mLoadedCount = 0;
+			currTypeInfo.second.mMemorySize = 0;
+		}
+
+		USIZE usedSize = 0;
+
+		for (U32 i = 0; i < mResources.GetSize(); ++i)
+		{
+			TPtr<IResource> pResource = mResources[i].GetOrDefault(TPtr<IResource>(nullptr));
+			if (!pResource || (E_RESOURCE_STATE_TYPE::RST_LOADED != pResource->GetState()))
+			{
+				continue;
+			}
+
+			const USIZE size = pResource->GetMemorySize();
+			usedSize += size;
+
+			TResourceTypeMemoryInfo& typeInfo = mMemoryInfo.mTypesInfo[pResource->GetResourceTypeName()];
+			++typeInfo.mLoadedCount;
+			typeInfo.mMemorySize += size;
+		}
+
+		const USIZE budget = mMemoryBudget;
+
+		TEvictionCandidatesArray evictionCandidates;
+
+		/// \note Evicted resources could release references onto others (e.g. materials hold their textures), so candidates
+		/// are collected again until the budget is met or nothing is evicted
+		for (bool hasEvictedResources = true; budget && (usedSize > budget) && hasEvictedResources; )
+		{
+			hasEvictedResources = false;
+
+			_collectEvictionCandidates(evictionCandidates);
+
+			for (const TEvictionCandidate& currCandidate : evictionCandidates)
+			{
+				if (usedSize <= budget)
+				{
+					break;
+				}
+
+				TPtr<IResource> pResource = _getResourceInternal(currCandidate.mId);
+				if (!pResource)
+				{
+					continue;
+				}
+
+				const std::string typeName = pResource->GetResourceTypeName();
+				pResource = nullptr; /// \note Drop the handle, otherwise the resource is treated as a referenced one
+
+				if (RC_OK != _evictResource(currCandidate.mId))
+				{
+					continue;
+				}
+
+				usedSize -= currCandidate.mSize;
+				hasEvictedResources = true;
+
+				TResourceTypeMemoryInfo& typeInfo = mMemoryInfo.mTypesInfo[typeName];
+				--typeInfo.mLoadedCount;
+				typeInfo.mMemorySize -= currCandidate.mSize;
+				++typeInfo.mEvictionsCount;
+
+				++mMemoryInfo.mEvictionsCount;
+				mMemoryInfo.mEvictedSize += currCandidate.mSize;
+			}
+		}
+
+		mMemoryUsage = usedSize;
+
+		mMemoryInfo.mBudget = budget;
+		mMemoryInfo.mUsedSize = usedSize;
+
+		TDE2_UPDATE_RESOURCES_MEMORY_INFO(mMemoryInfo);
+
+		++mCurrTick;
+
+		return RC_OK;
+	}
+
+	void CResourceManager::SetMemoryBudget(USIZE budget)
+	{
+		mMemoryBudget = budget;
+	}
+
+	USIZE CResourceManager::GetMemoryBudget() const
+	{
+		return mMemoryBudget;
+	}
+
+	USIZE CResourceManager::GetMemoryUsage() const
+	{
+		return mMemoryUsage;
+	}
+
+	void CResourceManager::_collectEvictionCandidates(TEvictionCandidatesArray& candidates) const
+	{
+		candidates.clear();
+
+		const U32 currTick = mCurrTick;
+
+		for (U32 i = 0; i < mResources.GetSize(); ++i)
+		{
+			TPtr<IResource> pResource = mResources[i].GetOrDefault(TPtr<IResource>(nullptr));
+			if (!pResource || (E_RESOURCE_STATE_TYPE::RST_LOADED != pResource->GetState()))
+			{
+				continue;
+			}
+
+			const USIZE size = pResource->GetMemorySize();
+
+			/// \note Resources that were accessed during the current frame are never evicted
+			if (size && (pResource->GetLastUsedTick() < currTick) && (pResource->GetRefCount() <= UnreferencedResourceRefCount))
+			{
+				candidates.push_back({ TResourceId(i), pResource->GetLastUsedTick(), size });
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const TEvictionCandidate& left, const TEvictionCandidate& right)
+		{
+			return left.mLastUsedTick < right.mLastUsedTick;
+		});
+	}
+
+	E_RESULT_CODE CResourceManager::_evictResource(const TResourceId& resourceId)
+	{
+		TPtr<IResource> pResource = _getResourceInternal(resourceId);
+		if (!pResource || (pResource->GetRefCount() > UnreferencedResourceRefCount))
+		{
+			return RC_FAIL;
+		}
+
+		const std::string& name = pResource->GetName();
+		const U32 nameHash = ComputeHash(name.c_str());
+
+		TResourcesMapShard& shard = mResourcesMapShards[_getResourcesMapShardIndex(nameHash)];
+
+		/// \note Claim the resource the same way as loading does, so nobody starts to load it while it's being evicted
+		{
+			std::lock_guard<std::shared_timed_mutex> lock(shard.mMutex);
+
+			auto it = FindResourceEntry(shard.mResourcesMap, name, nameHash);
+			if ((it == shard.mResourcesMap.end()) || (it->second.mId != resourceId) || !it->second.mIsEvictable || 
+				(std::thread::id() != it->second.mLoadingThreadId) || (E_RESOURCE_STATE_TYPE::RST_LOADED != pResource->GetState()))
+			{
+				return RC_FAIL;
+			}
+
+			it->second.mLoadingThreadId = std::this_thread::get_id();
+		}
+
+		E_RESULT_CODE result = pResource->Evict();
+		if (RC_OK == result)
+		{
+			pResource->SetState(E_RESOURCE_STATE_TYPE::RST_PENDING);
+
+			std::lock_guard<std::mutex> lock(mEvictionMutex);
+			mEvictedResources.insert(static_cast<U32>(resourceId));
+		}
+
+		{
+			std::lock_guard<std::shared_timed_mutex> lock(shard.mMutex);
+
+			auto it = FindResourceEntry(shard.mResourcesMap, name, nameHash);
+			if ((it != shard.mResourcesMap.end()) && (it->second.mId == resourceId))
+			{
+				it->second.mLoadingThreadId = std::thread::id();
+			}
+		}
+
+		return result;
+	}
+
+	void CResourceManager::_requestEvictedResourceReload(const TResourceId& resourceId) const
+	{
+		std::lock_guard<std::mutex> lock(mEvictionMutex);
+
+		auto it = mEvictedResources.find(static_cast<U32>(resourceId));
+		if (it == mEvictedResources.end())
+		{
+			return; /// \note The resource wasn't loaded yet, it's not a business of the eviction policy
+		}
+
+		mEvictedResources.erase(it);
+		mReloadRequests.push_back(resourceId);
+	}
+
+	void CResourceManager::_reloadEvictedResources()
+	{
+		TResourcesIdsArray reloadRequests;
+
+		{
+			std::lock_guard<std::mutex> lock(mEvictionMutex);
+			std::swap(reloadRequests, mReloadRequests);
+		}
+
+		for (const TResourceId& currResourceId : reloadRequests)
+		{
+			TPtr<IResource> pResource = _getResourceInternal(currResourceId);
+			if (!pResource)
+			{
+				continue;
+			}
+
+			const std::string name = pResource->GetName();
+			pResource = nullptr;
+
+			_loadResourceOnce(currResourceId, name, ComputeHash(name.c_str()));
+		}
+	}
+	
+	void CResourceManager::_processAsyncLoadingRequest(U32 slotIndex, U32 generation)
+	{
+		std::string name;
+		U32 nameHash = 0;
+		TResourceId resourceId = TResourceId::Invalid;
+
+		{
+			std::lock_guard<std::mutex> lock(mAsyncLoadingMutex);
+
+			const TAsyncLoadingRequest& request = mAsyncLoadingRequests[slotIndex];
+			TDE2_ASSERT(request.mGeneration == generation && E_RESOURCE_LOADING_STATUS::LOADING == request.mStatus);
+
+			name = request.mName;
+			nameHash = request.mNameHash;
+			resourceId = request.mResourceId;
+		}
+
+		const E_RESULT_CODE result = _loadResourceOnce(resourceId, name, nameHash);
+
+		std::shared_ptr<std::atomic<bool>> pUploadFence = std::make_shared<std::atomic<bool>>(false);
+
+		if (RC_OK == result)
+		{
+			/// \note Main thread's actions are executed in FIFO order, so the fence is set after the loader's uploads of GPU data
+			mpJobManager->ExecuteInMainThread([pUploadFence] { *pUploadFence = true; });
+		}
+
+		std::unique_lock<std::mutex> lock(mAsyncLoadingMutex);
+
+		TAsyncLoadingRequest& request = mAsyncLoadingRequests[slotIndex];
+
+		if (RC_OK == result)
+		{
+			request.mStatus = E_RESOURCE_LOADING_STATUS::UPLOADING;
+			request.mpUploadFence = pUploadFence;
+		}
+		else
+		{
+			_finishAsyncLoadingRequestInternal(request, E_RESOURCE_LOADING_STATUS::FAILED);
+		}
+
+		--mActiveAsyncLoadingRequestsCount;
+
+		const TAsyncLoadingSlotsArray startedRequests = _dispatchAsyncLoadingRequestsInternal();
+
+		lock.unlock();
+		_submitAsyncLoadingJobs(startedRequests);
+	}
+
+	void CResourceManager::_updateAsyncLoadingRequests()
+	{
+		TAsyncLoadingSlotsArray mainThreadRequests;
+
+		{
+			std::lock_guard<std::mutex> lock(mAsyncLoadingMutex);
+			std::swap(mainThreadRequests, mMainThreadAsyncLoadingRequests);
+		}
+
+		for (auto&& currRequest : mainThreadRequests)
+		{
+			_processAsyncLoadingRequest(std::get<0>(currRequest), std::get<1>(currRequest));
+		}
+
+		TDeferredLoadingActionsArray readyActions;
+
+		{
+			std::lock_guard<std::mutex> lock(mAsyncLoadingMutex);
+
+			auto it = std::stable_partition(mDeferredLoadingActions.begin(), mDeferredLoadingActions.end(), [this](const TDeferredLoadingAction& currAction)
+			{
+				return std::any_of(currAction.mDependencies.cbegin(), currAction.mDependencies.cend(), [this](const TResourceLoadingHandle& currDependency)
+				{
+					return !IsLoadingRequestFinished(_getLoadingStatusInternal(currDependency));
+				});
+			});
+
+			std::move(it, mDeferredLoadingActions.end(), std::back_inserter(readyActions));
+			mDeferredLoadingActions.erase(it, mDeferredLoadingActions.end());
+		}
+
+		/// \note Actions are executed without the lock, because they usually load resources
+		for (auto&& currAction : readyActions)
+		{
+			currAction.mAction();
+		}
+
+		std::unique_lock<std::mutex> lock(mAsyncLoadingMutex);
+
+		for (U32 i = 0; i < static_cast<U32>(mAsyncLoadingRequests.size()); ++i)
+		{
+			TAsyncLoadingRequest& currRequest = mAsyncLoadingRequests[i];
+
+			switch (currRequest.mStatus)
+			{
+				case E_RESOURCE_LOADING_STATUS::UPLOADING:
+					if (currRequest.mpUploadFence && *currRequest.mpUploadFence)
+					{
+						auto pResource = _getResourceInternal(currRequest.mResourceId);
+						const E_RESOURCE_STATE_TYPE state = pResource ? pResource->GetState() : E_RESOURCE_STATE_TYPE::RST_PENDING;
+
+						/// \note Streamed resources stay in RST_LOADING state until their loaders finish
+						if (E_RESOURCE_STATE_TYPE::RST_LOADED == state)
+						{
+							_finishAsyncLoadingRequestInternal(currRequest, E_RESOURCE_LOADING_STATUS::COMPLETED);
+						}
+						else if (E_RESOURCE_STATE_TYPE::RST_LOADING != state)
+						{
+							_finishAsyncLoadingRequestInternal(currRequest, E_RESOURCE_LOADING_STATUS::FAILED);
+						}
+					}
+					break;
+
+				case E_RESOURCE_LOADING_STATUS::COMPLETED:
+				case E_RESOURCE_LOADING_STATUS::FAILED:
+				case E_RESOURCE_LOADING_STATUS::CANCELLED:
+					/// \note Statuses are kept at least for a frame, after that they're restored from states of resources
+					if (currRequest.mFinishedTick < mCurrTick)
+					{
+						++currRequest.mGeneration;
+
+						currRequest.mStatus = E_RESOURCE_LOADING_STATUS::INVALID;
+						currRequest.mName.clear();
+						currRequest.mDependencies.clear();
+						currRequest.mpUploadFence = nullptr;
+
+						mFreeAsyncLoadingRequestsSlots.push_back(i);
+					}
+					break;
+
+				default:
+					break;
+			}
+		}
+
+		const TAsyncLoadingSlotsArray startedRequests = _dispatchAsyncLoadingRequestsInternal();
+
+		lock.unlock();
+		_submitAsyncLoadingJobs(startedRequests);
+	}
+
+	CResourceManager::TAsyncLoadingSlotsArray CResourceManager::_dispatchAsyncLoadingRequestsInternal()
+	{
+		TAsyncLoadingSlotsArray startedRequests;
+
+		bool hasChanges = true;
+
+		/// \note A failed request fails all its dependents, so the list is traversed until nothing changes
+		while (hasChanges)
+		{
+			hasChanges = false;
+
+			for (auto it = mWaitingAsyncLoadingRequests.begin(); it != mWaitingAsyncLoadingRequests.end();)
+			{
+				TAsyncLoadingRequest& currRequest = mAsyncLoadingRequests[*it];
+
+				if (E_RESOURCE_LOADING_STATUS::WAITING_DEPENDENCIES != currRequest.mStatus) /// \note The request was cancelled
+				{
+					it = mWaitingAsyncLoadingRequests.erase(it);
+					continue;
+				}
+
+				bool isReady = true;
+				bool hasFailedDependency = false;
+
+				for (const TResourceLoadingHandle& currDependency : currRequest.mDependencies)
+				{
+					const E_RESOURCE_LOADING_STATUS dependencyStatus = _getLoadingStatusInternal(currDependency);
+					if (E_RESOURCE_LOADING_STATUS::COMPLETED == dependencyStatus)
+					{
+						continue;
+					}
+
+					isReady = false;
+
+					if (IsLoadingRequestFinished(dependencyStatus))
+					{
+						hasFailedDependency = true;
+						break;
+					}
+				}
+
+				if (hasFailedDependency)
+				{
+					_finishAsyncLoadingRequestInternal(currRequest, E_RESOURCE_LOADING_STATUS::FAILED);
+					it = mWaitingAsyncLoadingRequests.erase(it);
+
+					hasChanges = true;
+					continue;
+				}
+
+				if (!isReady)
+				{
+					++it;
+					continue;
+				}
+
+				currRequest.mStatus = E_RESOURCE_LOADING_STATUS::QUEUED;
+				mQueuedAsyncLoadingRequests.push({ currRequest.mPriority, mAsyncLoadingSequenceIndex++, *it, currRequest.mGeneration });
+
+				it = mWaitingAsyncLoadingRequests.erase(it);
+			}
+		}
+
+		while ((mActiveAsyncLoadingRequestsCount < mMaxActiveAsyncLoadingRequestsCount) && !mQueuedAsyncLoadingRequests.empty())
+		{
+			const TQueuedAsyncLoadingRequest queuedRequest = mQueuedAsyncLoadingRequests.top();
+			mQueuedAsyncLoadingRequests.pop();
+
+			TAsyncLoadingRequest& currRequest = mAsyncLoadingRequests[queuedRequest.mSlotIndex];
+			if ((currRequest.mGeneration != queuedRequest.mGeneration) || (E_RESOURCE_LOADING_STATUS::QUEUED != currRequest.mStatus))
+			{
+				continue;
+			}
+
+			currRequest.mStatus = E_RESOURCE_LOADING_STATUS::LOADING;
+			++mActiveAsyncLoadingRequestsCount;
+
+			TPtr<IResourceLoader> pResourceLoader = nullptr;
+
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				pResourceLoader = _getResourceLoader(currRequest.mResourceTypeId);
+			}
+
+			/// \note Such requests are executed within Update, because ExecuteInMainThread would run them at once under the lock
+			if (pResourceLoader && pResourceLoader->IsMainThreadRequired())
+			{
+				mMainThreadAsyncLoadingRequests.emplace_back(queuedRequest.mSlotIndex, queuedRequest.mGeneration);
+				continue;
+			}
+
+			startedRequests.emplace_back(queuedRequest.mSlotIndex, queuedRequest.mGeneration);
+		}
+
+		return startedRequests;
+	}
+
+	void CResourceManager::_submitAsyncLoadingJobs(const TAsyncLoadingSlotsArray& requests)
+	{
+		for (auto&& currRequest : requests)
+		{
+			const U32 slotIndex = std::get<0>(currRequest);
+			const U32 generation = std::get<1>(currRequest);
+
+			const TJobHandle jobHandle = mpJobManager->SubmitJob(nullptr, [this, slotIndex, generation] { _processAsyncLoadingRequest(slotIndex, generation); });
+
+			std::unique_lock<std::mutex> lock(mAsyncLoadingMutex);
+
+			TAsyncLoadingRequest& request = mAsyncLoadingRequests[slotIndex];
+
+			if (jobHandle.IsValid())
+			{
+				/// \note The job could be already finished, so the handle is stored only for the request which is still being loaded
+				if ((request.mGeneration == generation) && (E_RESOURCE_LOADING_STATUS::LOADING == request.mStatus))
+				{
+					request.mJobHandle = jobHandle;
+				}
+
+				continue;
+			}
+
+			_finishAsyncLoadingRequestInternal(request, E_RESOURCE_LOADING_STATUS::FAILED);
+			--mActiveAsyncLoadingRequestsCount;
+
+			const TAsyncLoadingSlotsArray startedRequests = _dispatchAsyncLoadingRequestsInternal();
+
+			lock.unlock();
+			_submitAsyncLoadingJobs(startedRequests);
+		}
+	}
+
+	E_RESOURCE_LOADING_STATUS CResourceManager::_getLoadingStatusInternal(const TResourceLoadingHandle& handle) const
+	{
+		if (!handle.IsValid())
+		{
+			return E_RESOURCE_LOADING_STATUS::INVALID;
+		}
+
+		if (handle.mSlotIndex < mAsyncLoadingRequests.size())
+		{
+			const TAsyncLoadingRequest& request = mAsyncLoadingRequests[handle.mSlotIndex];
+			if (request.mGeneration == handle.mGeneration)
+			{
+				return request.mStatus;
+			}
+		}
+
+		/// \note The request was recycled, so its status is restored from the resource's state
+		auto pResource = _getResourceInternal(handle.mResourceId);
+		return (pResource && (E_RESOURCE_STATE_TYPE::RST_LOADED == pResource->GetState())) ? E_RESOURCE_LOADING_STATUS::COMPLETED : E_RESOURCE_LOADING_STATUS::FAILED;
+	}
+
+	void CResourceManager::_finishAsyncLoadingRequestInternal(TAsyncLoadingRequest& request, E_RESOURCE_LOADING_STATUS status)
+	{
+		TDE2_ASSERT(IsLoadingRequestFinished(status));
+
+		request.mStatus = status;
+		request.mFinishedTick = mCurrTick;
+	}
+
+	const TPtr<IResourceLoader> CResourceManager::_getResourceLoader(TypeId resourceTypeId) const
+	{
+		auto resourceLoaderIdIter = mResourceLoadersMap.find(resourceTypeId);
+
+		if (resourceLoaderIdIter == mResourceLoadersMap.cend())
+		{
+			return TPtr<IResourceLoader>(nullptr);
+		}
+
+		return mRegisteredResourceLoaders[static_cast<U32>(resourceLoaderIdIter->second) - 1].GetOrDefault(TPtr<IResourceLoader>(nullptr));
+	}
+
+	const TPtr<IResourceFactory> CResourceManager::_getResourceFactory(TypeId resourceTypeId) const
+	{
+		auto factoryIdIter = mResourceFactoriesMap.find(resourceTypeId);
+
+		auto getFactoryInternal = [&factoryIdIter, this]() -> TPtr<IResourceFactory>
+		{
+			if (auto getFactoryResult = mRegisteredResourceFactories[static_cast<U32>((*factoryIdIter).second) - 1])
+			{
+				return getFactoryResult.Get();
+			}
+
+			return TPtr<IResourceFactory>(nullptr);
+		};
+
+		if (factoryIdIter == mResourceFactoriesMap.cend())
+		{
+			/// \note We haven't found factory, try to find an alias type and its corresponding factory
+			for (auto&& currResourceAliasInfo : mResourceTypesAliases)
+			{
+				if (std::get<0>(currResourceAliasInfo) != resourceTypeId)
+				{
+					continue;
+				}
+
+				factoryIdIter = mResourceFactoriesMap.find(std::get<1>(currResourceAliasInfo));
+				if (factoryIdIter != mResourceFactoriesMap.cend())
+				{
+					return getFactoryInternal();
+				}
+			}
+
+			return TPtr<IResourceFactory>(nullptr);
+		}
+
+		return getFactoryInternal();
+	}
+
+	std::vector<std::string> CResourceManager::_getResourcesListByType(TypeId resourceTypeId) const
+	{
+		std::vector<std::string> resourcesList;
+
+		for (U32 i = 0; i < mResources.GetSize(); ++i)
+		{
+			if (auto getResourceResult = mResources[i])
+			{
+				auto&& pResource = getResourceResult.Get();
+
+				if (pResource && (resourceTypeId == pResource->GetResourceTypeId()))
+				{
+					resourcesList.push_back(pResource->GetName());
+				}
+			}
+		}
+
+		return resourcesList;
+	}
+
+
+	U32 CResourceManager::_getResourcesMapShardIndex(U32 nameHash)
+	{
+		return (nameHash ^ (nameHash >> 16)) & (mResourcesMapShardsCount - 1);
 	}
 
 
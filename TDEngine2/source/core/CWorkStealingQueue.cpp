@@ -0,0 +1,85 @@
+#include "../../include/core/CWorkStealingQueue.h"
+
+
+namespace TDEngine2
+{
+	CWorkStealingQueue::CWorkStealingQueue(U32 capacity):
+		mpBuffer(new std::atomic<TValueType>[capacity]), mCapacity(capacity), mMask(capacity - 1), mTop(0), mBottom(0)
+	{
+		TDE2_ASSERT(capacity && !(capacity & (capacity - 1)));
+	}
+
+	bool CWorkStealingQueue::Push(TValueType value)
+	{
+		const I64 bottom = mBottom.load(std::memory_order_relaxed);
+		const I64 top    = mTop.load(std::memory_order_acquire);
+
+		if (bottom - top >= static_cast<I64>(mCapacity))
+		{
+			return false;
+		}
+
+		mpBuffer[static_cast<U32>(bottom) & mMask].store(value, std::memory_order_relaxed);
+
+		mBottom.store(bottom + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool CWorkStealingQueue::Pop(TValueType& value)
+	{
+		const I64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+		mBottom.store(bottom, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		I64 top = mTop.load(std::memory_order_relaxed);
+
+		if (top > bottom) /// \note The queue is empty
+		{
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		value = mpBuffer[static_cast<U32>(bottom) & mMask].load(std::memory_order_relaxed);
+
+		if (top != bottom)
+		{
+			return true;
+		}
+
+		/// \note The last value is left, so race with thieves for it
+		const bool result = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+		return result;
+	}
+
+	bool CWorkStealingQueue::Steal(TValueType& value)
+	{
+		I64 top = mTop.load(std::memory_order_acquire);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		const I64 bottom = mBottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+		{
+			return false;
+		}
+
+		value = mpBuffer[static_cast<U32>(top) & mMask].load(std::memory_order_relaxed);
+
+		return mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	bool CWorkStealingQueue::IsEmpty() const
+	{
+		return mBottom.load(std::memory_order_relaxed) <= mTop.load(std::memory_order_relaxed);
+	}
+
+	U32 CWorkStealingQueue::GetCapacity() const
+	{
+		return mCapacity;
+	}
+}
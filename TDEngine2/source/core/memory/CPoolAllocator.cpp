@@ -1,5 +1,7 @@
 #include "../../../include/core/memory/CPoolAllocator.h"
 #include "../../../include/editor/CMemoryProfiler.h"
+#include <algorithm>
+#include <mutex>
 
 
 namespace TDEngine2
@@ -12,7 +14,8 @@ namespace TDEngine2
 
 	CPoolAllocator::CPoolAllocator():
 		CBaseAllocator(), mObjectSize(0), mObjectAlignment(0),
-		mppNextFreeBlock(nullptr), mUsedMemorySize(0)
+		mppNextFreeBlock(nullptr), mUsedMemorySize(0), mObjectsCapacity(0), mPeakAllocationsCount(0),
+		mIsPoolInfoDirty(false)
 	{
 	}
 
@@ -42,7 +45,7 @@ namespace TDEngine2
 			auto pLastCreatedBlock = _getLastBlockEntity();
 			auto pNewBlock = _allocateNewBlock(pLastCreatedBlock);
 
-			_clearMemoryRegion(pNewBlock);
+			mObjectsCapacity += _clearMemoryRegion(pNewBlock);
 
 			/// \note Stitch both blocks together
 			*pLastCreatedBlock->mpLastAllowedPointer = pNewBlock->mpCurrPointer;
@@ -58,8 +61,12 @@ namespace TDEngine2
 
 		++mAllocationsCount;
 
+		mPeakAllocationsCount = std::max<U32>(mPeakAllocationsCount, mAllocationsCount);
+
 		TDE2_UPDATE_MEMORY_BLOCK_INFO(mName, mUsedMemorySize);
 
+		mIsPoolInfoDirty = true;
+
 		return pObjectPtr;
 	}
 
@@ -78,6 +85,8 @@ namespace TDEngine2
 
 		--mAllocationsCount;
 
+		mIsPoolInfoDirty = true;
+
 		return RC_OK;
 	}
 
@@ -85,9 +94,11 @@ namespace TDEngine2
 	{
 		TMemoryBlockEntity* pCurrBlockEntity = mpRootBlock.get();
 
+		mObjectsCapacity = 0;
+
 		while (pCurrBlockEntity)
 		{
-			_clearMemoryRegion(pCurrBlockEntity);
+			mObjectsCapacity += _clearMemoryRegion(pCurrBlockEntity);
 
 			pCurrBlockEntity = pCurrBlockEntity->mpNextBlock ? pCurrBlockEntity->mpNextBlock.get() : nullptr;
 		}
@@ -111,16 +122,52 @@ namespace TDEngine2
 
 		mppNextFreeBlock = reinterpret_cast<void**>(reinterpret_cast<U32Ptr>(mpRootBlock->mpRegion.get()) + static_cast<U32Ptr>(mObjectAlignment));
 		mUsedMemorySize = 0;
+		mPeakAllocationsCount = 0;
+
+		mIsPoolInfoDirty = true;
 
 		return RC_OK;
 	}
 
+#if TDE2_EDITORS_ENABLED
+
+	static std::vector<CPoolAllocator*> NamedPoolAllocators;
+	static std::mutex NamedPoolAllocatorsMutex;
+
+	void CPoolAllocator::SetBlockDebugName(const std::string& blockId)
+	{
+		CBaseAllocator::SetBlockDebugName(blockId);
+
+		std::lock_guard<std::mutex> lock(NamedPoolAllocatorsMutex);
+
+		if (std::find(NamedPoolAllocators.cbegin(), NamedPoolAllocators.cend(), this) == NamedPoolAllocators.cend())
+		{
+			NamedPoolAllocators.push_back(this);
+		}
+
+		mIsPoolInfoDirty = true;
+	}
+
+#endif
+
 	CPoolAllocator::TSizeType CPoolAllocator::GetUsedMemorySize() const
 	{
 		return mUsedMemorySize;
 	}
 
-	void CPoolAllocator::_clearMemoryRegion(TMemoryBlockEntity*& pRegion)
+	TPoolAllocatorInfo CPoolAllocator::GetPoolInfo() const
+	{
+		TPoolAllocatorInfo info;
+
+		info.mObjectSize       = mObjectSize;
+		info.mCapacity         = mObjectsCapacity;
+		info.mLiveObjectsCount = mAllocationsCount;
+		info.mPeakObjectsCount = mPeakAllocationsCount;
+
+		return info;
+	}
+
+	CPoolAllocator::TSizeType CPoolAllocator::_clearMemoryRegion(TMemoryBlockEntity*& pRegion)
 	{
 		void* pMemoryBlock = reinterpret_cast<void*>(pRegion->mpRegion.get());
 
@@ -130,7 +177,9 @@ namespace TDEngine2
 
 		pRegion->mpCurrPointer = pCurrBlock;
 
-		for (U32 i = 0; i < static_cast<U32>((mPageSize - padding) / mObjectSize) - 1; ++i)
+		const U32 objectsCount = static_cast<U32>((mPageSize - padding) / mObjectSize);
+
+		for (U32 i = 0; i < objectsCount - 1; ++i)
 		{
 			*pCurrBlock = reinterpret_cast<void*>(reinterpret_cast<U32Ptr>(pCurrBlock) + mObjectSize);
 			pCurrBlock = reinterpret_cast<void**>(*pCurrBlock);
@@ -140,6 +189,32 @@ namespace TDEngine2
 		pRegion->mUsedMemorySize = 0;
 
 		*pCurrBlock = nullptr;
+
+		return objectsCount;
+	}
+
+	E_RESULT_CODE CPoolAllocator::_onFreeInternal()
+	{
+#if TDE2_EDITORS_ENABLED
+		std::lock_guard<std::mutex> lock(NamedPoolAllocatorsMutex);
+		NamedPoolAllocators.erase(std::remove(NamedPoolAllocators.begin(), NamedPoolAllocators.end(), this), NamedPoolAllocators.end());
+#endif
+
+		return RC_OK;
+	}
+
+	void CPoolAllocator::_updatePoolInfo()
+	{
+#if TDE2_EDITORS_ENABLED
+		if (mName.empty() || !mIsPoolInfoDirty) /// \note Only named pools are tracked, e.g. pools of components' factories
+		{
+			return;
+		}
+
+		mIsPoolInfoDirty = false;
+
+		TDE2_UPDATE_POOL_ALLOCATOR_INFO(mName, GetPoolInfo());
+#endif
 	}
 
 
@@ -168,4 +243,16 @@ namespace TDEngine2
 	{
 		TypesPoolAllocators.clear();
 	}
+
+	void CPoolAllocatorsRegistry::UpdatePoolsInfo()
+	{
+#if TDE2_EDITORS_ENABLED
+		std::lock_guard<std::mutex> lock(NamedPoolAllocatorsMutex);
+
+		for (CPoolAllocator* pCurrPool : NamedPoolAllocators)
+		{
+			pCurrPool->_updatePoolInfo();
+		}
+#endif
+	}
 }
\ No newline at end of file
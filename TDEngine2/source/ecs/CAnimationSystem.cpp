@@ -6,6 +6,7 @@
 #include "../../include/core/IEventManager.h"
 #include "../../include/core/Meta.h"
 #include "../../include/graphics/animation/CAnimationContainerComponent.h"
+#include "../../include/graphics/animation/CMeshAnimatorComponent.h"
 #include "../../include/graphics/animation/CAnimationClip.h"
 #include "../../include/graphics/animation/IAnimationTrack.h"
 #include "../../include/graphics/animation/AnimationTracks.h"
@@ -21,6 +22,11 @@ namespace TDEngine2
 	CAnimationSystem::CAnimationSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CAnimationContainerComponent>();
+
+		/// \note Tracks are bound to properties of components, only CTransform and CMeshAnimatorComponent provide them
+		_addWriteAccess<CAnimationContainerComponent, CTransform, CMeshAnimatorComponent>();
+		_requireMainThread(); /// \note Clips are loaded and animation events are sent during the update
 	}
 
 	E_RESULT_CODE CAnimationSystem::Init(IResourceManager* pResourceManager, IEventManager* pEventManager)
@@ -0,0 +1,745 @@
+#include "../../include/ecs/CArchetypeStorage.h"
+#include "../../include/ecs/IComponent.h"
+#include <algorithm>
+
+
+namespace TDEngine2
+{
+	TDE2_STATIC_CONSTEXPR U32 BitsPerMaskWord = 64;
+
+
+	void TComponentsMask::Set(U32 bitIndex)
+	{
+		const U32 wordIndex = bitIndex / BitsPerMaskWord;
+
+		if (wordIndex >= mBits.size())
+		{
+			mBits.resize(wordIndex + 1, 0);
+		}
+
+		mBits[wordIndex] |= (1ull << (bitIndex % BitsPerMaskWord));
+	}
+
+	bool TComponentsMask::Test(U32 bitIndex) const
+	{
+		const U32 wordIndex = bitIndex / BitsPerMaskWord;
+		return (wordIndex < mBits.size()) && (mBits[wordIndex] & (1ull << (bitIndex % BitsPerMaskWord)));
+	}
+
+	bool TComponentsMask::ContainsAll(const TComponentsMask& mask) const
+	{
+		for (USIZE i = 0; i < mask.mBits.size(); ++i)
+		{
+			const U64 currWord = (i < mBits.size()) ? mBits[i] : 0;
+
+			if ((currWord & mask.mBits[i]) != mask.mBits[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool TComponentsMask::Intersects(const TComponentsMask& mask) const
+	{
+		const USIZE wordsCount = std::min<USIZE>(mBits.size(), mask.mBits.size());
+
+		for (USIZE i = 0; i < wordsCount; ++i)
+		{
+			if (mBits[i] & mask.mBits[i])
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool TComponentsMask::IsEmpty() const
+	{
+		return std::all_of(mBits.cbegin(), mBits.cend(), [](U64 word) { return !word; });
+	}
+
+	void TComponentsMask::Reset()
+	{
+		std::fill(mBits.begin(), mBits.end(), 0);
+	}
+
+
+	CArchetype::CArchetype(TArchetypeId id, const TComponentsSignature& signature, const TComponentsMask& mask, const std::vector<U32>& typesBitsIndices):
+		mId(id), mSignature(signature), mComponentsMask(mask), mColumns(signature.size())
+	{
+		TDE2_ASSERT(std::is_sorted(mSignature.cbegin(), mSignature.cend()));
+		TDE2_ASSERT(typesBitsIndices.size() == signature.size());
+
+		for (U32 i = 0; i < static_cast<U32>(typesBitsIndices.size()); ++i)
+		{
+			const U32 bitIndex = typesBitsIndices[i];
+
+			if (bitIndex >= mColumnsIndicesTable.size())
+			{
+				mColumnsIndicesTable.resize(bitIndex + 1, mInvalidColumnIndex);
+			}
+
+			mColumnsIndicesTable[bitIndex] = i;
+		}
+	}
+
+	U32 CArchetype::AddEntity(TEntityId entityId)
+	{
+		const U32 rowIndex = static_cast<U32>(mEntities.size());
+
+		mEntities.push_back(entityId);
+
+		for (TComponentsColumn& currColumn : mColumns)
+		{
+			currColumn.push_back(nullptr);
+		}
+
+		return rowIndex;
+	}
+
+	TEntityId CArchetype::RemoveEntity(U32 rowIndex)
+	{
+		if (rowIndex >= mEntities.size())
+		{
+			TDE2_ASSERT(false);
+			return TEntityId::Invalid;
+		}
+
+		const U32 lastRowIndex = static_cast<U32>(mEntities.size() - 1);
+
+		TEntityId movedEntityId = TEntityId::Invalid;
+
+		if (rowIndex != lastRowIndex) /// \note Move the last row into the removed one's place to keep columns contiguous
+		{
+			movedEntityId = mEntities[lastRowIndex];
+
+			mEntities[rowIndex] = movedEntityId;
+
+			for (TComponentsColumn& currColumn : mColumns)
+			{
+				currColumn[rowIndex] = currColumn[lastRowIndex];
+			}
+		}
+
+		mEntities.pop_back();
+
+		for (TComponentsColumn& currColumn : mColumns)
+		{
+			currColumn.pop_back();
+		}
+
+		return movedEntityId;
+	}
+
+	U32 CArchetype::GetColumnIndex(TypeId componentTypeId) const
+	{
+		auto it = std::lower_bound(mSignature.cbegin(), mSignature.cend(), componentTypeId);
+		if (it == mSignature.cend() || *it != componentTypeId)
+		{
+			return mInvalidColumnIndex;
+		}
+
+		return static_cast<U32>(std::distance(mSignature.cbegin(), it));
+	}
+
+	U32 CArchetype::GetColumnIndexByTypeBit(U32 typeBitIndex) const
+	{
+		return (typeBitIndex < mColumnsIndicesTable.size()) ? mColumnsIndicesTable[typeBitIndex] : mInvalidColumnIndex;
+	}
+
+	bool CArchetype::HasComponentType(TypeId componentTypeId) const
+	{
+		return std::binary_search(mSignature.cbegin(), mSignature.cend(), componentTypeId);
+	}
+
+	bool CArchetype::HasAllComponentTypes(const std::vector<TypeId>& types) const
+	{
+		for (TypeId currType : types)
+		{
+			if (!HasComponentType(currType))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool CArchetype::HasAnyComponentTypes(const std::vector<TypeId>& types) const
+	{
+		for (TypeId currType : types)
+		{
+			if (HasComponentType(currType))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool CArchetype::MatchesMask(const TComponentsMask& allOfMask, const TComponentsMask& anyOfMask) const
+	{
+		return mComponentsMask.ContainsAll(allOfMask) && (anyOfMask.IsEmpty() || mComponentsMask.Intersects(anyOfMask));
+	}
+
+	void CArchetype::SetAddEdge(TypeId componentTypeId, TArchetypeId archetypeId)
+	{
+		mAddEdges[componentTypeId] = archetypeId;
+	}
+
+	void CArchetype::SetRemoveEdge(TypeId componentTypeId, TArchetypeId archetypeId)
+	{
+		mRemoveEdges[componentTypeId] = archetypeId;
+	}
+
+	TArchetypeId CArchetype::GetAddEdge(TypeId componentTypeId) const
+	{
+		auto it = mAddEdges.find(componentTypeId);
+		return (it == mAddEdges.cend()) ? TArchetypeId::Invalid : it->second;
+	}
+
+	TArchetypeId CArchetype::GetRemoveEdge(TypeId componentTypeId) const
+	{
+		auto it = mRemoveEdges.find(componentTypeId);
+		return (it == mRemoveEdges.cend()) ? TArchetypeId::Invalid : it->second;
+	}
+
+	CArchetype::TComponentsColumn& CArchetype::GetColumn(U32 columnIndex)
+	{
+		TDE2_ASSERT(columnIndex < mColumns.size());
+		return mColumns[columnIndex];
+	}
+
+	const CArchetype::TComponentsColumn& CArchetype::GetColumn(U32 columnIndex) const
+	{
+		TDE2_ASSERT(columnIndex < mColumns.size());
+		return mColumns[columnIndex];
+	}
+
+	const CArchetype::TEntitiesArray& CArchetype::GetEntities() const
+	{
+		return mEntities;
+	}
+
+	const CArchetype::TComponentsSignature& CArchetype::GetSignature() const
+	{
+		return mSignature;
+	}
+
+	const TComponentsMask& CArchetype::GetComponentsMask() const
+	{
+		return mComponentsMask;
+	}
+
+	TArchetypeId CArchetype::GetId() const
+	{
+		return mId;
+	}
+
+	USIZE CArchetype::GetEntitiesCount() const
+	{
+		return mEntities.size();
+	}
+
+
+	E_RESULT_CODE CArchetypeStorage::AddComponent(TEntityId entityId, TypeId componentTypeId, IComponent* pComponent)
+	{
+		if (TEntityId::Invalid == entityId || TypeId::Invalid == componentTypeId || !pComponent)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		if (HasComponent(entityId, componentTypeId))
+		{
+			return RC_FAIL;
+		}
+
+		const U32 entityIndex = GetEntityIndex(entityId);
+
+		if (entityIndex >= mEntitiesRecords.size())
+		{
+			mEntitiesRecords.resize(entityIndex + 1);
+		}
+
+		if (TArchetypeId::Invalid != mEntitiesRecords[entityIndex].mArchetypeId && !GetEntityRecord(entityId))
+		{
+			return RC_INVALID_ARGS; /// \note The slot is occupied with another generation of the entity
+		}
+
+		const TArchetypeId destArchetypeId = _getArchetypeWithComponent(mEntitiesRecords[entityIndex].mArchetypeId, componentTypeId);
+		_moveEntity(entityId, destArchetypeId);
+
+		const TEntityRecord& entityRecord = mEntitiesRecords[entityIndex];
+
+		CArchetype& destArchetype = *mArchetypes[static_cast<U32>(destArchetypeId)];
+		destArchetype.GetColumn(destArchetype.GetColumnIndex(componentTypeId))[entityRecord.mRowIndex] = pComponent;
+
+		return RC_OK;
+	}
+
+	IComponent* CArchetypeStorage::RemoveComponent(TEntityId entityId, TypeId componentTypeId)
+	{
+		const TEntityRecord* pEntityRecord = GetEntityRecord(entityId);
+		if (!pEntityRecord)
+		{
+			return nullptr;
+		}
+
+		const TArchetypeId sourceArchetypeId = pEntityRecord->mArchetypeId;
+		const CArchetype& sourceArchetype = *mArchetypes[static_cast<U32>(sourceArchetypeId)];
+
+		const U32 columnIndex = sourceArchetype.GetColumnIndex(componentTypeId);
+		if (CArchetype::mInvalidColumnIndex == columnIndex)
+		{
+			return nullptr;
+		}
+
+		IComponent* pComponent = sourceArchetype.GetColumn(columnIndex)[pEntityRecord->mRowIndex];
+
+		_moveEntity(entityId, _getArchetypeWithoutComponent(sourceArchetypeId, componentTypeId));
+
+		return pComponent;
+	}
+
+	E_RESULT_CODE CArchetypeStorage::RemoveEntity(TEntityId entityId, const TComponentAction& action)
+	{
+		const TEntityRecord* pEntityRecord = GetEntityRecord(entityId);
+		if (!pEntityRecord)
+		{
+			return RC_FAIL;
+		}
+
+		const CArchetype& archetype = *mArchetypes[static_cast<U32>(pEntityRecord->mArchetypeId)];
+
+		if (action)
+		{
+			auto&& signature = archetype.GetSignature();
+
+			for (U32 i = 0; i < static_cast<U32>(signature.size()); ++i)
+			{
+				action(signature[i], archetype.GetColumn(i)[pEntityRecord->mRowIndex]);
+			}
+		}
+
+		_moveEntity(entityId, TArchetypeId::Invalid);
+
+		return RC_OK;
+	}
+
+	IComponent* CArchetypeStorage::GetComponent(TEntityId entityId, TypeId componentTypeId) const
+	{
+		const TEntityRecord* pEntityRecord = GetEntityRecord(entityId);
+		if (!pEntityRecord)
+		{
+			return nullptr;
+		}
+
+		const CArchetype& archetype = *mArchetypes[static_cast<U32>(pEntityRecord->mArchetypeId)];
+
+		const U32 columnIndex = archetype.GetColumnIndexByTypeBit(_getComponentTypeBitIndex(componentTypeId));
+		if (CArchetype::mInvalidColumnIndex == columnIndex)
+		{
+			return nullptr;
+		}
+
+		return archetype.GetColumn(columnIndex)[pEntityRecord->mRowIndex];
+	}
+
+	bool CArchetypeStorage::HasComponent(TEntityId entityId, TypeId componentTypeId) const
+	{
+		const TEntityRecord* pEntityRecord = GetEntityRecord(entityId);
+		if (!pEntityRecord)
+		{
+			return false;
+		}
+
+		const U32 bitIndex = _getComponentTypeBitIndex(componentTypeId);
+		return (mInvalidBitIndex != bitIndex) && mArchetypes[static_cast<U32>(pEntityRecord->mArchetypeId)]->GetComponentsMask().Test(bitIndex);
+	}
+
+	std::vector<IComponent*> CArchetypeStorage::GetComponents(TEntityId entityId) const
+	{
+		std::vector<IComponent*> components;
+
+		const TEntityRecord* pEntityRecord = GetEntityRecord(entityId);
+		if (!pEntityRecord)
+		{
+			return components;
+		}
+
+		const CArchetype& archetype = *mArchetypes[static_cast<U32>(pEntityRecord->mArchetypeId)];
+
+		const U32 columnsCount = static_cast<U32>(archetype.GetSignature().size());
+		components.reserve(columnsCount);
+
+		for (U32 i = 0; i < columnsCount; ++i)
+		{
+			components.push_back(archetype.GetColumn(i)[pEntityRecord->mRowIndex]);
+		}
+
+		return components;
+	}
+
+	void CArchetypeStorage::FindEntitiesWithAll(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities) const
+	{
+		if (types.empty())
+		{
+			for (auto&& pCurrArchetype : mArchetypes)
+			{
+				auto&& entities = pCurrArchetype->GetEntities();
+				outEntities.insert(outEntities.end(), entities.begin(), entities.end());
+			}
+
+			return;
+		}
+
+		/// \note The query's mask is reused between calls of a thread, so no allocations happen after the first one
+		static thread_local TComponentsMask queryMask;
+		queryMask.Reset();
+
+		/// \note Pick the smallest set of archetypes, all others are supersets of the result
+		const std::vector<TArchetypeId>* pSmallestArchetypesSet = nullptr;
+
+		for (TypeId currType : types)
+		{
+			const U32 bitIndex = _getComponentTypeBitIndex(currType);
+			if (mInvalidBitIndex == bitIndex)
+			{
+				return;
+			}
+
+			const std::vector<TArchetypeId>* pArchetypesSet = &mArchetypesPerType[bitIndex];
+			if (pArchetypesSet->empty())
+			{
+				return;
+			}
+
+			queryMask.Set(bitIndex);
+
+			if (!pSmallestArchetypesSet || pArchetypesSet->size() < pSmallestArchetypesSet->size())
+			{
+				pSmallestArchetypesSet = pArchetypesSet;
+			}
+		}
+
+		for (TArchetypeId currArchetypeId : *pSmallestArchetypesSet)
+		{
+			const CArchetype& archetype = *mArchetypes[static_cast<U32>(currArchetypeId)];
+			if (!archetype.GetEntitiesCount() || !archetype.MatchesMask(queryMask, {}))
+			{
+				continue;
+			}
+
+			auto&& entities = archetype.GetEntities();
+			outEntities.insert(outEntities.end(), entities.begin(), entities.end());
+		}
+	}
+
+	void CArchetypeStorage::FindEntitiesWithAny(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities) const
+	{
+		/// \note The mask contains types which were already visited, it's reused between calls of a thread
+		static thread_local TComponentsMask visitedTypesMask;
+		visitedTypesMask.Reset();
+
+		for (USIZE i = 0; i < types.size(); ++i)
+		{
+			const U32 bitIndex = _getComponentTypeBitIndex(types[i]);
+			if (mInvalidBitIndex == bitIndex)
+			{
+				continue;
+			}
+
+			const std::vector<TArchetypeId>* pArchetypesSet = &mArchetypesPerType[bitIndex];
+
+			for (TArchetypeId currArchetypeId : *pArchetypesSet)
+			{
+				const CArchetype& archetype = *mArchetypes[static_cast<U32>(currArchetypeId)];
+				if (!archetype.GetEntitiesCount())
+				{
+					continue;
+				}
+
+				/// \note Skip archetypes which were already visited with one of previous types
+				if (archetype.GetComponentsMask().Intersects(visitedTypesMask))
+				{
+					continue;
+				}
+
+				auto&& entities = archetype.GetEntities();
+				outEntities.insert(outEntities.end(), entities.begin(), entities.end());
+			}
+
+			visitedTypesMask.Set(bitIndex);
+		}
+	}
+
+	TComponentsMask CArchetypeStorage::CreateComponentsMask(const std::vector<TypeId>& types)
+	{
+		TComponentsMask mask;
+
+		for (TypeId currType : types)
+		{
+			mask.Set(_getOrCreateComponentTypeBitIndex(currType));
+		}
+
+		return mask;
+	}
+
+	void CArchetypeStorage::ForEachComponent(const TComponentAction& action) const
+	{
+		if (!action)
+		{
+			return;
+		}
+
+		for (auto&& pCurrArchetype : mArchetypes)
+		{
+			auto&& signature = pCurrArchetype->GetSignature();
+
+			for (U32 i = 0; i < static_cast<U32>(signature.size()); ++i)
+			{
+				for (IComponent* pCurrComponent : pCurrArchetype->GetColumn(i))
+				{
+					action(signature[i], pCurrComponent);
+				}
+			}
+		}
+	}
+
+	void CArchetypeStorage::Clear()
+	{
+		mArchetypes.clear();
+		mArchetypesTable.clear();
+		mEntitiesRecords.clear();
+
+		/// \note Bits of types are kept to leave masks that were created before valid
+		for (auto&& currArchetypesSet : mArchetypesPerType)
+		{
+			currArchetypesSet.clear();
+		}
+	}
+
+	const CArchetypeStorage::TArchetypesArray& CArchetypeStorage::GetArchetypes() const
+	{
+		return mArchetypes;
+	}
+
+	const CArchetype* CArchetypeStorage::GetArchetype(TArchetypeId archetypeId) const
+	{
+		const U32 archetypeIndex = static_cast<U32>(archetypeId);
+		return (archetypeIndex < mArchetypes.size()) ? mArchetypes[archetypeIndex].get() : nullptr;
+	}
+
+	const CArchetypeStorage::TEntityRecord* CArchetypeStorage::GetEntityRecord(TEntityId entityId) const
+	{
+		const U32 entityIndex = GetEntityIndex(entityId);
+
+		if (TEntityId::Invalid == entityId || entityIndex >= mEntitiesRecords.size())
+		{
+			return nullptr;
+		}
+
+		/// \note The slot could be recycled by another entity, so a stale identifier shouldn't access its components
+		const TEntityRecord& entityRecord = mEntitiesRecords[entityIndex];
+		return (TArchetypeId::Invalid == entityRecord.mArchetypeId || entityRecord.mEntityId != entityId) ? nullptr : &entityRecord;
+	}
+
+	TArchetypeId CArchetypeStorage::_findOrCreateArchetype(const CArchetype::TComponentsSignature& signature)
+	{
+		auto it = mArchetypesTable.find(signature);
+		if (it != mArchetypesTable.cend())
+		{
+			return it->second;
+		}
+
+		const TArchetypeId archetypeId = TArchetypeId(static_cast<U32>(mArchetypes.size()));
+
+		TComponentsMask mask;
+		std::vector<U32> typesBitsIndices;
+
+		for (TypeId currType : signature)
+		{
+			const U32 bitIndex = _getOrCreateComponentTypeBitIndex(currType);
+
+			mask.Set(bitIndex);
+			typesBitsIndices.push_back(bitIndex);
+
+			mArchetypesPerType[bitIndex].push_back(archetypeId);
+		}
+
+		mArchetypes.emplace_back(std::make_unique<CArchetype>(archetypeId, signature, mask, typesBitsIndices));
+		mArchetypesTable.emplace(signature, archetypeId);
+
+		return archetypeId;
+	}
+
+	TArchetypeId CArchetypeStorage::_getArchetypeWithComponent(TArchetypeId archetypeId, TypeId componentTypeId)
+	{
+		if (TArchetypeId::Invalid == archetypeId)
+		{
+			return _findOrCreateArchetype({ componentTypeId });
+		}
+
+		const TArchetypeId cachedArchetypeId = mArchetypes[static_cast<U32>(archetypeId)]->GetAddEdge(componentTypeId);
+		if (TArchetypeId::Invalid != cachedArchetypeId)
+		{
+			return cachedArchetypeId;
+		}
+
+		CArchetype::TComponentsSignature signature = mArchetypes[static_cast<U32>(archetypeId)]->GetSignature();
+		signature.insert(std::upper_bound(signature.begin(), signature.end(), componentTypeId), componentTypeId);
+
+		/// \note The array of archetypes could be reallocated here, so don't hold any references to its elements
+		const TArchetypeId destArchetypeId = _findOrCreateArchetype(signature);
+
+		mArchetypes[static_cast<U32>(archetypeId)]->SetAddEdge(componentTypeId, destArchetypeId);
+		mArchetypes[static_cast<U32>(destArchetypeId)]->SetRemoveEdge(componentTypeId, archetypeId);
+
+		return destArchetypeId;
+	}
+
+	TArchetypeId CArchetypeStorage::_getArchetypeWithoutComponent(TArchetypeId archetypeId, TypeId componentTypeId)
+	{
+		TDE2_ASSERT(TArchetypeId::Invalid != archetypeId);
+
+		const TArchetypeId cachedArchetypeId = mArchetypes[static_cast<U32>(archetypeId)]->GetRemoveEdge(componentTypeId);
+		if (TArchetypeId::Invalid != cachedArchetypeId)
+		{
+			return cachedArchetypeId;
+		}
+
+		CArchetype::TComponentsSignature signature = mArchetypes[static_cast<U32>(archetypeId)]->GetSignature();
+		signature.erase(std::remove(signature.begin(), signature.end(), componentTypeId), signature.end());
+
+		if (signature.empty()) /// \note Entities without components don't belong to any archetype
+		{
+			return TArchetypeId::Invalid;
+		}
+
+		const TArchetypeId destArchetypeId = _findOrCreateArchetype(signature);
+
+		mArchetypes[static_cast<U32>(archetypeId)]->SetRemoveEdge(componentTypeId, destArchetypeId);
+		mArchetypes[static_cast<U32>(destArchetypeId)]->SetAddEdge(componentTypeId, archetypeId);
+
+		return destArchetypeId;
+	}
+
+	void CArchetypeStorage::_moveEntity(TEntityId entityId, TArchetypeId destArchetypeId)
+	{
+		TEntityRecord& entityRecord = mEntitiesRecords[GetEntityIndex(entityId)];
+
+		if (entityRecord.mArchetypeId == destArchetypeId)
+		{
+			return;
+		}
+
+		CArchetype* pDestArchetype = (TArchetypeId::Invalid == destArchetypeId) ? nullptr : mArchetypes[static_cast<U32>(destArchetypeId)].get();
+		const U32 destRowIndex = pDestArchetype ? pDestArchetype->AddEntity(entityId) : 0;
+
+		if (TArchetypeId::Invalid != entityRecord.mArchetypeId)
+		{
+			CArchetype& sourceArchetype = *mArchetypes[static_cast<U32>(entityRecord.mArchetypeId)];
+
+			/// \note Copy all components that both archetypes share
+			if (pDestArchetype)
+			{
+				auto&& sourceSignature = sourceArchetype.GetSignature();
+
+				for (U32 i = 0; i < static_cast<U32>(sourceSignature.size()); ++i)
+				{
+					const U32 destColumnIndex = pDestArchetype->GetColumnIndex(sourceSignature[i]);
+					if (CArchetype::mInvalidColumnIndex == destColumnIndex)
+					{
+						continue;
+					}
+
+					pDestArchetype->GetColumn(destColumnIndex)[destRowIndex] = sourceArchetype.GetColumn(i)[entityRecord.mRowIndex];
+				}
+			}
+
+			const TEntityId movedEntityId = sourceArchetype.RemoveEntity(entityRecord.mRowIndex);
+			if (TEntityId::Invalid != movedEntityId)
+			{
+				mEntitiesRecords[GetEntityIndex(movedEntityId)].mRowIndex = entityRecord.mRowIndex;
+			}
+		}
+
+		entityRecord.mArchetypeId = destArchetypeId;
+		entityRecord.mRowIndex    = destRowIndex;
+		entityRecord.mEntityId    = entityId;
+	}
+
+	U32 CArchetypeStorage::_getOrCreateComponentTypeBitIndex(TypeId componentTypeId)
+	{
+		const U32 existingBitIndex = _getComponentTypeBitIndex(componentTypeId);
+		if (mInvalidBitIndex != existingBitIndex)
+		{
+			return existingBitIndex;
+		}
+
+		const U32 bitIndex = static_cast<U32>(mArchetypesPerType.size());
+
+		/// \note Keep the load factor under 0.5, so probing sequences stay short and always reach an empty entry
+		if (2 * (bitIndex + 1) > static_cast<U32>(mComponentTypesBitsTable.size()))
+		{
+			TComponentTypesBitsTable prevTable = std::move(mComponentTypesBitsTable);
+			mComponentTypesBitsTable.assign(std::max<USIZE>(16, 2 * prevTable.size()), {});
+
+			for (const TComponentTypeBitEntry& currEntry : prevTable)
+			{
+				if (TypeId::Invalid != currEntry.mTypeId)
+				{
+					_insertComponentTypeBitIndex(currEntry.mTypeId, currEntry.mBitIndex);
+				}
+			}
+		}
+
+		_insertComponentTypeBitIndex(componentTypeId, bitIndex);
+		mArchetypesPerType.emplace_back();
+
+		return bitIndex;
+	}
+
+	U32 CArchetypeStorage::_getComponentTypeBitIndex(TypeId componentTypeId) const
+	{
+		if (mComponentTypesBitsTable.empty() || TypeId::Invalid == componentTypeId)
+		{
+			return mInvalidBitIndex;
+		}
+
+		const U32 mask = static_cast<U32>(mComponentTypesBitsTable.size()) - 1;
+
+		for (U32 i = static_cast<U32>(componentTypeId) & mask; ; i = (i + 1) & mask)
+		{
+			const TComponentTypeBitEntry& currEntry = mComponentTypesBitsTable[i];
+
+			if (currEntry.mTypeId == componentTypeId)
+			{
+				return currEntry.mBitIndex;
+			}
+
+			if (TypeId::Invalid == currEntry.mTypeId)
+			{
+				return mInvalidBitIndex;
+			}
+		}
+	}
+
+	void CArchetypeStorage::_insertComponentTypeBitIndex(TypeId componentTypeId, U32 bitIndex)
+	{
+		const U32 mask = static_cast<U32>(mComponentTypesBitsTable.size()) - 1;
+
+		U32 i = static_cast<U32>(componentTypeId) & mask;
+
+		while (TypeId::Invalid != mComponentTypesBitsTable[i].mTypeId)
+		{
+			i = (i + 1) & mask;
+		}
+
+		mComponentTypesBitsTable[i] = { componentTypeId, bitIndex };
+	}
+}
\ No newline at end of file
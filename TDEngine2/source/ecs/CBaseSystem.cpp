@@ -1,4 +1,5 @@
 #include "../../include/ecs/CBaseSystem.h"
+#include <algorithm>
 
 
 namespace TDEngine2
@@ -25,4 +26,35 @@ namespace TDEngine2
 	{
 		return mIsActive;
 	}
+
+	const std::vector<TComponentsFilter>& CBaseSystem::GetComponentsFilters() const
+	{
+		return mComponentsFilters;
+	}
+
+	const TComponentsAccessInfo& CBaseSystem::GetComponentsAccessInfo() const
+	{
+		return mComponentsAccessInfo;
+	}
+
+	void CBaseSystem::_requireMainThread()
+	{
+		mComponentsAccessInfo.mIsMainThreadRequired = true;
+	}
+
+	void CBaseSystem::_addComponentsAccess(std::vector<TypeId>& accessTypes, const std::vector<TypeId>& types)
+	{
+		for (TypeId currType : types)
+		{
+			auto it = std::lower_bound(accessTypes.begin(), accessTypes.end(), currType);
+			if (it != accessTypes.end() && *it == currType)
+			{
+				continue;
+			}
+
+			accessTypes.insert(it, currType);
+		}
+
+		mComponentsAccessInfo.mIsDeclared = true;
+	}
 }
\ No newline at end of file
@@ -26,6 +26,15 @@ namespace TDEngine2
 	CBoundsUpdatingSystem::CBoundsUpdatingSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CSceneInfoComponent>();
+		_addComponentsFilter<CStaticMeshContainer, CTransform>();
+		_addComponentsFilter<CSkinnedMeshContainer, CTransform>();
+		_addComponentsFilter<CQuadSprite, CTransform>();
+		_addComponentsFilter<CBoundsComponent>();
+
+		_addReadAccess<CTransform, CStaticMeshContainer, CSkinnedMeshContainer, CQuadSprite>();
+		_addWriteAccess<CBoundsComponent>();
+		_requireMainThread(); /// \note Meshes are loaded and bounds are drawn with the debug utility
 	}
 
 	E_RESULT_CODE CBoundsUpdatingSystem::Init(IResourceManager* pResourceManager, IDebugUtility* pDebugUtility, ISceneManager* pSceneManager)
@@ -56,6 +65,7 @@ namespace TDEngine2
 		context.mpBounds.clear();
 		context.mpElements.clear();
 		context.mpTransforms.clear();
+		context.mpResources.clear();
 
 		for (TEntityId id : pWorld->FindEntitiesWithComponents<TComponentType>())
 		{
@@ -84,135 +94,178 @@ namespace TDEngine2
 	}
 
 
-	static void ComputeStaticMeshBounds(IResourceManager* pResourceManager, CBoundsUpdatingSystem::TStaticMeshesBoundsContext& staticMeshesContext, USIZE id)
+	/*!
+		\brief The function resolves meshes of elements with dirty bounds. It's invoked on the main thread, because
+		a synchronous loading of a resource could touch the graphics context. Meshes that aren't loaded yet are left nullptr
+	*/
+
+	template <typename TMeshType, typename T>
+	static void ResolveMeshesResources(IResourceManager* pResourceManager, T& meshesContext)
 	{
-		TDE2_PROFILER_SCOPE("ComputeStaticMeshBounds");
+		TDE2_PROFILER_SCOPE("CBoundsUpdatingSystem::ResolveMeshesResources");
 
-		CBoundsComponent* pBounds = staticMeshesContext.mpBounds[id];
+		auto& resources = meshesContext.mpResources;
+		resources.assign(meshesContext.mpElements.size(), nullptr);
 
-		if (CStaticMeshContainer* pStaticMeshContainer = staticMeshesContext.mpElements[id])
+		for (USIZE i = 0; i < resources.size(); ++i)
 		{
-			const TResourceId meshId = pResourceManager->Load<IStaticMesh>(pStaticMeshContainer->GetMeshName());
+			CBoundsComponent* pBounds = meshesContext.mpBounds[i];
+			auto pMeshContainer = meshesContext.mpElements[i];
 
-			/// \note Skip meshes that's not been loaded yet
-			if (E_RESOURCE_STATE_TYPE::RST_LOADED != pResourceManager->GetResource<IResource>(meshId)->GetState())
+			if (!pBounds || !pBounds->IsDirty() || !pMeshContainer)
 			{
-				return;
+				continue;
 			}
 
-			if (auto pStaticMesh = pResourceManager->GetResource<IStaticMesh>(meshId))
+			const TResourceId meshId = pResourceManager->Load<TMeshType>(pMeshContainer->GetMeshName());
+
+			auto pResource = pResourceManager->GetResource<IResource>(meshId);
+			if (!pResource || E_RESOURCE_STATE_TYPE::RST_LOADED != pResource->GetState())
 			{
-				auto&& vertices = pStaticMesh->GetPositionsArray();
+				continue;
+			}
 
-				if (CTransform* pTransform = staticMeshesContext.mpTransforms[id])
-				{
-					const TMatrix4& worldMatrix = pTransform->GetLocalToWorldTransform();
+			if (auto pMesh = pResourceManager->GetResource<TMeshType>(meshId))
+			{
+				resources[i] = pMesh.Get();
+			}
+		}
+	}
 
-					TVector4 min{ (std::numeric_limits<F32>::max)() };
-					TVector4 max{ -(std::numeric_limits<F32>::max)() };
 
-					for (auto&& v : vertices)
-					{
-						TVector4 transformedVertex = worldMatrix * v;
+	/*!
+		\brief The functions below return false if bounds can't be computed yet, e.g. a mesh isn't loaded, so the component stays dirty
+	*/
 
-						min = Min(min, transformedVertex);
-						max = Max(max, transformedVertex);
-					}
+	static bool ComputeStaticMeshBounds(IResourceManager* pResourceManager, CBoundsUpdatingSystem::TStaticMeshesBoundsContext& staticMeshesContext, USIZE id)
+	{
+		TDE2_PROFILER_SCOPE("ComputeStaticMeshBounds");
 
-					pBounds->SetBounds(TAABB{ min, max });
-				}
-			}
+		CBoundsComponent* pBounds = staticMeshesContext.mpBounds[id];
+
+		CTransform* pTransform = staticMeshesContext.mpTransforms[id];
+
+		/// \note Skip meshes that's not been loaded yet
+		IStaticMesh* pStaticMesh = staticMeshesContext.mpResources[id];
+		if (!staticMeshesContext.mpElements[id] || !pStaticMesh || !pTransform)
+		{
+			return false;
+		}
+
+		auto&& vertices = pStaticMesh->GetPositionsArray();
+
+		const TMatrix4& worldMatrix = pTransform->GetLocalToWorldTransform();
+
+		TVector4 min{ (std::numeric_limits<F32>::max)() };
+		TVector4 max{ -(std::numeric_limits<F32>::max)() };
+
+		for (auto&& v : vertices)
+		{
+			TVector4 transformedVertex = worldMatrix * v;
+
+			min = Min(min, transformedVertex);
+			max = Max(max, transformedVertex);
 		}
+
+		pBounds->SetBounds(TAABB{ min, max });
+
+		return true;
 	}
 
-	static void ComputeSkinnedMeshBounds(IResourceManager* pResourceManager, CBoundsUpdatingSystem::TSkinnedMeshesBoundsContext& skinnedMeshesContext, USIZE id)
+	static bool ComputeSkinnedMeshBounds(IResourceManager* pResourceManager, CBoundsUpdatingSystem::TSkinnedMeshesBoundsContext& skinnedMeshesContext, USIZE id)
 	{
 		TDE2_PROFILER_SCOPE("ComputeSkinnedMeshBounds");
 
 		CBoundsComponent* pBounds = skinnedMeshesContext.mpBounds[id];
 
-		if (CSkinnedMeshContainer* pSkinnedMeshContainer = skinnedMeshesContext.mpElements[id])
+		CSkinnedMeshContainer* pSkinnedMeshContainer = skinnedMeshesContext.mpElements[id];
+		CTransform* pTransform = skinnedMeshesContext.mpTransforms[id];
+
+		/// \note Skip meshes that's not been loaded yet
+		ISkinnedMesh* pSkinnedMesh = skinnedMeshesContext.mpResources[id];
+		if (!pSkinnedMeshContainer || !pSkinnedMesh || !pTransform)
 		{
-			const TResourceId meshId = pResourceManager->Load<ISkinnedMesh>(pSkinnedMeshContainer->GetMeshName());
+			return false;
+		}
 
-			/// \note Skip meshes that's not been loaded yet
-			if (E_RESOURCE_STATE_TYPE::RST_LOADED != pResourceManager->GetResource<IResource>(meshId)->GetState())
-			{
-				return;
-			}
+		auto&& currAnimationPose = pSkinnedMeshContainer->GetCurrentAnimationPose();
+		auto&& vertices = pSkinnedMesh->GetPositionsArray();
+		auto&& jointIndices = pSkinnedMesh->GetJointIndicesArray();
+		auto&& jointWeights = pSkinnedMesh->GetJointWeightsArray();
 
-			if (auto pSkinnedMesh = pResourceManager->GetResource<ISkinnedMesh>(meshId))
-			{
-				if (CTransform* pTransform = skinnedMeshesContext.mpTransforms[id])
-				{
-					auto&& currAnimationPose = pSkinnedMeshContainer->GetCurrentAnimationPose();
-					auto&& vertices = pSkinnedMesh->GetPositionsArray();
-					auto&& jointIndices = pSkinnedMesh->GetJointIndicesArray();
-					auto&& jointWeights = pSkinnedMesh->GetJointWeightsArray();
+		const TMatrix4& worldMatrix = pTransform->GetLocalToWorldTransform();
 
-					const TMatrix4& worldMatrix = pTransform->GetLocalToWorldTransform();
+		TVector4 min{ (std::numeric_limits<F32>::max)() };
+		TVector4 max{ -(std::numeric_limits<F32>::max)() };
 
-					TVector4 min{ (std::numeric_limits<F32>::max)() };
-					TVector4 max{ -(std::numeric_limits<F32>::max)() };
+		/// \note Compute whole CPU skinning for correct updates of bounds when the model is animated
 
-					/// \note Compute whole CPU skinning for correct updates of bounds when the model is animated
+		for (U32 i = 0; i < vertices.size(); ++i)
+		{
+			TVector4 skinVertex = TVector4(ZeroVector3, 1.0f);
+			const TVector4& currVertex = vertices[i];
 
-					for (U32 i = 0; i < vertices.size(); ++i)
-					{
-						TVector4 skinVertex = TVector4(ZeroVector3, 1.0f);
-						const TVector4& currVertex = vertices[i];
+			for (U8 k = 0; k < jointWeights[i].size(); ++k)
+			{
+				const U32 jointIndex = jointIndices[i][k];
 
-						for (U8 k = 0; k < jointWeights[i].size(); ++k)
-						{
-							const U32 jointIndex = jointIndices[i][k];
+				const auto& jointMatrix = (jointIndex < ISkeleton::mMaxNumOfJoints && jointIndex < currAnimationPose.size()) ? currAnimationPose[jointIndex] : ZeroMatrix4;
 
-							const auto& jointMatrix = (jointIndex < ISkeleton::mMaxNumOfJoints && jointIndex < currAnimationPose.size()) ? currAnimationPose[jointIndex] : ZeroMatrix4;
+				skinVertex = skinVertex + jointWeights[i][k] * Mul(jointMatrix, currVertex);
+			}
+			
+			TVector4 transformedVertex = worldMatrix * vertices[i];
 
-							skinVertex = skinVertex + jointWeights[i][k] * Mul(jointMatrix, currVertex);
-						}
-						
-						TVector4 transformedVertex = worldMatrix * vertices[i];
+			min = Min(min, transformedVertex);
+			max = Max(max, transformedVertex);
+		}
 
-						min = Min(min, transformedVertex);
-						max = Max(max, transformedVertex);
-					}
+		pBounds->SetBounds(TAABB{ min, max });
 
-					pBounds->SetBounds(TAABB{ min, max });
-				}
-			}
-		}
+		return true;
 	}
 
 	template <typename T, typename TFunc>
-	static void ProcessMeshesBounds(IResourceManager* pResourceManager, IDebugUtility* pDebugUtility, T& meshesContext, bool isUpdateNeeded, const TFunc& functor)
+	static void ProcessMeshesBounds(IWorld* pWorld, IResourceManager* pResourceManager, IDebugUtility* pDebugUtility, T& meshesContext, bool isUpdateNeeded, const TFunc& functor)
 	{
 		TDE2_PROFILER_SCOPE("CBoundsUpdatingSystem::ProcessMeshesBounds");
 
 		auto& bounds = meshesContext.mpBounds;
 
-		for (USIZE i = 0; i < bounds.size(); ++i)
+		if (isUpdateNeeded)
 		{
-			if (CBoundsComponent* pBounds = bounds[i])
+			/// \note Each element writes only into its own bounds component, so they're processed in parallel
+			pWorld->ParallelForEach(bounds.size(), [pResourceManager, &meshesContext, &bounds, &functor](USIZE i)
 			{
-				if (pDebugUtility)
+				CBoundsComponent* pBounds = bounds[i];
+				if (!pBounds || !pBounds->IsDirty())
 				{
-					pDebugUtility->DrawAABB(pBounds->GetBounds(), TColorUtils::mWhite);
+					return;
 				}
 
-				if (!isUpdateNeeded || !pBounds->IsDirty())
+				if (functor(pResourceManager, meshesContext, i))
 				{
-					continue;
+					pBounds->SetDirty(false);
 				}
+			});
+		}
 
-				functor(pResourceManager, meshesContext, i);
+		if (!pDebugUtility)
+		{
+			return;
+		}
 
-				pBounds->SetDirty(false);
+		for (CBoundsComponent* pBounds : bounds)
+		{
+			if (pBounds)
+			{
+				pDebugUtility->DrawAABB(pBounds->GetBounds(), TColorUtils::mWhite);
 			}
 		}
 	}
 
 
-	static void ComputeSpritesBounds(CBoundsUpdatingSystem::TSpritesBoundsContext& spritesContext, USIZE id)
+	static bool ComputeSpritesBounds(CBoundsUpdatingSystem::TSpritesBoundsContext& spritesContext, USIZE id)
 	{
 		TDE2_PROFILER_SCOPE("ComputeSpritesBounds");
 
@@ -226,50 +279,38 @@ namespace TDEngine2
 			TVector4 { 0.5f, -0.5f, 0.0f, 1.0f },
 		};
 
-		if (CTransform* pSpriteTransform = spritesContext.mpTransforms[id])
+		CTransform* pSpriteTransform = spritesContext.mpTransforms[id];
+		if (!pSpriteTransform)
 		{
-			const TMatrix4& worldMatrix = pSpriteTransform->GetLocalToWorldTransform();
+			return false;
+		}
 
-			TVector4 min{ (std::numeric_limits<F32>::max)() };
-			TVector4 max{ -(std::numeric_limits<F32>::max)() };
+		const TMatrix4& worldMatrix = pSpriteTransform->GetLocalToWorldTransform();
 
-			for (auto&& v : spriteVerts)
-			{
-				TVector4 transformedVertex = worldMatrix * v;
+		TVector4 min{ (std::numeric_limits<F32>::max)() };
+		TVector4 max{ -(std::numeric_limits<F32>::max)() };
 
-				min = Min(min, transformedVertex);
-				max = Max(max, transformedVertex);
-			}
+		for (auto&& v : spriteVerts)
+		{
+			TVector4 transformedVertex = worldMatrix * v;
 
-			pBounds->SetBounds(TAABB{ min, max });
+			min = Min(min, transformedVertex);
+			max = Max(max, transformedVertex);
 		}
+
+		pBounds->SetBounds(TAABB{ min, max });
+
+		return true;
 	}
 
-	static void ProcessSpritesBounds(IDebugUtility* pDebugUtility, CBoundsUpdatingSystem::TSpritesBoundsContext& spritesContext, bool isUpdateNeeded)
+	static void ProcessSpritesBounds(IWorld* pWorld, IDebugUtility* pDebugUtility, CBoundsUpdatingSystem::TSpritesBoundsContext& spritesContext, bool isUpdateNeeded)
 	{
 		TDE2_PROFILER_SCOPE("CBoundsUpdatingSystem::ProcessSpritesBounds");
 
-		auto& bounds = spritesContext.mpBounds;
-
-		for (USIZE i = 0; i < bounds.size(); ++i)
+		ProcessMeshesBounds(pWorld, nullptr, pDebugUtility, spritesContext, isUpdateNeeded, [](IResourceManager*, CBoundsUpdatingSystem::TSpritesBoundsContext& context, USIZE id)
 		{
-			if (CBoundsComponent* pBounds = bounds[i])
-			{
-				if (pDebugUtility)
-				{
-					pDebugUtility->DrawAABB(pBounds->GetBounds(), TColorUtils::mWhite);
-				}
-
-				if (!isUpdateNeeded || !pBounds->IsDirty())
-				{
-					continue;
-				}
-
-				ComputeSpritesBounds(spritesContext, i);
-
-				pBounds->SetDirty(false);
-			}
-		}
+			return ComputeSpritesBounds(context, id);
+		});
 	}
 
 
@@ -284,9 +325,15 @@ namespace TDEngine2
 
 		TDE2_PROFILER_SCOPE("CBoundsUpdatingSystem::Update");
 
-		ProcessMeshesBounds(mpResourceManager, mpDebugUtility, mStaticMeshesContext, isUpdateNeeded, ComputeStaticMeshBounds);
-		ProcessMeshesBounds(mpResourceManager, mpDebugUtility, mSkinnedMeshesContext, isUpdateNeeded, ComputeSkinnedMeshBounds);
-		ProcessSpritesBounds(mpDebugUtility, mSpritesContext, isUpdateNeeded);
+		if (isUpdateNeeded)
+		{
+			ResolveMeshesResources<IStaticMesh>(mpResourceManager, mStaticMeshesContext);
+			ResolveMeshesResources<ISkinnedMesh>(mpResourceManager, mSkinnedMeshesContext);
+		}
+
+		ProcessMeshesBounds(pWorld, mpResourceManager, mpDebugUtility, mStaticMeshesContext, isUpdateNeeded, ComputeStaticMeshBounds);
+		ProcessMeshesBounds(pWorld, mpResourceManager, mpDebugUtility, mSkinnedMeshesContext, isUpdateNeeded, ComputeSkinnedMeshBounds);
+		ProcessSpritesBounds(pWorld, mpDebugUtility, mSpritesContext, isUpdateNeeded);
 
 #if 0
 		_processScenesEntities(pWorld);
@@ -18,6 +18,13 @@ namespace TDEngine2
 	CCameraSystem::CCameraSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<COrthoCamera, CTransform>();
+		_addComponentsFilter<CPerspectiveCamera, CTransform>();
+		_addComponentsFilter<CCamerasContextComponent>();
+
+		_addReadAccess<CTransform, CCamerasContextComponent>();
+		_addWriteAccess<CPerspectiveCamera, COrthoCamera>();
+		_requireMainThread(); /// \note The main camera is passed into the renderer
 	}
 
 	E_RESULT_CODE CCameraSystem::Init(const IWindowSystem* pWindowSystem, IGraphicsContext* pGraphicsContext, IRenderer* pRenderer)
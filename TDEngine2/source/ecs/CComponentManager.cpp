@@ -34,6 +34,7 @@
 #include "../../include/scene/components/CLODStrategyComponent.h"
 #include "../../include/editor/ecs/EditorComponents.h"
 #include "../../include/editor/CPerfProfiler.h"
+#include <algorithm>
 
 
 namespace TDEngine2
@@ -62,32 +63,21 @@ namespace TDEngine2
 		E_RESULT_CODE result = RC_OK;
 
 		/// \note Remove all active components
-		for (auto&& currComponentsGroup : mActiveComponents)
+		mArchetypesStorage.ForEachComponent([&result](TypeId, IComponent* pCurrComponent)
 		{
-			for (IComponent* pCurrComponent : currComponentsGroup)
+			if (!pCurrComponent)
 			{
-				if (!pCurrComponent)
-				{
-					continue;
-				}
-
-				result = result | pCurrComponent->Free();
+				return;
 			}
-		}
 
-		/// \note Remove reserved ones
-		for (IComponent* pReservedComponent : mDestroyedComponents)
-		{
-			if (!pReservedComponent)
-			{
-				continue;
-			}
+			result = result | pCurrComponent->Free();
+		});
 
-			pReservedComponent->Free();
-		}
+		/// \note Remove reserved ones
+		result = result | ReleaseDestroyedComponents();
 
-		mActiveComponents.clear();
-		mDestroyedComponents.clear();
+		mArchetypesStorage.Clear();
+		mComponentsOfTypeCache.clear();
 
 		result = result | _unregisterBuiltinComponentFactories();
 
@@ -129,19 +119,32 @@ namespace TDEngine2
 	}
 
 
-	E_RESULT_CODE CComponentManager::_removeComponentWithAction(TypeId componentTypeId, TEntityId entityId,
-																const std::function<E_RESULT_CODE(IComponent*&)>& action)
+	E_RESULT_CODE CComponentManager::ReleaseDestroyedComponents()
 	{
-		U32 targetEntityComponentHash = mComponentEntityMap[componentTypeId][entityId];
+		TDE2_PROFILER_SCOPE("CComponentManager::ReleaseDestroyedComponents");
 
-		if (!targetEntityComponentHash || (mComponentsHashTable.find(componentTypeId) == mComponentsHashTable.cend()))
+		E_RESULT_CODE result = RC_OK;
+
+		for (IComponent* pReservedComponent : mDestroyedComponents)
 		{
-			return RC_FAIL;
+			if (!pReservedComponent)
+			{
+				continue;
+			}
+
+			result = result | pReservedComponent->Free();
 		}
 
-		U32 componentHashValue = mComponentsHashTable[componentTypeId];
+		mDestroyedComponents.clear();
 
-		IComponent* pComponent = mActiveComponents[componentHashValue][targetEntityComponentHash - 1];
+		return result;
+	}
+
+
+	E_RESULT_CODE CComponentManager::_removeComponentWithAction(TypeId componentTypeId, TEntityId entityId,
+																const std::function<E_RESULT_CODE(IComponent*&)>& action)
+	{
+		IComponent* pComponent = mArchetypesStorage.GetComponent(entityId, componentTypeId);
 
 		if (!pComponent)
 		{
@@ -155,20 +158,8 @@ namespace TDEngine2
 			return result;
 		}
 
-		mActiveComponents[componentHashValue][targetEntityComponentHash - 1] = nullptr;
-		
-		if (_isUniqueComponent(componentTypeId))
-		{
-			auto it = mUniqueComponentsRegistry.find(componentTypeId);
-			if (it != mUniqueComponentsRegistry.cend())
-			{
-				mUniqueComponentsRegistry.erase(it);
-			}
-		}
-
-		// mark handlers as invalid
-		mEntityComponentMap[entityId].erase(componentTypeId);
-		mComponentEntityMap[componentTypeId].erase(entityId);
+		mArchetypesStorage.RemoveComponent(entityId, componentTypeId);
+		_onComponentDetached(componentTypeId);
 
 		return RC_OK;
 	}
@@ -204,83 +195,76 @@ namespace TDEngine2
 
 	E_RESULT_CODE CComponentManager::_removeComponentsWithAction(TEntityId entityId, const std::function<E_RESULT_CODE(IComponent*&)>& action)
 	{
-		auto entityComponentsListIter = mEntityComponentMap.find(entityId);
-
-		if (entityComponentsListIter == mEntityComponentMap.end())
+		const CArchetypeStorage::TEntityRecord* pEntityRecord = mArchetypesStorage.GetEntityRecord(entityId);
+		if (!pEntityRecord)
 		{
 			return RC_FAIL;
 		}
 
-		auto entityComponentsList = (*entityComponentsListIter).second;
-
-		IComponent* pCurrComponent = nullptr;
-
-		TypeId componentType = TypeId(0);
-
-		U32 hashValue = 0;
-
-		U32 componentTypeHashValue = 0;
+		const CArchetype* pArchetype = mArchetypesStorage.GetArchetype(pEntityRecord->mArchetypeId);
+		const CArchetype::TComponentsSignature signature = pArchetype->GetSignature();
 
 		E_RESULT_CODE result = RC_OK;
 
-		for (auto& currEntityComponentPair : entityComponentsList)
-		{
-			componentType = currEntityComponentPair.first;
-			hashValue = currEntityComponentPair.second - 1;
-
-			if (hashValue == (std::numeric_limits<U32>::max)()) // \note this means that there is no component of given type on this entity
-			{
-				continue;
-			}
-
-			componentTypeHashValue = mComponentsHashTable[componentType];
+		std::vector<TypeId> failedComponentsTypes;
 
-			pCurrComponent = mActiveComponents[componentTypeHashValue][hashValue];
+		for (U32 i = 0; i < static_cast<U32>(signature.size()); ++i)
+		{
+			IComponent* pComponent = pArchetype->GetColumn(i)[pEntityRecord->mRowIndex];
 
-			if ((result = action(pCurrComponent)) != RC_OK)
+			const E_RESULT_CODE actionResult = action(pComponent);
+			if (RC_OK != actionResult)
 			{
-				return result;
+				failedComponentsTypes.push_back(signature[i]);
+				result = result | actionResult;
 			}
+		}
 
-			mActiveComponents[componentTypeHashValue][hashValue] = nullptr;
-
-			if (_isUniqueComponent(componentType))
+		if (failedComponentsTypes.empty())
+		{
+			/// \note All components are detached at once, so the entity doesn't travel through intermediate archetypes
+			mArchetypesStorage.RemoveEntity(entityId);
+		}
+		else
+		{
+			/// \note Components which the action failed for stay attached, so they aren't leaked and the caller could retry
+			for (TypeId currComponentTypeId : signature)
 			{
-				auto it = mUniqueComponentsRegistry.find(componentType);
-				if (it != mUniqueComponentsRegistry.cend())
+				if (std::find(failedComponentsTypes.cbegin(), failedComponentsTypes.cend(), currComponentTypeId) == failedComponentsTypes.cend())
 				{
-					mUniqueComponentsRegistry.erase(it);
+					mArchetypesStorage.RemoveComponent(entityId, currComponentTypeId);
 				}
 			}
+		}
 
-			// mark handlers as invalid
-			mEntityComponentMap[entityId].erase(componentType);
-			mComponentEntityMap[componentType].erase(entityId);
+		for (TypeId currComponentTypeId : signature)
+		{
+			if (std::find(failedComponentsTypes.cbegin(), failedComponentsTypes.cend(), currComponentTypeId) == failedComponentsTypes.cend())
+			{
+				_onComponentDetached(currComponentTypeId);
+			}
 		}
 
-		return RC_OK;
+		return result;
 	}
-	
-	std::vector<IComponent*> CComponentManager::GetComponents(TEntityId id) const
-	{
-		std::vector<IComponent*> components;
 
-		auto entityComponentsIter = mEntityComponentMap.find(id);
-		if (entityComponentsIter == mEntityComponentMap.cend())
+	void CComponentManager::_onComponentDetached(TypeId componentTypeId)
+	{
+		if (!_isUniqueComponent(componentTypeId))
 		{
-			return components;
+			return;
 		}
 
-		auto&& componentsHashesTable = entityComponentsIter->second;
-
-		for (auto& currEntityComponentPair : componentsHashesTable)
+		auto it = mUniqueComponentsRegistry.find(componentTypeId);
+		if (it != mUniqueComponentsRegistry.cend())
 		{
-			const TypeId componentType = currEntityComponentPair.first;
-
-			 components.push_back(mActiveComponents[mComponentsHashTable.at(componentType)][currEntityComponentPair.second - 1]);
+			mUniqueComponentsRegistry.erase(it);
 		}
-
-		return components;
+	}
+	
+	std::vector<IComponent*> CComponentManager::GetComponents(TEntityId id) const
+	{
+		return mArchetypesStorage.GetComponents(id);
 	}
 
 	E_RESULT_CODE CComponentManager::RegisterFactory(TPtr<IComponentFactory> pFactory)
@@ -375,23 +359,11 @@ namespace TDEngine2
 
 		pNewComponent = pComponentFactory->CreateDefault();
 		
-		auto componentTypeHashIter = mComponentsHashTable.find(componentTypeId);
-
-		if (componentTypeHashIter == mComponentsHashTable.end()) /// allocate space for a new group
+		if (RC_OK != mArchetypesStorage.AddComponent(entityId, componentTypeId, pNewComponent))
 		{
-			mComponentsHashTable[componentTypeId] = static_cast<U32>(mActiveComponents.size());
-
-			mActiveComponents.emplace_back();
+			pNewComponent->Free();
+			return nullptr;
 		}
-		
-		std::vector<IComponent*>& componentsGroup = mActiveComponents[mComponentsHashTable[componentTypeId]];
-
-		componentsGroup.push_back(pNewComponent);
-
-		U32 hash = static_cast<U32>(componentsGroup.size());
-
-		mComponentEntityMap[componentTypeId][entityId] = hash;
-		mEntityComponentMap[entityId][componentTypeId] = hash;
 
 		if (isUniqueComponentType)
 		{
@@ -403,18 +375,7 @@ namespace TDEngine2
 
 	IComponent* CComponentManager::_getComponent(TypeId componentTypeId, TEntityId entityId)
 	{
-		TDE2_PROFILER_SCOPE("CComponentManager::_getComponent");
-		
-		const U32 instanceHashValue = mComponentEntityMap[componentTypeId][entityId];
-
-		auto&& it = mComponentsHashTable.find(componentTypeId);
-
-		if (!instanceHashValue || (it == mComponentsHashTable.cend()))
-		{
-			return nullptr;
-		}		
-
-		return mActiveComponents[it->second][instanceHashValue - 1];
+		return mArchetypesStorage.GetComponent(entityId, componentTypeId);
 	}
 
 	E_RESULT_CODE CComponentManager::_registerBuiltinComponentFactories()
@@ -502,99 +463,80 @@ namespace TDEngine2
 
 	bool CComponentManager::_hasComponent(TypeId componentTypeId, TEntityId entityId)
 	{
-		TDE2_PROFILER_SCOPE("CComponentManager::_hasComponent");
-
-		U32 instanceHashValue = mComponentEntityMap[componentTypeId][entityId];
-
-		return instanceHashValue && (mComponentsHashTable.find(componentTypeId) != mComponentsHashTable.cend());
+		return mArchetypesStorage.HasComponent(entityId, componentTypeId);
 	}
 
 	CComponentIterator CComponentManager::FindComponentsOfType(TypeId typeId)
 	{
-		if (mComponentsHashTable.find(typeId) == mComponentsHashTable.cend())
+		std::vector<IComponent*>& components = mComponentsOfTypeCache[typeId];
+		components.clear();
+
+		for (auto&& pCurrArchetype : mArchetypesStorage.GetArchetypes())
 		{
-			return CComponentIterator::mInvalidIterator;
+			const U32 columnIndex = pCurrArchetype->GetColumnIndex(typeId);
+			if (CArchetype::mInvalidColumnIndex == columnIndex)
+			{
+				continue;
+			}
+
+			auto&& column = pCurrArchetype->GetColumn(columnIndex);
+			components.insert(components.end(), column.begin(), column.end());
 		}
 
-		U32 componentTypeHashValue = mComponentsHashTable[typeId];
+		if (components.empty())
+		{
+			return CComponentIterator::mInvalidIterator;
+		}
 		
-		return CComponentIterator(mActiveComponents[componentTypeHashValue], 0);
+		return CComponentIterator(components, 0);
 	}
 
 	void CComponentManager::ForEach(TypeId componentTypeId, const std::function<void(TEntityId entityId, IComponent* pComponent)>& action)
 	{
-		if (mComponentsHashTable.find(componentTypeId) == mComponentsHashTable.cend())
+		for (auto&& pCurrArchetype : mArchetypesStorage.GetArchetypes())
 		{
-			return;
-		}
-
-		U32 componentTypeHashValue = mComponentsHashTable[componentTypeId];
+			const U32 columnIndex = pCurrArchetype->GetColumnIndex(componentTypeId);
+			if (CArchetype::mInvalidColumnIndex == columnIndex)
+			{
+				continue;
+			}
 
-		auto& componentsGroup = mComponentEntityMap[componentTypeId];
+			auto&& entities = pCurrArchetype->GetEntities();
+			auto&& column = pCurrArchetype->GetColumn(columnIndex);
 
-		for (auto iter = componentsGroup.begin(); iter != componentsGroup.end(); ++iter)
-		{
-			action((*iter).first, mActiveComponents[componentTypeHashValue][(*iter).second - 1]);
+			for (USIZE i = 0; i < entities.size(); ++i)
+			{
+				action(entities[i], column[i]);
+			}
 		}
 	}
 
 	std::vector<TEntityId> CComponentManager::FindEntitiesWithAll(const std::vector<TypeId>& types)
 	{
 		std::vector<TEntityId> filter;
+		FindEntitiesWithAll(types, filter);
 
-		std::unordered_map<TypeId, U32> entityComponentsTable;
-
-		bool containsAll = false;
-
-		for (auto entityComponentsTablePair : mEntityComponentMap)
-		{
-			entityComponentsTable = entityComponentsTablePair.second;
-
-			containsAll = true;
-
-			for (auto typeIter = types.cbegin(); typeIter != types.cend(); ++typeIter)
-			{
-				containsAll = containsAll && (entityComponentsTable.find(*typeIter) != entityComponentsTable.cend());
-
-				if (!containsAll) /// an early interruption of the loop if one of operands is false
-				{
-					break;
-				}
-			}
-
-			if (!containsAll)
-			{
-				continue;
-			}
-
-			filter.push_back(entityComponentsTablePair.first);
-		}
+		return filter;
+	}
 
-		return std::move(filter);
+	void CComponentManager::FindEntitiesWithAll(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities)
+	{
+		TDE2_PROFILER_SCOPE("CComponentManager::FindEntitiesWithAll");
+		mArchetypesStorage.FindEntitiesWithAll(types, outEntities);
 	}
 
 	std::vector<TEntityId> CComponentManager::FindEntitiesWithAny(const std::vector<TypeId>& types)
 	{
 		std::vector<TEntityId> filter;
+		FindEntitiesWithAny(types, filter);
 
-		std::unordered_map<TypeId, U32> entityComponentsTable;
-
-		for (auto entityComponentsTablePair : mEntityComponentMap)
-		{
-			entityComponentsTable = entityComponentsTablePair.second;
-			
-			for (auto typeIter = types.cbegin(); typeIter != types.cend(); ++typeIter)
-			{
-				if (entityComponentsTable.find(*typeIter) != entityComponentsTable.cend())
-				{
-					filter.push_back(entityComponentsTablePair.first);
-
-					break;
-				}
-			}
-		}
+		return filter;
+	}
 
-		return std::move(filter);
+	void CComponentManager::FindEntitiesWithAny(const std::vector<TypeId>& types, std::vector<TEntityId>& outEntities)
+	{
+		TDE2_PROFILER_SCOPE("CComponentManager::FindEntitiesWithAny");
+		mArchetypesStorage.FindEntitiesWithAny(types, outEntities);
 	}
 
 	TEntityId CComponentManager::FindEntityWithUniqueComponent(TypeId typeId)
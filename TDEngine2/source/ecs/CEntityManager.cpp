@@ -3,6 +3,8 @@
 #include "../../include/ecs/CTransform.h"
 #include "../../include/core/IEventManager.h"
 #include "../../include/editor/CPerfProfiler.h"
+#include "../../include/utils/CFileLogger.h"
+#include <algorithm>
 
 
 namespace TDEngine2
@@ -30,8 +32,6 @@ namespace TDEngine2
 
 		mpEventManager = pEventManager;
 
-		mNextIdValue = 0;
-
 		mIsInitialized = true;
 
 		return RC_OK;
@@ -58,7 +58,7 @@ namespace TDEngine2
 	CEntity* CEntityManager::Create()
 	{
 		std::lock_guard<std::mutex> lock(mMutex);
-		return _createEntity(_constructDefaultEntityName(mNextIdValue));
+		return _createEntity(_constructDefaultEntityName(_getNextSlotIndex()));
 	}
 
 	CEntity* CEntityManager::Create(const std::string& name)
@@ -74,27 +74,36 @@ namespace TDEngine2
 			return RC_INVALID_ARGS;
 		}
 
-		E_RESULT_CODE result = mpComponentManager->RemoveComponents(pEntity->GetId());
+		const TEntityId id = pEntity->GetId();
 
-		if (result != RC_OK)
 		{
-			return result;
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			const TEntitySlot* pEntitySlot = _getEntitySlot(id);
+			if (!pEntitySlot || pEntitySlot->mpEntity != pEntity)
+			{
+				return RC_INVALID_ARGS; /// \note The entity has been already destroyed
+			}
 		}
 
 		TOnEntityRemovedEvent onEntityRemoved;
+		_getComponentsTypes(id, onEntityRemoved.mRemovedComponentsTypes);
+
+		E_RESULT_CODE result = mpComponentManager->RemoveComponents(id);
 
+		if (result != RC_OK)
 		{
-			std::lock_guard<std::mutex> lock(mMutex);
+			return result;
+		}
 
-			TEntityId id = pEntity->GetId();
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
 
 			onEntityRemoved.mRemovedEntityId = id;
 
-			mActiveEntities[static_cast<U32>(id)] = nullptr;
+			_releaseEntitySlot(id);
 
 			mDestroyedEntities.push_back(pEntity);
-
-			mEntitiesHashTable.erase(id);
 		}
 
 		mpEventManager->Notify(&onEntityRemoved);
@@ -111,17 +120,25 @@ namespace TDEngine2
 
 	E_RESULT_CODE CEntityManager::DestroyAllEntities()
 	{
-		std::lock_guard<std::mutex> lock(mMutex);
+		std::vector<CEntity*> entities;
 
-		E_RESULT_CODE result = RC_OK;
-
-		for (CEntity* pEntity : mActiveEntities)
 		{
-			if (!pEntity)
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			for (const TEntitySlot& currSlot : mEntitiesSlots)
 			{
-				continue;
+				if (currSlot.mpEntity)
+				{
+					entities.push_back(currSlot.mpEntity);
+				}
 			}
+		}
+
+		E_RESULT_CODE result = RC_OK;
 
+		/// \note Destroy locks the mutex by itself
+		for (CEntity* pEntity : entities)
+		{
 			if ((result = Destroy(pEntity)) != RC_OK)
 			{
 				return result;
@@ -137,14 +154,14 @@ namespace TDEngine2
 
 		E_RESULT_CODE result = RC_OK;
 
-		for (CEntity* pEntity : mActiveEntities)
+		for (const TEntitySlot& currSlot : mEntitiesSlots)
 		{
-			if (!pEntity)
+			if (!currSlot.mpEntity)
 			{
 				continue;
 			}
 
-			if ((result = _destroyImmediatelyInternal(pEntity)) != RC_OK)
+			if ((result = _destroyImmediatelyInternal(currSlot.mpEntity)) != RC_OK)
 			{
 				return result;
 			}
@@ -180,18 +197,10 @@ namespace TDEngine2
 
 	CEntity* CEntityManager::GetEntity(TEntityId entityId) const
 	{
-		TDE2_PROFILER_SCOPE("CEntityManager::GetEntity");
-
 		std::lock_guard<std::mutex> lock(mMutex);
 
-		TEntitiesHashTable::const_iterator entityIter = mEntitiesHashTable.find(entityId);
-
-		if (entityIter == mEntitiesHashTable.cend())
-		{
-			return nullptr;
-		}
-
-		return mActiveEntities[(*entityIter).second];
+		const TEntitySlot* pEntitySlot = _getEntitySlot(entityId);
+		return pEntitySlot ? pEntitySlot->mpEntity : nullptr;
 	}
 
 	std::string CEntityManager::_constructDefaultEntityName(U32 id) const
@@ -203,30 +212,41 @@ namespace TDEngine2
 	{
 		E_RESULT_CODE result = RC_OK;
 
-		TEntityId id = TEntityId(mNextIdValue);
+		const U32 slotIndex = _getNextSlotIndex();
+
+		if (slotIndex >= EntityIndexMask) /// \note The greatest index is reserved for TEntityId::Invalid
+		{
+			LOG_ERROR("[CEntityManager] The maximal number of entities has been exceeded");
+			return nullptr;
+		}
+
+		if (slotIndex == static_cast<U32>(mEntitiesSlots.size()))
+		{
+			mEntitiesSlots.emplace_back();
+		}
+		else
+		{
+			mFreeSlotsIndices.pop_back();
+		}
+
+		TEntitySlot& entitySlot = mEntitiesSlots[slotIndex];
+
+		const TEntityId id = MakeEntityId(slotIndex, entitySlot.mGeneration);
 
 		CEntity* pEntity = CreateEntity(id, name, this, result);
 		
 		if (result != RC_OK)
 		{
+			mFreeSlotsIndices.push_back(slotIndex);
 			return nullptr;
 		}
 
-		size_t currStorageSize = mActiveEntities.size();
+		entitySlot.mpEntity = pEntity;
 
-		if (mNextIdValue + 1 >= currStorageSize)
-		{
-			mActiveEntities.resize(currStorageSize + 10); /// \todo 10 is just a magic constant that should be replaced in some way
-		}
-		
 		TOnEntityCreatedEvent onEntityCreated;
 
 		onEntityCreated.mCreatedEntityId = id;
 
-		mEntitiesHashTable[id] = mNextIdValue;
-
-		mActiveEntities[mNextIdValue++] = pEntity;
-
 		/// create basic component CTransform
 		CTransform* pTransform = pEntity->AddComponent<CTransform>();
 		pTransform->SetOwnerId(id);
@@ -236,6 +256,41 @@ namespace TDEngine2
 		return pEntity;
 	}
 
+	U32 CEntityManager::_getNextSlotIndex() const
+	{
+		return mFreeSlotsIndices.empty() ? static_cast<U32>(mEntitiesSlots.size()) : mFreeSlotsIndices.back();
+	}
+
+	const CEntityManager::TEntitySlot* CEntityManager::_getEntitySlot(TEntityId entityId) const
+	{
+		const U32 slotIndex = GetEntityIndex(entityId);
+
+		if (TEntityId::Invalid == entityId || slotIndex >= mEntitiesSlots.size())
+		{
+			return nullptr;
+		}
+
+		const TEntitySlot& entitySlot = mEntitiesSlots[slotIndex];
+		return (entitySlot.mpEntity && entitySlot.mGeneration == GetEntityGeneration(entityId)) ? &entitySlot : nullptr;
+	}
+
+	void CEntityManager::_releaseEntitySlot(TEntityId entityId)
+	{
+		const U32 slotIndex = GetEntityIndex(entityId);
+		TDE2_ASSERT(slotIndex < mEntitiesSlots.size());
+
+		TEntitySlot& entitySlot = mEntitiesSlots[slotIndex];
+
+		entitySlot.mpEntity = nullptr;
+
+		if (++entitySlot.mGeneration > EntityGenerationMask)
+		{
+			return; /// \note The slot is retired, otherwise old identifiers would become valid again
+		}
+
+		mFreeSlotsIndices.push_back(slotIndex);
+	}
+
 	E_RESULT_CODE CEntityManager::_destroyImmediatelyInternal(CEntity* pEntity)
 	{
 		if (!pEntity)
@@ -243,6 +298,15 @@ namespace TDEngine2
 			return RC_INVALID_ARGS;
 		}
 
+		const TEntitySlot* pEntitySlot = _getEntitySlot(pEntity->GetId());
+		if (!pEntitySlot || pEntitySlot->mpEntity != pEntity)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		TOnEntityRemovedEvent onEntityRemoved;
+		_getComponentsTypes(pEntity->GetId(), onEntityRemoved.mRemovedComponentsTypes);
+
 		E_RESULT_CODE result = mpComponentManager->RemoveComponents(pEntity->GetId());
 
 		if (result != RC_OK)
@@ -252,8 +316,6 @@ namespace TDEngine2
 
 		TEntityId id = pEntity->GetId();
 
-		TOnEntityRemovedEvent onEntityRemoved;
-
 		onEntityRemoved.mRemovedEntityId = id;
 
 		if (RC_OK != (result = pEntity->Free())) /// \note Release the memory 
@@ -261,9 +323,7 @@ namespace TDEngine2
 			return result;
 		}
 
-		mActiveEntities[static_cast<U32>(id)] = nullptr;
-
-		mEntitiesHashTable.erase(id);
+		_releaseEntitySlot(id);
 
 		mpEventManager->Notify(&onEntityRemoved);
 
@@ -277,9 +337,21 @@ namespace TDEngine2
 		onComponentCreated.mEntityId               = entityId;
 		onComponentCreated.mCreatedComponentTypeId = componentTypeId;
 
+		_getComponentsTypes(entityId, onComponentCreated.mEntityComponentsTypes);
+
 		mpEventManager->Notify(&onComponentCreated);
 	}
 
+	void CEntityManager::_getComponentsTypes(TEntityId entityId, std::vector<TypeId>& outComponentsTypes) const
+	{
+		for (const IComponent* pCurrComponent : mpComponentManager->GetComponents(entityId))
+		{
+			outComponentsTypes.push_back(pCurrComponent->GetComponentTypeId());
+		}
+
+		std::sort(outComponentsTypes.begin(), outComponentsTypes.end());
+	}
+
 	void CEntityManager::_notifyOnRemovedComponent(TEntityId entityId, TypeId componentTypeId)
 	{
 		TOnComponentRemovedEvent onComponentRemoved;
@@ -287,6 +359,8 @@ namespace TDEngine2
 		onComponentRemoved.mEntityId               = entityId;
 		onComponentRemoved.mRemovedComponentTypeId = componentTypeId;
 
+		_getComponentsTypes(entityId, onComponentRemoved.mEntityComponentsTypes);
+
 		mpEventManager->Notify(&onComponentRemoved);
 	}
 	
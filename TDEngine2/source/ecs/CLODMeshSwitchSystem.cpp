@@ -13,6 +13,12 @@ namespace TDEngine2
 	CLODMeshSwitchSystem::CLODMeshSwitchSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CLODStrategyComponent, CStaticMeshContainer, CTransform>();
+		_addComponentsFilter<CLODStrategyComponent, CSkinnedMeshContainer, CTransform>();
+		_addComponentsFilter<CCamerasContextComponent>();
+
+		_addReadAccess<CLODStrategyComponent, CTransform, CCamerasContextComponent>();
+		_addWriteAccess<CStaticMeshContainer, CSkinnedMeshContainer>();
 	}
 
 	E_RESULT_CODE CLODMeshSwitchSystem::Init()
@@ -32,8 +38,8 @@ namespace TDEngine2
 		mStaticMeshesLODs = pWorld->CreateLocalComponentsSlice<CLODStrategyComponent, CStaticMeshContainer, CTransform>();
 		mSkinnedMeshesLODs = pWorld->CreateLocalComponentsSlice<CLODStrategyComponent, CSkinnedMeshContainer, CTransform>();
 
-		mpCamerasContext = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CCamerasContextComponent>())->GetComponent<CCamerasContextComponent>();
-		mpCurrActiveCameraTransform = pWorld->FindEntity(mpCamerasContext->GetActiveCameraEntityId())->GetComponent<CTransform>();
+		CEntity* pCamerasContextEntity = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CCamerasContextComponent>());
+		mpCamerasContext = pCamerasContextEntity ? pCamerasContextEntity->GetComponent<CCamerasContextComponent>() : nullptr;
 	}
 
 
@@ -76,8 +82,22 @@ namespace TDEngine2
 	{
 		TDE2_PROFILER_SCOPE("CLODMeshSwitchSystem::Update");
 
-		UpdateLODSEntities(mStaticMeshesLODs, mpCurrActiveCameraTransform, AssignMeshLODValues<CStaticMeshContainer>);
-		UpdateLODSEntities(mSkinnedMeshesLODs, mpCurrActiveCameraTransform, AssignMeshLODValues<CSkinnedMeshContainer>);
+		if (!mpCamerasContext)
+		{
+			return;
+		}
+
+		/// \note The camera's entity doesn't match the system's filters, so its transform is resolved each frame instead of being cached in InjectBindings
+		CEntity* pCameraEntity = pWorld->FindEntity(mpCamerasContext->GetActiveCameraEntityId());
+		CTransform* pCameraTransform = pCameraEntity ? pCameraEntity->GetComponent<CTransform>() : nullptr;
+
+		if (!pCameraTransform)
+		{
+			return;
+		}
+
+		UpdateLODSEntities(mStaticMeshesLODs, pCameraTransform, AssignMeshLODValues<CStaticMeshContainer>);
+		UpdateLODSEntities(mSkinnedMeshesLODs, pCameraTransform, AssignMeshLODValues<CSkinnedMeshContainer>);
 	}
 
 
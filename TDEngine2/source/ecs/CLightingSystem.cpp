@@ -1,5 +1,6 @@
 #include "../../include/ecs/CLightingSystem.h"
 #include "../../include/ecs/IWorld.h"
+#include "../../include/ecs/CWorld.h"
 #include "../../include/ecs/CEntity.h"
 #include "../../include/ecs/CTransform.h"
 #include "../../include/graphics/CStaticMesh.h"
@@ -8,8 +9,15 @@
 #include "../../include/graphics/CSkinnedMeshContainer.h"
 #include "../../include/graphics/IRenderer.h"
 #include "../../include/graphics/InternalShaderData.h"
+#include "../../include/graphics/ClusteredLighting.h"
+#include "../../include/graphics/ShadowCascades.h"
+#include "../../include/graphics/ICamera.h"
+#include "../../include/graphics/CPerspectiveCamera.h"
+#include "../../include/graphics/COrthoCamera.h"
+#include "../../include/graphics/CBaseCamera.h"
 #include "../../include/graphics/IGraphicsObjectManager.h"
 #include "../../include/graphics/IVertexDeclaration.h"
+#include "../../include/graphics/IVertexBuffer.h"
 #include "../../include/graphics/CRenderQueue.h"
 #include "../../include/graphics/CBaseMaterial.h"
 #include "../../include/graphics/CBaseRenderTarget.h"
@@ -19,8 +27,14 @@
 #include "../../include/scene/components/CDirectionalLight.h"
 #include "../../include/scene/components/CPointLight.h"
 #include "../../include/scene/components/ShadowMappingComponents.h"
+#include "../../include/ecs/components/CBoundsComponent.h"
+#include "../../include/math/TAABB.h"
 #include "../../include/utils/CFileLogger.h"
 #include "../../include/editor/CPerfProfiler.h"
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 
 namespace TDEngine2
@@ -28,6 +42,18 @@ namespace TDEngine2
 	CLightingSystem::CLightingSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CDirectionalLight, CTransform>();
+		_addComponentsFilter<CPointLight, CTransform>();
+		_addComponentsFilter<CShadowCasterComponent, CStaticMeshContainer, CTransform>();
+		_addComponentsFilter<CShadowCasterComponent, CSkinnedMeshContainer, CTransform>();
+		_addComponentsFilter<CShadowCasterComponent, CStaticMeshContainer, CTransform, CBoundsComponent>(); /// \note Bounds of casters are cached, they're added later by CBoundsUpdatingSystem
+		_addComponentsFilter<CShadowCasterComponent, CSkinnedMeshContainer, CTransform, CBoundsComponent>();
+		_addComponentsFilter<CShadowReceiverComponent, CStaticMeshContainer>();
+		_addComponentsFilter<CShadowReceiverComponent, CSkinnedMeshContainer>();
+
+		_addReadAccess<CDirectionalLight, CPointLight, CShadowCasterComponent, CShadowReceiverComponent, CStaticMeshContainer, CSkinnedMeshContainer, CTransform, CBoundsComponent>();
+		_addReadAccess<CPerspectiveCamera, COrthoCamera, CCamerasContextComponent>();
+		_requireMainThread(); /// \note Shadow maps are rendered and lighting data is passed into the renderer
 	}
 
 	E_RESULT_CODE CLightingSystem::Init(IRenderer* pRenderer, IGraphicsObjectManager* pGraphicsObjectManager)
@@ -58,6 +84,37 @@ namespace TDEngine2
 		return RC_OK;
 	}
 
+	/*!
+		\brief The function returns bounds of casters in the same order as they're stored in the given array. The bounds
+		could be nullptr until CBoundsUpdatingSystem adds them
+	*/
+
+	template <typename TMeshContainer>
+	static std::vector<CBoundsComponent*> GetShadowCastersBounds(IWorld* pWorld, const std::vector<TMeshContainer*>& meshContainers)
+	{
+		std::unordered_map<const TMeshContainer*, CBoundsComponent*> meshContainersBounds;
+
+		for (TEntityId currEntityId : pWorld->FindEntitiesWithComponents<CShadowCasterComponent, TMeshContainer, CTransform>())
+		{
+			if (CEntity* pEntity = pWorld->FindEntity(currEntityId))
+			{
+				meshContainersBounds.emplace(pEntity->GetComponent<TMeshContainer>(), pEntity->GetComponent<CBoundsComponent>());
+			}
+		}
+
+		std::vector<CBoundsComponent*> bounds;
+		bounds.reserve(meshContainers.size());
+
+		for (const TMeshContainer* pMeshContainer : meshContainers)
+		{
+			auto it = meshContainersBounds.find(pMeshContainer);
+			bounds.push_back((it != meshContainersBounds.cend()) ? it->second : nullptr);
+		}
+
+		return bounds;
+	}
+
+
 	void CLightingSystem::InjectBindings(IWorld* pWorld)
 	{
 		mDirectionalLightsContext = pWorld->CreateLocalComponentsSlice<CDirectionalLight, CTransform>();
@@ -66,6 +123,9 @@ namespace TDEngine2
 		mStaticShadowCastersContext  = pWorld->CreateLocalComponentsSlice<CShadowCasterComponent, CStaticMeshContainer, CTransform>();
 		mSkinnedShadowCastersContext = pWorld->CreateLocalComponentsSlice<CShadowCasterComponent, CSkinnedMeshContainer, CTransform>();
 
+		mStaticShadowCastersBounds  = GetShadowCastersBounds(pWorld, std::get<std::vector<CStaticMeshContainer*>>(mStaticShadowCastersContext.mComponentsSlice));
+		mSkinnedShadowCastersBounds = GetShadowCastersBounds(pWorld, std::get<std::vector<CSkinnedMeshContainer*>>(mSkinnedShadowCastersContext.mComponentsSlice));
+
 		mStaticShadowReceiversContext = pWorld->CreateLocalComponentsSlice<CShadowReceiverComponent, CStaticMeshContainer>();
 		mSkinnedShadowReceiversContext = pWorld->CreateLocalComponentsSlice<CShadowReceiverComponent, CSkinnedMeshContainer>();
 	}
@@ -77,6 +137,7 @@ namespace TDEngine2
 		IVertexDeclaration* mpVertexDeclaration;
 		TResourceId         mMaterialId;
 		U32                 mDrawIndex;
+		U32                 mCascadeIndex;
 		CRenderQueue*       mpRenderQueue;
 	};
 
@@ -112,7 +173,7 @@ namespace TDEngine2
 
 			auto&& subMeshInfo = pStaticMeshContainer->GetSubMeshInfo();
 
-			if (TDrawIndexedCommand* pDrawCommand = params.mpRenderQueue->SubmitDrawCommand<TDrawIndexedCommand>(params.mDrawIndex))
+			if (TDrawIndexedCommand* pDrawCommand = params.mpRenderQueue->SubmitDrawCommand<TDrawIndexedCommand>(MakeShadowCasterSortKey(params.mCascadeIndex, params.mDrawIndex)))
 			{
 				pDrawCommand->mpVertexBuffer = pStaticMeshResource->GetPositionOnlyVertexBuffer();
 				pDrawCommand->mpIndexBuffer = pStaticMeshResource->GetSharedIndexBuffer();
@@ -175,7 +236,7 @@ namespace TDEngine2
 
 			auto&& subMeshInfo = pSkinnedMeshContainer->GetSubMeshInfo();
 
-			if (TDrawIndexedCommand* pDrawCommand = params.mpRenderQueue->SubmitDrawCommand<TDrawIndexedCommand>(params.mDrawIndex))
+			if (TDrawIndexedCommand* pDrawCommand = params.mpRenderQueue->SubmitDrawCommand<TDrawIndexedCommand>(MakeShadowCasterSortKey(params.mCascadeIndex, params.mDrawIndex)))
 			{
 				pDrawCommand->mpVertexBuffer = pSkinnedMeshResource->GetPositionOnlyVertexBuffer();
 				pDrawCommand->mpIndexBuffer = pSkinnedMeshResource->GetSharedIndexBuffer();
@@ -194,27 +255,7 @@ namespace TDEngine2
 	}
 
 
-	static TMatrix4 ConstructSunLightMatrix(IGraphicsContext* pGraphicsContext, CTransform* pLightTransform)
-	{
-		if (!pLightTransform)
-		{
-			TDE2_ASSERT(false);
-			return IdentityMatrix4;
-		}
-
-		const F32 handedness = pGraphicsContext->GetPositiveZAxisDirection();
-
-		TMatrix4 viewMatrix = LookAt(handedness * pLightTransform->GetPosition(), UpVector3, ZeroVector3, -handedness);
-
-		const F32 halfSize = 10.0f;
-
-		TMatrix4 projMatrix = pGraphicsContext->CalcOrthographicMatrix(-halfSize, halfSize, halfSize, -halfSize, 0.001f, 1000.0f); // \todo Refactor
-
-		return Transpose(Mul(projMatrix, viewMatrix));
-	}
-
-
-	static void ProcessDirectionalLights(IGraphicsContext* pGraphicsContext, TLightingShaderData& lightingData, CLightingSystem::TDirLightsContext& directionalLightsContext)
+	static void ProcessDirectionalLights(TLightingShaderData& lightingData, CLightingSystem::TDirLightsContext& directionalLightsContext)
 	{
 		TDE2_PROFILER_SCOPE("CLightingSystem::ProcessDirectionalLights");
 
@@ -247,49 +288,276 @@ namespace TDEngine2
 			lightingData.mSunLightDirection      = Normalize(TVector4(pLightTransform->GetForwardVector(), 0.0f)); //TVector4(Normalize(pSunLight->GetDirection()), 0.0f);
 			lightingData.mSunLightPosition       = TVector4(pLightTransform->GetPosition(), 1.0f);
 			lightingData.mSunLightColor          = pCurrLight->GetColor();
-			lightingData.mSunLightMatrix         = ConstructSunLightMatrix(pGraphicsContext, pLightTransform);
 			lightingData.mIsShadowMappingEnabled = static_cast<U32>(CProjectSettings::Get()->mGraphicsSettings.mRendererSettings.mIsShadowMappingEnabled);
 		}
 	}
 
 
-	static void ProcessPointLights(TLightingShaderData& lightingData, CLightingSystem::TPointLightsContext& pointLightsContext)
+	static constexpr U32 FirstCachedShadowCascadeIndex = 1; ///< Cascades starting from this one are redrawn only when they're invalidated
+	static constexpr F32 CachedShadowCascadeMargin     = 0.25f;
+	static constexpr F32 ShadowCascadesSplitLambda     = 0.75f;
+
+
+	static U32 ProcessShadowCascades(IGraphicsContext* pGraphicsContext, const ICamera* pCamera, TLightingShaderData& lightingData, CLightingSystem::TShadowCascadeState cascades[])
+	{
+		TDE2_PROFILER_SCOPE("CLightingSystem::ProcessShadowCascades");
+
+		const auto& rendererSettings = CProjectSettings::Get()->mGraphicsSettings.mRendererSettings;
+
+		const U32 cascadesCount = std::max<U32>(1, std::min<U32>(rendererSettings.mShadowCascadesCount, MaxShadowCascadesCount));
+		lightingData.mShadowCascadesCount = cascadesCount;
+
+		for (U32 i = cascadesCount; i < MaxShadowCascadesCount; ++i)
+		{
+			cascades[i].mIsValid = false;
+		}
+
+		if (!pCamera || !lightingData.mIsShadowMappingEnabled)
+		{
+			lightingData.mIsShadowMappingEnabled = false;
+			return 0;
+		}
+
+		const F32 ndcZMin = pGraphicsContext->GetContextInfo().mNDCBox.min.z;
+
+		const F32 zNear = pCamera->GetNearPlane();
+		const F32 zFar = pCamera->GetFarPlane();
+		const F32 shadowsDistance = std::max<F32>(std::min<F32>(rendererSettings.mShadowsDistance, zFar), zNear + 1.0f);
+
+		F32 splits[MaxShadowCascadesCount];
+		ComputeShadowCascadesSplits(zNear, shadowsDistance, cascadesCount, ShadowCascadesSplitLambda, splits);
+
+		lightingData.mShadowCascadesSplits = TVector4(splits[0], splits[1], splits[2], splits[3]);
+
+		const TVector3 lightDirection(lightingData.mSunLightDirection.x, lightingData.mSunLightDirection.y, lightingData.mSunLightDirection.z);
+
+		U32 changedCascadesMask = 0;
+
+		for (U32 i = 0; i < cascadesCount; ++i)
+		{
+			auto& currCascade = cascades[i];
+
+			const TShadowCascadeBounds sliceBounds = ComputeShadowCascadeBounds(pCamera->GetProjMatrix(), pCamera->GetViewMatrix(), ndcZMin, zNear, zFar, i ? splits[i - 1] : zNear, splits[i]);
+
+			bool hasBoundsChanged = true;
+
+			if (i < FirstCachedShadowCascadeIndex)
+			{
+				currCascade.mBounds = sliceBounds;
+			}
+			else
+			{
+				hasBoundsChanged = UpdateCachedShadowCascadeBounds(sliceBounds, CachedShadowCascadeMargin, currCascade.mBounds);
+			}
+
+			/// \note The matrix is recomputed only on changes, so cached cascades are sampled with exactly the same values they were rendered with
+			if (hasBoundsChanged || !currCascade.mIsValid || (currCascade.mLightDirection != lightDirection) || (currCascade.mShadowMapSizes != rendererSettings.mShadowMapSizes))
+			{
+				currCascade.mMatrix         = ComputeShadowCascadeMatrix(lightDirection, currCascade.mBounds, shadowsDistance, rendererSettings.mShadowMapSizes, ndcZMin);
+				currCascade.mLightDirection = lightDirection;
+				currCascade.mShadowMapSizes = rendererSettings.mShadowMapSizes;
+				currCascade.mIsValid        = true;
+
+				changedCascadesMask |= (1 << i);
+			}
+
+			lightingData.mShadowCascadesMatrices[i] = Transpose(currCascade.mMatrix);
+		}
+
+		lightingData.mSunLightMatrix = lightingData.mShadowCascadesMatrices[0];
+
+		return changedCascadesMask;
+	}
+
+
+	static inline bool IsStaticShadowCaster(const CStaticMeshContainer* pMeshContainer)
+	{
+		return pMeshContainer->IsStatic();
+	}
+
+
+	static inline bool IsStaticShadowCaster(const CSkinnedMeshContainer*)
+	{
+		return false; /// \note Animated meshes change their shapes every frame
+	}
+
+
+	static inline U32 CombineHash(U32 hash, U32 value)
+	{
+		return hash ^ (value + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+	}
+
+
+	static U32 ComputeStaticCasterHash(const void* pCaster, const TAABB& bounds)
+	{
+		const F32 boundsValues[6] { bounds.min.x, bounds.min.y, bounds.min.z, bounds.max.x, bounds.max.y, bounds.max.z };
+
+		const U64 casterAddress = static_cast<U64>(reinterpret_cast<uintptr_t>(pCaster));
+
+		U32 hash = CombineHash(static_cast<U32>(casterAddress), static_cast<U32>(casterAddress >> 32));
+
+		for (F32 currValue : boundsValues)
+		{
+			U32 valueBits = 0;
+			memcpy(&valueBits, &currValue, sizeof(valueBits));
+
+			hash = CombineHash(hash, valueBits);
+		}
+
+		return hash;
+	}
+
+
+	/*!
+		\brief The function culls casters against volumes of cascades. A caster without bounds is considered as a dynamic one
+		which is visible within all cascades
+
+		\param[out] castersCascades A mask of cascades for each caster
+		\param[in, out] dynamicCastersMask Cascades that contain non-static casters
+		\param[in, out] staticCastersHashes Hashes of static casters for each cascade
+	*/
+
+	template <typename TMeshContainer>
+	static void CullShadowCastersByCascades(const std::vector<TMeshContainer*>& meshContainers, const std::vector<CBoundsComponent*>& bounds, 
+											const CLightingSystem::TShadowCascadeState cascades[], U32 cascadesCount, F32 ndcZMin, std::vector<U8>& castersCascades,
+											U32& dynamicCastersMask, std::array<U32, MaxShadowCascadesCount>& staticCastersHashes)
+	{
+		TDE2_ASSERT(meshContainers.size() == bounds.size());
+
+		const U8 allCascadesMask = static_cast<U8>((1 << cascadesCount) - 1);
+
+		castersCascades.resize(meshContainers.size());
+
+		for (USIZE i = 0; i < meshContainers.size(); ++i)
+		{
+			const TMeshContainer* pMeshContainer = meshContainers[i];
+			const CBoundsComponent* pBounds = (i < bounds.size()) ? bounds[i] : nullptr;
+
+			if (!pMeshContainer || !pBounds)
+			{
+				castersCascades[i] = pMeshContainer ? allCascadesMask : 0;
+				dynamicCastersMask |= castersCascades[i];
+
+				continue;
+			}
+
+			const TAABB& casterBounds = pBounds->GetBounds();
+			const bool isStatic = IsStaticShadowCaster(pMeshContainer);
+
+			U8 currCascadesMask = 0;
+
+			for (U32 k = 0; k < cascadesCount; ++k)
+			{
+				if (!TestShadowCascadeAABB(cascades[k].mMatrix, casterBounds, ndcZMin))
+				{
+					continue;
+				}
+
+				currCascadesMask |= (1 << k);
+
+				if (isStatic)
+				{
+					staticCastersHashes[k] = CombineHash(staticCastersHashes[k], ComputeStaticCasterHash(pMeshContainer, casterBounds));
+				}
+			}
+
+			castersCascades[i] = currCascadesMask;
+
+			if (!isStatic)
+			{
+				dynamicCastersMask |= currCascadesMask;
+			}
+		}
+	}
+
+
+
+	/*!
+		\brief The function takes visible point lights that are the nearest to the camera, so MaxPointLightsCount drops far ones
+		instead of ones that go last in the components' order. Taken lights are ordered by distance, AssignPointLightsToClusters
+		truncates overflowed clusters in the same order
+
+		\param[in, out] candidates A temporary storage which is reused between frames
+	*/
+
+	static void ProcessPointLights(IWorld* pWorld, const ICamera* pCamera, TLightClustersShaderData& lightClustersData, CLightingSystem::TPointLightsContext& pointLightsContext,
+								   std::vector<std::pair<F32, U32>>& candidates)
 	{
 		TDE2_PROFILER_SCOPE("CLightingSystem::ProcessPointLights");
 
 		const auto& transforms = std::get<std::vector<CTransform*>>(pointLightsContext.mComponentsSlice);
 		const auto& lights = std::get<std::vector<CPointLight*>>(pointLightsContext.mComponentsSlice);
 
-		lightingData.mPointLightsCount = std::min<U32>(MaxPointLightsCount, static_cast<U32>(lights.size()));
+		lightClustersData.mPointLightsCount = 0;
 
-		auto& pointLights = lightingData.mPointLights;
+		if (!pCamera)
+		{
+			std::fill(std::begin(lightClustersData.mClusters), std::end(lightClustersData.mClusters), 0);
+			return;
+		}
 
-		for (USIZE i = 0; i < transforms.size(); ++i)
+		const IFrustum* pFrustum = pCamera->GetFrustum();
+		const TVector3& cameraPosition = pCamera->GetPosition();
+
+		candidates.clear();
+
+		/// \note Lights outside of the frustum are skipped, so MaxPointLightsCount limits only visible ones
+		for (USIZE i = 0; i < lights.size(); ++i)
 		{
-			auto& currPointLight = pointLights[i];
+			const TVector3 position = transforms[i]->GetPosition();
 
-			CTransform* pLightTransform = transforms[i];
-			CPointLight* pLight = lights[i];
+			if (pFrustum && !pFrustum->TestSphere(position, lights[i]->GetRange()))
+			{
+				continue;
+			}
 
-			currPointLight.mPosition = TVector4(pLightTransform->GetPosition(), 1.0f);
+			const TVector3 toLight = position - cameraPosition;
+			candidates.emplace_back(Dot(toLight, toLight), static_cast<U32>(i));
+		}
+
+		const USIZE takenLightsCount = std::min<USIZE>(candidates.size(), MaxPointLightsCount);
+
+		std::partial_sort(candidates.begin(), candidates.begin() + takenLightsCount, candidates.end());
+
+		for (USIZE k = 0; k < takenLightsCount; ++k)
+		{
+			const U32 lightIndex = candidates[k].second;
+
+			CPointLight* pLight = lights[lightIndex];
+			const TVector3 position = transforms[lightIndex]->GetPosition();
+
+			auto& currPointLight = lightClustersData.mPointLights[lightClustersData.mPointLightsCount++];
+
+			currPointLight.mPosition = TVector4(position, 1.0f);
 			currPointLight.mColor = pLight->GetColor();
 			currPointLight.mIntensity = pLight->GetIntensity();
 			currPointLight.mRange = pLight->GetRange();
 		}
+
+		TDE2_PROFILER_COUNTER("CLightingSystem::VisiblePointLights", static_cast<F32>(lightClustersData.mPointLightsCount));
+		TDE2_PROFILER_COUNTER("CLightingSystem::DroppedPointLights", static_cast<F32>(candidates.size() - takenLightsCount));
+
+		const U32 clustersIndicesCount = AssignPointLightsToClusters(pWorld, pCamera->GetViewMatrix(), pCamera->GetProjMatrix(), pCamera->GetNearPlane(), pCamera->GetFarPlane(), lightClustersData);
+
+		TDE2_PROFILER_COUNTER("CLightingSystem::LightClustersIndices", static_cast<F32>(clustersIndicesCount));
 	}
 
 
 	template <typename TRenderable>
-	static void ProcessShadowReceivers(TPtr<IResourceManager> pResourceManager, const std::vector<TRenderable*> shadowReceivers, TPtr<ITexture> pShadowMapTexture)
+	static void ProcessShadowReceivers(TPtr<IResourceManager> pResourceManager, const std::vector<TRenderable*>& shadowReceivers, 
+									std::array<TPtr<ITexture>, MaxShadowCascadesCount>& shadowMapsTextures, U32 cascadesCount)
 	{
-		// \note Inject shadow map buffer into materials 
+		// \note Inject shadow maps' buffers into materials 
 		for (USIZE i = 0; i < shadowReceivers.size(); ++i)
 		{
 			if (TRenderable* pMeshContainer = shadowReceivers[i])
 			{
 				if (auto pMaterial = pResourceManager->GetResource<IMaterial>(pResourceManager->Load<IMaterial>(pMeshContainer->GetMaterialName())))
 				{
-					pMaterial->SetTextureResource("DirectionalShadowMapTexture", pShadowMapTexture.Get());
+					for (U32 k = 0; k < cascadesCount; ++k)
+					{
+						pMaterial->SetTextureResource(GetShadowMapCascadeSamplerName(k), shadowMapsTextures[k].Get());
+					}
 				}
 			}
 		}
@@ -301,41 +569,109 @@ namespace TDEngine2
 		TDE2_PROFILER_SCOPE("CLightingSystem::Update");
 		TDE2_ASSERT(mpRenderer);
 
+		ICamera* pCamera = GetCurrentActiveCamera(pWorld);
+
 		TLightingShaderData lightingData;
 
-		ProcessDirectionalLights(mpGraphicsContext, lightingData, mDirectionalLightsContext);
-		ProcessPointLights(lightingData, mPointLightsContext);
+		ProcessDirectionalLights(lightingData, mDirectionalLightsContext);
+		ProcessPointLights(pWorld, pCamera, mLightClustersData, mPointLightsContext, mPointLightsCandidates);
+
+		const U32 changedCascadesMask = ProcessShadowCascades(mpGraphicsContext, pCamera, lightingData, mShadowCascades);
+		const U32 cascadesCount = lightingData.mShadowCascadesCount;
 
 		if (mpRenderer)
 		{
 			PANIC_ON_FAILURE(mpRenderer->SetLightingData(lightingData));
+			PANIC_ON_FAILURE(mpRenderer->SetLightClustersData(mLightClustersData));
+		}
+
+		if (!lightingData.mIsShadowMappingEnabled)
+		{
+			return;
+		}
+
+		U32 cascadesUpdateMask = 0;
+
+		// \note Find out which cascades contain casters, cached cascades are redrawn only if their volumes or static casters within them have changed
+		{
+			TDE2_PROFILER_SCOPE("CLightingSystem::CullShadowCasters");
+
+			const F32 ndcZMin = mpGraphicsContext->GetContextInfo().mNDCBox.min.z;
+
+			U32 dynamicCastersMask = 0;
+			std::array<U32, MaxShadowCascadesCount> staticCastersHashes {};
+
+			CullShadowCastersByCascades(std::get<std::vector<CStaticMeshContainer*>>(mStaticShadowCastersContext.mComponentsSlice), mStaticShadowCastersBounds,
+										mShadowCascades, cascadesCount, ndcZMin, mStaticShadowCastersCascades, dynamicCastersMask, staticCastersHashes);
+			CullShadowCastersByCascades(std::get<std::vector<CSkinnedMeshContainer*>>(mSkinnedShadowCastersContext.mComponentsSlice), mSkinnedShadowCastersBounds,
+										mShadowCascades, cascadesCount, ndcZMin, mSkinnedShadowCastersCascades, dynamicCastersMask, staticCastersHashes);
+
+			cascadesUpdateMask = changedCascadesMask | ((1 << FirstCachedShadowCascadeIndex) - 1);
+			cascadesUpdateMask |= UpdateShadowCascadesCastersState(cascadesCount, dynamicCastersMask, staticCastersHashes.data(), mShadowCascadesCastersState);
+
+			cascadesUpdateMask &= (1 << cascadesCount) - 1;
+
+			mpRenderer->SetShadowCascadesUpdateMask(cascadesUpdateMask);
 		}
 
 		U32 drawIndex = 0;
 
-		// \note Prepare commands for the renderer
+		mUsedShadowInstancesBuffersCount = 0;
+
+		/// \note Static casters are instanced if the shadow pass's shader has the instanced variant
+		auto pShadowPassMaterial = mpResourceManager->GetResource<IMaterial>(mShadowPassMaterialHandle);
+		const bool isShadowCastersInstancingEnabled = pShadowPassMaterial && pShadowPassMaterial->IsInstancingEnabled();
+
+		// \note Prepare commands for the renderer. Commands are built only for cascades that will be redrawn
 		{
 			TDE2_PROFILER_SCOPE("CLightingSystem::ProcessShadowCasters");
 
-			for (USIZE i = 0; i < mStaticShadowCastersContext.mComponentsCount; ++i)
+			for (U32 cascadeIndex = 0; cascadeIndex < cascadesCount; ++cascadeIndex)
 			{
-				drawIndex = ProcessStaticMeshCasterEntity({ mpResourceManager.Get(), mpShadowVertDecl, mShadowPassMaterialHandle, drawIndex, mpShadowPassRenderQueue }, mStaticShadowCastersContext, i);
-			}
+				const U8 cascadeMask = static_cast<U8>(1 << cascadeIndex);
 
-			for (USIZE i = 0; i < mSkinnedShadowCastersContext.mComponentsCount; ++i)
-			{
-				drawIndex = ProcessSkinnedMeshCasterEntity({ mpResourceManager.Get(), mpSkinnedShadowVertDecl, mShadowPassSkinnedMaterialHandle, drawIndex, mpShadowPassRenderQueue }, mSkinnedShadowCastersContext, i);
+				if (!(cascadesUpdateMask & cascadeMask))
+				{
+					continue;
+				}
+
+				if (isShadowCastersInstancingEnabled)
+				{
+					drawIndex = _processInstancedStaticShadowCasters(cascadeIndex, drawIndex);
+				}
+				else
+				{
+					for (USIZE i = 0; i < mStaticShadowCastersContext.mComponentsCount; ++i)
+					{
+						if (mStaticShadowCastersCascades[i] & cascadeMask)
+						{
+							drawIndex = ProcessStaticMeshCasterEntity({ mpResourceManager.Get(), mpShadowVertDecl, mShadowPassMaterialHandle, drawIndex, cascadeIndex, mpShadowPassRenderQueue }, mStaticShadowCastersContext, i);
+						}
+					}
+				}
+
+				for (USIZE i = 0; i < mSkinnedShadowCastersContext.mComponentsCount; ++i)
+				{
+					if (mSkinnedShadowCastersCascades[i] & cascadeMask)
+					{
+						drawIndex = ProcessSkinnedMeshCasterEntity({ mpResourceManager.Get(), mpSkinnedShadowVertDecl, mShadowPassSkinnedMaterialHandle, drawIndex, cascadeIndex, mpShadowPassRenderQueue }, mSkinnedShadowCastersContext, i);
+					}
+				}
 			}
 		}
 
-		if (CProjectSettings::Get()->mGraphicsSettings.mRendererSettings.mIsShadowMappingEnabled)
 		{
 			TDE2_PROFILER_SCOPE("CLightingSystem::ProcessShadowReceivers");
 
-			auto pShadowMapTexture = mpResourceManager->GetResource<ITexture>(mpResourceManager->Load<IDepthBufferTarget>("ShadowMap"));
+			std::array<TPtr<ITexture>, MaxShadowCascadesCount> shadowMapsTextures;
+
+			for (U32 i = 0; i < cascadesCount; ++i)
+			{
+				shadowMapsTextures[i] = mpResourceManager->GetResource<ITexture>(mpResourceManager->Load<IDepthBufferTarget>(GetShadowMapCascadeResourceName(i)));
+			}
 
-			ProcessShadowReceivers(mpResourceManager, std::get<std::vector<CStaticMeshContainer*>>(mStaticShadowReceiversContext.mComponentsSlice), pShadowMapTexture);
-			ProcessShadowReceivers(mpResourceManager, std::get<std::vector<CSkinnedMeshContainer*>>(mSkinnedShadowReceiversContext.mComponentsSlice), pShadowMapTexture);
+			ProcessShadowReceivers(mpResourceManager, std::get<std::vector<CStaticMeshContainer*>>(mStaticShadowReceiversContext.mComponentsSlice), shadowMapsTextures, cascadesCount);
+			ProcessShadowReceivers(mpResourceManager, std::get<std::vector<CSkinnedMeshContainer*>>(mSkinnedShadowReceiversContext.mComponentsSlice), shadowMapsTextures, cascadesCount);
 		}
 	}
 
@@ -362,6 +698,21 @@ namespace TDEngine2
 			mpShadowVertDecl->AddElement({ FT_FLOAT4, 0, VEST_POSITION });
 		}
 
+		if (auto newVertDeclResult = mpGraphicsObjectManager->CreateVertexDeclaration())
+		{
+			mpInstancedShadowVertDecl = newVertDeclResult.Get();
+
+			mpInstancedShadowVertDecl->AddElement({ FT_FLOAT4, 0, VEST_POSITION });
+
+			/// \note A model matrix per instance, see TDE2_INSTANCE_MATRIX in TDEngine2Globals.inc
+			for (U32 i = 0; i < 4; ++i)
+			{
+				mpInstancedShadowVertDecl->AddElement({ FT_FLOAT4, 1, VEST_TEXCOORDS, true });
+			}
+
+			mpInstancedShadowVertDecl->AddInstancingDivisor(1, 1);
+		}
+
 		if (auto newVertDeclResult = mpGraphicsObjectManager->CreateVertexDeclaration())
 		{
 			mpSkinnedShadowVertDecl = newVertDeclResult.Get();
@@ -379,7 +730,114 @@ namespace TDEngine2
 		mShadowPassMaterialHandle        = mpResourceManager->Create<IMaterial>("ShadowPassMaterial.material", shadowPassMaterialParams);
 		mShadowPassSkinnedMaterialHandle = mpResourceManager->Create<IMaterial>("ShadowPassSkinnedMaterial.material", shadowPassSkinnedMaterialParams);
 
-		return (mShadowPassMaterialHandle != TResourceId::Invalid && mpShadowPassRenderQueue && mpShadowVertDecl) ? RC_OK : RC_FAIL;
+		return (mShadowPassMaterialHandle != TResourceId::Invalid && mpShadowPassRenderQueue && mpShadowVertDecl && mpInstancedShadowVertDecl) ? RC_OK : RC_FAIL;
+	}
+
+	U32 CLightingSystem::_processInstancedStaticShadowCasters(U32 cascadeIndex, U32 drawIndex)
+	{
+		const U8 cascadeMask = static_cast<U8>(1 << cascadeIndex);
+
+		auto&& staticMeshContainers = std::get<std::vector<CStaticMeshContainer*>>(mStaticShadowCastersContext.mComponentsSlice);
+		auto&& transforms = std::get<std::vector<CTransform*>>(mStaticShadowCastersContext.mComponentsSlice);
+
+		for (USIZE i = 0; i < mStaticShadowCastersContext.mComponentsCount; ++i)
+		{
+			CStaticMeshContainer* pStaticMeshContainer = staticMeshContainers[i];
+			if (!pStaticMeshContainer || !(mStaticShadowCastersCascades[i] & cascadeMask))
+			{
+				continue;
+			}
+
+			const TResourceId meshResourceHandle = mpResourceManager->Load<IStaticMesh>(pStaticMeshContainer->GetMeshName());
+
+			auto pStaticMeshResource = mpResourceManager->GetResource<IStaticMesh>(meshResourceHandle);
+			if (!pStaticMeshResource || (E_RESOURCE_STATE_TYPE::RST_LOADED != mpResourceManager->GetResource(meshResourceHandle)->GetState()))
+			{
+				continue;
+			}
+
+			auto&& subMeshInfo = pStaticMeshContainer->GetSubMeshInfo();
+
+			/// \note Casters are grouped by the mesh and the submesh, the material is the same for all of them
+			const U64 batchKey = (static_cast<U64>(static_cast<U32>(meshResourceHandle)) << 32) | static_cast<U64>(subMeshInfo.mStartIndex);
+
+			TShadowCastersBatch& currBatch = mShadowCastersBatches[batchKey];
+
+			if (currBatch.mModelMatrices.empty())
+			{
+				mActiveShadowCastersBatches.push_back(&currBatch);
+
+				currBatch.mpVertexBuffer = pStaticMeshResource->GetPositionOnlyVertexBuffer();
+				currBatch.mpIndexBuffer  = pStaticMeshResource->GetSharedIndexBuffer();
+				currBatch.mStartIndex    = subMeshInfo.mStartIndex;
+				currBatch.mIndicesCount  = subMeshInfo.mIndicesCount;
+			}
+
+			currBatch.mModelMatrices.push_back(Transpose(transforms[i]->GetLocalToWorldTransform()));
+		}
+
+		const U32 maxInstancesPerDrawCall = StaticMeshInstanceDataBufferSize / sizeof(TMatrix4);
+
+		for (TShadowCastersBatch* pCurrBatch : mActiveShadowCastersBatches)
+		{
+			const U32 instancesCount = static_cast<U32>(pCurrBatch->mModelMatrices.size());
+
+			for (U32 firstInstanceIndex = 0; firstInstanceIndex < instancesCount; firstInstanceIndex += maxInstancesPerDrawCall)
+			{
+				const U32 currInstancesCount = std::min(maxInstancesPerDrawCall, instancesCount - firstInstanceIndex);
+
+				IVertexBuffer* pInstancesBuffer = _getShadowInstancesBuffer();
+				if (!pInstancesBuffer || (RC_OK != pInstancesBuffer->Map(BMT_WRITE_DISCARD)))
+				{
+					break;
+				}
+
+				pInstancesBuffer->Write(&pCurrBatch->mModelMatrices[firstInstanceIndex], currInstancesCount * sizeof(TMatrix4));
+				pInstancesBuffer->Unmap();
+
+				auto pCommand = mpShadowPassRenderQueue->SubmitDrawCommand<TDrawIndexedInstancedCommand>(MakeShadowCasterSortKey(cascadeIndex, drawIndex++));
+
+				pCommand->mpVertexBuffer              = pCurrBatch->mpVertexBuffer;
+				pCommand->mpIndexBuffer               = pCurrBatch->mpIndexBuffer;
+				pCommand->mpInstancingBuffer          = pInstancesBuffer;
+				pCommand->mMaterialHandle             = mShadowPassMaterialHandle;
+				pCommand->mpVertexDeclaration         = mpInstancedShadowVertDecl;
+				pCommand->mPrimitiveType              = E_PRIMITIVE_TOPOLOGY_TYPE::PTT_TRIANGLE_LIST;
+				pCommand->mBaseVertexIndex            = 0;
+				pCommand->mStartIndex                 = pCurrBatch->mStartIndex;
+				pCommand->mIndicesPerInstance         = pCurrBatch->mIndicesCount;
+				pCommand->mStartInstance              = 0;
+				pCommand->mNumOfInstances             = currInstancesCount;
+				pCommand->mObjectData.mModelMatrix    = IdentityMatrix4; /// \note Transforms are read from the instances buffer
+				pCommand->mObjectData.mInvModelMatrix = IdentityMatrix4;
+			}
+
+			pCurrBatch->mModelMatrices.clear();
+		}
+
+		mActiveShadowCastersBatches.clear();
+
+		return drawIndex;
+	}
+
+	IVertexBuffer* CLightingSystem::_getShadowInstancesBuffer()
+	{
+		if (mUsedShadowInstancesBuffersCount < static_cast<U32>(mShadowInstancesBuffers.size()))
+		{
+			return mShadowInstancesBuffers[mUsedShadowInstancesBuffersCount++];
+		}
+
+		auto createBufferResult = mpGraphicsObjectManager->CreateVertexBuffer(BUT_DYNAMIC, StaticMeshInstanceDataBufferSize, nullptr);
+		if (createBufferResult.HasError())
+		{
+			LOG_ERROR("[CLightingSystem] Couldn't create a buffer for shadow casters' instances data");
+			return nullptr;
+		}
+
+		mShadowInstancesBuffers.push_back(createBufferResult.Get());
+		++mUsedShadowInstancesBuffersCount;
+
+		return mShadowInstancesBuffers.back();
 	}
 
 
@@ -17,6 +17,11 @@ namespace TDEngine2
 	CMeshAnimatorUpdatingSystem::CMeshAnimatorUpdatingSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CSkinnedMeshContainer, CMeshAnimatorComponent, CAnimationContainerComponent, CBoundsComponent>();
+
+		_addReadAccess<CAnimationContainerComponent>();
+		_addWriteAccess<CSkinnedMeshContainer, CMeshAnimatorComponent, CBoundsComponent>();
+		_requireMainThread(); /// \note Skeletons are loaded during the update
 	}
 
 	E_RESULT_CODE CMeshAnimatorUpdatingSystem::Init(IResourceManager* pResourceManager)
@@ -51,18 +56,34 @@ namespace TDEngine2
 		auto& animationContainers   = std::get<std::vector<CAnimationContainerComponent*>>(mEntitiesContext.mComponentsSlice);
 		auto& animators             = std::get<std::vector<CMeshAnimatorComponent*>>(mEntitiesContext.mComponentsSlice);
 		auto& bounds                = std::get<std::vector<CBoundsComponent*>>(mEntitiesContext.mComponentsSlice);
-		
-		for (USIZE i = 0; i < mEntitiesContext.mComponentsCount; ++i)
-		{
-			CSkinnedMeshContainer* pMeshContainer = skinnedMeshContainers[i];
-			const TResourceId skeletonResourceId = mpResourceManager->Load<ISkeleton>(pMeshContainer->GetSkeletonName());
 
+		/// \note Skeletons are resolved on the main thread, because a synchronous loading of a resource could touch the graphics context
+		mpSkeletons.assign(skinnedMeshContainers.size(), nullptr);
+
+		for (USIZE i = 0; i < skinnedMeshContainers.size(); ++i)
+		{
+			const TResourceId skeletonResourceId = mpResourceManager->Load<ISkeleton>(skinnedMeshContainers[i]->GetSkeletonName());
 			if (TResourceId::Invalid == skeletonResourceId)
 			{
 				continue;
 			}
 
-			auto pSkeleton = mpResourceManager->GetResource<ISkeleton>(skeletonResourceId);
+			if (auto pSkeleton = mpResourceManager->GetResource<ISkeleton>(skeletonResourceId))
+			{
+				mpSkeletons[i] = pSkeleton.Get();
+			}
+		}
+		
+		/// \note Each entity owns its poses, skeletons are only read here, so entities are processed in parallel
+		pWorld->ParallelForEach(mEntitiesContext, [this, &skinnedMeshContainers, &animationContainers, &animators, &bounds](USIZE i)
+		{
+			ISkeleton* pSkeleton = mpSkeletons[i];
+			if (!pSkeleton)
+			{
+				return;
+			}
+
+			CSkinnedMeshContainer* pMeshContainer = skinnedMeshContainers[i];
 
 			CMeshAnimatorComponent* pMeshAnimator = animators[i];
 			auto& updatedJointsPose = pMeshAnimator->GetCurrAnimationPose();
@@ -114,29 +135,26 @@ namespace TDEngine2
 			/// \note Update matrices for the mesh
 			auto& currAnimationPose = pMeshContainer->GetCurrentAnimationPose();
 
-			if (TResourceId::Invalid != skeletonResourceId)
-			{
-				/// \todo Refactor this fragment later
-				currAnimationPose.clear();
+			/// \todo Refactor this fragment later
+			currAnimationPose.clear();
 
-				U32 index = 0;
+			U32 index = 0;
 
-				pSkeleton->ForEachJoint([&currAnimationPose, &updatedJointsPose, &index](TJoint* pJoint)
+			pSkeleton->ForEachJoint([&currAnimationPose, &updatedJointsPose, &index](TJoint* pJoint)
+			{
+				if (currAnimationPose.size() <= pJoint->mIndex + 1)
 				{
-					if (currAnimationPose.size() <= pJoint->mIndex + 1)
-					{
-						currAnimationPose.resize(pJoint->mIndex + 1);
-					}
+					currAnimationPose.resize(pJoint->mIndex + 1);
+				}
 
-					currAnimationPose[pJoint->mIndex] = Transpose(Mul(updatedJointsPose[pJoint->mIndex], pJoint->mInvBindTransform));
-				});
-			}
+				currAnimationPose[pJoint->mIndex] = Transpose(Mul(updatedJointsPose[pJoint->mIndex], pJoint->mInvBindTransform));
+			});
 
 			if (auto pBounds = bounds[i])
 			{
 				pBounds->SetDirty(true);
 			}
-		}
+		});
 	}
 
 
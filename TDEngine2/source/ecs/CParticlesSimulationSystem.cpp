@@ -7,11 +7,12 @@
 #include "../../include/graphics/effects/CParticleEmitterComponent.h"
 #include "../../include/graphics/effects/CParticleEffect.h"
 #include "../../include/ecs/CTransform.h"
-#include "../../include/ecs/IWorld.h"
+#include "../../include/ecs/CWorld.h"
 #include "../../include/ecs/CEntity.h"
 #include "../../include/core/IResourceManager.h"
 #include "../../include/graphics/CPerspectiveCamera.h"
 #include "../../include/graphics/COrthoCamera.h"
+#include "../../include/graphics/CBaseCamera.h"
 #include "../../include/graphics/IVertexBuffer.h"
 #include "../../include/utils/CFileLogger.h"
 #include "../../include/editor/CPerfProfiler.h"
@@ -69,6 +70,11 @@ namespace TDEngine2
 	CParticlesSimulationSystem::CParticlesSimulationSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CParticleEmitter, CTransform>();
+
+		_addReadAccess<CTransform, CPerspectiveCamera, COrthoCamera, CCamerasContextComponent>();
+		_addWriteAccess<CParticleEmitter>();
+		_requireMainThread(); /// \note Instances buffers are mapped during the simulation
 	}
 
 	E_RESULT_CODE CParticlesSimulationSystem::Init(IRenderer* pRenderer, IGraphicsObjectManager* pGraphicsObjectManager)
@@ -124,9 +130,6 @@ namespace TDEngine2
 		mpParticlesInstancesBuffers.resize(particleEmitters.size());
 		mActiveParticlesCount.resize(particleEmitters.size());
 
-		const auto& cameras = pWorld->FindEntitiesWithAny<CPerspectiveCamera, COrthoCamera>();
-		mpCameraEntity = !cameras.empty() ? pWorld->FindEntity(cameras.front()) : nullptr;
-
 		mUsedMaterials = GetUsedMaterials(entities, pWorld, mpResourceManager.Get());
 
 		for (IVertexBuffer*& pCurrVertexBuffer : mpParticlesInstancesBuffers)
@@ -164,15 +167,14 @@ namespace TDEngine2
 	{
 		TDE2_PROFILER_SCOPE("CParticlesSimulationSystem::Update");
 
-		if (!mpCameraEntity)
+		/// \note The active camera is resolved each frame, because its entity doesn't match the system's filters
+		ICamera* pCameraComponent = GetCurrentActiveCamera(pWorld);
+		if (!pCameraComponent)
 		{
 			LOG_WARNING("[CParticlesSimulationSystem] An entity with Camera component attached to that wasn't found");
 			return;
 		}
 
-		ICamera* pCameraComponent = GetValidPtrOrDefault<ICamera*>(mpCameraEntity->GetComponent<CPerspectiveCamera>(), mpCameraEntity->GetComponent<COrthoCamera>());
-		TDE2_ASSERT(pCameraComponent);
-
 		// \note Process a new step of particles simulation
 		_simulateParticles(pWorld, dt);
 
@@ -269,8 +271,8 @@ namespace TDEngine2
 			const F32 distanceToCamera = ((viewMatrix * objectTransformMatrix) * TVector4(0.0f, 0.0f, 1.0f, 1.0f)).z;
 
 			// \note Create a command for the renderer
-			auto pCommand = pRenderGroup->SubmitDrawCommand<TDrawIndexedInstancedCommand>(static_cast<U32>(pCastedMaterial->GetGeometrySubGroupTag()) +
-				_computeRenderCommandHash(currMaterialId, distanceToCamera));
+			auto pCommand = pRenderGroup->SubmitDrawCommand<TDrawIndexedInstancedCommand>(MakeRenderCommandSortKey(GetGeometrySubGroupLayer(pCastedMaterial->GetGeometrySubGroupTag()),
+				pCastedMaterial->IsTransparent(), currMaterialId, distanceToCamera));
 
 			const bool isLocalSpaceParticles = E_PARTICLE_SIMULATION_SPACE::LOCAL == pParticleEffect->GetSimulationSpaceType();
 
@@ -283,7 +285,7 @@ namespace TDEngine2
 			pCommand->mNumOfInstances = mActiveParticlesCount[currBufferIndex];
 			pCommand->mPrimitiveType = E_PRIMITIVE_TOPOLOGY_TYPE::PTT_TRIANGLE_LIST;
 			pCommand->mObjectData.mModelMatrix = Transpose(isLocalSpaceParticles ? objectTransformMatrix : IdentityMatrix4);
-			pCommand->mObjectData.mInvModelMatrix = Transpose(isLocalSpaceParticles ? Inverse(objectTransformMatrix) : IdentityMatrix4);
+			pCommand->mObjectData.mInvModelMatrix = Transpose(isLocalSpaceParticles ? pTransform->GetWorldToLocalTransform() : IdentityMatrix4);
 
 			++currBufferIndex;
 		}
@@ -429,11 +431,6 @@ namespace TDEngine2
 		}
 	}
 		
-	U32 CParticlesSimulationSystem::_computeRenderCommandHash(TResourceId materialId, F32 distanceToCamera)
-	{
-		return (static_cast<U32>(materialId) << 16) | static_cast<U16>(fabs(distanceToCamera));
-	}
-
 
 	TDE2_API ISystem* CreateParticlesSimulationSystem(IRenderer* pRenderer, IGraphicsObjectManager* pGraphicsObjectManager, E_RESULT_CODE& result)
 	{
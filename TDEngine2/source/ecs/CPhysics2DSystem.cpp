@@ -24,6 +24,13 @@ namespace TDEngine2
 	CPhysics2DSystem::CPhysics2DSystem() :
 		CBaseSystem(), mpWorldInstance(nullptr)
 	{
+		_addComponentsFilter<CBoxCollisionObject2D, CTransform>();
+		_addComponentsFilter<CCircleCollisionObject2D, CTransform>();
+		_addComponentsFilter<CTrigger2D, CTransform>();
+
+		_addReadAccess<CBoxCollisionObject2D, CCircleCollisionObject2D, CTrigger2D>();
+		_addWriteAccess<CTransform>();
+		_requireMainThread(); /// \note Triggers' events are sent during the simulation
 	}
 
 	E_RESULT_CODE CPhysics2DSystem::Init(IEventManager* pEventManager)
@@ -60,6 +60,13 @@ namespace TDEngine2
 	CPhysics3DSystem::CPhysics3DSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CBoxCollisionObject3D, CTransform>();
+		_addComponentsFilter<CSphereCollisionObject3D, CTransform>();
+		_addComponentsFilter<CConvexHullCollisionObject3D, CTransform>();
+
+		_addReadAccess<CBoxCollisionObject3D, CSphereCollisionObject3D, CConvexHullCollisionObject3D>();
+		_addWriteAccess<CTransform>();
+		_requireMainThread(); /// \note Triggers' events are sent during the simulation
 	}
 
 	E_RESULT_CODE CPhysics3DSystem::Init(IEventManager* pEventManager)
@@ -11,9 +11,12 @@
 #include "../../include/ecs/CTransform.h"
 #include "../../include/ecs/CWorld.h"
 #include "../../include/ecs/CEntity.h"
+#include "../../include/ecs/components/CBoundsComponent.h"
+#include "../../include/graphics/FrustumCulling.h"
 #include "../../include/core/IResourceManager.h"
 #include "../../include/graphics/CPerspectiveCamera.h"
 #include "../../include/graphics/COrthoCamera.h"
+#include "../../include/graphics/CBaseCamera.h"
 #include "../../include/utils/CFileLogger.h"
 #include "../../include/editor/CPerfProfiler.h"
 #include <algorithm>
@@ -26,6 +29,12 @@ namespace TDEngine2
 	CSkinnedMeshRendererSystem::CSkinnedMeshRendererSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CTransform, CSkinnedMeshContainer>();
+		_addComponentsFilter<CTransform, CSkinnedMeshContainer, CBoundsComponent>(); /// \note Bounds are added later by CBoundsUpdatingSystem
+
+		_addReadAccess<CTransform, CBoundsComponent, CPerspectiveCamera, COrthoCamera, CCamerasContextComponent>();
+		_addWriteAccess<CSkinnedMeshContainer>();
+		_requireMainThread(); /// \note Resources are loaded and materials' instances are updated, only draw calls are recorded within jobs
 	}
 
 	E_RESULT_CODE CSkinnedMeshRendererSystem::Init(IRenderer* pRenderer, IGraphicsObjectManager* pGraphicsObjectManager)
@@ -59,6 +68,7 @@ namespace TDEngine2
 		std::vector<TEntityId> entities = pWorld->FindEntitiesWithComponents<CTransform, CSkinnedMeshContainer>();
 
 		mProcessingEntities.clear();
+		mProcessingEntitiesBounds.clear();
 
 		CEntity* pCurrEntity = nullptr;
 
@@ -72,6 +82,7 @@ namespace TDEngine2
 			}
 
 			mProcessingEntities.push_back({ pCurrEntity->GetComponent<CTransform>(), pCurrEntity->GetComponent<CSkinnedMeshContainer>() });
+			mProcessingEntitiesBounds.push_back(pCurrEntity->GetComponent<CBoundsComponent>()); /// \note Is nullptr only until CBoundsUpdatingSystem adds it, the addition rebinds the system
 		}
 	}
 
@@ -87,53 +98,95 @@ namespace TDEngine2
 			return;
 		}
 
+		// \note the visibility stage, commands are built only for entities which bounds intersect the camera's frustum
+		const U32 visibleEntitiesCount = CullBoundsByFrustum(pWorld, pCameraComponent->GetFrustum(), mProcessingEntitiesBounds, mVisibilityFlags);
+
+		TDE2_PROFILER_COUNTER("CSkinnedMeshRendererSystem::VisibleEntities", static_cast<F32>(visibleEntitiesCount));
+		TDE2_PROFILER_COUNTER("CSkinnedMeshRendererSystem::CulledEntities", static_cast<F32>(mProcessingEntities.size() - visibleEntitiesCount));
+
+		mDrawRecords.clear();
+
 		// \note first pass (construct an array of materials)
 		// \note Materials: | {opaque_material_group1}, ..., {opaque_material_groupN} | {transp_material_group1}, ..., {transp_material_groupM} |
-		_collectUsedMaterials(mProcessingEntities, mpResourceManager.Get(), mCurrMaterialsArray);
+		_collectUsedMaterials(mProcessingEntities, mVisibilityFlags, mpResourceManager.Get(), mCurrMaterialsArray);
 
-		auto firstTransparentMatIter = std::find_if(mCurrMaterialsArray.begin(), mCurrMaterialsArray.end(), [](auto&& pCurrMaterial)
+		auto firstTransparentMatIter = std::find_if(mCurrMaterialsArray.begin(), mCurrMaterialsArray.end(), [](const TMaterialBucket* pCurrBucket)
 		{
-			return pCurrMaterial->IsTransparent();
+			return pCurrBucket->mpMaterial->IsTransparent();
 		});
 
 		// \note construct commands for opaque geometry
-		std::for_each(mCurrMaterialsArray.begin(), firstTransparentMatIter, [this, pCameraComponent](auto&& pCurrMaterial)
+		std::for_each(mCurrMaterialsArray.begin(), firstTransparentMatIter, [this, pCameraComponent](TMaterialBucket* pCurrBucket)
 		{
-			_populateCommandsBuffer(mProcessingEntities, mpOpaqueRenderGroup, pCurrMaterial, pCameraComponent);
+			_populateCommandsBuffer(mProcessingEntities, *pCurrBucket, mpOpaqueRenderGroup, pCameraComponent);
 		});
 
 		// \note construct commands for transparent geometry
-		std::for_each(firstTransparentMatIter, mCurrMaterialsArray.end(), [this, pCameraComponent](auto&& pCurrMaterial)
+		std::for_each(firstTransparentMatIter, mCurrMaterialsArray.end(), [this, pCameraComponent](TMaterialBucket* pCurrBucket)
 		{
-			_populateCommandsBuffer(mProcessingEntities, mpTransparentRenderGroup, pCurrMaterial, pCameraComponent);
+			_populateCommandsBuffer(mProcessingEntities, *pCurrBucket, mpTransparentRenderGroup, pCameraComponent);
 		});
+
+		_recordDrawCommands(pWorld, mProcessingEntities, pCameraComponent);
 	}
 
-	void CSkinnedMeshRendererSystem::_collectUsedMaterials(const TEntitiesArray& entities, IResourceManager* pResourceManager, TMaterialsArray& usedMaterials)
+	void CSkinnedMeshRendererSystem::_collectUsedMaterials(const TEntitiesArray& entities, const std::vector<U8>& visibilityFlags, IResourceManager* pResourceManager,
+														  TMaterialBucketsArray& usedMaterials)
 	{
 		usedMaterials.clear();
 
 		ISkinnedMeshContainer* pCurrSkinnedMeshContainer = nullptr;
 
-		TPtr<IMaterial> pCurrMaterial;
-
-		for (auto& iter : entities)
+		/// \note A single pass over entities, materials' identifiers are cached within components and resolved again only when names change
+		for (U32 i = 0; i < static_cast<U32>(entities.size()); ++i)
 		{
-			pCurrSkinnedMeshContainer = std::get<CSkinnedMeshContainer*>(iter);
+			if (!visibilityFlags[i])
+			{
+				continue;
+			}
+
+			pCurrSkinnedMeshContainer = std::get<CSkinnedMeshContainer*>(entities[i]);
 
-			pCurrMaterial = mpResourceManager->GetResource<IMaterial>(mpResourceManager->Load<IMaterial>(pCurrSkinnedMeshContainer->GetMaterialName()));
+			TResourceId materialId = pCurrSkinnedMeshContainer->GetMaterialId();
+			if (TResourceId::Invalid == materialId)
+			{
+				/// \note Materials are loaded by workers, so the scene's first frames don't stall on their shaders and textures
+				materialId = pResourceManager->LoadAsync<IMaterial>(pCurrSkinnedMeshContainer->GetMaterialName()).mResourceId;
+				pCurrSkinnedMeshContainer->SetMaterialId(materialId);
+			}
 
-			// \note skip duplicates
-			if (std::find(usedMaterials.cbegin(), usedMaterials.cend(), pCurrMaterial) != usedMaterials.cend())
+			if (TResourceId::Invalid == materialId)
 			{
 				continue;
 			}
 
-			usedMaterials.push_back(pCurrMaterial);
+			TMaterialBucket& currBucket = mMaterialBuckets[materialId];
+
+			if (currBucket.mEntitiesIndices.empty())
+			{
+				/// \note Meshes aren't drawn until their material is bound to its shader and textures
+				TPtr<IResource> pMaterialResource = pResourceManager->GetResource(materialId);
+				if (!pMaterialResource || (E_RESOURCE_STATE_TYPE::RST_LOADED != pMaterialResource->GetState()))
+				{
+					continue;
+				}
+
+				currBucket.mpMaterial = pResourceManager->GetResource<IMaterial>(materialId);
+				if (!currBucket.mpMaterial)
+				{
+					continue;
+				}
+
+				usedMaterials.push_back(&currBucket);
+			}
+
+			currBucket.mEntitiesIndices.push_back(i);
 		}
 
-		// sort all materials
-		std::sort(usedMaterials.begin(), usedMaterials.end(), CBaseMaterial::AlphaBasedMaterialComparator);
+		std::stable_partition(usedMaterials.begin(), usedMaterials.end(), [](const TMaterialBucket* pCurrBucket)
+		{
+			return !pCurrBucket->mpMaterial->IsTransparent();
+		});
 	}
 
 
@@ -178,34 +231,29 @@ namespace TDEngine2
 	}
 
 
-	void CSkinnedMeshRendererSystem::_populateCommandsBuffer(const TEntitiesArray& entities, CRenderQueue*& pRenderGroup, TPtr<IMaterial> pCurrMaterial,
-															const ICamera* pCamera)
+	void CSkinnedMeshRendererSystem::_populateCommandsBuffer(const TEntitiesArray& entities, TMaterialBucket& materialBucket, CRenderQueue*& pRenderGroup, const ICamera* pCamera)
 	{
-		auto iter = entities.begin();
-
-		auto&& pCastedMaterial = DynamicPtrCast<CBaseMaterial>(pCurrMaterial);
-		const std::string& currMaterialName = pCastedMaterial->GetName();
+		auto&& pCastedMaterial = DynamicPtrCast<CBaseMaterial>(materialBucket.mpMaterial);
 		TDE2_ASSERT(pCastedMaterial);
 
 		TResourceId currMaterialId = pCastedMaterial->GetId();
 
-		auto&& viewMatrix = pCamera->GetViewMatrix();
+		const U8 layer = GetGeometrySubGroupLayer(pCastedMaterial->GetGeometrySubGroupTag());
 
-		// \note iterate over all entities with pCurrMaterial attached as main material
-		while ((iter = std::find_if(iter, entities.end(), [pCastedMaterial, currMaterialId, &currMaterialName](auto&& entity)
-		{
-			return std::get<CSkinnedMeshContainer*>(entity)->GetMaterialName() == currMaterialName;
-		})) != entities.end())
+		for (U32 currEntityIndex : materialBucket.mEntitiesIndices)
 		{
-			auto pSkinnedMeshContainer = std::get<CSkinnedMeshContainer*>(*iter);
-			auto pTransform            = std::get<CTransform*>(*iter);
+			auto pSkinnedMeshContainer = std::get<CSkinnedMeshContainer*>(entities[currEntityIndex]);
 
-			const TResourceId sharedMeshId = mpResourceManager->Load<ISkinnedMesh>(pSkinnedMeshContainer->GetMeshName());
+			TResourceId sharedMeshId = pSkinnedMeshContainer->GetMeshId();
+			if (TResourceId::Invalid == sharedMeshId)
+			{
+				sharedMeshId = mpResourceManager->Load<ISkinnedMesh>(pSkinnedMeshContainer->GetMeshName());
+				pSkinnedMeshContainer->SetMeshId(sharedMeshId);
+			}
 
 			auto pSharedMeshResource = mpResourceManager->GetResource<ISkinnedMesh>(sharedMeshId);
 			if (!pSharedMeshResource || (pSharedMeshResource && (E_RESOURCE_STATE_TYPE::RST_LOADED != mpResourceManager->GetResource<IResource>(sharedMeshId)->GetState())))
 			{
-				++iter;
 				continue;
 			}
 			
@@ -266,12 +314,16 @@ namespace TDEngine2
 			auto& currAnimationPose = pSkinnedMeshContainer->GetCurrentAnimationPose();
 			U32 jointsCount = static_cast<U32>(currAnimationPose.size());
 
-			const TResourceId skeletonResourceId = mpResourceManager->Load<ISkeleton>(pSkinnedMeshContainer->GetSkeletonName());
+			TResourceId skeletonResourceId = pSkinnedMeshContainer->GetSkeletonId();
+			if (TResourceId::Invalid == skeletonResourceId)
+			{
+				skeletonResourceId = mpResourceManager->Load<ISkeleton>(pSkinnedMeshContainer->GetSkeletonName());
+				pSkinnedMeshContainer->SetSkeletonId(skeletonResourceId);
+			}
 
 			auto pSkeletonResource = mpResourceManager->GetResource<IResource>(sharedMeshId);
 			if (!pSkeletonResource || (pSkeletonResource && (E_RESOURCE_STATE_TYPE::RST_LOADED != pSkeletonResource->GetState())))
 			{
-				++iter;
 				continue;
 			}
 
@@ -291,36 +343,49 @@ namespace TDEngine2
 			pCastedMaterial->SetVariableForInstance(materialInstance, CSkinnedMeshContainer::mJointsArrayUniformVariableId, &currAnimationPose.front(), static_cast<U32>(sizeof(TMatrix4) * currAnimationPose.size()));
 			pCastedMaterial->SetVariableForInstance(materialInstance, CSkinnedMeshContainer::mJointsCountUniformVariableId, &jointsCount, sizeof(U32));
 
-			auto& meshBuffersEntry = mMeshBuffersMap[pSkinnedMeshContainer->GetSystemBuffersHandle()];
+			mDrawRecords.push_back({ pRenderGroup,
+									 { pSharedMeshResource->GetSharedVertexBuffer(), pSharedMeshResource->GetSharedIndexBuffer(), mMeshBuffersMap[pSkinnedMeshContainer->GetSystemBuffersHandle()].mpVertexDecl },
+									 currMaterialId, materialInstance, currEntityIndex, subMeshInfo.mStartIndex, subMeshInfo.mIndicesCount, layer, pCastedMaterial->IsTransparent() });
+		}
+
+		materialBucket.mEntitiesIndices.clear();
+		materialBucket.mpMaterial = nullptr;
+	}
+
+	void CSkinnedMeshRendererSystem::_recordDrawCommands(IWorld* pWorld, const TEntitiesArray& entities, const ICamera* pCamera)
+	{
+		TDE2_PROFILER_SCOPE("CSkinnedMeshRendererSystem::RecordDrawCommands");
+
+		auto&& viewMatrix = pCamera->GetViewMatrix();
+
+		/// \note Joints of instances are already written into materials, so jobs only read transforms and write commands into buffers of
+		/// their workers. Indices of records are used as submission indices, so the order of commands doesn't depend on the distribution of jobs
+		pWorld->ParallelForEach(mDrawRecords.size(), [this, &entities, &viewMatrix](USIZE i)
+		{
+			const TDrawRecord& currRecord = mDrawRecords[i];
+
+			auto pTransform = std::get<CTransform*>(entities[currRecord.mEntityIndex]);
 
 			auto&& objectTransformMatrix = pTransform->GetLocalToWorldTransform();
 
-			F32 distanceToCamera = ((viewMatrix * objectTransformMatrix) * TVector4(0.0f, 0.0f, 1.0f, 1.0f)).z;
+			const F32 distanceToCamera = ((viewMatrix * objectTransformMatrix) * TVector4(0.0f, 0.0f, 1.0f, 1.0f)).z;
+
+			auto pCommand = currRecord.mpRenderGroup->SubmitDrawCommand<TDrawIndexedCommand>(
+				MakeRenderCommandSortKey(currRecord.mLayer, currRecord.mIsTransparent, currRecord.mMaterialId, distanceToCamera), MakeRenderCommandSubmissionIndex(E_RENDER_COMMANDS_RECORDER_TYPE::RCRT_SKINNED_MESHES, static_cast<U32>(i)));
 
-			// create a command for the renderer
-			auto pCommand = pRenderGroup->SubmitDrawCommand<TDrawIndexedCommand>(static_cast<U32>(pCastedMaterial->GetGeometrySubGroupTag()) + 
-																				 _computeMeshCommandHash(currMaterialId, distanceToCamera));
-			
 			TDE2_ASSERT(pCommand);
 
-			pCommand->mpVertexBuffer              = pSharedMeshResource->GetSharedVertexBuffer();
-			pCommand->mpIndexBuffer               = pSharedMeshResource->GetSharedIndexBuffer();
-			pCommand->mMaterialHandle             = currMaterialId;
-			pCommand->mMaterialInstanceId         = materialInstance;
-			pCommand->mpVertexDeclaration         = meshBuffersEntry.mpVertexDecl; // \todo replace with access to a vertex declarations pool
-			pCommand->mNumOfIndices               = subMeshInfo.mIndicesCount;
-			pCommand->mStartIndex                 = subMeshInfo.mStartIndex;
+			pCommand->mpVertexBuffer              = currRecord.mMeshBuffers.mpVertexBuffer;
+			pCommand->mpIndexBuffer               = currRecord.mMeshBuffers.mpIndexBuffer;
+			pCommand->mMaterialHandle             = currRecord.mMaterialId;
+			pCommand->mMaterialInstanceId         = currRecord.mMaterialInstanceId;
+			pCommand->mpVertexDeclaration         = currRecord.mMeshBuffers.mpVertexDecl; // \todo replace with access to a vertex declarations pool
+			pCommand->mNumOfIndices               = currRecord.mIndicesCount;
+			pCommand->mStartIndex                 = currRecord.mStartIndex;
 			pCommand->mPrimitiveType              = E_PRIMITIVE_TOPOLOGY_TYPE::PTT_TRIANGLE_LIST;
 			pCommand->mObjectData.mModelMatrix    = Transpose(objectTransformMatrix);
-			pCommand->mObjectData.mInvModelMatrix = Transpose(Inverse(objectTransformMatrix));
-
-			++iter;
-		}
-	}
-
-	U32 CSkinnedMeshRendererSystem::_computeMeshCommandHash(TResourceId materialId, F32 distanceToCamera)
-	{
-		return (static_cast<U32>(materialId) << 16) | static_cast<U16>(fabs(distanceToCamera));
+			pCommand->mObjectData.mInvModelMatrix = Transpose(pTransform->GetWorldToLocalTransform());
+		});
 	}
 
 
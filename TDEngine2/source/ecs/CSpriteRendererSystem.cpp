@@ -3,6 +3,13 @@
 #include "../../include/graphics/CQuadSprite.h"
 #include "../../include/ecs/CEntity.h"
 #include "../../include/ecs/CTransform.h"
+#include "../../include/ecs/CWorld.h"
+#include "../../include/ecs/components/CBoundsComponent.h"
+#include "../../include/graphics/FrustumCulling.h"
+#include "../../include/graphics/ICamera.h"
+#include "../../include/graphics/CPerspectiveCamera.h"
+#include "../../include/graphics/COrthoCamera.h"
+#include "../../include/graphics/CBaseCamera.h"
 #include "../../include/graphics/CRenderQueue.h"
 #include "../../include/graphics/IGraphicsObjectManager.h"
 #include "../../include/graphics/IVertexBuffer.h"
@@ -15,6 +22,9 @@
 #include "../../include/core/IResourceManager.h"
 #include "../../include/graphics/CBaseMaterial.h"
 #include "../../include/core/memory/IAllocator.h"
+#include "../../include/editor/CPerfProfiler.h"
+#include "../../include/utils/CFileLogger.h"
+#include <algorithm>
 
 
 namespace TDEngine2
@@ -23,6 +33,12 @@ namespace TDEngine2
 		CBaseSystem(), mpRenderQueue(nullptr), mpSpriteVertexBuffer(nullptr), mpSpriteIndexBuffer(nullptr),
 		mpSpriteVertexDeclaration(nullptr), mSpriteFaces {0, 1, 2, 2, 1, 3}, mpGraphicsLayers(nullptr)
 	{
+		_addComponentsFilter<CTransform, CQuadSprite>();
+		_addComponentsFilter<CTransform, CQuadSprite, CBoundsComponent>(); /// \note Bounds are added later by CBoundsUpdatingSystem
+
+		_addReadAccess<CTransform, CBoundsComponent, CPerspectiveCamera, COrthoCamera, CCamerasContextComponent>();
+		_addWriteAccess<CQuadSprite>();
+		_requireMainThread(); /// \note Materials are loaded and instances buffers are mapped during the update
 	}
 
 	E_RESULT_CODE CSpriteRendererSystem::Init(TPtr<IAllocator> allocator, IRenderer* pRenderer, IGraphicsObjectManager* pGraphicsObjectManager)
@@ -98,13 +114,6 @@ namespace TDEngine2
 			return result;
 		}
 
-		for (auto iter = mBatches.begin(); iter != mBatches.end(); ++iter)
-		{
-			TBatchEntry& currBatchEntry = (*iter).second;
-
-			delete currBatchEntry.mpInstancesData;
-		}
-
 		return RC_OK;
 	}
 
@@ -114,6 +123,7 @@ namespace TDEngine2
 
 		mTransforms.clear();		
 		mSprites.clear();
+		mSpritesBounds.clear();
 
 		CEntity* pCurrEntity = nullptr;
 
@@ -127,6 +137,7 @@ namespace TDEngine2
 
 			mTransforms.push_back(pCurrEntity->GetComponent<CTransform>());
 			mSprites.push_back(pCurrEntity->GetComponent<CQuadSprite>());
+			mSpritesBounds.push_back(pCurrEntity->GetComponent<CBoundsComponent>()); /// \note Is nullptr only until CBoundsUpdatingSystem adds it, the addition rebinds the system
 
 			TDE2_ASSERT(mTransforms.back());
 			TDE2_ASSERT(mSprites.back());
@@ -135,68 +146,110 @@ namespace TDEngine2
 
 	void CSpriteRendererSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		TDrawIndexedInstancedCommand* pCurrCommand = nullptr;
-
 		CTransform* pCurrTransform = nullptr;
 
 		CQuadSprite* pCurrSprite = nullptr;
 
-		U32 groupKey = 0x0;
+		U64 groupKey = 0x0;
 
-		/// allocate memory for vertex buffers that will store instances data if it's not allocated yet
-		if (mSpritesPerInstanceData.empty())
-		{
-			_initializeBatchVertexBuffers(mpGraphicsObjectManager, PreCreatedNumOfVertexBuffers);
-		}
+		mUsedInstancesBuffersCount = 0;
+
+		ICamera* pCameraComponent = GetCurrentActiveCamera(pWorld);
+
+		/// \note the visibility stage, culled sprites aren't added into batches
+		const U32 visibleSpritesCount = CullBoundsByFrustum(pWorld, pCameraComponent ? pCameraComponent->GetFrustum() : nullptr, mSpritesBounds, mVisibilityFlags);
+
+		TDE2_PROFILER_COUNTER("CSpriteRendererSystem::VisibleEntities", static_cast<F32>(visibleSpritesCount));
+		TDE2_PROFILER_COUNTER("CSpriteRendererSystem::CulledEntities", static_cast<F32>(mSprites.size() - visibleSpritesCount));
+
+		TBatchEntry* pCurrBatchEntry = nullptr;
 
 		for (U32 i = 0; i < static_cast<U32>(mSprites.size()); ++i)
 		{
+			if (!mVisibilityFlags[i])
+			{
+				continue;
+			}
+
 			pCurrTransform = mTransforms[i];
 
 			pCurrSprite = mSprites[i];
-			
-			const TResourceId currMaterialHandle = mpResourceManager->Load<IMaterial>(pCurrSprite->GetMaterialName());
 
-			groupKey = _computeSpriteCommandKey(currMaterialHandle, mpGraphicsLayers->GetLayerIndex(pCurrTransform->GetPosition().z));
-			
-			TBatchEntry& currBatchEntry = mBatches[groupKey];
+			TResourceId currMaterialHandle = pCurrSprite->GetMaterialId();
+			if (TResourceId::Invalid == currMaterialHandle)
+			{
+				currMaterialHandle = mpResourceManager->Load<IMaterial>(pCurrSprite->GetMaterialName());
+				pCurrSprite->SetMaterialId(currMaterialHandle);
+			}
 
-			currBatchEntry.mMaterialHandle = currMaterialHandle;
+			groupKey = _computeSpriteCommandKey(currMaterialHandle, mpGraphicsLayers->GetLayerIndex(pCurrTransform->GetPosition().z));
 
-			if (!currBatchEntry.mpInstancesData)
+			/// \note Neighbouring sprites often share the batch, so the table isn't queried for them
+			if (!pCurrBatchEntry || (pCurrBatchEntry->mGroupKey != groupKey))
 			{
-				currBatchEntry.mpInstancesData = new CDynamicArray<TSpriteInstanceData>(*mpTempAllocator.Get(), 100);
+				pCurrBatchEntry = &_getBatchEntry(groupKey, currMaterialHandle);
 			}
 
-			currBatchEntry.mpInstancesData->PushBack({ Transpose(pCurrTransform->GetLocalToWorldTransform()), pCurrSprite->GetColor() });
+			pCurrBatchEntry->mInstancesData.push_back({ Transpose(pCurrTransform->GetLocalToWorldTransform()), pCurrSprite->GetColor() });
 		}
-		
-		U32 currInstancesBufferIndex = 0;
 
-		IVertexBuffer* pCurrBatchInstancesBuffer = nullptr;
+		for (TBatchEntry& currBatchEntry : mBatches)
+		{
+			if (currBatchEntry.mInstancesData.empty()) /// \note All sprites of the batch are culled
+			{
+				continue;
+			}
 
-		U32 instancesCount = 0;
+			_submitBatch(currBatchEntry);
 
-		for (auto iter = mBatches.begin(); iter != mBatches.end(); ++iter)
+			currBatchEntry.mInstancesData.clear();
+		}
+	}
+
+	CSpriteRendererSystem::TBatchEntry& CSpriteRendererSystem::_getBatchEntry(U64 groupKey, TResourceId materialHandle)
+	{
+		auto it = mBatchesTable.find(groupKey);
+		if (it != mBatchesTable.end())
 		{
-			pCurrBatchInstancesBuffer = mSpritesPerInstanceData[currInstancesBufferIndex++];
+			return mBatches[it->second];
+		}
 
-			TBatchEntry& currBatchEntry = (*iter).second;
+		mBatchesTable.emplace(groupKey, static_cast<U32>(mBatches.size()));
 
-			instancesCount    = static_cast<U32>(currBatchEntry.mpInstancesData->GetSize());
-			U32 currBatchSize = instancesCount * sizeof(TSpriteInstanceData);
+		TBatchEntry batchEntry;
+		batchEntry.mGroupKey       = groupKey;
+		batchEntry.mMaterialHandle = materialHandle;
+
+		mBatches.emplace_back(std::move(batchEntry));
+
+		return mBatches.back();
+	}
+
+	void CSpriteRendererSystem::_submitBatch(const TBatchEntry& batchEntry)
+	{
+		TPtr<IMaterial> pMaterial = mpResourceManager->GetResource<IMaterial>(batchEntry.mMaterialHandle);
+		ITexture* pMainTexture = pMaterial->GetTextureResource(Wrench::StringUtils::GetEmptyStr());
+
+		auto&& uvRect = pMainTexture ? pMainTexture->GetNormalizedTextureRect() : TRectF32 { 0.0f, 0.0f, 1.0f, 1.0f};
+
+		/// \note A batch which doesn't fit into a single instances buffer is split into a few instanced draw calls
+		const U32 maxInstancesPerBuffer = SpriteInstanceDataBufferSize / sizeof(TSpriteInstanceData);
+		const U32 instancesCount        = static_cast<U32>(batchEntry.mInstancesData.size());
+
+		for (U32 firstInstanceIndex = 0; firstInstanceIndex < instancesCount; firstInstanceIndex += maxInstancesPerBuffer)
+		{
+			const U32 currChunkSize = std::min(maxInstancesPerBuffer, instancesCount - firstInstanceIndex);
 
-			if (currBatchSize <= SpriteInstanceDataBufferSize)
+			IVertexBuffer* pCurrBatchInstancesBuffer = _getInstancesBuffer();
+			if (!pCurrBatchInstancesBuffer || (RC_OK != pCurrBatchInstancesBuffer->Map(BMT_WRITE_DISCARD)))
 			{
-				pCurrBatchInstancesBuffer->Map(BMT_WRITE_DISCARD);
-				pCurrBatchInstancesBuffer->Write(&(*currBatchEntry.mpInstancesData)[0], currBatchSize);
-				pCurrBatchInstancesBuffer->Unmap();
+				return;
 			}
 
-			TPtr<IMaterial> pMaterial = mpResourceManager->GetResource<IMaterial>(currBatchEntry.mMaterialHandle);
-			ITexture* pMainTexture = pMaterial->GetTextureResource(Wrench::StringUtils::GetEmptyStr());
+			pCurrBatchInstancesBuffer->Write(&batchEntry.mInstancesData[firstInstanceIndex], currChunkSize * sizeof(TSpriteInstanceData));
+			pCurrBatchInstancesBuffer->Unmap();
 
-			pCurrCommand = mpRenderQueue->SubmitDrawCommand<TDrawIndexedInstancedCommand>((*iter).first); /// \note (*iter).first is a group key that was computed before
+			auto pCurrCommand = mpRenderQueue->SubmitDrawCommand<TDrawIndexedInstancedCommand>(batchEntry.mGroupKey);
 
 			pCurrCommand->mpVertexBuffer           = mpSpriteVertexBuffer;
 			pCurrCommand->mpIndexBuffer            = mpSpriteIndexBuffer;
@@ -205,23 +258,19 @@ namespace TDEngine2
 			pCurrCommand->mBaseVertexIndex         = 0;
 			pCurrCommand->mStartIndex              = 0;
 			pCurrCommand->mStartInstance           = 0;
-			pCurrCommand->mNumOfInstances          = instancesCount;/// assign number of sprites in a batch
+			pCurrCommand->mNumOfInstances          = currChunkSize; /// assign number of sprites in a batch
 			pCurrCommand->mpInstancingBuffer       = pCurrBatchInstancesBuffer; /// assign accumulated data of a batch
-			pCurrCommand->mMaterialHandle          = currBatchEntry.mMaterialHandle;
+			pCurrCommand->mMaterialHandle          = batchEntry.mMaterialHandle;
 			pCurrCommand->mpVertexDeclaration      = mpSpriteVertexDeclaration;
 
-			auto&& uvRect = pMainTexture ? pMainTexture->GetNormalizedTextureRect() : TRectF32 { 0.0f, 0.0f, 1.0f, 1.0f};
-
 			pCurrCommand->mObjectData.mModelMatrix = IdentityMatrix4;
 			pCurrCommand->mObjectData.mTextureTransformDesc = { uvRect.x, uvRect.y, uvRect.width, uvRect.height };
-
-			currBatchEntry.mpInstancesData->Clear();
 		}
 	}
 
-	U32 CSpriteRendererSystem::_computeSpriteCommandKey(TResourceId materialId, U16 graphicsLayerId)
+	U64 CSpriteRendererSystem::_computeSpriteCommandKey(TResourceId materialId, U16 graphicsLayerId)
 	{
-		return static_cast<U32>(materialId) << 16 | graphicsLayerId;
+		return static_cast<U64>(static_cast<U32>(materialId)) << 16 | graphicsLayerId;
 	}
 
 	void CSpriteRendererSystem::_initializeBatchVertexBuffers(IGraphicsObjectManager* pGraphicsObjectManager, U32 numOfBuffers)
@@ -232,6 +281,26 @@ namespace TDEngine2
 		}
 	}
 
+	IVertexBuffer* CSpriteRendererSystem::_getInstancesBuffer()
+	{
+		if (mUsedInstancesBuffersCount < static_cast<U32>(mSpritesPerInstanceData.size()))
+		{
+			return mSpritesPerInstanceData[mUsedInstancesBuffersCount++];
+		}
+
+		auto createBufferResult = mpGraphicsObjectManager->CreateVertexBuffer(BUT_DYNAMIC, SpriteInstanceDataBufferSize, nullptr);
+		if (createBufferResult.HasError())
+		{
+			LOG_ERROR("[CSpriteRendererSystem] Couldn't create a buffer for instances data");
+			return nullptr;
+		}
+
+		mSpritesPerInstanceData.push_back(createBufferResult.Get());
+		++mUsedInstancesBuffersCount;
+
+		return mSpritesPerInstanceData.back();
+	}
+
 
 	TDE2_API ISystem* CreateSpriteRendererSystem(TPtr<IAllocator> allocator, IRenderer* pRenderer, IGraphicsObjectManager* pGraphicsObjectManager, E_RESULT_CODE& result)
 	{
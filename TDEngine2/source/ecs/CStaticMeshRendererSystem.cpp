@@ -5,13 +5,17 @@
 #include "../../include/graphics/CRenderQueue.h"
 #include "../../include/graphics/CBaseMaterial.h"
 #include "../../include/graphics/IVertexDeclaration.h"
+#include "../../include/graphics/IVertexBuffer.h"
 #include "../../include/graphics/CStaticMesh.h"
 #include "../../include/ecs/CTransform.h"
 #include "../../include/ecs/CWorld.h"
 #include "../../include/ecs/CEntity.h"
+#include "../../include/ecs/components/CBoundsComponent.h"
+#include "../../include/graphics/FrustumCulling.h"
 #include "../../include/core/IResourceManager.h"
 #include "../../include/graphics/CPerspectiveCamera.h"
 #include "../../include/graphics/COrthoCamera.h"
+#include "../../include/graphics/CBaseCamera.h"
 #include "../../include/utils/CFileLogger.h"
 #include "../../include/editor/CPerfProfiler.h"
 #include <algorithm>
@@ -23,6 +27,12 @@ namespace TDEngine2
 	CStaticMeshRendererSystem::CStaticMeshRendererSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CTransform, CStaticMeshContainer>();
+		_addComponentsFilter<CTransform, CStaticMeshContainer, CBoundsComponent>(); /// \note Bounds are added later by CBoundsUpdatingSystem
+
+		_addReadAccess<CTransform, CBoundsComponent, CPerspectiveCamera, COrthoCamera, CCamerasContextComponent>();
+		_addWriteAccess<CStaticMeshContainer>();
+		_requireMainThread(); /// \note Resources are loaded and instances buffers are mapped during the update, only draw calls are recorded within jobs
 	}
 
 	E_RESULT_CODE CStaticMeshRendererSystem::Init(IRenderer* pRenderer, IGraphicsObjectManager* pGraphicsObjectManager)
@@ -54,6 +64,7 @@ namespace TDEngine2
 		std::vector<TEntityId> entities = pWorld->FindEntitiesWithComponents<CTransform, CStaticMeshContainer>();
 
 		mProcessingEntities.clear();
+		mProcessingEntitiesBounds.clear();
 
 		CEntity* pCurrEntity = nullptr;
 
@@ -67,6 +78,7 @@ namespace TDEngine2
 			}
 
 			mProcessingEntities.push_back({ pCurrEntity->GetComponent<CTransform>(), pCurrEntity->GetComponent<CStaticMeshContainer>() });
+			mProcessingEntitiesBounds.push_back(pCurrEntity->GetComponent<CBoundsComponent>()); /// \note Is nullptr only until CBoundsUpdatingSystem adds it, the addition rebinds the system
 		}
 	}
 
@@ -82,86 +94,131 @@ namespace TDEngine2
 			return;
 		}
 
+		// \note the visibility stage, commands are built only for entities which bounds intersect the camera's frustum
+		const U32 visibleEntitiesCount = CullBoundsByFrustum(pWorld, pCameraComponent->GetFrustum(), mProcessingEntitiesBounds, mVisibilityFlags);
+
+		TDE2_PROFILER_COUNTER("CStaticMeshRendererSystem::VisibleEntities", static_cast<F32>(visibleEntitiesCount));
+		TDE2_PROFILER_COUNTER("CStaticMeshRendererSystem::CulledEntities", static_cast<F32>(mProcessingEntities.size() - visibleEntitiesCount));
+
+		mUsedInstancesBuffersCount = 0;
+
+		mDrawRecords.clear();
+
+		++mCurrFrameIndex;
+
 		// \note first pass (construct an array of materials)
 		// \note Materials: | {opaque_material_group1}, ..., {opaque_material_groupN} | {transp_material_group1}, ..., {transp_material_groupM} |
-		_collectUsedMaterials(mProcessingEntities, mpResourceManager.Get(), mCurrMaterialsArray);
+		_collectUsedMaterials(mProcessingEntities, mVisibilityFlags, mpResourceManager.Get(), mCurrMaterialsArray);
 
-		auto firstTransparentMatIter = std::find_if(mCurrMaterialsArray.cbegin(), mCurrMaterialsArray.cend(), [](auto&& pCurrMaterial)
+		auto firstTransparentMatIter = std::find_if(mCurrMaterialsArray.begin(), mCurrMaterialsArray.end(), [](const TMaterialBucket* pCurrBucket)
 		{
-			return pCurrMaterial->IsTransparent();
+			return pCurrBucket->mpMaterial->IsTransparent();
 		});
-		
+
 		// \note construct commands for opaque geometry
-		std::for_each(mCurrMaterialsArray.cbegin(), firstTransparentMatIter, [this, &pCameraComponent](auto&& pCurrMaterial)
+		std::for_each(mCurrMaterialsArray.begin(), firstTransparentMatIter, [this, pCameraComponent](TMaterialBucket* pCurrBucket)
 		{
-			_populateCommandsBuffer(mProcessingEntities, mpOpaqueRenderGroup, pCurrMaterial, pCameraComponent);
+			_populateCommandsBuffer(mProcessingEntities, *pCurrBucket, mpOpaqueRenderGroup, pCameraComponent);
 		});
 
 		// \note construct commands for transparent geometry
-		std::for_each(firstTransparentMatIter, mCurrMaterialsArray.cend(), [this, &pCameraComponent](auto&& pCurrMaterial)
+		std::for_each(firstTransparentMatIter, mCurrMaterialsArray.end(), [this, pCameraComponent](TMaterialBucket* pCurrBucket)
 		{
-			_populateCommandsBuffer(mProcessingEntities, mpTransparentRenderGroup, pCurrMaterial, pCameraComponent);
+			_populateCommandsBuffer(mProcessingEntities, *pCurrBucket, mpTransparentRenderGroup, pCameraComponent);
 		});
+
+		_recordDrawCommands(pWorld, mProcessingEntities, pCameraComponent);
+
+		_pruneInstancesBatches();
 	}
 
-	void CStaticMeshRendererSystem::_collectUsedMaterials(const TEntitiesArray& entities, IResourceManager* pResourceManager, TMaterialsArray& usedMaterials)
+	void CStaticMeshRendererSystem::_collectUsedMaterials(const TEntitiesArray& entities, const std::vector<U8>& visibilityFlags, IResourceManager* pResourceManager,
+														  TMaterialBucketsArray& usedMaterials)
 	{
 		usedMaterials.clear();
 
 		IStaticMeshContainer* pCurrStaticMeshContainer = nullptr;
 
-		TPtr<IMaterial> pCurrMaterial;
-
-		for (auto& iter : entities)
+		/// \note A single pass over entities, materials' identifiers are cached within components and resolved again only when names change
+		for (U32 i = 0; i < static_cast<U32>(entities.size()); ++i)
 		{
-			pCurrStaticMeshContainer = std::get<CStaticMeshContainer*>(iter);
-
-			pCurrMaterial = mpResourceManager->GetResource<IMaterial>(mpResourceManager->Load<IMaterial>(pCurrStaticMeshContainer->GetMaterialName()));
-			if (!pCurrMaterial)
+			if (!visibilityFlags[i])
 			{
 				continue;
 			}
 
-			// \note skip duplicates
-			if (std::find(usedMaterials.cbegin(), usedMaterials.cend(), pCurrMaterial) != usedMaterials.cend())
+			pCurrStaticMeshContainer = std::get<CStaticMeshContainer*>(entities[i]);
+
+			TResourceId materialId = pCurrStaticMeshContainer->GetMaterialId();
+			if (TResourceId::Invalid == materialId)
+			{
+				/// \note Materials are loaded by workers, so the scene's first frames don't stall on their shaders and textures
+				materialId = pResourceManager->LoadAsync<IMaterial>(pCurrStaticMeshContainer->GetMaterialName()).mResourceId;
+				pCurrStaticMeshContainer->SetMaterialId(materialId);
+			}
+
+			if (TResourceId::Invalid == materialId)
 			{
 				continue;
 			}
 
-			usedMaterials.push_back(pCurrMaterial);
+			TMaterialBucket& currBucket = mMaterialBuckets[materialId];
+
+			if (currBucket.mEntitiesIndices.empty())
+			{
+				/// \note Meshes aren't drawn until their material is bound to its shader and textures
+				TPtr<IResource> pMaterialResource = pResourceManager->GetResource(materialId);
+				if (!pMaterialResource || (E_RESOURCE_STATE_TYPE::RST_LOADED != pMaterialResource->GetState()))
+				{
+					continue;
+				}
+
+				currBucket.mpMaterial = pResourceManager->GetResource<IMaterial>(materialId);
+				if (!currBucket.mpMaterial)
+				{
+					continue;
+				}
+
+				usedMaterials.push_back(&currBucket);
+			}
+
+			currBucket.mEntitiesIndices.push_back(i);
 		}
 
-		// sort all materials
-		std::sort(usedMaterials.begin(), usedMaterials.end(), CBaseMaterial::AlphaBasedMaterialComparator);
+		std::stable_partition(usedMaterials.begin(), usedMaterials.end(), [](const TMaterialBucket* pCurrBucket)
+		{
+			return !pCurrBucket->mpMaterial->IsTransparent();
+		});
 	}
 
-	void CStaticMeshRendererSystem::_populateCommandsBuffer(const TEntitiesArray& entities, CRenderQueue*& pRenderGroup, TPtr<IMaterial> pCurrMaterial,
-															const ICamera* pCamera)
+	void CStaticMeshRendererSystem::_populateCommandsBuffer(const TEntitiesArray& entities, TMaterialBucket& materialBucket, CRenderQueue*& pRenderGroup, const ICamera* pCamera)
 	{
-		auto iter = entities.begin();
-
-		auto&& pCastedMaterial = DynamicPtrCast<CBaseMaterial>(pCurrMaterial);
-		const std::string& currMaterialName = pCastedMaterial->GetName();
+		auto&& pCastedMaterial = DynamicPtrCast<CBaseMaterial>(materialBucket.mpMaterial);
 
 		TResourceId currMaterialId = pCastedMaterial->GetId();
 
+		/// \note Transparent objects aren't instanced because they should be drawn in back-to-front order
+		const bool isInstancingEnabled = pCastedMaterial->IsInstancingEnabled() && !pCastedMaterial->IsTransparent();
+
+		const U8 layer = GetGeometrySubGroupLayer(pCastedMaterial->GetGeometrySubGroupTag());
+
 		auto&& viewMatrix = pCamera->GetViewMatrix();
 
-		// \note iterate over all entities with pCurrMaterial attached as main material
-		while ((iter = std::find_if(iter, entities.end(), [currMaterialId, &currMaterialName](auto&& entity)
+		for (U32 currEntityIndex : materialBucket.mEntitiesIndices)
 		{
-			return std::get<CStaticMeshContainer*>(entity)->GetMaterialName() == currMaterialName;
-		})) != entities.end())
-		{
-			auto pStaticMeshContainer = std::get<CStaticMeshContainer*>(*iter);
-			auto pTransform           = std::get<CTransform*>(*iter);
+			auto pStaticMeshContainer = std::get<CStaticMeshContainer*>(entities[currEntityIndex]);
+			auto pTransform           = std::get<CTransform*>(entities[currEntityIndex]);
 
-			const TResourceId sharedMeshId = mpResourceManager->Load<IStaticMesh>(pStaticMeshContainer->GetMeshName());
+			TResourceId sharedMeshId = pStaticMeshContainer->GetMeshId();
+			if (TResourceId::Invalid == sharedMeshId)
+			{
+				sharedMeshId = mpResourceManager->Load<IStaticMesh>(pStaticMeshContainer->GetMeshName());
+				pStaticMeshContainer->SetMeshId(sharedMeshId);
+			}
 
 			auto pSharedMeshResource = mpResourceManager->GetResource<IStaticMesh>(sharedMeshId);
 			if (!pSharedMeshResource || (pSharedMeshResource && (E_RESOURCE_STATE_TYPE::RST_LOADED != mpResourceManager->GetResource<IResource>(sharedMeshId)->GetState())))
 			{
-				++iter;
 				continue;
 			}
 
@@ -170,28 +227,8 @@ namespace TDEngine2
 			{
 				pStaticMeshContainer->SetSystemBuffersHandle(static_cast<U32>(mMeshBuffersMap.size()));
 
-				auto pVertexDecl = mpGraphicsObjectManager->CreateVertexDeclaration().Get();
-
-				mMeshBuffersMap.push_back({ pSharedMeshResource->GetSharedVertexBuffer(), pSharedMeshResource->GetSharedIndexBuffer(), pVertexDecl });
-
-				// \note form the vertex declaration for the mesh
-				pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_POSITION });
-				pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_COLOR });
-
-				if (pSharedMeshResource->HasTexCoords0())
-				{
-					pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_TEXCOORDS });
-				}
-
-				if (pSharedMeshResource->HasNormals())
-				{
-					pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_NORMAL });
-				}
-
-				if (pSharedMeshResource->HasTangents())
-				{
-					pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_TANGENT });
-				}
+				mMeshBuffersMap.push_back({ pSharedMeshResource->GetSharedVertexBuffer(), pSharedMeshResource->GetSharedIndexBuffer(),
+											_createMeshVertexDeclaration(pSharedMeshResource.Get()) });
 
 #if TDE2_EDITORS_ENABLED
 				for (auto&& currSubmeshId : pSharedMeshResource->GetSubmeshesIdentifiers())
@@ -209,33 +246,217 @@ namespace TDEngine2
 
 			const TSubMeshRenderInfo& subMeshInfo = pStaticMeshContainer->GetSubMeshInfo();
 
-			auto meshBuffersEntry = mMeshBuffersMap[pStaticMeshContainer->GetSystemBuffersHandle()];
+			if (!isInstancingEnabled)
+			{
+				mDrawRecords.push_back({ pRenderGroup,
+										 { pSharedMeshResource->GetSharedVertexBuffer(), pSharedMeshResource->GetSharedIndexBuffer(), mMeshBuffersMap[pStaticMeshContainer->GetSystemBuffersHandle()].mpVertexDecl },
+										 currMaterialId, currEntityIndex, subMeshInfo.mStartIndex, subMeshInfo.mIndicesCount, layer, pCastedMaterial->IsTransparent() });
+				continue;
+			}
 
 			auto&& objectTransformMatrix = pTransform->GetLocalToWorldTransform();
 
-			F32 distanceToCamera = ((viewMatrix * objectTransformMatrix) * TVector4(0.0f, 0.0f, 1.0f, 1.0f)).z;
+			const F32 distanceToCamera = std::abs(((viewMatrix * objectTransformMatrix) * TVector4(0.0f, 0.0f, 1.0f, 1.0f)).z);
+
+			/// \note Entities are grouped by the shared mesh and the submesh, the material is the same within the call
+			const U64 batchKey = (static_cast<U64>(static_cast<U32>(sharedMeshId)) << 32) | static_cast<U64>(subMeshInfo.mStartIndex);
+
+			TInstancesBatch& currBatch = mInstancesBatches[batchKey];
 
-			// create a command for the renderer
-			auto pCommand = pRenderGroup->SubmitDrawCommand<TDrawIndexedCommand>(static_cast<U32>(pCastedMaterial->GetGeometrySubGroupTag()) + 
-																				 _computeMeshCommandHash(currMaterialId, distanceToCamera));
+			if (currBatch.mInstances.empty())
+			{
+				mActiveInstancesBatches.push_back(&currBatch);
+
+				currBatch.mLastUsedFrameIndex  = mCurrFrameIndex;
+				currBatch.mpVertexBuffer       = pSharedMeshResource->GetSharedVertexBuffer();
+				currBatch.mpIndexBuffer        = pSharedMeshResource->GetSharedIndexBuffer();
+				currBatch.mpVertexDecl         = _getInstancedVertexDeclaration(sharedMeshId, pSharedMeshResource.Get());
+				currBatch.mStartIndex          = subMeshInfo.mStartIndex;
+				currBatch.mIndicesCount        = subMeshInfo.mIndicesCount;
+				currBatch.mMinDistanceToCamera = distanceToCamera;
+			}
+
+			currBatch.mMinDistanceToCamera = std::min(currBatch.mMinDistanceToCamera, distanceToCamera);
+			currBatch.mInstances.push_back({ Transpose(objectTransformMatrix), Transpose(pTransform->GetWorldToLocalTransform()) });
+		}
+
+		if (isInstancingEnabled)
+		{
+			_submitInstancesBatches(pRenderGroup, materialBucket.mpMaterial);
+		}
+
+		materialBucket.mEntitiesIndices.clear();
+		materialBucket.mpMaterial = nullptr;
+	}
+
+	void CStaticMeshRendererSystem::_submitInstancesBatches(CRenderQueue*& pRenderGroup, TPtr<IMaterial> pCurrMaterial)
+	{
+		auto&& pCastedMaterial = DynamicPtrCast<CBaseMaterial>(pCurrMaterial);
+
+		const TResourceId currMaterialId = pCastedMaterial->GetId();
+		const U8 layer = GetGeometrySubGroupLayer(pCastedMaterial->GetGeometrySubGroupTag());
+
+		const U32 maxInstancesPerDrawCall = StaticMeshInstanceDataBufferSize / sizeof(TStaticMeshInstanceData);
+
+		for (TInstancesBatch* pCurrBatch : mActiveInstancesBatches)
+		{
+			TInstancesBatch& currBatch = *pCurrBatch;
 
-			pCommand->mpVertexBuffer              = pSharedMeshResource->GetSharedVertexBuffer();
-			pCommand->mpIndexBuffer               = pSharedMeshResource->GetSharedIndexBuffer();
-			pCommand->mMaterialHandle             = mpResourceManager->Load<IMaterial>(pStaticMeshContainer->GetMaterialName());
-			pCommand->mpVertexDeclaration         = meshBuffersEntry.mpVertexDecl; // \todo replace with access to a vertex declarations pool
-			pCommand->mStartIndex                 = subMeshInfo.mStartIndex;
-			pCommand->mNumOfIndices               = subMeshInfo.mIndicesCount;
+			const U32 instancesCount = static_cast<U32>(currBatch.mInstances.size());
+
+			/// \note A batch that doesn't fit into a single buffer is split into a few draw calls
+			for (U32 firstInstanceIndex = 0; firstInstanceIndex < instancesCount; firstInstanceIndex += maxInstancesPerDrawCall)
+			{
+				const U32 currInstancesCount = std::min(maxInstancesPerDrawCall, instancesCount - firstInstanceIndex);
+
+				IVertexBuffer* pInstancesBuffer = _getInstancesBuffer();
+				if (!pInstancesBuffer || (RC_OK != pInstancesBuffer->Map(BMT_WRITE_DISCARD)))
+				{
+					break;
+				}
+
+				pInstancesBuffer->Write(&currBatch.mInstances[firstInstanceIndex], currInstancesCount * sizeof(TStaticMeshInstanceData));
+				pInstancesBuffer->Unmap();
+
+				auto pCommand = pRenderGroup->SubmitDrawCommand<TDrawIndexedInstancedCommand>(MakeRenderCommandSortKey(layer, false, currMaterialId, currBatch.mMinDistanceToCamera));
+
+				pCommand->mpVertexBuffer              = currBatch.mpVertexBuffer;
+				pCommand->mpIndexBuffer               = currBatch.mpIndexBuffer;
+				pCommand->mpInstancingBuffer          = pInstancesBuffer;
+				pCommand->mMaterialHandle             = currMaterialId;
+				pCommand->mpVertexDeclaration         = currBatch.mpVertexDecl;
+				pCommand->mPrimitiveType              = E_PRIMITIVE_TOPOLOGY_TYPE::PTT_TRIANGLE_LIST;
+				pCommand->mBaseVertexIndex            = 0;
+				pCommand->mStartIndex                 = currBatch.mStartIndex;
+				pCommand->mIndicesPerInstance         = currBatch.mIndicesCount;
+				pCommand->mStartInstance              = 0;
+				pCommand->mNumOfInstances             = currInstancesCount;
+				pCommand->mObjectData.mModelMatrix    = IdentityMatrix4; /// \note Transforms are read from the instances buffer
+				pCommand->mObjectData.mInvModelMatrix = IdentityMatrix4;
+			}
+
+			currBatch.mInstances.clear();
+		}
+
+		mActiveInstancesBatches.clear();
+	}
+
+	void CStaticMeshRendererSystem::_recordDrawCommands(IWorld* pWorld, const TEntitiesArray& entities, const ICamera* pCamera)
+	{
+		TDE2_PROFILER_SCOPE("CStaticMeshRendererSystem::RecordDrawCommands");
+
+		auto&& viewMatrix = pCamera->GetViewMatrix();
+
+		/// \note Each job reads transforms of its entities and writes commands into the buffer of its worker. Indices of records
+		/// are used as submission indices, so the order of commands doesn't depend on the distribution of jobs
+		pWorld->ParallelForEach(mDrawRecords.size(), [this, &entities, &viewMatrix](USIZE i)
+		{
+			const TDrawRecord& currRecord = mDrawRecords[i];
+
+			auto pTransform = std::get<CTransform*>(entities[currRecord.mEntityIndex]);
+
+			auto&& objectTransformMatrix = pTransform->GetLocalToWorldTransform();
+
+			const F32 distanceToCamera = ((viewMatrix * objectTransformMatrix) * TVector4(0.0f, 0.0f, 1.0f, 1.0f)).z;
+
+			auto pCommand = currRecord.mpRenderGroup->SubmitDrawCommand<TDrawIndexedCommand>(
+				MakeRenderCommandSortKey(currRecord.mLayer, currRecord.mIsTransparent, currRecord.mMaterialId, distanceToCamera), MakeRenderCommandSubmissionIndex(E_RENDER_COMMANDS_RECORDER_TYPE::RCRT_STATIC_MESHES, static_cast<U32>(i)));
+
+			pCommand->mpVertexBuffer              = currRecord.mMeshBuffers.mpVertexBuffer;
+			pCommand->mpIndexBuffer               = currRecord.mMeshBuffers.mpIndexBuffer;
+			pCommand->mMaterialHandle             = currRecord.mMaterialId;
+			pCommand->mpVertexDeclaration         = currRecord.mMeshBuffers.mpVertexDecl; // \todo replace with access to a vertex declarations pool
+			pCommand->mStartIndex                 = currRecord.mStartIndex;
+			pCommand->mNumOfIndices               = currRecord.mIndicesCount;
 			pCommand->mPrimitiveType              = E_PRIMITIVE_TOPOLOGY_TYPE::PTT_TRIANGLE_LIST;
 			pCommand->mObjectData.mModelMatrix    = Transpose(objectTransformMatrix);
-			pCommand->mObjectData.mInvModelMatrix = Transpose(Inverse(objectTransformMatrix));
+			pCommand->mObjectData.mInvModelMatrix = Transpose(pTransform->GetWorldToLocalTransform());
+		});
+	}
 
-			++iter;
+	void CStaticMeshRendererSystem::_pruneInstancesBatches()
+	{
+		for (auto it = mInstancesBatches.begin(); it != mInstancesBatches.end();)
+		{
+			if (mCurrFrameIndex - it->second.mLastUsedFrameIndex > mMaxInstancesBatchUnusedFramesCount)
+			{
+				it = mInstancesBatches.erase(it);
+				continue;
+			}
+
+			++it;
 		}
 	}
 
-	U32 CStaticMeshRendererSystem::_computeMeshCommandHash(TResourceId materialId, F32 distanceToCamera)
+	IVertexDeclaration* CStaticMeshRendererSystem::_createMeshVertexDeclaration(IStaticMesh* pSharedMesh)
 	{
-		return (static_cast<U32>(materialId) << 16) | static_cast<U16>(fabs(distanceToCamera));
+		auto pVertexDecl = mpGraphicsObjectManager->CreateVertexDeclaration().Get();
+
+		// \note form the vertex declaration for the mesh
+		pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_POSITION });
+		pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_COLOR });
+
+		if (pSharedMesh->HasTexCoords0())
+		{
+			pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_TEXCOORDS });
+		}
+
+		if (pSharedMesh->HasNormals())
+		{
+			pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_NORMAL });
+		}
+
+		if (pSharedMesh->HasTangents())
+		{
+			pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 0, TDEngine2::VEST_TANGENT });
+		}
+
+		return pVertexDecl;
+	}
+
+	IVertexDeclaration* CStaticMeshRendererSystem::_getInstancedVertexDeclaration(TResourceId meshId, IStaticMesh* pSharedMesh)
+	{
+		auto it = mInstancedVertexDecls.find(meshId);
+		if (it != mInstancedVertexDecls.end())
+		{
+			return it->second;
+		}
+
+		IVertexDeclaration* pVertexDecl = _createMeshVertexDeclaration(pSharedMesh);
+
+		const U32 firstInstanceElementIndex = pVertexDecl->GetElementsCount();
+
+		/// \note Per-instance data follows the mesh's elements, see TDE2_INSTANCE_MATRIX in TDEngine2Globals.inc
+		for (U32 i = 0; i < 2 * 4; ++i) /// \note Model and inverse model matrices, four elements per each
+		{
+			pVertexDecl->AddElement({ TDEngine2::FT_FLOAT4, 1, TDEngine2::VEST_TEXCOORDS, true });
+		}
+
+		pVertexDecl->AddInstancingDivisor(firstInstanceElementIndex, 1);
+
+		mInstancedVertexDecls.emplace(meshId, pVertexDecl);
+
+		return pVertexDecl;
+	}
+
+	IVertexBuffer* CStaticMeshRendererSystem::_getInstancesBuffer()
+	{
+		if (mUsedInstancesBuffersCount < static_cast<U32>(mInstancesBuffers.size()))
+		{
+			return mInstancesBuffers[mUsedInstancesBuffersCount++];
+		}
+
+		auto createBufferResult = mpGraphicsObjectManager->CreateVertexBuffer(BUT_DYNAMIC, StaticMeshInstanceDataBufferSize, nullptr);
+		if (createBufferResult.HasError())
+		{
+			LOG_ERROR("[CStaticMeshRendererSystem] Couldn't create a buffer for instances data");
+			return nullptr;
+		}
+
+		mInstancesBuffers.push_back(createBufferResult.Get());
+		++mUsedInstancesBuffersCount;
+
+		return mInstancesBuffers.back();
 	}
 
 
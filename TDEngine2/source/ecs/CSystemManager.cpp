@@ -5,19 +5,21 @@
 #include "../../include/ecs/CSpriteRendererSystem.h"
 #include "../../include/utils/Utils.h"
 #include "../../include/core/IEventManager.h"
+#include "../../include/core/IJobManager.h"
 #include "../../include/ecs/CEntity.h"
 #include "../../include/ecs/CBaseComponent.h"
+#include "../../include/editor/CPerfProfiler.h"
 #include <algorithm>
 
 
 namespace TDEngine2
 {
 	CSystemManager::CSystemManager() :
-		CBaseObject(), mpEventManager(nullptr), mpWorld(nullptr)
+		CBaseObject(), mpEventManager(nullptr), mpWorld(nullptr), mpJobManager(nullptr)
 	{
 	}
 
-	E_RESULT_CODE CSystemManager::Init(IWorld* pWorld, IEventManager* pEventManager)
+	E_RESULT_CODE CSystemManager::Init(IWorld* pWorld, IEventManager* pEventManager, IJobManager* pJobManager)
 	{
 		std::lock_guard<std::mutex> lock(mMutex);
 
@@ -34,14 +36,15 @@ namespace TDEngine2
 		mpWorld = pWorld;
 
 		mpEventManager = pEventManager;
+
+		/// \note Without worker threads all systems are updated in the main thread
+		mpJobManager = (pJobManager && pJobManager->GetWorkerThreadsCount()) ? pJobManager : nullptr;
 		
 		/// subscribe the manager onto events of ECS
 		mpEventManager->Subscribe(TOnEntityCreatedEvent::GetTypeId(), this);
 		mpEventManager->Subscribe(TOnEntityRemovedEvent::GetTypeId(), this);
 		mpEventManager->Subscribe(TOnComponentCreatedEvent::GetTypeId(), this);
 		mpEventManager->Subscribe(TOnComponentRemovedEvent::GetTypeId(), this);
-		
-		mIsDirty = true;
 
 		mIsInitialized = true;
 		
@@ -118,6 +121,8 @@ namespace TDEngine2
 			pSystem->InjectBindings(mpWorld);
 		}
 
+		targetSystemIter->mIsDirty = false;
+
 		mpActiveSystems.emplace_back(*targetSystemIter);
 
 		mpDeactivatedSystems.erase(targetSystemIter);
@@ -192,21 +197,23 @@ namespace TDEngine2
 	{
 		std::lock_guard<std::mutex> lock(mMutex);
 
-		ISystem* pCurrSystem = nullptr;
-
-		for (auto currSystemDesc : mpActiveSystems)
+		if (!mpJobManager)
 		{
-			pCurrSystem = currSystemDesc.mpSystem;
-
-			if (mIsDirty)
+			for (auto& currSystemDesc : mpActiveSystems)
 			{
-				pCurrSystem->InjectBindings(mpWorld);
+				_injectBindingsIfDirty(currSystemDesc);
+				currSystemDesc.mpSystem->Update(pWorld, dt);
 			}
 
-			pCurrSystem->Update(pWorld, dt);
+			return;
 		}
 
-		mIsDirty = false;
+		_buildExecutionLevels();
+
+		for (auto&& currLevel : mExecutionLevels)
+		{
+			_updateSystemsLevel(pWorld, dt, currLevel);
+		}
 	}
 
 	E_RESULT_CODE CSystemManager::DestroySystems()
@@ -234,7 +241,47 @@ namespace TDEngine2
 
 	E_RESULT_CODE CSystemManager::OnEvent(const TBaseEvent* pEvent)
 	{
-		mIsDirty = true;
+		const TypeId eventType = pEvent->GetEventType();
+
+		if (TOnComponentCreatedEvent::GetTypeId() == eventType)
+		{
+			if (const TOnComponentCreatedEvent* pComponentCreatedEvent = dynamic_cast<const TOnComponentCreatedEvent*>(pEvent))
+			{
+				_markAffectedSystems(pComponentCreatedEvent->mEntityComponentsTypes, pComponentCreatedEvent->mCreatedComponentTypeId);
+			}
+
+			return RC_OK;
+		}
+
+		if (TOnComponentRemovedEvent::GetTypeId() == eventType)
+		{
+			if (const TOnComponentRemovedEvent* pComponentRemovedEvent = dynamic_cast<const TOnComponentRemovedEvent*>(pEvent))
+			{
+				/// \note The entity should be tested as it was before the removal
+				std::vector<TypeId> entityComponentsTypes = pComponentRemovedEvent->mEntityComponentsTypes;
+
+				const TypeId removedComponentTypeId = pComponentRemovedEvent->mRemovedComponentTypeId;
+				entityComponentsTypes.insert(std::upper_bound(entityComponentsTypes.begin(), entityComponentsTypes.end(), removedComponentTypeId), removedComponentTypeId);
+
+				_markAffectedSystems(entityComponentsTypes, removedComponentTypeId);
+			}
+
+			return RC_OK;
+		}
+
+		if (TOnEntityRemovedEvent::GetTypeId() == eventType)
+		{
+			if (const TOnEntityRemovedEvent* pEntityRemovedEvent = dynamic_cast<const TOnEntityRemovedEvent*>(pEvent))
+			{
+				_markAffectedSystems(pEntityRemovedEvent->mRemovedComponentsTypes, TypeId::Invalid);
+			}
+
+			return RC_OK;
+		}
+
+		/// \note A new entity has no components yet, so only systems without filters are affected
+		_markAffectedSystems({}, TypeId::Invalid);
+
 		return RC_OK;
 	}
 
@@ -300,6 +347,129 @@ namespace TDEngine2
 		return pSystem->Free();
 	}
 
+	void CSystemManager::_markAffectedSystems(const std::vector<TypeId>& entityComponentsTypes, TypeId changedComponentTypeId)
+	{
+		std::lock_guard<std::mutex> lock(mDirtyFlagsMutex);
+
+		for (auto& currSystemDesc : mpActiveSystems)
+		{
+			if (currSystemDesc.mIsDirty)
+			{
+				continue;
+			}
+
+			currSystemDesc.mIsDirty = _isSystemAffected(currSystemDesc.mpSystem, entityComponentsTypes, changedComponentTypeId);
+		}
+
+		/// \note Deactivated systems inject their bindings on activation
+	}
+
+	bool CSystemManager::_isSystemAffected(const ISystem* pSystem, const std::vector<TypeId>& entityComponentsTypes, TypeId changedComponentTypeId)
+	{
+		auto&& componentsFilters = pSystem->GetComponentsFilters();
+		if (componentsFilters.empty())
+		{
+			return true;
+		}
+
+		for (auto&& currFilter : componentsFilters)
+		{
+			if (TypeId::Invalid != changedComponentTypeId && !std::binary_search(currFilter.cbegin(), currFilter.cend(), changedComponentTypeId))
+			{
+				continue;
+			}
+
+			if (std::includes(entityComponentsTypes.cbegin(), entityComponentsTypes.cend(), currFilter.cbegin(), currFilter.cend()))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CSystemManager::_buildExecutionLevels()
+	{
+		TDE2_PROFILER_SCOPE("CSystemManager::_buildExecutionLevels");
+
+		mpLevelsSystems.clear();
+
+		for (const TSystemDesc& currSystemDesc : mpActiveSystems)
+		{
+			mpLevelsSystems.push_back(currSystemDesc.mpSystem);
+		}
+
+		BuildSystemsExecutionLevels(mpLevelsSystems, mExecutionLevels);
+	}
+
+	void CSystemManager::_updateSystemsLevel(IWorld* pWorld, F32 dt, const std::vector<U32>& systemsIndices)
+	{
+		if (systemsIndices.size() == 1)
+		{
+			TSystemDesc& systemDesc = mpActiveSystems[systemsIndices.front()];
+
+			_injectBindingsIfDirty(systemDesc);
+			systemDesc.mpSystem->Update(pWorld, dt);
+
+			return;
+		}
+
+		/// \note Bindings are injected in the main thread before any system of the level starts
+		for (U32 currSystemIndex : systemsIndices)
+		{
+			_injectBindingsIfDirty(mpActiveSystems[currSystemIndex]);
+		}
+
+		TJobCounter systemsJobsCounter;
+
+		for (U32 currSystemIndex : systemsIndices)
+		{
+			ISystem* pSystem = mpActiveSystems[currSystemIndex].mpSystem;
+
+			if (pSystem->GetComponentsAccessInfo().mIsMainThreadRequired)
+			{
+				continue;
+			}
+
+			mpJobManager->SubmitJob(&systemsJobsCounter, [pSystem, pWorld, dt]
+			{
+				TDE2_PROFILER_SCOPE("CSystemManager::UpdateSystemJob");
+				pSystem->Update(pWorld, dt);
+			});
+		}
+
+		for (U32 currSystemIndex : systemsIndices)
+		{
+			ISystem* pSystem = mpActiveSystems[currSystemIndex].mpSystem;
+
+			if (pSystem->GetComponentsAccessInfo().mIsMainThreadRequired)
+			{
+				pSystem->Update(pWorld, dt);
+			}
+		}
+
+		{
+			TDE2_PROFILER_SCOPE("CSystemManager::WaitForSystemsLevel");
+			mpJobManager->WaitForJobCounter(systemsJobsCounter);
+		}
+	}
+
+	void CSystemManager::_injectBindingsIfDirty(TSystemDesc& systemDesc)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mDirtyFlagsMutex);
+
+			if (!systemDesc.mIsDirty)
+			{
+				return;
+			}
+
+			systemDesc.mIsDirty = false;
+		}
+
+		systemDesc.mpSystem->InjectBindings(mpWorld);
+	}
+
 	TSystemId CSystemManager::FindSystem(TypeId typeId)
 	{
 		auto iter = std::find_if(mpActiveSystems.cbegin(), mpActiveSystems.cend(), [typeId](const TSystemDesc& systemDesc)
@@ -311,8 +481,84 @@ namespace TDEngine2
 	}
 
 
-	ISystemManager* CreateSystemManager(IWorld* pWorld, IEventManager* pEventManager, E_RESULT_CODE& result)
+	ISystemManager* CreateSystemManager(IWorld* pWorld, IEventManager* pEventManager, IJobManager* pJobManager, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(ISystemManager, CSystemManager, result, pWorld, pEventManager, pJobManager);
+	}
+
+
+	bool HasSystemsAccessConflict(const ISystem* pLeftSystem, const ISystem* pRightSystem)
+	{
+		const TComponentsAccessInfo& leftAccessInfo = pLeftSystem->GetComponentsAccessInfo();
+		const TComponentsAccessInfo& rightAccessInfo = pRightSystem->GetComponentsAccessInfo();
+
+		if (!leftAccessInfo.mIsDeclared || !rightAccessInfo.mIsDeclared)
+		{
+			return true;
+		}
+
+		auto hasIntersection = [](const std::vector<TypeId>& left, const std::vector<TypeId>& right)
+		{
+			auto leftIt = left.cbegin();
+			auto rightIt = right.cbegin();
+
+			while (leftIt != left.cend() && rightIt != right.cend())
+			{
+				if (*leftIt == *rightIt)
+				{
+					return true;
+				}
+
+				if (*leftIt < *rightIt)
+				{
+					++leftIt;
+				}
+				else
+				{
+					++rightIt;
+				}
+			}
+
+			return false;
+		};
+
+		return hasIntersection(leftAccessInfo.mWrittenComponentsTypes, rightAccessInfo.mWrittenComponentsTypes) ||
+				hasIntersection(leftAccessInfo.mWrittenComponentsTypes, rightAccessInfo.mReadComponentsTypes) ||
+				hasIntersection(leftAccessInfo.mReadComponentsTypes, rightAccessInfo.mWrittenComponentsTypes);
+	}
+
+	void BuildSystemsExecutionLevels(const std::vector<const ISystem*>& systems, std::vector<std::vector<U32>>& levels)
 	{
-		return CREATE_IMPL(ISystemManager, CSystemManager, result, pWorld, pEventManager);
+		for (auto& currLevel : levels)
+		{
+			currLevel.clear();
+		}
+
+		std::vector<U32> systemsLevelsIndices;
+		systemsLevelsIndices.reserve(systems.size());
+
+		for (U32 i = 0; i < static_cast<U32>(systems.size()); ++i)
+		{
+			U32 levelIndex = 0;
+
+			for (U32 j = 0; j < i; ++j)
+			{
+				if (systemsLevelsIndices[j] >= levelIndex && HasSystemsAccessConflict(systems[j], systems[i]))
+				{
+					levelIndex = systemsLevelsIndices[j] + 1;
+				}
+			}
+
+			systemsLevelsIndices.push_back(levelIndex);
+
+			if (levelIndex >= levels.size())
+			{
+				levels.resize(levelIndex + 1);
+			}
+
+			levels[levelIndex].push_back(i);
+		}
+
+		levels.erase(std::remove_if(levels.begin(), levels.end(), [](auto&& level) { return level.empty(); }), levels.end());
 	}
 }
\ No newline at end of file
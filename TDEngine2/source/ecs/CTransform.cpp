@@ -9,6 +9,7 @@ namespace TDEngine2
 	CTransform::CTransform() :
 		CBaseComponent(), 
 		mLocalToWorldMatrix(IdentityMatrix4), 
+		mWorldToLocalMatrix(IdentityMatrix4),
 		mHasChanged(true),
 		mPosition(ZeroVector3),
 		mRotation(UnitQuaternion),
@@ -14,6 +14,12 @@ namespace TDEngine2
 	CTransformSystem::CTransformSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CTransform>();
+		_addComponentsFilter<CTransform, CBoundsComponent>();
+		_addComponentsFilter<CTransform, CPerspectiveCamera>();
+		_addComponentsFilter<CTransform, COrthoCamera>();
+
+		_addWriteAccess<CTransform, CBoundsComponent>();
 	}
 
 	E_RESULT_CODE CTransformSystem::Init(IGraphicsContext* pGraphicsContext)
@@ -420,6 +420,16 @@ namespace TDEngine2
 	CUIElementsProcessSystem::CUIElementsProcessSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CTransform, CLayoutElement>();
+		_addComponentsFilter<CLayoutElement, CImage>();
+		_addComponentsFilter<CLayoutElement, C9SliceImage>();
+		_addComponentsFilter<CLayoutElement, CLabel>();
+		_addComponentsFilter<CTransform, CCanvas>();
+		_addComponentsFilter<CTransform, CGridGroupLayout>();
+		_addComponentsFilter<CLayoutElement, CUIElementMeshData>();
+
+		_addWriteAccess<CTransform, CLayoutElement, CCanvas, CGridGroupLayout, CImage, C9SliceImage, CLabel, CUIElementMeshData>();
+		_requireMainThread(); /// \note Images and fonts are loaded during the update
 	}
 
 	E_RESULT_CODE CUIElementsProcessSystem::Init(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager)
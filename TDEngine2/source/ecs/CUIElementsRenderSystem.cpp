@@ -27,6 +27,13 @@ namespace TDEngine2
 	CUIElementsRenderSystem::CUIElementsRenderSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CCanvas>();
+		_addComponentsFilter<CLayoutElement>();
+		_addComponentsFilter<CUIElementMeshData>();
+		_addComponentsFilter<CUIElementMeshData, CTransform>();
+
+		_addReadAccess<CCanvas, CLayoutElement, CUIElementMeshData, CTransform>();
+		_requireMainThread(); /// \note Vertex and index buffers are mapped during the update
 	}
 
 	E_RESULT_CODE CUIElementsRenderSystem::Init(IRenderer* pRenderer, IGraphicsObjectManager* pGraphicsObjectManager)
@@ -15,6 +15,13 @@ namespace TDEngine2
 	CUIEventsSystem::CUIEventsSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CCanvas>();
+		_addComponentsFilter<CLayoutElement>();
+		_addComponentsFilter<CInputReceiver>();
+		_addComponentsFilter<CInputReceiver, CTransform>();
+
+		_addReadAccess<CLayoutElement>();
+		_addWriteAccess<CInputReceiver>();
 	}
 
 	E_RESULT_CODE CUIEventsSystem::Init(IInputContext* pInputContext)
@@ -5,6 +5,7 @@
 #include "../../include/ecs/CComponentManager.h"
 #include "../../include/ecs/CSystemManager.h"
 #include "../../include/core/IEventManager.h"
+#include "../../include/core/IJobManager.h"
 #include "../../include/editor/CPerfProfiler.h"
 #include "../../include/physics/IRaycastContext.h"
 #include "../../include/graphics/CBaseCamera.h"
@@ -20,7 +21,7 @@ namespace TDEngine2
 	{
 	}
 
-	E_RESULT_CODE CWorld::Init(TPtr<IEventManager> pEventManager)
+	E_RESULT_CODE CWorld::Init(TPtr<IEventManager> pEventManager, TPtr<IJobManager> pJobManager)
 	{
 		std::lock_guard<std::mutex> lock(mMutex);
 
@@ -52,7 +53,7 @@ namespace TDEngine2
 			return result;
 		}
 		
-		mpSystemManager = CreateSystemManager(this, pEventManager.Get(), result);
+		mpSystemManager = CreateSystemManager(this, pEventManager.Get(), pJobManager.Get(), result);
 
 		if (result != RC_OK)
 		{
@@ -60,6 +61,7 @@ namespace TDEngine2
 		}
 
 		mpEventManager   = pEventManager;
+		mpJobManager     = pJobManager;
 		mpRaycastContext = nullptr;
 
 		mIsInitialized = true;
@@ -186,6 +188,9 @@ namespace TDEngine2
 		TDE2_PROFILER_SCOPE("World::Update");
 		mpSystemManager->Update(this, mTimeScaleFactor * dt);
 
+		/// \note Components which were removed during the frame are returned into their pools, systems rebind their components before the next update
+		mpComponentManager->ReleaseDestroyedComponents();
+
 		// \note reset all allocated raycasts results data
 		mpRaycastContext->Reset();
 	}
@@ -224,6 +229,18 @@ namespace TDEngine2
 		return mpComponentManager->FindEntitiesWithAny(types);
 	}
 
+	void CWorld::_parallelFor(USIZE elementsCount, USIZE elementSize, const std::function<void(USIZE, USIZE)>& action)
+	{
+		if (!mpJobManager) /// \note Process all elements in the calling thread if there is no job manager
+		{
+			action(0, elementsCount);
+			return;
+		}
+
+		E_RESULT_CODE result = mpJobManager->ParallelFor(elementsCount, elementSize, action);
+		TDE2_ASSERT(RC_OK == result);
+	}
+
 	TEntityId CWorld::_findEntityWithUniqueComponent(TypeId typeId)
 	{
 		TEntityId entityId = mpComponentManager->FindEntityWithUniqueComponent(typeId);
@@ -252,9 +269,9 @@ namespace TDEngine2
 	}
 	
 
-	IWorld* CreateWorld(TPtr<IEventManager> pEventManager, E_RESULT_CODE& result)
+	IWorld* CreateWorld(TPtr<IEventManager> pEventManager, TPtr<IJobManager> pJobManager, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(IWorld, CWorld, result, pEventManager);
+		return CREATE_IMPL(IWorld, CWorld, result, pEventManager, pJobManager);
 	}
 
 
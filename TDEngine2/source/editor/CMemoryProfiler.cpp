@@ -57,6 +57,28 @@ namespace TDEngine2
 	}
 
 
+	E_RESULT_CODE CMemoryProfiler::UpdatePoolAllocatorInfo(const std::string& name, const TPoolAllocatorInfo& info)
+	{
+		if (name.empty())
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		mPoolAllocatorsInfoRegistry[name] = info;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CMemoryProfiler::UpdateResourcesMemoryInfo(const TResourcesMemoryInfo& info)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mResourcesMemoryInfo = info;
+
+		return RC_OK;
+	}
+
+
 	static std::string GetStackTrace() {
 		std::ostringstream ss;
 
@@ -126,6 +148,18 @@ namespace TDEngine2
 		return mBlocksInfoRegistry;
 	}
 
+	CMemoryProfiler::TPoolAllocatorsStatistics CMemoryProfiler::GetPoolAllocatorsStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mPoolAllocatorsInfoRegistry;
+	}
+
+	TResourcesMemoryInfo CMemoryProfiler::GetResourcesMemoryInfo() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mResourcesMemoryInfo;
+	}
+
 	USIZE CMemoryProfiler::GetTotalMemoryAvailable() const
 	{
 		return mTotalMemorySize;
@@ -35,6 +35,7 @@ namespace TDEngine2
 
 		mFramesTimesStatistics.resize(mLogBuffer);
 		mFramesStatistics.resize(mLogBuffer);
+		mFramesCounters.resize(mLogBuffer);
 	}
 
 	E_RESULT_CODE CPerfProfiler::_onFreeInternal()
@@ -44,6 +45,8 @@ namespace TDEngine2
 
 	E_RESULT_CODE CPerfProfiler::BeginFrame()
 	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
 		if (mIsRecording)
 		{
 			return RC_FAIL;
@@ -57,11 +60,15 @@ namespace TDEngine2
 			currSample.second.clear();
 		}
 
+		mFramesCounters[mCurrFrameIndex].clear();
+
 		return RC_OK;
 	}
 
 	E_RESULT_CODE CPerfProfiler::EndFrame()
 	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
 		if (!mIsRecording)
 		{
 			return RC_FAIL;
@@ -80,6 +87,8 @@ namespace TDEngine2
 
 	void CPerfProfiler::WriteSample(const std::string& name, F32 startTime, F32 duration, USIZE threadID)
 	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
 		TDE2_ASSERT(mFramesStatistics.size() > mCurrFrameIndex);
 
 		auto&& currSamplesLog = mFramesStatistics[mCurrFrameIndex][threadID];
@@ -91,6 +100,14 @@ namespace TDEngine2
 		currSamplesLog.insert(insertIter, { startTime - mFramesTimesStatistics[mCurrFrameIndex], duration, threadID, name });
 	}
 
+	void CPerfProfiler::WriteCounter(const std::string& name, F32 value)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		TDE2_ASSERT(mFramesCounters.size() > mCurrFrameIndex);
+		mFramesCounters[mCurrFrameIndex][name] = value;
+	}
+
 	ITimer* CPerfProfiler::GetTimer() const
 	{
 		return mpPerformanceTimer;
@@ -113,6 +130,13 @@ namespace TDEngine2
 	}
 
 
+	const CPerfProfiler::TCountersTable& CPerfProfiler::GetCountersByFrameIndex(U32 frameIndex) const
+	{
+		TDE2_ASSERT(frameIndex < mFramesCounters.size());
+		return mFramesCounters[frameIndex];
+	}
+
+
 	TDE2_API TPtr<ITimeProfiler> CPerfProfiler::Get()
 	{
 		static TPtr<ITimeProfiler> pInstance = TPtr<ITimeProfiler>(new (std::nothrow) CPerfProfiler());
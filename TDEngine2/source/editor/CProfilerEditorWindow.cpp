@@ -253,6 +253,30 @@ namespace TDEngine2
 				mpImGUIContext->EndChildWindow();
 			}
 
+			mpImGUIContext->Label("Pool Allocators (live / capacity, occupancy, fragmentation):");
+
+			for (auto&& currPoolInfo : CMemoryProfiler::Get()->GetPoolAllocatorsStatistics())
+			{
+				const TPoolAllocatorInfo& info = currPoolInfo.second;
+
+				mpImGUIContext->Label(Wrench::StringUtils::Format("{0}: {1} / {2}, {3}%, {4}%", currPoolInfo.first, info.mLiveObjectsCount, info.mCapacity,
+																	static_cast<U32>(100.0f * info.GetOccupancy()), static_cast<U32>(100.0f * info.GetFragmentation())));
+			}
+
+			const TResourcesMemoryInfo resourcesInfo = CMemoryProfiler::Get()->GetResourcesMemoryInfo();
+
+			mpImGUIContext->Label(Wrench::StringUtils::Format("Resources: {0} / {1} KiB, evictions: {2} ({3} KiB)", resourcesInfo.mUsedSize >> 10, 
+															  resourcesInfo.mBudget ? std::to_string(resourcesInfo.mBudget >> 10) : "unlimited", 
+															  resourcesInfo.mEvictionsCount, resourcesInfo.mEvictedSize >> 10));
+
+			for (auto&& currTypeInfo : resourcesInfo.mTypesInfo)
+			{
+				const TResourceTypeMemoryInfo& info = currTypeInfo.second;
+
+				mpImGUIContext->Label(Wrench::StringUtils::Format("{0}: {1} loaded, {2} KiB, {3} evicted", currTypeInfo.first, info.mLoadedCount, 
+																	info.mMemorySize >> 10, info.mEvictionsCount));
+			}
+
 			mpImGUIContext->EndWindow();
 		}
 
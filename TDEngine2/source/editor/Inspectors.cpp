@@ -236,6 +236,21 @@ namespace TDEngine2
 
 				imguiContext.EndHorizontal();
 			}
+
+			/// \note Static flag
+			{
+				bool isStatic = meshContainer.IsStatic();
+
+				imguiContext.BeginHorizontal();
+				imguiContext.Label("Static");
+				imguiContext.Checkbox("##IsStatic", isStatic);
+				imguiContext.EndHorizontal();
+
+				if (meshContainer.IsStatic() != isStatic)
+				{
+					meshContainer.SetStatic(isStatic);
+				}
+			}
 		}
 	}
 
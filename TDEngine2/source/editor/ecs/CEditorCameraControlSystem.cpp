@@ -17,6 +17,7 @@ namespace TDEngine2
 	CEditorCameraControlSystem::CEditorCameraControlSystem() :
 		CBaseSystem()
 	{
+		_addComponentsFilter<CEditorCamera>();
 	}
 
 	E_RESULT_CODE CEditorCameraControlSystem::Init(IInputContext* pInputContext, IEditorsManager* pEditorManager)
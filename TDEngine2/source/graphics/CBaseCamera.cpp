@@ -199,30 +199,29 @@ namespace TDEngine2
 
 	bool CFrustum::TestAABB(const TAABB& box) const
 	{
-		TVector3 min = box.min;
-		TVector3 max = box.max;
-
-		std::array<TVector3, 8> boxVertices
+		/// \note The box is outside if its vertex that's the farthest along plane's normal stays behind any of planes.
+		/// Unlike testing of the box's corners it doesn't reject boxes that are larger than the frustum
+		for (auto&& currPlane : mPlanes)
 		{
-			min,
-			TVector3(min.x, min.y, max.z),
-			TVector3(min.x, max.y, min.z),
-			TVector3(min.x, max.y, max.z),
-			TVector3(max.x, min.y, min.z),
-			TVector3(max.x, min.y, max.z),
-			TVector3(max.x, max.y, min.z),
-			max,
-		};
+			const TVector3 farthestVertex
+			{
+				currPlane.a >= 0.0f ? box.max.x : box.min.x,
+				currPlane.b >= 0.0f ? box.max.y : box.min.y,
+				currPlane.c >= 0.0f ? box.max.z : box.min.z,
+			};
 
-		for (auto&& v : boxVertices)
-		{
-			if (TestPoint(v))
+			if (CalcDistanceFromPlaneToPoint(currPlane, farthestVertex) < 0.0f)
 			{
-				return true;
+				return false;
 			}
 		}
 
-		return false;
+		return true;
+	}
+
+	const CFrustum::TPlanesArray& CFrustum::GetPlanes() const
+	{
+		return mPlanes;
 	}
 
 
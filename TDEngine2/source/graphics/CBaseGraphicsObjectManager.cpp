@@ -3,7 +3,9 @@
 #include "../../include/core/IGraphicsContext.h"
 #include "../../include/graphics/CDebugUtility.h"
 #include "../../include/graphics/IRenderer.h"
+#include "../../include/graphics/IBuffer.h"
 #include <unordered_map>
+#include <algorithm>
 
 
 namespace TDEngine2
@@ -116,6 +118,25 @@ namespace TDEngine2
 		return;
 	}
 
+	E_RESULT_CODE CBaseGraphicsObjectManager::DestroyBuffer(IBuffer* pBuffer)
+	{
+		if (!pBuffer)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		auto it = std::find(mBuffersArray.begin(), mBuffersArray.end(), pBuffer);
+		if (it == mBuffersArray.end())
+		{
+			return RC_FAIL;
+		}
+
+		*it = nullptr;
+		mFreeBuffersSlots.push_back(static_cast<U32>(std::distance(mBuffersArray.begin(), it)));
+
+		return pBuffer->Free();
+	}
+
 	void CBaseGraphicsObjectManager::_insertVertexDeclaration(IVertexDeclaration* pVertDecl)
 	{
 		U32 index = 0;
@@ -14,6 +14,7 @@
 #include "../../include/math/MathUtils.h"
 #include "stringUtils.hpp"
 #include <cstring>
+#include <memory>
 
 
 namespace TDEngine2
@@ -24,6 +25,8 @@ namespace TDEngine2
 		static const std::string mTransparencyKey;
 
 		static const std::string mGeometryTagKey;
+
+		static const std::string mInstancingKey;
 		
 		static const std::string mBlendStateGroup;
 
@@ -87,6 +90,7 @@ namespace TDEngine2
 	const std::string TMaterialArchiveKeys::mTransparencyKey = "transparency_enabled";
 	const std::string TMaterialArchiveKeys::mBlendStateGroup = "blend_state";
 	const std::string TMaterialArchiveKeys::mGeometryTagKey  = "geom_tag";
+	const std::string TMaterialArchiveKeys::mInstancingKey   = "instancing_enabled";
 
 	const std::string TMaterialArchiveKeys::TBlendStateKeys::mSrcColorKey       = "src_color";
 	const std::string TMaterialArchiveKeys::TBlendStateKeys::mDestColorKey      = "dest_color";
@@ -172,6 +176,38 @@ namespace TDEngine2
 		return RC_NOT_IMPLEMENTED_YET;
 	}
 
+	E_RESULT_CODE CBaseMaterial::Evict()
+	{
+		if (mpInstancesUserUniformBuffers.size() > 1)
+		{
+			return RC_FAIL;
+		}
+
+		mInstancesAssignedTextures.clear();
+
+		return RC_OK;
+	}
+
+	USIZE CBaseMaterial::GetMemorySize() const
+	{
+		if (E_RESOURCE_STATE_TYPE::RST_LOADED != mState)
+		{
+			return 0;
+		}
+
+		USIZE size = sizeof(*this);
+
+		for (auto&& currInstanceUniforms : mpInstancesUserUniformBuffers)
+		{
+			for (auto&& currUniformBuffer : currInstanceUniforms.second)
+			{
+				size += currUniformBuffer.size();
+			}
+		}
+
+		return size;
+	}
+
 	TPtr<IMaterialInstance> CBaseMaterial::CreateInstance()
 	{
 		if (!mIsInitialized)
@@ -213,6 +249,19 @@ namespace TDEngine2
 	}
 
 	E_RESULT_CODE CBaseMaterial::Load(IArchiveReader* pReader)
+	{
+		TMaterialResourcesBindings bindings;
+
+		E_RESULT_CODE result = LoadParameters(pReader, bindings);
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		return BindResources(bindings);
+	}
+
+	E_RESULT_CODE CBaseMaterial::LoadParameters(IArchiveReader* pReader, TMaterialResourcesBindings& bindings)
 	{
 		if (!pReader)
 		{
@@ -232,9 +281,11 @@ namespace TDEngine2
 			LOG_WARNING(Wrench::StringUtils::Format("[BaseMaterial] Missing \"{0}\" group of parameters", groupName));
 		};
 
-		SetShader(pReader->GetString(TMaterialArchiveKeys::mShaderIdKey));
+		bindings.mShaderName = pReader->GetString(TMaterialArchiveKeys::mShaderIdKey);
+
 		SetTransparentState(pReader->GetBool(TMaterialArchiveKeys::mTransparencyKey));
 		SetGeometrySubGroupTag(Meta::EnumTrait<E_GEOMETRY_SUBGROUP_TAGS>::FromString(pReader->GetString(TMaterialArchiveKeys::mGeometryTagKey)));
+		SetInstancingEnabled(pReader->GetBool(TMaterialArchiveKeys::mInstancingKey));
 
 		processGroup(TMaterialArchiveKeys::mBlendStateGroup, [pReader, this]
 		{
@@ -292,7 +343,7 @@ namespace TDEngine2
 			// \todo Add another parameters
 		});
 
-		processGroup(TMaterialArchiveKeys::mTexturesGroup, [pReader, this]
+		processGroup(TMaterialArchiveKeys::mTexturesGroup, [pReader, &bindings]
 		{
 			E_RESULT_CODE result = RC_OK;
 
@@ -311,15 +362,14 @@ namespace TDEngine2
 				{
 					pReader->BeginGroup(Wrench::StringUtils::GetEmptyStr());
 
-					std::string slotId = pReader->GetString(TMaterialArchiveKeys::TTextureKeys::mSlotKey);
-					std::string textureId = pReader->GetString(TMaterialArchiveKeys::TTextureKeys::mTextureKey);
+					TMaterialResourcesBindings::TTextureBinding textureBinding;
 
-					TypeId textureTypeId = TypeId(pReader->GetUInt32(TMaterialArchiveKeys::TTextureKeys::mTextureTypeKey));
-					if (SetTextureResource(slotId, mpResourceManager->GetResource<ITexture>(mpResourceManager->Load(textureId, textureTypeId)).Get(), instanceId) != RC_OK)
-					{
-						LOG_WARNING(Wrench::StringUtils::Format("[BaseMaterial] Couldn't load texture \"{0}\"", textureId));
-						result = result | RC_FAIL;
-					}
+					textureBinding.mInstanceId = instanceId;
+					textureBinding.mSlotId = pReader->GetString(TMaterialArchiveKeys::TTextureKeys::mSlotKey);
+					textureBinding.mTextureId = pReader->GetString(TMaterialArchiveKeys::TTextureKeys::mTextureKey);
+					textureBinding.mTextureTypeId = TypeId(pReader->GetUInt32(TMaterialArchiveKeys::TTextureKeys::mTextureTypeKey));
+
+					bindings.mTextures.emplace_back(std::move(textureBinding));
 
 					pReader->EndGroup();
 				}
@@ -336,6 +386,23 @@ namespace TDEngine2
 		return RC_OK;
 	}
 
+	E_RESULT_CODE CBaseMaterial::BindResources(const TMaterialResourcesBindings& bindings)
+	{
+		SetShader(bindings.mShaderName);
+
+		for (auto&& currTextureBinding : bindings.mTextures)
+		{
+			const TResourceId textureId = mpResourceManager->Load(currTextureBinding.mTextureId, currTextureBinding.mTextureTypeId);
+
+			if (SetTextureResource(currTextureBinding.mSlotId, mpResourceManager->GetResource<ITexture>(textureId).Get(), currTextureBinding.mInstanceId) != RC_OK)
+			{
+				LOG_WARNING(Wrench::StringUtils::Format("[BaseMaterial] Couldn't load texture \"{0}\"", currTextureBinding.mTextureId));
+			}
+		}
+
+		return RC_OK;
+	}
+
 	E_RESULT_CODE CBaseMaterial::Save(IArchiveWriter* pWriter)
 	{
 		if (!pWriter)
@@ -353,6 +420,7 @@ namespace TDEngine2
 		pWriter->SetString(TMaterialArchiveKeys::mShaderIdKey, mpResourceManager->GetResource(mShaderHandle)->GetName());
 		pWriter->SetBool(TMaterialArchiveKeys::mTransparencyKey, mBlendStateParams.mIsEnabled);
 		pWriter->SetString(TMaterialArchiveKeys::mGeometryTagKey, Meta::EnumTrait<E_GEOMETRY_SUBGROUP_TAGS>::ToString(mTag));
+		pWriter->SetBool(TMaterialArchiveKeys::mInstancingKey, mIsInstancingEnabled);
 
 		pWriter->BeginGroup(TMaterialArchiveKeys::mBlendStateGroup);
 		{
@@ -421,7 +489,7 @@ namespace TDEngine2
 					{
 						pWriter->SetString(TMaterialArchiveKeys::TTextureKeys::mSlotKey, textureEntry.first);
 
-						if (auto pTexture = dynamic_cast<IResource*>(textureEntry.second))
+						if (auto pTexture = dynamic_cast<const IResource*>(textureEntry.second.Get()))
 						{
 							pWriter->SetUInt32(TMaterialArchiveKeys::TTextureKeys::mTextureTypeKey, static_cast<U32>(pTexture->GetResourceTypeId()));
 							pWriter->SetString(TMaterialArchiveKeys::TTextureKeys::mTextureKey, pTexture->GetName());
@@ -449,7 +517,12 @@ namespace TDEngine2
 			return;
 		}
 
-		PANIC_ON_FAILURE(_initDefaultInstance(*mpResourceManager->GetResource<IShader>(mShaderHandle)->GetShaderMetaData()));
+		const TShaderCompilerOutput* pShaderMetadata = mpResourceManager->GetResource<IShader>(mShaderHandle)->GetShaderMetaData();
+
+		PANIC_ON_FAILURE(_initDefaultInstance(*pShaderMetadata));
+
+		/// \note The variant declares the same resources as the shader does, so instances' data is bound into it without changes
+		mInstancedShaderHandle = pShaderMetadata->mIsInstancingSupported ? mpResourceManager->Load<IShader>(GetInstancedShaderVariantName(shaderName)) : TResourceId::Invalid;
 	}
 
 	void CBaseMaterial::SetTransparentState(bool isTransparent)
@@ -472,9 +545,9 @@ namespace TDEngine2
 		mBlendStateParams.mAlphaOpType = alphaOpType;
 	}
 
-	void CBaseMaterial::Bind(TMaterialInstanceId instanceId)
+	void CBaseMaterial::Bind(TMaterialInstanceId instanceId, bool useInstancedShader)
 	{
-		auto pShaderInstance = mpResourceManager->GetResource<IShader>(mShaderHandle);
+		auto pShaderInstance = mpResourceManager->GetResource<IShader>(useInstancedShader ? GetInstancedShaderHandle() : mShaderHandle);
 
 		if (!pShaderInstance || (instanceId == TMaterialInstanceId::Invalid))
 		{
@@ -502,31 +575,19 @@ namespace TDEngine2
 
 		mpGraphicsContext->BindRasterizerState(mRasterizerStateHandle);
 
-		auto iter = mpInstancesUserUniformBuffers.find(instanceId);
-		if (iter != mpInstancesUserUniformBuffers.cend())
-		{
-			auto&& instanceUniformBuffers = iter->second;
-
-			U8 userUniformBufferId = 0;
-			for (const auto& currUserDataBuffer : instanceUniformBuffers)
-			{
-				if (!currUserDataBuffer.size())
-				{
-					continue;
-				}
-
-				PANIC_ON_FAILURE(pShaderInstance->SetUserUniformsBuffer(userUniformBufferId++, &currUserDataBuffer.front(), currUserDataBuffer.size()));
-			}
-		}
+		_bindInstanceData(pShaderInstance.Get(), instanceId);
+	}
 
-		auto&& instanceTexturesStorage = mInstancesAssignedTextures[instanceId];
+	void CBaseMaterial::BindInstanceData(TMaterialInstanceId instanceId, bool useInstancedShader)
+	{
+		auto pShaderInstance = mpResourceManager->GetResource<IShader>(useInstancedShader ? GetInstancedShaderHandle() : mShaderHandle);
 
-		for (auto iter = instanceTexturesStorage.cbegin(); iter != instanceTexturesStorage.cend(); ++iter)
+		if (!pShaderInstance || (instanceId == TMaterialInstanceId::Invalid))
 		{
-			pShaderInstance->SetTextureResource(iter->first, iter->second);
+			return;
 		}
 
-		pShaderInstance->Bind();
+		_bindInstanceData(pShaderInstance.Get(), instanceId);
 	}
 
 	E_RESULT_CODE CBaseMaterial::SetTextureResource(const std::string& resourceName, ITexture* pTexture, TMaterialInstanceId instanceId)
@@ -536,7 +597,9 @@ namespace TDEngine2
 			return RC_INVALID_ARGS;
 		}
 
-		mInstancesAssignedTextures[instanceId][resourceName] = pTexture;
+		/// \note The resource manager evicts only textures that aren't referenced, so the material keeps its own reference
+		pTexture->AddRef();
+		mInstancesAssignedTextures[instanceId][resourceName] = TPtr<ITexture>(pTexture);
 
 		return RC_OK;
 	}
@@ -624,6 +687,11 @@ namespace TDEngine2
 		mTag = tag;
 	}
 
+	void CBaseMaterial::SetInstancingEnabled(bool value)
+	{
+		mIsInstancingEnabled = value;
+	}
+
 	U32 CBaseMaterial::GetVariableHash(const std::string& name) const
 	{
 		return TDE2_STRING_ID(name.c_str());
@@ -634,11 +702,21 @@ namespace TDEngine2
 		return mShaderHandle;
 	}
 
+	TResourceId CBaseMaterial::GetInstancedShaderHandle() const
+	{
+		return (TResourceId::Invalid != mInstancedShaderHandle) ? mInstancedShaderHandle : mShaderHandle;
+	}
+
 	bool CBaseMaterial::IsTransparent() const
 	{
 		return mBlendStateParams.mIsEnabled;
 	}
 
+	bool CBaseMaterial::IsInstancingEnabled() const
+	{
+		return mIsInstancingEnabled || (TResourceId::Invalid != mInstancedShaderHandle);
+	}
+
 	const E_GEOMETRY_SUBGROUP_TAGS& CBaseMaterial::GetGeometrySubGroupTag() const
 	{
 		return mTag;
@@ -664,11 +742,11 @@ namespace TDEngine2
 				return nullptr;
 			}
 
-			return it->second.begin()->second;
+			return const_cast<ITexture*>(it->second.begin()->second.Get());
 		}
 
 		auto textureResourceIt = it->second.find(id);
-		return (textureResourceIt == it->second.cend()) ? nullptr : textureResourceIt->second;
+		return (textureResourceIt == it->second.cend()) ? nullptr : const_cast<ITexture*>(textureResourceIt->second.Get());
 	}
 
 	bool CBaseMaterial::IsScissorTestEnabled() const
@@ -795,6 +873,35 @@ namespace TDEngine2
 		return result;
 	}
 
+	void CBaseMaterial::_bindInstanceData(IShader* pShaderInstance, TMaterialInstanceId instanceId)
+	{
+		auto iter = mpInstancesUserUniformBuffers.find(instanceId);
+		if (iter != mpInstancesUserUniformBuffers.cend())
+		{
+			auto&& instanceUniformBuffers = iter->second;
+
+			U8 userUniformBufferId = 0;
+			for (const auto& currUserDataBuffer : instanceUniformBuffers)
+			{
+				if (!currUserDataBuffer.size())
+				{
+					continue;
+				}
+
+				PANIC_ON_FAILURE(pShaderInstance->SetUserUniformsBuffer(userUniformBufferId++, &currUserDataBuffer.front(), currUserDataBuffer.size()));
+			}
+		}
+
+		auto&& instanceTexturesStorage = mInstancesAssignedTextures[instanceId];
+
+		for (auto iter = instanceTexturesStorage.begin(); iter != instanceTexturesStorage.end(); ++iter)
+		{
+			pShaderInstance->SetTextureResource(iter->first, iter->second.Get());
+		}
+
+		pShaderInstance->Bind();
+	}
+
 	const TPtr<IResourceLoader> CBaseMaterial::_getResourceLoader()
 	{
 		return mpResourceManager->GetResourceLoader<IMaterial>();
@@ -901,12 +1008,46 @@ namespace TDEngine2
 			return RC_FAIL;
 		}
 
-		if (TResult<TFileEntryId> materialFileId = mpFileSystem->Open<IYAMLFileReader>(pResource->GetName()))
+		CBaseMaterial* pMaterial = dynamic_cast<CBaseMaterial*>(pResource);
+		if (!pMaterial)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		TResult<TFileEntryId> materialFileId = mpFileSystem->Open<IYAMLFileReader>(pResource->GetName());
+		if (materialFileId.HasError())
+		{
+			return RC_FILE_NOT_FOUND;
+		}
+
+		auto pBindings = std::make_shared<TMaterialResourcesBindings>();
+
+		E_RESULT_CODE result = pMaterial->LoadParameters(mpFileSystem->Get<IYAMLFileReader>(materialFileId.Get()), *pBindings);
+		if (RC_OK != result)
 		{
-			return dynamic_cast<IMaterial*>(pResource)->Load(mpFileSystem->Get<IYAMLFileReader>(materialFileId.Get()));
+			return result;
 		}
 
-		return RC_FILE_NOT_FOUND;
+		/// \note The shader and textures are loaded by workers too, the material waits for them without occupying a worker
+		TAsyncLoadingParams bindingParams;
+
+		bindingParams.mDependencies.push_back(mpResourceManager->LoadAsync<IShader>(pBindings->mShaderName));
+
+		for (auto&& currTextureBinding : pBindings->mTextures)
+		{
+			bindingParams.mDependencies.push_back(mpResourceManager->LoadAsync(currTextureBinding.mTextureId, currTextureBinding.mTextureTypeId, {}));
+		}
+
+		pResource->SetState(E_RESOURCE_STATE_TYPE::RST_LOADING);
+
+		/// \note The reference keeps the material alive until the action is executed
+		pResource->AddRef();
+		TPtr<IResource> pMaterialResource = TPtr<IResource>(pResource);
+
+		return mpResourceManager->ExecuteAfterLoading(bindingParams, [pMaterialResource, pMaterial, pBindings]
+		{
+			pMaterialResource->SetState((RC_OK == pMaterial->BindResources(*pBindings)) ? E_RESOURCE_STATE_TYPE::RST_LOADED : E_RESOURCE_STATE_TYPE::RST_UNLOADED);
+		});
 	}
 
 	TypeId CBaseMaterialLoader::GetResourceTypeId() const
@@ -4,6 +4,8 @@
 #include "../../include/core/IJobManager.h"
 #include "../../include/core/IGraphicsContext.h"
 #include "../../include/graphics/IGraphicsObjectManager.h"
+#include "../../include/graphics/IVertexBuffer.h"
+#include "../../include/graphics/IIndexBuffer.h"
 #include "../../include/graphics/CGeometryBuilder.h"
 #include "../../include/utils/CFileLogger.h"
 #include <cstring>
@@ -13,7 +15,7 @@
 namespace TDEngine2
 {
 	CBaseMesh::CBaseMesh() :
-		CBaseResource()
+		CBaseResource(), mpSharedVertexBuffer(nullptr), mpPositionOnlyVertexBuffer(nullptr), mpSharedIndexBuffer(nullptr)
 	{
 	}
 
@@ -73,6 +75,57 @@ namespace TDEngine2
 		return RC_NOT_IMPLEMENTED_YET;
 	}
 
+	E_RESULT_CODE CBaseMesh::Evict()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		E_RESULT_CODE result = RC_OK;
+
+		IBuffer* buffers[] { mpSharedVertexBuffer, mpPositionOnlyVertexBuffer, mpSharedIndexBuffer };
+
+		for (IBuffer* pCurrBuffer : buffers)
+		{
+			if (pCurrBuffer)
+			{
+				result = result | mpGraphicsObjectManager->DestroyBuffer(pCurrBuffer);
+			}
+		}
+
+		mpSharedVertexBuffer = nullptr;
+		mpPositionOnlyVertexBuffer = nullptr;
+		mpSharedIndexBuffer = nullptr;
+
+		/// \note swap with empty arrays to release the memory, clear() keeps the capacity
+		TPositionsArray().swap(mPositions);
+		TVertexColorArray().swap(mVertexColors);
+		TNormalsArray().swap(mNormals);
+		TTangentsArray().swap(mTangents);
+		TTexcoordsArray().swap(mTexcoords0);
+		TIndicesArray().swap(mIndices);
+
+		mSubMeshesIdentifiers.clear();
+		mSubMeshesInfo.clear();
+
+		return result;
+	}
+
+	USIZE CBaseMesh::GetMemorySize() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		USIZE size = mPositions.size() * sizeof(TVector4) + mVertexColors.size() * sizeof(TColor32F) + mNormals.size() * sizeof(TVector4) + 
+					 mTangents.size() * sizeof(TVector4) + mTexcoords0.size() * sizeof(TVector2) + mIndices.size() * sizeof(U32);
+
+		const IBuffer* buffers[] { mpSharedVertexBuffer, mpPositionOnlyVertexBuffer, mpSharedIndexBuffer };
+
+		for (const IBuffer* pCurrBuffer : buffers)
+		{
+			size += pCurrBuffer ? pCurrBuffer->GetSize() : 0;
+		}
+
+		return size;
+	}
+
 	void CBaseMesh::AddPosition(const TVector4& pos)
 	{
 		std::lock_guard<std::mutex> lock(mMutex);
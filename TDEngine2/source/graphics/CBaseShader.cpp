@@ -223,4 +223,26 @@ namespace TDEngine2
 	{
 		return mpResourceManager->GetResourceLoader<IShader>();
 	}
+
+
+	static const std::string InstancedShaderVariantSuffix = "#instanced";
+
+
+	TDE2_API std::string GetInstancedShaderVariantName(const std::string& shaderName)
+	{
+		return shaderName + InstancedShaderVariantSuffix;
+	}
+
+
+	TDE2_API std::tuple<std::string, bool> ParseShaderVariantName(const std::string& name)
+	{
+		const USIZE suffixLength = InstancedShaderVariantSuffix.length();
+
+		if (name.length() > suffixLength && !name.compare(name.length() - suffixLength, suffixLength, InstancedShaderVariantSuffix))
+		{
+			return { name.substr(0, name.length() - suffixLength), true };
+		}
+
+		return { name, false };
+	}
 }
\ No newline at end of file
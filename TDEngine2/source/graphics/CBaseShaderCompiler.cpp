@@ -325,6 +325,8 @@ namespace TDEngine2
 
 	const C8* CBaseShaderCompiler::mTargetVersionDefineName = "TARGET";		
 
+	const C8* CBaseShaderCompiler::mInstancingSupportDefineName = "TDE2_INSTANCING_SUPPORTED";
+
 	CBaseShaderCompiler::CBaseShaderCompiler() :
 		CBaseObject()
 	{
@@ -385,6 +387,8 @@ namespace TDEngine2
 		///\todo implement convertation of a version string into E_SHADER_TARGET_VERSION enum's value
 		extractedMetadata.mFeatureLevel = _getTargetVersionFromStr(extractedMetadata.mDefines[mTargetVersionDefineName].mValue);
 
+		extractedMetadata.mIsInstancingSupported = extractedMetadata.mDefines.find(mInstancingSupportDefineName) != extractedMetadata.mDefines.cend();
+
 		return extractedMetadata;
 	}
 
@@ -532,7 +536,8 @@ namespace TDEngine2
 				{ "TDEngine2PerFrame", { IUBR_PER_FRAME, sizeof(TPerFrameShaderData), E_UNIFORM_BUFFER_DESC_FLAGS::UBDF_INTERNAL } },
 				{ "TDEngine2PerObject", { IUBR_PER_OBJECT, sizeof(TPerObjectShaderData), E_UNIFORM_BUFFER_DESC_FLAGS::UBDF_INTERNAL} },
 				{ "TDEngine2RareUpdate",{ IUBR_RARE_UDATED, sizeof(TRareUpdateShaderData), E_UNIFORM_BUFFER_DESC_FLAGS::UBDF_INTERNAL} },
-				{ "TDEngine2Constants", { IUBR_CONSTANTS, sizeof(TConstantShaderData), E_UNIFORM_BUFFER_DESC_FLAGS::UBDF_INTERNAL} }
+				{ "TDEngine2Constants", { IUBR_CONSTANTS, sizeof(TConstantShaderData), E_UNIFORM_BUFFER_DESC_FLAGS::UBDF_INTERNAL} },
+				{ "TDEngine2Lights", { IUBR_LIGHTS, sizeof(TLightClustersShaderData), E_UNIFORM_BUFFER_DESC_FLAGS::UBDF_INTERNAL} }
 			};
 	}
 
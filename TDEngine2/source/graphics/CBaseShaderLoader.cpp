@@ -2,6 +2,7 @@
 #include "../../include/graphics/CBaseShader.h"
 #include "../../include/core/IFileSystem.h"
 #include "../../include/core/IFile.h"
+#include "../../include/core/IJobManager.h"
 #include "../../include/platform/CTextFileReader.h"
 #include "../../include/graphics/IShaderCompiler.h"
 #include "../../include/core/IGraphicsContext.h"
@@ -9,6 +10,7 @@
 #include "../../include/utils/CFileLogger.h"
 #include <unordered_map>
 #include <string>
+#include <tuple>
 
 
 namespace TDEngine2
@@ -60,40 +62,62 @@ namespace TDEngine2
 
 		E_RESULT_CODE result = RC_OK;
 
-		/// load source code
-		TResult<TFileEntryId> shaderFileId = mpFileSystem->Open<ITextFileReader>(pResource->GetName());
+		/// \note The instanced variant is compiled from the same source as the shader itself
+		std::string shaderName;
+		bool isInstancedVariant = false;
 
-		if (shaderFileId.HasError())
-		{
-			LOG_WARNING(std::string("[Shader Loader] Could not load the specified shader (").append(pResource->GetName()).append("), load default one instead..."));
+		std::tie(shaderName, isInstancedVariant) = ParseShaderVariantName(pResource->GetName());
 
-			E_DEFAULT_SHADER_TYPE shaderType = CBaseGraphicsObjectManager::GetDefaultShaderTypeByName(pResource->GetName());
+		const std::string variantDefines = isInstancedVariant ? "#define TDE2_INSTANCING_ENABLED\n" : "";
 
-			/// \note can't load file with the shader, so load default one
-			return pShader->Compile(mpShaderCompiler, mpGraphicsContext->GetGraphicsObjectManager()->GetDefaultShaderCode(shaderType));
-		}
+		std::string shaderSourceCode;
 
-		ITextFileReader* pShaderFileReader = dynamic_cast<ITextFileReader*>(mpFileSystem->Get<ITextFileReader>(shaderFileId.Get()));
-		
-		std::string shaderSourceCode = pShaderFileReader->ReadToEnd();
+		/// load source code
+		TResult<TFileEntryId> shaderFileId = mpFileSystem->Open<ITextFileReader>(shaderName);
 
-		if ((result = pShaderFileReader->Close()) != RC_OK)
+		if (!shaderFileId.HasError())
 		{
-			return result;
+			ITextFileReader* pShaderFileReader = dynamic_cast<ITextFileReader*>(mpFileSystem->Get<ITextFileReader>(shaderFileId.Get()));
+
+			shaderSourceCode = pShaderFileReader->ReadToEnd();
+
+			if ((result = pShaderFileReader->Close()) != RC_OK)
+			{
+				return result;
+			}
 		}
 
-		/// parse it and compile needed variant
-		if ((result = pShader->Compile(mpShaderCompiler, shaderSourceCode)) != RC_OK)
+		auto compileShaderRoutine = [this, pResource, pShader, shaderName, variantDefines, shaderSourceCode]
 		{
-			LOG_WARNING(std::string("[Shader Loader] Could not load the specified shader (").append(pResource->GetName()).append("), load default one instead..."));
+			/// parse it and compile needed variant
+			E_RESULT_CODE result = shaderSourceCode.empty() ? RC_FILE_NOT_FOUND : pShader->Compile(mpShaderCompiler, variantDefines + shaderSourceCode);
 
-			E_DEFAULT_SHADER_TYPE shaderType = CBaseGraphicsObjectManager::GetDefaultShaderTypeByName(pResource->GetName());
+			if (RC_OK != result)
+			{
+				LOG_WARNING(std::string("[Shader Loader] Could not load the specified shader (").append(pResource->GetName()).append("), load default one instead..."));
 
-			/// \note can't load file with the shader, so load default one
-			return pShader->Compile(mpShaderCompiler, mpGraphicsContext->GetGraphicsObjectManager()->GetDefaultShaderCode(shaderType));
+				E_DEFAULT_SHADER_TYPE shaderType = CBaseGraphicsObjectManager::GetDefaultShaderTypeByName(shaderName);
+
+				/// \note can't load file with the shader, so load default one
+				result = pShader->Compile(mpShaderCompiler, variantDefines + mpGraphicsContext->GetGraphicsObjectManager()->GetDefaultShaderCode(shaderType));
+			}
+
+			pResource->SetState((RC_OK == result) ? E_RESOURCE_STATE_TYPE::RST_LOADED : E_RESOURCE_STATE_TYPE::RST_UNLOADED);
+		};
+
+		IJobManager* pJobManager = mpFileSystem->GetJobManager();
+		if (!pJobManager)
+		{
+			compileShaderRoutine();
+			return (E_RESOURCE_STATE_TYPE::RST_LOADED == pResource->GetState()) ? RC_OK : RC_FAIL;
 		}
 
-		return result;
+		/// \note The source is read by the calling thread, but GPU programs are created on the main thread, so the shader stays
+		/// in RST_LOADING state until that. The routine is executed at once if the loader is called from the main thread
+		pResource->SetState(E_RESOURCE_STATE_TYPE::RST_LOADING);
+		pJobManager->ExecuteInMainThread(compileShaderRoutine);
+
+		return (E_RESOURCE_STATE_TYPE::RST_UNLOADED == pResource->GetState()) ? RC_FAIL : RC_OK;
 	}
 
 	TypeId CBaseShaderLoader::GetResourceTypeId() const
@@ -4,6 +4,7 @@
 #include "../../include/core/IFileSystem.h"
 #include "../../include/core/IJobManager.h"
 #include "../../include/graphics/IGraphicsObjectManager.h"
+#include "../../include/utils/Utils.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include <string>
@@ -132,6 +133,33 @@ namespace TDEngine2
 		return { 0.0f, 0.0f, 1.0f, 1.0f };
 	}
 
+	E_RESULT_CODE CBaseTexture2D::Evict()
+	{
+		E_RESULT_CODE result = _releaseInternalTextureHandler();
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		mWidth  = 0;
+		mHeight = 0;
+
+		return RC_OK;
+	}
+
+	USIZE CBaseTexture2D::GetMemorySize() const
+	{
+		if (E_RESOURCE_STATE_TYPE::RST_LOADED != mState)
+		{
+			return 0;
+		}
+
+		const USIZE size = static_cast<USIZE>(mWidth) * static_cast<USIZE>(mHeight) * static_cast<USIZE>(CFormatUtils::GetFormatSize(mFormat));
+
+		/// \note A full mip chain takes a third of the base level's size
+		return (mNumOfMipLevels > 1) ? (size + size / 3) : size;
+	}
+
 	TTextureSamplerId CBaseTexture2D::GetTextureSampleHandle(IGraphicsContext* pGraphicsContext, const TTextureSamplerDesc& params)
 	{
 		IGraphicsObjectManager* pGraphicsObjectManager = pGraphicsContext->GetGraphicsObjectManager();
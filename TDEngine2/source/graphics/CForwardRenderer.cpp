@@ -10,11 +10,13 @@
 #include "../../include/core/CProjectSettings.h"
 #include "../../include/graphics/CGlobalShaderProperties.h"
 #include "../../include/graphics/InternalShaderData.h"
+#include "../../include/graphics/ShadowCascades.h"
 #include "../../include/graphics/CDebugUtility.h"
 #include "../../include/graphics/IGraphicsObjectManager.h"
 #include "../../include/editor/CPerfProfiler.h"
 #include "../../include/graphics/IFramePostProcessor.h"
 #include "../../include/graphics/CBaseRenderTarget.h"
+#include <array>
 #if TDE2_EDITORS_ENABLED
 	#include "../../include/editor/ISelectionManager.h"
 #endif
@@ -23,19 +25,20 @@
 namespace TDEngine2
 {
 	CForwardRenderer::CForwardRenderer():
-		CBaseObject(), mpMainCamera(nullptr), mpResourceManager(nullptr), mpGlobalShaderProperties(nullptr), mpFramePostProcessor(nullptr)
+		CBaseObject(), mpMainCamera(nullptr), mpResourceManager(nullptr), mpGlobalShaderProperties(nullptr), mpFramePostProcessor(nullptr), mLightClustersData(),
+		mShadowCascadesUpdateMask((1 << MaxShadowCascadesCount) - 1), mShadowMapSizes(0)
 	{
 	}
 
 
-	static TResult<TResourceId> GetOrCreateShadowMap(TPtr<IResourceManager> pResourceManager)
+	static TResult<TResourceId> GetOrCreateShadowMap(TPtr<IResourceManager> pResourceManager, U32 cascadeIndex)
 	{
 		const U32 shadowMapSizes = CProjectSettings::Get()->mGraphicsSettings.mRendererSettings.mShadowMapSizes;
 		TDE2_ASSERT(shadowMapSizes > 0 && shadowMapSizes < 65536);
 
 		const TTexture2DParameters shadowMapParams{ shadowMapSizes, shadowMapSizes, FT_D32, 1, 1, 0 };
 
-		const TResourceId shadowMapHandle = pResourceManager->Create<IDepthBufferTarget>("ShadowMap", shadowMapParams);
+		const TResourceId shadowMapHandle = pResourceManager->Create<IDepthBufferTarget>(GetShadowMapCascadeResourceName(cascadeIndex), shadowMapParams);
 		if (shadowMapHandle == TResourceId::Invalid)
 		{
 			TDE2_ASSERT(false);
@@ -91,15 +94,27 @@ namespace TDEngine2
 				return result;
 			}
 
-			/// \note this CRenderQueue's instance now owns this allocator
-			mpRenderQueues[i] = TPtr<CRenderQueue>(CreateRenderQueue(pCurrAllocator, result));
+			std::vector<IAllocator*> workersAllocators;
+
+			for (U32 k = 0; k < params.mWorkerThreadsCount; ++k)
+			{
+				workersAllocators.push_back(allocatorFactory(PerRenderQueueWorkerMemoryBlockSize, result));
+
+				if (result != RC_OK)
+				{
+					return result;
+				}
+			}
+
+			/// \note this CRenderQueue's instance now owns these allocators
+			mpRenderQueues[i] = TPtr<CRenderQueue>(CreateRenderQueue(pCurrAllocator, workersAllocators, result));
 
 			if (result != RC_OK)
 			{
 				return result;
 			}
 			
-			LOG_MESSAGE(std::string("[Forward Renderer] A new render queue buffer was created ( mem-size : ").append(std::to_string(PerRenderQueueMemoryBlockSize / 1024)).
+			LOG_MESSAGE(std::string("[Forward Renderer] A new render queue buffer was created ( mem-size : ").append(std::to_string((PerRenderQueueMemoryBlockSize + params.mWorkerThreadsCount * PerRenderQueueWorkerMemoryBlockSize) / 1024)).
 																											  append(" KiB; group-type : ").
 																											  append(std::to_string(i)).
 																											  append(")"));
@@ -127,7 +142,13 @@ namespace TDEngine2
 
 		if (CProjectSettings::Get()->mGraphicsSettings.mRendererSettings.mIsShadowMappingEnabled)
 		{
-			GetOrCreateShadowMap(mpResourceManager).Get(); /// \note Create a shadow map's texture before any Update will be executed
+			const U32 cascadesCount = std::min<U32>(CProjectSettings::Get()->mGraphicsSettings.mRendererSettings.mShadowCascadesCount, MaxShadowCascadesCount);
+
+			/// \note Create shadow maps' textures before any Update will be executed
+			for (U32 i = 0; i < cascadesCount; ++i)
+			{
+				GetOrCreateShadowMap(mpResourceManager, i).Get();
+			}
 		}
 
 		mIsInitialized = true;
@@ -137,7 +158,7 @@ namespace TDEngine2
 
 
 	static inline void SubmitCommandsToDraw(TPtr<IGraphicsContext> pGraphicsContext, TPtr<IResourceManager> pResourceManager, TPtr<IGlobalShaderProperties> pGlobalShaderProperties,
-									TPtr<CRenderQueue> pRenderQueue, U32 upperRenderIndexLimit)
+									TPtr<CRenderQueue> pRenderQueue, TRenderStateCache& stateCache, U32 upperRenderIndexLimit)
 	{
 		CRenderQueue::CRenderQueueIterator iter = pRenderQueue->GetIterator();
 
@@ -157,16 +178,19 @@ namespace TDEngine2
 				break;
 			}
 
-			pCurrDrawCommand->Submit(pGraphicsContext.Get(), pResourceManager.Get(), pGlobalShaderProperties.Get());
+			pCurrDrawCommand->Submit(pGraphicsContext.Get(), pResourceManager.Get(), pGlobalShaderProperties.Get(), &stateCache);
 		}
 	}
 
 
 	static inline void ExecuteDrawCommands(TPtr<IGraphicsContext> pGraphicsContext, TPtr<IResourceManager> pResourceManager, TPtr<IGlobalShaderProperties> pGlobalShaderProperties,
-									TPtr<CRenderQueue> pCommandsBuffer, bool shouldClearBuffers, U32 upperRenderIndexLimit = (std::numeric_limits<U32>::max)())
+									TPtr<CRenderQueue> pCommandsBuffer, TRenderStateCache& stateCache, bool shouldClearBuffers, U32 upperRenderIndexLimit = (std::numeric_limits<U32>::max)())
 	{
+		/// \note The pipeline could be changed between passes (render targets, post-processing, debug utilities), so start from a clean state
+		stateCache.Invalidate();
+
 		pCommandsBuffer->Sort();
-		SubmitCommandsToDraw(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pCommandsBuffer, upperRenderIndexLimit);
+		SubmitCommandsToDraw(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pCommandsBuffer, stateCache, upperRenderIndexLimit);
 
 		if (shouldClearBuffers)
 		{
@@ -176,7 +200,7 @@ namespace TDEngine2
 
 
 	static E_RESULT_CODE ProcessShadowPass(TPtr<IGraphicsContext> pGraphicsContext, TPtr<IResourceManager> pResourceManager, TPtr<IGlobalShaderProperties> pGlobalShaderProperties,
-										TPtr<CRenderQueue> pShadowCastersRenderGroup)
+										TPtr<CRenderQueue> pShadowCastersRenderGroup, TRenderStateCache& stateCache, const TPerFrameShaderData& perFrameShaderData, U32 cascadesUpdateMask)
 	{
 		if (!pShadowCastersRenderGroup)
 		{
@@ -186,29 +210,78 @@ namespace TDEngine2
 
 		TDE2_PROFILER_SCOPE("Renderer::RenderShadows");
 
-		const TResourceId shadowMapHandle = GetOrCreateShadowMap(pResourceManager).Get();
+		static const std::array<std::string, MaxShadowCascadesCount> cascadesDrawCallsCountersNames
+		{
+			"Renderer::ShadowCascade0DrawCalls", "Renderer::ShadowCascade1DrawCalls", "Renderer::ShadowCascade2DrawCalls", "Renderer::ShadowCascade3DrawCalls"
+		};
+
+		std::array<U32, MaxShadowCascadesCount> cascadesDrawCallsCount {};
 
-		if (!pShadowCastersRenderGroup->IsEmpty())
+		const U32 cascadesCount = std::min<U32>(perFrameShaderData.mLightingData.mShadowCascadesCount, MaxShadowCascadesCount);
+
+		if (cascadesUpdateMask)
 		{
 			const F32 shadowMapSizes = static_cast<F32>(CProjectSettings::Get()->mGraphicsSettings.mRendererSettings.mShadowMapSizes);
 
+			/// \note The pipeline could be changed between passes (render targets, post-processing, debug utilities), so start from a clean state
+			stateCache.Invalidate();
+
+			pShadowCastersRenderGroup->Sort();
+
+			CRenderQueue::CRenderQueueIterator iter = pShadowCastersRenderGroup->GetIterator();
+
+			/// \note Each cascade's pass uses its own matrix of the sun light
+			TPerFrameShaderData cascadePerFrameShaderData = perFrameShaderData;
+
 			pGraphicsContext->SetViewport(0.0f, 0.0f, shadowMapSizes, shadowMapSizes, 0.0f, 1.0f);
+
+			for (U32 cascadeIndex = 0; cascadeIndex < cascadesCount; ++cascadeIndex)
 			{
-				pGraphicsContext->BindDepthBufferTarget(pResourceManager->GetResource<IDepthBufferTarget>(shadowMapHandle).Get(), true);
+				const bool isCascadeUpdated = (cascadesUpdateMask >> cascadeIndex) & 0x1;
 
-				pGraphicsContext->ClearDepthBuffer(1.0f);
+				if (isCascadeUpdated)
+				{
+					cascadePerFrameShaderData.mLightingData.mSunLightMatrix = perFrameShaderData.mLightingData.mShadowCascadesMatrices[cascadeIndex];
+					pGlobalShaderProperties->SetInternalUniformsBuffer(IUBR_PER_FRAME, reinterpret_cast<const U8*>(&cascadePerFrameShaderData), sizeof(cascadePerFrameShaderData));
+
+					const TResourceId shadowMapHandle = GetOrCreateShadowMap(pResourceManager, cascadeIndex).Get();
 
-				ExecuteDrawCommands(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pShadowCastersRenderGroup, true);
+					pGraphicsContext->BindDepthBufferTarget(pResourceManager->GetResource<IDepthBufferTarget>(shadowMapHandle).Get(), true);
+					pGraphicsContext->ClearDepthBuffer(1.0f);
+				}
+
+				/// \note Commands are sorted by cascades, the first cascade goes first
+				while (iter.HasNext() && (GetShadowCascadeIndexFromSortKey(iter.GetSortKey()) <= cascadeIndex))
+				{
+					TRenderCommand* pCurrDrawCommand = *(iter++);
 
-				pGraphicsContext->BindDepthBufferTarget(nullptr);
+					if (!pCurrDrawCommand || !isCascadeUpdated)
+					{
+						continue;
+					}
+
+					pCurrDrawCommand->Submit(pGraphicsContext.Get(), pResourceManager.Get(), pGlobalShaderProperties.Get(), &stateCache);
+					++cascadesDrawCallsCount[cascadeIndex];
+				}
 			}
 
+			pGraphicsContext->BindDepthBufferTarget(nullptr);
+
+			pGlobalShaderProperties->SetInternalUniformsBuffer(IUBR_PER_FRAME, reinterpret_cast<const U8*>(&perFrameShaderData), sizeof(perFrameShaderData));
+
 			if (auto pWindowSystem = pGraphicsContext->GetWindowSystem())
 			{
 				pGraphicsContext->SetViewport(0.0f, 0.0f, static_cast<F32>(pWindowSystem->GetWidth()), static_cast<F32>(pWindowSystem->GetHeight()), 0.0f, 1.0f);
 			}
 		}
 
+		pShadowCastersRenderGroup->Clear();
+
+		for (U32 i = 0; i < MaxShadowCascadesCount; ++i)
+		{
+			TDE2_PROFILER_COUNTER(cascadesDrawCallsCountersNames[i], static_cast<F32>(cascadesDrawCallsCount[i]));
+		}
+
 		return RC_OK;
 	}
 
@@ -216,7 +289,7 @@ namespace TDEngine2
 #if TDE2_EDITORS_ENABLED
 
 	static E_RESULT_CODE ProcessEditorSelectionBuffer(TPtr<IGraphicsContext> pGraphicsContext, TPtr<IResourceManager> pResourceManager, TPtr<IGlobalShaderProperties> pGlobalShaderProperties,
-													ISelectionManager* pSelectionManager, TPtr<CRenderQueue> pRenderGroup)
+													ISelectionManager* pSelectionManager, TPtr<CRenderQueue> pRenderGroup, TRenderStateCache& stateCache)
 	{
 		if (!pRenderGroup)
 		{
@@ -230,7 +303,7 @@ namespace TDEngine2
 		{
 			if (pSelectionManager->BuildSelectionMap([&, pRenderGroup]
 			{
-				ExecuteDrawCommands(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pRenderGroup, true);
+				ExecuteDrawCommands(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pRenderGroup, stateCache, true);
 				return RC_OK;
 			}) != RC_OK)
 			{
@@ -245,7 +318,7 @@ namespace TDEngine2
 
 
 	static inline E_RESULT_CODE RenderMainPasses(TPtr<IGraphicsContext> pGraphicsContext, TPtr<IResourceManager> pResourceManager, TPtr<IGlobalShaderProperties> pGlobalShaderProperties,
-										TPtr<IFramePostProcessor> pFramePostProcessor, TPtr<CRenderQueue> pRenderQueues[])
+										TPtr<IFramePostProcessor> pFramePostProcessor, TPtr<CRenderQueue> pRenderQueues[], TRenderStateCache& stateCache)
 	{
 		pGraphicsContext->ClearDepthBuffer(1.0f);
 
@@ -269,7 +342,7 @@ namespace TDEngine2
 
 				const bool isOverlayCommandBuffer = (static_cast<E_RENDER_QUEUE_GROUP>(currGroup) == E_RENDER_QUEUE_GROUP::RQG_OVERLAY);
 
-				ExecuteDrawCommands(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pCurrCommandBuffer, true,
+				ExecuteDrawCommands(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pCurrCommandBuffer, stateCache, true,
 					isOverlayCommandBuffer ? static_cast<U32>(E_GEOMETRY_SUBGROUP_TAGS::IMAGE_EFFECTS) : (std::numeric_limits<U32>::max)());
 			}
 		});
@@ -279,7 +352,7 @@ namespace TDEngine2
 
 
 	static E_RESULT_CODE RenderOverlayAndPostEffects(TPtr<IGraphicsContext> pGraphicsContext, TPtr<IResourceManager> pResourceManager, TPtr<IGlobalShaderProperties> pGlobalShaderProperties,
-													TPtr<CRenderQueue> pRenderGroup)
+													TPtr<CRenderQueue> pRenderGroup, TRenderStateCache& stateCache)
 	{
 		if (!pRenderGroup)
 		{
@@ -296,7 +369,7 @@ namespace TDEngine2
 
 		pGraphicsContext->ClearDepthBuffer(1.0f);
 
-		ExecuteDrawCommands(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pRenderGroup, true);
+		ExecuteDrawCommands(pGraphicsContext, pResourceManager, pGlobalShaderProperties, pRenderGroup, stateCache, true);
 
 		return RC_OK;
 	}
@@ -312,18 +385,39 @@ namespace TDEngine2
 		}
 
 		_prepareFrame(currTime, deltaTime);
+		_uploadObjectsData();
+
+		mRenderStateCache.ResetStats();
 
 #if TDE2_EDITORS_ENABLED
-		ProcessEditorSelectionBuffer(mpGraphicsContext, mpResourceManager, mpGlobalShaderProperties, mpSelectionManager, mpRenderQueues[static_cast<U8>(E_RENDER_QUEUE_GROUP::RQG_EDITOR_ONLY)]);
+		ProcessEditorSelectionBuffer(mpGraphicsContext, mpResourceManager, mpGlobalShaderProperties, mpSelectionManager, mpRenderQueues[static_cast<U8>(E_RENDER_QUEUE_GROUP::RQG_EDITOR_ONLY)], mRenderStateCache);
 #endif
 
 		if (CProjectSettings::Get()->mGraphicsSettings.mRendererSettings.mIsShadowMappingEnabled)
 		{
-			ProcessShadowPass(mpGraphicsContext, mpResourceManager, mpGlobalShaderProperties, mpRenderQueues[static_cast<U8>(E_RENDER_QUEUE_GROUP::RQG_SHADOW_PASS)]);
+			const U32 shadowMapSizes = CProjectSettings::Get()->mGraphicsSettings.mRendererSettings.mShadowMapSizes;
+
+			/// \note Cached cascades are invalidated when their textures are resized
+			if (mShadowMapSizes != shadowMapSizes)
+			{
+				mShadowCascadesUpdateMask = (1 << MaxShadowCascadesCount) - 1;
+				mShadowMapSizes = shadowMapSizes;
+			}
+
+			ProcessShadowPass(mpGraphicsContext, mpResourceManager, mpGlobalShaderProperties, mpRenderQueues[static_cast<U8>(E_RENDER_QUEUE_GROUP::RQG_SHADOW_PASS)], mRenderStateCache, 
+							mPerFrameShaderData, mShadowCascadesUpdateMask);
+
+			mShadowCascadesUpdateMask = 0;
 		}
 		
-		RenderMainPasses(mpGraphicsContext, mpResourceManager, mpGlobalShaderProperties, mpFramePostProcessor, mpRenderQueues);
-		RenderOverlayAndPostEffects(mpGraphicsContext, mpResourceManager, mpGlobalShaderProperties, mpRenderQueues[static_cast<U8>(E_RENDER_QUEUE_GROUP::RQG_OVERLAY)]);
+		RenderMainPasses(mpGraphicsContext, mpResourceManager, mpGlobalShaderProperties, mpFramePostProcessor, mpRenderQueues, mRenderStateCache);
+		RenderOverlayAndPostEffects(mpGraphicsContext, mpResourceManager, mpGlobalShaderProperties, mpRenderQueues[static_cast<U8>(E_RENDER_QUEUE_GROUP::RQG_OVERLAY)], mRenderStateCache);
+
+		/// \note Release cached resources until the next frame
+		mRenderStateCache.Invalidate();
+
+		TDE2_PROFILER_COUNTER("Renderer::StateBinds", static_cast<F32>(mRenderStateCache.mBindsCount));
+		TDE2_PROFILER_COUNTER("Renderer::SkippedStateBinds", static_cast<F32>(mRenderStateCache.mSkippedBindsCount));
 
 		mpGraphicsContext->Present();
 
@@ -374,6 +468,25 @@ namespace TDEngine2
 		mLightingData = lightingData;
 		return RC_OK;
 	}
+
+	E_RESULT_CODE CForwardRenderer::SetLightClustersData(const TLightClustersShaderData& lightClustersData)
+	{
+		if (lightClustersData.mPointLightsCount > MaxPointLightsCount)
+		{
+			LOG_ERROR("[ForwardRenderer] A number of point lights exceeds MaxPointLightsCount");
+			TDE2_ASSERT(false);
+
+			return RC_INVALID_ARGS;
+		}
+
+		mLightClustersData = lightClustersData;
+		return RC_OK;
+	}
+
+	void CForwardRenderer::SetShadowCascadesUpdateMask(U32 cascadesMask)
+	{
+		mShadowCascadesUpdateMask |= cascadesMask;
+	}
 	
 	E_ENGINE_SUBSYSTEM_TYPE CForwardRenderer::GetType() const
 	{
@@ -400,7 +513,7 @@ namespace TDEngine2
 		TDE2_PROFILER_SCOPE("Renderer::PreRender");
 
 		///set up global shader properties for TPerFrameShaderData buffer
-		TPerFrameShaderData perFrameShaderData;
+		TPerFrameShaderData& perFrameShaderData = mPerFrameShaderData;
 
 		perFrameShaderData.mLightingData = mLightingData;
 		
@@ -414,6 +527,7 @@ namespace TDEngine2
 		perFrameShaderData.mTime = TVector4(currTime, deltaTime, 0.0f, 0.0f);
 
 		mpGlobalShaderProperties->SetInternalUniformsBuffer(IUBR_PER_FRAME, reinterpret_cast<const U8*>(&perFrameShaderData), sizeof(perFrameShaderData));
+		mpGlobalShaderProperties->SetInternalUniformsBuffer(IUBR_LIGHTS, reinterpret_cast<const U8*>(&mLightClustersData), sizeof(mLightClustersData));
 
 		mpGraphicsContext->ClearBackBuffer(TColor32F(0.0f, 0.0f, 0.5f, 1.0f));
 		mpGraphicsContext->ClearDepthBuffer(1.0f);
@@ -421,6 +535,40 @@ namespace TDEngine2
 		mpDebugUtility->PreRender();
 	}
 
+	void CForwardRenderer::_uploadObjectsData()
+	{
+		TDE2_PROFILER_SCOPE("Renderer::UploadObjectsData");
+
+		mObjectsData.clear();
+
+		for (TPtr<CRenderQueue> pCurrRenderQueue : mpRenderQueues)
+		{
+			if (!pCurrRenderQueue)
+			{
+				continue;
+			}
+
+			CRenderQueue::CRenderQueueIterator iter = pCurrRenderQueue->GetIterator();
+
+			while (iter.HasNext())
+			{
+				TRenderCommand* pCurrCommand = *(iter++);
+				if (!pCurrCommand)
+				{
+					continue;
+				}
+
+				pCurrCommand->mObjectDataIndex = static_cast<U32>(mObjectsData.size());
+				mObjectsData.push_back(pCurrCommand->mObjectData);
+			}
+		}
+
+		/// \note If the data can't be uploaded commands write it per draw call
+		mpGlobalShaderProperties->SetObjectsData(mObjectsData);
+
+		TDE2_PROFILER_COUNTER("Renderer::ObjectsDataCount", static_cast<F32>(mObjectsData.size()));
+	}
+
 
 	TDE2_API IRenderer* CreateForwardRenderer(const TRendererInitParams& params, E_RESULT_CODE& result)
 	{
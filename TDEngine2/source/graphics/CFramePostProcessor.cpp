@@ -255,7 +255,7 @@ namespace TDEngine2
 
 		if (drawImmediately)
 		{
-			pDrawCommand->Submit(mpGraphicsContext, mpResourceManager.Get(), mpGlobalShaderProperties);
+			pDrawCommand->Submit(mpGraphicsContext, mpResourceManager.Get(), mpGlobalShaderProperties, nullptr);
 		}
 	}
 	 
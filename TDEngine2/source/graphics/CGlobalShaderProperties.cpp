@@ -2,6 +2,8 @@
 #include "../../include/graphics/IGraphicsObjectManager.h"
 #include "../../include/graphics/IConstantBuffer.h"
 #include "../../include/graphics/InternalShaderData.h"
+#include <algorithm>
+#include <cstring>
 
 
 namespace TDEngine2
@@ -30,6 +32,8 @@ namespace TDEngine2
 			return result;
 		}
 
+		mpGraphicsObjectManager = pGraphicsObjectManager;
+
 		mIsInitialized = true;
 		
 		return RC_OK;
@@ -74,6 +78,96 @@ namespace TDEngine2
 		return RC_OK;
 	}
 
+	E_RESULT_CODE CGlobalShaderProperties::SetObjectsData(const std::vector<TPerObjectShaderData>& objectsData)
+	{
+		if (!mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		mUploadedObjectsCount = 0;
+
+		if (!mIsObjectsDataRangeBindingSupported)
+		{
+			return RC_NOT_IMPLEMENTED_YET;
+		}
+
+		constexpr U32 objectsPerPage = PerObjectShaderDataPageSize / PerObjectShaderDataStride;
+
+		const U32 objectsCount = static_cast<U32>(objectsData.size());
+
+		mObjectsDataStagingBuffer.resize(PerObjectShaderDataPageSize);
+
+		E_RESULT_CODE result = RC_OK;
+
+		for (U32 pageIndex = 0, firstObjectIndex = 0; firstObjectIndex < objectsCount; ++pageIndex, firstObjectIndex += objectsPerPage)
+		{
+			if (pageIndex >= static_cast<U32>(mpObjectsDataPages.size()))
+			{
+				auto createBufferResult = mpGraphicsObjectManager->CreateConstantBuffer(BUT_DYNAMIC, PerObjectShaderDataPageSize, nullptr);
+				if (createBufferResult.HasError())
+				{
+					return createBufferResult.GetError();
+				}
+
+				mpObjectsDataPages.push_back(createBufferResult.Get());
+			}
+
+			const U32 pageObjectsCount = std::min<U32>(objectsPerPage, objectsCount - firstObjectIndex);
+
+			for (U32 i = 0; i < pageObjectsCount; ++i)
+			{
+				memcpy(&mObjectsDataStagingBuffer[i * PerObjectShaderDataStride], &objectsData[firstObjectIndex + i], sizeof(TPerObjectShaderData));
+			}
+
+			IConstantBuffer* pCurrPage = mpObjectsDataPages[pageIndex];
+
+			if ((result = pCurrPage->Map(BMT_WRITE_DISCARD)) != RC_OK)
+			{
+				return result;
+			}
+
+			result = pCurrPage->Write(mObjectsDataStagingBuffer.data(), pageObjectsCount * PerObjectShaderDataStride);
+
+			pCurrPage->Unmap();
+
+			if (result != RC_OK)
+			{
+				return result;
+			}
+
+			mUploadedObjectsCount = firstObjectIndex + pageObjectsCount;
+		}
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CGlobalShaderProperties::BindObjectData(U32 objectIndex)
+	{
+		if (!mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (objectIndex >= mUploadedObjectsCount)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		constexpr U32 objectsPerPage = PerObjectShaderDataPageSize / PerObjectShaderDataStride;
+
+		const E_RESULT_CODE result = mpObjectsDataPages[objectIndex / objectsPerPage]->BindRange(IUBR_PER_OBJECT, (objectIndex % objectsPerPage) * PerObjectShaderDataStride, 
+																								  PerObjectShaderDataStride);
+		if (RC_NOT_IMPLEMENTED_YET == result)
+		{
+			/// \note Stop uploading objects' data, all draw calls fall back to writes into IUBR_PER_OBJECT buffer
+			mIsObjectsDataRangeBindingSupported = false;
+			mUploadedObjectsCount = 0;
+		}
+
+		return result;
+	}
+
 	E_RESULT_CODE CGlobalShaderProperties::_initializeUniformsBuffers(IGraphicsObjectManager* pGraphicsObjectManager, U8 numOfBuffers)
 	{
 		E_INTERNAL_UNIFORM_BUFFER_REGISTERS currSlot;
@@ -144,6 +238,8 @@ namespace TDEngine2
 				return sizeof(TRareUpdateShaderData);
 			case IUBR_CONSTANTS:
 				return sizeof(TConstantShaderData);
+			case IUBR_LIGHTS:
+				return sizeof(TLightClustersShaderData);
 		}
 
 		return 0;
@@ -39,6 +39,8 @@ namespace TDEngine2
 		mMaterialName = pReader->GetString("material");
 		TDE2_ASSERT(!mMaterialName.empty());
 
+		mMaterialId = TResourceId::Invalid;
+
 		return RC_OK;
 	}
 
@@ -67,6 +69,7 @@ namespace TDEngine2
 	void CQuadSprite::SetMaterialName(const std::string& materialName)
 	{
 		mMaterialName = materialName;
+		mMaterialId = TResourceId::Invalid;
 	}
 
 	void CQuadSprite::SetColor(const TColor32F& color)
@@ -74,11 +77,21 @@ namespace TDEngine2
 		mColor = color;
 	}
 
+	void CQuadSprite::SetMaterialId(TResourceId materialId)
+	{
+		mMaterialId = materialId;
+	}
+
 	const std::string& CQuadSprite::GetMaterialName() const
 	{
 		return mMaterialName;
 	}
 
+	TResourceId CQuadSprite::GetMaterialId() const
+	{
+		return mMaterialId;
+	}
+
 	const TColor32F& CQuadSprite::GetColor() const
 	{
 		return mColor;
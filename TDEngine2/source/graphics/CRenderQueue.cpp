@@ -9,7 +9,10 @@
 #include "../../include/graphics/IShader.h"
 #include "../../include/graphics/IGlobalShaderProperties.h"
 #include "../../include/utils/CFileLogger.h"
+#include "../../include/core/CBaseJobManager.h"
 #include <algorithm>
+#include <cstring>
+#include <cmath>
 #include <stringUtils.hpp>
 
 
@@ -18,87 +21,238 @@ namespace TDEngine2
 	static const std::string InvalidMaterialMessage = "{0} Invalid material was passed into the render command";
 
 
-	E_RESULT_CODE TDrawCommand::Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties)
+	void TRenderStateCache::Invalidate()
 	{
-		if (TResourceId::Invalid == mMaterialHandle)
+		mMaterialHandle         = TResourceId::Invalid;
+		mMaterialInstanceId     = TMaterialInstanceId::Invalid;
+		mIsInstancedShaderBound = false;
+		mpMaterial              = nullptr;
+		mpShader                = nullptr;
+		mpVertexDeclaration     = nullptr;
+		mpDeclarationShader     = nullptr;
+		mpIndexBuffer           = nullptr;
+
+		for (U32 i = 0; i < mMaxVertexBuffersCount; ++i)
 		{
-			LOG_ERROR(Wrench::StringUtils::Format(InvalidMaterialMessage, "[TDrawCommand]"));
-			return RC_INVALID_ARGS;
+			mpDeclarationBuffers[i]  = nullptr;
+			mpVertexBuffers[i]       = nullptr;
+			mVertexBuffersStrides[i] = 0;
 		}
+	}
 
-		auto pMaterial = pResourceManager->GetResource<IMaterial>(mMaterialHandle);
+	void TRenderStateCache::ResetStats()
+	{
+		mBindsCount        = 0;
+		mSkippedBindsCount = 0;
+	}
 
-		auto pAttachedShader = pResourceManager->GetResource<IShader>(pMaterial->GetShaderHandle());
+	IMaterial* TRenderStateCache::BindMaterial(IResourceManager* pResourceManager, TResourceId materialHandle, TMaterialInstanceId instanceId, bool useInstancedShader)
+	{
+		/// \note Instanced and regular draw calls of the same material use different shaders, so switches between them rebind everything
+		if (mMaterialHandle == materialHandle && mpMaterial && mIsInstancedShaderBound == useInstancedShader)
+		{
+			if (mMaterialInstanceId == instanceId)
+			{
+				++mSkippedBindsCount;
+				return mpMaterial.Get();
+			}
 
-		mpVertexDeclaration->Bind(pGraphicsContext, { mpVertexBuffer }, pAttachedShader.Get());
+			/// \note The same material but another instance, so only user uniforms and textures should be updated
+			mpMaterial->BindInstanceData(instanceId, useInstancedShader);
+			mMaterialInstanceId = instanceId;
 
-		pMaterial->Bind(mMaterialInstanceId);
+			++mBindsCount;
 
-		if (pMaterial->IsScissorTestEnabled())
+			return mpMaterial.Get();
+		}
+
+		mpMaterial = pResourceManager->GetResource<IMaterial>(materialHandle);
+		if (!mpMaterial)
 		{
-			pGraphicsContext->SetScissorRect(mScissorRect);
+			Invalidate();
+			return nullptr;
 		}
 
-		if (mpVertexBuffer)
+		mpShader = pResourceManager->GetResource<IShader>(useInstancedShader ? mpMaterial->GetInstancedShaderHandle() : mpMaterial->GetShaderHandle());
+		if (!mpShader)
 		{
-			mpVertexBuffer->Bind(0, 0, mpVertexDeclaration->GetStrideSize(0)); /// \todo replace magic constants
+			Invalidate();
+			return nullptr;
 		}
 
-		pGlobalShaderProperties->SetInternalUniformsBuffer(IUBR_PER_OBJECT, reinterpret_cast<const U8*>(&mObjectData), sizeof(mObjectData));
+		mpMaterial->Bind(instanceId, useInstancedShader);
 
-		pGraphicsContext->Draw(mPrimitiveType, mStartVertex, mNumOfVertices);
+		mMaterialHandle         = materialHandle;
+		mMaterialInstanceId     = instanceId;
+		mIsInstancedShaderBound = useInstancedShader;
 
-		return RC_OK;
+		++mBindsCount;
+
+		return mpMaterial.Get();
+	}
+
+	void TRenderStateCache::BindVertexDeclaration(IGraphicsContext* pGraphicsContext, IVertexDeclaration* pVertexDeclaration, IVertexBuffer* pVertexBuffer,
+												  IVertexBuffer* pInstancingBuffer)
+	{
+		IShader* pShader = mpShader.Get();
+
+		if (mpVertexDeclaration == pVertexDeclaration && mpDeclarationShader == pShader &&
+			mpDeclarationBuffers[0] == pVertexBuffer && mpDeclarationBuffers[1] == pInstancingBuffer)
+		{
+			++mSkippedBindsCount;
+			return;
+		}
+
+		if (pInstancingBuffer)
+		{
+			pVertexDeclaration->Bind(pGraphicsContext, { pVertexBuffer, pInstancingBuffer }, pShader);
+		}
+		else
+		{
+			pVertexDeclaration->Bind(pGraphicsContext, { pVertexBuffer }, pShader);
+		}
+
+		mpVertexDeclaration     = pVertexDeclaration;
+		mpDeclarationShader     = pShader;
+		mpDeclarationBuffers[0] = pVertexBuffer;
+		mpDeclarationBuffers[1] = pInstancingBuffer;
+
+		/// \note A vertex array object in GL keeps bindings of buffers, so they should be set up again
+		for (U32 i = 0; i < mMaxVertexBuffersCount; ++i)
+		{
+			mpVertexBuffers[i] = nullptr;
+		}
+
+		mpIndexBuffer = nullptr;
+
+		++mBindsCount;
+	}
+
+	void TRenderStateCache::BindVertexBuffer(U32 slot, IVertexBuffer* pVertexBuffer, U32 stride)
+	{
+		TDE2_ASSERT(slot < mMaxVertexBuffersCount);
+
+		if (!pVertexBuffer)
+		{
+			return;
+		}
+
+		if (mpVertexBuffers[slot] == pVertexBuffer && mVertexBuffersStrides[slot] == stride)
+		{
+			++mSkippedBindsCount;
+			return;
+		}
+
+		pVertexBuffer->Bind(slot, 0, stride);
+
+		mpVertexBuffers[slot]       = pVertexBuffer;
+		mVertexBuffersStrides[slot] = stride;
+
+		++mBindsCount;
 	}
 
+	void TRenderStateCache::BindIndexBuffer(IIndexBuffer* pIndexBuffer)
+	{
+		if (mpIndexBuffer == pIndexBuffer)
+		{
+			++mSkippedBindsCount;
+			return;
+		}
+
+		pIndexBuffer->Bind(0);
+		mpIndexBuffer = pIndexBuffer;
 
-	E_RESULT_CODE TDrawIndexedCommand::Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties)
+		++mBindsCount;
+	}
+
+
+	static void BindPerObjectData(IGlobalShaderProperties* pGlobalShaderProperties, const TRenderCommand& command)
+	{
+		if (InvalidPerObjectDataIndex != command.mObjectDataIndex && RC_OK == pGlobalShaderProperties->BindObjectData(command.mObjectDataIndex))
+		{
+			return;
+		}
+
+		pGlobalShaderProperties->SetInternalUniformsBuffer(IUBR_PER_OBJECT, reinterpret_cast<const U8*>(&command.mObjectData), sizeof(command.mObjectData));
+	}
+
+
+	E_RESULT_CODE TDrawCommand::Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache)
 	{
 		if (TResourceId::Invalid == mMaterialHandle)
 		{
-			LOG_ERROR(Wrench::StringUtils::Format(InvalidMaterialMessage, "[TDrawIndexedCommand]"));
+			LOG_ERROR(Wrench::StringUtils::Format(InvalidMaterialMessage, "[TDrawCommand]"));
 			return RC_INVALID_ARGS;
 		}
 
-		auto pMaterial = pResourceManager->GetResource<IMaterial>(mMaterialHandle);
+		TRenderStateCache localStateCache;
+		TRenderStateCache& stateCache = pStateCache ? *pStateCache : localStateCache;
+
+		IMaterial* pMaterial = stateCache.BindMaterial(pResourceManager, mMaterialHandle, mMaterialInstanceId);
 		if (!pMaterial)
 		{
 			TDE2_ASSERT(false);
 			return RC_FAIL;
 		}
 
-		auto pAttachedShader = pResourceManager->GetResource<IShader>(pMaterial->GetShaderHandle());
-		if (!pAttachedShader)
+		stateCache.BindVertexDeclaration(pGraphicsContext, mpVertexDeclaration, mpVertexBuffer);
+
+		if (pMaterial->IsScissorTestEnabled())
+		{
+			pGraphicsContext->SetScissorRect(mScissorRect);
+		}
+
+		stateCache.BindVertexBuffer(0, mpVertexBuffer, mpVertexDeclaration->GetStrideSize(0)); /// \todo replace magic constants
+
+		BindPerObjectData(pGlobalShaderProperties, *this);
+
+		pGraphicsContext->Draw(mPrimitiveType, mStartVertex, mNumOfVertices);
+
+		return RC_OK;
+	}
+
+
+	E_RESULT_CODE TDrawIndexedCommand::Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache)
+	{
+		if (TResourceId::Invalid == mMaterialHandle)
+		{
+			LOG_ERROR(Wrench::StringUtils::Format(InvalidMaterialMessage, "[TDrawIndexedCommand]"));
+			return RC_INVALID_ARGS;
+		}
+
+		TRenderStateCache localStateCache;
+		TRenderStateCache& stateCache = pStateCache ? *pStateCache : localStateCache;
+
+		IMaterial* pMaterial = stateCache.BindMaterial(pResourceManager, mMaterialHandle, mMaterialInstanceId);
+		if (!pMaterial)
 		{
 			TDE2_ASSERT(false);
 			return RC_FAIL;
 		}
 
-		mpVertexDeclaration->Bind(pGraphicsContext, { mpVertexBuffer }, pAttachedShader.Get());
-
-		pMaterial->Bind(mMaterialInstanceId);
+		stateCache.BindVertexDeclaration(pGraphicsContext, mpVertexDeclaration, mpVertexBuffer);
 
 		if (pMaterial->IsScissorTestEnabled())
 		{
 			pGraphicsContext->SetScissorRect(mScissorRect);
 		}
 
-		mpVertexBuffer->Bind(0, 0, mpVertexDeclaration->GetStrideSize(0)); /// \todo replace magic constants
-		mpIndexBuffer->Bind(0);
+		stateCache.BindVertexBuffer(0, mpVertexBuffer, mpVertexDeclaration->GetStrideSize(0)); /// \todo replace magic constants
+		stateCache.BindIndexBuffer(mpIndexBuffer);
 
-		pGlobalShaderProperties->SetInternalUniformsBuffer(IUBR_PER_OBJECT, reinterpret_cast<const U8*>(&mObjectData), sizeof(mObjectData));
+		BindPerObjectData(pGlobalShaderProperties, *this);
 		
 		pGraphicsContext->DrawIndexed(mPrimitiveType, mpIndexBuffer->GetIndexFormat(), mStartVertex, mStartIndex, mNumOfIndices);
 
 		return RC_OK;
 	}
 
-	E_RESULT_CODE TDrawInstancedCommand::Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties)
+	E_RESULT_CODE TDrawInstancedCommand::Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache)
 	{
 		return RC_NOT_IMPLEMENTED_YET;
 	}
 
-	E_RESULT_CODE TDrawIndexedInstancedCommand::Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties)
+	E_RESULT_CODE TDrawIndexedInstancedCommand::Submit(IGraphicsContext* pGraphicsContext, IResourceManager* pResourceManager, IGlobalShaderProperties* pGlobalShaderProperties, TRenderStateCache* pStateCache)
 	{
 		if (TResourceId::Invalid == mMaterialHandle)
 		{
@@ -106,25 +260,29 @@ namespace TDEngine2
 			return RC_INVALID_ARGS;
 		}
 
-		auto pMaterial = pResourceManager->GetResource<IMaterial>(mMaterialHandle);
-
-		auto pAttachedShader = pResourceManager->GetResource<IShader>(pMaterial->GetShaderHandle());
+		TRenderStateCache localStateCache;
+		TRenderStateCache& stateCache = pStateCache ? *pStateCache : localStateCache;
 
-		mpVertexDeclaration->Bind(pGraphicsContext, { mpVertexBuffer, mpInstancingBuffer }, pAttachedShader.Get());
+		IMaterial* pMaterial = stateCache.BindMaterial(pResourceManager, mMaterialHandle, mMaterialInstanceId, true);
+		if (!pMaterial)
+		{
+			TDE2_ASSERT(false);
+			return RC_FAIL;
+		}
 
-		pMaterial->Bind(mMaterialInstanceId);
+		stateCache.BindVertexDeclaration(pGraphicsContext, mpVertexDeclaration, mpVertexBuffer, mpInstancingBuffer);
 
 		if (pMaterial->IsScissorTestEnabled())
 		{
 			pGraphicsContext->SetScissorRect(mScissorRect);
 		}
 
-		mpVertexBuffer->Bind(0, 0, mpVertexDeclaration->GetStrideSize(0)); /// \todo replace magic constants
-		mpInstancingBuffer->Bind(1, 0, mpVertexDeclaration->GetStrideSize(1));
+		stateCache.BindVertexBuffer(0, mpVertexBuffer, mpVertexDeclaration->GetStrideSize(0)); /// \todo replace magic constants
+		stateCache.BindVertexBuffer(1, mpInstancingBuffer, mpVertexDeclaration->GetStrideSize(1));
 
-		mpIndexBuffer->Bind(0);
+		stateCache.BindIndexBuffer(mpIndexBuffer);
 
-		pGlobalShaderProperties->SetInternalUniformsBuffer(IUBR_PER_OBJECT, reinterpret_cast<const U8*>(&mObjectData), sizeof(mObjectData));
+		BindPerObjectData(pGlobalShaderProperties, *this);
 
 		pGraphicsContext->DrawIndexedInstanced(mPrimitiveType, mpIndexBuffer->GetIndexFormat(), mBaseVertexIndex, mStartIndex, 
 											   mStartInstance, mIndicesPerInstance, mNumOfInstances);
@@ -152,7 +310,7 @@ namespace TDEngine2
 
 	TRenderCommand* CRenderQueue::CRenderQueueIterator::GetNext()
 	{
-		return std::get<TRenderCommand*>((*mpTargetCollection)[++mCurrCommandIndex]);
+		return (*mpTargetCollection)[++mCurrCommandIndex].mpCommand;
 	}
 
 	bool CRenderQueue::CRenderQueueIterator::HasNext() const
@@ -167,13 +325,18 @@ namespace TDEngine2
 
 	TRenderCommand* CRenderQueue::CRenderQueueIterator::Get() const
 	{
-		return std::get<TRenderCommand*>((*mpTargetCollection)[mCurrCommandIndex]);
+		return (*mpTargetCollection)[mCurrCommandIndex].mpCommand;
 	}
 
 	U32 CRenderQueue::CRenderQueueIterator::GetIndex() const
 	{
 		return mCurrCommandIndex;
 	}
+
+	U64 CRenderQueue::CRenderQueueIterator::GetSortKey() const
+	{
+		return (*mpTargetCollection)[mCurrCommandIndex].mSortKey;
+	}
 	
 	CRenderQueue::CRenderQueueIterator& CRenderQueue::CRenderQueueIterator::operator++()
 	{
@@ -193,7 +356,7 @@ namespace TDEngine2
 
 	TRenderCommand* CRenderQueue::CRenderQueueIterator::operator*() const
 	{
-		return std::get<TRenderCommand*>((*mpTargetCollection)[mCurrCommandIndex]);
+		return (*mpTargetCollection)[mCurrCommandIndex].mpCommand;
 	}
 
 
@@ -202,20 +365,28 @@ namespace TDEngine2
 	{
 	}
 
-	E_RESULT_CODE CRenderQueue::Init(IAllocator* pTempAllocator)
+	E_RESULT_CODE CRenderQueue::Init(IAllocator* pTempAllocator, const std::vector<IAllocator*>& workersAllocators)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
-		if (!pTempAllocator)
+		if (!pTempAllocator || std::find(workersAllocators.cbegin(), workersAllocators.cend(), nullptr) != workersAllocators.cend())
 		{
 			return RC_INVALID_ARGS;
 		}
 
 		mpTempAllocator = pTempAllocator;
 
+		for (IAllocator* pCurrAllocator : workersAllocators)
+		{
+			TRecordingContext workerContext;
+			workerContext.mpAllocator = pCurrAllocator;
+
+			mWorkersContexts.emplace_back(std::move(workerContext));
+		}
+
 		mIsInitialized = true;
 
 		return RC_OK;
@@ -225,35 +396,194 @@ namespace TDEngine2
 	{
 		mCommandsBuffer.clear();
 
-		return mpTempAllocator->Clear();
+		E_RESULT_CODE result = RC_OK;
+
+		for (TRecordingContext& currContext : mWorkersContexts)
+		{
+			currContext.mCommandsBuffer.clear();
+			result = result | currContext.mpAllocator->Clear();
+		}
+
+		return result | mpTempAllocator->Clear();
 	}
 
 	void CRenderQueue::Sort()
 	{
-		std::sort(mCommandsBuffer.begin(), mCommandsBuffer.end(), [](const std::tuple<U32, TRenderCommand*>& left, const std::tuple<U32, TRenderCommand*>& right)
+		_mergeRecordedCommands();
+
+		const USIZE commandsCount = mCommandsBuffer.size();
+		if (commandsCount < 2)
 		{
-			return std::get<U32>(left) > std::get<U32>(right);
-		});
+			return;
+		}
+
+		constexpr U32 radixBits  = 8;
+		constexpr U32 radixSize  = 1 << radixBits;
+		constexpr U32 indexPassesCount = sizeof(U32) * 8 / radixBits;
+		constexpr U32 passesCount = indexPassesCount + sizeof(U64) * 8 / radixBits;
+
+		/// \note Submission indices are the least significant digits, so ties of keys are resolved without a separate sort.
+		/// Keys are inverted to get the descending order
+		auto getDigit = [](const TCommandEntry& entry, U32 pass)
+		{
+			const U64 value = (pass < indexPassesCount) ? (static_cast<U64>(entry.mSubmissionIndex) >> (pass * radixBits)) : ((~entry.mSortKey) >> ((pass - indexPassesCount) * radixBits));
+			return static_cast<U32>(value & (radixSize - 1));
+		};
+
+		mTempCommandsBuffer.resize(commandsCount);
+
+		TCommandEntry* pSrc = mCommandsBuffer.data();
+		TCommandEntry* pDest = mTempCommandsBuffer.data();
+
+		/// \note Build histograms of all digits in a single sweep
+		USIZE histograms[passesCount][radixSize] = {};
+
+		for (USIZE i = 0; i < commandsCount; ++i)
+		{
+			for (U32 pass = 0; pass < passesCount; ++pass)
+			{
+				++histograms[pass][getDigit(pSrc[i], pass)];
+			}
+		}
+
+		for (U32 pass = 0; pass < passesCount; ++pass)
+		{
+			USIZE* pHistogram = histograms[pass];
+
+			/// \note Skip the pass if all entries have the same digit, which is common for layers, flags and high bits of indices
+			if (pHistogram[getDigit(pSrc[0], pass)] == commandsCount)
+			{
+				continue;
+			}
+
+			USIZE offset = 0;
+
+			for (U32 digit = 0; digit < radixSize; ++digit)
+			{
+				const USIZE count = pHistogram[digit];
+				pHistogram[digit] = offset;
+				offset += count;
+			}
+
+			for (USIZE i = 0; i < commandsCount; ++i)
+			{
+				pDest[pHistogram[getDigit(pSrc[i], pass)]++] = pSrc[i];
+			}
+
+			std::swap(pSrc, pDest);
+		}
+
+		if (pSrc != mCommandsBuffer.data())
+		{
+			std::copy(pSrc, pSrc + commandsCount, mCommandsBuffer.data());
+		}
 	}
 
 	bool CRenderQueue::IsEmpty() const
 	{
-		return mCommandsBuffer.empty();
+		return mCommandsBuffer.empty() && std::all_of(mWorkersContexts.cbegin(), mWorkersContexts.cend(), [](const TRecordingContext& currContext)
+		{
+			return currContext.mCommandsBuffer.empty();
+		});
 	}
 
 	E_RESULT_CODE CRenderQueue::_onFreeInternal()
 	{
-		return mpTempAllocator->Free();
+		E_RESULT_CODE result = RC_OK;
+
+		for (TRecordingContext& currContext : mWorkersContexts)
+		{
+			result = result | currContext.mpAllocator->Free();
+		}
+
+		return result | mpTempAllocator->Free();
+	}
+
+	CRenderQueue::TRecordingContext* CRenderQueue::_getCurrWorkerRecordingContext()
+	{
+		const U32 workerIndex = CBaseJobManager::GetCurrWorkerThreadIndex();
+		return (workerIndex < static_cast<U32>(mWorkersContexts.size())) ? &mWorkersContexts[workerIndex] : nullptr;
+	}
+
+	void CRenderQueue::_mergeRecordedCommands()
+	{
+		/// \note Which worker executes a job varies between frames, Sort orders merged commands by their submission indices
+		for (TRecordingContext& currContext : mWorkersContexts)
+		{
+			mCommandsBuffer.insert(mCommandsBuffer.end(), currContext.mCommandsBuffer.cbegin(), currContext.mCommandsBuffer.cend());
+			currContext.mCommandsBuffer.clear();
+		}
 	}
 
 	CRenderQueue::CRenderQueueIterator CRenderQueue::GetIterator()
 	{
+		_mergeRecordedCommands();
+
 		return CRenderQueueIterator(mCommandsBuffer);
 	}
 
 
+	TDE2_API U64 MakeRenderCommandSortKey(U8 layer, bool isTransparent, TResourceId materialId, F32 distanceToCamera, U8 sequence)
+	{
+		/// \note Bits of a non-negative float keep the order of values, so the highest 16 bits give a depth with logarithmic precision
+		const F32 depth = fabs(distanceToCamera);
+
+		U32 depthBits = 0;
+		memcpy(&depthBits, &depth, sizeof(depth));
+
+		const U64 quantizedDepth = static_cast<U64>(depthBits >> 15) & 0xFFFF;
+		const U64 material = static_cast<U64>(static_cast<U32>(materialId));
+
+		U64 key = (static_cast<U64>(layer) << 56) | (static_cast<U64>(sequence) & 0x7F);
+
+		if (isTransparent)
+		{
+			/// \note Back-to-front, farther objects get greater keys
+			key |= (quantizedDepth << 39) | (material << 7);
+		}
+		else
+		{
+			/// \note Front-to-back within a material, nearer objects get greater keys
+			key |= (1ull << 55) | (material << 23) | ((0xFFFF - quantizedDepth) << 7);
+		}
+
+		return key;
+	}
+
+	TDE2_API U8 GetGeometrySubGroupLayer(E_GEOMETRY_SUBGROUP_TAGS tag)
+	{
+		switch (tag)
+		{
+			case E_GEOMETRY_SUBGROUP_TAGS::BASE:
+				return 0;
+			case E_GEOMETRY_SUBGROUP_TAGS::SKYBOX:
+				return 1;
+			case E_GEOMETRY_SUBGROUP_TAGS::IMAGE_EFFECTS:
+				return 2;
+			case E_GEOMETRY_SUBGROUP_TAGS::SELECTION_OUTLINE:
+				return 3;
+		}
+
+		return 0;
+	}
+
+
+	TDE2_API U32 MakeRenderCommandSubmissionIndex(E_RENDER_COMMANDS_RECORDER_TYPE recorderType, U32 index)
+	{
+		constexpr U32 indexBitsCount = 24;
+
+		TDE2_ASSERT(index < (1u << indexBitsCount));
+		return (static_cast<U32>(recorderType) << indexBitsCount) | (index & ((1u << indexBitsCount) - 1));
+	}
+
+
 	TDE2_API CRenderQueue* CreateRenderQueue(IAllocator* pTempAllocator, E_RESULT_CODE& result)
 	{
 		return CREATE_IMPL(CRenderQueue, CRenderQueue, result, pTempAllocator);
 	}
+
+	TDE2_API CRenderQueue* CreateRenderQueue(IAllocator* pTempAllocator, const std::vector<IAllocator*>& workersAllocators, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(CRenderQueue, CRenderQueue, result, pTempAllocator, workersAllocators);
+	}
 }
\ No newline at end of file
@@ -86,6 +86,26 @@ namespace TDEngine2
 		return _hasJointIndicesInternal();
 	}
 
+	E_RESULT_CODE CSkinnedMesh::Evict()
+	{
+		E_RESULT_CODE result = CBaseMesh::Evict();
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		std::vector<TJointsWeightsArray>().swap(mJointsWeights);
+		std::vector<TJointsIndicesArray>().swap(mJointsIndices);
+
+		return result;
+	}
+
+	USIZE CSkinnedMesh::GetMemorySize() const
+	{
+		const USIZE size = CBaseMesh::GetMemorySize();
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		return size + mJointsWeights.size() * sizeof(TJointsWeightsArray) + mJointsIndices.size() * sizeof(TJointsIndicesArray);
+	}
+
 	E_RESULT_CODE CSkinnedMesh::_initPositionOnlyVertexBuffer()
 	{
 		auto&& positions = _toPositionOnlyArray();
@@ -37,6 +37,10 @@ namespace TDEngine2
 		mMeshName = pReader->GetString(TSkinnedMeshContainerArchiveKeys::mMeshKeyId);
 		mSkeletonName = pReader->GetString(TSkinnedMeshContainerArchiveKeys::mSkeletonKeyId);
 
+		mMaterialId = TResourceId::Invalid;
+		mMeshId = TResourceId::Invalid;
+		mSkeletonId = TResourceId::Invalid;
+
 		return RC_OK;
 	}
 
@@ -63,11 +67,13 @@ namespace TDEngine2
 	void CSkinnedMeshContainer::SetMaterialName(const std::string& materialName)
 	{
 		mMaterialName = materialName;
+		mMaterialId = TResourceId::Invalid;
 	}
 
 	void CSkinnedMeshContainer::SetMeshName(const std::string& meshName)
 	{
 		mMeshName = meshName;
+		mMeshId = TResourceId::Invalid;
 		mIsDirty = true;
 	}
 
@@ -88,6 +94,21 @@ namespace TDEngine2
 		mIsDirty = value;
 	}
 
+	void CSkinnedMeshContainer::SetMaterialId(TResourceId materialId)
+	{
+		mMaterialId = materialId;
+	}
+
+	void CSkinnedMeshContainer::SetMeshId(TResourceId meshId)
+	{
+		mMeshId = meshId;
+	}
+
+	void CSkinnedMeshContainer::SetSkeletonId(TResourceId skeletonId)
+	{
+		mSkeletonId = skeletonId;
+	}
+
 #if TDE2_EDITORS_ENABLED
 
 	void CSkinnedMeshContainer::AddSubmeshIdentifier(const std::string& submeshId)
@@ -105,6 +126,7 @@ namespace TDEngine2
 	void CSkinnedMeshContainer::SetSkeletonName(const std::string& skeletonName)
 	{
 		mSkeletonName = skeletonName;
+		mSkeletonId = TResourceId::Invalid;
 	}
 
 	void CSkinnedMeshContainer::SetSystemBuffersHandle(U32 handle)
@@ -167,6 +189,21 @@ namespace TDEngine2
 		return mIsDirty;
 	}
 
+	TResourceId CSkinnedMeshContainer::GetMaterialId() const
+	{
+		return mMaterialId;
+	}
+
+	TResourceId CSkinnedMeshContainer::GetMeshId() const
+	{
+		return mMeshId;
+	}
+
+	TResourceId CSkinnedMeshContainer::GetSkeletonId() const
+	{
+		return mSkeletonId;
+	}
+
 #if TDE2_EDITORS_ENABLED
 
 	const std::vector<std::string>& CSkinnedMeshContainer::GetSubmeshesIdentifiers() const
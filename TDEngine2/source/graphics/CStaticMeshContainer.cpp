@@ -18,6 +18,10 @@ namespace TDEngine2
 		mMaterialName = pReader->GetString("material");
 		mMeshName = pReader->GetString("mesh");
 		mSubMeshId = pReader->GetString("sub_mesh_id");
+		mIsStatic = pReader->GetBool("is_static");
+
+		mMaterialId = TResourceId::Invalid;
+		mMeshId = TResourceId::Invalid;
 
 		mIsDirty = true;
 
@@ -38,6 +42,7 @@ namespace TDEngine2
 			pWriter->SetString("material", mMaterialName);
 			pWriter->SetString("mesh", mMeshName);
 			pWriter->SetString("sub_mesh_id", mSubMeshId);
+			pWriter->SetBool("is_static", mIsStatic);
 		}
 		pWriter->EndGroup();
 
@@ -47,11 +52,13 @@ namespace TDEngine2
 	void CStaticMeshContainer::SetMaterialName(const std::string& materialName)
 	{
 		mMaterialName = materialName;
+		mMaterialId = TResourceId::Invalid;
 	}
 
 	void CStaticMeshContainer::SetMeshName(const std::string& meshName)
 	{
 		mMeshName = meshName;
+		mMeshId = TResourceId::Invalid;
 		mIsDirty = true;
 	}
 
@@ -76,6 +83,21 @@ namespace TDEngine2
 		mIsDirty = value;
 	}
 
+	void CStaticMeshContainer::SetMaterialId(TResourceId materialId)
+	{
+		mMaterialId = materialId;
+	}
+
+	void CStaticMeshContainer::SetMeshId(TResourceId meshId)
+	{
+		mMeshId = meshId;
+	}
+
+	void CStaticMeshContainer::SetStatic(bool value)
+	{
+		mIsStatic = value;
+	}
+
 #if TDE2_EDITORS_ENABLED
 
 	void CStaticMeshContainer::AddSubmeshIdentifier(const std::string& submeshId)
@@ -115,6 +137,21 @@ namespace TDEngine2
 		return mIsDirty;
 	}
 
+	TResourceId CStaticMeshContainer::GetMaterialId() const
+	{
+		return mMaterialId;
+	}
+
+	TResourceId CStaticMeshContainer::GetMeshId() const
+	{
+		return mMeshId;
+	}
+
+	bool CStaticMeshContainer::IsStatic() const
+	{
+		return mIsStatic;
+	}
+
 #if TDE2_EDITORS_ENABLED
 
 	const std::vector<std::string>& CStaticMeshContainer::GetSubmeshesIdentifiers() const
@@ -100,6 +100,23 @@ namespace TDEngine2
 		return RC_OK;
 	}
 
+	E_RESULT_CODE CTextureAtlas::Evict()
+	{
+		return Reset();
+	}
+
+	USIZE CTextureAtlas::GetMemorySize() const
+	{
+		USIZE size = mAtlasNodes.size() * sizeof(stbrp_node);
+
+		for (auto&& currEntity : mAtlasEntities)
+		{
+			size += currEntity.first.capacity() + sizeof(TRectI32);
+		}
+
+		return size;
+	}
+
 	E_RESULT_CODE CTextureAtlas::AddRawTexture(const std::string& name, U32 width, U32 height, E_FORMAT_TYPE format, const U8* pData)
 	{
 		if (!mIsInitialized)
@@ -0,0 +1,293 @@
+#include "../../include/graphics/ClusteredLighting.h"
+#include "../../include/graphics/InternalShaderData.h"
+#include "../../include/ecs/IWorld.h"
+#include "../../include/editor/CPerfProfiler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+
+namespace TDEngine2
+{
+	static constexpr U32 ClustersPerSlice = LightClustersCountX * LightClustersCountY;
+
+
+	typedef struct TLightClusterBounds
+	{
+		U8   mMinX, mMaxX;
+		U8   mMinY, mMaxY;
+		U8   mMinZ, mMaxZ;
+		bool mIsVisible;
+	} TLightClusterBounds, *TLightClusterBoundsPtr;
+
+
+	template <typename TAction>
+	static void ParallelFor(IWorld* pWorld, U32 elementsCount, const TAction& action)
+	{
+		if (pWorld)
+		{
+			pWorld->ParallelForEach(static_cast<USIZE>(elementsCount), action);
+			return;
+		}
+
+		for (USIZE i = 0; i < elementsCount; ++i)
+		{
+			action(i);
+		}
+	}
+
+
+	/// \note The mapping should match GetLightClusterIndex from TDEngine2Globals.inc
+	static inline U8 GetTileIndex(F32 ndcCoord, U32 tilesCount)
+	{
+		const F32 uv = std::min(std::max(ndcCoord * 0.5f + 0.5f, 0.0f), 0.9999f);
+		return static_cast<U8>(uv * static_cast<F32>(tilesCount));
+	}
+
+	static inline U8 GetSliceIndex(F32 depth, const TVector4& clustersParams)
+	{
+		const F32 slice = logf(std::max(depth, clustersParams.x) / clustersParams.x) * clustersParams.z;
+		return static_cast<U8>(std::min(slice, static_cast<F32>(LightClustersCountZ - 1)));
+	}
+
+
+	static TLightClusterBounds ComputeLightClusterBounds(const TMatrix4& viewMatrix, const TMatrix4& projMatrix, const TVector4& clustersParams, const TPointLightData& light)
+	{
+		TLightClusterBounds bounds { 0, LightClustersCountX - 1, 0, LightClustersCountY - 1, 0, LightClustersCountZ - 1, false };
+
+		const TVector4 viewPos = viewMatrix * TVector4(light.mPosition.x, light.mPosition.y, light.mPosition.z, 1.0f);
+		const F32 radius = light.mRange;
+
+		/// \note A view space depth is used instead of w of clip space, because the latter is constant for orthographic projections
+		const F32 depth = clustersParams.w * viewPos.z;
+
+		if ((depth + radius <= 0.0f) || (depth - radius > clustersParams.y))
+		{
+			return bounds;
+		}
+
+		bounds.mIsVisible = true;
+		bounds.mMinZ      = GetSliceIndex(depth - radius, clustersParams);
+		bounds.mMaxZ      = GetSliceIndex(depth + radius, clustersParams);
+
+		F32 minX = 1.0f, maxX = -1.0f;
+		F32 minY = 1.0f, maxY = -1.0f;
+
+		/// \note Corners of a box around the light are projected, the rect that encloses them encloses the sphere as well
+		for (U32 i = 0; i < 8; ++i)
+		{
+			const TVector4 clipPos = projMatrix * TVector4(viewPos.x + ((i & 0x1) ? radius : -radius),
+														   viewPos.y + ((i & 0x2) ? radius : -radius),
+														   viewPos.z + ((i & 0x4) ? radius : -radius), 1.0f);
+
+			if (clipPos.w < 1e-3f) /// \note The light surrounds the camera, so all tiles of the slices are touched
+			{
+				return bounds;
+			}
+
+			minX = std::min(minX, clipPos.x / clipPos.w);
+			maxX = std::max(maxX, clipPos.x / clipPos.w);
+			minY = std::min(minY, clipPos.y / clipPos.w);
+			maxY = std::max(maxY, clipPos.y / clipPos.w);
+		}
+
+		if (minX > 1.0f || maxX < -1.0f || minY > 1.0f || maxY < -1.0f)
+		{
+			bounds.mIsVisible = false;
+			return bounds;
+		}
+
+		bounds.mMinX = GetTileIndex(minX, LightClustersCountX);
+		bounds.mMaxX = GetTileIndex(maxX, LightClustersCountX);
+		bounds.mMinY = GetTileIndex(minY, LightClustersCountY);
+		bounds.mMaxY = GetTileIndex(maxY, LightClustersCountY);
+
+		return bounds;
+	}
+
+
+	/*!
+		\brief The function finds a limit of lights per cluster which fits all references into MaxLightClustersIndicesCount.
+		The limit is the same for all clusters, so far slices aren't starved by near ones which go first within the buffer
+
+		\param[in, out] pClusters Numbers of lights of clusters which are clamped by the function
+
+		\return A number of references that were dropped
+	*/
+
+	static U32 TruncateLightClusters(U32* pClusters)
+	{
+		U32 referencesCount = 0;
+
+		for (U32 i = 0; i < LightClustersCount; ++i)
+		{
+			referencesCount += pClusters[i];
+		}
+
+		if (referencesCount <= MaxLightClustersIndicesCount)
+		{
+			return 0;
+		}
+
+		auto countLimitedReferences = [pClusters](U32 limit)
+		{
+			U32 count = 0;
+
+			for (U32 i = 0; i < LightClustersCount; ++i)
+			{
+				count += std::min(pClusters[i], limit);
+			}
+
+			return count;
+		};
+
+		/// \note Find the greatest limit which fits into the buffer
+		U32 minLimit = 0;
+		U32 maxLimit = MaxPointLightsCount;
+
+		while (minLimit < maxLimit)
+		{
+			const U32 limit = (minLimit + maxLimit + 1) / 2;
+
+			if (countLimitedReferences(limit) <= MaxLightClustersIndicesCount)
+			{
+				minLimit = limit;
+			}
+			else
+			{
+				maxLimit = limit - 1;
+			}
+		}
+
+		/// \note The rest of the buffer is given to overflowed clusters by a single reference
+		U32 freeReferencesCount = MaxLightClustersIndicesCount - countLimitedReferences(minLimit);
+
+		for (U32 i = 0; i < LightClustersCount; ++i)
+		{
+			if (pClusters[i] <= minLimit)
+			{
+				continue;
+			}
+
+			pClusters[i] = minLimit;
+
+			if (freeReferencesCount > 0)
+			{
+				++pClusters[i];
+				--freeReferencesCount;
+			}
+		}
+
+		return referencesCount - MaxLightClustersIndicesCount;
+	}
+
+
+	TDE2_API U32 AssignPointLightsToClusters(IWorld* pWorld, const TMatrix4& viewMatrix, const TMatrix4& projMatrix, F32 zNear, F32 zFar,
+											 TLightClustersShaderData& lightClustersData)
+	{
+		TDE2_PROFILER_SCOPE("AssignPointLightsToClusters");
+
+		zNear = std::max(zNear, 1e-3f);
+		zFar  = std::max(zFar, 2.0f * zNear);
+
+		const U32 lightsCount = std::min(lightClustersData.mPointLightsCount, MaxPointLightsCount);
+
+		/// \note Both projections map the view direction onto the same sign of z, w of a perspective projection equals to the depth
+		const bool isPerspective = fabs(projMatrix.m[3][2]) > 0.0f;
+		const F32 viewDepthSign = ((isPerspective ? projMatrix.m[3][2] : projMatrix.m[2][2]) < 0.0f) ? -1.0f : 1.0f;
+
+		lightClustersData.mPointLightsCount = lightsCount;
+		lightClustersData.mClustersParams   = TVector4(zNear, zFar, static_cast<F32>(LightClustersCountZ) / logf(zFar / zNear), viewDepthSign);
+		lightClustersData.mClustersCount[0] = LightClustersCountX;
+		lightClustersData.mClustersCount[1] = LightClustersCountY;
+		lightClustersData.mClustersCount[2] = LightClustersCountZ;
+
+		const TVector4& clustersParams = lightClustersData.mClustersParams;
+		const TPointLightData* pPointLights = lightClustersData.mPointLights;
+
+		std::array<TLightClusterBounds, MaxPointLightsCount> lightsBounds;
+
+		ParallelFor(pWorld, lightsCount, [&lightsBounds, &viewMatrix, &projMatrix, &clustersParams, pPointLights](USIZE i)
+		{
+			lightsBounds[i] = ComputeLightClusterBounds(viewMatrix, projMatrix, clustersParams, pPointLights[i]);
+		});
+
+		U32* pClusters = lightClustersData.mClusters;
+
+		/// \note Each slice is processed by a single job, so clusters are written without synchronization
+		ParallelFor(pWorld, LightClustersCountZ, [&lightsBounds, lightsCount, pClusters](USIZE slice)
+		{
+			U32* pSliceClusters = pClusters + slice * ClustersPerSlice;
+
+			std::fill(pSliceClusters, pSliceClusters + ClustersPerSlice, 0);
+
+			for (U32 i = 0; i < lightsCount; ++i)
+			{
+				const TLightClusterBounds& bounds = lightsBounds[i];
+
+				if (!bounds.mIsVisible || (slice < bounds.mMinZ) || (slice > bounds.mMaxZ))
+				{
+					continue;
+				}
+
+				for (U32 y = bounds.mMinY; y <= bounds.mMaxY; ++y)
+				{
+					for (U32 x = bounds.mMinX; x <= bounds.mMaxX; ++x)
+					{
+						++pSliceClusters[x + y * LightClustersCountX];
+					}
+				}
+			}
+		});
+
+		const U32 droppedReferencesCount = TruncateLightClusters(pClusters);
+		TDE2_PROFILER_COUNTER("AssignPointLightsToClusters::DroppedReferences", static_cast<F32>(droppedReferencesCount));
+
+		U32 indicesCount = 0;
+
+		for (U32 i = 0; i < LightClustersCount; ++i)
+		{
+			const U32 clusterLightsCount = pClusters[i];
+
+			pClusters[i] = indicesCount | (clusterLightsCount << 16);
+			indicesCount += clusterLightsCount;
+		}
+
+		U16* pLightIndices = lightClustersData.mLightIndices;
+
+		ParallelFor(pWorld, LightClustersCountZ, [&lightsBounds, lightsCount, pClusters, pLightIndices](USIZE slice)
+		{
+			const U32* pSliceClusters = pClusters + slice * ClustersPerSlice;
+
+			std::array<U16, ClustersPerSlice> writtenIndicesCount {};
+
+			for (U32 i = 0; i < lightsCount; ++i)
+			{
+				const TLightClusterBounds& bounds = lightsBounds[i];
+
+				if (!bounds.mIsVisible || (slice < bounds.mMinZ) || (slice > bounds.mMaxZ))
+				{
+					continue;
+				}
+
+				for (U32 y = bounds.mMinY; y <= bounds.mMaxY; ++y)
+				{
+					for (U32 x = bounds.mMinX; x <= bounds.mMaxX; ++x)
+					{
+						const U32 clusterIndex = x + y * LightClustersCountX;
+						const U32 clusterData  = pSliceClusters[clusterIndex];
+
+						U16& currWrittenCount = writtenIndicesCount[clusterIndex];
+
+						if (currWrittenCount < (clusterData >> 16)) /// \note Truncated clusters keep lights with lower indices, which are the nearest ones
+						{
+							pLightIndices[(clusterData & 0xFFFF) + currWrittenCount++] = static_cast<U16>(i);
+						}
+					}
+				}
+			}
+		});
+
+		return indicesCount;
+	}
+}
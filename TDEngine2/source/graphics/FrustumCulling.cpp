@@ -0,0 +1,157 @@
+#include "../../include/graphics/FrustumCulling.h"
+#include "../../include/graphics/ICamera.h"
+#include "../../include/ecs/IWorld.h"
+#include "../../include/ecs/components/CBoundsComponent.h"
+#include "../../include/math/TAABB.h"
+#include "../../include/editor/CPerfProfiler.h"
+#include <algorithm>
+
+#if TDE2_SSE_ENABLED
+	#include <xmmintrin.h>
+#endif
+
+
+namespace TDEngine2
+{
+	static constexpr U32 BoxesPerPacket = 4;
+
+
+	/// \note Dirty bounds are stale until CBoundsUpdatingSystem recomputes them, so such elements are never culled
+	static inline bool IsCullable(const CBoundsComponent* pBounds)
+	{
+		return pBounds && !pBounds->IsDirty();
+	}
+
+
+#if TDE2_SSE_ENABLED
+
+	static U32 TestPacketOfBoxes(const IFrustum::TPlanesArray& planes, const CBoundsComponent* const* ppBounds, U32 count)
+	{
+		alignas(16) F32 minX[BoxesPerPacket] {}, minY[BoxesPerPacket] {}, minZ[BoxesPerPacket] {};
+		alignas(16) F32 maxX[BoxesPerPacket] {}, maxY[BoxesPerPacket] {}, maxZ[BoxesPerPacket] {};
+
+		U32 uncullableMask = 0x0;
+
+		for (U32 i = 0; i < count; ++i)
+		{
+			if (!IsCullable(ppBounds[i]))
+			{
+				uncullableMask |= (1 << i);
+				continue;
+			}
+
+			const TAABB& box = ppBounds[i]->GetBounds();
+
+			minX[i] = box.min.x; minY[i] = box.min.y; minZ[i] = box.min.z;
+			maxX[i] = box.max.x; maxY[i] = box.max.y; maxZ[i] = box.max.z;
+		}
+
+		const __m128 packedMinX = _mm_load_ps(minX), packedMinY = _mm_load_ps(minY), packedMinZ = _mm_load_ps(minZ);
+		const __m128 packedMaxX = _mm_load_ps(maxX), packedMaxY = _mm_load_ps(maxY), packedMaxZ = _mm_load_ps(maxZ);
+
+		const __m128 zero = _mm_setzero_ps();
+
+		__m128 outsideMask = zero;
+
+		for (auto&& currPlane : planes)
+		{
+			/// \note A vertex of a box which is the farthest one along the normal is chosen per axis, the choice is the same for all boxes
+			const __m128 x = (currPlane.a >= 0.0f) ? packedMaxX : packedMinX;
+			const __m128 y = (currPlane.b >= 0.0f) ? packedMaxY : packedMinY;
+			const __m128 z = (currPlane.c >= 0.0f) ? packedMaxZ : packedMinZ;
+
+			const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(currPlane.a), x), _mm_mul_ps(_mm_set1_ps(currPlane.b), y)),
+											   _mm_add_ps(_mm_mul_ps(_mm_set1_ps(currPlane.c), z), _mm_set1_ps(currPlane.d)));
+
+			outsideMask = _mm_or_ps(outsideMask, _mm_cmplt_ps(distance, zero));
+		}
+
+		return ((~static_cast<U32>(_mm_movemask_ps(outsideMask))) & 0xF) | uncullableMask;
+	}
+
+#else
+
+	static U32 TestPacketOfBoxes(const IFrustum::TPlanesArray& planes, const CBoundsComponent* const* ppBounds, U32 count)
+	{
+		U32 visibilityMask = 0x0;
+
+		for (U32 i = 0; i < count; ++i)
+		{
+			if (!IsCullable(ppBounds[i]))
+			{
+				visibilityMask |= (1 << i);
+				continue;
+			}
+
+			const TAABB& box = ppBounds[i]->GetBounds();
+
+			bool isVisible = true;
+
+			for (auto&& currPlane : planes)
+			{
+				const F32 x = (currPlane.a >= 0.0f) ? box.max.x : box.min.x;
+				const F32 y = (currPlane.b >= 0.0f) ? box.max.y : box.min.y;
+				const F32 z = (currPlane.c >= 0.0f) ? box.max.z : box.min.z;
+
+				if (currPlane.a * x + currPlane.b * y + currPlane.c * z + currPlane.d < 0.0f)
+				{
+					isVisible = false;
+					break;
+				}
+			}
+
+			visibilityMask |= (static_cast<U32>(isVisible) << i);
+		}
+
+		return visibilityMask;
+	}
+
+#endif
+
+
+	TDE2_API U32 CullBoundsByFrustum(IWorld* pWorld, const IFrustum* pFrustum, const std::vector<CBoundsComponent*>& bounds, std::vector<U8>& visibilityFlags)
+	{
+		TDE2_PROFILER_SCOPE("CullBoundsByFrustum");
+
+		const USIZE elementsCount = bounds.size();
+
+		visibilityFlags.resize(elementsCount);
+
+		if (!pFrustum)
+		{
+			std::fill(visibilityFlags.begin(), visibilityFlags.end(), static_cast<U8>(1));
+			return static_cast<U32>(elementsCount);
+		}
+
+		const IFrustum::TPlanesArray& planes = pFrustum->GetPlanes();
+
+		auto processPacket = [&planes, &bounds, &visibilityFlags, elementsCount](USIZE packetIndex)
+		{
+			const USIZE firstElementIndex = packetIndex * BoxesPerPacket;
+			const U32 packetSize = static_cast<U32>(std::min<USIZE>(BoxesPerPacket, elementsCount - firstElementIndex));
+
+			const U32 visibilityMask = TestPacketOfBoxes(planes, &bounds[firstElementIndex], packetSize);
+
+			for (U32 i = 0; i < packetSize; ++i)
+			{
+				visibilityFlags[firstElementIndex + i] = static_cast<U8>((visibilityMask >> i) & 0x1);
+			}
+		};
+
+		const USIZE packetsCount = (elementsCount + BoxesPerPacket - 1) / BoxesPerPacket;
+
+		if (pWorld)
+		{
+			pWorld->ParallelForEach(packetsCount, processPacket);
+		}
+		else
+		{
+			for (USIZE i = 0; i < packetsCount; ++i)
+			{
+				processPacket(i);
+			}
+		}
+
+		return static_cast<U32>(std::count(visibilityFlags.cbegin(), visibilityFlags.cend(), static_cast<U8>(1)));
+	}
+}
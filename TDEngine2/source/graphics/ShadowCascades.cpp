@@ -0,0 +1,217 @@
+#include "../../include/graphics/ShadowCascades.h"
+#include "../../include/graphics/InternalShaderData.h"
+#include "../../include/math/TAABB.h"
+#include "../../include/math/TVector4.h"
+#include "../../include/math/TVector2.h"
+#include <array>
+#include <algorithm>
+#include <cmath>
+
+
+namespace TDEngine2
+{
+	TDE2_API void ComputeShadowCascadesSplits(F32 zNear, F32 shadowDistance, U32 cascadesCount, F32 splitLambda, F32 splits[])
+	{
+		TDE2_ASSERT(cascadesCount > 0 && cascadesCount <= MaxShadowCascadesCount);
+		TDE2_ASSERT(zNear > 0.0f && shadowDistance > zNear);
+
+		cascadesCount = std::max<U32>(1, std::min<U32>(cascadesCount, MaxShadowCascadesCount));
+
+		for (U32 i = 0; i < cascadesCount; ++i)
+		{
+			const F32 t = static_cast<F32>(i + 1) / static_cast<F32>(cascadesCount);
+
+			const F32 uniformSplit = zNear + (shadowDistance - zNear) * t;
+			const F32 logSplit     = zNear * powf(shadowDistance / zNear, t);
+
+			splits[i] = uniformSplit + (logSplit - uniformSplit) * splitLambda;
+		}
+
+		for (U32 i = cascadesCount; i < MaxShadowCascadesCount; ++i)
+		{
+			splits[i] = splits[cascadesCount - 1];
+		}
+	}
+
+
+	TDE2_API TShadowCascadeBounds ComputeShadowCascadeBounds(const TMatrix4& projMatrix, const TMatrix4& viewMatrix, F32 ndcZMin, F32 zNear, F32 zFar,
+															   F32 sliceNear, F32 sliceFar)
+	{
+		static const std::array<TVector2, 4> ndcCorners { TVector2(-1.0f, -1.0f), TVector2(1.0f, -1.0f), TVector2(1.0f, 1.0f), TVector2(-1.0f, 1.0f) };
+
+		std::array<TVector3, 8> sliceCorners;
+
+		/// \note View depth changes linearly along rays which pass through the frustum's corners
+		const F32 nearT = (sliceNear - zNear) / (zFar - zNear);
+		const F32 farT  = (sliceFar - zNear) / (zFar - zNear);
+
+		/// \note The sphere is computed in view space, so its radius doesn't depend on the camera's orientation
+		const TMatrix4 invProj = Inverse(projMatrix);
+
+		TVector3 center = ZeroVector3;
+
+		for (U32 i = 0; i < ndcCorners.size(); ++i)
+		{
+			const TVector4 nearCorner = invProj * TVector4(ndcCorners[i].x, ndcCorners[i].y, ndcZMin, 1.0f);
+			const TVector4 farCorner  = invProj * TVector4(ndcCorners[i].x, ndcCorners[i].y, 1.0f, 1.0f);
+
+			const TVector3 rayBegin = TVector3(nearCorner.x, nearCorner.y, nearCorner.z) * (1.0f / nearCorner.w);
+			const TVector3 rayEnd   = TVector3(farCorner.x, farCorner.y, farCorner.z) * (1.0f / farCorner.w);
+
+			sliceCorners[2 * i]     = Lerp(rayBegin, rayEnd, nearT);
+			sliceCorners[2 * i + 1] = Lerp(rayBegin, rayEnd, farT);
+
+			center = center + sliceCorners[2 * i] + sliceCorners[2 * i + 1];
+		}
+
+		center = center * (1.0f / static_cast<F32>(sliceCorners.size()));
+
+		F32 radius = 0.0f;
+
+		for (const TVector3& currCorner : sliceCorners)
+		{
+			radius = std::max<F32>(radius, Length(currCorner - center));
+		}
+
+		/// \note Round the radius up to hide floating point errors between frames
+		radius = ceilf(radius * 16.0f) / 16.0f;
+
+		const TVector4 worldCenter = Inverse(viewMatrix) * TVector4(center, 1.0f);
+
+		return { TVector3(worldCenter.x, worldCenter.y, worldCenter.z), radius };
+	}
+
+
+	TDE2_API bool UpdateCachedShadowCascadeBounds(const TShadowCascadeBounds& sliceBounds, F32 margin, TShadowCascadeBounds& cachedBounds)
+	{
+		const F32 enlargedRadius = sliceBounds.mRadius * (1.0f + margin);
+
+		if ((std::abs(cachedBounds.mRadius - enlargedRadius) < 1e-3f) && (Length(sliceBounds.mCenter - cachedBounds.mCenter) + sliceBounds.mRadius <= cachedBounds.mRadius))
+		{
+			return false;
+		}
+
+		cachedBounds.mCenter = sliceBounds.mCenter;
+		cachedBounds.mRadius = enlargedRadius;
+
+		return true;
+	}
+
+
+	TDE2_API TMatrix4 ComputeShadowCascadeMatrix(const TVector3& lightDirection, const TShadowCascadeBounds& bounds, F32 castersExtrusion, U32 shadowMapSizes, F32 ndcZMin)
+	{
+		TDE2_ASSERT(bounds.mRadius > 0.0f && shadowMapSizes > 0);
+
+		const TVector3 forward = Normalize(lightDirection);
+		const TVector3 right   = Normalize(Cross((std::abs(forward.y) > 0.99f) ? RightVector3 : UpVector3, forward));
+		const TVector3 up      = Cross(forward, right);
+
+		const F32 radius = bounds.mRadius;
+
+		/// \note Move the center by whole texels, so rasterization of static geometry stays the same between frames
+		const F32 texelSize = 2.0f * radius / static_cast<F32>(shadowMapSizes);
+
+		const F32 centerX = floorf(Dot(right, bounds.mCenter) / texelSize) * texelSize;
+		const F32 centerY = floorf(Dot(up, bounds.mCenter) / texelSize) * texelSize;
+
+		const F32 zNear = Dot(forward, bounds.mCenter) - radius - castersExtrusion;
+		const F32 zFar  = Dot(forward, bounds.mCenter) + radius;
+		const F32 zScale = (1.0f - ndcZMin) / (zFar - zNear);
+
+		TMatrix4 cascadeMatrix = IdentityMatrix4;
+
+		cascadeMatrix.m[0][0] = right.x / radius;
+		cascadeMatrix.m[0][1] = right.y / radius;
+		cascadeMatrix.m[0][2] = right.z / radius;
+		cascadeMatrix.m[0][3] = -centerX / radius;
+
+		cascadeMatrix.m[1][0] = up.x / radius;
+		cascadeMatrix.m[1][1] = up.y / radius;
+		cascadeMatrix.m[1][2] = up.z / radius;
+		cascadeMatrix.m[1][3] = -centerY / radius;
+
+		cascadeMatrix.m[2][0] = forward.x * zScale;
+		cascadeMatrix.m[2][1] = forward.y * zScale;
+		cascadeMatrix.m[2][2] = forward.z * zScale;
+		cascadeMatrix.m[2][3] = ndcZMin - zNear * zScale;
+
+		return cascadeMatrix;
+	}
+
+
+	TDE2_API bool TestShadowCascadeAABB(const TMatrix4& cascadeMatrix, const TAABB& bounds, F32 ndcZMin)
+	{
+		const TVector3 center  = (bounds.min + bounds.max) * 0.5f;
+		const TVector3 extents = (bounds.max - bounds.min) * 0.5f;
+
+		const F32 minBounds[3] { -1.0f, -1.0f, ndcZMin };
+
+		/// \note The matrix is an affine one, so the box is projected onto each axis of the cascade's volume separately
+		for (U8 i = 0; i < 3; ++i)
+		{
+			const F32 projectedCenter = cascadeMatrix.m[i][0] * center.x + cascadeMatrix.m[i][1] * center.y + cascadeMatrix.m[i][2] * center.z + cascadeMatrix.m[i][3];
+			const F32 projectedExtent = std::abs(cascadeMatrix.m[i][0]) * extents.x + std::abs(cascadeMatrix.m[i][1]) * extents.y + std::abs(cascadeMatrix.m[i][2]) * extents.z;
+
+			if ((projectedCenter + projectedExtent < minBounds[i]) || (projectedCenter - projectedExtent > 1.0f))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
+	TDE2_API U32 UpdateShadowCascadesCastersState(U32 cascadesCount, U32 dynamicCastersMask, const U32 staticCastersHashes[], TShadowCascadesCastersState& castersState)
+	{
+		U32 changedCascadesMask = dynamicCastersMask | castersState.mDynamicCastersMask;
+
+		castersState.mDynamicCastersMask = dynamicCastersMask;
+
+		for (U32 i = 0; i < std::min(cascadesCount, MaxShadowCascadesCount); ++i)
+		{
+			if (castersState.mStaticCastersHashes[i] != staticCastersHashes[i])
+			{
+				castersState.mStaticCastersHashes[i] = staticCastersHashes[i];
+				changedCascadesMask |= (1 << i);
+			}
+		}
+
+		return changedCascadesMask & ((1 << cascadesCount) - 1);
+	}
+
+
+	TDE2_API U64 MakeShadowCasterSortKey(U32 cascadeIndex, U32 drawIndex)
+	{
+		TDE2_ASSERT(cascadeIndex < MaxShadowCascadesCount);
+		return (static_cast<U64>(MaxShadowCascadesCount - cascadeIndex) << 32) | static_cast<U64>(drawIndex);
+	}
+
+
+	TDE2_API U32 GetShadowCascadeIndexFromSortKey(U64 key)
+	{
+		const U32 encodedIndex = static_cast<U32>(key >> 32);
+		return (encodedIndex > 0 && encodedIndex <= MaxShadowCascadesCount) ? (MaxShadowCascadesCount - encodedIndex) : 0;
+	}
+
+
+	TDE2_API const std::string& GetShadowMapCascadeResourceName(U32 cascadeIndex)
+	{
+		static const std::array<std::string, MaxShadowCascadesCount> resourcesNames { "ShadowMap", "ShadowMap1", "ShadowMap2", "ShadowMap3" };
+
+		TDE2_ASSERT(cascadeIndex < MaxShadowCascadesCount);
+		return resourcesNames[std::min<U32>(cascadeIndex, MaxShadowCascadesCount - 1)];
+	}
+
+
+	TDE2_API const std::string& GetShadowMapCascadeSamplerName(U32 cascadeIndex)
+	{
+		static const std::array<std::string, MaxShadowCascadesCount> samplersNames
+		{
+			"DirectionalShadowMapTexture", "DirectionalShadowMapTexture1", "DirectionalShadowMapTexture2", "DirectionalShadowMapTexture3"
+		};
+
+		TDE2_ASSERT(cascadeIndex < MaxShadowCascadesCount);
+		return samplersNames[std::min<U32>(cascadeIndex, MaxShadowCascadesCount - 1)];
+	}
+}
@@ -3,55 +3,249 @@
 #include "../../include/platform/IOStreams.h"
 #include "../../include/core/IFile.h"
 #include "../../include/core/IFileSystem.h"
+#include "../../include/core/IJobManager.h"
 #include "../../include/utils/CFileLogger.h"
 #define DEFER_IMPLEMENTATION
 #include "deferOperation.hpp"
 #include <algorithm>
+#include <atomic>
 #include "stringUtils.hpp"
 #include "zlib.h"
 
+#if defined(TDE2_USE_UNIXPLATFORM)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 
 namespace TDEngine2
 {
+	TDE2_API std::vector<TPackageTableOfContentsBucket> BuildPackageTableOfContents(const std::vector<TPackageFileEntryInfo>& filesTable)
+	{
+		if (filesTable.empty())
+		{
+			return {};
+		}
+
+		/// \note The load factor is kept below 0.5, so probe sequences stay short
+		U32 bucketsCount = 1;
+		while (bucketsCount < 2 * filesTable.size())
+		{
+			bucketsCount <<= 1;
+		}
+
+		std::vector<TPackageTableOfContentsBucket> buckets(bucketsCount);
+
+		for (U32 i = 0; i < static_cast<U32>(filesTable.size()); ++i)
+		{
+			const U32 nameHash = ComputeHash(filesTable[i].mFilename.c_str());
+
+			U32 bucketIndex = nameHash & (bucketsCount - 1);
+			while (TPackageTableOfContentsBucket::mInvalidEntryIndex != buckets[bucketIndex].mEntryIndex)
+			{
+				bucketIndex = (bucketIndex + 1) & (bucketsCount - 1);
+			}
+
+			buckets[bucketIndex].mNameHash = nameHash;
+			buckets[bucketIndex].mEntryIndex = i;
+		}
+
+		return buckets;
+	}
+
+
+	TDE2_API U32 FindPackageFileEntryIndex(const std::vector<TPackageTableOfContentsBucket>& tableOfContents, const std::vector<TPackageFileEntryInfo>& filesTable,
+										   const std::string& path)
+	{
+		const U32 bucketsCount = static_cast<U32>(tableOfContents.size());
+		if (!bucketsCount)
+		{
+			return TPackageTableOfContentsBucket::mInvalidEntryIndex;
+		}
+
+		const U32 nameHash = ComputeHash(path.c_str());
+
+		U32 bucketIndex = nameHash & (bucketsCount - 1);
+
+		for (U32 i = 0; i < bucketsCount; ++i)
+		{
+			const TPackageTableOfContentsBucket& currBucket = tableOfContents[bucketIndex];
+			if (TPackageTableOfContentsBucket::mInvalidEntryIndex == currBucket.mEntryIndex)
+			{
+				break;
+			}
+
+			/// \note Names are compared only when hashes match to resolve collisions
+			if ((nameHash == currBucket.mNameHash) && (currBucket.mEntryIndex < filesTable.size()) && (filesTable[currBucket.mEntryIndex].mFilename == path))
+			{
+				return currBucket.mEntryIndex;
+			}
+
+			bucketIndex = (bucketIndex + 1) & (bucketsCount - 1);
+		}
+
+		return TPackageTableOfContentsBucket::mInvalidEntryIndex;
+	}
+
+
+	static bool DecompressPackageFileChunk(E_PACKAGE_ENTRY_CODEC codec, const U8* pSrcData, U64 srcSize, U8* pDestData, U64 destSize)
+	{
+		/// \note Chunks which weren't made smaller by the codec are stored as is
+		if (srcSize == destSize)
+		{
+			memcpy(pDestData, pSrcData, static_cast<USIZE>(srcSize));
+			return true;
+		}
+
+		switch (codec)
+		{
+			case E_PACKAGE_ENTRY_CODEC::ZLIB:
+			{
+				uLongf decompressedSize = static_cast<uLongf>(destSize);
+				return (Z_OK == uncompress(pDestData, &decompressedSize, pSrcData, static_cast<uLong>(srcSize))) && (decompressedSize == destSize);
+			}
+			/// \todo Decompress LZ4 chunks with LZ4_decompress_safe when the library is vendored
+			default:
+				return false;
+		}
+	}
+
+
+	TDE2_API E_RESULT_CODE CompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC codec, const std::vector<U8>& data, U32 chunkSize, std::vector<U8>& output)
+	{
+		/// \todo Compress LZ4 chunks with LZ4_compress_default when the library is vendored
+		if (E_PACKAGE_ENTRY_CODEC::ZLIB != codec || !chunkSize)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		const USIZE chunksCount = (data.size() + chunkSize - 1) / chunkSize;
+
+		std::vector<U64> chunksOffsets(chunksCount + 1);
+
+		output.clear();
+		output.resize(sizeof(U64) * chunksOffsets.size());
+
+		std::vector<U8> compressedChunk;
+
+		for (USIZE i = 0; i < chunksCount; ++i)
+		{
+			chunksOffsets[i] = static_cast<U64>(output.size());
+
+			const U8* pChunkData = data.data() + i * chunkSize;
+			const USIZE chunkDataSize = std::min<USIZE>(chunkSize, data.size() - i * chunkSize);
+
+			uLong compressedChunkSize = compressBound(static_cast<uLong>(chunkDataSize));
+			compressedChunk.resize(static_cast<USIZE>(compressedChunkSize));
+
+			if (Z_OK != compress(compressedChunk.data(), &compressedChunkSize, pChunkData, static_cast<uLong>(chunkDataSize)))
+			{
+				return RC_FAIL;
+			}
+
+			if (compressedChunkSize >= chunkDataSize)
+			{
+				output.insert(output.end(), pChunkData, pChunkData + chunkDataSize);
+				continue;
+			}
+
+			output.insert(output.end(), compressedChunk.begin(), compressedChunk.begin() + compressedChunkSize);
+		}
+
+		chunksOffsets[chunksCount] = static_cast<U64>(output.size());
+
+		for (USIZE i = 0; i < chunksOffsets.size(); ++i)
+		{
+			const U64 offset = SwapBytes(chunksOffsets[i]);
+			memcpy(&output[i * sizeof(U64)], &offset, sizeof(U64));
+		}
+
+		return RC_OK;
+	}
+
+
+	TDE2_API E_RESULT_CODE DecompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC codec, const U64* pChunksOffsets, USIZE chunksCount, const U8* pChunksData, U32 chunkSize, 
+													   U8* pDestData, USIZE destSize, IJobManager* pJobManager)
+	{
+		if (!pChunksOffsets || !pChunksData || !pDestData || !chunksCount || !chunkSize || (destSize > chunksCount * chunkSize) || (destSize <= (chunksCount - 1) * chunkSize))
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		std::atomic<bool> hasErrors { false };
+
+		auto decompressChunksRange = [&](USIZE first, USIZE last)
+		{
+			for (USIZE i = first; i < last; ++i)
+			{
+				const USIZE destOffset = i * chunkSize;
+
+				if ((pChunksOffsets[i + 1] < pChunksOffsets[i]) ||
+					!DecompressPackageFileChunk(codec, pChunksData + (pChunksOffsets[i] - pChunksOffsets[0]), pChunksOffsets[i + 1] - pChunksOffsets[i],
+												pDestData + destOffset, std::min<USIZE>(chunkSize, destSize - destOffset)))
+				{
+					hasErrors = true;
+				}
+			}
+		};
+
+		/// \note Chunks are independent, so they're decompressed in parallel
+		if (pJobManager && (chunksCount > 1))
+		{
+			pJobManager->ParallelFor(chunksCount, chunkSize, decompressChunksRange);
+		}
+		else
+		{
+			decompressChunksRange(0, chunksCount);
+		}
+
+		return hasErrors ? RC_FAIL : RC_OK;
+	}
+
+
 	/*!
 		\brief CPackageFileReader's definition
 	*/
 
 	CPackageFileReader::CPackageFileReader() :
-		CBinaryFileReader()
+		CBinaryFileReader(), mpMappedData(nullptr), mMappedDataSize(0), mPackageVersion(0)
 	{
 	}
 
 	std::vector<U8> CPackageFileReader::ReadFileBytes(const std::string& path)
 	{
-		auto iter = std::find_if(mFilesTable.cbegin(), mFilesTable.cend(), [path](auto&& entry) { return entry.mFilename == path; });
-		if (iter == mFilesTable.cend())
+		const TPackageFileEntryInfo* pEntry = _findFileEntry(path);
+		if (!pEntry)
 		{
 			return {};
 		}
 
+		if (pEntry->mIsCompressed && pEntry->mChunkSize)
+		{
+			return _decompressChunks(*pEntry, 0, (pEntry->mDataBlockSize + pEntry->mChunkSize - 1) / pEntry->mChunkSize);
+		}
+
+		const USIZE blockSize = pEntry->mIsCompressed ? static_cast<USIZE>(pEntry->mCompressedBlockSize) : static_cast<USIZE>(pEntry->mDataBlockSize);
+
 		std::vector<U8> dataBuffer;
-		dataBuffer.resize(iter->mIsCompressed ? static_cast<USIZE>(iter->mCompressedBlockSize) : static_cast<USIZE>(iter->mDataBlockSize));
 
-		TPtr<IInputStream> pStream = DynamicPtrCast<IInputStream>(mpStreamImpl);
-		
-		TSizeType prevPosition = pStream->GetPosition();
+		const U8* pBlockData = _getEntryBlockData(*pEntry, 0, blockSize, dataBuffer); /// \note Compressed data is inflated directly from the mapped package
+		if (!pBlockData)
 		{
-			pStream->SetPosition(static_cast<TSizeType>(iter->mDataBlockOffset));
-			pStream->Read(&dataBuffer[0], dataBuffer.size() * sizeof(U8));
+			return {};
 		}
 
-		pStream->SetPosition(prevPosition);
-
 		/// \note Make decompression if the file was archived previously
-		if (iter->mIsCompressed)
+		if (pEntry->mIsCompressed)
 		{
 			std::vector<U8> decompressedBufferBlock;
-			decompressedBufferBlock.resize(static_cast<USIZE>(iter->mDataBlockSize));
+			decompressedBufferBlock.resize(static_cast<USIZE>(pEntry->mDataBlockSize));
 
-			uLongf decompressedDataSize = static_cast<uLongf>(iter->mDataBlockSize);
+			uLongf decompressedDataSize = static_cast<uLongf>(pEntry->mDataBlockSize);
 
-			if (Z_OK != uncompress(&decompressedBufferBlock.front(), &decompressedDataSize, &dataBuffer.front(), static_cast<uLong>(iter->mCompressedBlockSize)))
+			if (Z_OK != uncompress(&decompressedBufferBlock.front(), &decompressedDataSize, pBlockData, static_cast<uLong>(pEntry->mCompressedBlockSize)))
 			{
 				return {};
 			}
@@ -59,9 +253,82 @@ namespace TDEngine2
 			return std::move(decompressedBufferBlock);
 		}
 
+		if (dataBuffer.empty())
+		{
+			dataBuffer.assign(pBlockData, pBlockData + blockSize);
+		}
+
 		return std::move(dataBuffer);
 	}
 
+	std::vector<U8> CPackageFileReader::ReadFileRange(const std::string& path, U64 offset, U64 size)
+	{
+		const TPackageFileEntryInfo* pEntry = _findFileEntry(path);
+		if (!pEntry || (offset >= pEntry->mDataBlockSize))
+		{
+			return {};
+		}
+
+		size = std::min<U64>(size, pEntry->mDataBlockSize - offset);
+		if (!size)
+		{
+			return {};
+		}
+
+		if (!pEntry->mIsCompressed)
+		{
+			std::vector<U8> dataBuffer;
+
+			const U8* pData = _getEntryBlockData(*pEntry, offset, size, dataBuffer);
+			if (!pData)
+			{
+				return {};
+			}
+
+			if (dataBuffer.empty())
+			{
+				dataBuffer.assign(pData, pData + size);
+			}
+
+			return std::move(dataBuffer);
+		}
+
+		/// \note Files of old packages are compressed as a whole, so there is no way to decompress only a part of them
+		if (!pEntry->mChunkSize)
+		{
+			std::vector<U8> fileData = ReadFileBytes(path);
+			if (fileData.size() < offset + size)
+			{
+				return {};
+			}
+
+			return std::vector<U8>(fileData.begin() + static_cast<USIZE>(offset), fileData.begin() + static_cast<USIZE>(offset + size));
+		}
+
+		const U64 firstChunkIndex = offset / pEntry->mChunkSize;
+		const U64 lastChunkIndex = (offset + size - 1) / pEntry->mChunkSize + 1;
+
+		std::vector<U8> chunksData = _decompressChunks(*pEntry, firstChunkIndex, lastChunkIndex);
+		if (chunksData.empty())
+		{
+			return {};
+		}
+
+		const USIZE localOffset = static_cast<USIZE>(offset - firstChunkIndex * pEntry->mChunkSize);
+		return std::vector<U8>(chunksData.begin() + localOffset, chunksData.begin() + localOffset + static_cast<USIZE>(size));
+	}
+
+	TPackageFileDataView CPackageFileReader::GetFileDataView(const std::string& path) const
+	{
+		const TPackageFileEntryInfo* pEntry = _findFileEntry(path);
+		if (!pEntry || pEntry->mIsCompressed || !mpMappedData || (pEntry->mDataBlockOffset + pEntry->mDataBlockSize > mMappedDataSize))
+		{
+			return {};
+		}
+
+		return { mpMappedData + pEntry->mDataBlockOffset, static_cast<USIZE>(pEntry->mDataBlockSize) };
+	}
+
 	const TPackageFileHeader& CPackageFileReader::GetPackageHeader() const
 	{
 		return mCurrHeader;
@@ -76,10 +343,22 @@ namespace TDEngine2
 	{
 		E_RESULT_CODE result = _readPackageHeader();
 		result = result | _readFilesTableDescription();
+		result = result | _readTableOfContents();
+
+		if (RC_OK != _mapPackageFile())
+		{
+			LOG_WARNING(Wrench::StringUtils::Format("[CPackageFileReader] The package ({0}) couldn't be mapped into memory, its files will be read through the stream", mpStreamImpl->GetName()));
+		}
 
 		return RC_OK;
 	}
 
+	E_RESULT_CODE CPackageFileReader::_onFree()
+	{
+		_unmapPackageFile();
+		return CBinaryFileReader::_onFree();
+	}
+
 	E_RESULT_CODE CPackageFileReader::_readPackageHeader()
 	{
 		TPtr<IInputStream> pStream = DynamicPtrCast<IInputStream>(mpStreamImpl);
@@ -94,8 +373,9 @@ namespace TDEngine2
 		result = result | pStream->Read(&padding, sizeof(padding));
 
 		version = SwapBytes(version);
+		mPackageVersion = version;
 
-		if (strcmp(tag, TPackageFileHeader::mTag) != 0 || version != TPackageFileHeader::mVersion)
+		if (strcmp(tag, TPackageFileHeader::mTag) != 0 || version < TPackageFileHeader::mMinSupportedVersion || version > TPackageFileHeader::mVersion)
 		{
 			LOG_ERROR(Wrench::StringUtils::Format("[CPackageFileReader] Invalid package was found at ({0}", pStream->GetName()));
 			TDE2_ASSERT(false);
@@ -112,6 +392,17 @@ namespace TDEngine2
 		result = result | pStream->Read(&mCurrHeader.mFilesTableSize, sizeof(mCurrHeader.mFilesTableSize));
 		mCurrHeader.mFilesTableSize = SwapBytes(mCurrHeader.mFilesTableSize);
 
+		if (version < TPackageFileHeader::mTableOfContentsVersion)
+		{
+			return result;
+		}
+
+		result = result | pStream->Read(&mCurrHeader.mTableOfContentsOffset, sizeof(mCurrHeader.mTableOfContentsOffset));
+		mCurrHeader.mTableOfContentsOffset = SwapBytes(mCurrHeader.mTableOfContentsOffset);
+
+		result = result | pStream->Read(&mCurrHeader.mTableOfContentsBucketsCount, sizeof(mCurrHeader.mTableOfContentsBucketsCount));
+		mCurrHeader.mTableOfContentsBucketsCount = SwapBytes(mCurrHeader.mTableOfContentsBucketsCount);
+
 		return result;
 	}
 
@@ -142,12 +433,233 @@ namespace TDEngine2
 
 			result = result | pStream->Read(&info.mIsCompressed, sizeof(info.mIsCompressed));
 
+			info.mCodec = info.mIsCompressed ? E_PACKAGE_ENTRY_CODEC::ZLIB : E_PACKAGE_ENTRY_CODEC::NONE;
+			info.mChunkSize = 0;
+
+			if (mPackageVersion >= TPackageFileHeader::mChunkedEntriesVersion)
+			{
+				result = result | pStream->Read(&info.mCodec, sizeof(info.mCodec));
+
+				result = result | pStream->Read(&info.mChunkSize, sizeof(info.mChunkSize));
+				info.mChunkSize = SwapBytes(info.mChunkSize);
+			}
+
 			mFilesTable.push_back(info);
 		}
 
 		return result;
 	}
 
+	E_RESULT_CODE CPackageFileReader::_readTableOfContents()
+	{
+		const U32 bucketsCount = mCurrHeader.mTableOfContentsBucketsCount;
+
+		/// \note Old packages don't store the table, so it's built in memory
+		if (!bucketsCount || (bucketsCount & (bucketsCount - 1)))
+		{
+			mTableOfContents = BuildPackageTableOfContents(mFilesTable);
+			return RC_OK;
+		}
+
+		TPtr<IInputStream> pStream = DynamicPtrCast<IInputStream>(mpStreamImpl);
+
+		E_RESULT_CODE result = pStream->SetPosition(static_cast<TSizeType>(mCurrHeader.mTableOfContentsOffset));
+
+		mTableOfContents.resize(bucketsCount);
+		result = result | pStream->Read(mTableOfContents.data(), sizeof(TPackageTableOfContentsBucket) * bucketsCount);
+
+		for (TPackageTableOfContentsBucket& currBucket : mTableOfContents)
+		{
+			currBucket.mNameHash = SwapBytes(currBucket.mNameHash);
+			currBucket.mEntryIndex = SwapBytes(currBucket.mEntryIndex);
+		}
+
+		return result;
+	}
+
+	const TPackageFileEntryInfo* CPackageFileReader::_findFileEntry(const std::string& path) const
+	{
+		const U32 entryIndex = FindPackageFileEntryIndex(mTableOfContents, mFilesTable, path);
+		return (TPackageTableOfContentsBucket::mInvalidEntryIndex == entryIndex) ? nullptr : &mFilesTable[entryIndex];
+	}
+
+	const U8* CPackageFileReader::_getEntryBlockData(const TPackageFileEntryInfo& entry, U64 offset, U64 size, std::vector<U8>& buffer)
+	{
+		const U64 absoluteOffset = entry.mDataBlockOffset + offset;
+
+		if (mpMappedData)
+		{
+			return (absoluteOffset + size <= mMappedDataSize) ? (mpMappedData + absoluteOffset) : nullptr;
+		}
+
+		buffer.resize(static_cast<USIZE>(size));
+		if (buffer.empty())
+		{
+			return nullptr;
+		}
+
+		TPtr<IInputStream> pStream = DynamicPtrCast<IInputStream>(mpStreamImpl);
+
+		const TSizeType prevPosition = pStream->GetPosition();
+
+		E_RESULT_CODE result = pStream->SetPosition(static_cast<TSizeType>(absoluteOffset));
+		result = result | pStream->Read(buffer.data(), buffer.size());
+
+		pStream->SetPosition(prevPosition);
+
+		return (RC_OK == result) ? buffer.data() : nullptr;
+	}
+
+	std::vector<U8> CPackageFileReader::_decompressChunks(const TPackageFileEntryInfo& entry, U64 firstChunkIndex, U64 lastChunkIndex)
+	{
+		const U64 chunkSize = entry.mChunkSize;
+		const U64 chunksCount = (entry.mDataBlockSize + chunkSize - 1) / chunkSize;
+
+		if ((firstChunkIndex >= lastChunkIndex) || (lastChunkIndex > chunksCount))
+		{
+			return {};
+		}
+
+		/// \note Only offsets of requested chunks and the next one are read from the block's table
+		std::vector<U8> offsetsBuffer;
+
+		const U8* pOffsetsData = _getEntryBlockData(entry, firstChunkIndex * sizeof(U64), (lastChunkIndex - firstChunkIndex + 1) * sizeof(U64), offsetsBuffer);
+		if (!pOffsetsData)
+		{
+			return {};
+		}
+
+		std::vector<U64> chunksOffsets(static_cast<USIZE>(lastChunkIndex - firstChunkIndex + 1));
+		memcpy(chunksOffsets.data(), pOffsetsData, sizeof(U64) * chunksOffsets.size());
+
+		for (U64& currOffset : chunksOffsets)
+		{
+			currOffset = SwapBytes(currOffset);
+		}
+
+		if (!std::is_sorted(chunksOffsets.cbegin(), chunksOffsets.cend()) || (chunksOffsets.back() > entry.mCompressedBlockSize))
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[CPackageFileReader] Chunks of ({0}) are corrupted", entry.mFilename));
+			return {};
+		}
+
+		std::vector<U8> compressedDataBuffer;
+
+		const U8* pCompressedData = _getEntryBlockData(entry, chunksOffsets.front(), chunksOffsets.back() - chunksOffsets.front(), compressedDataBuffer);
+		if (!pCompressedData)
+		{
+			return {};
+		}
+
+		const U64 firstByteOffset = firstChunkIndex * chunkSize;
+		std::vector<U8> decompressedData(static_cast<USIZE>(std::min<U64>(lastChunkIndex * chunkSize, entry.mDataBlockSize) - firstByteOffset));
+
+		IJobManager* pJobManager = mpStorage ? mpStorage->GetFileSystem()->GetJobManager() : nullptr;
+
+		if (RC_OK != DecompressPackageFileChunks(entry.mCodec, chunksOffsets.data(), static_cast<USIZE>(lastChunkIndex - firstChunkIndex), pCompressedData, entry.mChunkSize,
+												 decompressedData.data(), decompressedData.size(), pJobManager))
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[CPackageFileReader] Couldn't decompress ({0})", entry.mFilename));
+			return {};
+		}
+
+		return std::move(decompressedData);
+	}
+
+	E_RESULT_CODE CPackageFileReader::_mapPackageFile()
+	{
+		/// \note Only packages that are stored as physical files could be mapped
+		if (!DynamicPtrCast<CFileInputStream>(mpStreamImpl))
+		{
+			return RC_FAIL;
+		}
+
+		const std::string& path = mpStreamImpl->GetName();
+
+#if defined(TDE2_USE_WINPLATFORM)
+		HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (INVALID_HANDLE_VALUE == fileHandle)
+		{
+			return RC_FILE_NOT_FOUND;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(fileHandle, &fileSize) || !fileSize.QuadPart)
+		{
+			CloseHandle(fileHandle);
+			return RC_FAIL;
+		}
+
+		HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(fileHandle);
+
+		if (!mappingHandle)
+		{
+			return RC_FAIL;
+		}
+
+		/// \note The view keeps the mapping alive, so handles aren't needed anymore
+		void* pMappedData = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mappingHandle);
+
+		if (!pMappedData)
+		{
+			return RC_FAIL;
+		}
+
+		mpMappedData = static_cast<const U8*>(pMappedData);
+		mMappedDataSize = static_cast<USIZE>(fileSize.QuadPart);
+
+		return RC_OK;
+#elif defined(TDE2_USE_UNIXPLATFORM)
+		const I32 fileDescriptor = open(path.c_str(), O_RDONLY);
+		if (fileDescriptor < 0)
+		{
+			return RC_FILE_NOT_FOUND;
+		}
+
+		struct stat fileStats;
+		if ((fstat(fileDescriptor, &fileStats) < 0) || !fileStats.st_size)
+		{
+			close(fileDescriptor);
+			return RC_FAIL;
+		}
+
+		/// \note The mapping stays valid after the descriptor is closed
+		void* pMappedData = mmap(nullptr, static_cast<size_t>(fileStats.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		close(fileDescriptor);
+
+		if (MAP_FAILED == pMappedData)
+		{
+			return RC_FAIL;
+		}
+
+		mpMappedData = static_cast<const U8*>(pMappedData);
+		mMappedDataSize = static_cast<USIZE>(fileStats.st_size);
+
+		return RC_OK;
+#else
+		return RC_NOT_IMPLEMENTED_YET;
+#endif
+	}
+
+	void CPackageFileReader::_unmapPackageFile()
+	{
+		if (!mpMappedData)
+		{
+			return;
+		}
+
+#if defined(TDE2_USE_WINPLATFORM)
+		UnmapViewOfFile(mpMappedData);
+#elif defined(TDE2_USE_UNIXPLATFORM)
+		munmap(const_cast<U8*>(mpMappedData), mMappedDataSize);
+#endif
+
+		mpMappedData = nullptr;
+		mMappedDataSize = 0;
+	}
+
 
 	IFile* CreatePackageFileReader(IMountableStorage* pStorage, TPtr<IStream> pStream, E_RESULT_CODE& result)
 	{
@@ -184,18 +696,19 @@ namespace TDEngine2
 
 	E_RESULT_CODE CPackageFileWriter::_onInit()
 	{
-		return mpStreamImpl->SetPosition(sizeof(TPackageFileHeader));
+		return mpStreamImpl->SetPosition(PackageFileHeaderSize);
 	}
 
 	E_RESULT_CODE CPackageFileWriter::_onFree()
 	{
 		E_RESULT_CODE result = _writeFilesTableDescription();
+		result = result | _writeTableOfContents();
 		result = result | _writePackageHeader();
 
 		return result;
 	}
 
-	E_RESULT_CODE CPackageFileWriter::_writeFileInternal(TypeId fileTypeId, const std::string& path, const IFileReader& file, bool useCompression)
+	E_RESULT_CODE CPackageFileWriter::_writeFileInternal(TypeId fileTypeId, const std::string& path, const IFileReader& file, E_PACKAGE_ENTRY_CODEC codec)
 	{
 		if (CPackageFileWriter::GetTypeId() == fileTypeId || CPackageFileReader::GetTypeId() == fileTypeId)
 		{
@@ -233,24 +746,22 @@ namespace TDEngine2
 				return result;
 			}
 
-			/// \note Compresss data if useCompression equals to true
-			if (useCompression)
+			/// \note Compress data by chunks, so readers could decompress only a part of the file
+			if (E_PACKAGE_ENTRY_CODEC::NONE != codec)
 			{
-				uLong compressedDataBlockSize = compressBound(static_cast<uLong>(buffer.size()));
-
 				std::vector<U8> compressedDataBuffer;
-				compressedDataBuffer.resize(static_cast<USIZE>(compressedDataBlockSize));
-				
-				if (Z_OK != compress(&compressedDataBuffer.front(), &compressedDataBlockSize, &buffer.front(), static_cast<uLong>(fileInfo.mDataBlockSize)))
+
+				if (RC_OK != (result = CompressPackageFileChunks(codec, buffer, PackageFileChunkSize, compressedDataBuffer)))
 				{
-					return RC_FAIL;
+					return result;
 				}
 
-				buffer.resize(static_cast<USIZE>(compressedDataBlockSize));
-				memcpy(&buffer.front(), &compressedDataBuffer.front(), sizeof(U8) * compressedDataBlockSize);
+				buffer = std::move(compressedDataBuffer);
 
-				fileInfo.mCompressedBlockSize = static_cast<U64>(compressedDataBlockSize);
+				fileInfo.mCompressedBlockSize = static_cast<U64>(buffer.size());
 				fileInfo.mIsCompressed = true;
+				fileInfo.mCodec = codec;
+				fileInfo.mChunkSize = PackageFileChunkSize;
 			}
 
 			// Write into the package
@@ -293,6 +804,12 @@ namespace TDEngine2
 		mCurrHeader.mFilesTableSize = SwapBytes(mCurrHeader.mFilesTableSize);
 		result = result | pStream->Write(&mCurrHeader.mFilesTableSize, sizeof(mCurrHeader.mFilesTableSize));
 
+		mCurrHeader.mTableOfContentsOffset = SwapBytes(mCurrHeader.mTableOfContentsOffset);
+		result = result | pStream->Write(&mCurrHeader.mTableOfContentsOffset, sizeof(mCurrHeader.mTableOfContentsOffset));
+
+		mCurrHeader.mTableOfContentsBucketsCount = SwapBytes(mCurrHeader.mTableOfContentsBucketsCount);
+		result = result | pStream->Write(&mCurrHeader.mTableOfContentsBucketsCount, sizeof(mCurrHeader.mTableOfContentsBucketsCount));
+
 		pStream->SetPosition(prevPosition);
 
 		return result;
@@ -323,6 +840,10 @@ namespace TDEngine2
 			result = result | pStream->Write(&currFileEntryInfo.mCompressedBlockSize, sizeof(currFileEntryInfo.mCompressedBlockSize));
 
 			result = result | pStream->Write(&currFileEntryInfo.mIsCompressed, sizeof(currFileEntryInfo.mIsCompressed));
+			result = result | pStream->Write(&currFileEntryInfo.mCodec, sizeof(currFileEntryInfo.mCodec));
+
+			currFileEntryInfo.mChunkSize = SwapBytes(currFileEntryInfo.mChunkSize);
+			result = result | pStream->Write(&currFileEntryInfo.mChunkSize, sizeof(currFileEntryInfo.mChunkSize));
 		}
 
 		mCurrHeader.mFilesTableSize = std::max<U64>(0, static_cast<U64>(pStream->GetPosition()) - mCurrHeader.mFilesTableOffset);
@@ -331,6 +852,29 @@ namespace TDEngine2
 		return result;
 	}
 
+	E_RESULT_CODE CPackageFileWriter::_writeTableOfContents()
+	{
+		auto pStream = DynamicPtrCast<IOutputStream>(mpStreamImpl);
+
+		std::vector<TPackageTableOfContentsBucket> tableOfContents = BuildPackageTableOfContents(mFilesTable); /// \note Only names are used, so the table could be built after entries were written
+
+		mCurrHeader.mTableOfContentsOffset = pStream->GetPosition();
+		mCurrHeader.mTableOfContentsBucketsCount = static_cast<U32>(tableOfContents.size());
+
+		E_RESULT_CODE result = RC_OK;
+
+		for (TPackageTableOfContentsBucket& currBucket : tableOfContents)
+		{
+			currBucket.mNameHash = SwapBytes(currBucket.mNameHash);
+			result = result | pStream->Write(&currBucket.mNameHash, sizeof(currBucket.mNameHash));
+
+			currBucket.mEntryIndex = SwapBytes(currBucket.mEntryIndex);
+			result = result | pStream->Write(&currBucket.mEntryIndex, sizeof(currBucket.mEntryIndex));
+		}
+
+		return result;
+	}
+
 
 	IFile* CreatePackageFileWriter(IMountableStorage* pStorage, TPtr<IStream> pStream, E_RESULT_CODE& result)
 	{
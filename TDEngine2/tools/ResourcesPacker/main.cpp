@@ -26,6 +26,11 @@
 	Beginning from 0.5.x version of the engine the packages support compressed files storage. The compression
 	is implemented via zlib library
 
+	Since 0x300 version of the format compressed files are split into chunks of 64 KiB which are
+	compressed independently, so the engine can decode them in parallel or read only a part of a file.
+	A codec is chosen with --codec option, --benchmark reads the package through the engine's
+	IPackageFileReader and prints reading throughput with sequential and parallel decoding of chunks
+
 	\todo Implement endian independent file IO operations
 */
 
@@ -0,0 +1,134 @@
+#include "packageBenchmark.h"
+#include <TDEngine2.h>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+
+namespace TDEngine2
+{
+	static std::vector<U8> ReadSourceFile(const std::string& path)
+	{
+		std::ifstream sourceFile{ path, std::ios::binary };
+		return std::vector<U8>(std::istreambuf_iterator<C8>(sourceFile), std::istreambuf_iterator<C8>());
+	}
+
+
+	static bool ReadPackageFiles(IPackageFileReader* pPackageReader, const std::vector<std::vector<U8>>& sourcesData, F64& readSeconds)
+	{
+		const std::vector<TPackageFileEntryInfo>& filesTable = pPackageReader->GetFilesTable();
+
+		std::chrono::high_resolution_clock::duration readTime { 0 };
+
+		for (USIZE i = 0; i < filesTable.size(); ++i)
+		{
+			const auto readStartTime = std::chrono::high_resolution_clock::now();
+			const std::vector<U8> fileData = pPackageReader->ReadFileBytes(filesTable[i].mFilename);
+			readTime += std::chrono::high_resolution_clock::now() - readStartTime;
+
+			if (fileData != sourcesData[i])
+			{
+				std::cerr << "Error: Read data mismatches the original one: " << filesTable[i].mFilename << std::endl;
+				return false;
+			}
+		}
+
+		readSeconds = std::chrono::duration<F64>(readTime).count();
+
+		return true;
+	}
+
+
+	static void PrintThroughput(const std::string& passName, F64 megabytes, F64 seconds)
+	{
+		std::cout << passName << ": " << megabytes << " MB in " << seconds << " s";
+
+		if (seconds > 0.0)
+		{
+			std::cout << " (" << megabytes / seconds << " MB/s)";
+		}
+
+		std::cout << std::endl;
+	}
+
+
+	bool RunPackageReadingBenchmark(const std::string& packagePath)
+	{
+		E_RESULT_CODE result = RC_OK;
+
+#if defined (TDE2_USE_WINPLATFORM)
+		TPtr<IFileSystem> pFileSystem = TPtr<IFileSystem>(CreateWin32FileSystem(result));
+#elif defined (TDE2_USE_UNIXPLATFORM)
+		TPtr<IFileSystem> pFileSystem = TPtr<IFileSystem>(CreateUnixFileSystem(result));
+#else
+		TPtr<IFileSystem> pFileSystem = nullptr;
+#endif
+
+		if (!pFileSystem || RC_OK != result)
+		{
+			std::cerr << "Error: Couldn't create the engine's file system" << std::endl;
+			return false;
+		}
+
+		if (RC_OK != pFileSystem->RegisterFileFactory<IPackageFileReader>({ CreatePackageFileReader, E_FILE_FACTORY_TYPE::READER }))
+		{
+			return false;
+		}
+
+		TJobManagerInitParams jobManagerParams;
+		jobManagerParams.mMaxNumOfThreads = std::max<U32>(2, std::thread::hardware_concurrency()) - 1;
+
+		TPtr<IJobManager> pJobManager = TPtr<IJobManager>(CreateBaseJobManager(jobManagerParams, result));
+		if (!pJobManager || RC_OK != result)
+		{
+			std::cerr << "Error: Couldn't create the engine's job manager" << std::endl;
+			return false;
+		}
+
+		auto openPackageResult = pFileSystem->Open<IPackageFileReader>(packagePath);
+		if (openPackageResult.HasError())
+		{
+			std::cerr << "Error: Couldn't open the package: " << packagePath << std::endl;
+			return false;
+		}
+
+		IPackageFileReader* pPackageReader = pFileSystem->Get<IPackageFileReader>(openPackageResult.Get());
+
+		/// \note Sources are loaded beforehand, so only reads of the package are measured
+		std::vector<std::vector<U8>> sourcesData;
+		USIZE totalSize = 0;
+
+		for (const TPackageFileEntryInfo& currEntry : pPackageReader->GetFilesTable())
+		{
+			sourcesData.emplace_back(ReadSourceFile(currEntry.mFilename));
+			totalSize += sourcesData.back().size();
+		}
+
+		const F64 totalMegabytes = static_cast<F64>(totalSize) / (1024.0 * 1024.0);
+
+		F64 sequentialReadSeconds = 0.0;
+		F64 parallelReadSeconds = 0.0;
+
+		/// \note The reader takes the job manager from the file system on each read, so chunks are decoded sequentially without it
+		pFileSystem->SetJobManager(nullptr);
+		bool isBenchmarkPassed = ReadPackageFiles(pPackageReader, sourcesData, sequentialReadSeconds);
+
+		pFileSystem->SetJobManager(pJobManager.Get());
+		isBenchmarkPassed = isBenchmarkPassed && ReadPackageFiles(pPackageReader, sourcesData, parallelReadSeconds);
+
+		pFileSystem->SetJobManager(nullptr);
+		pPackageReader->Close();
+
+		if (!isBenchmarkPassed)
+		{
+			return false;
+		}
+
+		PrintThroughput("Sequential reading", totalMegabytes, sequentialReadSeconds);
+		PrintThroughput("Parallel reading (" + std::to_string(jobManagerParams.mMaxNumOfThreads) + " worker threads)", totalMegabytes, parallelReadSeconds);
+
+		return true;
+	}
+}
@@ -0,0 +1,30 @@
+/*!
+	\file packageBenchmark.h
+	\date 17.10.2026
+	\author Ildar Kasimov
+
+	\brief The file is separated from resourcePacker.h, because the utility declares its own
+	types of the package's format which have the same names as the engine's ones
+*/
+
+#pragma once
+
+
+#include <string>
+
+
+namespace TDEngine2
+{
+	/*!
+		\brief The function opens a package through the engine's file system and reads all its files with
+		IPackageFileReader::ReadFileBytes twice, without a job manager and with it, so compressed chunks are
+		decoded sequentially and in parallel. Read data is checked against source files whose paths are
+		the names of package's entries. Throughput of both passes is printed into the standard output
+
+		\param[in] packagePath A path to a package which is written by the utility
+
+		\return True if all files were read and match their sources, false in other cases
+	*/
+
+	bool RunPackageReadingBenchmark(const std::string& packagePath);
+}
@@ -1,9 +1,11 @@
 #include "resourcePacker.h"
+#include "packageBenchmark.h"
 #include "deps/argparse/argparse.h"
 #include "../../deps/zlib/zlib.h"
 #include <unordered_set>
 #include <iostream>
 #include <fstream>
+#include <cstring>
 
 #if _HAS_CXX17
 	#include <filesystem>
@@ -26,6 +28,102 @@ namespace TDEngine2
 	};
 
 
+	uint32_t ComputeHash(const char* pStr) TDE2_NOEXCEPT
+	{
+		uint32_t hash = 5381;
+
+		while (*pStr)
+		{
+			hash = ((hash << 5) + hash) + *pStr++;
+		}
+
+		return hash;
+	}
+
+
+	std::vector<TPackageTableOfContentsBucket> BuildTableOfContents(const std::vector<TPackageFileEntryInfo>& filesTable) TDE2_NOEXCEPT
+	{
+		if (filesTable.empty())
+		{
+			return {};
+		}
+
+		uint32_t bucketsCount = 1;
+		while (bucketsCount < 2 * filesTable.size())
+		{
+			bucketsCount <<= 1;
+		}
+
+		std::vector<TPackageTableOfContentsBucket> buckets(bucketsCount);
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(filesTable.size()); ++i)
+		{
+			const uint32_t nameHash = ComputeHash(filesTable[i].mFilename.c_str());
+
+			// \note Linear probing, the engine looks up entries in the same way
+			uint32_t bucketIndex = nameHash & (bucketsCount - 1);
+			while (TPackageTableOfContentsBucket::InvalidEntryIndex != buckets[bucketIndex].mEntryIndex)
+			{
+				bucketIndex = (bucketIndex + 1) & (bucketsCount - 1);
+			}
+
+			buckets[bucketIndex].mNameHash = nameHash;
+			buckets[bucketIndex].mEntryIndex = i;
+		}
+
+		return buckets;
+	}
+
+
+	E_ERROR_CODE CompressChunks(E_PACKAGE_ENTRY_CODEC codec, const std::vector<unsigned char>& data, std::vector<unsigned char>& output) TDE2_NOEXCEPT
+	{
+		if (E_PACKAGE_ENTRY_CODEC::ZLIB != codec)
+		{
+			return E_ERROR_CODE::INVALID_ARGS;
+		}
+
+		const size_t chunksCount = (data.size() + PackageFileChunkSize - 1) / PackageFileChunkSize;
+
+		std::vector<uint64_t> chunksOffsets(chunksCount + 1);
+
+		output.clear();
+		output.resize(sizeof(uint64_t) * chunksOffsets.size());
+
+		std::vector<unsigned char> compressedChunk;
+
+		for (size_t i = 0; i < chunksCount; ++i)
+		{
+			chunksOffsets[i] = static_cast<uint64_t>(output.size());
+
+			const unsigned char* pChunkData = data.data() + i * PackageFileChunkSize;
+			const size_t chunkDataSize = std::min<size_t>(PackageFileChunkSize, data.size() - i * PackageFileChunkSize);
+
+			uLong compressedChunkSize = compressBound(static_cast<uLong>(chunkDataSize));
+			compressedChunk.resize(static_cast<size_t>(compressedChunkSize));
+
+			if (Z_OK != compress(compressedChunk.data(), &compressedChunkSize, pChunkData, static_cast<uLong>(chunkDataSize)))
+			{
+				return E_ERROR_CODE::FAIL;
+			}
+
+			// \note The engine treats chunks with the same size as raw ones
+			if (compressedChunkSize >= chunkDataSize)
+			{
+				output.insert(output.end(), pChunkData, pChunkData + chunkDataSize);
+				continue;
+			}
+
+			output.insert(output.end(), compressedChunk.begin(), compressedChunk.begin() + compressedChunkSize);
+		}
+
+		chunksOffsets[chunksCount] = static_cast<uint64_t>(output.size());
+
+		memcpy(output.data(), chunksOffsets.data(), sizeof(uint64_t) * chunksOffsets.size());
+
+		return E_ERROR_CODE::OK;
+	}
+
+
 	Result<TUtilityOptions> ParseOptions(int argc, const char** argv) TDE2_NOEXCEPT
 	{
 		int showVersion = 0;
@@ -36,11 +134,13 @@ namespace TDEngine2
 		int forceMode = 0;
 		int emitFlags = 0;
 		int useCompression = 0;
+		int runDecodeBenchmark = 0;
 
 		const char* pOutputDirectory = nullptr;
 		const char* pOutputFilename = nullptr;
 		const char* pExcludedPathsStr = nullptr;
 		const char* pExcludedTypenamesStr = nullptr;
+		const char* pCodecStr = nullptr;
 
 		const char* pCacheOutputDirectory = nullptr;
 
@@ -51,7 +151,9 @@ namespace TDEngine2
 			OPT_STRING(0, "outdir", &pOutputDirectory, "Write output into specified <dirname>"),
 			OPT_STRING('o', "outfile", &pOutputFilename, "Output file's name <filename>"),
 			OPT_BOOLEAN(0, "quiet", &suppressLogOutput, "Enables suppresion of program's output"),
-			OPT_BOOLEAN(0, "compress", &useCompression, "Enables compression of resources"),
+			OPT_BOOLEAN(0, "compress", &useCompression, "Enables compression of resources, the same as --codec zlib"),
+			OPT_STRING(0, "codec", &pCodecStr, "Compression codec of resources <none|zlib>"),
+			OPT_BOOLEAN(0, "benchmark", &runDecodeBenchmark, "Reads the package through the engine after packing and prints reading throughput"),
 			OPT_END(),
 		};
 
@@ -96,7 +198,28 @@ namespace TDEngine2
 			utilityOptions.mOutputFilename = pOutputFilename;
 		}
 
-		utilityOptions.mCompressFiles = static_cast<bool>(useCompression);
+		utilityOptions.mCodec = useCompression ? E_PACKAGE_ENTRY_CODEC::ZLIB : E_PACKAGE_ENTRY_CODEC::NONE;
+
+		if (pCodecStr)
+		{
+			const std::string codecStr = pCodecStr;
+
+			if ("none" == codecStr)
+			{
+				utilityOptions.mCodec = E_PACKAGE_ENTRY_CODEC::NONE;
+			}
+			else if ("zlib" == codecStr)
+			{
+				utilityOptions.mCodec = E_PACKAGE_ENTRY_CODEC::ZLIB;
+			}
+			else
+			{
+				std::cerr << "Error: unsupported codec " << codecStr << ", available ones are none, zlib\n";
+				return Wrench::TErrValue<E_ERROR_CODE>(E_ERROR_CODE::INVALID_ARGS);
+			}
+		}
+
+		utilityOptions.mRunDecodeBenchmark = static_cast<bool>(runDecodeBenchmark);
 
 		return Wrench::TOkValue<TUtilityOptions>(utilityOptions);
 	}
@@ -162,6 +285,8 @@ namespace TDEngine2
 		packageFile.write(reinterpret_cast<const char*>(&headerData.mEntitiesCount), sizeof(headerData.mEntitiesCount));
 		packageFile.write(reinterpret_cast<const char*>(&headerData.mFilesTableOffset), sizeof(headerData.mFilesTableOffset));
 		packageFile.write(reinterpret_cast<const char*>(&headerData.mFilesTableSize), sizeof(headerData.mFilesTableSize));
+		packageFile.write(reinterpret_cast<const char*>(&headerData.mTableOfContentsOffset), sizeof(headerData.mTableOfContentsOffset));
+		packageFile.write(reinterpret_cast<const char*>(&headerData.mTableOfContentsBucketsCount), sizeof(headerData.mTableOfContentsBucketsCount));
 
 		return E_ERROR_CODE::OK;
 	}
@@ -179,6 +304,20 @@ namespace TDEngine2
 			packageFile.write(reinterpret_cast<char*>(&currFileEntry.mDataBlockSize), sizeof(currFileEntry.mDataBlockSize));
 			packageFile.write(reinterpret_cast<char*>(&currFileEntry.mCompressedBlockSize), sizeof(currFileEntry.mCompressedBlockSize));
 			packageFile.write(reinterpret_cast<char*>(&currFileEntry.mIsCompressed), sizeof(currFileEntry.mIsCompressed));
+			packageFile.write(reinterpret_cast<char*>(&currFileEntry.mCodec), sizeof(currFileEntry.mCodec));
+			packageFile.write(reinterpret_cast<char*>(&currFileEntry.mChunkSize), sizeof(currFileEntry.mChunkSize));
+		}
+
+		return E_ERROR_CODE::OK;
+	}
+
+
+	static E_ERROR_CODE WriteTableOfContents(std::ofstream& packageFile, const std::vector<TPackageTableOfContentsBucket>& tableOfContents) TDE2_NOEXCEPT
+	{
+		for (auto&& currBucket : tableOfContents)
+		{
+			packageFile.write(reinterpret_cast<const char*>(&currBucket.mNameHash), sizeof(currBucket.mNameHash));
+			packageFile.write(reinterpret_cast<const char*>(&currBucket.mEntryIndex), sizeof(currBucket.mEntryIndex));
 		}
 
 		return E_ERROR_CODE::OK;
@@ -232,33 +371,36 @@ namespace TDEngine2
 
 			resourceFile.close();
 
+			const bool isCompressed = (E_PACKAGE_ENTRY_CODEC::NONE != options.mCodec);
+
 			/// \note Compress data
-			uLong compressedDataSize = options.mCompressFiles ? compressBound(static_cast<uLong>(tempDataBuffer.size())) : 0;
-			
-			if (options.mCompressFiles)
+			if (isCompressed)
 			{
-				compressedDataBuffer.resize(compressedDataSize);
-
-				if (Z_OK != compress(&compressedDataBuffer.front(), &compressedDataSize, &tempDataBuffer.front(), static_cast<uLong>(dataSize)))
+				if (E_ERROR_CODE::OK != CompressChunks(options.mCodec, tempDataBuffer, compressedDataBuffer))
 				{
+					std::cerr << "Error: Couldn't compress file: " << currFilePath << std::endl;
 					continue;
 				}
 			}
 
-			filesTable.push_back(TPackageFileEntryInfo
-				{ 
-					currFilePath, 
-					static_cast<uint64_t>(packageFile.tellp()), 
-					static_cast<uint64_t>(dataSize),
-					static_cast<uint64_t>(compressedDataSize),
-					options.mCompressFiles
-				});
+			TPackageFileEntryInfo entryInfo;
+			entryInfo.mFilename = currFilePath;
+			entryInfo.mDataBlockOffset = static_cast<uint64_t>(packageFile.tellp());
+			entryInfo.mDataBlockSize = static_cast<uint64_t>(dataSize);
+			entryInfo.mCompressedBlockSize = isCompressed ? static_cast<uint64_t>(compressedDataBuffer.size()) : 0;
+			entryInfo.mIsCompressed = isCompressed;
+			entryInfo.mCodec = options.mCodec;
+			entryInfo.mChunkSize = isCompressed ? PackageFileChunkSize : 0;
+
+			filesTable.push_back(entryInfo);
 
 			/// \note Actual write data into the package file
-			packageFile.write(reinterpret_cast<char*>(options.mCompressFiles ? compressedDataBuffer.data() : tempDataBuffer.data()), 
-				options.mCompressFiles ? static_cast<size_t>(compressedDataSize) : static_cast<size_t>(dataSize));
+			packageFile.write(reinterpret_cast<char*>(isCompressed ? compressedDataBuffer.data() : tempDataBuffer.data()), 
+				isCompressed ? static_cast<std::streamsize>(compressedDataBuffer.size()) : static_cast<std::streamsize>(dataSize));
 		}
 
+		const std::vector<TPackageTableOfContentsBucket> tableOfContents = BuildTableOfContents(filesTable);
+
 		TPackageFileHeader header;
 		header.mEntitiesCount = static_cast<uint32_t>(filesTable.size());
 		header.mFilesTableOffset = packageFile.tellp();
@@ -271,6 +413,16 @@ namespace TDEngine2
 		}
 
 		header.mFilesTableSize = static_cast<uint64_t>(packageFile.tellp()) - header.mFilesTableOffset;
+
+		// \note The table of contents goes right after the files table
+		header.mTableOfContentsOffset = packageFile.tellp();
+		header.mTableOfContentsBucketsCount = static_cast<uint32_t>(tableOfContents.size());
+
+		if (E_ERROR_CODE::OK != (result = WriteTableOfContents(packageFile, tableOfContents)))
+		{
+			packageFile.close();
+			return result;
+		}
 		
 		packageFile.seekp(0);
 
@@ -283,6 +435,12 @@ namespace TDEngine2
 
 		packageFile.close();
 
+		/// \note The package is read through the engine, so the benchmark measures the same code path that the runtime uses
+		if (options.mRunDecodeBenchmark && !RunPackageReadingBenchmark(fs::path(options.mOutputDirname).append(options.mOutputFilename).string()))
+		{
+			return E_ERROR_CODE::FAIL;
+		}
+
 		return E_ERROR_CODE::OK;
 	}
 }
\ No newline at end of file
@@ -37,10 +37,25 @@ namespace TDEngine2
 	static struct TVersion
 	{
 		const uint32_t mMajor = 0;
-		const uint32_t mMinor = 1;
+		const uint32_t mMinor = 3;
 	} ToolVersion;
 
 
+	/*!
+		\brief The values should be the same as E_PACKAGE_ENTRY_CODEC's ones within the engine. Only zlib is
+		vendored within the engine's dependencies, so there are no other codecs for now
+	*/
+
+	enum class E_PACKAGE_ENTRY_CODEC : uint8_t
+	{
+		NONE,
+		ZLIB,
+	};
+
+
+	constexpr uint32_t PackageFileChunkSize = 64 * 1024;
+
+
 	struct TUtilityOptions
 	{
 		std::vector<std::string> mInputFiles;
@@ -48,7 +63,9 @@ namespace TDEngine2
 		std::string mOutputDirname = ".";
 		std::string mOutputFilename = "NewArchive.pak";
 
-		bool mCompressFiles = false;
+		E_PACKAGE_ENTRY_CODEC mCodec = E_PACKAGE_ENTRY_CODEC::NONE;
+
+		bool mRunDecodeBenchmark = false;
 	};
 
 
@@ -58,15 +75,32 @@ namespace TDEngine2
 	{
 		const char mTag[4]{ "PAK" };
 
-		const uint16_t mVersion = 0x100;
+		const uint16_t mVersion = 0x300;
 		const uint16_t mPadding = 0x0;
 
 		uint32_t mEntitiesCount = 0;
 
 		uint64_t mFilesTableOffset = 0;
 		uint64_t mFilesTableSize = 0;
+
+		uint64_t mTableOfContentsOffset = 0;
+		uint32_t mTableOfContentsBucketsCount = 0;
 	} TPackageFileHeader, *TPackageFileHeaderPtr;
 
+
+	/*!
+		\brief A bucket of the hashed table of contents, empty ones have mEntryIndex equal to InvalidEntryIndex.
+		The layout should be the same as TPackageTableOfContentsBucket within the engine
+	*/
+
+	typedef struct TPackageTableOfContentsBucket
+	{
+		static constexpr uint32_t InvalidEntryIndex = 0xFFFFFFFF;
+
+		uint32_t mNameHash = 0;
+		uint32_t mEntryIndex = InvalidEntryIndex;
+	} TPackageTableOfContentsBucket, *TPackageTableOfContentsBucketPtr;
+
 #pragma pack(pop)
 
 
@@ -78,9 +112,27 @@ namespace TDEngine2
 		uint64_t mDataBlockSize = 0;
 		uint64_t mCompressedBlockSize = 0;
 		bool     mIsCompressed = false;
+
+		E_PACKAGE_ENTRY_CODEC mCodec = E_PACKAGE_ENTRY_CODEC::NONE;
+		uint32_t mChunkSize = 0;
 	} TPackageFileEntryInfo, *TPackageFileEntryInfoPtr;
 
 
+	/*!
+		\brief The function should produce the same values as TDEngine2::ComputeHash does
+	*/
+
+	uint32_t ComputeHash(const char* pStr) TDE2_NOEXCEPT;
+
+	std::vector<TPackageTableOfContentsBucket> BuildTableOfContents(const std::vector<TPackageFileEntryInfo>& filesTable) TDE2_NOEXCEPT;
+
+	/*!
+		\brief The function splits data into chunks of PackageFileChunkSize bytes and compresses each of them independently.
+		The output begins with (ChunksCount + 1) offsets of chunks, chunks that couldn't be made smaller are stored as is
+	*/
+
+	E_ERROR_CODE CompressChunks(E_PACKAGE_ENTRY_CODEC codec, const std::vector<unsigned char>& data, std::vector<unsigned char>& output) TDE2_NOEXCEPT;
+
 	Result<TUtilityOptions> ParseOptions(int argc, const char** argv) TDE2_NOEXCEPT;
 
 	std::vector<std::string> BuildFilesList(const std::vector<std::string>& directories) TDE2_NOEXCEPT;
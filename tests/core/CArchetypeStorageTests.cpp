@@ -0,0 +1,123 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <vector>
+#include <algorithm>
+
+
+using namespace TDEngine2;
+
+
+static IComponent* MakeFakeComponent(U32 value)
+{
+	return reinterpret_cast<IComponent*>(static_cast<uintptr_t>(value));
+}
+
+
+TEST_CASE("CArchetypeStorage Tests")
+{
+	CArchetypeStorage storage;
+
+	const TypeId firstTypeId  = TypeId(1);
+	const TypeId secondTypeId = TypeId(2);
+	const TypeId thirdTypeId  = TypeId(3);
+
+	SECTION("TestAddComponent_AddComponentsToEntities_EntitiesWithSameSignaturesShareArchetype")
+	{
+		REQUIRE(RC_OK == storage.AddComponent(TEntityId(0), firstTypeId, MakeFakeComponent(0x10)));
+		REQUIRE(RC_OK == storage.AddComponent(TEntityId(1), firstTypeId, MakeFakeComponent(0x20)));
+		REQUIRE(RC_FAIL == storage.AddComponent(TEntityId(1), firstTypeId, MakeFakeComponent(0x30)));
+
+		REQUIRE(storage.GetEntityRecord(TEntityId(0))->mArchetypeId == storage.GetEntityRecord(TEntityId(1))->mArchetypeId);
+		REQUIRE(storage.GetComponent(TEntityId(1), firstTypeId) == MakeFakeComponent(0x20));
+	}
+
+	SECTION("TestRemoveComponent_RemoveComponentFromMiddleRow_OtherEntitiesKeepTheirComponents")
+	{
+		for (U32 i = 0; i < 4; ++i)
+		{
+			REQUIRE(RC_OK == storage.AddComponent(TEntityId(i), firstTypeId, MakeFakeComponent(0x100 + i)));
+			REQUIRE(RC_OK == storage.AddComponent(TEntityId(i), secondTypeId, MakeFakeComponent(0x200 + i)));
+		}
+
+		REQUIRE(storage.RemoveComponent(TEntityId(1), secondTypeId) == MakeFakeComponent(0x201));
+		REQUIRE(!storage.HasComponent(TEntityId(1), secondTypeId));
+		REQUIRE(storage.GetComponent(TEntityId(1), firstTypeId) == MakeFakeComponent(0x101));
+
+		for (U32 i : { 0, 2, 3 })
+		{
+			REQUIRE(storage.GetComponent(TEntityId(i), firstTypeId) == MakeFakeComponent(0x100 + i));
+			REQUIRE(storage.GetComponent(TEntityId(i), secondTypeId) == MakeFakeComponent(0x200 + i));
+		}
+
+		U32 removedComponentsCount = 0;
+		REQUIRE(RC_OK == storage.RemoveEntity(TEntityId(2), [&removedComponentsCount](TypeId, IComponent*) { ++removedComponentsCount; }));
+		REQUIRE(2 == removedComponentsCount);
+		REQUIRE(!storage.GetEntityRecord(TEntityId(2)));
+		REQUIRE(storage.GetComponent(TEntityId(3), secondTypeId) == MakeFakeComponent(0x203));
+	}
+
+	SECTION("TestFindEntitiesWithAll_QueryTwoTypes_ReturnsOnlyEntitiesWithBothOfThem")
+	{
+		storage.AddComponent(TEntityId(0), firstTypeId, MakeFakeComponent(0x10));
+		storage.AddComponent(TEntityId(1), firstTypeId, MakeFakeComponent(0x20));
+		storage.AddComponent(TEntityId(1), secondTypeId, MakeFakeComponent(0x21));
+		storage.AddComponent(TEntityId(2), secondTypeId, MakeFakeComponent(0x31));
+		storage.AddComponent(TEntityId(2), thirdTypeId, MakeFakeComponent(0x32));
+		storage.AddComponent(TEntityId(2), firstTypeId, MakeFakeComponent(0x30));
+
+		std::vector<TEntityId> entities;
+		storage.FindEntitiesWithAll({ firstTypeId, secondTypeId }, entities);
+		std::sort(entities.begin(), entities.end());
+
+		REQUIRE(entities == std::vector<TEntityId> { TEntityId(1), TEntityId(2) });
+
+		entities.clear();
+		storage.FindEntitiesWithAll({ firstTypeId, TypeId(42) }, entities);
+
+		REQUIRE(entities.empty());
+	}
+
+	SECTION("TestFindEntitiesWithAny_QueryTwoTypes_ReturnsEachEntityOnce")
+	{
+		storage.AddComponent(TEntityId(0), firstTypeId, MakeFakeComponent(0x10));
+		storage.AddComponent(TEntityId(1), firstTypeId, MakeFakeComponent(0x20));
+		storage.AddComponent(TEntityId(1), secondTypeId, MakeFakeComponent(0x21));
+		storage.AddComponent(TEntityId(2), thirdTypeId, MakeFakeComponent(0x32));
+
+		std::vector<TEntityId> entities;
+		storage.FindEntitiesWithAny({ firstTypeId, secondTypeId }, entities);
+		std::sort(entities.begin(), entities.end());
+
+		REQUIRE(entities == std::vector<TEntityId> { TEntityId(0), TEntityId(1) });
+	}
+
+	SECTION("TestCreateComponentsMask_MaskOfArchetype_MatchesOnlyItsSubsets")
+	{
+		storage.AddComponent(TEntityId(0), firstTypeId, MakeFakeComponent(0x10));
+		storage.AddComponent(TEntityId(0), thirdTypeId, MakeFakeComponent(0x11));
+
+		const CArchetype* pArchetype = storage.GetArchetype(storage.GetEntityRecord(TEntityId(0))->mArchetypeId);
+		REQUIRE(pArchetype);
+
+		REQUIRE(pArchetype->MatchesMask(storage.CreateComponentsMask({ thirdTypeId }), {}));
+		REQUIRE(pArchetype->MatchesMask({}, storage.CreateComponentsMask({ secondTypeId, thirdTypeId })));
+		REQUIRE(!pArchetype->MatchesMask(storage.CreateComponentsMask({ firstTypeId, secondTypeId }), {}));
+	}
+
+	SECTION("TestGetComponent_StaleGenerationOfEntity_ReturnsNothing")
+	{
+		const TEntityId staleEntityId = MakeEntityId(5, 0);
+		const TEntityId currEntityId  = MakeEntityId(5, 1);
+
+		REQUIRE(GetEntityIndex(staleEntityId) == GetEntityIndex(currEntityId));
+
+		REQUIRE(RC_OK == storage.AddComponent(staleEntityId, firstTypeId, MakeFakeComponent(0x10)));
+		REQUIRE(RC_OK == storage.RemoveEntity(staleEntityId));
+		REQUIRE(RC_OK == storage.AddComponent(currEntityId, firstTypeId, MakeFakeComponent(0x20)));
+
+		REQUIRE(storage.GetComponent(currEntityId, firstTypeId) == MakeFakeComponent(0x20));
+		REQUIRE(!storage.GetComponent(staleEntityId, firstTypeId));
+		REQUIRE(!storage.GetEntityRecord(staleEntityId));
+		REQUIRE(RC_INVALID_ARGS == storage.AddComponent(staleEntityId, secondTypeId, MakeFakeComponent(0x11)));
+	}
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <atomic>
+
+
+using namespace TDEngine2;
+
+
+TEST_CASE("CBaseJobManager Tests")
+{
+	E_RESULT_CODE result = RC_OK;
+
+	TJobManagerInitParams params;
+	params.mMaxNumOfThreads = 4;
+
+	TPtr<IJobManager> pJobManager = TPtr<IJobManager>(CreateBaseJobManager(params, result));
+	REQUIRE(result == RC_OK);
+
+	SECTION("TestSubmitJob_SubmitJobsWithCounter_CounterReachesZeroWhenAllJobsAreCompleted")
+	{
+		const U32 jobsCount = 3 * JobsPoolSizePerThread; /// \note More jobs than slots, so slots are reused
+
+		std::atomic<U32> executedJobsCount { 0 };
+
+		TJobCounter counter;
+
+		for (U32 i = 0; i < jobsCount; ++i)
+		{
+			REQUIRE(pJobManager->SubmitJob(&counter, [&executedJobsCount] { ++executedJobsCount; }).IsValid());
+		}
+
+		pJobManager->WaitForJobCounter(counter);
+
+		REQUIRE(counter.mValue == 0);
+		REQUIRE(executedJobsCount == jobsCount);
+	}
+
+	SECTION("TestWaitForJob_PassHandle_JobIsCompletedAndHandleStaysCompletedAfterSlotIsReused")
+	{
+		std::atomic<bool> isExecuted { false };
+
+		const TJobHandle jobHandle = pJobManager->SubmitJob(nullptr, [&isExecuted]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			isExecuted = true;
+		});
+
+		REQUIRE(jobHandle.IsValid());
+
+		pJobManager->WaitForJob(jobHandle);
+
+		REQUIRE(isExecuted);
+		REQUIRE(pJobManager->IsJobCompleted(jobHandle));
+
+		TJobCounter counter;
+
+		for (U32 i = 0; i < 2 * JobsPoolSizePerThread; ++i)
+		{
+			pJobManager->SubmitJob(&counter, [] {});
+		}
+
+		pJobManager->WaitForJobCounter(counter);
+
+		REQUIRE(pJobManager->IsJobCompleted(jobHandle));
+		REQUIRE(pJobManager->IsJobCompleted(TJobHandle {})); /// \note Invalid handles are treated as completed ones
+	}
+
+	SECTION("TestContinueWith_PassPendingParent_ContinuationStartsAfterParentIsCompleted")
+	{
+		std::atomic<bool> isParentCompleted { false };
+		std::atomic<U32> orderedContinuationsCount { 0 };
+
+		TJobCounter counter;
+
+		const TJobHandle parentJobHandle = pJobManager->SubmitJob(&counter, [&isParentCompleted]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			isParentCompleted = true;
+		});
+
+		std::vector<TJobHandle> continuationsHandles;
+
+		const U32 continuationsCount = MaxJobContinuationsCount + 2; /// \note The last ones don't fit into the parent's slot
+
+		for (U32 i = 0; i < continuationsCount; ++i)
+		{
+			continuationsHandles.push_back(pJobManager->ContinueWith(parentJobHandle, &counter, [&isParentCompleted, &orderedContinuationsCount]
+			{
+				if (isParentCompleted)
+				{
+					++orderedContinuationsCount;
+				}
+			}));
+
+			REQUIRE(continuationsHandles.back().IsValid());
+		}
+
+		pJobManager->WaitForJobCounter(counter);
+
+		REQUIRE(orderedContinuationsCount == continuationsCount);
+
+		for (const TJobHandle& currHandle : continuationsHandles)
+		{
+			REQUIRE(pJobManager->IsJobCompleted(currHandle));
+		}
+	}
+
+	SECTION("TestContinueWith_PassCompletedOrInvalidParent_ContinuationIsExecuted")
+	{
+		const TJobHandle parentJobHandle = pJobManager->SubmitJob(nullptr, [] {});
+		pJobManager->WaitForJob(parentJobHandle);
+
+		std::atomic<U32> executedJobsCount { 0 };
+
+		TJobCounter counter;
+
+		REQUIRE(pJobManager->ContinueWith(parentJobHandle, &counter, [&executedJobsCount] { ++executedJobsCount; }).IsValid());
+		REQUIRE(pJobManager->ContinueWith(TJobHandle {}, &counter, [&executedJobsCount] { ++executedJobsCount; }).IsValid());
+		REQUIRE(!pJobManager->ContinueWith(TJobHandle {}, &counter, nullptr).IsValid());
+
+		pJobManager->WaitForJobCounter(counter);
+
+		REQUIRE(executedJobsCount == 2);
+	}
+
+	SECTION("TestParallelFor_PassRange_EachElementIsProcessedOnce")
+	{
+		std::vector<U32> values(10000, 0);
+
+		REQUIRE(RC_OK == pJobManager->ParallelFor(values.size(), sizeof(U32), [&values](USIZE first, USIZE last)
+		{
+			for (USIZE i = first; i < last; ++i)
+			{
+				++values[i];
+			}
+		}));
+
+		for (U32 currValue : values)
+		{
+			REQUIRE(currValue == 1);
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <chrono>
+
+
+using namespace TDEngine2;
+
+
+/*!
+	\note The benchmarks are hidden and should be run explicitly with a release build, e.g. tests "[benchmark]"
+*/
+
+TEST_CASE("CComponentManager Benchmarks", "[.][benchmark]")
+{
+	E_RESULT_CODE result = RC_OK;
+
+	IComponentManager* pComponentManager = CreateComponentManager(result);
+
+	REQUIRE(pComponentManager);
+	REQUIRE(RC_OK == result);
+
+	const U32 entitiesCount   = 10000;
+	const U32 iterationsCount = 200;
+
+	for (U32 i = 0; i < entitiesCount; ++i)
+	{
+		const TEntityId entityId = MakeEntityId(i, 0);
+
+		REQUIRE(pComponentManager->CreateComponent<CTransform>(entityId));
+
+		/// \note Split entities into several archetypes
+		if (i % 2)
+		{
+			REQUIRE(pComponentManager->CreateComponent<CBoundsComponent>(entityId));
+		}
+	}
+
+	SECTION("TestGetComponent_ExistingComponents_TakesFewNanosecondsPerCall")
+	{
+		uintptr_t checksum = 0;
+
+		const auto startTime = std::chrono::high_resolution_clock::now();
+
+		for (U32 k = 0; k < iterationsCount; ++k)
+		{
+			for (U32 i = 0; i < entitiesCount; ++i)
+			{
+				checksum ^= reinterpret_cast<uintptr_t>(pComponentManager->GetComponent<CTransform>(MakeEntityId(i, 0)));
+			}
+		}
+
+		const auto elapsedTime = std::chrono::duration<F64, std::nano>(std::chrono::high_resolution_clock::now() - startTime).count();
+		const F64 timePerCall = elapsedTime / (static_cast<F64>(entitiesCount) * iterationsCount);
+
+		WARN("IComponentManager::GetComponent<CTransform>: " << timePerCall << " ns per call, checksum " << checksum);
+
+		REQUIRE(timePerCall < 20.0);
+	}
+
+	SECTION("TestGetComponent_MissingComponents_ReturnsNullptrWithoutInsertions")
+	{
+		U32 foundComponentsCount = 0;
+
+		const auto startTime = std::chrono::high_resolution_clock::now();
+
+		for (U32 k = 0; k < iterationsCount; ++k)
+		{
+			for (U32 i = 0; i < entitiesCount; i += 2)
+			{
+				foundComponentsCount += (pComponentManager->GetComponent<CBoundsComponent>(MakeEntityId(i, 0)) != nullptr);
+			}
+		}
+
+		const auto elapsedTime = std::chrono::duration<F64, std::nano>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+		WARN("IComponentManager::GetComponent<CBoundsComponent> (missing): " << elapsedTime / (entitiesCount / 2 * iterationsCount) << " ns per call");
+
+		REQUIRE(!foundComponentsCount);
+
+		REQUIRE(pComponentManager->GetComponents(MakeEntityId(0, 0)).size() == 1);
+	}
+
+	REQUIRE(RC_OK == pComponentManager->Free());
+}
@@ -0,0 +1,470 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+
+using namespace TDEngine2;
+
+
+namespace
+{
+	std::atomic<U32> LoadsCounter { 0 };
+	std::atomic<U32> EvictionsCounter { 0 };
+
+	std::mutex LoadedResourcesMutex;
+	std::vector<std::string> LoadedResourcesNames;
+
+
+	class CTestResource : public CBaseResource
+	{
+		public:
+			TDE2_REGISTER_RESOURCE_TYPE(CTestResource)
+			TDE2_REGISTER_TYPE(CTestResource)
+
+			CTestResource(IResourceManager* pResourceManager, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy)
+			{
+				_init(pResourceManager, name);
+				mLoadingPolicy = loadingPolicy;
+			}
+
+			E_RESULT_CODE Reset() override
+			{
+				return RC_OK;
+			}
+
+			E_RESULT_CODE Evict() override
+			{
+				++EvictionsCounter;
+				return RC_OK;
+			}
+
+			USIZE GetMemorySize() const override
+			{
+				return (E_RESOURCE_STATE_TYPE::RST_LOADED == mState) ? 1024 : 0;
+			}
+		protected:
+			const TPtr<IResourceLoader> _getResourceLoader() override
+			{
+				return mpResourceManager->GetResourceLoader<CTestResource>();
+			}
+	};
+
+
+	/*!
+		\brief The texture doesn't own GPU data, it's used to check that textures are evicted together with materials
+	*/
+
+	class CTestTexture : public CTestResource, public ITexture
+	{
+		public:
+			TDE2_REGISTER_RESOURCE_TYPE(CTestTexture)
+			TDE2_REGISTER_TYPE(CTestTexture)
+
+			CTestTexture(IResourceManager* pResourceManager, const std::string& name, E_RESOURCE_LOADING_POLICY loadingPolicy) :
+				CTestResource(pResourceManager, name, loadingPolicy)
+			{
+			}
+
+			void Bind(U32 slot) override {}
+
+			void SetUWrapMode(const E_ADDRESS_MODE_TYPE& mode) override {}
+			void SetVWrapMode(const E_ADDRESS_MODE_TYPE& mode) override {}
+			void SetWWrapMode(const E_ADDRESS_MODE_TYPE& mode) override {}
+
+			void SetFilterType(const E_TEXTURE_FILTER_TYPE& type) override {}
+
+			U32 GetWidth() const override { return 16; }
+			U32 GetHeight() const override { return 16; }
+
+			E_FORMAT_TYPE GetFormat() const override { return FT_NORM_UBYTE4; }
+
+			TRectF32 GetNormalizedTextureRect() const override { return { 0.0f, 0.0f, 1.0f, 1.0f }; }
+		protected:
+			const TPtr<IResourceLoader> _getResourceLoader() override
+			{
+				return mpResourceManager->GetResourceLoader<CTestTexture>();
+			}
+	};
+
+
+	template <typename TResourceType>
+	class CTestResourceLoader : public CBaseObject, public IResourceLoader
+	{
+		public:
+			CTestResourceLoader()
+			{
+				mIsInitialized = true;
+			}
+
+			E_RESULT_CODE LoadResource(IResource* pResource) const override
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(20)); /// \note Give other threads a chance to request the same resource
+				++LoadsCounter;
+
+				std::lock_guard<std::mutex> lock(LoadedResourcesMutex);
+				LoadedResourcesNames.push_back(pResource->GetName());
+
+				return RC_OK;
+			}
+
+			TypeId GetResourceTypeId() const override
+			{
+				return TResourceType::GetTypeId();
+			}
+	};
+
+
+	template <typename TResourceType>
+	class CTestResourceFactory : public CBaseObject, public IResourceFactory
+	{
+		public:
+			CTestResourceFactory(IResourceManager* pResourceManager) :
+				mpResourceManager(pResourceManager)
+			{
+				mIsInitialized = true;
+			}
+
+			IResource* Create(const std::string& name, const TBaseResourceParameters& params) const override
+			{
+				return CreateDefault(name, params);
+			}
+
+			IResource* CreateDefault(const std::string& name, const TBaseResourceParameters& params) const override
+			{
+				return new TResourceType(mpResourceManager, name, params.mLoadingPolicy);
+			}
+
+			TypeId GetResourceTypeId() const override
+			{
+				return TResourceType::GetTypeId();
+			}
+		protected:
+			IResourceManager* mpResourceManager;
+	};
+
+
+	/*!
+		\brief The loader assigns a texture to a material like CBaseMaterialLoader does with textures from a material's file
+	*/
+
+	class CTestMaterialLoader : public CBaseObject, public IResourceLoader
+	{
+		public:
+			CTestMaterialLoader(IResourceManager* pResourceManager) :
+				mpResourceManager(pResourceManager)
+			{
+				mIsInitialized = true;
+			}
+
+			E_RESULT_CODE LoadResource(IResource* pResource) const override
+			{
+				auto pTexture = mpResourceManager->GetResource<ITexture>(mpResourceManager->Load<CTestTexture>("TestTexture", E_RESOURCE_LOADING_POLICY::SYNCED));
+				return dynamic_cast<IMaterial*>(pResource)->SetTextureResource("MainTexture", pTexture.Get());
+			}
+
+			TypeId GetResourceTypeId() const override
+			{
+				return IMaterial::GetTypeId();
+			}
+		protected:
+			IResourceManager* mpResourceManager;
+	};
+
+
+	class CTestMaterialFactory : public CBaseObject, public IResourceFactory
+	{
+		public:
+			CTestMaterialFactory(IResourceManager* pResourceManager, IGraphicsContext* pGraphicsContext) :
+				mpResourceManager(pResourceManager), mpGraphicsContext(pGraphicsContext)
+			{
+				mIsInitialized = true;
+			}
+
+			IResource* Create(const std::string& name, const TBaseResourceParameters& params) const override
+			{
+				return CreateDefault(name, params);
+			}
+
+			IResource* CreateDefault(const std::string& name, const TBaseResourceParameters& params) const override
+			{
+				E_RESULT_CODE result = RC_OK;
+				return dynamic_cast<IResource*>(CreateBaseMaterial(mpResourceManager, mpGraphicsContext, name, result));
+			}
+
+			TypeId GetResourceTypeId() const override
+			{
+				return IMaterial::GetTypeId();
+			}
+		protected:
+			IResourceManager* mpResourceManager;
+			IGraphicsContext* mpGraphicsContext;
+	};
+}
+
+
+TEST_CASE("CResourceManager Tests")
+{
+	E_RESULT_CODE result = RC_OK;
+
+	TPtr<IJobManager> pJobManager = TPtr<IJobManager>(CreateBaseJobManager(TJobManagerInitParams {}, result));
+	REQUIRE(result == RC_OK);
+
+	TPtr<IResourceManager> pResourceManager = TPtr<IResourceManager>(CreateResourceManager(pJobManager, result));
+	REQUIRE(result == RC_OK);
+
+	REQUIRE(pResourceManager->RegisterLoader(new CTestResourceLoader<CTestResource>()).IsOk());
+	REQUIRE(pResourceManager->RegisterFactory(new CTestResourceFactory<CTestResource>(pResourceManager.Get())).IsOk());
+
+	LoadsCounter = 0;
+	EvictionsCounter = 0;
+	LoadedResourcesNames.clear();
+
+	SECTION("TestLoad_RequestTheSameResourceFromManyThreads_ResourceIsLoadedOnce")
+	{
+		const U32 threadsCount = 8;
+
+		std::vector<TResourceId> resourcesIds(threadsCount, TResourceId::Invalid);
+		std::vector<U8> isLoadedFlags(threadsCount, 0); /// \note std::vector<bool> packs flags into shared words, so concurrent writes would race
+
+		std::vector<std::thread> threads;
+
+		for (U32 i = 0; i < threadsCount; ++i)
+		{
+			threads.emplace_back([i, &pResourceManager, &resourcesIds, &isLoadedFlags]
+			{
+				resourcesIds[i] = pResourceManager->Load<CTestResource>("TestResource", E_RESOURCE_LOADING_POLICY::SYNCED);
+
+				auto pResource = pResourceManager->GetResource(resourcesIds[i]);
+				isLoadedFlags[i] = static_cast<U8>(pResource && (E_RESOURCE_STATE_TYPE::RST_LOADED == pResource->GetState()));
+			});
+		}
+
+		for (auto& currThread : threads)
+		{
+			currThread.join();
+		}
+
+		REQUIRE(LoadsCounter == 1);
+
+		for (U32 i = 0; i < threadsCount; ++i)
+		{
+			REQUIRE(resourcesIds[i] != TResourceId::Invalid);
+			REQUIRE(resourcesIds[i] == resourcesIds[0]);
+			REQUIRE(isLoadedFlags[i]);
+		}
+	}
+
+	SECTION("TestLoad_PassPrecomputedNameHash_ReturnsTheSameResourceAsStringVersion")
+	{
+		const TResourceNameHash resourceName("TestResource");
+
+		const TResourceId resourceId = pResourceManager->Load<CTestResource>(resourceName, E_RESOURCE_LOADING_POLICY::SYNCED);
+
+		REQUIRE(resourceId != TResourceId::Invalid);
+		REQUIRE(resourceId == pResourceManager->Load<CTestResource>("TestResource", E_RESOURCE_LOADING_POLICY::SYNCED));
+		REQUIRE(resourceId == pResourceManager->GetResourceId("TestResource"));
+		REQUIRE(LoadsCounter == 1);
+	}
+
+	SECTION("TestReleaseResource_ReleaseLoadedResource_NameIsNotRegisteredAnymore")
+	{
+		const TResourceId firstResourceId = pResourceManager->Load<CTestResource>("FirstResource", E_RESOURCE_LOADING_POLICY::SYNCED);
+		const TResourceId secondResourceId = pResourceManager->Load<CTestResource>("SecondResource", E_RESOURCE_LOADING_POLICY::SYNCED);
+
+		REQUIRE(firstResourceId != secondResourceId);
+
+		REQUIRE(pResourceManager->ReleaseResource(firstResourceId) == RC_OK);
+
+		REQUIRE(pResourceManager->GetResourceId("FirstResource") == TResourceId::Invalid);
+		REQUIRE(pResourceManager->GetResourceId("SecondResource") == secondResourceId);
+	}
+
+	SECTION("TestUpdate_MemoryBudgetIsUnlimited_NothingIsEvicted")
+	{
+		pResourceManager->Load<CTestResource>("FirstResource", E_RESOURCE_LOADING_POLICY::SYNCED);
+		pResourceManager->Load<CTestResource>("SecondResource", E_RESOURCE_LOADING_POLICY::SYNCED);
+
+		for (U32 i = 0; i < 3; ++i)
+		{
+			REQUIRE(pResourceManager->Update() == RC_OK);
+		}
+
+		REQUIRE(pResourceManager->GetMemoryUsage() == 2048);
+		REQUIRE(EvictionsCounter == 0);
+	}
+
+	SECTION("TestUpdate_ExceedMemoryBudget_LeastRecentlyUsedUnreferencedResourcesAreEvicted")
+	{
+		pResourceManager->SetMemoryBudget(2048);
+
+		const TResourceId firstResourceId = pResourceManager->Load<CTestResource>("FirstResource", E_RESOURCE_LOADING_POLICY::SYNCED);
+		const TResourceId secondResourceId = pResourceManager->Load<CTestResource>("SecondResource", E_RESOURCE_LOADING_POLICY::SYNCED);
+		const TResourceId thirdResourceId = pResourceManager->Load<CTestResource>("ThirdResource", E_RESOURCE_LOADING_POLICY::SYNCED);
+
+		/// \note Resources that were used within the current frame are kept even if the budget is exceeded
+		REQUIRE(pResourceManager->Update() == RC_OK);
+		REQUIRE(pResourceManager->GetMemoryUsage() == 3072);
+		REQUIRE(EvictionsCounter == 0);
+
+		TPtr<IResource> pFirstResource = pResourceManager->GetResource(firstResourceId);
+		pResourceManager->GetResource(thirdResourceId);
+
+		REQUIRE(pResourceManager->Update() == RC_OK);
+		REQUIRE(pResourceManager->GetMemoryUsage() == 2048);
+		REQUIRE(EvictionsCounter == 1);
+		REQUIRE(pResourceManager->GetResource(secondResourceId)->GetState() == E_RESOURCE_STATE_TYPE::RST_PENDING);
+
+		/// \note The second resource was requested above, so it's reloaded and the least recently used one is evicted instead
+		REQUIRE(pResourceManager->Update() == RC_OK);
+		REQUIRE(LoadsCounter == 4);
+		REQUIRE(EvictionsCounter == 2);
+		REQUIRE(pResourceManager->GetResourceId("SecondResource") == secondResourceId);
+
+		REQUIRE(pFirstResource->GetState() == E_RESOURCE_STATE_TYPE::RST_LOADED);
+		REQUIRE(pResourceManager->GetResource(secondResourceId)->GetState() == E_RESOURCE_STATE_TYPE::RST_LOADED);
+		REQUIRE(pResourceManager->GetResource(thirdResourceId)->GetState() == E_RESOURCE_STATE_TYPE::RST_PENDING);
+	}
+
+	SECTION("TestUpdate_ExceedMemoryBudget_TextureOfUnusedMaterialIsEvicted")
+	{
+		TPtr<IEventManager> pEventManager = TPtr<IEventManager>(CreateEventManager(result));
+		REQUIRE(result == RC_OK);
+
+		TPtr<IWindowSystem> pWindowSystem = TPtr<IWindowSystem>(CreateProxyWindowSystem(pEventManager, "Test", 640, 480, 0x0, result));
+		REQUIRE(result == RC_OK);
+
+		TPtr<IGraphicsContext> pGraphicsContext = TPtr<IGraphicsContext>(CreateProxyGraphicsContext(pWindowSystem, result));
+		REQUIRE(result == RC_OK);
+
+		REQUIRE(pResourceManager->RegisterLoader(new CTestResourceLoader<CTestTexture>()).IsOk());
+		REQUIRE(pResourceManager->RegisterFactory(new CTestResourceFactory<CTestTexture>(pResourceManager.Get())).IsOk());
+		REQUIRE(pResourceManager->RegisterLoader(new CTestMaterialLoader(pResourceManager.Get())).IsOk());
+		REQUIRE(pResourceManager->RegisterFactory(new CTestMaterialFactory(pResourceManager.Get(), pGraphicsContext.Get())).IsOk());
+
+		pResourceManager->SetMemoryBudget(1);
+
+		const TResourceId materialId = pResourceManager->Load<IMaterial>("TestMaterial", E_RESOURCE_LOADING_POLICY::SYNCED);
+		const TResourceId textureId = pResourceManager->GetResourceId("TestTexture");
+
+		REQUIRE(pResourceManager->GetResource<IMaterial>(materialId)->GetTextureResource("MainTexture"));
+
+		/// \note The material and the texture were used within the current frame
+		REQUIRE(pResourceManager->Update() == RC_OK);
+		REQUIRE(EvictionsCounter == 0);
+
+		/// \note The texture is referenced by the material until the latter is evicted within the same update
+		REQUIRE(pResourceManager->Update() == RC_OK);
+		REQUIRE(EvictionsCounter == 1);
+		REQUIRE(pResourceManager->GetMemoryUsage() == 0);
+
+		auto pMaterial = pResourceManager->GetResource<IMaterial>(materialId);
+		REQUIRE(dynamic_cast<IResource*>(pMaterial.Get())->GetState() == E_RESOURCE_STATE_TYPE::RST_PENDING);
+		REQUIRE(!pMaterial->GetTextureResource("MainTexture"));
+
+		REQUIRE(pResourceManager->GetResource(textureId)->GetState() == E_RESOURCE_STATE_TYPE::RST_PENDING);
+	}
+
+	SECTION("TestLoadAsync_WaitForLoading_RequestIsCompletedAndResourceIsLoaded")
+	{
+		const TResourceLoadingHandle handle = pResourceManager->LoadAsync<CTestResource>("AsyncResource");
+		REQUIRE(handle.IsValid());
+		REQUIRE(handle.mResourceId == pResourceManager->GetResourceId("AsyncResource"));
+
+		REQUIRE(pResourceManager->WaitForLoading(handle) == E_RESOURCE_LOADING_STATUS::COMPLETED);
+		REQUIRE(pResourceManager->GetResource(handle.mResourceId)->GetState() == E_RESOURCE_STATE_TYPE::RST_LOADED);
+
+		/// \note Requests of loaded resources are completed at once
+		const TResourceLoadingHandle secondHandle = pResourceManager->LoadAsync<CTestResource>("AsyncResource");
+		REQUIRE(pResourceManager->GetLoadingStatus(secondHandle) == E_RESOURCE_LOADING_STATUS::COMPLETED);
+		REQUIRE(secondHandle.mResourceId == handle.mResourceId);
+		REQUIRE(LoadsCounter == 1);
+
+		/// \note Statuses of recycled requests are restored from states of resources
+		for (U32 i = 0; i < 2; ++i)
+		{
+			REQUIRE(pResourceManager->Update() == RC_OK);
+		}
+
+		REQUIRE(pResourceManager->GetLoadingStatus(handle) == E_RESOURCE_LOADING_STATUS::COMPLETED);
+	}
+
+	SECTION("TestLoadAsync_PassDependencies_DependencyIsLoadedFirst")
+	{
+		const TResourceLoadingHandle dependencyHandle = pResourceManager->LoadAsync<CTestResource>("Dependency");
+		const TResourceLoadingHandle dependentHandle = pResourceManager->LoadAsync<CTestResource>("Dependent", { E_RESOURCE_LOADING_PRIORITY::HIGH, { dependencyHandle } });
+
+		REQUIRE(pResourceManager->WaitForLoading(dependentHandle) == E_RESOURCE_LOADING_STATUS::COMPLETED);
+		REQUIRE(pResourceManager->GetLoadingStatus(dependencyHandle) == E_RESOURCE_LOADING_STATUS::COMPLETED);
+
+		REQUIRE(LoadedResourcesNames.size() == 2);
+		REQUIRE(LoadedResourcesNames[0] == "Dependency");
+		REQUIRE(LoadedResourcesNames[1] == "Dependent");
+	}
+
+	SECTION("TestCancelLoading_CancelWaitingRequest_DependentsFailAndResourceIsNotLoaded")
+	{
+		const TResourceLoadingHandle dependencyHandle = pResourceManager->LoadAsync<CTestResource>("Dependency");
+		const TResourceLoadingHandle cancelledHandle = pResourceManager->LoadAsync<CTestResource>("Cancelled", { E_RESOURCE_LOADING_PRIORITY::NORMAL, { dependencyHandle } });
+		const TResourceLoadingHandle dependentHandle = pResourceManager->LoadAsync<CTestResource>("Dependent", { E_RESOURCE_LOADING_PRIORITY::NORMAL, { cancelledHandle } });
+
+		REQUIRE(pResourceManager->CancelLoading(cancelledHandle) == RC_OK);
+		REQUIRE(pResourceManager->GetLoadingStatus(cancelledHandle) == E_RESOURCE_LOADING_STATUS::CANCELLED);
+		REQUIRE(pResourceManager->GetLoadingStatus(dependentHandle) == E_RESOURCE_LOADING_STATUS::FAILED);
+
+		REQUIRE(pResourceManager->WaitForLoading(dependencyHandle) == E_RESOURCE_LOADING_STATUS::COMPLETED);
+		REQUIRE(pResourceManager->CancelLoading(dependencyHandle) == RC_FAIL);
+
+		REQUIRE(LoadsCounter == 1);
+		REQUIRE(pResourceManager->GetResource(cancelledHandle.mResourceId)->GetState() == E_RESOURCE_STATE_TYPE::RST_PENDING);
+	}
+
+	SECTION("TestExecuteAfterLoading_CallFromWorker_ActionIsExecutedOnMainThreadAfterDependencies")
+	{
+		const TResourceLoadingHandle dependencyHandle = pResourceManager->LoadAsync<CTestResource>("Dependency");
+
+		std::atomic<bool> isActionExecuted { false };
+		std::thread::id actionThreadId;
+
+		E_RESULT_CODE workerResult = RC_FAIL;
+
+		std::thread worker([&]
+		{
+			workerResult = pResourceManager->ExecuteAfterLoading({ E_RESOURCE_LOADING_PRIORITY::NORMAL, { dependencyHandle } }, [&]
+			{
+				actionThreadId = std::this_thread::get_id();
+				isActionExecuted = pResourceManager->GetLoadingStatus(dependencyHandle) == E_RESOURCE_LOADING_STATUS::COMPLETED;
+			});
+		});
+
+		worker.join();
+
+		/// \note The last stage of the request is completed by the main thread, so the action can't be executed yet
+		REQUIRE(workerResult == RC_OK);
+		REQUIRE(!isActionExecuted);
+
+		REQUIRE(pResourceManager->WaitForLoading(dependencyHandle) == E_RESOURCE_LOADING_STATUS::COMPLETED);
+		REQUIRE(pResourceManager->Update() == RC_OK);
+
+		REQUIRE(isActionExecuted);
+		REQUIRE(actionThreadId == std::this_thread::get_id());
+	}
+
+	SECTION("TestExecuteAfterLoading_CallFromMainThread_ActionIsExecutedAtOnce")
+	{
+		const TResourceLoadingHandle dependencyHandle = pResourceManager->LoadAsync<CTestResource>("Dependency");
+
+		bool isActionExecuted = false;
+
+		REQUIRE(pResourceManager->ExecuteAfterLoading({ E_RESOURCE_LOADING_PRIORITY::NORMAL, { dependencyHandle } }, [&]
+		{
+			isActionExecuted = pResourceManager->GetLoadingStatus(dependencyHandle) == E_RESOURCE_LOADING_STATUS::COMPLETED;
+		}) == RC_OK);
+
+		REQUIRE(isActionExecuted);
+	}
+}
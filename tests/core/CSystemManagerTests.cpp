@@ -0,0 +1,84 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <vector>
+
+
+using namespace TDEngine2;
+
+
+namespace
+{
+	class CTestInputContext : public CBaseObject, public IInputContext
+	{
+		public:
+			CTestInputContext()
+			{
+				mIsInitialized = true;
+			}
+
+			E_RESULT_CODE Init(TPtr<IWindowSystem> pWindowSystem) override
+			{
+				return RC_OK;
+			}
+
+			E_RESULT_CODE Update() override
+			{
+				return RC_OK;
+			}
+
+			E_ENGINE_SUBSYSTEM_TYPE GetType() const override
+			{
+				return EST_INPUT_CONTEXT;
+			}
+	};
+}
+
+
+TEST_CASE("CSystemManager Tests")
+{
+	E_RESULT_CODE result = RC_OK;
+
+	TPtr<IInputContext> pInputContext = TPtr<IInputContext>(new CTestInputContext());
+
+	/// \note Systems are listed in order of their registration within CEngineCore
+	TPtr<ISystem> pUIEventsSystem = TPtr<ISystem>(CreateUIEventsSystem(pInputContext.Get(), result));
+	REQUIRE(RC_OK == result);
+
+	TPtr<ISystem> pLODMeshSwitchSystem = TPtr<ISystem>(CreateLODMeshSwitchSystem(result));
+	REQUIRE(RC_OK == result);
+
+	TPtr<ISystem> pPhysics2DSystem = TPtr<ISystem>(CreatePhysics2DSystem(nullptr, result));
+	REQUIRE(RC_OK == result);
+
+	SECTION("TestHasSystemsAccessConflict_SystemsWriteReadComponents_ReturnsTrue")
+	{
+		/// \note CPhysics2DSystem writes CTransform which is read by CLODMeshSwitchSystem
+		REQUIRE(HasSystemsAccessConflict(pLODMeshSwitchSystem.Get(), pPhysics2DSystem.Get()));
+		REQUIRE(HasSystemsAccessConflict(pPhysics2DSystem.Get(), pLODMeshSwitchSystem.Get()));
+
+		REQUIRE_FALSE(HasSystemsAccessConflict(pUIEventsSystem.Get(), pLODMeshSwitchSystem.Get()));
+		REQUIRE_FALSE(HasSystemsAccessConflict(pUIEventsSystem.Get(), pPhysics2DSystem.Get()));
+	}
+
+	SECTION("TestBuildSystemsExecutionLevels_PassBuiltinSystems_IndependentSystemsShareLevel")
+	{
+		std::vector<std::vector<U32>> levels;
+		BuildSystemsExecutionLevels({ pUIEventsSystem.Get(), pLODMeshSwitchSystem.Get(), pPhysics2DSystem.Get() }, levels);
+
+		REQUIRE(levels.size() == 2);
+		REQUIRE(levels[0] == std::vector<U32> { 0, 1 });
+		REQUIRE(levels[1] == std::vector<U32> { 2 });
+	}
+
+	SECTION("TestBuildSystemsExecutionLevels_RebuildLevels_PreviousLevelsAreDiscarded")
+	{
+		std::vector<std::vector<U32>> levels;
+		BuildSystemsExecutionLevels({ pLODMeshSwitchSystem.Get(), pPhysics2DSystem.Get(), pUIEventsSystem.Get() }, levels);
+		REQUIRE(levels.size() == 2);
+
+		BuildSystemsExecutionLevels({ pUIEventsSystem.Get(), pLODMeshSwitchSystem.Get() }, levels);
+
+		REQUIRE(levels.size() == 1);
+		REQUIRE(levels[0] == std::vector<U32> { 0, 1 });
+	}
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+
+using namespace TDEngine2;
+
+
+TEST_CASE("CWorkStealingQueue Tests")
+{
+	CWorkStealingQueue queue(8);
+
+	SECTION("TestPushPop_PushValues_OwnerPopsThemInReversedOrder")
+	{
+		U32 value = 0;
+
+		REQUIRE(queue.IsEmpty());
+		REQUIRE(!queue.Pop(value));
+
+		for (U32 i = 0; i < 3; ++i)
+		{
+			REQUIRE(queue.Push(i));
+		}
+
+		for (U32 i = 3; i > 0; --i)
+		{
+			REQUIRE(queue.Pop(value));
+			REQUIRE(value == i - 1);
+		}
+
+		REQUIRE(queue.IsEmpty());
+	}
+
+	SECTION("TestSteal_PushValues_ThiefTakesTheOldestOne")
+	{
+		U32 value = 0;
+
+		REQUIRE(queue.Push(1));
+		REQUIRE(queue.Push(2));
+
+		REQUIRE(queue.Steal(value));
+		REQUIRE(value == 1);
+
+		REQUIRE(queue.Pop(value));
+		REQUIRE(value == 2);
+
+		REQUIRE(!queue.Steal(value));
+	}
+
+	SECTION("TestPush_QueueIsFull_ReturnsFalse")
+	{
+		for (U32 i = 0; i < queue.GetCapacity(); ++i)
+		{
+			REQUIRE(queue.Push(i));
+		}
+
+		REQUIRE(!queue.Push(42));
+	}
+
+	SECTION("TestSteal_ConcurrentThieves_EachValueIsRetrievedOnce")
+	{
+		const U32 valuesCount = 100000;
+		const U32 thievesCount = 3;
+
+		CWorkStealingQueue sharedQueue(1024);
+
+		std::vector<std::atomic<U32>> retrievalsCounters(valuesCount);
+		std::atomic<bool> isDone { false };
+
+		std::vector<std::thread> thieves;
+
+		for (U32 i = 0; i < thievesCount; ++i)
+		{
+			thieves.emplace_back([&]
+			{
+				U32 value = 0;
+
+				while (!isDone || !sharedQueue.IsEmpty())
+				{
+					if (sharedQueue.Steal(value))
+					{
+						++retrievalsCounters[value];
+					}
+				}
+			});
+		}
+
+		U32 value = 0;
+
+		for (U32 i = 0; i < valuesCount; ++i)
+		{
+			while (!sharedQueue.Push(i))
+			{
+				if (sharedQueue.Pop(value))
+				{
+					++retrievalsCounters[value];
+				}
+			}
+		}
+
+		while (sharedQueue.Pop(value))
+		{
+			++retrievalsCounters[value];
+		}
+
+		isDone = true;
+
+		for (std::thread& currThread : thieves)
+		{
+			currThread.join();
+		}
+
+		for (U32 i = 0; i < valuesCount; ++i)
+		{
+			REQUIRE(1 == retrievalsCounters[i]);
+		}
+	}
+}
@@ -78,5 +78,81 @@ TEST_CASE("CFrustum Tests")
 		}
 	}
 
+	SECTION("TestTestAABB_PassBoxesThatIntersectFrustum_ReturnsTrue")
+	{
+		TAABB testCases[]
+		{
+			{ TVector3(-1.0f, -1.0f, 1.5f), TVector3(1.0f, 1.0f, 2.5f) },
+			{ TVector3(-5000.0f), TVector3(5000.0f) }, ///< The box is larger than the frustum, so none of its vertices lies inside
+			{ TVector3(-1.0f, -1.0f, 500.0f), TVector3(1.0f, 1.0f, 5000.0f) },
+		};
+
+		for (auto&& currBox : testCases)
+		{
+			REQUIRE(pFrustum->TestAABB(currBox));
+		}
+	}
+
+	SECTION("TestTestAABB_PassBoxesOutsideOfFrustum_ReturnsFalse")
+	{
+		TAABB testCases[]
+		{
+			{ TVector3(-10.0f), TVector3(-5.0f) },
+			{ TVector3(10.0f, -1.0f, 2.0f), TVector3(20.0f, 1.0f, 3.0f) },
+			{ TVector3(-1.0f, -1.0f, 1010.0f), TVector3(1.0f, 1.0f, 1020.0f) },
+		};
+
+		for (auto&& currBox : testCases)
+		{
+			REQUIRE(!pFrustum->TestAABB(currBox));
+		}
+	}
+
+	SECTION("TestCullBoundsByFrustum_PassMixedBounds_ReturnsVisibilityOfEachElement")
+	{
+		const TAABB boxes[]
+		{
+			{ TVector3(-1.0f, -1.0f, 1.5f), TVector3(1.0f, 1.0f, 2.5f) },
+			{ TVector3(-10.0f), TVector3(-5.0f) },
+			{ TVector3(-5000.0f), TVector3(5000.0f) },
+			{ TVector3(10.0f, -1.0f, 2.0f), TVector3(20.0f, 1.0f, 3.0f) },
+			{ TVector3(-1.0f, -1.0f, 1010.0f), TVector3(1.0f, 1.0f, 1020.0f) },
+		};
+
+		std::vector<CBoundsComponent*> bounds;
+
+		for (auto&& currBox : boxes)
+		{
+			CBoundsComponent* pBounds = dynamic_cast<CBoundsComponent*>(CreateBoundsComponent(result));
+			REQUIRE(pBounds);
+
+			pBounds->SetBounds(currBox);
+			pBounds->SetDirty(false);
+
+			bounds.push_back(pBounds);
+		}
+
+		bounds.push_back(nullptr); /// \note Elements without bounds are never culled
+
+		std::vector<U8> visibilityFlags;
+
+		REQUIRE(CullBoundsByFrustum(nullptr, pFrustum, bounds, visibilityFlags) == 3);
+		REQUIRE(visibilityFlags == std::vector<U8> { 1, 0, 1, 0, 0, 1 });
+
+		/// \note Dirty bounds are stale, so they're considered as visible ones
+		bounds[1]->SetDirty(true);
+
+		REQUIRE(CullBoundsByFrustum(nullptr, pFrustum, bounds, visibilityFlags) == 4);
+		REQUIRE(visibilityFlags[1]);
+
+		for (CBoundsComponent* pBounds : bounds)
+		{
+			if (pBounds)
+			{
+				REQUIRE(pBounds->Free() == RC_OK);
+			}
+		}
+	}
+
 	REQUIRE(pFrustum->Free() == RC_OK);
 }
\ No newline at end of file
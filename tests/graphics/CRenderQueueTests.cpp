@@ -0,0 +1,570 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <vector>
+#include <algorithm>
+
+
+using namespace TDEngine2;
+
+
+namespace
+{
+	/*!
+		\brief Test doubles that allow to submit draw commands into CProxyGraphicsContext without GPU resources
+	*/
+
+	class CTestShader : public CBaseShader
+	{
+		public:
+			CTestShader(IResourceManager* pResourceManager, IGraphicsContext* pGraphicsContext, const std::string& name)
+			{
+				Init(pResourceManager, pGraphicsContext, name);
+			}
+
+			E_RESULT_CODE Reset() override
+			{
+				return RC_OK;
+			}
+
+			void Unbind() override
+			{
+			}
+		protected:
+			E_RESULT_CODE _createInternalHandlers(const TShaderCompilerOutput* pCompilerData) override
+			{
+				return RC_OK;
+			}
+
+			void _bindUniformBuffer(U32 slot, IConstantBuffer* pBuffer) override
+			{
+			}
+	};
+
+
+	class CTestMaterial : public CBaseMaterial
+	{
+		public:
+			CTestMaterial(IResourceManager* pResourceManager, IGraphicsContext* pGraphicsContext, const std::string& name)
+			{
+				Init(pResourceManager, pGraphicsContext, name);
+			}
+
+			/// \note Binds the same states as CBaseMaterial does, but states' objects aren't created, because the proxy context has no objects manager
+			void Bind(TMaterialInstanceId instanceId, bool useInstancedShader) override
+			{
+				mpGraphicsContext->BindBlendState(TBlendStateId(0));
+				mpGraphicsContext->BindDepthStencilState(TDepthStencilStateId(0));
+				mpGraphicsContext->BindRasterizerState(TRasterizerStateId(0));
+
+				++mInstanceDataBindsCount;
+
+				mIsInstancedShaderBound = useInstancedShader;
+			}
+
+			void BindInstanceData(TMaterialInstanceId instanceId, bool useInstancedShader) override
+			{
+				++mInstanceDataBindsCount;
+			}
+
+			void SetShaderHandle(TResourceId shaderHandle)
+			{
+				mShaderHandle = shaderHandle;
+			}
+		public:
+			U32  mInstanceDataBindsCount = 0;
+
+			bool mIsInstancedShaderBound = false;
+	};
+
+
+	template <typename TResourceType, typename TInterfaceType>
+	class CTestResourceLoader : public CBaseObject, public IResourceLoader
+	{
+		public:
+			CTestResourceLoader()
+			{
+				mIsInitialized = true;
+			}
+
+			E_RESULT_CODE LoadResource(IResource* pResource) const override
+			{
+				return RC_OK;
+			}
+
+			TypeId GetResourceTypeId() const override
+			{
+				return TInterfaceType::GetTypeId();
+			}
+	};
+
+
+	template <typename TResourceType, typename TInterfaceType>
+	class CTestResourceFactory : public CBaseObject, public IResourceFactory
+	{
+		public:
+			CTestResourceFactory(IResourceManager* pResourceManager, IGraphicsContext* pGraphicsContext) :
+				mpResourceManager(pResourceManager), mpGraphicsContext(pGraphicsContext)
+			{
+				mIsInitialized = true;
+			}
+
+			IResource* Create(const std::string& name, const TBaseResourceParameters& params) const override
+			{
+				return CreateDefault(name, params);
+			}
+
+			IResource* CreateDefault(const std::string& name, const TBaseResourceParameters& params) const override
+			{
+				return new TResourceType(mpResourceManager, mpGraphicsContext, name);
+			}
+
+			TypeId GetResourceTypeId() const override
+			{
+				return TInterfaceType::GetTypeId();
+			}
+		protected:
+			IResourceManager* mpResourceManager;
+			IGraphicsContext* mpGraphicsContext;
+	};
+
+
+	class CTestVertexDeclaration : public CVertexDeclaration
+	{
+		public:
+			CTestVertexDeclaration()
+			{
+				Init();
+			}
+
+			void Bind(IGraphicsContext* pGraphicsContext, const CStaticArray<IVertexBuffer*>& pVertexBuffersArray, IShader* pShader) override
+			{
+				++mBindsCount;
+			}
+		public:
+			U32 mBindsCount = 0;
+	};
+
+
+	class CTestVertexBuffer : public CBaseObject, public IVertexBuffer
+	{
+		public:
+			CTestVertexBuffer()
+			{
+				mIsInitialized = true;
+			}
+
+			E_RESULT_CODE Init(IGraphicsContext* pGraphicsContext, E_BUFFER_USAGE_TYPE usageType, USIZE totalBufferSize, const void* pDataPtr) override { return RC_OK; }
+
+			void Bind(U32 slot, U32 offset, U32 stride) override
+			{
+				++mBindsCount;
+			}
+
+			E_RESULT_CODE Map(E_BUFFER_MAP_TYPE mapType) override { return RC_OK; }
+			void Unmap() override {}
+			E_RESULT_CODE Write(const void* pData, USIZE size) override { return RC_OK; }
+			void* Read() override { return nullptr; }
+			const TBufferInternalData& GetInternalData() const override { return mInternalData; }
+			USIZE GetSize() const override { return 0; }
+			USIZE GetUsedSize() const override { return 0; }
+		public:
+			U32 mBindsCount = 0;
+
+			TBufferInternalData mInternalData;
+	};
+
+
+	class CTestGlobalShaderProperties : public CBaseObject, public IGlobalShaderProperties
+	{
+		public:
+			CTestGlobalShaderProperties()
+			{
+				mIsInitialized = true;
+			}
+
+			E_RESULT_CODE Init(IGraphicsObjectManager* pGraphicsObjectManager) override { return RC_OK; }
+			E_RESULT_CODE SetInternalUniformsBuffer(E_INTERNAL_UNIFORM_BUFFER_REGISTERS slot, const U8* pData, U32 dataSize) override { return RC_OK; }
+			E_RESULT_CODE SetObjectsData(const std::vector<TPerObjectShaderData>& objectsData) override { return RC_OK; }
+			E_RESULT_CODE BindObjectData(U32 objectIndex) override { return RC_OK; }
+	};
+}
+
+
+TEST_CASE("MakeRenderCommandSortKey Tests")
+{
+	const TResourceId materialA = TResourceId(1);
+	const TResourceId materialB = TResourceId(70000); /// \note The identifier doesn't fit into 16 bits
+
+	SECTION("TestMakeRenderCommandSortKey_PassOpaqueCommands_NearerObjectsGetGreaterKeys")
+	{
+		REQUIRE(MakeRenderCommandSortKey(0, false, materialA, 1.0f) > MakeRenderCommandSortKey(0, false, materialA, 2.0f));
+		REQUIRE(MakeRenderCommandSortKey(0, false, materialA, 70000.0f) > MakeRenderCommandSortKey(0, false, materialA, 140000.0f));
+	}
+
+	SECTION("TestMakeRenderCommandSortKey_PassTransparentCommands_FartherObjectsGetGreaterKeys")
+	{
+		REQUIRE(MakeRenderCommandSortKey(0, true, materialA, 2.0f) > MakeRenderCommandSortKey(0, true, materialA, 1.0f));
+		REQUIRE(MakeRenderCommandSortKey(0, true, materialA, 140000.0f) > MakeRenderCommandSortKey(0, true, materialB, 70000.0f));
+	}
+
+	SECTION("TestMakeRenderCommandSortKey_PassDifferentMaterials_KeysDoNotAlias")
+	{
+		REQUIRE(MakeRenderCommandSortKey(0, false, materialA, 1.0f) != MakeRenderCommandSortKey(0, false, TResourceId(static_cast<U32>(materialA) + 65536), 1.0f));
+		REQUIRE(MakeRenderCommandSortKey(0, false, materialB, 100.0f) > MakeRenderCommandSortKey(0, false, materialA, 1.0f));
+	}
+
+	SECTION("TestMakeRenderCommandSortKey_PassLayersAndTranslucency_LayersDominateAndOpaqueGoFirst")
+	{
+		REQUIRE(MakeRenderCommandSortKey(1, true, materialA, 1.0f) > MakeRenderCommandSortKey(0, false, materialB, 1.0f));
+		REQUIRE(MakeRenderCommandSortKey(0, false, materialA, 1000.0f) > MakeRenderCommandSortKey(0, true, materialB, 1.0f));
+	}
+}
+
+
+TEST_CASE("CRenderQueue Tests")
+{
+	E_RESULT_CODE result = RC_OK;
+
+	TPtr<CRenderQueue> pRenderQueue = TPtr<CRenderQueue>(CreateRenderQueue(CreateLinearAllocator(1024 * 1024, result), result));
+	REQUIRE(result == RC_OK);
+
+	SECTION("TestSort_PassRandomKeys_CommandsAreOrderedByDescendingKeys")
+	{
+		std::vector<U64> keys;
+
+		U64 seed = 0x9E3779B97F4A7C15ull;
+
+		for (U32 i = 0; i < 1000; ++i)
+		{
+			seed ^= seed << 13;
+			seed ^= seed >> 7;
+			seed ^= seed << 17;
+
+			keys.push_back(seed);
+		}
+
+		for (U64 currKey : keys)
+		{
+			TDrawCommand* pCommand = pRenderQueue->SubmitDrawCommand<TDrawCommand>(currKey);
+			REQUIRE(pCommand);
+
+			pCommand->mStartVertex = static_cast<U32>(currKey & 0xFFFFFFFF);
+		}
+
+		pRenderQueue->Sort();
+
+		std::sort(keys.begin(), keys.end(), std::greater<U64>());
+
+		auto iter = pRenderQueue->GetIterator();
+
+		for (U64 currKey : keys)
+		{
+			REQUIRE(iter.HasNext());
+			REQUIRE(dynamic_cast<TDrawCommand*>(*(iter++))->mStartVertex == static_cast<U32>(currKey & 0xFFFFFFFF));
+		}
+	}
+
+	SECTION("TestSort_PassEqualKeys_OrderOfSubmissionIsPreserved")
+	{
+		for (U32 i = 0; i < 16; ++i)
+		{
+			pRenderQueue->SubmitDrawCommand<TDrawCommand>(i % 2)->mStartVertex = i;
+		}
+
+		pRenderQueue->Sort();
+
+		auto iter = pRenderQueue->GetIterator();
+
+		for (U32 expectedValue : { 1, 3, 5, 7, 9, 11, 13, 15, 0, 2, 4, 6, 8, 10, 12, 14 })
+		{
+			REQUIRE(dynamic_cast<TDrawCommand*>(*(iter++))->mStartVertex == expectedValue);
+		}
+	}
+
+	REQUIRE(pRenderQueue->Clear() == RC_OK);
+}
+
+
+TEST_CASE("CRenderQueue Multithreaded Recording Tests")
+{
+	E_RESULT_CODE result = RC_OK;
+
+	const U32 workerThreadsCount = 4;
+
+	TJobManagerInitParams jobManagerParams;
+	jobManagerParams.mMaxNumOfThreads = workerThreadsCount;
+
+	TPtr<IJobManager> pJobManager = TPtr<IJobManager>(CreateBaseJobManager(jobManagerParams, result));
+	REQUIRE(result == RC_OK);
+
+	std::vector<IAllocator*> workersAllocators;
+
+	for (U32 i = 0; i < workerThreadsCount; ++i)
+	{
+		workersAllocators.push_back(CreateLinearAllocator(1024 * 1024, result));
+		REQUIRE(result == RC_OK);
+	}
+
+	TPtr<CRenderQueue> pRenderQueue = TPtr<CRenderQueue>(CreateRenderQueue(CreateLinearAllocator(1024 * 1024, result), workersAllocators, result));
+	REQUIRE(result == RC_OK);
+
+	SECTION("TestSubmitDrawCommand_RecordCommandsFromJobs_AllCommandsAreMergedAndSorted")
+	{
+		const U32 jobsCount = 64;
+		const U32 commandsPerJob = 100;
+
+		TJobCounter counter;
+
+		for (U32 jobIndex = 0; jobIndex < jobsCount; ++jobIndex)
+		{
+			pJobManager->SubmitJob(&counter, [jobIndex, commandsPerJob, &pRenderQueue]
+			{
+				for (U32 i = 0; i < commandsPerJob; ++i)
+				{
+					const U32 value = jobIndex * commandsPerJob + i;
+					pRenderQueue->SubmitDrawCommand<TDrawCommand>(static_cast<U64>(value))->mStartVertex = value;
+				}
+			});
+		}
+
+		pJobManager->WaitForJobCounter(counter);
+
+		REQUIRE(!pRenderQueue->IsEmpty());
+
+		pRenderQueue->Sort();
+
+		auto iter = pRenderQueue->GetIterator();
+
+		for (U32 expectedValue = jobsCount * commandsPerJob; expectedValue > 0; --expectedValue)
+		{
+			REQUIRE(iter.HasNext());
+			REQUIRE(dynamic_cast<TDrawCommand*>(*(iter++))->mStartVertex == expectedValue - 1);
+		}
+
+		REQUIRE(!iter.HasNext());
+	}
+
+	SECTION("TestSort_RecordEqualKeysFromJobs_CommandsAreOrderedBySubmissionIndices")
+	{
+		const U32 commandsCount = 10000;
+
+		/// \note Ranges are distributed among workers differently on each run, but the order should match submission indices
+		REQUIRE(RC_OK == pJobManager->ParallelFor(commandsCount, sizeof(U32), [&pRenderQueue](USIZE first, USIZE last)
+		{
+			for (USIZE i = first; i < last; ++i)
+			{
+				pRenderQueue->SubmitDrawCommand<TDrawCommand>(static_cast<U64>(i % 2), static_cast<U32>(i))->mStartVertex = static_cast<U32>(i);
+			}
+		}));
+
+		pRenderQueue->Sort();
+
+		auto iter = pRenderQueue->GetIterator();
+
+		for (U32 expectedValue = 1; expectedValue < commandsCount; expectedValue += 2)
+		{
+			REQUIRE(iter.HasNext());
+			REQUIRE(dynamic_cast<TDrawCommand*>(*(iter++))->mStartVertex == expectedValue);
+		}
+
+		for (U32 expectedValue = 0; expectedValue < commandsCount; expectedValue += 2)
+		{
+			REQUIRE(iter.HasNext());
+			REQUIRE(dynamic_cast<TDrawCommand*>(*(iter++))->mStartVertex == expectedValue);
+		}
+
+		REQUIRE(!iter.HasNext());
+	}
+
+	SECTION("TestSort_RecordEqualKeysFromDifferentRecorders_CommandsAreGroupedByRecorders")
+	{
+		const U32 commandsCount = 1000;
+
+		/// \note Both recorders use the same raw indices, the skinned meshes' ones should go after all static meshes' commands
+		TJobCounter counter;
+
+		const E_RENDER_COMMANDS_RECORDER_TYPE recorders[] { E_RENDER_COMMANDS_RECORDER_TYPE::RCRT_SKINNED_MESHES, E_RENDER_COMMANDS_RECORDER_TYPE::RCRT_STATIC_MESHES };
+
+		for (E_RENDER_COMMANDS_RECORDER_TYPE currRecorder : recorders)
+		{
+			pJobManager->SubmitJob(&counter, [currRecorder, commandsCount, &pRenderQueue]
+			{
+				const U32 baseValue = (E_RENDER_COMMANDS_RECORDER_TYPE::RCRT_SKINNED_MESHES == currRecorder) ? commandsCount : 0;
+
+				for (U32 i = 0; i < commandsCount; ++i)
+				{
+					pRenderQueue->SubmitDrawCommand<TDrawCommand>(0, MakeRenderCommandSubmissionIndex(currRecorder, i))->mStartVertex = baseValue + i;
+				}
+			});
+		}
+
+		pJobManager->WaitForJobCounter(counter);
+
+		pRenderQueue->Sort();
+
+		auto iter = pRenderQueue->GetIterator();
+
+		for (U32 expectedValue = 0; expectedValue < 2 * commandsCount; ++expectedValue)
+		{
+			REQUIRE(iter.HasNext());
+			REQUIRE(dynamic_cast<TDrawCommand*>(*(iter++))->mStartVertex == expectedValue);
+		}
+
+		REQUIRE(!iter.HasNext());
+	}
+
+	REQUIRE(pRenderQueue->Clear() == RC_OK);
+	REQUIRE(pRenderQueue->IsEmpty());
+}
+
+
+TEST_CASE("TRenderStateCache Tests")
+{
+	E_RESULT_CODE result = RC_OK;
+
+	TPtr<IEventManager> pEventManager = TPtr<IEventManager>(CreateEventManager(result));
+	REQUIRE(result == RC_OK);
+
+	TPtr<IWindowSystem> pWindowSystem = TPtr<IWindowSystem>(CreateProxyWindowSystem(pEventManager, "Test", 640, 480, 0x0, result));
+	REQUIRE(result == RC_OK);
+
+	TPtr<IGraphicsContext> pGraphicsContext = TPtr<IGraphicsContext>(CreateProxyGraphicsContext(pWindowSystem, result));
+	REQUIRE(result == RC_OK);
+
+	CProxyGraphicsContext* pProxyGraphicsContext = dynamic_cast<CProxyGraphicsContext*>(pGraphicsContext.Get());
+	REQUIRE(pProxyGraphicsContext);
+
+	TPtr<IJobManager> pJobManager = TPtr<IJobManager>(CreateBaseJobManager(TJobManagerInitParams {}, result));
+	REQUIRE(result == RC_OK);
+
+	TPtr<IResourceManager> pResourceManager = TPtr<IResourceManager>(CreateResourceManager(pJobManager, result));
+	REQUIRE(result == RC_OK);
+
+	REQUIRE(pResourceManager->RegisterLoader(new CTestResourceLoader<CTestShader, IShader>()).IsOk());
+	REQUIRE(pResourceManager->RegisterLoader(new CTestResourceLoader<CTestMaterial, IMaterial>()).IsOk());
+	REQUIRE(pResourceManager->RegisterFactory(new CTestResourceFactory<CTestShader, IShader>(pResourceManager.Get(), pGraphicsContext.Get())).IsOk());
+	REQUIRE(pResourceManager->RegisterFactory(new CTestResourceFactory<CTestMaterial, IMaterial>(pResourceManager.Get(), pGraphicsContext.Get())).IsOk());
+
+	const TResourceId shaderHandle = pResourceManager->Load<IShader>("TestShader", E_RESOURCE_LOADING_POLICY::SYNCED);
+	REQUIRE(TResourceId::Invalid != shaderHandle);
+
+	const TResourceId firstMaterialHandle = pResourceManager->Load<IMaterial>("FirstMaterial", E_RESOURCE_LOADING_POLICY::SYNCED);
+	const TResourceId secondMaterialHandle = pResourceManager->Load<IMaterial>("SecondMaterial", E_RESOURCE_LOADING_POLICY::SYNCED);
+
+	TPtr<CTestMaterial> pFirstMaterial = DynamicPtrCast<CTestMaterial>(pResourceManager->GetResource(firstMaterialHandle));
+	TPtr<CTestMaterial> pSecondMaterial = DynamicPtrCast<CTestMaterial>(pResourceManager->GetResource(secondMaterialHandle));
+	REQUIRE((pFirstMaterial && pSecondMaterial));
+
+	pFirstMaterial->SetShaderHandle(shaderHandle);
+	pSecondMaterial->SetShaderHandle(shaderHandle);
+
+	CTestVertexDeclaration* pVertexDeclaration = new CTestVertexDeclaration();
+	CTestVertexBuffer* pVertexBuffer = new CTestVertexBuffer();
+
+	CTestGlobalShaderProperties globalShaderProperties;
+
+	auto makeCommand = [pVertexDeclaration, pVertexBuffer](TResourceId materialHandle, TMaterialInstanceId instanceId)
+	{
+		TDrawCommand command;
+
+		command.mPrimitiveType       = E_PRIMITIVE_TOPOLOGY_TYPE::PTT_TRIANGLE_LIST;
+		command.mpVertexBuffer       = pVertexBuffer;
+		command.mpVertexDeclaration  = pVertexDeclaration;
+		command.mMaterialHandle      = materialHandle;
+		command.mMaterialInstanceId  = instanceId;
+		command.mObjectDataIndex     = 0;
+		command.mStartVertex         = 0;
+		command.mNumOfVertices       = 3;
+
+		return command;
+	};
+
+	/// \note The pass is already sorted, so draws with the same material and instance go one by one
+	std::vector<TDrawCommand> pass
+	{
+		makeCommand(firstMaterialHandle, DefaultMaterialInstanceId),
+		makeCommand(firstMaterialHandle, DefaultMaterialInstanceId),
+		makeCommand(firstMaterialHandle, TMaterialInstanceId(1)),
+		makeCommand(secondMaterialHandle, DefaultMaterialInstanceId),
+	};
+
+	pProxyGraphicsContext->ResetStats();
+
+	SECTION("TestSubmit_PassStateCache_RedundantBindsAreSkipped")
+	{
+		TRenderStateCache stateCache;
+		stateCache.Invalidate();
+
+		for (TDrawCommand& currCommand : pass)
+		{
+			REQUIRE(RC_OK == currCommand.Submit(pGraphicsContext.Get(), pResourceManager.Get(), &globalShaderProperties, &stateCache));
+		}
+
+		const TProxyGraphicsContextStats& stats = pProxyGraphicsContext->GetStats();
+
+		/// \note Pipeline's states are bound once per material, the instance switch only rebinds user data
+		REQUIRE(stats.mDrawCallsCount == 4);
+		REQUIRE(stats.mBlendStateBindsCount == 2);
+		REQUIRE(stats.mDepthStencilStateBindsCount == 2);
+		REQUIRE(stats.mRasterizerStateBindsCount == 2);
+
+		REQUIRE(pFirstMaterial->mInstanceDataBindsCount == 2);
+		REQUIRE(pSecondMaterial->mInstanceDataBindsCount == 1);
+
+		/// \note Both materials share the shader, so the vertex declaration and the buffer are bound once
+		REQUIRE(pVertexDeclaration->mBindsCount == 1);
+		REQUIRE(pVertexBuffer->mBindsCount == 1);
+
+		REQUIRE(stateCache.mBindsCount == 5);
+		REQUIRE(stateCache.mSkippedBindsCount == 7);
+
+		/// \note The next pass starts from a clean state, so everything is bound again
+		stateCache.Invalidate();
+		pProxyGraphicsContext->ResetStats();
+
+		REQUIRE(RC_OK == pass.front().Submit(pGraphicsContext.Get(), pResourceManager.Get(), &globalShaderProperties, &stateCache));
+
+		REQUIRE(pProxyGraphicsContext->GetStats().mBlendStateBindsCount == 1);
+		REQUIRE(pVertexDeclaration->mBindsCount == 2);
+		REQUIRE(pVertexBuffer->mBindsCount == 2);
+	}
+
+	SECTION("TestSubmit_PassNoStateCache_AllStatesAreRebound")
+	{
+		for (TDrawCommand& currCommand : pass)
+		{
+			REQUIRE(RC_OK == currCommand.Submit(pGraphicsContext.Get(), pResourceManager.Get(), &globalShaderProperties, nullptr));
+		}
+
+		const TProxyGraphicsContextStats& stats = pProxyGraphicsContext->GetStats();
+
+		REQUIRE(stats.mDrawCallsCount == 4);
+		REQUIRE(stats.mBlendStateBindsCount == 4);
+		REQUIRE(stats.mDepthStencilStateBindsCount == 4);
+		REQUIRE(stats.mRasterizerStateBindsCount == 4);
+
+		REQUIRE(pVertexDeclaration->mBindsCount == 4);
+		REQUIRE(pVertexBuffer->mBindsCount == 4);
+	}
+
+	SECTION("TestBindMaterial_SwitchInstancedShader_MaterialIsRebound")
+	{
+		TRenderStateCache stateCache;
+		stateCache.Invalidate();
+
+		REQUIRE(stateCache.BindMaterial(pResourceManager.Get(), firstMaterialHandle, DefaultMaterialInstanceId));
+		REQUIRE_FALSE(pFirstMaterial->mIsInstancedShaderBound);
+
+		/// \note Instanced draw calls of the same material use another shader, so the material's states are bound again
+		REQUIRE(stateCache.BindMaterial(pResourceManager.Get(), firstMaterialHandle, DefaultMaterialInstanceId, true));
+		REQUIRE(stateCache.BindMaterial(pResourceManager.Get(), firstMaterialHandle, DefaultMaterialInstanceId, true));
+		REQUIRE(pFirstMaterial->mIsInstancedShaderBound);
+
+		REQUIRE(pProxyGraphicsContext->GetStats().mBlendStateBindsCount == 2);
+		REQUIRE(stateCache.mBindsCount == 2);
+		REQUIRE(stateCache.mSkippedBindsCount == 1);
+	}
+
+	pVertexDeclaration->Free();
+	pVertexBuffer->Free();
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <chrono>
+#include <memory>
+
+
+using namespace TDEngine2;
+
+
+/*!
+	\note The benchmarks are hidden and should be run explicitly with a release build, e.g. tests "[benchmark]"
+*/
+
+TEST_CASE("ClusteredLighting Benchmarks", "[.][benchmark]")
+{
+	const F32 zNear = 0.1f;
+	const F32 zFar  = 500.0f;
+
+	const TMatrix4 projMatrix = PerspectiveProj(0.5f * CMathConstants::Pi, 16.0f / 9.0f, zNear, zFar, 0.0f, 1.0f, -1.0f);
+
+	auto pData = std::make_unique<TLightClustersShaderData>();
+
+	/// \note Small lights are scattered over the view frustum like ones on a night level
+	U32 seed = 0x9E3779B9;
+
+	auto nextRandom = [&seed]
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+
+		return static_cast<F32>(seed % 10000) / 10000.0f;
+	};
+
+	for (U32 i = 0; i < MaxPointLightsCount; ++i)
+	{
+		const F32 depth = 1.0f + nextRandom() * 100.0f;
+
+		TPointLightData& light = pData->mPointLights[i];
+
+		light.mPosition  = TVector4((nextRandom() - 0.5f) * 2.0f * depth, (nextRandom() - 0.5f) * depth, depth, 1.0f);
+		light.mRange     = 1.0f + nextRandom() * 4.0f;
+		light.mIntensity = 1.0f;
+	}
+
+	SECTION("TestAssignPointLightsToClusters_MaxPointLights_TakesLessThanMillisecond")
+	{
+		const U32 iterationsCount = 200;
+
+		U32 indicesCount = 0;
+
+		const auto startTime = std::chrono::high_resolution_clock::now();
+
+		for (U32 k = 0; k < iterationsCount; ++k)
+		{
+			pData->mPointLightsCount = MaxPointLightsCount;
+			indicesCount = AssignPointLightsToClusters(nullptr, IdentityMatrix4, projMatrix, zNear, zFar, *pData);
+		}
+
+		const auto elapsedTime = std::chrono::duration<F64, std::micro>(std::chrono::high_resolution_clock::now() - startTime).count();
+		const F64 timePerCall = elapsedTime / static_cast<F64>(iterationsCount);
+
+		WARN("AssignPointLightsToClusters (" << MaxPointLightsCount << " lights, single thread): " << timePerCall << " us per call, " << indicesCount << " references");
+
+		REQUIRE(timePerCall < 1000.0);
+	}
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+
+
+using namespace TDEngine2;
+
+
+/// \note Mirrors GetLightClusterIndex from TDEngine2Globals.inc
+static U32 GetClusterIndex(const TMatrix4& viewMatrix, const TMatrix4& projMatrix, const TLightClustersShaderData& data, const TVector3& point)
+{
+	const TVector4 viewPos = viewMatrix * TVector4(point, 1.0f);
+	const TVector4 clipPos = projMatrix * viewPos;
+
+	const F32 u = std::min(std::max((clipPos.x / clipPos.w) * 0.5f + 0.5f, 0.0f), 0.9999f);
+	const F32 v = std::min(std::max((clipPos.y / clipPos.w) * 0.5f + 0.5f, 0.0f), 0.9999f);
+	const F32 slice = logf(std::max(data.mClustersParams.w * viewPos.z, data.mClustersParams.x) / data.mClustersParams.x) * data.mClustersParams.z;
+
+	const U32 x = static_cast<U32>(u * LightClustersCountX);
+	const U32 y = static_cast<U32>(v * LightClustersCountY);
+	const U32 z = std::min(static_cast<U32>(slice), LightClustersCountZ - 1);
+
+	return x + LightClustersCountX * (y + LightClustersCountY * z);
+}
+
+
+static bool ClusterContainsLight(const TLightClustersShaderData& data, U32 clusterIndex, U32 lightIndex)
+{
+	const U32 offset = data.mClusters[clusterIndex] & 0xFFFF;
+	const U32 count  = data.mClusters[clusterIndex] >> 16;
+
+	return std::find(data.mLightIndices + offset, data.mLightIndices + offset + count, static_cast<U16>(lightIndex)) != data.mLightIndices + offset + count;
+}
+
+
+TEST_CASE("ClusteredLighting Tests")
+{
+	const F32 zNear = 0.1f;
+	const F32 zFar  = 1000.0f;
+
+	const TMatrix4 viewMatrix = IdentityMatrix4;
+	const TMatrix4 projMatrix = PerspectiveProj(0.5f * CMathConstants::Pi, 16.0f / 9.0f, zNear, zFar, 0.0f, 1.0f, -1.0f);
+
+	auto pData = std::make_unique<TLightClustersShaderData>();
+
+	auto addLight = [&pData](const TVector3& position, F32 range)
+	{
+		TPointLightData& light = pData->mPointLights[pData->mPointLightsCount++];
+
+		light.mPosition  = TVector4(position, 1.0f);
+		light.mRange     = range;
+		light.mIntensity = 1.0f;
+	};
+
+	SECTION("TestAssignPointLightsToClusters_PassVisibleLights_ClustersOfTheirCentersReferenceThem")
+	{
+		const TVector3 positions[] { TVector3(0.0f, 0.0f, 10.0f), TVector3(-5.0f, 2.0f, 30.0f), TVector3(20.0f, -3.0f, 200.0f) };
+
+		for (auto&& currPosition : positions)
+		{
+			addLight(currPosition, 2.0f);
+		}
+
+		REQUIRE(AssignPointLightsToClusters(nullptr, viewMatrix, projMatrix, zNear, zFar, *pData) > 0);
+
+		for (U32 i = 0; i < 3; ++i)
+		{
+			REQUIRE(ClusterContainsLight(*pData, GetClusterIndex(viewMatrix, projMatrix, *pData, positions[i]), i));
+			REQUIRE(ClusterContainsLight(*pData, GetClusterIndex(viewMatrix, projMatrix, *pData, positions[i] + TVector3(1.9f, 0.0f, 0.0f)), i));
+		}
+
+		/// \note The first light doesn't reach the farthest one
+		REQUIRE(!ClusterContainsLight(*pData, GetClusterIndex(viewMatrix, projMatrix, *pData, positions[2]), 0));
+	}
+
+	SECTION("TestAssignPointLightsToClusters_PassOrthographicProjection_LightsAreSlicedByDepth")
+	{
+		const TMatrix4 orthoProjMatrix = OrthographicProj(-100.0f, 100.0f, 100.0f, -100.0f, zNear, zFar, 0.0f, 1.0f, -1.0f, false);
+
+		const TVector3 positions[] { TVector3(0.0f, 0.0f, 5.0f), TVector3(0.0f, 0.0f, 500.0f) };
+
+		for (auto&& currPosition : positions)
+		{
+			addLight(currPosition, 1.0f);
+		}
+
+		REQUIRE(AssignPointLightsToClusters(nullptr, viewMatrix, orthoProjMatrix, zNear, zFar, *pData) > 0);
+
+		const U32 nearClusterIndex = GetClusterIndex(viewMatrix, orthoProjMatrix, *pData, positions[0]);
+		const U32 farClusterIndex  = GetClusterIndex(viewMatrix, orthoProjMatrix, *pData, positions[1]);
+
+		/// \note w of clip space is constant, so both lights would fall into the first slice if it were used as a depth
+		REQUIRE(nearClusterIndex != farClusterIndex);
+
+		REQUIRE(ClusterContainsLight(*pData, nearClusterIndex, 0));
+		REQUIRE(!ClusterContainsLight(*pData, nearClusterIndex, 1));
+		REQUIRE(ClusterContainsLight(*pData, farClusterIndex, 1));
+		REQUIRE(!ClusterContainsLight(*pData, farClusterIndex, 0));
+	}
+
+	SECTION("TestAssignPointLightsToClusters_PassLightBehindCamera_NoClustersReferenceIt")
+	{
+		addLight(TVector3(0.0f, 0.0f, -50.0f), 5.0f);
+
+		REQUIRE(AssignPointLightsToClusters(nullptr, viewMatrix, projMatrix, zNear, zFar, *pData) == 0);
+
+		for (U32 i = 0; i < LightClustersCount; ++i)
+		{
+			REQUIRE((pData->mClusters[i] >> 16) == 0);
+		}
+	}
+
+	SECTION("TestAssignPointLightsToClusters_PassTooManyReferences_IndicesAreTruncatedWithinBuffer")
+	{
+		while (pData->mPointLightsCount < MaxPointLightsCount)
+		{
+			addLight(ZeroVector3, zFar);
+		}
+
+		REQUIRE(AssignPointLightsToClusters(nullptr, viewMatrix, projMatrix, zNear, zFar, *pData) == MaxLightClustersIndicesCount);
+
+		const U32 lastClusterData = pData->mClusters[LightClustersCount - 1];
+		REQUIRE((lastClusterData & 0xFFFF) + (lastClusterData >> 16) <= MaxLightClustersIndicesCount);
+	}
+
+	SECTION("TestAssignPointLightsToClusters_PassTooManyReferences_FarClustersAreNotStarved")
+	{
+		while (pData->mPointLightsCount < MaxPointLightsCount)
+		{
+			addLight(ZeroVector3, zFar);
+		}
+
+		REQUIRE(AssignPointLightsToClusters(nullptr, viewMatrix, projMatrix, zNear, zFar, *pData) == MaxLightClustersIndicesCount);
+
+		/// \note All clusters are limited evenly and keep the lights with the lowest indices
+		for (U32 i = 0; i < LightClustersCount; ++i)
+		{
+			const U32 clusterLightsCount = pData->mClusters[i] >> 16;
+
+			REQUIRE(clusterLightsCount >= MaxLightClustersIndicesCount / LightClustersCount);
+			REQUIRE(clusterLightsCount <= MaxLightClustersIndicesCount / LightClustersCount + 1);
+			REQUIRE(ClusterContainsLight(*pData, i, 0));
+		}
+	}
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <cmath>
+
+
+using namespace TDEngine2;
+
+
+TEST_CASE("ShadowCascades Tests")
+{
+	const F32 zNear = 0.1f;
+	const F32 zFar  = 1000.0f;
+
+	const TMatrix4 projMatrix = PerspectiveProj(0.5f * CMathConstants::Pi, 16.0f / 9.0f, zNear, zFar, 0.0f, 1.0f, -1.0f);
+
+	SECTION("TestComputeShadowCascadesSplits_PassCascadesCount_SplitsGrowAndEndAtShadowDistance")
+	{
+		F32 splits[MaxShadowCascadesCount];
+
+		ComputeShadowCascadesSplits(zNear, 100.0f, 3, 0.75f, splits);
+
+		REQUIRE(splits[0] > zNear);
+		REQUIRE(splits[0] < splits[1]);
+		REQUIRE(splits[1] < splits[2]);
+		REQUIRE(std::abs(splits[2] - 100.0f) < 1e-3f);
+		REQUIRE(splits[3] == splits[2]);
+	}
+
+	SECTION("TestComputeShadowCascadesSplits_PassUniformLambda_SplitsAreEvenlyDistributed")
+	{
+		F32 splits[MaxShadowCascadesCount];
+
+		ComputeShadowCascadesSplits(1.0f, 101.0f, 4, 0.0f, splits);
+
+		for (U32 i = 0; i < MaxShadowCascadesCount; ++i)
+		{
+			REQUIRE(std::abs(splits[i] - (1.0f + 25.0f * (i + 1))) < 1e-3f);
+		}
+	}
+
+	SECTION("TestComputeShadowCascadeBounds_RotateCamera_RadiusStaysTheSame")
+	{
+		const TShadowCascadeBounds firstBounds  = ComputeShadowCascadeBounds(projMatrix, IdentityMatrix4, 0.0f, zNear, zFar, 10.0f, 40.0f);
+		const TShadowCascadeBounds secondBounds = ComputeShadowCascadeBounds(projMatrix, RotationMatrix(TQuaternion(TVector3(0.0f, 0.7f, 0.1f))), 0.0f, zNear, zFar, 10.0f, 40.0f);
+
+		REQUIRE(firstBounds.mRadius > 0.0f);
+		REQUIRE(firstBounds.mRadius == secondBounds.mRadius);
+		REQUIRE(Length(firstBounds.mCenter - secondBounds.mCenter) > 1.0f);
+	}
+
+	SECTION("TestUpdateCachedShadowCascadeBounds_MoveSliceWithinMargin_CachedBoundsAreKept")
+	{
+		TShadowCascadeBounds cachedBounds;
+
+		REQUIRE(UpdateCachedShadowCascadeBounds({ ZeroVector3, 10.0f }, 0.25f, cachedBounds));
+		REQUIRE(cachedBounds.mRadius == 12.5f);
+
+		REQUIRE(!UpdateCachedShadowCascadeBounds({ TVector3(2.0f, 0.0f, 0.0f), 10.0f }, 0.25f, cachedBounds));
+		REQUIRE(Length(cachedBounds.mCenter) < 1e-5f);
+
+		REQUIRE(UpdateCachedShadowCascadeBounds({ TVector3(3.0f, 0.0f, 0.0f), 10.0f }, 0.25f, cachedBounds));
+		REQUIRE(std::abs(cachedBounds.mCenter.x - 3.0f) < 1e-5f);
+	}
+
+	SECTION("TestComputeShadowCascadeMatrix_PassArbitraryCenter_TranslationIsSnappedToTexels")
+	{
+		const U32 shadowMapSizes = 1024;
+
+		const TMatrix4 cascadeMatrix = ComputeShadowCascadeMatrix(Normalize(TVector3(0.3f, -1.0f, 0.2f)), { TVector3(3.17f, 1.3f, -7.91f), 16.0f }, 100.0f, shadowMapSizes, 0.0f);
+
+		for (U8 i = 0; i < 2; ++i)
+		{
+			const F32 texelsOffset = 0.5f * cascadeMatrix.m[i][3] * shadowMapSizes;
+			REQUIRE(std::abs(texelsOffset - roundf(texelsOffset)) < 1e-2f);
+		}
+	}
+
+	SECTION("TestTestShadowCascadeAABB_PassBoxes_OnlyBoxesWithinVolumeOrTowardsLightPass")
+	{
+		const TVector3 lightDirection = TVector3(0.0f, -1.0f, 0.0f);
+		const TMatrix4 cascadeMatrix = ComputeShadowCascadeMatrix(lightDirection, { ZeroVector3, 10.0f }, 50.0f, 1024, 0.0f);
+
+		REQUIRE(TestShadowCascadeAABB(cascadeMatrix, TAABB(ZeroVector3, 2.0f, 2.0f, 2.0f), 0.0f));
+		REQUIRE(TestShadowCascadeAABB(cascadeMatrix, TAABB(TVector3(0.0f, 40.0f, 0.0f), 2.0f, 2.0f, 2.0f), 0.0f)); /// \note Above the volume but still casts into it
+		REQUIRE(!TestShadowCascadeAABB(cascadeMatrix, TAABB(TVector3(30.0f, 0.0f, 0.0f), 2.0f, 2.0f, 2.0f), 0.0f));
+		REQUIRE(!TestShadowCascadeAABB(cascadeMatrix, TAABB(TVector3(0.0f, -30.0f, 0.0f), 2.0f, 2.0f, 2.0f), 0.0f));
+	}
+
+	SECTION("TestUpdateShadowCascadesCastersState_DynamicCasterLeavesCascade_CascadeIsRedrawnOnceMore")
+	{
+		const U32 cascadesCount = 3;
+		const U32 staticCastersHashes[MaxShadowCascadesCount] { 1, 2, 3, 0 };
+
+		TShadowCascadesCastersState castersState;
+
+		REQUIRE(UpdateShadowCascadesCastersState(cascadesCount, 0x0, staticCastersHashes, castersState) == 0x7); /// \note Hashes of static casters are new
+		REQUIRE(UpdateShadowCascadesCastersState(cascadesCount, 0x4, staticCastersHashes, castersState) == 0x4);
+
+		/// \note The caster has moved into the second cascade, the third one still contains its shadow
+		REQUIRE(UpdateShadowCascadesCastersState(cascadesCount, 0x2, staticCastersHashes, castersState) == 0x6);
+		REQUIRE(UpdateShadowCascadesCastersState(cascadesCount, 0x0, staticCastersHashes, castersState) == 0x2);
+		REQUIRE(UpdateShadowCascadesCastersState(cascadesCount, 0x0, staticCastersHashes, castersState) == 0x0);
+	}
+
+	SECTION("TestUpdateShadowCascadesCastersState_StaticCastersChange_OnlyTheirCascadesAreRedrawn")
+	{
+		const U32 cascadesCount = 3;
+
+		U32 staticCastersHashes[MaxShadowCascadesCount] { 1, 2, 3, 0 };
+
+		TShadowCascadesCastersState castersState;
+		UpdateShadowCascadesCastersState(cascadesCount, 0x0, staticCastersHashes, castersState);
+
+		staticCastersHashes[1] = 42;
+
+		REQUIRE(UpdateShadowCascadesCastersState(cascadesCount, 0x0, staticCastersHashes, castersState) == 0x2);
+		REQUIRE(UpdateShadowCascadesCastersState(cascadesCount, 0x0, staticCastersHashes, castersState) == 0x0);
+	}
+
+	SECTION("TestMakeShadowCasterSortKey_PassCascades_FirstCascadeGoesFirstAndIndexIsDecoded")
+	{
+		REQUIRE(MakeShadowCasterSortKey(0, 0) > MakeShadowCasterSortKey(1, 0xFFFFFFFF));
+		REQUIRE(MakeShadowCasterSortKey(2, 5) > MakeShadowCasterSortKey(2, 4));
+
+		for (U32 i = 0; i < MaxShadowCascadesCount; ++i)
+		{
+			REQUIRE(GetShadowCascadeIndexFromSortKey(MakeShadowCasterSortKey(i, 42)) == i);
+		}
+	}
+}
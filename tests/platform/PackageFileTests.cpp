@@ -0,0 +1,307 @@
+#include <catch2/catch.hpp>
+#include <TDEngine2.h>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+
+using namespace TDEngine2;
+
+
+static void WriteBytesToFile(const std::string& path, const std::vector<U8>& data)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const C8*>(data.data()), data.size());
+}
+
+
+static std::vector<U8> ReadBytesFromFile(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	return std::vector<U8>(std::istreambuf_iterator<C8>(file), std::istreambuf_iterator<C8>());
+}
+
+
+template <typename T>
+static void AppendValue(std::vector<U8>& output, T value)
+{
+	value = SwapBytes(value);
+
+	const U8* pValueBytes = reinterpret_cast<const U8*>(&value);
+	output.insert(output.end(), pValueBytes, pValueBytes + sizeof(T));
+}
+
+
+TEST_CASE("PackageFile Tests")
+{
+	SECTION("TestBuildPackageTableOfContents_PassEmptyFilesTable_ReturnsNoBuckets")
+	{
+		REQUIRE(BuildPackageTableOfContents({}).empty());
+		REQUIRE(FindPackageFileEntryIndex({}, {}, "file.txt") == TPackageTableOfContentsBucket::mInvalidEntryIndex);
+	}
+
+	SECTION("TestFindPackageFileEntryIndex_PassFilesPaths_ReturnsIndicesOfEntries")
+	{
+		std::vector<TPackageFileEntryInfo> filesTable;
+
+		for (U32 i = 0; i < 1000; ++i)
+		{
+			TPackageFileEntryInfo entry;
+			entry.mFilename = "Resources/Textures/texture" + std::to_string(i) + ".png";
+
+			filesTable.push_back(entry);
+		}
+
+		const std::vector<TPackageTableOfContentsBucket> tableOfContents = BuildPackageTableOfContents(filesTable);
+
+		REQUIRE(tableOfContents.size() >= 2 * filesTable.size());
+		REQUIRE((tableOfContents.size() & (tableOfContents.size() - 1)) == 0);
+
+		for (U32 i = 0; i < static_cast<U32>(filesTable.size()); ++i)
+		{
+			REQUIRE(FindPackageFileEntryIndex(tableOfContents, filesTable, filesTable[i].mFilename) == i);
+		}
+
+		REQUIRE(FindPackageFileEntryIndex(tableOfContents, filesTable, "Resources/Textures/texture1000.png") == TPackageTableOfContentsBucket::mInvalidEntryIndex);
+		REQUIRE(FindPackageFileEntryIndex(tableOfContents, filesTable, "") == TPackageTableOfContentsBucket::mInvalidEntryIndex);
+	}
+
+	SECTION("TestDecompressPackageFileChunks_PassCompressedChunks_ReturnsOriginalDataOfAnyRangeOfChunks")
+	{
+		const U32 chunkSize = 1024;
+
+		/// \note The first half is well compressible, the second one is a noise which is stored as raw chunks
+		std::vector<U8> data(10 * chunkSize + 100);
+
+		U32 seed = 42;
+
+		for (USIZE i = 0; i < data.size(); ++i)
+		{
+			seed = seed * 1664525 + 1013904223;
+			data[i] = (i < data.size() / 2) ? static_cast<U8>(i % 7) : static_cast<U8>(seed >> 24);
+		}
+
+		std::vector<U8> compressedData;
+		REQUIRE(RC_OK == CompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC::ZLIB, data, chunkSize, compressedData));
+
+		const USIZE chunksCount = 11;
+
+		std::vector<U64> chunksOffsets(chunksCount + 1);
+
+		for (USIZE i = 0; i < chunksOffsets.size(); ++i)
+		{
+			memcpy(&chunksOffsets[i], &compressedData[i * sizeof(U64)], sizeof(U64));
+			chunksOffsets[i] = SwapBytes(chunksOffsets[i]);
+		}
+
+		REQUIRE(chunksOffsets.front() == sizeof(U64) * chunksOffsets.size());
+		REQUIRE(chunksOffsets.back() == compressedData.size());
+		REQUIRE(compressedData.size() < data.size());
+
+		std::vector<U8> decompressedData(data.size());
+
+		REQUIRE(RC_OK == DecompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC::ZLIB, chunksOffsets.data(), chunksCount, &compressedData[chunksOffsets.front()], chunkSize,
+													 decompressedData.data(), decompressedData.size(), nullptr));
+		REQUIRE(decompressedData == data);
+
+		/// \note Decode only chunks [3; 6)
+		std::vector<U8> rangeData(3 * chunkSize);
+
+		REQUIRE(RC_OK == DecompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC::ZLIB, &chunksOffsets[3], 3, &compressedData[chunksOffsets[3]], chunkSize,
+													 rangeData.data(), rangeData.size(), nullptr));
+		REQUIRE(std::equal(rangeData.begin(), rangeData.end(), data.begin() + 3 * chunkSize));
+	}
+
+	SECTION("TestDecompressPackageFileChunks_PassInvalidArguments_ReturnsErrors")
+	{
+		std::vector<U8> compressedData;
+		REQUIRE(RC_INVALID_ARGS == CompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC::NONE, { 1, 2, 3 }, 1024, compressedData));
+		REQUIRE(RC_INVALID_ARGS == CompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC::ZLIB, { 1, 2, 3 }, 0, compressedData));
+
+		const U64 chunksOffsets[] { 0, 4 };
+		const U8 corruptedChunk[] { 1, 2, 3, 4 };
+
+		U8 buffer[16];
+
+		REQUIRE(RC_INVALID_ARGS == DecompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC::ZLIB, chunksOffsets, 1, corruptedChunk, 8, buffer, 16, nullptr));
+		REQUIRE(RC_FAIL == DecompressPackageFileChunks(E_PACKAGE_ENTRY_CODEC::ZLIB, chunksOffsets, 1, corruptedChunk, 8, buffer, 8, nullptr));
+	}
+}
+
+
+TEST_CASE("PackageFile Reading And Writing Tests")
+{
+	E_RESULT_CODE result = RC_OK;
+
+	IFileSystem* pFileSystem = nullptr;
+
+#if defined (TDE2_USE_WINPLATFORM)
+	pFileSystem = CreateWin32FileSystem(result);
+#elif defined (TDE2_USE_UNIXPLATFORM)
+	pFileSystem = CreateUnixFileSystem(result);
+#else
+#endif
+
+	REQUIRE(pFileSystem);
+	REQUIRE(result == RC_OK);
+
+	REQUIRE(RC_OK == pFileSystem->RegisterFileFactory<IBinaryFileReader>({ CreateBinaryFileReader, E_FILE_FACTORY_TYPE::READER }));
+	REQUIRE(RC_OK == pFileSystem->RegisterFileFactory<IPackageFileReader>({ CreatePackageFileReader, E_FILE_FACTORY_TYPE::READER }));
+	REQUIRE(RC_OK == pFileSystem->RegisterFileFactory<IPackageFileWriter>({ CreatePackageFileWriter, E_FILE_FACTORY_TYPE::WRITER }));
+
+	const std::string packagePath = "PackageFileTests.pak";
+	const std::string rawFilename = "PackageFileTestsRaw.bin";
+	const std::string compressedFilename = "PackageFileTestsCompressed.bin";
+
+	std::vector<U8> rawData(4000);
+	std::vector<U8> compressedData(2 * PackageFileChunkSize + 17);
+
+	for (USIZE i = 0; i < rawData.size(); ++i)
+	{
+		rawData[i] = static_cast<U8>(i * 31 + 7);
+	}
+
+	for (USIZE i = 0; i < compressedData.size(); ++i)
+	{
+		compressedData[i] = static_cast<U8>(i % 13);
+	}
+
+	auto writePackage = [&]
+	{
+		WriteBytesToFile(rawFilename, rawData);
+		WriteBytesToFile(compressedFilename, compressedData);
+
+		auto pPackageWriter = pFileSystem->Get<IPackageFileWriter>(pFileSystem->Open<IPackageFileWriter>(packagePath, true).Get());
+		auto pRawFile = pFileSystem->Get<IBinaryFileReader>(pFileSystem->Open<IBinaryFileReader>(rawFilename).Get());
+		auto pCompressedFile = pFileSystem->Get<IBinaryFileReader>(pFileSystem->Open<IBinaryFileReader>(compressedFilename).Get());
+
+		REQUIRE(pPackageWriter);
+		REQUIRE(pRawFile);
+		REQUIRE(pCompressedFile);
+
+		REQUIRE(RC_OK == pPackageWriter->WriteFile(Wrench::StringUtils::GetEmptyStr(), *pRawFile));
+		REQUIRE(RC_OK == pPackageWriter->WriteFile(Wrench::StringUtils::GetEmptyStr(), *pCompressedFile, true));
+
+		REQUIRE(RC_OK == pRawFile->Close());
+		REQUIRE(RC_OK == pCompressedFile->Close());
+		REQUIRE(RC_OK == pPackageWriter->Close());
+	};
+
+	SECTION("TestWriteFile_WritePackage_HeaderDoesNotOverwriteDataOfTheFirstFile")
+	{
+		writePackage();
+
+		const std::vector<U8> packageData = ReadBytesFromFile(packagePath);
+		REQUIRE(packageData.size() > PackageFileHeaderSize + rawData.size());
+
+		REQUIRE(0 == memcmp(packageData.data(), TPackageFileHeader::mTag, sizeof(TPackageFileHeader::mTag)));
+		REQUIRE(std::equal(rawData.begin(), rawData.end(), packageData.begin() + PackageFileHeaderSize));
+	}
+
+	SECTION("TestReadFileBytes_PassPackageWithTableOfContents_ReturnsDataOfWrittenFiles")
+	{
+		writePackage();
+
+		auto pPackageReader = pFileSystem->Get<IPackageFileReader>(pFileSystem->Open<IPackageFileReader>(packagePath).Get());
+		REQUIRE(pPackageReader);
+
+		const TPackageFileHeader& header = pPackageReader->GetPackageHeader();
+		REQUIRE(header.mEntitiesCount == 2);
+		REQUIRE(header.mTableOfContentsBucketsCount == 4);
+		REQUIRE(header.mTableOfContentsOffset >= header.mFilesTableOffset + header.mFilesTableSize);
+
+		const std::vector<TPackageFileEntryInfo>& filesTable = pPackageReader->GetFilesTable();
+		REQUIRE(filesTable.size() == 2);
+		REQUIRE(filesTable[0].mDataBlockOffset == PackageFileHeaderSize);
+		REQUIRE(!filesTable[0].mIsCompressed);
+		REQUIRE(filesTable[1].mIsCompressed);
+
+		REQUIRE(pPackageReader->ReadFileBytes(rawFilename) == rawData);
+		REQUIRE(pPackageReader->ReadFileBytes(compressedFilename) == compressedData);
+		REQUIRE(pPackageReader->ReadFileBytes("PackageFileTestsMissing.bin").empty());
+
+		REQUIRE(RC_OK == pPackageReader->Close());
+	}
+
+	SECTION("TestGetFileDataView_PassFilesOfMappedPackage_ReturnsViewsOfUncompressedFilesOnly")
+	{
+		writePackage();
+
+		auto pPackageReader = pFileSystem->Get<IPackageFileReader>(pFileSystem->Open<IPackageFileReader>(packagePath).Get());
+		REQUIRE(pPackageReader);
+
+		const TPackageFileDataView rawDataView = pPackageReader->GetFileDataView(rawFilename);
+		REQUIRE(rawDataView.mpData);
+		REQUIRE(rawDataView.mSize == rawData.size());
+		REQUIRE(0 == memcmp(rawDataView.mpData, rawData.data(), rawData.size()));
+
+		REQUIRE(!pPackageReader->GetFileDataView(compressedFilename).mpData);
+		REQUIRE(!pPackageReader->GetFileDataView("PackageFileTestsMissing.bin").mpData);
+
+		REQUIRE(RC_OK == pPackageReader->Close());
+	}
+
+	SECTION("TestReadFileBytes_PassPackageOfFirstVersion_TableOfContentsIsBuiltOnLoading")
+	{
+		/// \note 0x100 packages have neither the table of contents nor codecs and chunks sizes of entries
+		const USIZE legacyHeaderSize = PackageFileHeaderSize - sizeof(U64) - sizeof(U32);
+
+		std::vector<U8> packageData;
+		packageData.insert(packageData.end(), TPackageFileHeader::mTag, TPackageFileHeader::mTag + sizeof(TPackageFileHeader::mTag));
+
+		AppendValue<U16>(packageData, TPackageFileHeader::mMinSupportedVersion);
+		AppendValue<U16>(packageData, 0);
+		AppendValue<U32>(packageData, 2);
+		AppendValue<U64>(packageData, legacyHeaderSize + 2 * rawData.size());
+
+		const USIZE filesTableSizePosition = packageData.size();
+		AppendValue<U64>(packageData, 0);
+
+		REQUIRE(packageData.size() == legacyHeaderSize);
+
+		const std::string filenames[] { rawFilename, compressedFilename };
+
+		/// \note Both files are stored without compression, the second one is reversed
+		packageData.insert(packageData.end(), rawData.begin(), rawData.end());
+		packageData.insert(packageData.end(), rawData.rbegin(), rawData.rend());
+
+		for (U32 i = 0; i < 2; ++i)
+		{
+			AppendValue<U64>(packageData, filenames[i].length());
+			packageData.insert(packageData.end(), filenames[i].begin(), filenames[i].end());
+
+			AppendValue<U64>(packageData, legacyHeaderSize + i * rawData.size());
+			AppendValue<U64>(packageData, rawData.size());
+			AppendValue<U64>(packageData, 0);
+			AppendValue<U8>(packageData, 0);
+		}
+
+		const U64 filesTableSize = SwapBytes<U64>(packageData.size() - legacyHeaderSize - 2 * rawData.size());
+		memcpy(&packageData[filesTableSizePosition], &filesTableSize, sizeof(filesTableSize));
+
+		WriteBytesToFile(packagePath, packageData);
+
+		auto pPackageReader = pFileSystem->Get<IPackageFileReader>(pFileSystem->Open<IPackageFileReader>(packagePath).Get());
+		REQUIRE(pPackageReader);
+
+		REQUIRE(pPackageReader->GetPackageHeader().mEntitiesCount == 2);
+		REQUIRE(pPackageReader->GetPackageHeader().mTableOfContentsBucketsCount == 0);
+
+		REQUIRE(pPackageReader->ReadFileBytes(rawFilename) == rawData);
+		REQUIRE(pPackageReader->ReadFileBytes(compressedFilename) == std::vector<U8>(rawData.rbegin(), rawData.rend()));
+		REQUIRE(pPackageReader->ReadFileRange(compressedFilename, 10, 5) == std::vector<U8>(rawData.rbegin() + 10, rawData.rbegin() + 15));
+		REQUIRE(pPackageReader->GetFileDataView(rawFilename).mSize == rawData.size());
+		REQUIRE(pPackageReader->ReadFileBytes("PackageFileTestsMissing.bin").empty());
+
+		REQUIRE(RC_OK == pPackageReader->Close());
+	}
+
+	std::remove(packagePath.c_str());
+	std::remove(rawFilename.c_str());
+	std::remove(compressedFilename.c_str());
+
+	REQUIRE(RC_OK == pFileSystem->Free());
+}